@@ -0,0 +1,284 @@
+/*!
+ * @file        benchmark.hpp
+ * @brief       Benchmark harness for the Cell Engine.
+ * @details     This file defines the timing loops and the JSON report shared by the benchmark executables.
+ * @author      Kambiz Asadzadeh
+ * @since       07 Jun 2023
+ * @version     1.0
+ * @note        This is part of the Cell Engine, developed by Kambiz Asadzadeh.
+ *
+ * @license     This file is licensed under the terms of the Genyleap License. See the LICENSE.md file for more information.
+ * @copyright   Copyright (c) 2025 The Genyleap | Kambiz Asadzadeh. All rights reserved.
+ * @see         https://github.com/genyleap/cell
+ */
+
+#ifndef CELL_BENCHMARK_HPP
+#define CELL_BENCHMARK_HPP
+
+#if __has_include("common.hpp")
+#   include "common.hpp"
+#else
+#   error "Cell's "common.hpp" was not found!"
+#endif
+
+#if defined(__linux__)
+#   include <unistd.h>
+#endif
+
+CELL_NAMESPACE_BEGIN(Cell::Benchmarks)
+
+/**
+ * @brief The result of one benchmark.
+ */
+struct Measurement final
+{
+    std::string                     name        {}; //!< The benchmark, e.g. `pool.acquire.contended`.
+    std::uint64_t                   operations  {}; //!< Operations timed.
+    double                          seconds     {}; //!< Wall time of all of them.
+    std::vector<double>             latencies   {}; //!< Microseconds of each operation, when they were timed one by one.
+    std::map<std::string, double>   metrics     {}; //!< Further numbers, e.g. bytes or rows.
+
+    /**
+     * @brief Returns the operations per second.
+     */
+    double throughput() const
+    {
+        return seconds > 0 ? static_cast<double>(operations) / seconds : 0;
+    }
+
+    /**
+     * @brief Returns a latency percentile in microseconds, or zero without latencies.
+     *
+     * @param fraction The percentile as a fraction, e.g. 0.99.
+     */
+    double percentile(double fraction) const
+    {
+        if (latencies.empty()) {
+            return 0;
+        }
+        std::vector<double> sorted = latencies;
+        const auto rank = static_cast<std::size_t>(fraction * static_cast<double>(sorted.size() - 1));
+        std::nth_element(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(rank), sorted.end());
+        return sorted[rank];
+    }
+};
+
+/**
+ * @brief Times an operation a number of times, one by one.
+ *
+ * @param name The benchmark.
+ * @param iterations How often to run it.
+ * @param operation Called with the iteration number.
+ */
+template <typename Operation>
+Measurement measure(const std::string& name, std::uint64_t iterations, Operation&& operation)
+{
+    Measurement measurement;
+    measurement.name = name;
+    measurement.operations = iterations;
+    measurement.latencies.reserve(iterations);
+    const auto start = std::chrono::steady_clock::now();
+    for (std::uint64_t i = 0; i < iterations; ++i) {
+        const auto begin = std::chrono::steady_clock::now();
+        operation(i);
+        measurement.latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count());
+    }
+    measurement.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return measurement;
+}
+
+/**
+ * @brief Times an operation run by several threads at once.
+ *
+ * @param name The benchmark.
+ * @param threads The number of threads.
+ * @param iterations How often each thread runs it.
+ * @param operation Called with the thread and the iteration number.
+ */
+template <typename Operation>
+Measurement measureConcurrent(const std::string& name, Types::uint threads, std::uint64_t iterations, Operation&& operation)
+{
+    std::vector<std::vector<double>> latencies(threads);
+    std::vector<std::thread> workers;
+    const auto start = std::chrono::steady_clock::now();
+    for (Types::uint thread = 0; thread < threads; ++thread) {
+        workers.emplace_back([&, thread]() {
+            latencies[thread].reserve(iterations);
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                const auto begin = std::chrono::steady_clock::now();
+                operation(thread, i);
+                latencies[thread].push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count());
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    Measurement measurement;
+    measurement.name = name;
+    measurement.operations = iterations * threads;
+    measurement.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    for (auto& samples : latencies) {
+        measurement.latencies.insert(measurement.latencies.end(), samples.begin(), samples.end());
+    }
+    measurement.metrics["threads"] = threads;
+    return measurement;
+}
+
+/**
+ * @brief Times an operation too short to time one by one, run by one or more threads.
+ *
+ * Only the whole loop is timed; the metric `ns_per_call` is the mean wall time of one call on one thread.
+ *
+ * @param name The benchmark.
+ * @param threads The number of threads.
+ * @param iterations How often each thread runs it.
+ * @param operation Called with the thread and the iteration number.
+ */
+template <typename Operation>
+Measurement measureBatch(const std::string& name, Types::uint threads, std::uint64_t iterations, Operation&& operation)
+{
+    std::vector<double> nanoseconds(threads);
+    std::vector<std::thread> workers;
+    const auto start = std::chrono::steady_clock::now();
+    for (Types::uint thread = 0; thread < threads; ++thread) {
+        workers.emplace_back([&, thread]() {
+            const auto begin = std::chrono::steady_clock::now();
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                operation(thread, i);
+            }
+            nanoseconds[thread] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    Measurement measurement;
+    measurement.name = name;
+    measurement.operations = iterations * threads;
+    measurement.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    measurement.metrics["threads"] = threads;
+    measurement.metrics["ns_per_call"] = std::accumulate(nanoseconds.begin(), nanoseconds.end(), 0.0)
+                                         / static_cast<double>(measurement.operations);
+    return measurement;
+}
+
+/**
+ * @brief Returns the resident memory of the process in bytes, or zero where it is not known.
+ */
+inline std::uint64_t residentBytes()
+{
+#if defined(__linux__)
+    std::ifstream statm("/proc/self/statm");
+    std::uint64_t size {};
+    std::uint64_t resident {};
+    if (statm >> size >> resident) {
+        return resident * static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE));
+    }
+#endif
+    return 0;
+}
+
+/**
+ * @brief Collects measurements and writes them as JSON for regression tracking.
+ *
+ * The document is one object: `suite`, `context` (string pairs such as the driver), and `results`, an
+ * array with the name, operations, seconds, throughput, latency percentiles in microseconds and the
+ * further metrics of every measurement.
+ */
+class Report {
+public:
+    /**
+     * @brief Constructs an empty report of a suite.
+     */
+    explicit Report(std::string suite) : m_suite(std::move(suite)) {}
+
+    /**
+     * @brief Records a fact about the run, e.g. the driver or the server version.
+     */
+    void context(const std::string& key, const std::string& value)
+    {
+        m_context[key] = value;
+    }
+
+    /**
+     * @brief Adds a measurement and prints a summary line of it to the standard error.
+     */
+    void add(Measurement measurement)
+    {
+        std::cerr << std::left << std::setw(40) << measurement.name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(14) << measurement.throughput() << " op/s"
+                  << std::setw(12) << measurement.percentile(0.5) << " us p50"
+                  << std::setw(12) << measurement.percentile(0.99) << " us p99" << '\n';
+        m_results.push_back(std::move(measurement));
+    }
+
+    /**
+     * @brief Returns the report as JSON.
+     */
+    std::string json() const
+    {
+        std::ostringstream out;
+        out << std::setprecision(10);
+        out << "{\n  \"suite\": " << quote(m_suite) << ",\n  \"context\": {";
+        bool first = true;
+        for (const auto& [key, value] : m_context) {
+            out << (first ? "" : ",") << "\n    " << quote(key) << ": " << quote(value);
+            first = false;
+        }
+        out << "\n  },\n  \"results\": [";
+        first = true;
+        for (const auto& result : m_results) {
+            out << (first ? "" : ",") << "\n    {\"name\": " << quote(result.name)
+                << ", \"operations\": " << result.operations
+                << ", \"seconds\": " << result.seconds
+                << ", \"ops_per_second\": " << result.throughput();
+            if (!result.latencies.empty()) {
+                out << ", \"latency_us\": {\"p50\": " << result.percentile(0.5) << ", \"p90\": " << result.percentile(0.9)
+                    << ", \"p99\": " << result.percentile(0.99) << ", \"max\": " << result.percentile(1.0) << "}";
+            }
+            out << ", \"metrics\": {";
+            bool firstMetric = true;
+            for (const auto& [key, value] : result.metrics) {
+                out << (firstMetric ? "" : ", ") << quote(key) << ": " << value;
+                firstMetric = false;
+            }
+            out << "}}";
+            first = false;
+        }
+        out << "\n  ]\n}\n";
+        return out.str();
+    }
+
+private:
+    /**
+     * @brief Returns a JSON string literal.
+     */
+    static std::string quote(std::string_view text)
+    {
+        std::string quoted = "\"";
+        for (const char character : text) {
+            if (character == '"' || character == '\\') {
+                quoted += '\\';
+                quoted += character;
+            } else if (static_cast<unsigned char>(character) < 0x20) {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(character));
+                quoted += escaped;
+            } else {
+                quoted += character;
+            }
+        }
+        return quoted + "\"";
+    }
+
+    std::string                         m_suite     {}; //!< The suite.
+    std::map<std::string, std::string>  m_context   {}; //!< Facts about the run.
+    std::vector<Measurement>            m_results   {}; //!< The measurements, in order.
+};
+
+CELL_NAMESPACE_END
+
+#endif  // CELL_BENCHMARK_HPP
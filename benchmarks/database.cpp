@@ -0,0 +1,409 @@
+#if __has_include("benchmark.hpp")
+#   include "benchmark.hpp"
+#else
+#   error "Cell's "benchmark.hpp" was not found!"
+#endif
+
+#if defined(USE_SQLITE)
+#   include "modules/database/sqlite.hpp"
+#endif
+
+#if defined(USE_POSTGRESQL)
+#   include "modules/database/psql.hpp"
+#endif
+
+#if defined(USE_MYSQL_MARIADB)
+#   include "modules/database/mysql.hpp"
+#endif
+
+CELL_USING_NAMESPACE Cell;
+CELL_USING_NAMESPACE Cell::Benchmarks;
+CELL_USING_NAMESPACE Cell::Modules::BuiltIn::Database;
+
+namespace {
+
+constexpr std::string_view usage =
+    "Usage: cell-database-benchmark [options]\n"
+    "  --driver sqlite|postgresql|mysql   Driver to measure (default: sqlite)\n"
+    "  --database NAME                    Database name, or the SQLite file (default: a temporary file)\n"
+    "  --host HOST --port PORT            Server of PostgreSQL or MySQL (default: 127.0.0.1)\n"
+    "  --user USER --password PASSWORD    Credentials of PostgreSQL or MySQL\n"
+    "  --pool SIZE                        Connections of the pool (default: 8)\n"
+    "  --rows COUNT                       Rows of the read and load benchmarks (default: 100000)\n"
+    "  --iterations COUNT                 Operations of the latency benchmarks (default: 10000)\n"
+    "  --output FILE                      Write the JSON report to FILE instead of the standard output\n";
+
+/**
+ * @brief The command line.
+ */
+struct Settings final
+{
+    std::string     driver      { "sqlite" };
+    std::string     database    {};
+    std::string     host        { "127.0.0.1" };
+    Types::uint     port        {};
+    std::string     user        {};
+    std::string     password    {};
+    Types::uint     pool        { 8 };
+    std::uint64_t   rows        { 100000 };
+    std::uint64_t   iterations  { 10000 };
+    std::string     output      {};
+};
+
+/**
+ * @brief The driver-specific spelling of the benchmark's statements.
+ */
+struct Dialect final
+{
+    std::string key;                        //!< Type of the integer primary key.
+    std::string (*placeholder)(int index);  //!< Placeholder of a 1-based parameter.
+};
+
+std::string questionMark(int)
+{
+    return "?";
+}
+
+#if defined(USE_POSTGRESQL)
+std::string dollarNumber(int index)
+{
+    return "$" + std::to_string(index);
+}
+#endif
+
+std::vector<std::vector<std::string>> makeRows(std::uint64_t first, std::uint64_t count)
+{
+    std::vector<std::vector<std::string>> rows;
+    rows.reserve(count);
+    for (std::uint64_t id = first; id < first + count; ++id) {
+        rows.push_back({ std::to_string(id), "name-" + std::to_string(id), std::to_string(static_cast<double>(id) * 0.5) });
+    }
+    return rows;
+}
+
+template <typename Connection>
+void require(Connection& db, bool succeeded, std::string_view what)
+{
+    if (!succeeded) {
+        throw std::runtime_error(std::string(what) + ": " + db.getLastError());
+    }
+}
+
+/**
+ * @brief Empties the load table between the load benchmarks.
+ */
+template <typename Connection>
+void clearLoadTable(Connection& db)
+{
+    require(db, db.executeSync("DELETE FROM cell_bench_load"), "clear cell_bench_load");
+}
+
+/**
+ * @brief Measures everything a driver shares, and its own extensions where it has them.
+ */
+template <typename Connection>
+void runSuite(Connection& db, Abstracts::ConnectionPool& pool, const Dialect& dialect, const Settings& settings, Report& report)
+{
+    const std::string columns = "(id " + dialect.key + " PRIMARY KEY, name VARCHAR(64), value DOUBLE PRECISION)";
+    db.executeSync("DROP TABLE IF EXISTS cell_bench");
+    db.executeSync("DROP TABLE IF EXISTS cell_bench_load");
+    require(db, db.executeSync("CREATE TABLE cell_bench " + columns), "create cell_bench");
+    require(db, db.executeSync("CREATE TABLE cell_bench_load " + columns), "create cell_bench_load");
+
+    const auto rows = makeRows(1, settings.rows);
+    const std::uint64_t loadRows = std::min<std::uint64_t>(settings.rows, settings.iterations);
+    const std::string insert = "INSERT INTO cell_bench_load (id, name, value) VALUES ("
+                               + dialect.placeholder(1) + ", " + dialect.placeholder(2) + ", " + dialect.placeholder(3) + ")";
+
+    // Pool: one borrower, then four times as many borrowers as connections
+    report.add(measure("pool.acquire", settings.iterations, [&](std::uint64_t) {
+        Abstracts::ConnectionLease lease(pool);
+    }));
+    report.add(measureConcurrent("pool.acquire.contended", settings.pool * 4, settings.iterations / 4, [&](Types::uint, std::uint64_t) {
+        Abstracts::ConnectionLease lease(pool);
+    }));
+
+    // Loads: one statement per row, one batch, one multi-row INSERT, and COPY where the driver has it
+    {
+        auto measurement = measure("insert.single", loadRows, [&](std::uint64_t i) {
+            db.executeWithParamsSync(insert, rows[i]);
+        });
+        measurement.metrics["rows"] = static_cast<double>(loadRows);
+        report.add(std::move(measurement));
+        clearLoadTable(db);
+    }
+    {
+        const std::vector<std::vector<std::string>> batch(rows.begin(), rows.begin() + static_cast<std::ptrdiff_t>(loadRows));
+        auto measurement = measure("insert.batched", 1, [&](std::uint64_t) {
+            require(db, db.executeBatchWithParamsSync(insert, batch), "insert.batched");
+        });
+        measurement.metrics["rows"] = static_cast<double>(loadRows);
+        measurement.metrics["rows_per_second"] = static_cast<double>(loadRows) / measurement.seconds;
+        report.add(std::move(measurement));
+        clearLoadTable(db);
+    }
+    {
+        auto measurement = measure("insert.bulk", 1, [&](std::uint64_t) {
+            require(db, db.bulkInsert("cell_bench_load", rows), "insert.bulk");
+        });
+        measurement.metrics["rows"] = static_cast<double>(rows.size());
+        measurement.metrics["rows_per_second"] = static_cast<double>(rows.size()) / measurement.seconds;
+        report.add(std::move(measurement));
+        clearLoadTable(db);
+    }
+    if constexpr (requires { db.copyIn(std::string(), rows); }) {
+        auto measurement = measure("insert.copy", 1, [&](std::uint64_t) {
+            db.copyIn("cell_bench_load", rows);
+        });
+        measurement.metrics["rows"] = static_cast<double>(rows.size());
+        measurement.metrics["rows_per_second"] = static_cast<double>(rows.size()) / measurement.seconds;
+        report.add(std::move(measurement));
+        clearLoadTable(db);
+    }
+
+    require(db, db.bulkInsert("cell_bench", rows), "fill cell_bench");
+
+    // Point selects: bound parameters through the statement cache against a new statement text every time
+    const std::string pointSelect = "SELECT id, name, value FROM cell_bench WHERE id = " + dialect.placeholder(1);
+    const auto idOf = [&settings](std::uint64_t i) { return std::to_string(i * 7919 % settings.rows + 1); };
+    report.add(measure("select.point.prepared", settings.iterations, [&](std::uint64_t i) {
+        db.queryWithParamsSync(pointSelect, { idOf(i) });
+    }));
+    report.add(measure("select.point.unprepared", settings.iterations, [&](std::uint64_t i) {
+        db.querySync("SELECT id, name, value FROM cell_bench WHERE id = " + idOf(i));
+    }));
+    report.add(measureConcurrent("select.point.concurrent", settings.pool, settings.iterations / settings.pool, [&](Types::uint thread, std::uint64_t i) {
+        db.queryWithParamsSync(pointSelect, { idOf(i * settings.pool + thread) });
+    }));
+
+    // Sync against async: the same reads, one at a time or with a window of them in flight
+    const std::uint64_t window = 32;
+    report.add(measure("select.sync", settings.iterations, [&](std::uint64_t i) {
+        db.queryResult("SELECT id, name, value FROM cell_bench WHERE id = " + idOf(i));
+    }));
+    {
+        auto measurement = measure("select.async", settings.iterations / window, [&](std::uint64_t batch) {
+            std::vector<std::future<Abstracts::ResultSetPtr>> pending;
+            for (std::uint64_t i = 0; i < window; ++i) {
+                pending.push_back(db.queryResultAsync("SELECT id, name, value FROM cell_bench WHERE id = " + idOf(batch * window + i)));
+            }
+            for (auto& result : pending) {
+                result.get();
+            }
+        });
+        measurement.operations *= window;
+        measurement.metrics["window"] = static_cast<double>(window);
+        report.add(std::move(measurement));
+    }
+    if constexpr (requires { db.queryPipelined(std::vector<std::string>()); }) {
+        auto measurement = measure("select.pipelined", settings.iterations / window, [&](std::uint64_t batch) {
+            std::vector<std::string> statements;
+            for (std::uint64_t i = 0; i < window; ++i) {
+                statements.push_back("SELECT id, name, value FROM cell_bench WHERE id = " + idOf(batch * window + i));
+            }
+            db.queryPipelined(statements);
+        });
+        measurement.operations *= window;
+        measurement.metrics["window"] = static_cast<double>(window);
+        report.add(std::move(measurement));
+    }
+
+    // Large results: the flat result set against a vector of string rows, with the memory each holds
+    {
+        const auto before = residentBytes();
+        Abstracts::ResultSetPtr held;
+        auto measurement = measure("result.materialize.resultset", 1, [&](std::uint64_t) {
+            held = db.queryResult("SELECT id, name, value FROM cell_bench");
+        });
+        measurement.metrics["rows"] = static_cast<double>(held ? held->rowCount() : 0);
+        measurement.metrics["resident_bytes"] = static_cast<double>(residentBytes() - std::min(before, residentBytes()));
+        held.reset();
+        report.add(std::move(measurement));
+    }
+    {
+        const auto before = residentBytes();
+        std::vector<std::vector<std::string>> held;
+        auto measurement = measure("result.materialize.rows", 1, [&](std::uint64_t) {
+            held = db.querySync("SELECT id, name, value FROM cell_bench");
+        });
+        measurement.metrics["rows"] = static_cast<double>(held.size());
+        measurement.metrics["resident_bytes"] = static_cast<double>(residentBytes() - std::min(before, residentBytes()));
+        report.add(std::move(measurement));
+    }
+
+    // Paging to the end of the table: OFFSET rescans what it skips, a keyset seeks past it
+    const int pageSize = 100;
+    const auto pages = static_cast<std::uint64_t>((settings.rows + pageSize - 1) / pageSize);
+    report.add(measure("page.offset", pages, [&](std::uint64_t page) {
+        db.queryWithPagination("SELECT id, name, value FROM cell_bench ORDER BY id", static_cast<int>(page) + 1, pageSize);
+    }));
+    {
+        std::string continuation;
+        report.add(measure("page.keyset", pages, [&](std::uint64_t) {
+            continuation = db.queryWithKeyset("SELECT id, name, value FROM cell_bench", { { "id" } }, pageSize, continuation).continuation;
+        }));
+    }
+
+    // Schema catalog: lookups from the snapshot against a reload after every invalidation
+    report.add(measure("schema.lookup", settings.iterations, [&](std::uint64_t) {
+        db.getTableColumns("cell_bench");
+    }));
+    report.add(measure("schema.reload", std::max<std::uint64_t>(settings.iterations / 100, 1), [&](std::uint64_t) {
+        pool.schemaCatalog().invalidate();
+        db.schema();
+    }));
+
+    // Driver extensions: table migration and backup
+    if constexpr (requires { db.migrateTable(std::string(), db, std::string()); }) {
+        clearLoadTable(db);
+        Abstracts::MigrationOptions options;
+        options.key = { { "id" } };
+        options.parallelism = std::max<Types::uint>(settings.pool / 2, 1);
+        auto measurement = measure("migration.table", 1, [&](std::uint64_t) {
+            db.migrateTable("cell_bench", db, "cell_bench_load", options);
+        });
+        measurement.metrics["rows"] = static_cast<double>(settings.rows);
+        measurement.metrics["rows_per_second"] = static_cast<double>(settings.rows) / measurement.seconds;
+        report.add(std::move(measurement));
+    }
+#if defined(USE_POSTGRESQL)
+    if constexpr (std::is_same_v<Connection, PostgreSqlDatabaseConnection>) {
+        const auto directory = std::filesystem::temp_directory_path() / "cell-database-benchmark-backup";
+        std::filesystem::remove_all(directory);
+        PostgreSqlBackupOptions backupOptions;
+        backupOptions.parallelism = std::max<Types::uint>(settings.pool / 2, 1);
+        PostgreSqlBackupManifest manifest;
+        auto backup = measure("backup.dump", 1, [&](std::uint64_t) {
+            manifest = db.backup(directory.string(), backupOptions);
+        });
+        std::uint64_t bytes = 0;
+        for (const auto& table : manifest.tables) {
+            bytes += table.bytes;
+        }
+        backup.metrics["bytes"] = static_cast<double>(bytes);
+        backup.metrics["bytes_per_second"] = static_cast<double>(bytes) / backup.seconds;
+        report.add(std::move(backup));
+
+        PostgreSqlRestoreOptions restoreOptions;
+        restoreOptions.parallelism = backupOptions.parallelism;
+        restoreOptions.truncate = true;
+        auto restore = measure("backup.restore", 1, [&](std::uint64_t) {
+            db.restore(directory.string(), restoreOptions);
+        });
+        restore.metrics["bytes"] = static_cast<double>(bytes);
+        restore.metrics["bytes_per_second"] = static_cast<double>(bytes) / restore.seconds;
+        report.add(std::move(restore));
+        std::filesystem::remove_all(directory);
+    }
+#endif
+
+    db.executeSync("DROP TABLE IF EXISTS cell_bench_load");
+    db.executeSync("DROP TABLE IF EXISTS cell_bench");
+}
+
+Settings parse(int argc, char* argv[])
+{
+    Settings settings;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view option = argv[i];
+        if (option == "--help" || option == "-h") {
+            std::cout << usage;
+            std::exit(EXIT_SUCCESS);
+        }
+        if (i + 1 >= argc) {
+            throw std::invalid_argument("Missing value of " + std::string(option) + ".\n" + std::string(usage));
+        }
+        const std::string value = argv[++i];
+        if (option == "--driver") {
+            settings.driver = value;
+        } else if (option == "--database") {
+            settings.database = value;
+        } else if (option == "--host") {
+            settings.host = value;
+        } else if (option == "--port") {
+            settings.port = static_cast<Types::uint>(std::stoul(value));
+        } else if (option == "--user") {
+            settings.user = value;
+        } else if (option == "--password") {
+            settings.password = value;
+        } else if (option == "--pool") {
+            settings.pool = std::max<Types::uint>(static_cast<Types::uint>(std::stoul(value)), 1);
+        } else if (option == "--rows") {
+            settings.rows = std::max<std::uint64_t>(std::stoull(value), 1);
+        } else if (option == "--iterations") {
+            settings.iterations = std::max<std::uint64_t>(std::stoull(value), 64);
+        } else if (option == "--output") {
+            settings.output = value;
+        } else {
+            throw std::invalid_argument("Unknown option " + std::string(option) + ".\n" + std::string(usage));
+        }
+    }
+    return settings;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    try {
+        const Settings settings = parse(argc, argv);
+        Report report("database");
+        report.context("driver", settings.driver);
+        report.context("pool", std::to_string(settings.pool));
+        report.context("rows", std::to_string(settings.rows));
+        report.context("iterations", std::to_string(settings.iterations));
+
+        bool known = false;
+#if defined(USE_SQLITE)
+        if (settings.driver == "sqlite") {
+            known = true;
+            const std::string path = settings.database.empty()
+                                         ? (std::filesystem::temp_directory_path() / "cell-database-benchmark.db").string()
+                                         : settings.database;
+            for (const auto suffix : { "", "-wal", "-shm" }) {
+                std::filesystem::remove(path + suffix);
+            }
+            SqliteConnectionPool pool(path, settings.pool);
+            SqliteDatabaseConnection db(pool);
+            require(db, db.connect(), "connect");
+            report.context("server_version", db.getDatabaseServerVersion());
+            runSuite(db, pool, { "INTEGER", &questionMark }, settings, report);
+        }
+#endif
+#if defined(USE_POSTGRESQL)
+        if (settings.driver == "postgresql") {
+            known = true;
+            PostgreSqlConnectionPool pool(settings.host, settings.port ? settings.port : 5432, settings.user, settings.password,
+                                          settings.database, settings.pool);
+            PostgreSqlDatabaseConnection db(pool);
+            require(db, db.connect(), "connect");
+            report.context("server_version", db.getDatabaseServerVersion());
+            runSuite(db, pool, { "BIGINT", &dollarNumber }, settings, report);
+        }
+#endif
+#if defined(USE_MYSQL_MARIADB)
+        if (settings.driver == "mysql") {
+            known = true;
+            MySqlConnectionPool pool(settings.host, settings.port ? settings.port : 3306, settings.user, settings.password,
+                                     settings.database, settings.pool);
+            MySQLDatabaseConnection db(pool);
+            require(db, db.connect(), "connect");
+            report.context("server_version", db.getDatabaseServerVersion());
+            runSuite(db, pool, { "BIGINT", &questionMark }, settings, report);
+        }
+#endif
+        if (!known) {
+            throw std::invalid_argument("The driver '" + settings.driver + "' is unknown or was not built.");
+        }
+
+        if (settings.output.empty()) {
+            std::cout << report.json();
+        } else {
+            std::ofstream(settings.output) << report.json();
+        }
+        return EXIT_SUCCESS;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+}
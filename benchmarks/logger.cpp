@@ -0,0 +1,141 @@
+#if __has_include("benchmark.hpp")
+#   include "benchmark.hpp"
+#else
+#   error "Cell's "benchmark.hpp" was not found!"
+#endif
+
+#if __has_include("core/logger.hpp")
+#   include "core/logger.hpp"
+#else
+#   error "Cell's "core/logger.hpp" was not found!"
+#endif
+
+CELL_USING_NAMESPACE Cell;
+CELL_USING_NAMESPACE Cell::Benchmarks;
+CELL_USING_NAMESPACE Cell::Utility;
+
+namespace {
+
+constexpr std::string_view usage =
+    "Usage: cell-logger-benchmark [options]\n"
+    "  --threads COUNT        Logging threads of the concurrent benchmarks (default: 4)\n"
+    "  --iterations COUNT     Calls per thread (default: 1000000)\n"
+    "  --output FILE          Write the JSON report to FILE instead of the standard output\n";
+
+/**
+ * @brief The command line.
+ */
+struct Settings final
+{
+    Types::uint     threads     { 4 };
+    std::uint64_t   iterations  { 1000000 };
+    std::string     output      {};
+};
+
+Settings parse(int argc, char* argv[])
+{
+    Settings settings;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view option = argv[i];
+        if (option == "--help" || option == "-h") {
+            std::cout << usage;
+            std::exit(EXIT_SUCCESS);
+        }
+        if (i + 1 >= argc) {
+            throw std::invalid_argument("Missing value of " + std::string(option) + ".\n" + std::string(usage));
+        }
+        const std::string value = argv[++i];
+        if (option == "--threads") {
+            settings.threads = std::max<Types::uint>(static_cast<Types::uint>(std::stoul(value)), 1);
+        } else if (option == "--iterations") {
+            settings.iterations = std::max<std::uint64_t>(std::stoull(value), 1000);
+        } else if (option == "--output") {
+            settings.output = value;
+        } else {
+            throw std::invalid_argument("Unknown option " + std::string(option) + ".\n" + std::string(usage));
+        }
+    }
+    return settings;
+}
+
+/**
+ * @brief Runs a benchmark of the asynchronous logger, writing into a .clog or a text file without console output.
+ *
+ * A warm-up round first touches the ring of each thread and is written out, so page faults are not timed.
+ * The records written and dropped during the run are added as metrics.
+ */
+template <typename Operation>
+Measurement measureLogger(Logger& logger, const std::string& name, OutputFormat format, OverflowPolicy policy,
+                          Types::uint threads, std::uint64_t iterations, Operation&& operation)
+{
+    ConfigStruct config;
+    config.storage = Storage::InFile;
+    config.outputFormat = format;
+    logger.set(config);
+
+    AsyncLoggerOptions options;
+    options.console = false;
+    options.overflowPolicy = policy;
+    options.ringBytes = 1 << 22;
+    Logger::startAsync(options);
+
+    measureBatch(name, threads, iterations / 10, operation);
+    Logger::flush();
+    const AsyncLoggerStatistics before = Logger::asyncStatistics();
+    Measurement measurement = measureBatch(name, threads, iterations, operation);
+    Logger::flush();
+    const AsyncLoggerStatistics after = Logger::asyncStatistics();
+    Logger::stopAsync();
+
+    measurement.metrics["written"] = static_cast<double>(after.written - before.written);
+    measurement.metrics["dropped"] = static_cast<double>(after.dropped - before.dropped);
+    return measurement;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    try {
+        const Settings settings = parse(argc, argv);
+        Report report("logger");
+        report.context("threads", std::to_string(settings.threads));
+        report.context("iterations", std::to_string(settings.iterations));
+        std::filesystem::remove_all(std::string(LogFolder));
+
+        // The call itself: records that do not fit are counted, not waited for, so the writer's pace does not leak in
+        const std::string name = "orders";
+        const auto deferred = [&](Types::uint thread, std::uint64_t i) {
+            LogDeferred(LoggerType::Info, "thread {} wrote {} rows to {} in {:.3f} ms", thread, i, name, 0.25);
+        };
+        const auto formatted = [&](Types::uint thread, std::uint64_t i) {
+            Logger::formatted(LoggerType::Info, "thread {} wrote {} rows to {} in {:.3f} ms", thread, i, name, 0.25);
+        };
+
+        Logger logger;
+        for (const auto& [format, label] : { std::pair { OutputFormat::Dedicated, "clog" }, std::pair { OutputFormat::RawText, "text" } }) {
+            report.add(measureLogger(logger, std::string("deferred.") + label, format, OverflowPolicy::Count,
+                                     1, settings.iterations, deferred));
+            report.add(measureLogger(logger, std::string("deferred.") + label + ".concurrent", format, OverflowPolicy::Count,
+                                     settings.threads, settings.iterations, deferred));
+        }
+
+        // Formatting on the calling thread, then copying the text into the ring
+        report.add(measureLogger(logger, "formatted.text", OutputFormat::RawText, OverflowPolicy::Count, 1, settings.iterations, formatted));
+
+        // Everything that reaches the disk: the writer keeps up or the callers wait for it
+        report.add(measureLogger(logger, "deferred.clog.sustained", OutputFormat::Dedicated, OverflowPolicy::Block,
+                                 1, settings.iterations, deferred));
+
+        std::filesystem::remove_all(std::string(LogFolder));
+        if (settings.output.empty()) {
+            std::cout << report.json();
+        } else {
+            std::ofstream(settings.output) << report.json();
+        }
+        return EXIT_SUCCESS;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+}
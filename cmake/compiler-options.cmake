@@ -168,6 +168,22 @@ if (BUILD_DOC)
   add_definitions(-DBUILD_DOC)
 endif()
 
+# Build the benchmark executables
+option(BUILD_BENCHMARKS "Build the benchmark executables" OFF)
+if (BUILD_BENCHMARKS)
+  add_definitions(-DBUILD_BENCHMARKS)
+endif()
+
+# Compile out log records below a level: 0 Debug, 1 Info, 2 Warning, 3 Error, 4 Off
+set(CELL_LOG_MIN_LEVEL "0" CACHE STRING "Lowest LogLevel compiled into Log, LogTagged and LogDeferred calls")
+add_definitions(-DCELL_LOG_MIN_LEVEL=${CELL_LOG_MIN_LEVEL})
+
+# Build the command line tools, e.g. cell-logdecode
+option(BUILD_TOOLS "Build the command line tools" OFF)
+if (BUILD_TOOLS)
+  add_definitions(-DBUILD_TOOLS)
+endif()
+
 # Compile Qt Quick (QML) files
 option(USE_QT_QUICK_COMPILER "Compile Qt Quick (QML) files." OFF)
 if (USE_QT_QUICK_COMPILER)
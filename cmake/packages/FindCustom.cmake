@@ -1,3 +1,5 @@
+# Each database option defines the USE_* macro its driver sources are compiled under, publicly on the library.
+
 # Package Info.
 set(MYSQL_NAME "MySQL")
 set(MYSQL_DESCRIPTION "")
@@ -5,6 +7,7 @@ set(MYSQL_DESCRIPTION "")
 option(USE_DB_MYSQL ${MYSQL_DESCRIPTION} FALSE)
 if (USE_DB_MYSQL)
     add_definitions(-DUSE_DB_MYSQL)
+    list(APPEND LIB_TARGET_COMPILER_DEFINATION USE_MYSQL_MARIADB)
     # Package Info.
     # Package Info.
     list(APPEND LIB_TARGET_INCLUDE_DIRECTORIES
@@ -22,6 +25,7 @@ set(PSQL_DESCRIPTION "")
 option(USE_DB_PSQL ${PSQL_DESCRIPTION} FALSE)
 if (USE_DB_PSQL)
     add_definitions(-DUSE_DB_PSQL)
+    list(APPEND LIB_TARGET_COMPILER_DEFINATION USE_POSTGRESQL)
     # Package Info.
     list(APPEND LIB_MODULES
         /opt/homebrew/Cellar/mariadb-connector-c/3.3.8/lib/mariadb/libmariadb.3.dylib
@@ -38,6 +42,7 @@ set(MSSQL_DESCRIPTION "")
 option(USE_DB_MSSQL ${MSSQL_DESCRIPTION} FALSE)
 if (USE_DB_MSSQL)
     add_definitions(-DUSE_DB_MSSQL)
+    list(APPEND LIB_TARGET_COMPILER_DEFINATION USE_MSSQL)
 endif()
 
 # Package Info.
@@ -47,6 +52,7 @@ set(ORACLE_DESCRIPTION "")
 option(USE_DB_ORACLE ${ORACLE_DESCRIPTION} FALSE)
 if (USE_DB_ORACLE)
     add_definitions(-DUSE_DB_ORACLE)
+    list(APPEND LIB_TARGET_COMPILER_DEFINATION USE_ORACLE)
 endif()
 
 # Package Info.
@@ -56,6 +62,8 @@ set(SQLITE_DESCRIPTION "")
 option(USE_DB_SQLITE ${SQLITE_DESCRIPTION} FALSE)
 if (USE_DB_SQLITE)
     add_definitions(-DUSE_DB_SQLITE)
+    list(APPEND LIB_TARGET_COMPILER_DEFINATION USE_SQLITE)
+    list(APPEND LIB_MODULES sqlite3)
 endif()
 
 # find_package(ODBC REQUIRED)
@@ -0,0 +1,72 @@
+#if __has_include("connectionlease.hpp")
+#   include "connectionlease.hpp"
+#else
+#   error "Cell's connectionlease was not found!"
+#endif
+
+#if defined(USE_MYSQL_MARIADB) || defined(USE_POSTGRESQL) || defined(USE_SQLITE) || defined(USE_MSSQL) || defined(USE_ORACLE)
+
+CELL_USING_NAMESPACE Cell;
+
+CELL_NAMESPACE_BEGIN(Cell::Abstracts)
+
+ConnectionLease::ConnectionLease(ConnectionPool& pool)
+    : m_pool(&pool), m_connection(pool.getConnection())
+{
+}
+
+ConnectionLease::~ConnectionLease()
+{
+    release();
+}
+
+ConnectionLease::ConnectionLease(ConnectionLease&& other) noexcept
+    : m_pool(std::exchange(other.m_pool, nullptr)), m_connection(other.m_connection)
+{
+}
+
+ConnectionLease& ConnectionLease::operator=(ConnectionLease&& other) noexcept
+{
+    if (this != &other) {
+        release();
+        m_pool = std::exchange(other.m_pool, nullptr);
+        m_connection = other.m_connection;
+    }
+    return *this;
+}
+
+bool ConnectionLease::valid() const
+{
+    return m_pool != nullptr;
+}
+
+ConnectionLease::operator bool() const
+{
+    return valid();
+}
+
+Types::SqlConnection ConnectionLease::connection() const
+{
+    if (!m_pool) {
+        throw std::logic_error("Connection lease is empty.");
+    }
+    return m_connection;
+}
+
+void ConnectionLease::release()
+{
+    if (auto* pool = std::exchange(m_pool, nullptr)) {
+        pool->releaseConnection(m_connection);
+    }
+}
+
+void ConnectionLease::discard()
+{
+    if (auto* pool = std::exchange(m_pool, nullptr)) {
+        pool->discardConnection(m_connection);
+    }
+}
+
+CELL_NAMESPACE_END
+
+#endif
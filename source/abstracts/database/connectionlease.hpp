@@ -0,0 +1,127 @@
+/*!
+ * @file        connectionlease.hpp
+ * @brief       Scoped connection lease for the Cell Engine.
+ * @details     This file defines ConnectionLease, which holds a pooled connection for the lifetime of a scope.
+ * @author      Kambiz Asadzadeh
+ * @since       07 Jun 2023
+ * @version     1.0
+ * @note        This is part of the Cell Engine, developed by Kambiz Asadzadeh.
+ *
+ * @license     This file is licensed under the terms of the Genyleap License. See the LICENSE.md file for more information.
+ * @copyright   Copyright (c) 2025 The Genyleap | Kambiz Asadzadeh. All rights reserved.
+ * @see         https://github.com/genyleap/cell
+ */
+
+#ifndef CELL_DATABASE_CONNECTION_LEASE_ABSTRACT_HPP
+#define CELL_DATABASE_CONNECTION_LEASE_ABSTRACT_HPP
+
+#if defined(USE_MYSQL_MARIADB) || defined(USE_POSTGRESQL) || defined(USE_SQLITE) || defined(USE_MSSQL) || defined(USE_ORACLE)
+
+//! Cell's Common.
+#if __has_include(<common>)
+#   include <common>
+#else
+#   error "Cell's common was not found!"
+#endif
+
+//! Cell's Core (Core Only).
+#if __has_include(<core>)
+#   include <core>
+#else
+#   error "Cell's requirements was not found!"
+#endif
+
+#if __has_include("connectionpool.hpp")
+#   include "connectionpool.hpp"
+#else
+#   error "Cell's connectionpool was not found!"
+#endif
+
+CELL_NAMESPACE_BEGIN(Cell::Abstracts)
+
+/**
+ * @brief Holds one pooled connection and returns it to the pool when it goes out of scope.
+ *
+ * A lease is move-only: exactly one owner can use the connection at a time, and every statement issued
+ * through it is guaranteed to run on the same backend session.
+ */
+class ConnectionLease {
+public:
+    /**
+     * @brief Constructs an empty lease that holds no connection.
+     */
+    ConnectionLease() = default;
+
+    /**
+     * @brief Acquires a connection from the pool, waiting until one is available.
+     *
+     * @param pool The pool to acquire the connection from.
+     */
+    explicit ConnectionLease(ConnectionPool& pool);
+
+    /**
+     * @brief Returns the connection to the pool.
+     */
+    ~ConnectionLease();
+
+    ConnectionLease(ConnectionLease&& other) noexcept;
+    ConnectionLease& operator=(ConnectionLease&& other) noexcept;
+
+    /**
+     * @brief Disable copy construction and assignment for a class.
+     */
+    CELL_DISABLE_COPY(ConnectionLease)
+
+    /**
+     * @brief Checks whether the lease currently holds a connection.
+     */
+    bool valid() const;
+
+    /**
+     * @brief Checks whether the lease currently holds a connection.
+     */
+    explicit operator bool() const;
+
+    /**
+     * @brief Returns the leased connection.
+     *
+     * @throws std::logic_error If the lease is empty.
+     */
+    Types::SqlConnection connection() const;
+
+    /**
+     * @brief Returns the driver handle of the leased connection, e.g. `lease.get<Types::PostgreSqlPtr>()`.
+     *
+     * @throws std::logic_error If the lease is empty.
+     * @throws std::runtime_error If the connection belongs to another driver.
+     */
+    template <typename Handle>
+    Handle get() const
+    {
+        const auto current = connection();
+        if (!std::holds_alternative<Handle>(current)) {
+            throw std::runtime_error("Leased connection has an unexpected driver type.");
+        }
+        return std::get<Handle>(current);
+    }
+
+    /**
+     * @brief Returns the connection to the pool before the lease goes out of scope.
+     */
+    void release();
+
+    /**
+     * @brief Closes the connection instead of returning it to the pool, e.g. after a protocol error.
+     */
+    void discard();
+
+private:
+    ConnectionPool*         m_pool          {}; //!< The pool the connection came from; nullptr when empty.
+    Types::SqlConnection    m_connection    {}; //!< The leased connection.
+};
+
+CELL_NAMESPACE_END
+
+#endif
+
+#endif  // CELL_DATABASE_CONNECTION_LEASE_ABSTRACT_HPP
@@ -4,7 +4,7 @@
 #   error "Cell's connectionpool was not found!"
 #endif
 
-#if defined(USE_MYSQL_MARIADB) && defined(USE_POSTGRESQL) && defined(USE_SQLITE) && defined(USE_MSSQL) && defined(USE_ORACLE)
+#if defined(USE_MYSQL_MARIADB) || defined(USE_POSTGRESQL) || defined(USE_SQLITE) || defined(USE_MSSQL) || defined(USE_ORACLE)
 
 CELL_USING_NAMESPACE Cell;
 
@@ -22,6 +22,324 @@ ConnectionPool::ConnectionPool()
  */
 ConnectionPool::~ConnectionPool()
 {
+    // Drivers call shutdown() while their virtual functions are still usable; this only catches omissions
+    {
+        std::lock_guard<std::mutex> lock(m_poolData.mutex);
+        m_poolData.stopping = true;
+        m_poolData.maintenanceCondition.notify_all();
+    }
+    if (m_poolData.maintenance.joinable()) {
+        m_poolData.maintenance.join();
+    }
+}
+
+void ConnectionPool::initialize()
+{
+    std::unique_lock<std::mutex> lock(m_poolData.mutex);
+    if (m_poolData.initialized) {
+        return;
+    }
+    m_poolData.stopping = false;
+    const auto minSize = std::min(m_poolData.minSize, m_poolData.poolSize);
+
+    // Open the minimum eagerly so that configuration errors surface here rather than on first use
+    while (m_poolData.total < minSize) {
+        ++m_poolData.total;
+        lock.unlock();
+        Types::SqlConnection connection;
+        try {
+            connection = openConnection();
+        } catch (...) {
+            lock.lock();
+            --m_poolData.total;
+            throw;
+        }
+        lock.lock();
+        ++m_poolData.statistics.created;
+        m_poolData.connections.push_back({ connection, std::chrono::steady_clock::now() });
+    }
+
+    m_poolData.initialized = true;
+    m_poolData.maintenance = std::thread([this] { maintain(); });
+}
+
+bool ConnectionPool::isInitialized() const
+{
+    std::lock_guard<std::mutex> lock(m_poolData.mutex);
+    return m_poolData.initialized;
+}
+
+Types::SqlConnection ConnectionPool::getConnection()
+{
+    std::chrono::milliseconds timeout;
+    {
+        std::lock_guard<std::mutex> lock(m_poolData.mutex);
+        timeout = m_poolData.acquireTimeout;
+    }
+    return getConnection(timeout);
+}
+
+Types::SqlConnection ConnectionPool::getConnection(std::chrono::milliseconds timeout)
+{
+    const auto startedAt = std::chrono::steady_clock::now();
+    const auto deadline = startedAt + timeout;
+
+    std::unique_lock<std::mutex> lock(m_poolData.mutex);
+    ++m_poolData.statistics.waiting;
+
+    for (;;) {
+        // Reuse the most recently returned connection: its server-side caches are the warmest
+        if (!m_poolData.connections.empty()) {
+            PooledConnection pooled = m_poolData.connections.back();
+            m_poolData.connections.pop_back();
+
+            if (std::chrono::steady_clock::now() - pooled.lastUsedAt > m_poolData.validationInterval) {
+                lock.unlock();
+                const bool alive = pingConnection(pooled.connection);
+                if (!alive) {
+                    closeConnection(pooled.connection);
+                }
+                lock.lock();
+                if (!alive) {
+                    --m_poolData.total;
+                    ++m_poolData.statistics.validationFailures;
+                    ++m_poolData.statistics.destroyed;
+                    m_poolData.maintenanceCondition.notify_one();
+                    continue;
+                }
+            }
+
+            --m_poolData.statistics.waiting;
+            recordWait(std::chrono::steady_clock::now() - startedAt);
+            return pooled.connection;
+        }
+
+        // Grow lazily up to the maximum
+        if (m_poolData.total < m_poolData.poolSize) {
+            ++m_poolData.total;
+            lock.unlock();
+            Types::SqlConnection connection;
+            try {
+                connection = openConnection();
+            } catch (...) {
+                lock.lock();
+                --m_poolData.total;
+                --m_poolData.statistics.waiting;
+                m_poolData.condition.notify_one();
+                throw;
+            }
+            lock.lock();
+            ++m_poolData.statistics.created;
+            --m_poolData.statistics.waiting;
+            recordWait(std::chrono::steady_clock::now() - startedAt);
+            return connection;
+        }
+
+        if (m_poolData.condition.wait_until(lock, deadline) == std::cv_status::timeout
+            && m_poolData.connections.empty() && m_poolData.total >= m_poolData.poolSize) {
+            --m_poolData.statistics.waiting;
+            ++m_poolData.statistics.timeouts;
+            throw PoolTimeoutError("Timed out after " + std::to_string(timeout.count()) + " ms waiting for a database connection.");
+        }
+    }
+}
+
+void ConnectionPool::releaseConnection(Types::SqlConnection connection)
+{
+    std::unique_lock<std::mutex> lock(m_poolData.mutex);
+    --m_poolData.statistics.inUse;
+
+    // Connections above a lowered maximum, or returned during shutdown, are closed right away
+    if (m_poolData.stopping || m_poolData.total > m_poolData.poolSize) {
+        --m_poolData.total;
+        ++m_poolData.statistics.destroyed;
+        lock.unlock();
+        closeConnection(connection);
+        return;
+    }
+
+    // Add the connection back to the pool
+    m_poolData.connections.push_back({ connection, std::chrono::steady_clock::now() });
+
+    // Notify a waiting thread about the availability of a connection
+    m_poolData.condition.notify_one();
+}
+
+void ConnectionPool::discardConnection(Types::SqlConnection connection)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_poolData.mutex);
+        --m_poolData.statistics.inUse;
+        --m_poolData.total;
+        ++m_poolData.statistics.destroyed;
+
+        // A waiter may now open a replacement, and the maintenance thread restores the minimum
+        m_poolData.condition.notify_one();
+        m_poolData.maintenanceCondition.notify_one();
+    }
+    closeConnection(connection);
+}
+
+void ConnectionPool::setPoolLimits(Types::uint minSize, Types::uint maxSize)
+{
+    std::lock_guard<std::mutex> lock(m_poolData.mutex);
+    m_poolData.poolSize = std::max<Types::uint>(maxSize, 1);
+    m_poolData.minSize = std::min(minSize, m_poolData.poolSize);
+    m_poolData.condition.notify_all();
+    m_poolData.maintenanceCondition.notify_one();
+}
+
+void ConnectionPool::setAcquireTimeout(std::chrono::milliseconds timeout)
+{
+    std::lock_guard<std::mutex> lock(m_poolData.mutex);
+    m_poolData.acquireTimeout = timeout;
+}
+
+void ConnectionPool::setIdleTimeout(std::chrono::milliseconds timeout)
+{
+    std::lock_guard<std::mutex> lock(m_poolData.mutex);
+    m_poolData.idleTimeout = timeout;
+}
+
+void ConnectionPool::setValidationInterval(std::chrono::milliseconds interval)
+{
+    std::lock_guard<std::mutex> lock(m_poolData.mutex);
+    m_poolData.validationInterval = interval;
+}
+
+std::optional<std::chrono::milliseconds> ConnectionPool::replicationLag(const Types::SqlConnection&)
+{
+    return std::chrono::milliseconds::zero();
+}
+
+PoolStatistics ConnectionPool::statistics() const
+{
+    std::lock_guard<std::mutex> lock(m_poolData.mutex);
+    PoolStatistics statistics = m_poolData.statistics;
+    statistics.idle = static_cast<Types::uint>(m_poolData.connections.size());
+    return statistics;
+}
+
+std::map<std::string, std::string> ConnectionPool::statisticsMap() const
+{
+    const auto current = statistics();
+    std::map<std::string, std::string> values {
+        { "pool_idle",                  std::to_string(current.idle) },
+        { "pool_in_use",                std::to_string(current.inUse) },
+        { "pool_waiting",               std::to_string(current.waiting) },
+        { "pool_created",               std::to_string(current.created) },
+        { "pool_destroyed",             std::to_string(current.destroyed) },
+        { "pool_acquired",              std::to_string(current.acquired) },
+        { "pool_timeouts",              std::to_string(current.timeouts) },
+        { "pool_validation_failures",   std::to_string(current.validationFailures) },
+        { "pool_reconnect_failures",    std::to_string(current.reconnectFailures) }
+    };
+
+    const auto& buckets = CONNECTION_POOL_CONSTANTS::WAIT_BUCKETS_MS;
+    for (std::size_t i = 0; i < buckets.size(); ++i) {
+        values["pool_wait_le_" + std::to_string(buckets[i]) + "ms"] = std::to_string(current.waitHistogram[i]);
+    }
+    values["pool_wait_gt_" + std::to_string(buckets.back()) + "ms"] = std::to_string(current.waitHistogram.back());
+    return values;
+}
+
+SchemaCatalog& ConnectionPool::schemaCatalog()
+{
+    return m_schemaCatalog;
+}
+
+void ConnectionPool::shutdown()
+{
+    std::deque<PooledConnection> idle;
+    {
+        std::lock_guard<std::mutex> lock(m_poolData.mutex);
+        m_poolData.stopping = true;
+        m_poolData.initialized = false;
+        idle.swap(m_poolData.connections);
+        m_poolData.total -= static_cast<Types::uint>(idle.size());
+        m_poolData.statistics.destroyed += idle.size();
+        m_poolData.maintenanceCondition.notify_all();
+        m_poolData.condition.notify_all();
+    }
+    if (m_poolData.maintenance.joinable()) {
+        m_poolData.maintenance.join();
+    }
+    for (const auto& pooled : idle) {
+        closeConnection(pooled.connection);
+    }
+}
+
+void ConnectionPool::maintain()
+{
+    auto backoff = CONNECTION_POOL_CONSTANTS::INITIAL_RECONNECT_BACKOFF;
+    auto wait = CONNECTION_POOL_CONSTANTS::MAINTENANCE_INTERVAL;
+
+    std::unique_lock<std::mutex> lock(m_poolData.mutex);
+    while (!m_poolData.stopping) {
+        m_poolData.maintenanceCondition.wait_for(lock, wait);
+        if (m_poolData.stopping) {
+            break;
+        }
+        wait = CONNECTION_POOL_CONSTANTS::MAINTENANCE_INTERVAL;
+
+        // Reap connections idle for too long, oldest first, without going below the minimum
+        std::vector<Types::SqlConnection> expired;
+        const auto now = std::chrono::steady_clock::now();
+        while (!m_poolData.connections.empty()
+               && m_poolData.total > m_poolData.minSize
+               && now - m_poolData.connections.front().lastUsedAt > m_poolData.idleTimeout) {
+            expired.push_back(m_poolData.connections.front().connection);
+            m_poolData.connections.pop_front();
+            --m_poolData.total;
+            ++m_poolData.statistics.destroyed;
+        }
+
+        // Restore the minimum, backing off while the server is unreachable
+        const bool refill = m_poolData.total < m_poolData.minSize;
+        if (refill) {
+            ++m_poolData.total;
+        }
+
+        lock.unlock();
+        for (const auto& connection : expired) {
+            closeConnection(connection);
+        }
+        std::optional<Types::SqlConnection> opened;
+        if (refill) {
+            try {
+                opened = openConnection();
+            } catch (const std::exception&) {
+            }
+        }
+        lock.lock();
+
+        if (!refill) {
+            continue;
+        }
+        if (opened) {
+            ++m_poolData.statistics.created;
+            m_poolData.connections.push_front({ *opened, std::chrono::steady_clock::now() });
+            m_poolData.condition.notify_one();
+            backoff = CONNECTION_POOL_CONSTANTS::INITIAL_RECONNECT_BACKOFF;
+            wait = std::chrono::milliseconds::zero();
+        } else {
+            --m_poolData.total;
+            ++m_poolData.statistics.reconnectFailures;
+            wait = backoff;
+            backoff = std::min(backoff * 2, CONNECTION_POOL_CONSTANTS::MAX_RECONNECT_BACKOFF);
+        }
+    }
+}
+
+void ConnectionPool::recordWait(std::chrono::steady_clock::duration waited)
+{
+    ++m_poolData.statistics.acquired;
+    ++m_poolData.statistics.inUse;
+
+    const auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(waited).count();
+    const auto& buckets = CONNECTION_POOL_CONSTANTS::WAIT_BUCKETS_MS;
+    const auto bucket = std::lower_bound(buckets.begin(), buckets.end(), milliseconds) - buckets.begin();
+    ++m_poolData.statistics.waitHistogram[static_cast<std::size_t>(bucket)];
 }
 
 CELL_NAMESPACE_END
@@ -15,7 +15,8 @@
 #ifndef CELL_DATABASE_CONNECTION_POOL_ABSTRACT_HPP
 #define CELL_DATABASE_CONNECTION_POOL_ABSTRACT_HPP
 
-#if defined(USE_MYSQL_MARIADB) && defined(USE_POSTGRESQL) && defined(USE_SQLITE) && defined(USE_MSSQL) && defined(USE_ORACLE)
+//! A pool needs at least one driver, whose handles make up Types::SqlConnection.
+#if defined(USE_MYSQL_MARIADB) || defined(USE_POSTGRESQL) || defined(USE_SQLITE) || defined(USE_MSSQL) || defined(USE_ORACLE)
 
 //! Cell's Common.
 #if __has_include(<common>)
@@ -31,8 +32,70 @@
 #   error "Cell's requirements was not found!"
 #endif
 
+#if __has_include("schemacatalog.hpp")
+#   include "schemacatalog.hpp"
+#else
+#   error "Cell's schemacatalog was not found!"
+#endif
+
 CELL_NAMESPACE_BEGIN(Cell::Abstracts)
 
+/**
+ * @brief Constants related to connection pools.
+ */
+struct CONNECTION_POOL_CONSTANTS final
+{
+    __cell_static_const_constexpr std::chrono::milliseconds DEFAULT_ACQUIRE_TIMEOUT     {30000};   //!< How long getConnection() waits for a free connection.
+    __cell_static_const_constexpr std::chrono::milliseconds DEFAULT_IDLE_TIMEOUT        {600000};  //!< Idle connections above the minimum are closed after this.
+    __cell_static_const_constexpr std::chrono::milliseconds DEFAULT_VALIDATION_INTERVAL {5000};    //!< Connections idle longer than this are pinged before reuse.
+    __cell_static_const_constexpr std::chrono::milliseconds MAINTENANCE_INTERVAL        {1000};    //!< How often idle connections are reaped and the minimum restored.
+    __cell_static_const_constexpr std::chrono::milliseconds INITIAL_RECONNECT_BACKOFF   {100};     //!< Delay after the first failed reconnection.
+    __cell_static_const_constexpr std::chrono::milliseconds MAX_RECONNECT_BACKOFF       {30000};   //!< Upper bound of the reconnection delay.
+
+    /**
+     * @brief Upper bounds, in milliseconds, of the acquire wait time histogram buckets; the last bucket is unbounded.
+     */
+    __cell_static_const_constexpr std::array<std::int64_t, 7> WAIT_BUCKETS_MS { 1, 5, 10, 50, 100, 500, 1000 };
+};
+
+/**
+ * @brief Thrown when no connection becomes available within the acquire timeout.
+ */
+struct PoolTimeoutError : std::runtime_error
+{
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * @brief An idle connection kept by the pool.
+ */
+struct PooledConnection final
+{
+    Types::SqlConnection                    connection  {}; //!< The driver connection.
+    std::chrono::steady_clock::time_point   lastUsedAt  {}; //!< When the connection was returned to the pool.
+};
+
+/**
+ * @brief Counters describing the state and history of a connection pool.
+ */
+struct PoolStatistics final
+{
+    Types::uint     idle                {}; //!< Open connections waiting in the pool.
+    Types::uint     inUse               {}; //!< Connections currently borrowed.
+    Types::uint     waiting             {}; //!< Callers blocked in getConnection().
+    std::uint64_t   created             {}; //!< Connections opened since initialization.
+    std::uint64_t   destroyed           {}; //!< Connections closed since initialization.
+    std::uint64_t   acquired            {}; //!< Successful getConnection() calls.
+    std::uint64_t   timeouts            {}; //!< getConnection() calls that gave up.
+    std::uint64_t   validationFailures  {}; //!< Idle connections that failed the ping on borrow.
+    std::uint64_t   reconnectFailures   {}; //!< Failed attempts to open a connection in the background.
+
+    /**
+     * @brief Acquire wait times, bucketed by CONNECTION_POOL_CONSTANTS::WAIT_BUCKETS_MS plus one overflow bucket.
+     */
+    std::array<std::uint64_t, CONNECTION_POOL_CONSTANTS::WAIT_BUCKETS_MS.size() + 1> waitHistogram {};
+};
+
 /**
  * @brief Represents the data required for configuring a connection pool.
  */
@@ -44,19 +107,36 @@ struct PoolData final
     Types::OptionalString password  {}; //!< Optional password for the database user.
     Types::OptionalString database  {}; //!< Optional name of the database to connect to.
     Types::uint           poolSize  {}; //!< Maximum number of connections in the pool.
+    Types::uint           minSize   { 1 }; //!< Connections kept open even when idle.
+
+    std::chrono::milliseconds acquireTimeout        { CONNECTION_POOL_CONSTANTS::DEFAULT_ACQUIRE_TIMEOUT };     //!< Maximum wait in getConnection().
+    std::chrono::milliseconds idleTimeout           { CONNECTION_POOL_CONSTANTS::DEFAULT_IDLE_TIMEOUT };        //!< Idle time after which surplus connections are closed.
+    std::chrono::milliseconds validationInterval    { CONNECTION_POOL_CONSTANTS::DEFAULT_VALIDATION_INTERVAL }; //!< Idle time after which a connection is pinged on borrow.
 
-    Types::DbConnectionQueue connections    {}; //!< Queue of available database connections.
-    Types::ConditionVariable condition      {}; //!< Condition variable for managing connection availability.
+    std::deque<PooledConnection> connections    {}; //!< Idle connections; the most recently used is at the back.
+    Types::uint                  total          {}; //!< Open connections, idle or borrowed (including ones being opened).
+    Types::ConditionVariable     condition      {}; //!< Condition variable for managing connection availability.
+    PoolStatistics               statistics     {}; //!< Pool counters.
+
+    std::thread                  maintenance            {}; //!< Background reaper and reconnector.
+    Types::ConditionVariable     maintenanceCondition   {}; //!< Wakes the maintenance thread.
+    bool                         initialized            { false };
+    bool                         stopping               { false };
 
     Types::OptionalString keyPath   {}; //!< Optional file path to the private key for SSL/TLS connection.
     Types::OptionalString certPath  {}; //!< Optional file path to the certificate for SSL/TLS connection.
     Types::OptionalString caPath    {}; //!< Optional file path to the CA certificate for SSL/TLS connection.
 
-    Types::Mutex mutex              {}; //!< Mutex for ensuring thread-safe access to the connection pool.
+    mutable Types::Mutex mutex      {}; //!< Mutex for ensuring thread-safe access to the connection pool.
 };
 
 /**
- * @brief The abstract base class for a connection pool.
+ * @brief The base class for a connection pool.
+ *
+ * The pool grows lazily between a minimum and a maximum size, reuses the most recently returned
+ * connection first, pings connections that sat idle longer than the validation interval before handing
+ * them out, and closes surplus idle connections in the background. Drivers only provide
+ * openConnection(), pingConnection() and closeConnection(), and call shutdown() from their destructor.
  */
 class ConnectionPool {
 public:
@@ -67,25 +147,46 @@ public:
 
     /**
      * @brief Initialize the connection pool.
+     *
+     * Opens the minimum number of connections and starts the maintenance thread.
+     *
+     * @throws std::runtime_error If the minimum number of connections cannot be opened.
      */
-    __cell_virtual void initialize() = __cell_zero;
-
+    __cell_virtual void initialize();
 
-    __cell_virtual bool isInitialized() const = __cell_zero;
+    __cell_virtual bool isInitialized() const;
 
     /**
      * @brief Get a connection from the pool.
      *
+     * Waits at most the acquire timeout for a connection.
+     *
      * @return SqlConnection Pointer to a connection object.
+     * @throws PoolTimeoutError If no connection became available in time.
      */
-    __cell_virtual Types::SqlConnection getConnection() = __cell_zero;
+    __cell_virtual Types::SqlConnection getConnection();
+
+    /**
+     * @brief Get a connection from the pool, waiting at most the given time.
+     *
+     * @param timeout The maximum time to wait.
+     * @throws PoolTimeoutError If no connection became available in time.
+     */
+    Types::SqlConnection getConnection(std::chrono::milliseconds timeout);
 
     /**
      * @brief Release a connection back to the pool.
      *
      * @param connection Pointer to the connection object to release.
      */
-    __cell_virtual void releaseConnection(Types::SqlConnection connection) = __cell_zero;
+    __cell_virtual void releaseConnection(Types::SqlConnection connection);
+
+    /**
+     * @brief Closes a borrowed connection that is known to be broken instead of returning it to the pool.
+     *
+     * @param connection The connection to close.
+     */
+    void discardConnection(Types::SqlConnection connection);
 
     /**
      * @brief Enable encryption for the connections in the pool.
@@ -95,8 +196,94 @@ public:
      * @param caPath Path to the CA (Certificate Authority) file for encryption.
      */
     __cell_virtual void enableEncryption(const std::string& keyPath, const std::string& certPath, const std::string& caPath) = __cell_zero;
-};
 
+    /**
+     * @brief Sets the number of connections kept open and the maximum number of connections.
+     *
+     * @param minSize Connections kept open even when idle.
+     * @param maxSize Connections open at most.
+     */
+    void setPoolLimits(Types::uint minSize, Types::uint maxSize);
+
+    /**
+     * @brief Sets how long getConnection() waits for a free connection.
+     */
+    void setAcquireTimeout(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Sets how long surplus connections may stay idle before they are closed.
+     */
+    void setIdleTimeout(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Sets how long a connection may stay idle before it is pinged on borrow.
+     */
+    void setValidationInterval(std::chrono::milliseconds interval);
+
+    /**
+     * @brief Measures how far the server behind a connection is behind its primary.
+     *
+     * The default reports no lag; drivers that support replicas ask the server.
+     *
+     * @param connection A connection borrowed from this pool.
+     * @return The lag; zero for a server that is not a replica, std::nullopt if its replication is stopped.
+     * @throws std::runtime_error If the server cannot be asked.
+     */
+    __cell_virtual std::optional<std::chrono::milliseconds> replicationLag(const Types::SqlConnection& connection);
+
+    /**
+     * @brief Returns a snapshot of the pool counters.
+     */
+    PoolStatistics statistics() const;
+
+    /**
+     * @brief Returns the pool counters as name/value pairs, for getConnectionStatistics().
+     */
+    std::map<std::string, std::string> statisticsMap() const;
+
+    /**
+     * @brief Returns the schema catalog shared by every connection of the pool.
+     */
+    SchemaCatalog& schemaCatalog();
+
+protected:
+    /**
+     * @brief Opens a new driver connection.
+     *
+     * @throws std::runtime_error If the connection cannot be opened.
+     */
+    __cell_virtual Types::SqlConnection openConnection() = __cell_zero;
+
+    /**
+     * @brief Checks a connection with a round trip to the server.
+     */
+    __cell_virtual bool pingConnection(const Types::SqlConnection& connection) = __cell_zero;
+
+    /**
+     * @brief Closes a driver connection.
+     */
+    __cell_virtual void closeConnection(const Types::SqlConnection& connection) = __cell_zero;
+
+    /**
+     * @brief Stops the maintenance thread and closes the idle connections; called by the driver's destructor.
+     */
+    void shutdown();
+
+    PoolData m_poolData {}; //!< The pool data used to manage connections.
+
+private:
+    /**
+     * @brief Reaps idle connections above the minimum and reopens connections below it.
+     */
+    void maintain();
+
+    /**
+     * @brief Records how long a successful getConnection() call waited; the mutex must be held.
+     */
+    void recordWait(std::chrono::steady_clock::duration waited);
+
+    SchemaCatalog m_schemaCatalog {}; //!< Tables, columns, keys and indexes of the pool's database.
+};
 
 CELL_NAMESPACE_END
 
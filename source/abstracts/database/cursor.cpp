@@ -0,0 +1,25 @@
+#if __has_include("cursor.hpp")
+#   include "cursor.hpp"
+#else
+#   error "Cell's cursor was not found!"
+#endif
+
+CELL_USING_NAMESPACE Cell;
+
+CELL_NAMESPACE_BEGIN(Cell::Abstracts)
+
+/*!
+ * \brief Constructs an abstract Cursor.
+ */
+Cursor::Cursor()
+{
+}
+
+/*!
+ * \brief Destroys the Cursor.
+ */
+Cursor::~Cursor()
+{
+}
+
+CELL_NAMESPACE_END
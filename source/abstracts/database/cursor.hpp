@@ -0,0 +1,130 @@
+/*!
+ * @file        cursor.hpp
+ * @brief       Database cursor for the Cell Engine.
+ * @details     This file defines Cursor, which streams a query result in batches with constant memory.
+ * @author      Kambiz Asadzadeh
+ * @since       07 Jun 2023
+ * @version     1.0
+ * @note        This is part of the Cell Engine, developed by Kambiz Asadzadeh.
+ *
+ * @license     This file is licensed under the terms of the Genyleap License. See the LICENSE.md file for more information.
+ * @copyright   Copyright (c) 2025 The Genyleap | Kambiz Asadzadeh. All rights reserved.
+ * @see         https://github.com/genyleap/cell
+ */
+
+#ifndef CELL_DATABASE_CURSOR_ABSTRACT_HPP
+#define CELL_DATABASE_CURSOR_ABSTRACT_HPP
+
+//! Cell's Common.
+#if __has_include(<common>)
+#   include <common>
+#else
+#   error "Cell's common was not found!"
+#endif
+
+//! Cell's Core (Core Only).
+#if __has_include(<core>)
+#   include <core>
+#else
+#   error "Cell's requirements was not found!"
+#endif
+
+#if __has_include("resultset.hpp")
+#   include "resultset.hpp"
+#else
+#   error "Cell's resultset was not found!"
+#endif
+
+CELL_NAMESPACE_BEGIN(Cell::Abstracts)
+
+/**
+ * @brief Constants related to cursors.
+ */
+struct CURSOR_CONSTANTS final
+{
+    __cell_static_const_constexpr std::size_t DEFAULT_BATCH_SIZE = 1000; //!< Rows fetched per round trip.
+};
+
+/**
+ * @brief Options for opening a cursor.
+ */
+struct CursorOptions final
+{
+    std::size_t     batchSize   { CURSOR_CONSTANTS::DEFAULT_BATCH_SIZE };  //!< Rows per batch, where the driver can batch.
+    ResultFormat    format      { ResultFormat::Text };                     //!< Wire format of the values.
+};
+
+/**
+ * @brief The base class for a cursor that streams a query result.
+ *
+ * Rows are read from the server only when the consumer asks for the next batch, and the previous batch
+ * is released before the next one is read, so memory stays constant whatever the size of the result. A
+ * slow consumer simply leaves the rest of the result on the server (or in the socket buffers), which is
+ * the backpressure.
+ *
+ * A cursor holds its connection until it is exhausted or closed.
+ */
+class Cursor {
+public:
+    /**
+     * @brief Default constructor and destructor.
+     */
+    CELL_DEFAULT_INTERFACE_OCTORS(Cursor)
+
+    /**
+     * @brief Disable copy construction and assignment for a class.
+     */
+    CELL_DISABLE_COPY(Cursor)
+
+    /**
+     * @brief Reads the next batch of rows.
+     *
+     * The returned batch, and every view taken from it, is invalidated by the next call.
+     *
+     * @return The batch, or nullptr once the result is exhausted (the cursor is then closed).
+     * @throws std::runtime_error If reading fails; the cursor is closed.
+     */
+    __cell_virtual const ResultSet* fetch() = __cell_zero;
+
+    /**
+     * @brief Stops reading, releases the server-side resources and returns the connection.
+     */
+    __cell_virtual void close() = __cell_zero;
+
+    /**
+     * @brief Checks whether rows may still be read.
+     */
+    __cell_virtual bool isOpen() const = __cell_zero;
+
+    /**
+     * @brief Calls a visitor for every remaining row.
+     *
+     * @param visitor Called with a ResultRow; if it returns bool, false stops the iteration and closes the cursor.
+     * @return The number of rows visited.
+     */
+    template <typename Visitor>
+    std::size_t forEach(Visitor&& visitor)
+    {
+        std::size_t visited = 0;
+        while (const ResultSet* batch = fetch()) {
+            for (const ResultRow row : *batch) {
+                ++visited;
+                if constexpr (std::is_same_v<std::invoke_result_t<Visitor&, ResultRow>, bool>) {
+                    if (!visitor(row)) {
+                        close();
+                        return visited;
+                    }
+                } else {
+                    visitor(row);
+                }
+            }
+        }
+        return visited;
+    }
+};
+
+using CursorPtr = std::unique_ptr<Cursor>;
+
+CELL_NAMESPACE_END
+
+#endif // CELL_DATABASE_CURSOR_ABSTRACT_HPP
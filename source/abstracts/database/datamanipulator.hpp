@@ -29,6 +29,12 @@
 #   error "Cell's requirements was not found!"
 #endif
 
+#if __has_include("keyset.hpp")
+#   include "keyset.hpp"
+#else
+#   error "Cell's keyset was not found!"
+#endif
+
 CELL_NAMESPACE_BEGIN(Cell::Abstracts)
 
 /**
@@ -81,6 +87,9 @@ public:
     /**
      * @brief Query data from a table with pagination.
      *
+     * The page is selected with LIMIT and OFFSET, so the server reads and discards every row before it;
+     * use queryWithKeyset() to page deep into large tables.
+     *
      * @param sql The SQL query string.
      * @param pageNumber The page number of the result set to retrieve.
      * @param pageSize The number of records per page.
@@ -88,6 +97,25 @@ public:
      */
     __cell_virtual std::vector<std::vector<std::string>> queryWithPagination(const std::string& sql, int pageNumber, int pageSize) = __cell_zero;
 
+    /**
+     * @brief Query data page by page, seeking past the ordering key of the previous page.
+     *
+     * Unlike queryWithPagination(), a deep page costs the same as the first one when an index covers
+     * the key columns. See KeysetPagination for what the query and the key must look like.
+     *
+     * @param sql The SQL query string, without ORDER BY or LIMIT.
+     * @param ordering The key columns, most significant first; together they must be unique and not NULL.
+     * @param pageSize The number of records per page.
+     * @param continuation The token of the previous page; empty for the first page.
+     * @return KeysetPage The rows of the page and the token of the next one.
+     * @throws std::invalid_argument If the ordering, page size or token is invalid.
+     * @throws std::runtime_error If the query fails.
+     */
+    __cell_virtual KeysetPage queryWithKeyset(const std::string& sql,
+                                              const std::vector<KeysetColumn>& ordering,
+                                              std::size_t pageSize,
+                                              const std::string& continuation = {}) = __cell_zero;
+
     /**
      * @brief Get the row count of a table.
      *
@@ -0,0 +1,261 @@
+#if __has_include("keyset.hpp")
+#   include "keyset.hpp"
+#else
+#   error "Cell's keyset was not found!"
+#endif
+
+CELL_USING_NAMESPACE Cell;
+
+CELL_NAMESPACE_BEGIN(Cell::Abstracts)
+
+namespace {
+
+constexpr std::string_view derivedTable = "cell_keyset";
+constexpr std::string_view base64Alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+/**
+ * @brief Returns a fingerprint of an ordering, so a token is not reused with another one.
+ */
+std::string fingerprint(const std::vector<KeysetColumn>& ordering)
+{
+    // FNV-1a over the names and directions
+    std::uint64_t hash = 14695981039346656037ULL;
+    const auto mix = [&hash](unsigned char byte) {
+        hash ^= byte;
+        hash *= 1099511628211ULL;
+    };
+    for (const auto& column : ordering) {
+        for (const char character : column.name) {
+            mix(static_cast<unsigned char>(character));
+        }
+        mix(0);
+        mix(static_cast<unsigned char>(column.direction));
+    }
+    std::array<char, 16> digits {};
+    for (std::size_t i = 0; i < digits.size(); ++i) {
+        digits[digits.size() - 1 - i] = "0123456789abcdef"[(hash >> (i * 4)) & 0xF];
+    }
+    return std::string(digits.data(), digits.size());
+}
+
+/**
+ * @brief Encodes bytes as unpadded base64url, safe in URLs and headers.
+ */
+std::string encodeBase64Url(std::string_view bytes)
+{
+    std::string encoded;
+    encoded.reserve((bytes.size() + 2) / 3 * 4);
+    std::uint32_t buffer = 0;
+    int bits = 0;
+    for (const char character : bytes) {
+        buffer = (buffer << 8) | static_cast<unsigned char>(character);
+        bits += 8;
+        while (bits >= 6) {
+            bits -= 6;
+            encoded += base64Alphabet[(buffer >> bits) & 0x3F];
+        }
+    }
+    if (bits > 0) {
+        encoded += base64Alphabet[(buffer << (6 - bits)) & 0x3F];
+    }
+    return encoded;
+}
+
+/**
+ * @brief Decodes unpadded base64url.
+ */
+std::optional<std::string> decodeBase64Url(std::string_view encoded)
+{
+    std::string bytes;
+    bytes.reserve(encoded.size() * 3 / 4);
+    std::uint32_t buffer = 0;
+    int bits = 0;
+    for (const char character : encoded) {
+        const auto value = base64Alphabet.find(character);
+        if (value == std::string_view::npos) {
+            return std::nullopt;
+        }
+        buffer = (buffer << 6) | static_cast<std::uint32_t>(value);
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            bytes += static_cast<char>((buffer >> bits) & 0xFF);
+        }
+    }
+    return bytes;
+}
+
+/**
+ * @brief Returns a key column as the outer statement refers to it.
+ */
+std::string columnReference(const KeysetColumn& column, const KeysetDialect& dialect)
+{
+    return std::string(derivedTable) + "." + dialect.quoteIdentifier(column.name);
+}
+
+/**
+ * @brief Returns the comparison that selects rows after a key in a column's direction.
+ */
+std::string_view after(const KeysetColumn& column, bool inclusive = false)
+{
+    if (column.direction == SortDirection::Ascending) {
+        return inclusive ? " >= " : " > ";
+    }
+    return inclusive ? " <= " : " < ";
+}
+
+/**
+ * @brief Builds the predicate selecting the rows after a key.
+ */
+std::string seekPredicate(const std::vector<KeysetColumn>& ordering, const std::vector<std::string>& key,
+                          const KeysetDialect& dialect, std::vector<std::string>& params)
+{
+    const auto bind = [&dialect, &params](const std::string& value) {
+        params.push_back(value);
+        return dialect.placeholder(params.size());
+    };
+
+    const bool uniform = std::ranges::all_of(ordering, [&ordering](const KeysetColumn& column) {
+        return column.direction == ordering.front().direction;
+    });
+    if (uniform && ordering.size() == 1) {
+        return columnReference(ordering.front(), dialect) + std::string(after(ordering.front())) + bind(key.front());
+    }
+    if (uniform) {
+        // A row comparison is a single range on a composite index
+        std::string columns;
+        std::string values;
+        for (std::size_t i = 0; i < ordering.size(); ++i) {
+            columns += (i == 0 ? "" : ", ") + columnReference(ordering[i], dialect);
+            values += (i == 0 ? "" : ", ") + bind(key[i]);
+        }
+        return "(" + columns + ")" + std::string(after(ordering.front())) + "(" + values + ")";
+    }
+
+    // Mixed directions cannot be one row comparison; the leading bound keeps the index seek
+    std::string predicate = columnReference(ordering.front(), dialect) + std::string(after(ordering.front(), true)) + bind(key.front());
+    std::string expanded;
+    std::string closing;
+    for (std::size_t i = 0; i < ordering.size(); ++i) {
+        const std::string column = columnReference(ordering[i], dialect);
+        expanded += "(" + column + std::string(after(ordering[i])) + bind(key[i]);
+        if (i + 1 < ordering.size()) {
+            expanded += " OR (" + column + " = " + bind(key[i]) + " AND ";
+            closing += "))";
+        } else {
+            expanded += ")";
+        }
+    }
+    return predicate + " AND " + expanded + closing;
+}
+
+}  // namespace
+
+KeysetQuery KeysetPagination::build(std::string_view sql,
+                                    const std::vector<KeysetColumn>& ordering,
+                                    std::size_t pageSize,
+                                    std::string_view continuation,
+                                    const KeysetDialect& dialect,
+                                    const std::vector<std::string>& params)
+{
+    if (ordering.empty()) {
+        throw std::invalid_argument("A keyset page needs at least one key column.");
+    }
+    if (pageSize == 0) {
+        throw std::invalid_argument("The page size must be positive.");
+    }
+
+    // A trailing terminator would end the derived table early
+    while (!sql.empty() && (std::isspace(static_cast<unsigned char>(sql.back())) || sql.back() == ';')) {
+        sql.remove_suffix(1);
+    }
+
+    KeysetQuery query;
+    query.params = params;
+    query.sql = "SELECT " + std::string(derivedTable) + ".*";
+    for (std::size_t i = 0; i < ordering.size(); ++i) {
+        query.sql += ", " + columnReference(ordering[i], dialect) + " AS " + dialect.quoteIdentifier("cell_key_" + std::to_string(i));
+    }
+    query.sql += " FROM (" + std::string(sql) + ") AS " + std::string(derivedTable);
+
+    if (!continuation.empty()) {
+        query.sql += " WHERE " + seekPredicate(ordering, decodeToken(ordering, continuation), dialect, query.params);
+    }
+
+    query.sql += " ORDER BY ";
+    for (std::size_t i = 0; i < ordering.size(); ++i) {
+        query.sql += (i == 0 ? "" : ", ") + columnReference(ordering[i], dialect)
+                     + (ordering[i].direction == SortDirection::Ascending ? " ASC" : " DESC");
+    }
+    query.sql += " LIMIT " + std::to_string(pageSize + 1);
+    return query;
+}
+
+KeysetPage KeysetPagination::page(std::vector<std::vector<std::string>> rows,
+                                  const std::vector<KeysetColumn>& ordering,
+                                  std::size_t pageSize)
+{
+    KeysetPage page;
+    const bool hasMore = rows.size() > pageSize;
+    if (hasMore) {
+        rows.resize(pageSize);
+    }
+
+    const std::size_t keyColumns = ordering.size();
+    for (auto& row : rows) {
+        if (row.size() < keyColumns) {
+            throw std::invalid_argument("A row is missing its key columns.");
+        }
+    }
+    if (hasMore && !rows.empty()) {
+        const auto& last = rows.back();
+        page.continuation = encodeToken(ordering, std::vector<std::string>(last.end() - static_cast<std::ptrdiff_t>(keyColumns), last.end()));
+    }
+    for (auto& row : rows) {
+        row.resize(row.size() - keyColumns);
+    }
+    page.rows = std::move(rows);
+    return page;
+}
+
+std::string KeysetPagination::encodeToken(const std::vector<KeysetColumn>& ordering, const std::vector<std::string>& key)
+{
+    if (key.size() != ordering.size()) {
+        throw std::invalid_argument("The key does not match the ordering.");
+    }
+    // Length-prefixed values, so any byte may appear in a key
+    std::string payload = fingerprint(ordering);
+    for (const auto& value : key) {
+        payload += std::to_string(value.size()) + ":" + value;
+    }
+    return encodeBase64Url(payload);
+}
+
+std::vector<std::string> KeysetPagination::decodeToken(const std::vector<KeysetColumn>& ordering, std::string_view token)
+{
+    const auto payload = decodeBase64Url(token);
+    const std::string expected = fingerprint(ordering);
+    if (!payload || !payload->starts_with(expected)) {
+        throw std::invalid_argument("The continuation token is invalid or belongs to another ordering.");
+    }
+
+    std::vector<std::string> key;
+    key.reserve(ordering.size());
+    std::string_view rest = std::string_view(*payload).substr(expected.size());
+    while (!rest.empty()) {
+        const auto colon = rest.find(':');
+        std::size_t length {};
+        const auto [end, error] = std::from_chars(rest.data(), rest.data() + (colon == std::string_view::npos ? 0 : colon), length);
+        if (colon == std::string_view::npos || error != std::errc {} || end != rest.data() + colon || rest.size() - colon - 1 < length) {
+            throw std::invalid_argument("The continuation token is invalid or belongs to another ordering.");
+        }
+        key.emplace_back(rest.substr(colon + 1, length));
+        rest.remove_prefix(colon + 1 + length);
+    }
+    if (key.size() != ordering.size()) {
+        throw std::invalid_argument("The continuation token is invalid or belongs to another ordering.");
+    }
+    return key;
+}
+
+CELL_NAMESPACE_END
@@ -0,0 +1,156 @@
+/*!
+ * @file        keyset.hpp
+ * @brief       Keyset (seek) pagination for the Cell Engine.
+ * @details     This file defines KeysetPagination, which pages through a query by its ordering key instead of an offset.
+ * @author      Kambiz Asadzadeh
+ * @since       07 Jun 2023
+ * @version     1.0
+ * @note        This is part of the Cell Engine, developed by Kambiz Asadzadeh.
+ *
+ * @license     This file is licensed under the terms of the Genyleap License. See the LICENSE.md file for more information.
+ * @copyright   Copyright (c) 2025 The Genyleap | Kambiz Asadzadeh. All rights reserved.
+ * @see         https://github.com/genyleap/cell
+ */
+
+#ifndef CELL_DATABASE_KEYSET_ABSTRACT_HPP
+#define CELL_DATABASE_KEYSET_ABSTRACT_HPP
+
+//! Cell's Common.
+#if __has_include(<common>)
+#   include <common>
+#else
+#   error "Cell's common was not found!"
+#endif
+
+//! Cell's Core (Core Only).
+#if __has_include(<core>)
+#   include <core>
+#else
+#   error "Cell's requirements was not found!"
+#endif
+
+CELL_NAMESPACE_BEGIN(Cell::Abstracts)
+
+/**
+ * @brief The direction a key column is ordered in.
+ */
+enum class SortDirection : Types::u8
+{
+    Ascending,      //!< Smallest first.
+    Descending      //!< Largest first.
+};
+
+/**
+ * @brief A column of the ordering key.
+ */
+struct KeysetColumn final
+{
+    std::string     name        {};                             //!< The column, as the query's result names it.
+    SortDirection   direction   { SortDirection::Ascending };   //!< Its order.
+};
+
+/**
+ * @brief A page of rows and where the next one starts.
+ */
+struct KeysetPage final
+{
+    std::vector<std::vector<std::string>>   rows            {}; //!< The rows of the page, without a header.
+    std::string                             continuation    {}; //!< Token of the next page; empty on the last page.
+
+    /**
+     * @brief Checks whether another page follows.
+     */
+    bool hasMore() const { return !continuation.empty(); }
+};
+
+/**
+ * @brief A statement that reads one page, and the values to bind to it.
+ */
+struct KeysetQuery final
+{
+    std::string                 sql     {}; //!< The statement.
+    std::vector<std::string>    params  {}; //!< Values of its placeholders, in order.
+};
+
+/**
+ * @brief The driver-specific spelling of a keyset statement.
+ */
+struct KeysetDialect final
+{
+    /**
+     * @brief Returns the placeholder of the parameter at a 1-based position.
+     */
+    std::string (*placeholder)(std::size_t position) {};
+
+    /**
+     * @brief Quotes an identifier.
+     */
+    std::string (*quoteIdentifier)(std::string_view name) {};
+};
+
+/**
+ * @brief Pages through a query by its ordering key.
+ *
+ * An OFFSET makes the server produce and throw away every row before the page, so deep pages get
+ * slower the deeper they are. A keyset page instead starts after the last row of the previous page,
+ * with a predicate on the ordering key that an index on the key columns answers with one seek, so
+ * every page costs the same.
+ *
+ * The query is wrapped as a derived table, which PostgreSQL and MySQL 5.7+ merge into the outer
+ * statement so the predicate still reaches the index. The key columns must be in its select list,
+ * must not be NULL, and together must be unique (end the key with the primary key), or rows sharing
+ * a key could be skipped or repeated across pages. When every column runs in the same direction the
+ * predicate is a row comparison, `(a, b) > (?, ?)`; mixed directions are expanded, led by a bound on
+ * the first column so the seek is kept.
+ *
+ * The continuation token carries the last key of a page and a fingerprint of the ordering; it is
+ * opaque to callers and only its values are ever sent to the server, as bound parameters.
+ */
+class KeysetPagination {
+public:
+    /**
+     * @brief Builds the statement reading one page.
+     *
+     * @param sql The query, without ORDER BY or LIMIT.
+     * @param ordering The key columns, most significant first.
+     * @param pageSize The number of rows of a page.
+     * @param continuation The token of the previous page; empty for the first page.
+     * @param dialect The driver's placeholders and identifier quoting.
+     * @param params Values of the placeholders in the query itself; the page's own follow them.
+     * @return A statement that reads one row more than the page, to tell whether another follows.
+     * @throws std::invalid_argument If the ordering is empty, the page size is zero or the token is invalid.
+     */
+    static KeysetQuery build(std::string_view sql,
+                             const std::vector<KeysetColumn>& ordering,
+                             std::size_t pageSize,
+                             std::string_view continuation,
+                             const KeysetDialect& dialect,
+                             const std::vector<std::string>& params = {});
+
+    /**
+     * @brief Turns the rows read by a statement of build() into a page.
+     *
+     * @param rows The rows, each ending with the key columns build() appended.
+     * @param ordering The key columns given to build().
+     * @param pageSize The page size given to build().
+     */
+    static KeysetPage page(std::vector<std::vector<std::string>> rows,
+                           const std::vector<KeysetColumn>& ordering,
+                           std::size_t pageSize);
+
+    /**
+     * @brief Returns the token of the page that starts after a key.
+     */
+    static std::string encodeToken(const std::vector<KeysetColumn>& ordering, const std::vector<std::string>& key);
+
+    /**
+     * @brief Returns the key a token starts after.
+     *
+     * @throws std::invalid_argument If the token is malformed or was made for another ordering.
+     */
+    static std::vector<std::string> decodeToken(const std::vector<KeysetColumn>& ordering, std::string_view token);
+};
+
+CELL_NAMESPACE_END
+
+#endif  // CELL_DATABASE_KEYSET_ABSTRACT_HPP
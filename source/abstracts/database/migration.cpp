@@ -0,0 +1,156 @@
+#if __has_include("migration.hpp")
+#   include "migration.hpp"
+#else
+#   error "Cell's migration was not found!"
+#endif
+
+CELL_USING_NAMESPACE Cell;
+
+CELL_NAMESPACE_BEGIN(Cell::Abstracts)
+
+double MigrationProgress::rowsPerSecond() const
+{
+    return elapsed.count() > 0 ? static_cast<double>(rows) * 1000.0 / static_cast<double>(elapsed.count()) : 0.0;
+}
+
+TableMigration::TableMigration(std::string sql, const KeysetDialect& dialect, MigrationOptions options)
+    : m_sql(std::move(sql)), m_dialect(dialect), m_options(std::move(options))
+{
+    if (m_options.key.empty()) {
+        throw std::invalid_argument("A migration needs a key to read the rows in order.");
+    }
+    if (m_options.chunkRows == 0) {
+        throw std::invalid_argument("The chunk size must be positive.");
+    }
+    // The query is wrapped as a derived table, which a trailing terminator would end early
+    while (!m_sql.empty() && (std::isspace(static_cast<unsigned char>(m_sql.back())) || m_sql.back() == ';')) {
+        m_sql.pop_back();
+    }
+}
+
+MigrationProgress TableMigration::run(const Reader& reader, const Writer& writer, const std::vector<std::string>& boundaries)
+{
+    m_startedAt = std::chrono::steady_clock::now();
+    m_rows = 0;
+    m_chunks = 0;
+    m_lastReportMs = 0;
+    m_failed = false;
+
+    if (boundaries.empty()) {
+        copyRange(reader, writer, std::nullopt, std::nullopt);
+    } else {
+        // One worker per range: below the first boundary, between two boundaries, and from the last one on
+        std::exception_ptr error;
+        std::mutex errorMutex;
+        std::vector<std::thread> workers;
+        workers.reserve(boundaries.size() + 1);
+        for (std::size_t i = 0; i <= boundaries.size(); ++i) {
+            std::optional<std::string> lower = i == 0 ? std::nullopt : std::optional<std::string>(boundaries[i - 1]);
+            std::optional<std::string> upper = i == boundaries.size() ? std::nullopt : std::optional<std::string>(boundaries[i]);
+            workers.emplace_back([this, &reader, &writer, &error, &errorMutex, lower = std::move(lower), upper = std::move(upper)] {
+                try {
+                    copyRange(reader, writer, lower, upper);
+                } catch (...) {
+                    m_failed = true;
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    report(true);
+    return MigrationProgress {
+        .rows       = m_rows.load(),
+        .chunks     = m_chunks.load(),
+        .elapsed    = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_startedAt),
+        .finished   = true
+    };
+}
+
+void TableMigration::copyRange(const Reader& reader, const Writer& writer, const std::optional<std::string>& lower, const std::optional<std::string>& upper)
+{
+    // The range is a predicate on the first key column, bound rather than spliced into the statement
+    std::string sql = m_sql;
+    std::vector<std::string> params;
+    if (lower || upper) {
+        const std::string column = m_dialect.quoteIdentifier(m_options.key.front().name);
+        sql = "SELECT * FROM (" + m_sql + ") AS cell_range WHERE ";
+        if (lower) {
+            params.push_back(*lower);
+            sql += column + " >= " + m_dialect.placeholder(params.size());
+        }
+        if (upper) {
+            params.push_back(*upper);
+            sql += std::string(lower ? " AND " : "") + column + " < " + m_dialect.placeholder(params.size());
+        }
+    }
+
+    const std::size_t keyColumns = m_options.key.size();
+    std::string continuation;
+    while (!m_failed.load(std::memory_order_relaxed)) {
+        const auto query = KeysetPagination::build(sql, m_options.key, m_options.chunkRows, continuation, m_dialect, params);
+        const ResultSetPtr chunk = reader(query);
+        if (chunk->columnCount() < keyColumns) {
+            throw std::invalid_argument("A chunk is missing its key columns.");
+        }
+
+        const std::size_t rows = std::min(chunk->rowCount(), m_options.chunkRows);
+        const std::size_t columns = chunk->columnCount() - keyColumns;
+        if (rows > 0) {
+            writer(*chunk, rows, columns);
+            record(rows);
+        }
+        // The statement reads one row past the chunk; without it this was the last chunk
+        if (chunk->rowCount() <= m_options.chunkRows) {
+            return;
+        }
+
+        std::vector<std::string> key;
+        key.reserve(keyColumns);
+        for (std::size_t i = 0; i < keyColumns; ++i) {
+            key.emplace_back(chunk->value(rows - 1, columns + i));
+        }
+        continuation = KeysetPagination::encodeToken(m_options.key, key);
+    }
+}
+
+void TableMigration::record(std::size_t rows)
+{
+    m_rows.fetch_add(rows, std::memory_order_relaxed);
+    m_chunks.fetch_add(1, std::memory_order_relaxed);
+    if (!m_options.onProgress) {
+        return;
+    }
+
+    // Only the worker that claims the interval reports
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_startedAt).count();
+    std::int64_t last = m_lastReportMs.load(std::memory_order_relaxed);
+    if (elapsed - last >= m_options.progressInterval.count() && m_lastReportMs.compare_exchange_strong(last, elapsed)) {
+        report(false);
+    }
+}
+
+void TableMigration::report(bool finished)
+{
+    if (!m_options.onProgress) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_reportMutex);
+    m_options.onProgress(MigrationProgress {
+        .rows       = m_rows.load(),
+        .chunks     = m_chunks.load(),
+        .elapsed    = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_startedAt),
+        .finished   = finished
+    });
+}
+
+CELL_NAMESPACE_END
@@ -0,0 +1,170 @@
+/*!
+ * @file        migration.hpp
+ * @brief       Chunked table migration for the Cell Engine.
+ * @details     This file defines TableMigration, which copies a table in bounded chunks, optionally over several connections.
+ * @author      Kambiz Asadzadeh
+ * @since       07 Jun 2023
+ * @version     1.0
+ * @note        This is part of the Cell Engine, developed by Kambiz Asadzadeh.
+ *
+ * @license     This file is licensed under the terms of the Genyleap License. See the LICENSE.md file for more information.
+ * @copyright   Copyright (c) 2025 The Genyleap | Kambiz Asadzadeh. All rights reserved.
+ * @see         https://github.com/genyleap/cell
+ */
+
+#ifndef CELL_DATABASE_MIGRATION_ABSTRACT_HPP
+#define CELL_DATABASE_MIGRATION_ABSTRACT_HPP
+
+//! Cell's Common.
+#if __has_include(<common>)
+#   include <common>
+#else
+#   error "Cell's common was not found!"
+#endif
+
+//! Cell's Core (Core Only).
+#if __has_include(<core>)
+#   include <core>
+#else
+#   error "Cell's requirements was not found!"
+#endif
+
+#if __has_include("keyset.hpp")
+#   include "keyset.hpp"
+#else
+#   error "Cell's keyset was not found!"
+#endif
+
+#if __has_include("resultset.hpp")
+#   include "resultset.hpp"
+#else
+#   error "Cell's resultset was not found!"
+#endif
+
+CELL_NAMESPACE_BEGIN(Cell::Abstracts)
+
+/**
+ * @brief Constants related to table migrations.
+ */
+struct MIGRATION_CONSTANTS final
+{
+    __cell_static_const_constexpr std::size_t DEFAULT_CHUNK_ROWS = 10000;                         //!< Rows read and written at a time.
+    __cell_static_const_constexpr std::chrono::milliseconds DEFAULT_PROGRESS_INTERVAL {1000};       //!< Time between two progress reports.
+};
+
+/**
+ * @brief How far a migration has got.
+ */
+struct MigrationProgress final
+{
+    std::uint64_t               rows        {};         //!< Rows written so far.
+    std::uint64_t               chunks      {};         //!< Chunks written so far.
+    std::chrono::milliseconds   elapsed     {};         //!< Time since the migration started.
+    bool                        finished    { false };  //!< Whether every row has been written.
+
+    /**
+     * @brief Returns the average throughput since the start.
+     */
+    double rowsPerSecond() const;
+};
+
+/**
+ * @brief Options of a chunked migration.
+ */
+struct MigrationOptions final
+{
+    std::vector<KeysetColumn>   key                 {};                                                 //!< A unique, non-null ordering key, usually the primary key.
+    std::size_t                 chunkRows           { MIGRATION_CONSTANTS::DEFAULT_CHUNK_ROWS };        //!< Rows per chunk; each chunk is written on its own.
+    Types::uint                 parallelism         { 1 };                                              //!< Key ranges copied at the same time.
+    std::chrono::milliseconds   progressInterval    { MIGRATION_CONSTANTS::DEFAULT_PROGRESS_INTERVAL }; //!< Minimum time between two reports.
+
+    /**
+     * @brief Receives the progress at the interval and once more when the migration finishes.
+     *
+     * It is called from the worker threads, one call at a time.
+     */
+    std::function<void(const MigrationProgress&)> onProgress {};
+};
+
+/**
+ * @brief Copies the rows of a query in bounded chunks.
+ *
+ * Materializing a whole table and inserting it as one statement needs memory for all of it and one
+ * transaction as long as the copy. A migration instead reads one chunk at a time in key order, with
+ * the keyset predicate of KeysetPagination so every chunk is an index range scan, and hands it to a
+ * writer before the next one is read. Memory is bounded by one chunk per worker, and each chunk is
+ * committed on its own, so a failure loses only the chunk in flight.
+ *
+ * With boundaries the key's first column is split into ranges that are copied by one worker thread
+ * each. The reader and the writer are then called from several threads at once and must lease a
+ * connection per call, as the drivers do outside a transaction.
+ *
+ * The driver supplies both ends: the reader usually runs the statement on the source connection, and
+ * the writer streams the chunk into the destination, e.g. with COPY.
+ */
+class TableMigration {
+public:
+    /**
+     * @brief Runs a chunk statement on the source.
+     */
+    using Reader = std::function<ResultSetPtr(const KeysetQuery& query)>;
+
+    /**
+     * @brief Writes the first rows and columns of a chunk to the destination.
+     *
+     * The result set also carries one row more than the chunk and the key columns appended by
+     * KeysetPagination; only the given rows and columns belong to the table.
+     */
+    using Writer = std::function<void(const ResultSet& chunk, std::size_t rows, std::size_t columns)>;
+
+    /**
+     * @brief Prepares a migration.
+     *
+     * @param sql The query returning the rows to copy, e.g. `SELECT * FROM source`.
+     * @param dialect The source's placeholders and identifier quoting.
+     * @param options The key, chunk size, parallelism and progress callback.
+     * @throws std::invalid_argument If the key is empty or the chunk size is zero.
+     */
+    TableMigration(std::string sql, const KeysetDialect& dialect, MigrationOptions options);
+
+    /**
+     * @brief Copies every row.
+     *
+     * @param reader Runs chunk statements on the source.
+     * @param writer Writes chunks to the destination.
+     * @param boundaries Ascending values of the key's first column that split it into ranges; empty copies in this thread.
+     * @return The final progress.
+     * @throws The first exception thrown by the reader or the writer; the other workers stop after their current chunk.
+     */
+    MigrationProgress run(const Reader& reader, const Writer& writer, const std::vector<std::string>& boundaries = {});
+
+private:
+    /**
+     * @brief Copies the rows whose first key column lies in [lower, upper); an empty bound is open.
+     */
+    void copyRange(const Reader& reader, const Writer& writer, const std::optional<std::string>& lower, const std::optional<std::string>& upper);
+
+    /**
+     * @brief Adds a written chunk and reports the progress when the interval has passed.
+     */
+    void record(std::size_t rows);
+
+    /**
+     * @brief Calls the progress callback.
+     */
+    void report(bool finished);
+
+    std::string                             m_sql           {};     //!< The query returning the rows.
+    KeysetDialect                           m_dialect       {};     //!< The source's spelling.
+    MigrationOptions                        m_options       {};     //!< Migration options.
+    std::chrono::steady_clock::time_point   m_startedAt     {};     //!< When run() started.
+    std::atomic<std::uint64_t>              m_rows          {};     //!< Rows written.
+    std::atomic<std::uint64_t>              m_chunks        {};     //!< Chunks written.
+    std::atomic<std::int64_t>               m_lastReportMs  {};     //!< Elapsed time of the last report.
+    std::atomic<bool>                       m_failed        { false }; //!< Set when a worker failed.
+    std::mutex                              m_reportMutex   {};     //!< Serializes the progress callback.
+};
+
+CELL_NAMESPACE_END
+
+#endif  // CELL_DATABASE_MIGRATION_ABSTRACT_HPP
@@ -0,0 +1,329 @@
+#if __has_include("poolrouter.hpp")
+#   include "poolrouter.hpp"
+#else
+#   error "Cell's poolrouter was not found!"
+#endif
+
+#if __has_include("querycache.hpp")
+#   include "querycache.hpp"
+#else
+#   error "Cell's querycache was not found!"
+#endif
+
+#if defined(USE_MYSQL_MARIADB) || defined(USE_POSTGRESQL) || defined(USE_SQLITE) || defined(USE_MSSQL) || defined(USE_ORACLE)
+
+CELL_USING_NAMESPACE Cell;
+
+CELL_NAMESPACE_BEGIN(Cell::Abstracts)
+
+namespace {
+
+/**
+ * @brief Clauses that lock rows and therefore need the primary even in a SELECT.
+ */
+bool locksRows(std::string_view sql)
+{
+    std::string lowered(sql);
+    std::ranges::transform(lowered, lowered.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    // Whitespace is collapsed so "FOR\n  UPDATE" is found too
+    std::string words;
+    words.reserve(lowered.size());
+    for (const char character : lowered) {
+        const char normalized = std::isspace(static_cast<unsigned char>(character)) ? ' ' : character;
+        if (normalized != ' ' || (!words.empty() && words.back() != ' ')) {
+            words += normalized;
+        }
+    }
+    static constexpr std::array<std::string_view, 5> clauses {
+        "for update", "for share", "for no key update", "for key share", "lock in share mode"
+    };
+    return std::ranges::any_of(clauses, [&words](std::string_view clause) { return words.find(clause) != std::string::npos; });
+}
+
+/**
+ * @brief Functions that write, take locks or read session state, so a SELECT calling them needs the primary.
+ */
+constexpr std::array<std::string_view, 35> primaryOnlyFunctions {
+    // PostgreSQL sequences, advisory locks, notifications, transaction ids, settings and large objects
+    "nextval", "setval", "currval", "lastval",
+    "pg_advisory_lock", "pg_advisory_lock_shared", "pg_try_advisory_lock", "pg_try_advisory_lock_shared",
+    "pg_advisory_xact_lock", "pg_advisory_xact_lock_shared", "pg_try_advisory_xact_lock", "pg_try_advisory_xact_lock_shared",
+    "pg_advisory_unlock", "pg_advisory_unlock_shared", "pg_advisory_unlock_all",
+    "pg_notify", "txid_current", "pg_current_xact_id", "set_config",
+    "lo_create", "lo_creat", "lo_import", "lo_unlink", "lo_put", "lo_from_bytea", "dblink_exec",
+    // MySQL named locks and session state
+    "get_lock", "release_lock", "release_all_locks", "last_insert_id", "found_rows", "row_count",
+    // SQLite session state, which a reader connection does not share with the writer
+    "last_insert_rowid", "changes", "total_changes"
+};
+
+/**
+ * @brief Whether the statement calls one of primaryOnlyFunctions, schema-qualified or not.
+ */
+bool callsPrimaryOnlyFunction(std::string_view sql)
+{
+    const auto isWordCharacter = [](char character) {
+        return std::isalnum(static_cast<unsigned char>(character)) || character == '_';
+    };
+    std::size_t position = 0;
+    while (position < sql.size()) {
+        if (!isWordCharacter(sql[position])) {
+            ++position;
+            continue;
+        }
+        const auto begin = position;
+        while (position < sql.size() && isWordCharacter(sql[position])) {
+            ++position;
+        }
+        auto next = position;
+        while (next < sql.size() && std::isspace(static_cast<unsigned char>(sql[next]))) {
+            ++next;
+        }
+        if (next == sql.size() || sql[next] != '(') {
+            continue;
+        }
+        std::string word(sql.substr(begin, position - begin));
+        std::ranges::transform(word, word.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        if (std::ranges::find(primaryOnlyFunctions, word) != primaryOnlyFunctions.end()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Statements a replica may run; any other leading keyword goes to the primary.
+ */
+constexpr std::array<std::string_view, 6> readKeywords {
+    "select", "with", "show", "explain", "describe", "desc"
+};
+
+/**
+ * @brief Lower-cased words of a statement, with ";" between statements; literals and comments are skipped.
+ */
+std::vector<std::string> wordsOf(std::string_view sql)
+{
+    std::vector<std::string> words;
+    std::size_t i = 0;
+    while (i < sql.size()) {
+        const char character = sql[i];
+        if (character == '-' && i + 1 < sql.size() && sql[i + 1] == '-') {
+            while (i < sql.size() && sql[i] != '\n') {
+                ++i;
+            }
+        } else if (character == '/' && i + 1 < sql.size() && sql[i + 1] == '*') {
+            const auto end = sql.find("*/", i + 2);
+            i = end == std::string_view::npos ? sql.size() : end + 2;
+        } else if (character == '\'' || character == '"' || character == '`') {
+            ++i;
+            while (i < sql.size() && sql[i] != character) {
+                i += sql[i] == '\\' ? 2 : 1;
+            }
+            ++i;
+        } else if (std::isalnum(static_cast<unsigned char>(character)) || character == '_') {
+            const std::size_t start = i;
+            while (i < sql.size() && (std::isalnum(static_cast<unsigned char>(sql[i])) || sql[i] == '_' || sql[i] == '$')) {
+                ++i;
+            }
+            std::string word(sql.substr(start, i - start));
+            std::ranges::transform(word, word.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            words.push_back(std::move(word));
+        } else {
+            if (character == ';' && !words.empty() && words.back() != ";") {
+                words.emplace_back(";");
+            }
+            ++i;
+        }
+    }
+    return words;
+}
+
+/**
+ * @brief Whether every statement starts with a read keyword and none selects INTO a table, variable or file.
+ */
+bool startsAsRead(std::string_view sql)
+{
+    const auto words = wordsOf(sql);
+    if (words.empty()) {
+        return false;
+    }
+    bool statementStart = true;
+    for (const auto& word : words) {
+        if (word == ";") {
+            statementStart = true;
+            continue;
+        }
+        if (statementStart && std::ranges::find(readKeywords, word) == readKeywords.end()) {
+            return false;
+        }
+        statementStart = false;
+        if (word == "into") {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+PoolRouter::PoolRouter(ConnectionPool& primary, std::vector<ConnectionPool*> replicas, const ReplicaRoutingOptions& options)
+    : m_primary(primary), m_options(options)
+{
+    for (ConnectionPool* pool : replicas) {
+        if (pool) {
+            auto replica = std::make_unique<Replica>();
+            replica->pool = pool;
+            m_replicas.push_back(std::move(replica));
+        }
+    }
+
+    // Replicas only get reads once they have been measured
+    probe();
+    if (!m_replicas.empty()) {
+        m_thread = std::thread([this] { run(); });
+    }
+}
+
+PoolRouter::~PoolRouter()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_condition.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+ConnectionPool& PoolRouter::primary() const
+{
+    return m_primary;
+}
+
+ConnectionPool& PoolRouter::readPool(std::chrono::steady_clock::time_point lastWrite)
+{
+    // Read-your-writes: a replica may not have the session's write yet
+    if (lastWrite != std::chrono::steady_clock::time_point {}
+        && std::chrono::steady_clock::now() - lastWrite < m_options.stickiness) {
+        m_primaryReads.fetch_add(1, std::memory_order_relaxed);
+        return m_primary;
+    }
+
+    Replica* chosen = nullptr;
+    const std::size_t count = m_replicas.size();
+    if (m_options.selection == ReplicaSelection::LeastLatency) {
+        // Ties are broken in turn so equally fast replicas share the load
+        const std::size_t start = count == 0 ? 0 : m_next.fetch_add(1, std::memory_order_relaxed) % count;
+        for (std::size_t i = 0; i < count; ++i) {
+            Replica& replica = *m_replicas[(start + i) % count];
+            if (replica.healthy.load(std::memory_order_relaxed)
+                && (!chosen || replica.latencyUs.load(std::memory_order_relaxed) < chosen->latencyUs.load(std::memory_order_relaxed))) {
+                chosen = &replica;
+            }
+        }
+    } else {
+        for (std::size_t i = 0; i < count && !chosen; ++i) {
+            Replica& replica = *m_replicas[m_next.fetch_add(1, std::memory_order_relaxed) % count];
+            if (replica.healthy.load(std::memory_order_relaxed)) {
+                chosen = &replica;
+            }
+        }
+    }
+
+    if (!chosen) {
+        m_primaryReads.fetch_add(1, std::memory_order_relaxed);
+        return m_primary;
+    }
+    chosen->reads.fetch_add(1, std::memory_order_relaxed);
+    return *chosen->pool;
+}
+
+void PoolRouter::probe()
+{
+    for (auto& replica : m_replicas) {
+        probe(*replica);
+    }
+}
+
+std::vector<ReplicaStatus> PoolRouter::status() const
+{
+    std::vector<ReplicaStatus> statuses;
+    statuses.reserve(m_replicas.size());
+    for (const auto& replica : m_replicas) {
+        const auto lag = replica->lagMs.load(std::memory_order_relaxed);
+        statuses.push_back(ReplicaStatus {
+            .healthy    = replica->healthy.load(std::memory_order_relaxed),
+            .lag        = lag < 0 ? std::nullopt : std::make_optional(std::chrono::milliseconds(lag)),
+            .latency    = std::chrono::microseconds(replica->latencyUs.load(std::memory_order_relaxed)),
+            .reads      = replica->reads.load(std::memory_order_relaxed)
+        });
+    }
+    return statuses;
+}
+
+std::uint64_t PoolRouter::primaryReads() const
+{
+    return m_primaryReads.load(std::memory_order_relaxed);
+}
+
+bool PoolRouter::isReadOnly(std::string_view sql)
+{
+    if (!startsAsRead(sql)) {
+        return false;
+    }
+    // EXPLAIN ANALYZE runs the statement it explains, so a write inside it is found here
+    const auto written = QueryCache::tablesWrittenBy(sql);
+    return written && written->empty() && !locksRows(sql) && !callsPrimaryOnlyFunction(sql);
+}
+
+void PoolRouter::probe(Replica& replica)
+{
+    Types::SqlConnection connection;
+    try {
+        connection = replica.pool->getConnection(REPLICA_ROUTING_CONSTANTS::PROBE_ACQUIRE_TIMEOUT);
+    } catch (const PoolTimeoutError&) {
+        // Every connection is busy serving reads, which says nothing about its health
+        return;
+    } catch (const std::exception&) {
+        replica.healthy.store(false, std::memory_order_relaxed);
+        replica.lagMs.store(-1, std::memory_order_relaxed);
+        return;
+    }
+
+    std::optional<std::chrono::milliseconds> lag;
+    bool reachable = true;
+    const auto startedAt = std::chrono::steady_clock::now();
+    try {
+        lag = replica.pool->replicationLag(connection);
+    } catch (const std::exception&) {
+        reachable = false;
+    }
+    const auto roundTrip = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startedAt);
+
+    if (reachable) {
+        replica.pool->releaseConnection(connection);
+    } else {
+        replica.pool->discardConnection(connection);
+    }
+
+    // Smoothed so one slow probe does not move every read elsewhere
+    const auto previous = replica.latencyUs.load(std::memory_order_relaxed);
+    replica.latencyUs.store(previous == 0 ? roundTrip.count() : (previous * 4 + roundTrip.count()) / 5, std::memory_order_relaxed);
+    replica.lagMs.store(lag ? lag->count() : -1, std::memory_order_relaxed);
+    replica.healthy.store(reachable && lag && *lag <= m_options.maxLag, std::memory_order_relaxed);
+}
+
+void PoolRouter::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_condition.wait_for(lock, m_options.probeInterval, [this] { return m_stopping; })) {
+        lock.unlock();
+        probe();
+        lock.lock();
+    }
+}
+
+CELL_NAMESPACE_END
+
+#endif
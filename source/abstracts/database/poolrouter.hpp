@@ -0,0 +1,196 @@
+/*!
+ * @file        poolrouter.hpp
+ * @brief       Read/write splitting over connection pools for the Cell Engine.
+ * @details     This file defines PoolRouter, which sends reads to replica pools and everything else to the primary pool.
+ * @author      Kambiz Asadzadeh
+ * @since       07 Jun 2023
+ * @version     1.0
+ * @note        This is part of the Cell Engine, developed by Kambiz Asadzadeh.
+ *
+ * @license     This file is licensed under the terms of the Genyleap License. See the LICENSE.md file for more information.
+ * @copyright   Copyright (c) 2025 The Genyleap | Kambiz Asadzadeh. All rights reserved.
+ * @see         https://github.com/genyleap/cell
+ */
+
+#ifndef CELL_DATABASE_POOL_ROUTER_ABSTRACT_HPP
+#define CELL_DATABASE_POOL_ROUTER_ABSTRACT_HPP
+
+#if defined(USE_MYSQL_MARIADB) || defined(USE_POSTGRESQL) || defined(USE_SQLITE) || defined(USE_MSSQL) || defined(USE_ORACLE)
+
+//! Cell's Common.
+#if __has_include(<common>)
+#   include <common>
+#else
+#   error "Cell's common was not found!"
+#endif
+
+//! Cell's Core (Core Only).
+#if __has_include(<core>)
+#   include <core>
+#else
+#   error "Cell's requirements was not found!"
+#endif
+
+#if __has_include("connectionpool.hpp")
+#   include "connectionpool.hpp"
+#else
+#   error "Cell's connectionpool was not found!"
+#endif
+
+CELL_NAMESPACE_BEGIN(Cell::Abstracts)
+
+/**
+ * @brief Constants related to replica routing.
+ */
+struct REPLICA_ROUTING_CONSTANTS final
+{
+    __cell_static_const_constexpr std::chrono::milliseconds DEFAULT_MAX_LAG         {5000};    //!< Replicas further behind than this get no reads.
+    __cell_static_const_constexpr std::chrono::milliseconds DEFAULT_STICKINESS      {2000};    //!< Reads stay on the primary this long after a session writes.
+    __cell_static_const_constexpr std::chrono::milliseconds DEFAULT_PROBE_INTERVAL  {1000};    //!< How often the replicas' lag and latency are measured.
+    __cell_static_const_constexpr std::chrono::milliseconds PROBE_ACQUIRE_TIMEOUT   {250};     //!< How long a probe waits for a replica connection.
+};
+
+/**
+ * @brief How a read picks among the healthy replicas.
+ */
+enum class ReplicaSelection : Types::u8
+{
+    RoundRobin,     //!< Each replica in turn.
+    LeastLatency    //!< The replica with the lowest measured round trip.
+};
+
+/**
+ * @brief Options of a pool router.
+ */
+struct ReplicaRoutingOptions final
+{
+    ReplicaSelection            selection       { ReplicaSelection::RoundRobin };                           //!< How replicas are picked.
+    std::chrono::milliseconds   maxLag          { REPLICA_ROUTING_CONSTANTS::DEFAULT_MAX_LAG };             //!< Lag above which a replica gets no reads.
+    std::chrono::milliseconds   stickiness      { REPLICA_ROUTING_CONSTANTS::DEFAULT_STICKINESS };          //!< Read-your-writes window of a session.
+    std::chrono::milliseconds   probeInterval   { REPLICA_ROUTING_CONSTANTS::DEFAULT_PROBE_INTERVAL };      //!< Time between two measurements.
+};
+
+/**
+ * @brief The last measurement of a replica.
+ */
+struct ReplicaStatus final
+{
+    bool                                    healthy {}; //!< Whether the replica currently gets reads.
+    std::optional<std::chrono::milliseconds> lag    {}; //!< Replication lag; empty if unknown or replication is stopped.
+    std::chrono::microseconds               latency {}; //!< Smoothed round trip of the probe.
+    std::uint64_t                           reads   {}; //!< Reads routed to the replica.
+};
+
+/**
+ * @brief Routes reads to replica pools and writes to the primary pool.
+ *
+ * A background thread measures every replica's replication lag and round trip at the probe interval.
+ * A replica gets reads while its lag is known and within the limit; when none qualifies, reads go to
+ * the primary. A session that wrote within the stickiness window reads from the primary too, so it
+ * always sees its own writes.
+ *
+ * Only statements that cannot write are routed to replicas (see isReadOnly()). A SELECT that calls a
+ * known writing or locking function, such as nextval() or pg_advisory_lock(), stays on the primary; one
+ * that calls a user-defined function with side effects cannot be told from a plain one and must be sent
+ * to the primary by the caller.
+ *
+ * The pools must outlive the router.
+ */
+class PoolRouter {
+public:
+    /**
+     * @brief Starts measuring the replicas.
+     *
+     * @param primary The pool of the primary server.
+     * @param replicas The pools of the replicas.
+     * @param options The selection policy, lag limit, stickiness window and probe interval.
+     */
+    PoolRouter(ConnectionPool& primary, std::vector<ConnectionPool*> replicas, const ReplicaRoutingOptions& options = {});
+
+    /**
+     * @brief Stops measuring the replicas.
+     */
+    ~PoolRouter();
+
+    /**
+     * @brief Disable copy construction and assignment for a class.
+     */
+    CELL_DISABLE_COPY(PoolRouter)
+
+    /**
+     * @brief Returns the pool of the primary server.
+     */
+    ConnectionPool& primary() const;
+
+    /**
+     * @brief Returns the pool a read of a session goes to.
+     *
+     * @param lastWrite When the session last wrote; a default time point if it never did.
+     * @return A healthy replica pool, or the primary pool.
+     */
+    ConnectionPool& readPool(std::chrono::steady_clock::time_point lastWrite = {});
+
+    /**
+     * @brief Measures every replica once, without waiting for the next interval.
+     */
+    void probe();
+
+    /**
+     * @brief Returns the last measurement of every replica, in the order they were given.
+     */
+    std::vector<ReplicaStatus> status() const;
+
+    /**
+     * @brief Returns the number of reads that went to the primary.
+     */
+    std::uint64_t primaryReads() const;
+
+    /**
+     * @brief Checks whether a statement only reads, so that a replica can run it.
+     *
+     * Only SELECT, WITH, SHOW, EXPLAIN and DESCRIBE can be read-only; SET, LOCK, NOTIFY, CREATE and every
+     * other statement go to the primary. Among those, statements that select INTO a target, write (an
+     * EXPLAIN ANALYZE of a write included), lock rows, or call a function that writes, locks or reads
+     * session state (sequences, advisory and named locks, last insert ids) are not read-only either.
+     */
+    static bool isReadOnly(std::string_view sql);
+
+private:
+    /**
+     * @brief The measurements of a replica, read without locking by readPool().
+     */
+    struct Replica final
+    {
+        ConnectionPool*             pool        {};             //!< The replica's pool.
+        std::atomic<bool>           healthy     { false };      //!< Whether the replica gets reads.
+        std::atomic<std::int64_t>   lagMs       { -1 };         //!< Last lag; negative if unknown.
+        std::atomic<std::int64_t>   latencyUs   {};             //!< Smoothed probe round trip.
+        std::atomic<std::uint64_t>  reads       {};             //!< Reads routed to the replica.
+    };
+
+    /**
+     * @brief Measures one replica.
+     */
+    void probe(Replica& replica);
+
+    /**
+     * @brief Probes the replicas at the interval until the router is destroyed.
+     */
+    void run();
+
+    ConnectionPool&                         m_primary;                      //!< The primary pool.
+    std::vector<std::unique_ptr<Replica>>   m_replicas      {};             //!< The replicas.
+    ReplicaRoutingOptions                   m_options       {};             //!< Routing options.
+    std::atomic<std::size_t>                m_next          {};             //!< Round-robin cursor.
+    std::atomic<std::uint64_t>              m_primaryReads  {};             //!< Reads sent to the primary.
+    std::mutex                              m_mutex         {};             //!< Guards m_stopping.
+    std::condition_variable                 m_condition     {};             //!< Wakes the probe thread.
+    bool                                    m_stopping      { false };      //!< Set by the destructor.
+    std::thread                             m_thread        {};             //!< The probe thread.
+};
+
+CELL_NAMESPACE_END
+
+#endif
+
+#endif  // CELL_DATABASE_POOL_ROUTER_ABSTRACT_HPP
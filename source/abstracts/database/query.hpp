@@ -29,6 +29,12 @@
 #   error "Cell's requirements was not found!"
 #endif
 
+#if __has_include("querycache.hpp")
+#   include "querycache.hpp"
+#else
+#   error "Cell's querycache was not found!"
+#endif
+
 CELL_NAMESPACE_BEGIN(Cell::Abstracts)
 
 /**
@@ -239,6 +245,35 @@ public:
      * @return The boolean result indicating the success of the execution.
      */
     __cell_virtual bool executeProcedureWithParamsSync(const std::string& procedure, const std::vector<std::string>& params)  = __cell_zero;
+
+    /**
+     * @brief Execute a SQL query through the query cache.
+     *
+     * The result is served from the cache while it is live, and concurrent calls for the same query and
+     * parameters run it once. Writes made through this executor invalidate it.
+     *
+     * @param sql The SQL query to execute.
+     * @param params The vector of parameters to be used in the query; empty for a plain query.
+     * @param options The lifetime of the result and the tables it depends on.
+     * @return The vector of rows representing the result of the query.
+     */
+    __cell_virtual std::vector<std::vector<std::string>> queryCached(const std::string& sql,
+                                                                     const std::vector<std::string>& params = {},
+                                                                     const QueryCacheOptions& options = {}) = __cell_zero;
+
+    /**
+     * @brief Use a query cache, e.g. one shared with other connections and drivers.
+     *
+     * @param cache The cache to use from now on.
+     */
+    __cell_virtual void setQueryCache(std::shared_ptr<QueryCache> cache) = __cell_zero;
+
+    /**
+     * @brief Get the query cache used by this executor.
+     *
+     * @return The cache.
+     */
+    __cell_virtual std::shared_ptr<QueryCache> queryCache() const = __cell_zero;
 };
 
 CELL_NAMESPACE_END
@@ -0,0 +1,502 @@
+#if __has_include("querycache.hpp")
+#   include "querycache.hpp"
+#else
+#   error "Cell's querycache was not found!"
+#endif
+
+CELL_USING_NAMESPACE Cell;
+
+CELL_NAMESPACE_BEGIN(Cell::Abstracts)
+
+namespace {
+
+//! Tag of results whose tables are unknown; every invalidation drops them.
+const std::string anyTable { "*" };
+
+/**
+ * @brief A word or punctuation mark of a statement; literals and comments are skipped.
+ */
+struct Token final
+{
+    std::string text        {}; //!< Lower-cased word, unquoted identifier or punctuation.
+    bool        identifier  {}; //!< Whether the text is a word or a quoted identifier.
+};
+
+/**
+ * @brief Splits SQL into tokens, one vector per statement.
+ */
+std::vector<std::vector<Token>> tokenize(std::string_view sql)
+{
+    std::vector<std::vector<Token>> statements(1);
+    std::size_t i = 0;
+    while (i < sql.size()) {
+        const char character = sql[i];
+        if (std::isspace(static_cast<unsigned char>(character))) {
+            ++i;
+        } else if (character == '-' && i + 1 < sql.size() && sql[i + 1] == '-') {
+            while (i < sql.size() && sql[i] != '\n') {
+                ++i;
+            }
+        } else if (character == '/' && i + 1 < sql.size() && sql[i + 1] == '*') {
+            const auto end = sql.find("*/", i + 2);
+            i = end == std::string_view::npos ? sql.size() : end + 2;
+        } else if (character == '\'') {
+            // A doubled quote inside a literal ends and restarts it, which comes to the same thing here
+            ++i;
+            while (i < sql.size() && sql[i] != '\'') {
+                i += sql[i] == '\\' ? 2 : 1;
+            }
+            ++i;
+        } else if (character == '"' || character == '`' || character == '[') {
+            const char close = character == '[' ? ']' : character;
+            const auto end = sql.find(close, i + 1);
+            const auto stop = end == std::string_view::npos ? sql.size() : end;
+            Token token { std::string(sql.substr(i + 1, stop - i - 1)), true };
+            std::ranges::transform(token.text, token.text.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            statements.back().push_back(std::move(token));
+            i = stop + 1;
+        } else if (std::isalnum(static_cast<unsigned char>(character)) || character == '_' || character == '$') {
+            const std::size_t start = i;
+            while (i < sql.size() && (std::isalnum(static_cast<unsigned char>(sql[i])) || sql[i] == '_' || sql[i] == '$')) {
+                ++i;
+            }
+            Token token { std::string(sql.substr(start, i - start)), true };
+            std::ranges::transform(token.text, token.text.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            statements.back().push_back(std::move(token));
+        } else if (character == ';') {
+            if (!statements.back().empty()) {
+                statements.emplace_back();
+            }
+            ++i;
+        } else {
+            statements.back().push_back(Token { std::string(1, character), false });
+            ++i;
+        }
+    }
+    if (statements.back().empty()) {
+        statements.pop_back();
+    }
+    return statements;
+}
+
+/**
+ * @brief Reads a possibly qualified table name at a position, keeping its last part.
+ *
+ * @return The name, or an empty string if there is none; position is moved past it.
+ */
+std::string readTableName(const std::vector<Token>& tokens, std::size_t& position)
+{
+    if (position >= tokens.size() || !tokens[position].identifier) {
+        return {};
+    }
+    std::string name = tokens[position++].text;
+    while (position + 1 < tokens.size() && tokens[position].text == "." && tokens[position + 1].identifier) {
+        name = tokens[position + 1].text;
+        position += 2;
+    }
+    return name;
+}
+
+/**
+ * @brief Skips the words that may stand between a keyword and the table it names.
+ */
+void skipWords(const std::vector<Token>& tokens, std::size_t& position, std::initializer_list<std::string_view> words)
+{
+    while (position < tokens.size() && std::ranges::find(words, tokens[position].text) != words.end()) {
+        ++position;
+    }
+}
+
+void addUnique(std::vector<std::string>& tables, std::string table)
+{
+    if (!table.empty() && std::ranges::find(tables, table) == tables.end()) {
+        tables.push_back(std::move(table));
+    }
+}
+
+/**
+ * @brief Words after which a table name stops being followed by an alias.
+ */
+bool isClauseKeyword(std::string_view word)
+{
+    static constexpr std::array<std::string_view, 24> keywords {
+        "where", "join", "inner", "left", "right", "full", "cross", "natural", "on", "using", "group", "order",
+        "having", "limit", "offset", "union", "intersect", "except", "window", "for", "lateral", "returning", "set", "values"
+    };
+    return std::ranges::find(keywords, word) != keywords.end();
+}
+
+/**
+ * @brief Statements that never change table data or what their names refer to.
+ *
+ * Session settings, locks, notifications and maintenance commands are left out on purpose: SET search_path
+ * changes which table a name means, and the rest are safer treated as writing unknown tables.
+ */
+bool isReadOnlyStatement(std::string_view word)
+{
+    static constexpr std::array<std::string_view, 13> keywords {
+        "select", "with", "show", "explain", "describe", "desc", "begin", "start", "commit", "end",
+        "rollback", "savepoint", "release"
+    };
+    return std::ranges::find(keywords, word) != keywords.end();
+}
+
+/**
+ * @brief Approximates the memory held by a result.
+ */
+std::size_t estimateBytes(const QueryCache::Rows& rows)
+{
+    std::size_t bytes = sizeof(QueryCache::Rows) + rows.size() * sizeof(QueryCache::Rows::value_type);
+    for (const auto& row : rows) {
+        bytes += row.size() * sizeof(std::string);
+        for (const auto& value : row) {
+            bytes += value.size();
+        }
+    }
+    return bytes;
+}
+
+}  // namespace
+
+QueryCache::QueryCache(std::size_t byteBudget, std::chrono::milliseconds ttl)
+    : m_byteBudget(byteBudget), m_defaultTtl(ttl)
+{
+}
+
+QueryCache::RowsPtr QueryCache::getOrLoad(const std::string& sql,
+                                          const std::vector<std::string>& params,
+                                          const QueryCacheOptions& options,
+                                          const Loader& loader)
+{
+    const std::string key = makeKey(sql, params);
+
+    std::promise<RowsPtr> promise;
+    std::uint64_t loadedAt {};
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (const auto it = m_entries.find(key); it != m_entries.end()) {
+            if (it->second.expires > Clock::now()) {
+                ++m_statistics.hits;
+                m_recency.splice(m_recency.begin(), m_recency, it->second.recency);
+                return it->second.rows;
+            }
+            ++m_statistics.expirations;
+            erase(it);
+        }
+        if (const auto it = m_loading.find(key); it != m_loading.end()) {
+            ++m_statistics.coalesced;
+            const auto pending = it->second;
+            lock.unlock();
+            return pending.get();
+        }
+        ++m_statistics.misses;
+        m_loading.emplace(key, promise.get_future().share());
+        loadedAt = m_sequence;
+    }
+
+    RowsPtr rows;
+    try {
+        rows = std::make_shared<const Rows>(loader());
+    } catch (...) {
+        promise.set_exception(std::current_exception());
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_loading.erase(key);
+        throw;
+    }
+
+    // The waiters get the rows whether or not they can be cached below
+    promise.set_value(rows);
+
+    try {
+        std::vector<std::string> tables = options.tables.empty() ? tablesReadBy(sql) : std::vector<std::string> {};
+        for (const auto& table : options.tables) {
+            std::size_t position = 0;
+            const auto tokens = tokenize(table);
+            if (!tokens.empty()) {
+                addUnique(tables, readTableName(tokens.front(), position));
+            }
+        }
+        if (tables.empty()) {
+            tables.push_back(anyTable);
+        }
+        store(key, rows, std::move(tables), options.ttl, loadedAt);
+    } catch (const std::exception&) {
+        // The result is correct, only not cached; the next call loads it again
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_loading.erase(key);
+    }
+    return rows;
+}
+
+bool QueryCache::contains(const std::string& sql, const std::vector<std::string>& params) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto it = m_entries.find(makeKey(sql, params));
+    return it != m_entries.end() && it->second.expires > Clock::now();
+}
+
+void QueryCache::invalidate(const std::vector<std::string>& tables)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_sequence;
+    for (const auto& table : tables) {
+        std::size_t position = 0;
+        const auto tokens = tokenize(table);
+        const auto name = tokens.empty() ? std::string {} : readTableName(tokens.front(), position);
+        if (name.empty()) {
+            continue;
+        }
+        m_invalidatedAt[name] = m_sequence;
+        dropTag(name);
+    }
+    dropTag(anyTable);
+}
+
+void QueryCache::invalidateWrites(std::string_view sql)
+{
+    if (const auto tables = tablesWrittenBy(sql)) {
+        if (!tables->empty()) {
+            invalidate(*tables);
+        }
+    } else {
+        invalidateAll();
+    }
+}
+
+void QueryCache::invalidateAll()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_allInvalidatedAt = ++m_sequence;
+    m_statistics.invalidations += m_entries.size();
+    m_entries.clear();
+    m_recency.clear();
+    m_tags.clear();
+    m_bytes = 0;
+}
+
+void QueryCache::setByteBudget(std::size_t byteBudget)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_byteBudget = byteBudget;
+    shrink();
+}
+
+void QueryCache::setDefaultTtl(std::chrono::milliseconds ttl)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_defaultTtl = ttl;
+}
+
+QueryCacheStatistics QueryCache::statistics() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    QueryCacheStatistics statistics = m_statistics;
+    statistics.entries = m_entries.size();
+    statistics.bytes = m_bytes;
+    return statistics;
+}
+
+std::vector<std::string> QueryCache::tablesReadBy(std::string_view sql)
+{
+    std::vector<std::string> tables;
+    for (const auto& tokens : tokenize(sql)) {
+        for (std::size_t i = 0; i < tokens.size(); ++i) {
+            const auto& word = tokens[i].text;
+            if (word != "from" && word != "join") {
+                continue;
+            }
+            std::size_t position = i + 1;
+            skipWords(tokens, position, { "only", "lateral" });
+            // FROM a x, b AS y lists several tables; a subquery has its own FROM, found later
+            while (true) {
+                std::string table = readTableName(tokens, position);
+                if (table.empty() || isClauseKeyword(table)) {
+                    break;
+                }
+                addUnique(tables, std::move(table));
+                if (position < tokens.size() && tokens[position].text == "as") {
+                    ++position;
+                }
+                if (position < tokens.size() && tokens[position].identifier && !isClauseKeyword(tokens[position].text)) {
+                    ++position;
+                }
+                if (word != "from" || position >= tokens.size() || tokens[position].text != ",") {
+                    break;
+                }
+                ++position;
+            }
+        }
+    }
+    return tables;
+}
+
+std::optional<std::vector<std::string>> QueryCache::tablesWrittenBy(std::string_view sql)
+{
+    std::vector<std::string> tables;
+    for (const auto& tokens : tokenize(sql)) {
+        bool found = false;
+        for (std::size_t i = 0; i < tokens.size(); ++i) {
+            const auto& word = tokens[i].text;
+            std::size_t position = i + 1;
+            if (word == "insert" || word == "replace" || word == "merge") {
+                skipWords(tokens, position, { "low_priority", "delayed", "high_priority", "ignore", "into" });
+            } else if (word == "update") {
+                // ON CONFLICT ... DO UPDATE SET and ON DUPLICATE KEY UPDATE name no table
+                if (position < tokens.size() && tokens[position].text == "set") {
+                    continue;
+                }
+                skipWords(tokens, position, { "low_priority", "ignore", "only" });
+            } else if (word == "delete") {
+                skipWords(tokens, position, { "low_priority", "quick", "ignore", "from", "only" });
+            } else if (word == "truncate" || word == "alter" || word == "drop" || word == "rename") {
+                if (word != "truncate" && (position >= tokens.size() || (tokens[position].text != "table" && tokens[position].text != "tables"))) {
+                    continue;
+                }
+                skipWords(tokens, position, { "table", "tables", "if", "exists", "only" });
+                // TRUNCATE a, b and DROP TABLE a, b name several tables
+                while (true) {
+                    addUnique(tables, readTableName(tokens, position));
+                    if (position >= tokens.size() || tokens[position].text != ",") {
+                        break;
+                    }
+                    ++position;
+                }
+                found = true;
+                continue;
+            } else if (word == "copy" && i == 0) {
+                // COPY t FROM writes t; COPY t TO only reads it
+                std::string table = readTableName(tokens, position);
+                const bool writes = std::ranges::any_of(tokens, [](const Token& token) { return token.text == "from"; });
+                if (writes) {
+                    addUnique(tables, std::move(table));
+                }
+                found = true;
+                continue;
+            } else if (word == "into" && (tokens.front().text == "select" || tokens.front().text == "with")) {
+                // SELECT ... INTO t creates t; INTO @variable and INTO OUTFILE write no table
+                skipWords(tokens, position, { "temporary", "temp", "unlogged", "table" });
+                if (position < tokens.size() && (tokens[position].text == "outfile" || tokens[position].text == "dumpfile")) {
+                    continue;
+                }
+            } else if (word == "load" && i == 0) {
+                // LOAD DATA ... INTO TABLE t
+                for (std::size_t j = position; j + 1 < tokens.size(); ++j) {
+                    if (tokens[j].text == "into" && tokens[j + 1].text == "table") {
+                        position = j + 2;
+                        addUnique(tables, readTableName(tokens, position));
+                        found = true;
+                        break;
+                    }
+                }
+                continue;
+            } else {
+                continue;
+            }
+            std::string table = readTableName(tokens, position);
+            if (!table.empty()) {
+                addUnique(tables, std::move(table));
+                found = true;
+            }
+        }
+        if (!found && !tokens.empty() && !isReadOnlyStatement(tokens.front().text)) {
+            // CALL, DO, EXECUTE, CREATE ... AS SELECT, GRANT and the like may write or reshape anything
+            return std::nullopt;
+        }
+    }
+    return tables;
+}
+
+std::string QueryCache::makeKey(const std::string& sql, const std::vector<std::string>& params)
+{
+    // Every parameter is prefixed by its length, so no two parameter lists share a key
+    std::string key = sql;
+    for (const auto& param : params) {
+        key += '\0';
+        key += std::to_string(param.size());
+        key += ':';
+        key += param;
+    }
+    return key;
+}
+
+void QueryCache::store(const std::string& key, RowsPtr rows, std::vector<std::string> tables, std::chrono::milliseconds ttl, std::uint64_t loadedAt)
+{
+    const std::size_t bytes = estimateBytes(*rows) + key.size();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_loading.erase(key);
+
+    // A write that finished while the query ran may not be in the result
+    bool stale = m_allInvalidatedAt > loadedAt;
+    for (const auto& table : tables) {
+        if (table == anyTable) {
+            stale = stale || m_sequence > loadedAt;
+        } else if (const auto it = m_invalidatedAt.find(table); it != m_invalidatedAt.end()) {
+            stale = stale || it->second > loadedAt;
+        }
+    }
+    if (stale || bytes > m_byteBudget) {
+        return;
+    }
+
+    if (const auto it = m_entries.find(key); it != m_entries.end()) {
+        erase(it);
+    }
+    m_recency.push_front(key);
+    Entry entry {
+        .rows       = std::move(rows),
+        .tables     = std::move(tables),
+        .bytes      = bytes,
+        .expires    = Clock::now() + (ttl.count() > 0 ? ttl : m_defaultTtl),
+        .recency    = m_recency.begin()
+    };
+    for (const auto& table : entry.tables) {
+        m_tags[table].insert(key);
+    }
+    m_bytes += bytes;
+    m_entries.emplace(key, std::move(entry));
+    shrink();
+}
+
+void QueryCache::dropTag(const std::string& table)
+{
+    const auto tag = m_tags.find(table);
+    if (tag == m_tags.end()) {
+        return;
+    }
+    const auto keys = std::move(tag->second);
+    m_tags.erase(tag);
+    for (const auto& key : keys) {
+        if (const auto it = m_entries.find(key); it != m_entries.end()) {
+            ++m_statistics.invalidations;
+            erase(it);
+        }
+    }
+}
+
+void QueryCache::erase(std::unordered_map<std::string, Entry>::iterator entry)
+{
+    for (const auto& table : entry->second.tables) {
+        if (const auto tag = m_tags.find(table); tag != m_tags.end()) {
+            tag->second.erase(entry->first);
+            if (tag->second.empty()) {
+                m_tags.erase(tag);
+            }
+        }
+    }
+    m_bytes -= entry->second.bytes;
+    m_recency.erase(entry->second.recency);
+    m_entries.erase(entry);
+}
+
+void QueryCache::shrink()
+{
+    while (m_bytes > m_byteBudget && !m_recency.empty()) {
+        const auto it = m_entries.find(m_recency.back());
+        const bool expired = it->second.expires <= Clock::now();
+        ++(expired ? m_statistics.expirations : m_statistics.evictions);
+        erase(it);
+    }
+}
+
+CELL_NAMESPACE_END
@@ -0,0 +1,238 @@
+/*!
+ * @file        querycache.hpp
+ * @brief       Shared query result cache for the Cell Engine.
+ * @details     This file defines QueryCache, a byte-bounded cache of query results with expiry, table tags and single-flight loading.
+ * @author      Kambiz Asadzadeh
+ * @since       07 Jun 2023
+ * @version     1.0
+ * @note        This is part of the Cell Engine, developed by Kambiz Asadzadeh.
+ *
+ * @license     This file is licensed under the terms of the Genyleap License. See the LICENSE.md file for more information.
+ * @copyright   Copyright (c) 2025 The Genyleap | Kambiz Asadzadeh. All rights reserved.
+ * @see         https://github.com/genyleap/cell
+ */
+
+#ifndef CELL_DATABASE_QUERY_CACHE_ABSTRACT_HPP
+#define CELL_DATABASE_QUERY_CACHE_ABSTRACT_HPP
+
+//! Cell's Common.
+#if __has_include(<common>)
+#   include <common>
+#else
+#   error "Cell's common was not found!"
+#endif
+
+//! Cell's Core (Core Only).
+#if __has_include(<core>)
+#   include <core>
+#else
+#   error "Cell's requirements was not found!"
+#endif
+
+CELL_NAMESPACE_BEGIN(Cell::Abstracts)
+
+/**
+ * @brief Constants related to the query cache.
+ */
+struct QUERY_CACHE_CONSTANTS final
+{
+    __cell_static_const_constexpr std::size_t DEFAULT_BYTE_BUDGET = 64 * 1024 * 1024;  //!< Bytes of results kept.
+    __cell_static_const_constexpr std::chrono::seconds DEFAULT_TTL { 60 };             //!< Lifetime of a result unless a query asks otherwise.
+};
+
+/**
+ * @brief How one query is cached.
+ */
+struct QueryCacheOptions final
+{
+    std::chrono::milliseconds   ttl     {};  //!< Lifetime of the result; zero for the cache's default.
+    std::vector<std::string>    tables  {};  //!< Tables the result depends on; empty to take them from the FROM and JOIN clauses.
+};
+
+/**
+ * @brief A snapshot of the counters of a query cache.
+ */
+struct QueryCacheStatistics final
+{
+    std::uint64_t hits          {}; //!< Lookups served from the cache.
+    std::uint64_t misses        {}; //!< Lookups that ran the query.
+    std::uint64_t coalesced     {}; //!< Lookups that waited for the same query already running for another caller.
+    std::uint64_t evictions     {}; //!< Results dropped to stay within the byte budget.
+    std::uint64_t expirations   {}; //!< Results dropped because their lifetime was over.
+    std::uint64_t invalidations {}; //!< Results dropped because a table they depend on was written.
+    std::size_t   entries       {}; //!< Results currently cached.
+    std::size_t   bytes         {}; //!< Estimated size of the cached results.
+
+    /**
+     * @brief Returns the fraction of lookups that did not run the query.
+     */
+    double hitRatio() const
+    {
+        const auto served = hits + coalesced;
+        const auto lookups = served + misses;
+        return lookups == 0 ? 0.0 : static_cast<double>(served) / static_cast<double>(lookups);
+    }
+};
+
+/**
+ * @brief A cache of query results shared by any number of connections and drivers.
+ *
+ * Results are only cached when a query asks for it, and each one is tagged with the tables it reads.
+ * Writes made through a driver that uses the cache invalidate the tags of the tables they touch, so a
+ * result is dropped as soon as the data behind it changes rather than when its lifetime runs out. A
+ * query whose tables cannot be told from its text is tagged with every table, and a write whose tables
+ * cannot be told (a procedure call, say) invalidates everything.
+ *
+ * Concurrent lookups of the same query run it once: the first caller loads the result and the others
+ * wait for it. A load that overlaps an invalidation of one of its tables is handed to its callers but
+ * not stored, since it may have read the old data.
+ *
+ * The least recently used results are dropped once the estimated size of all results exceeds the byte
+ * budget; a single result larger than the budget is never stored.
+ *
+ * Writes hidden inside functions or triggers, or made by other applications, are not seen; call
+ * invalidate() for them.
+ */
+class QueryCache {
+public:
+    using Rows      = std::vector<std::vector<std::string>>;
+    using RowsPtr   = std::shared_ptr<const Rows>;
+    using Loader    = std::function<Rows()>;
+
+    /**
+     * @brief Constructs an empty cache.
+     *
+     * @param byteBudget The estimated size of results kept.
+     * @param ttl The lifetime of a result unless a query asks otherwise.
+     */
+    explicit QueryCache(std::size_t byteBudget = QUERY_CACHE_CONSTANTS::DEFAULT_BYTE_BUDGET,
+                        std::chrono::milliseconds ttl = QUERY_CACHE_CONSTANTS::DEFAULT_TTL);
+
+    /**
+     * @brief Disable copy construction and assignment for a class.
+     */
+    CELL_DISABLE_COPY(QueryCache)
+
+    /**
+     * @brief Returns the cached result of a query, or loads it once for all concurrent callers.
+     *
+     * @param sql The query.
+     * @param params Values of its parameters; part of the key.
+     * @param options The lifetime and table tags of the result.
+     * @param loader Runs the query; it throws to report an error, which is then not cached.
+     * @return The result, shared with the cache.
+     * @throws Whatever the loader threw, to every caller that waited for it.
+     */
+    RowsPtr getOrLoad(const std::string& sql,
+                      const std::vector<std::string>& params,
+                      const QueryCacheOptions& options,
+                      const Loader& loader);
+
+    /**
+     * @brief Checks whether a live result of a query is cached.
+     */
+    bool contains(const std::string& sql, const std::vector<std::string>& params = {}) const;
+
+    /**
+     * @brief Drops the results that depend on any of the tables.
+     */
+    void invalidate(const std::vector<std::string>& tables);
+
+    /**
+     * @brief Drops the results that depend on the tables a statement writes.
+     *
+     * @param sql One or more statements that were executed.
+     */
+    void invalidateWrites(std::string_view sql);
+
+    /**
+     * @brief Drops every result.
+     */
+    void invalidateAll();
+
+    /**
+     * @brief Changes the byte budget, dropping results until the cache fits.
+     */
+    void setByteBudget(std::size_t byteBudget);
+
+    /**
+     * @brief Changes the lifetime of results stored from now on without a lifetime of their own.
+     */
+    void setDefaultTtl(std::chrono::milliseconds ttl);
+
+    /**
+     * @brief Returns the counters of the cache.
+     */
+    QueryCacheStatistics statistics() const;
+
+    /**
+     * @brief Returns the tables a query reads, from its FROM and JOIN clauses.
+     */
+    static std::vector<std::string> tablesReadBy(std::string_view sql);
+
+    /**
+     * @brief Returns the tables the statements write.
+     *
+     * @param sql One or more statements.
+     * @return The tables, or std::nullopt if a statement may write tables that cannot be told from its text.
+     */
+    static std::optional<std::vector<std::string>> tablesWrittenBy(std::string_view sql);
+
+private:
+    using Clock = std::chrono::steady_clock;
+    using Recency = std::list<std::string>;
+
+    /**
+     * @brief A cached result.
+     */
+    struct Entry final
+    {
+        RowsPtr                     rows        {}; //!< The result.
+        std::vector<std::string>    tables      {}; //!< Normalised table tags.
+        std::size_t                 bytes       {}; //!< Estimated size.
+        Clock::time_point           expires     {}; //!< End of its lifetime.
+        Recency::iterator           recency     {}; //!< Position in m_recency.
+    };
+
+    /**
+     * @brief Returns the key of a query and its parameters.
+     */
+    static std::string makeKey(const std::string& sql, const std::vector<std::string>& params);
+
+    /**
+     * @brief Stores a loaded result unless one of its tables was invalidated while it loaded.
+     */
+    void store(const std::string& key, RowsPtr rows, std::vector<std::string> tables, std::chrono::milliseconds ttl, std::uint64_t loadedAt);
+
+    /**
+     * @brief Drops the results tagged with one table; the caller holds m_mutex.
+     */
+    void dropTag(const std::string& table);
+
+    /**
+     * @brief Drops one result; the caller holds m_mutex.
+     */
+    void erase(std::unordered_map<std::string, Entry>::iterator entry);
+
+    /**
+     * @brief Drops the least recently used results until the cache fits its budget; the caller holds m_mutex.
+     */
+    void shrink();
+
+    mutable std::mutex                                                      m_mutex             {};
+    std::size_t                                                             m_byteBudget        {};     //!< Estimated size of results kept.
+    std::chrono::milliseconds                                               m_defaultTtl        {};     //!< Lifetime of a result unless a query asks otherwise.
+    std::unordered_map<std::string, Entry>                                  m_entries           {};     //!< Results by key.
+    Recency                                                                 m_recency           {};     //!< Keys, most recently used first.
+    std::unordered_map<std::string, std::unordered_set<std::string>>        m_tags              {};     //!< Keys by table tag.
+    std::unordered_map<std::string, std::shared_future<RowsPtr>>            m_loading           {};     //!< Queries being loaded, by key.
+    std::unordered_map<std::string, std::uint64_t>                          m_invalidatedAt     {};     //!< Sequence of the last invalidation of each table.
+    std::uint64_t                                                           m_sequence          {};     //!< Incremented by every invalidation.
+    std::uint64_t                                                           m_allInvalidatedAt  {};     //!< Sequence of the last invalidateAll().
+    std::size_t                                                             m_bytes             {};     //!< Estimated size of the cached results.
+    QueryCacheStatistics                                                    m_statistics        {};     //!< Counters, guarded by m_mutex.
+};
+
+CELL_NAMESPACE_END
+
+#endif // CELL_DATABASE_QUERY_CACHE_ABSTRACT_HPP
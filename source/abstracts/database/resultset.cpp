@@ -0,0 +1,152 @@
+#if __has_include("resultset.hpp")
+#   include "resultset.hpp"
+#else
+#   error "Cell's resultset was not found!"
+#endif
+
+CELL_USING_NAMESPACE Cell;
+
+CELL_NAMESPACE_BEGIN(Cell::Abstracts)
+
+namespace {
+
+[[noreturn]] void throwConversionError(const ResultSet& resultSet, std::size_t column, std::string_view type)
+{
+    throw std::invalid_argument("Value of column '" + std::string(resultSet.columnName(column)) + "' is not " + std::string(type) + ".");
+}
+
+}  // namespace
+
+/*!
+ * \brief Constructs an abstract ResultSet.
+ */
+ResultSet::ResultSet()
+{
+}
+
+/*!
+ * \brief Destroys the ResultSet.
+ */
+ResultSet::~ResultSet()
+{
+}
+
+ResultFormat ResultSet::format() const
+{
+    return ResultFormat::Text;
+}
+
+std::optional<std::int64_t> ResultSet::integer(std::size_t row, std::size_t column) const
+{
+    if (isNull(row, column)) {
+        return std::nullopt;
+    }
+    const auto text = value(row, column);
+    std::int64_t number {};
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), number);
+    if (error != std::errc() || end != text.data() + text.size()) {
+        throwConversionError(*this, column, "an integer");
+    }
+    return number;
+}
+
+std::optional<double> ResultSet::real(std::size_t row, std::size_t column) const
+{
+    if (isNull(row, column)) {
+        return std::nullopt;
+    }
+    const auto text = value(row, column);
+#if defined(__cpp_lib_to_chars)
+    double number {};
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), number);
+    if (error != std::errc() || end != text.data() + text.size()) {
+        throwConversionError(*this, column, "a number");
+    }
+    return number;
+#else
+    // strtod needs a terminated string; numbers are short enough for the copy not to matter
+    const std::string copy(text);
+    char* end = __cell_nullptr;
+    const double number = std::strtod(copy.c_str(), &end);
+    if (copy.empty() || end != copy.c_str() + copy.size()) {
+        throwConversionError(*this, column, "a number");
+    }
+    return number;
+#endif
+}
+
+std::optional<bool> ResultSet::boolean(std::size_t row, std::size_t column) const
+{
+    if (isNull(row, column)) {
+        return std::nullopt;
+    }
+    const auto text = value(row, column);
+    if (text == "t" || text == "true" || text == "1") {
+        return true;
+    }
+    if (text == "f" || text == "false" || text == "0") {
+        return false;
+    }
+    throwConversionError(*this, column, "a boolean");
+}
+
+std::optional<std::size_t> ResultSet::columnIndex(std::string_view name) const
+{
+    for (std::size_t column = 0; column < columnCount(); ++column) {
+        if (columnName(column) == name) {
+            return column;
+        }
+    }
+    return std::nullopt;
+}
+
+bool ResultSet::empty() const
+{
+    return rowCount() == 0;
+}
+
+ResultRow ResultSet::row(std::size_t row) const
+{
+    return ResultRow(*this, row);
+}
+
+ResultColumn ResultSet::column(std::size_t column) const
+{
+    return ResultColumn(*this, column);
+}
+
+ResultSet::Iterator ResultSet::begin() const
+{
+    return Iterator(this, 0);
+}
+
+ResultSet::Iterator ResultSet::end() const
+{
+    return Iterator(this, rowCount());
+}
+
+std::vector<std::vector<std::string>> ResultSet::toRows(bool withColumnNames, std::string_view nullValue) const
+{
+    const std::size_t columns = columnCount();
+    std::vector<std::vector<std::string>> rows;
+    rows.reserve(rowCount() + (withColumnNames ? 1 : 0));
+
+    if (withColumnNames) {
+        auto& names = rows.emplace_back();
+        names.reserve(columns);
+        for (std::size_t column = 0; column < columns; ++column) {
+            names.emplace_back(columnName(column));
+        }
+    }
+
+    for (std::size_t row = 0; row < rowCount(); ++row) {
+        auto& values = rows.emplace_back();
+        values.reserve(columns);
+        for (std::size_t column = 0; column < columns; ++column) {
+            values.emplace_back(isNull(row, column) ? nullValue : value(row, column));
+        }
+    }
+    return rows;
+}
+
+CELL_NAMESPACE_END
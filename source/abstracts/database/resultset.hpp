@@ -0,0 +1,319 @@
+/*!
+ * @file        resultset.hpp
+ * @brief       Database result set for the Cell Engine.
+ * @details     This file defines ResultSet, which owns a driver result and exposes zero-copy row and column views.
+ * @author      Kambiz Asadzadeh
+ * @since       07 Jun 2023
+ * @version     1.0
+ * @note        This is part of the Cell Engine, developed by Kambiz Asadzadeh.
+ *
+ * @license     This file is licensed under the terms of the Genyleap License. See the LICENSE.md file for more information.
+ * @copyright   Copyright (c) 2025 The Genyleap | Kambiz Asadzadeh. All rights reserved.
+ * @see         https://github.com/genyleap/cell
+ */
+
+#ifndef CELL_DATABASE_RESULT_SET_ABSTRACT_HPP
+#define CELL_DATABASE_RESULT_SET_ABSTRACT_HPP
+
+//! Cell's Common.
+#if __has_include(<common>)
+#   include <common>
+#else
+#   error "Cell's common was not found!"
+#endif
+
+//! Cell's Core (Core Only).
+#if __has_include(<core>)
+#   include <core>
+#else
+#   error "Cell's requirements was not found!"
+#endif
+
+CELL_NAMESPACE_BEGIN(Cell::Abstracts)
+
+/**
+ * @brief The wire format of the values in a result set.
+ */
+enum class ResultFormat : Types::u8
+{
+    Text    =   0x0,    //!< Values are their textual representation.
+    Binary  =   0x1     //!< Values are in the server's binary representation (PostgreSQL only).
+};
+
+class ResultSet;
+
+/**
+ * @brief A view of one row of a result set; valid as long as the result set.
+ */
+class ResultRow {
+public:
+    ResultRow(const ResultSet& resultSet, std::size_t row) : m_resultSet(&resultSet), m_row(row) {}
+
+    /**
+     * @brief Returns the index of the row in the result set.
+     */
+    std::size_t index() const { return m_row; }
+
+    /**
+     * @brief Returns the number of columns.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Checks whether a value is SQL NULL.
+     */
+    bool isNull(std::size_t column) const;
+
+    /**
+     * @brief Returns the raw bytes of a value, pointing into the driver's buffer.
+     */
+    std::string_view operator[](std::size_t column) const;
+
+    /**
+     * @brief Returns the raw bytes of a value by column name.
+     *
+     * @throws std::out_of_range If there is no such column.
+     */
+    std::string_view operator[](std::string_view name) const;
+
+    /**
+     * @brief Converts a value; see ResultSet::get().
+     */
+    template <typename T>
+    std::optional<T> get(std::size_t column) const;
+
+private:
+    const ResultSet*    m_resultSet {};
+    std::size_t         m_row       {};
+};
+
+/**
+ * @brief A view of one column of a result set; valid as long as the result set.
+ */
+class ResultColumn {
+public:
+    ResultColumn(const ResultSet& resultSet, std::size_t column) : m_resultSet(&resultSet), m_column(column) {}
+
+    /**
+     * @brief Returns the name of the column.
+     */
+    std::string_view name() const;
+
+    /**
+     * @brief Returns the number of rows.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Checks whether a value is SQL NULL.
+     */
+    bool isNull(std::size_t row) const;
+
+    /**
+     * @brief Returns the raw bytes of a value, pointing into the driver's buffer.
+     */
+    std::string_view operator[](std::size_t row) const;
+
+    /**
+     * @brief Converts a value; see ResultSet::get().
+     */
+    template <typename T>
+    std::optional<T> get(std::size_t row) const;
+
+private:
+    const ResultSet*    m_resultSet {};
+    std::size_t         m_column    {};
+};
+
+/**
+ * @brief The base class for a query result that owns the driver's native result.
+ *
+ * Values are never copied out of the driver's buffer: value() returns a string_view into it and numbers
+ * are parsed only when asked for. The result set keeps the buffer alive, so views taken from it must not
+ * outlive it.
+ */
+class ResultSet {
+public:
+    /**
+     * @brief Default constructor and destructor.
+     */
+    CELL_DEFAULT_INTERFACE_OCTORS(ResultSet)
+
+    /**
+     * @brief Disable copy construction and assignment for a class.
+     */
+    CELL_DISABLE_COPY(ResultSet)
+
+    /**
+     * @brief Returns the number of rows.
+     */
+    __cell_virtual std::size_t rowCount() const = __cell_zero;
+
+    /**
+     * @brief Returns the number of columns.
+     */
+    __cell_virtual std::size_t columnCount() const = __cell_zero;
+
+    /**
+     * @brief Returns the name of a column.
+     */
+    __cell_virtual std::string_view columnName(std::size_t column) const = __cell_zero;
+
+    /**
+     * @brief Checks whether a value is SQL NULL.
+     */
+    __cell_virtual bool isNull(std::size_t row, std::size_t column) const = __cell_zero;
+
+    /**
+     * @brief Returns the raw bytes of a value, pointing into the driver's buffer; empty for NULL.
+     */
+    __cell_virtual std::string_view value(std::size_t row, std::size_t column) const = __cell_zero;
+
+    /**
+     * @brief Returns the wire format of the values.
+     */
+    __cell_virtual ResultFormat format() const;
+
+    /**
+     * @brief Parses a value as an integer.
+     *
+     * @return The value, or std::nullopt for NULL.
+     * @throws std::invalid_argument If the value is not an integer.
+     */
+    __cell_virtual std::optional<std::int64_t> integer(std::size_t row, std::size_t column) const;
+
+    /**
+     * @brief Parses a value as a floating point number.
+     *
+     * @return The value, or std::nullopt for NULL.
+     * @throws std::invalid_argument If the value is not a number.
+     */
+    __cell_virtual std::optional<double> real(std::size_t row, std::size_t column) const;
+
+    /**
+     * @brief Parses a value as a boolean (t/f, true/false, 1/0).
+     *
+     * @return The value, or std::nullopt for NULL.
+     * @throws std::invalid_argument If the value is not a boolean.
+     */
+    __cell_virtual std::optional<bool> boolean(std::size_t row, std::size_t column) const;
+
+    /**
+     * @brief Converts a value to T.
+     *
+     * Supported types are std::string_view (no copy), std::string, bool, integers and floating point types.
+     *
+     * @return The value, or std::nullopt for NULL.
+     * @throws std::invalid_argument If the value cannot be converted.
+     * @throws std::out_of_range If an integer does not fit in T.
+     */
+    template <typename T>
+    std::optional<T> get(std::size_t row, std::size_t column) const
+    {
+        if constexpr (std::is_same_v<T, std::string_view>) {
+            return isNull(row, column) ? std::nullopt : std::optional<T>(value(row, column));
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            return isNull(row, column) ? std::nullopt : std::optional<T>(std::string(value(row, column)));
+        } else if constexpr (std::is_same_v<T, bool>) {
+            return boolean(row, column);
+        } else if constexpr (std::is_integral_v<T>) {
+            const auto number = integer(row, column);
+            if (!number) {
+                return std::nullopt;
+            }
+            if (!std::in_range<T>(*number)) {
+                throw std::out_of_range("Value of column '" + std::string(columnName(column)) + "' does not fit the requested type.");
+            }
+            return static_cast<T>(*number);
+        } else {
+            static_assert(std::is_floating_point_v<T>, "Unsupported result set value type.");
+            const auto number = real(row, column);
+            return number ? std::optional<T>(static_cast<T>(*number)) : std::nullopt;
+        }
+    }
+
+    /**
+     * @brief Returns the index of a column.
+     *
+     * @return The index, or std::nullopt if there is no such column.
+     */
+    std::optional<std::size_t> columnIndex(std::string_view name) const;
+
+    /**
+     * @brief Checks whether the result has no rows.
+     */
+    bool empty() const;
+
+    /**
+     * @brief Returns a view of a row.
+     */
+    ResultRow row(std::size_t row) const;
+
+    /**
+     * @brief Returns a view of a column.
+     */
+    ResultColumn column(std::size_t column) const;
+
+    /**
+     * @brief Iterates over the rows of a result set.
+     */
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = ResultRow;
+        using difference_type   = std::ptrdiff_t;
+
+        Iterator() = default;
+        Iterator(const ResultSet* resultSet, std::size_t row) : m_resultSet(resultSet), m_row(row) {}
+
+        ResultRow operator*() const { return ResultRow(*m_resultSet, m_row); }
+        Iterator& operator++() { ++m_row; return *this; }
+        Iterator operator++(int) { auto copy = *this; ++m_row; return copy; }
+        bool operator==(const Iterator& other) const { return m_row == other.m_row; }
+
+    private:
+        const ResultSet*    m_resultSet {};
+        std::size_t         m_row       {};
+    };
+
+    Iterator begin() const;
+    Iterator end() const;
+
+    /**
+     * @brief Copies the result into the row-of-strings form returned by querySync().
+     *
+     * @param withColumnNames Whether the first row holds the column names.
+     * @param nullValue The text stored for NULL values.
+     */
+    std::vector<std::vector<std::string>> toRows(bool withColumnNames, std::string_view nullValue = {}) const;
+};
+
+using ResultSetPtr = std::unique_ptr<ResultSet>;
+
+inline std::size_t ResultRow::size() const { return m_resultSet->columnCount(); }
+inline bool ResultRow::isNull(std::size_t column) const { return m_resultSet->isNull(m_row, column); }
+inline std::string_view ResultRow::operator[](std::size_t column) const { return m_resultSet->value(m_row, column); }
+
+inline std::string_view ResultRow::operator[](std::string_view name) const
+{
+    const auto column = m_resultSet->columnIndex(name);
+    if (!column) {
+        throw std::out_of_range("No column named '" + std::string(name) + "' in the result set.");
+    }
+    return m_resultSet->value(m_row, *column);
+}
+
+template <typename T>
+std::optional<T> ResultRow::get(std::size_t column) const { return m_resultSet->get<T>(m_row, column); }
+
+inline std::string_view ResultColumn::name() const { return m_resultSet->columnName(m_column); }
+inline std::size_t ResultColumn::size() const { return m_resultSet->rowCount(); }
+inline bool ResultColumn::isNull(std::size_t row) const { return m_resultSet->isNull(row, m_column); }
+inline std::string_view ResultColumn::operator[](std::size_t row) const { return m_resultSet->value(row, m_column); }
+
+template <typename T>
+std::optional<T> ResultColumn::get(std::size_t row) const { return m_resultSet->get<T>(row, m_column); }
+
+CELL_NAMESPACE_END
+
+#endif // CELL_DATABASE_RESULT_SET_ABSTRACT_HPP
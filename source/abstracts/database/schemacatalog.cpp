@@ -0,0 +1,264 @@
+#if __has_include("schemacatalog.hpp")
+#   include "schemacatalog.hpp"
+#else
+#   error "Cell's schemacatalog was not found!"
+#endif
+
+CELL_USING_NAMESPACE Cell;
+
+CELL_NAMESPACE_BEGIN(Cell::Abstracts)
+
+namespace {
+
+/**
+ * @brief Returns the element of a list with a given name, or nullptr.
+ */
+template <typename T>
+const T* findByName(const std::vector<T>& elements, std::string_view name)
+{
+    const auto found = std::ranges::find(elements, name, &T::name);
+    return found == elements.end() ? nullptr : &*found;
+}
+
+/**
+ * @brief Returns a value of a catalog row, or an empty string for NULL.
+ */
+std::string text(const ResultSet& rows, std::size_t row, std::size_t column)
+{
+    return rows.isNull(row, column) ? std::string() : std::string(rows.value(row, column));
+}
+
+/**
+ * @brief Reads a flag of a catalog row.
+ */
+bool flag(const ResultSet& rows, std::size_t row, std::size_t column)
+{
+    if (rows.isNull(row, column)) {
+        return false;
+    }
+    const auto value = rows.value(row, column);
+    return value == "t" || value == "true" || value == "1" || value == "YES";
+}
+
+/**
+ * @brief Reads a number of a catalog row, or zero.
+ */
+std::uint64_t number(const ResultSet& rows, std::size_t row, std::size_t column)
+{
+    std::uint64_t result {};
+    if (!rows.isNull(row, column)) {
+        const auto value = rows.value(row, column);
+        std::from_chars(value.data(), value.data() + value.size(), result);
+    }
+    return result;
+}
+
+/**
+ * @brief Splits a list of a catalog row into its names.
+ */
+std::vector<std::string> list(const ResultSet& rows, std::size_t row, std::size_t column)
+{
+    std::vector<std::string> names;
+    if (rows.isNull(row, column)) {
+        return names;
+    }
+    std::string_view rest = rows.value(row, column);
+    while (!rest.empty()) {
+        const auto separator = rest.find(SCHEMA_CATALOG_CONSTANTS::LIST_SEPARATOR);
+        names.emplace_back(rest.substr(0, separator));
+        if (separator == std::string_view::npos) {
+            break;
+        }
+        rest.remove_prefix(separator + 1);
+    }
+    return names;
+}
+
+}  // namespace
+
+const ColumnDescription* TableDescription::column(std::string_view name) const
+{
+    return findByName(columns, name);
+}
+
+const IndexDescription* TableDescription::index(std::string_view name) const
+{
+    return findByName(indexes, name);
+}
+
+const ForeignKeyDescription* TableDescription::foreignKey(std::string_view name) const
+{
+    return findByName(foreignKeys, name);
+}
+
+SchemaSnapshot::SchemaSnapshot(std::vector<TableDescription> tables, std::uint64_t generation)
+    : m_tables(std::move(tables)), m_generation(generation), m_loadedAt(std::chrono::system_clock::now())
+{
+    std::ranges::sort(m_tables, {}, &TableDescription::name);
+}
+
+const TableDescription* SchemaSnapshot::table(std::string_view name) const
+{
+    const auto found = std::ranges::lower_bound(m_tables, name, {}, &TableDescription::name);
+    return found != m_tables.end() && found->name == name ? &*found : nullptr;
+}
+
+std::vector<std::string> SchemaSnapshot::tableNames() const
+{
+    std::vector<std::string> names;
+    names.reserve(m_tables.size());
+    for (const auto& table : m_tables) {
+        names.push_back(table.name);
+    }
+    return names;
+}
+
+std::uint64_t SchemaSnapshot::generation() const
+{
+    return m_generation;
+}
+
+std::chrono::system_clock::time_point SchemaSnapshot::loadedAt() const
+{
+    return m_loadedAt;
+}
+
+SchemaSnapshotPtr SchemaCatalog::snapshot(const Loader& loader)
+{
+    auto current = m_snapshot.load(std::memory_order_acquire);
+    if (current && current->generation() == m_generation.load(std::memory_order_acquire)) {
+        m_hits.fetch_add(1, std::memory_order_relaxed);
+        return current;
+    }
+
+    std::lock_guard<std::mutex> lock(m_loadMutex);
+    // Another caller may have loaded it while this one waited
+    const auto generation = m_generation.load(std::memory_order_acquire);
+    current = m_snapshot.load(std::memory_order_acquire);
+    if (current && current->generation() == generation) {
+        m_hits.fetch_add(1, std::memory_order_relaxed);
+        return current;
+    }
+
+    // Tagged with the generation it started in, so an invalidation during the load leaves it stale
+    auto loaded = std::make_shared<const SchemaSnapshot>(loader(), generation);
+    m_loads.fetch_add(1, std::memory_order_relaxed);
+    m_snapshot.store(loaded, std::memory_order_release);
+    return loaded;
+}
+
+void SchemaCatalog::invalidate()
+{
+    m_generation.fetch_add(1, std::memory_order_acq_rel);
+    m_invalidations.fetch_add(1, std::memory_order_relaxed);
+}
+
+SchemaCatalogStatistics SchemaCatalog::statistics() const
+{
+    SchemaCatalogStatistics statistics;
+    statistics.hits = m_hits.load(std::memory_order_relaxed);
+    statistics.loads = m_loads.load(std::memory_order_relaxed);
+    statistics.invalidations = m_invalidations.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+std::vector<TableDescription> SchemaCatalog::parse(const ResultSet& rows)
+{
+    if (rows.rowCount() > 0 && rows.columnCount() != SCHEMA_CATALOG_CONSTANTS::ROW_COLUMNS) {
+        throw std::invalid_argument("A schema catalog row must have " + std::to_string(SCHEMA_CATALOG_CONSTANTS::ROW_COLUMNS) + " columns.");
+    }
+
+    std::unordered_map<std::string, TableDescription> tables;
+    std::unordered_map<std::string, std::vector<std::pair<std::uint64_t, std::string>>> keyPositions;
+    for (std::size_t row = 0; row < rows.rowCount(); ++row) {
+        const auto kind = rows.value(row, 0);
+        const std::string tableName = text(rows, row, 1);
+        auto& table = tables[tableName];
+        table.name = tableName;
+
+        if (kind == "c") {
+            ColumnDescription column;
+            column.name = text(rows, row, 2);
+            column.type = text(rows, row, 3);
+            column.typeId = static_cast<std::uint32_t>(number(rows, row, 4));
+            column.kind = kindOf(column.type);
+            column.nullable = flag(rows, row, 5);
+            if (!rows.isNull(row, 6)) {
+                column.defaultValue = std::string(rows.value(row, 6));
+            }
+            column.position = static_cast<std::size_t>(number(rows, row, 7));
+            if (const auto keyPosition = number(rows, row, 8); keyPosition > 0) {
+                keyPositions[tableName].emplace_back(keyPosition, column.name);
+            }
+            table.columns.push_back(std::move(column));
+        } else if (kind == "i") {
+            IndexDescription index;
+            index.name = text(rows, row, 2);
+            index.columns = list(rows, row, 3);
+            index.unique = flag(rows, row, 4);
+            index.primary = flag(rows, row, 5);
+            if (index.primary) {
+                table.primaryKey = index.columns;
+            }
+            table.indexes.push_back(std::move(index));
+        } else if (kind == "f") {
+            ForeignKeyDescription foreignKey;
+            foreignKey.name = text(rows, row, 2);
+            foreignKey.columns = list(rows, row, 3);
+            foreignKey.referencedTable = text(rows, row, 4);
+            foreignKey.referencedColumns = list(rows, row, 5);
+            table.foreignKeys.push_back(std::move(foreignKey));
+        }
+    }
+
+    std::vector<TableDescription> result;
+    result.reserve(tables.size());
+    for (auto& [name, table] : tables) {
+        std::ranges::sort(table.columns, {}, &ColumnDescription::position);
+        // A key without an index of its own (SQLite's rowid) is only known from its columns
+        if (auto& positions = keyPositions[name]; table.primaryKey.empty() && !positions.empty()) {
+            std::ranges::sort(positions);
+            for (auto& [position, column] : positions) {
+                table.primaryKey.push_back(std::move(column));
+            }
+        }
+        result.push_back(std::move(table));
+    }
+    return result;
+}
+
+ColumnKind SchemaCatalog::kindOf(std::string_view type)
+{
+    std::string lower(type);
+    std::ranges::transform(lower, lower.begin(), [](unsigned char character) { return static_cast<char>(std::tolower(character)); });
+    const auto has = [&lower](std::string_view part) { return lower.find(part) != std::string::npos; };
+
+    // Order matters: "interval" and "point" contain "int", "timestamp" contains "time"
+    if (has("bool")) {
+        return ColumnKind::Boolean;
+    }
+    if (has("interval") || has("date") || has("time") || has("year")) {
+        return ColumnKind::Temporal;
+    }
+    if (has("point")) {
+        return ColumnKind::Other;
+    }
+    if (has("int") || has("serial")) {
+        return ColumnKind::Integer;
+    }
+    if (has("numeric") || has("decimal") || has("money")) {
+        return ColumnKind::Decimal;
+    }
+    if (has("real") || has("double") || has("float")) {
+        return ColumnKind::Real;
+    }
+    if (has("bytea") || has("blob") || has("binary")) {
+        return ColumnKind::Binary;
+    }
+    if (has("char") || has("text") || has("clob") || has("json") || has("uuid") || has("enum") || has("set") || has("xml")) {
+        return ColumnKind::Text;
+    }
+    return ColumnKind::Other;
+}
+
+CELL_NAMESPACE_END
@@ -0,0 +1,261 @@
+/*!
+ * @file        schemacatalog.hpp
+ * @brief       Schema metadata cache for the Cell Engine.
+ * @details     This file defines SchemaCatalog, which serves table, column, key and index metadata from immutable snapshots.
+ * @author      Kambiz Asadzadeh
+ * @since       07 Jun 2023
+ * @version     1.0
+ * @note        This is part of the Cell Engine, developed by Kambiz Asadzadeh.
+ *
+ * @license     This file is licensed under the terms of the Genyleap License. See the LICENSE.md file for more information.
+ * @copyright   Copyright (c) 2025 The Genyleap | Kambiz Asadzadeh. All rights reserved.
+ * @see         https://github.com/genyleap/cell
+ */
+
+#ifndef CELL_DATABASE_SCHEMA_CATALOG_ABSTRACT_HPP
+#define CELL_DATABASE_SCHEMA_CATALOG_ABSTRACT_HPP
+
+//! Cell's Common.
+#if __has_include(<common>)
+#   include <common>
+#else
+#   error "Cell's common was not found!"
+#endif
+
+//! Cell's Core (Core Only).
+#if __has_include(<core>)
+#   include <core>
+#else
+#   error "Cell's requirements was not found!"
+#endif
+
+#if __has_include("resultset.hpp")
+#   include "resultset.hpp"
+#else
+#   error "Cell's resultset was not found!"
+#endif
+
+CELL_NAMESPACE_BEGIN(Cell::Abstracts)
+
+/**
+ * @brief Constants related to the schema catalog.
+ */
+struct SCHEMA_CATALOG_CONSTANTS final
+{
+    __cell_static_const_constexpr char LIST_SEPARATOR = '\x1f';    //!< Separates the names of a list in a catalog row (ASCII unit separator).
+    __cell_static_const_constexpr std::size_t ROW_COLUMNS = 9;     //!< Columns of a catalog row.
+};
+
+/**
+ * @brief The family of a column's type, telling which ResultSet::get<T>() reads it.
+ */
+enum class ColumnKind : Types::u8
+{
+    Integer,    //!< Read with get<std::int64_t>().
+    Real,       //!< Read with get<double>().
+    Decimal,    //!< Exact numbers; read as text to keep every digit.
+    Boolean,    //!< Read with get<bool>().
+    Text,       //!< Character data, JSON, UUIDs and enumerations.
+    Binary,     //!< Byte strings.
+    Temporal,   //!< Dates, times and intervals, as text.
+    Other       //!< Anything else, as text.
+};
+
+/**
+ * @brief A column of a table.
+ */
+struct ColumnDescription final
+{
+    std::string                 name            {};                     //!< The column.
+    std::string                 type            {};                     //!< Its declared type, e.g. `character varying(64)`.
+    std::uint32_t               typeId          {};                     //!< The server's type id (a PostgreSQL OID) to declare a parameter with; 0 if the server has none.
+    ColumnKind                  kind            { ColumnKind::Other };  //!< The family of the type.
+    bool                        nullable        { true };               //!< Whether it accepts NULL.
+    std::optional<std::string>  defaultValue    {};                     //!< Its default expression, if any.
+    std::size_t                 position        {};                     //!< 1-based position in the table.
+};
+
+/**
+ * @brief An index of a table.
+ */
+struct IndexDescription final
+{
+    std::string                 name        {};         //!< The index.
+    std::vector<std::string>    columns     {};         //!< Its columns, in key order; expressions are left out.
+    bool                        unique      { false };  //!< Whether it enforces uniqueness.
+    bool                        primary     { false };  //!< Whether it backs the primary key.
+};
+
+/**
+ * @brief A foreign key of a table.
+ */
+struct ForeignKeyDescription final
+{
+    std::string                 name                {}; //!< The constraint.
+    std::vector<std::string>    columns             {}; //!< The referencing columns.
+    std::string                 referencedTable     {}; //!< The referenced table.
+    std::vector<std::string>    referencedColumns   {}; //!< The referenced columns, in the same order.
+};
+
+/**
+ * @brief The metadata of a table or view.
+ */
+struct TableDescription final
+{
+    std::string                         name        {}; //!< The table.
+    std::vector<ColumnDescription>      columns     {}; //!< Its columns, in table order.
+    std::vector<std::string>            primaryKey  {}; //!< Its primary key columns, in key order; empty if it has none.
+    std::vector<IndexDescription>       indexes     {}; //!< Its indexes.
+    std::vector<ForeignKeyDescription>  foreignKeys {}; //!< Its foreign keys.
+
+    /**
+     * @brief Returns a column by name, or nullptr.
+     */
+    const ColumnDescription* column(std::string_view name) const;
+
+    /**
+     * @brief Returns an index by name, or nullptr.
+     */
+    const IndexDescription* index(std::string_view name) const;
+
+    /**
+     * @brief Returns a foreign key by constraint name, or nullptr.
+     */
+    const ForeignKeyDescription* foreignKey(std::string_view name) const;
+};
+
+/**
+ * @brief An immutable copy of the schema, shared by every reader.
+ */
+class SchemaSnapshot {
+public:
+    /**
+     * @brief Constructs a snapshot.
+     *
+     * @param tables The tables.
+     * @param generation The catalog generation the tables were loaded in.
+     */
+    SchemaSnapshot(std::vector<TableDescription> tables, std::uint64_t generation);
+
+    /**
+     * @brief Returns a table by name, or nullptr.
+     */
+    const TableDescription* table(std::string_view name) const;
+
+    /**
+     * @brief Returns the names of the tables, sorted.
+     */
+    std::vector<std::string> tableNames() const;
+
+    /**
+     * @brief Returns the catalog generation the snapshot was loaded in.
+     */
+    std::uint64_t generation() const;
+
+    /**
+     * @brief Returns when the snapshot was loaded.
+     */
+    std::chrono::system_clock::time_point loadedAt() const;
+
+private:
+    std::vector<TableDescription>               m_tables        {}; //!< The tables, sorted by name.
+    std::uint64_t                               m_generation    {}; //!< The generation it was loaded in.
+    std::chrono::system_clock::time_point       m_loadedAt      {}; //!< When it was loaded.
+};
+
+using SchemaSnapshotPtr = std::shared_ptr<const SchemaSnapshot>;
+
+/**
+ * @brief A snapshot of the counters of a schema catalog.
+ */
+struct SchemaCatalogStatistics final
+{
+    std::uint64_t hits          {}; //!< Lookups served by the current snapshot.
+    std::uint64_t loads         {}; //!< Snapshots loaded from the server.
+    std::uint64_t invalidations {}; //!< Schema changes that made the snapshot stale.
+};
+
+/**
+ * @brief A cache of the schema of a database, shared by every connection of a pool.
+ *
+ * Introspection queries against the server's catalog are slow, and ORM-style code asks for the same
+ * columns and keys on every request. The catalog instead loads every table, column, key and index with
+ * one statement and keeps them in an immutable snapshot. Lookups only load the current snapshot
+ * pointer and never lock; a reload builds a new snapshot and swaps it in, and readers still holding
+ * the old one keep using it until they let it go (read-copy-update).
+ *
+ * A schema change made through the driver's TableManager calls invalidate(), and the next lookup
+ * reloads. One caller loads while the others wait for its result. A load that overlaps an
+ * invalidation is handed to its callers but is stale at once, so the change is never missed.
+ *
+ * Schema changes made by other applications or through plain statements are not seen; call
+ * invalidate() for them.
+ */
+class SchemaCatalog {
+public:
+    /**
+     * @brief Reads the whole schema from the server.
+     */
+    using Loader = std::function<std::vector<TableDescription>()>;
+
+    /**
+     * @brief Constructs an empty catalog that loads on first use.
+     */
+    SchemaCatalog() = default;
+
+    /**
+     * @brief Disable copy construction and assignment for a class.
+     */
+    CELL_DISABLE_COPY(SchemaCatalog)
+
+    /**
+     * @brief Returns the current snapshot, loading a new one if the schema changed since.
+     *
+     * @param loader Reads the schema; it throws to report an error, and the old snapshot stays.
+     * @throws Whatever the loader threw.
+     */
+    SchemaSnapshotPtr snapshot(const Loader& loader);
+
+    /**
+     * @brief Marks the current snapshot as stale, so the next lookup reloads.
+     */
+    void invalidate();
+
+    /**
+     * @brief Returns the counters of the catalog.
+     */
+    SchemaCatalogStatistics statistics() const;
+
+    /**
+     * @brief Turns the rows of a driver's catalog statement into tables.
+     *
+     * Every row has ROW_COLUMNS columns: a kind, the table, a name and six values whose meaning depends
+     * on the kind. Unused values are NULL, flags are `t`/`f` (or `1`/`0`), and lists are names joined
+     * with LIST_SEPARATOR.
+     * - `c`, a column: type, type id, nullable, default, position, position in the primary key.
+     * - `i`, an index: columns, unique, primary.
+     * - `f`, a foreign key: columns, referenced table, referenced columns.
+     *
+     * The primary key is taken from the primary index, or else from the columns' key positions.
+     *
+     * @throws std::invalid_argument If the rows do not have ROW_COLUMNS columns.
+     */
+    static std::vector<TableDescription> parse(const ResultSet& rows);
+
+    /**
+     * @brief Returns the family of a declared type.
+     */
+    static ColumnKind kindOf(std::string_view type);
+
+private:
+    std::atomic<SchemaSnapshotPtr>  m_snapshot      {};         //!< The current snapshot; empty until the first load.
+    std::atomic<std::uint64_t>      m_generation    { 1 };      //!< Incremented by every invalidation.
+    std::mutex                      m_loadMutex     {};         //!< Lets one caller load at a time.
+    std::atomic<std::uint64_t>      m_hits          {};         //!< Lookups served by the current snapshot.
+    std::atomic<std::uint64_t>      m_loads         {};         //!< Snapshots loaded.
+    std::atomic<std::uint64_t>      m_invalidations {};         //!< Calls of invalidate().
+};
+
+CELL_NAMESPACE_END
+
+#endif  // CELL_DATABASE_SCHEMA_CATALOG_ABSTRACT_HPP
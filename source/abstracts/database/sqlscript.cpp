@@ -0,0 +1,194 @@
+#if __has_include("sqlscript.hpp")
+#   include "sqlscript.hpp"
+#else
+#   error "Cell's sqlscript was not found!"
+#endif
+
+CELL_USING_NAMESPACE Cell;
+
+CELL_NAMESPACE_BEGIN(Cell::Abstracts)
+
+namespace {
+
+/**
+ * @brief Checks whether a character may be part of an unquoted identifier or a dollar quote tag.
+ */
+bool isIdentifierCharacter(int character)
+{
+    return character == '_' || character >= 0x80 || std::isalnum(character);
+}
+
+}  // namespace
+
+SqlScriptReader::SqlScriptReader(std::istream& input, const SqlScriptDialect& dialect)
+    : m_input(input.rdbuf()), m_dialect(dialect)
+{
+}
+
+std::optional<std::string> SqlScriptReader::next()
+{
+    constexpr int end = std::char_traits<char>::eof();
+    m_statement.clear();
+    m_hasCode = false;
+
+    for (int character = take(); character != end; character = take()) {
+        const char value = static_cast<char>(character);
+        switch (m_state) {
+        case State::Code:
+            if (value == ';') {
+                if (m_hasCode) {
+                    return complete();
+                }
+                // Only comments so far; they are dropped with the empty statement
+                m_statement.clear();
+                continue;
+            }
+            if (m_statement.empty() && std::isspace(static_cast<unsigned char>(value))) {
+                continue;
+            }
+            if (value == '-' && m_input->sgetc() == '-') {
+                m_state = State::LineComment;
+                append(value);
+                continue;
+            }
+            if (value == '/' && m_input->sgetc() == '*') {
+                m_state = State::BlockComment;
+                m_depth = 1;
+                append(value);
+                append(static_cast<char>(take()));
+                continue;
+            }
+            if (value == '\'') {
+                // E'...' unless the E ends a longer word
+                const std::size_t size = m_statement.size();
+                const bool escapeString = m_dialect.escapeStrings && size > 0 && (m_statement[size - 1] == 'E' || m_statement[size - 1] == 'e')
+                                          && (size == 1 || !isIdentifierCharacter(static_cast<unsigned char>(m_statement[size - 2])));
+                m_escapes = m_dialect.backslashEscapes || escapeString;
+                m_state = State::String;
+            } else if (value == '"' || (value == '`' && m_dialect.backtickQuotes)) {
+                m_delimiter.assign(1, value);
+                m_state = State::Identifier;
+            } else if (value == '$' && m_dialect.dollarQuotes
+                       && (m_statement.empty() || !isIdentifierCharacter(static_cast<unsigned char>(m_statement.back())))) {
+                // $tag$ or $$ opens a literal; $1 is a parameter
+                std::string tag(1, value);
+                if (!std::isdigit(m_input->sgetc())) {
+                    while (isIdentifierCharacter(m_input->sgetc())) {
+                        tag += static_cast<char>(take());
+                    }
+                }
+                if (m_input->sgetc() == '$') {
+                    tag += static_cast<char>(take());
+                    m_delimiter = tag;
+                    m_state = State::DollarString;
+                }
+                m_hasCode = true;
+                for (const char tagCharacter : tag) {
+                    append(tagCharacter);
+                }
+                m_delimiterEnd = m_statement.size();
+                continue;
+            }
+            m_hasCode = m_hasCode || !std::isspace(static_cast<unsigned char>(value));
+            append(value);
+            break;
+
+        case State::String:
+            append(value);
+            if (value == '\\' && m_escapes) {
+                if (const int escaped = take(); escaped != end) {
+                    append(static_cast<char>(escaped));
+                }
+            } else if (value == '\'') {
+                // A doubled quote stays inside the literal
+                if (m_input->sgetc() == '\'') {
+                    append(static_cast<char>(take()));
+                } else {
+                    m_state = State::Code;
+                }
+            }
+            break;
+
+        case State::Identifier:
+            append(value);
+            if (value == m_delimiter.front()) {
+                if (m_input->sgetc() == m_delimiter.front()) {
+                    append(static_cast<char>(take()));
+                } else {
+                    m_state = State::Code;
+                }
+            }
+            break;
+
+        case State::LineComment:
+            append(value);
+            if (value == '\n') {
+                m_state = State::Code;
+            }
+            break;
+
+        case State::BlockComment:
+            append(value);
+            if (value == '*' && m_input->sgetc() == '/') {
+                append(static_cast<char>(take()));
+                if (--m_depth == 0) {
+                    m_state = State::Code;
+                }
+            } else if (value == '/' && m_input->sgetc() == '*' && m_dialect.nestedComments) {
+                append(static_cast<char>(take()));
+                ++m_depth;
+            }
+            break;
+
+        case State::DollarString:
+            append(value);
+            if (value == '$' && m_statement.size() >= m_delimiterEnd + m_delimiter.size() && m_statement.ends_with(m_delimiter)) {
+                m_state = State::Code;
+            }
+            break;
+        }
+    }
+
+    if (m_state != State::Code && m_state != State::LineComment) {
+        throw std::runtime_error("The script ends inside a literal, a quoted identifier or a comment of the statement on line "
+                                 + std::to_string(m_startLine) + ".");
+    }
+    m_state = State::Code;
+    if (!m_hasCode) {
+        return std::nullopt;
+    }
+    return complete();
+}
+
+std::size_t SqlScriptReader::line() const
+{
+    return m_returnedLine;
+}
+
+std::string SqlScriptReader::complete()
+{
+    m_returnedLine = m_startLine;
+    while (!m_statement.empty() && std::isspace(static_cast<unsigned char>(m_statement.back()))) {
+        m_statement.pop_back();
+    }
+    return m_statement;
+}
+
+int SqlScriptReader::take()
+{
+    const int character = m_input->sbumpc();
+    if (character == '\n') {
+        ++m_line;
+    }
+    return character;
+}
+
+void SqlScriptReader::append(char character)
+{
+    if (m_statement.empty()) {
+        m_startLine = character == '\n' ? m_line - 1 : m_line;
+    }
+    m_statement += character;
+}
+
+CELL_NAMESPACE_END
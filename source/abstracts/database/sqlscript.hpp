@@ -0,0 +1,134 @@
+/*!
+ * @file        sqlscript.hpp
+ * @brief       Streaming SQL script reader for the Cell Engine.
+ * @details     This file defines SqlScriptReader, which splits a script into statements while it is read.
+ * @author      Kambiz Asadzadeh
+ * @since       07 Jun 2023
+ * @version     1.0
+ * @note        This is part of the Cell Engine, developed by Kambiz Asadzadeh.
+ *
+ * @license     This file is licensed under the terms of the Genyleap License. See the LICENSE.md file for more information.
+ * @copyright   Copyright (c) 2025 The Genyleap | Kambiz Asadzadeh. All rights reserved.
+ * @see         https://github.com/genyleap/cell
+ */
+
+#ifndef CELL_DATABASE_SQL_SCRIPT_ABSTRACT_HPP
+#define CELL_DATABASE_SQL_SCRIPT_ABSTRACT_HPP
+
+//! Cell's Common.
+#if __has_include(<common>)
+#   include <common>
+#else
+#   error "Cell's common was not found!"
+#endif
+
+//! Cell's Core (Core Only).
+#if __has_include(<core>)
+#   include <core>
+#else
+#   error "Cell's requirements was not found!"
+#endif
+
+CELL_NAMESPACE_BEGIN(Cell::Abstracts)
+
+/**
+ * @brief The driver-specific lexical rules a script is split by.
+ */
+struct SqlScriptDialect final
+{
+    bool dollarQuotes       { false };  //!< PostgreSQL `$tag$ ... $tag$` strings.
+    bool escapeStrings      { false };  //!< PostgreSQL `E'...'` strings, in which a backslash escapes.
+    bool backslashEscapes   { false };  //!< A backslash escapes in every string (MySQL).
+    bool backtickQuotes     { false };  //!< `` `name` `` identifiers (MySQL).
+    bool nestedComments     { false };  //!< Block comments nest (PostgreSQL).
+};
+
+/**
+ * @brief Splits a SQL script into statements while it is read.
+ *
+ * The script is read from a stream in the stream's own buffer-sized steps, and next() returns as soon
+ * as a statement is complete, so a driver executes the first statement before the rest of the file is
+ * read and memory is bounded by the longest statement rather than the script.
+ *
+ * Statements end with a semicolon outside string literals, quoted identifiers and comments. Comments
+ * are kept in the statement text, so optimizer hints and MySQL's executable comments still reach the
+ * server, but a statement of only comments and blanks is skipped.
+ *
+ * Client commands (psql's `\connect`, MySQL's `DELIMITER`) are not interpreted and are sent as they
+ * are. An SQLite trigger body, whose statements end with semicolons too, is not recognized.
+ */
+class SqlScriptReader {
+public:
+    /**
+     * @brief Constructs a reader of a stream; the stream must outlive it.
+     *
+     * @param input The script.
+     * @param dialect The lexical rules of the driver.
+     */
+    SqlScriptReader(std::istream& input, const SqlScriptDialect& dialect = {});
+
+    /**
+     * @brief Disable copy construction and assignment for a class.
+     */
+    CELL_DISABLE_COPY(SqlScriptReader)
+
+    /**
+     * @brief Reads the next statement.
+     *
+     * @return The statement without its terminator or surrounding blanks, or std::nullopt at the end of the script.
+     *         A last statement without a terminator is returned too.
+     * @throws std::runtime_error If the script ends inside a string literal, a quoted identifier or a comment.
+     */
+    std::optional<std::string> next();
+
+    /**
+     * @brief Returns the 1-based line the statement returned last starts on.
+     */
+    std::size_t line() const;
+
+private:
+    /**
+     * @brief The construct the reader is inside of.
+     */
+    enum class State : Types::u8
+    {
+        Code,           //!< Plain SQL.
+        String,         //!< A '...' literal.
+        Identifier,     //!< A "..." or `...` identifier.
+        LineComment,    //!< A -- comment.
+        BlockComment,   //!< A block comment.
+        DollarString    //!< A $tag$ ... $tag$ literal.
+    };
+
+    /**
+     * @brief Returns the statement read, without trailing blanks.
+     */
+    std::string complete();
+
+    /**
+     * @brief Takes the next character of the stream, counting lines.
+     */
+    int take();
+
+    /**
+     * @brief Appends a character of the statement, marking where its first line is.
+     */
+    void append(char character);
+
+    std::streambuf*     m_input         {};                 //!< The script.
+    SqlScriptDialect    m_dialect       {};                 //!< Its lexical rules.
+    std::string         m_statement     {};                 //!< The statement being read.
+    std::string         m_delimiter     {};                 //!< Closing `$tag$` or quote of the current literal.
+    std::size_t         m_delimiterEnd  {};                 //!< Length of the statement after its opening dollar quote.
+    std::size_t         m_depth         {};                 //!< Depth of nested block comments.
+    std::size_t         m_line          { 1 };              //!< Line of the next character.
+    std::size_t         m_startLine     { 1 };              //!< Line the current statement starts on.
+    std::size_t         m_returnedLine  { 1 };              //!< Line the statement returned last starts on.
+    State               m_state         { State::Code };    //!< Where the reader is.
+    bool                m_escapes       { false };          //!< Whether a backslash escapes in the current literal.
+    bool                m_hasCode       { false };          //!< Whether the statement has anything but comments and blanks.
+};
+
+CELL_NAMESPACE_END
+
+#endif  // CELL_DATABASE_SQL_SCRIPT_ABSTRACT_HPP
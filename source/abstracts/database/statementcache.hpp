@@ -0,0 +1,317 @@
+/*!
+ * @file        statementcache.hpp
+ * @brief       Prepared statement cache for the Cell Engine.
+ * @details     This file defines StatementCache, a bounded LRU of prepared statements owned by one physical connection.
+ * @author      Kambiz Asadzadeh
+ * @since       07 Jun 2023
+ * @version     1.0
+ * @note        This is part of the Cell Engine, developed by Kambiz Asadzadeh.
+ *
+ * @license     This file is licensed under the terms of the Genyleap License. See the LICENSE.md file for more information.
+ * @copyright   Copyright (c) 2025 The Genyleap | Kambiz Asadzadeh. All rights reserved.
+ * @see         https://github.com/genyleap/cell
+ */
+
+#ifndef CELL_DATABASE_STATEMENT_CACHE_ABSTRACT_HPP
+#define CELL_DATABASE_STATEMENT_CACHE_ABSTRACT_HPP
+
+//! Cell's Common.
+#if __has_include(<common>)
+#   include <common>
+#else
+#   error "Cell's common was not found!"
+#endif
+
+//! Cell's Core (Core Only).
+#if __has_include(<core>)
+#   include <core>
+#else
+#   error "Cell's requirements was not found!"
+#endif
+
+CELL_NAMESPACE_BEGIN(Cell::Abstracts)
+
+/**
+ * @brief Constants related to prepared statement caches.
+ */
+struct STATEMENT_CACHE_CONSTANTS final
+{
+    __cell_static_const_constexpr std::size_t DEFAULT_CAPACITY = 64; //!< Statements kept per connection.
+};
+
+/**
+ * @brief A snapshot of the counters shared by the statement caches of a pool.
+ */
+struct StatementCacheStatistics final
+{
+    std::uint64_t hits          {}; //!< Lookups that found a prepared statement.
+    std::uint64_t misses        {}; //!< Lookups that had to prepare the statement.
+    std::uint64_t evictions     {}; //!< Statements closed to make room for a new one.
+    std::uint64_t invalidations {}; //!< Statements dropped after a schema change or a lost session.
+
+    /**
+     * @brief Returns the fraction of lookups served from the cache.
+     */
+    double hitRatio() const
+    {
+        const auto lookups = hits + misses;
+        return lookups == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(lookups);
+    }
+};
+
+/**
+ * @brief Counters updated concurrently by every cache of a pool.
+ */
+struct StatementCacheCounters final
+{
+    std::atomic<std::uint64_t> hits          {};
+    std::atomic<std::uint64_t> misses        {};
+    std::atomic<std::uint64_t> evictions     {};
+    std::atomic<std::uint64_t> invalidations {};
+
+    StatementCacheStatistics snapshot() const
+    {
+        return StatementCacheStatistics {
+            .hits           = hits.load(std::memory_order_relaxed),
+            .misses         = misses.load(std::memory_order_relaxed),
+            .evictions      = evictions.load(std::memory_order_relaxed),
+            .invalidations  = invalidations.load(std::memory_order_relaxed)
+        };
+    }
+};
+
+/**
+ * @brief A bounded LRU of prepared statements keyed by SQL text.
+ *
+ * A cache belongs to a single physical connection and is only touched by whoever currently holds that
+ * connection, so it needs no locking of its own. Statements pushed out of the cache, or dropped with
+ * erase() and clear(), are handed to the finalizer so the driver can close them on the server.
+ *
+ * @tparam Handle The driver's statement handle (a statement name, a MYSQL_STMT*, ...).
+ */
+template <typename Handle>
+class StatementCache {
+public:
+    using Finalizer = std::function<void(Handle&)>;
+
+    /**
+     * @brief Constructs an empty cache.
+     *
+     * @param capacity The maximum number of statements kept.
+     * @param finalizer Closes a statement that leaves the cache.
+     * @param counters The counters to update.
+     */
+    StatementCache(std::size_t capacity, Finalizer finalizer, StatementCacheCounters& counters)
+        : m_capacity(capacity), m_finalizer(std::move(finalizer)), m_counters(counters)
+    {
+    }
+
+    ~StatementCache() { clear(); }
+
+    /**
+     * @brief Disable copy construction and assignment for a class.
+     */
+    CELL_DISABLE_COPY(StatementCache)
+
+    /**
+     * @brief Looks up a statement and marks it as the most recently used.
+     *
+     * @param sql The SQL text the statement was prepared from.
+     * @return The cached handle, or nullptr if the statement has to be prepared.
+     */
+    Handle* find(const std::string& sql)
+    {
+        const auto it = m_index.find(sql);
+        if (it == m_index.end()) {
+            m_counters.misses.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        m_counters.hits.fetch_add(1, std::memory_order_relaxed);
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        return &it->second->second;
+    }
+
+    /**
+     * @brief Adds a freshly prepared statement, evicting the least recently used ones if the cache is full.
+     *
+     * @param sql The SQL text the statement was prepared from.
+     * @param handle The statement handle; the cache takes ownership.
+     * @return The handle stored in the cache.
+     */
+    Handle& insert(const std::string& sql, Handle handle)
+    {
+        erase(sql);
+        const auto capacity = std::max<std::size_t>(m_capacity.load(std::memory_order_relaxed), 1);
+        while (m_entries.size() >= capacity) {
+            auto& victim = m_entries.back();
+            m_index.erase(victim.first);
+            m_finalizer(victim.second);
+            m_entries.pop_back();
+            m_counters.evictions.fetch_add(1, std::memory_order_relaxed);
+        }
+        m_entries.emplace_front(sql, std::move(handle));
+        m_index.emplace(m_entries.front().first, m_entries.begin());
+        return m_entries.front().second;
+    }
+
+    /**
+     * @brief Drops a statement that the server no longer accepts, e.g. after the table it reads changed.
+     *
+     * @param sql The SQL text the statement was prepared from.
+     */
+    void invalidate(const std::string& sql)
+    {
+        if (erase(sql)) {
+            m_counters.invalidations.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Closes and removes every statement.
+     */
+    void clear()
+    {
+        for (auto& entry : m_entries) {
+            m_finalizer(entry.second);
+        }
+        m_index.clear();
+        m_entries.clear();
+    }
+
+    /**
+     * @brief Removes every statement without closing it, for a session that is already gone.
+     */
+    void abandon()
+    {
+        m_counters.invalidations.fetch_add(m_entries.size(), std::memory_order_relaxed);
+        m_index.clear();
+        m_entries.clear();
+    }
+
+    /**
+     * @brief Returns a number unique within this cache, for drivers that name their statements.
+     */
+    std::uint64_t nextSequence() { return ++m_sequence; }
+
+    /**
+     * @brief Changes the maximum number of statements; a smaller limit is enforced on the next insert.
+     */
+    void setCapacity(std::size_t capacity) { m_capacity.store(capacity, std::memory_order_relaxed); }
+
+    /**
+     * @brief Returns the number of cached statements.
+     */
+    std::size_t size() const { return m_entries.size(); }
+
+private:
+    bool erase(const std::string& sql)
+    {
+        const auto it = m_index.find(sql);
+        if (it == m_index.end()) {
+            return false;
+        }
+        const auto entry = it->second;
+        m_index.erase(it);
+        m_finalizer(entry->second);
+        m_entries.erase(entry);
+        return true;
+    }
+
+    using Entries = std::list<std::pair<std::string, Handle>>;
+
+    std::atomic<std::size_t>                                            m_capacity  {};     //!< Maximum number of statements.
+    Finalizer                                                           m_finalizer {};     //!< Closes evicted statements.
+    StatementCacheCounters&                                             m_counters;         //!< Shared counters.
+    Entries                                                             m_entries   {};     //!< Most recently used first.
+    std::unordered_map<std::string_view, typename Entries::iterator>    m_index     {};     //!< Keys point into m_entries.
+    std::uint64_t                                                       m_sequence  {};     //!< Last number handed out by nextSequence().
+};
+
+/**
+ * @brief The statement caches of every connection of a pool.
+ *
+ * Looking a cache up takes the registry lock; using it afterwards does not, because only the holder of
+ * the connection touches its cache. Drivers call remove() before closing a connection so statements
+ * never outlive the session they were prepared on.
+ *
+ * @tparam Connection The driver connection handle.
+ * @tparam Handle The driver's statement handle.
+ */
+template <typename Connection, typename Handle>
+class StatementCacheRegistry {
+public:
+    using Cache = StatementCache<Handle>;
+
+    StatementCacheRegistry() = default;
+
+    /**
+     * @brief Disable copy construction and assignment for a class.
+     */
+    CELL_DISABLE_COPY(StatementCacheRegistry)
+
+    /**
+     * @brief Returns the cache of a connection, creating it on first use.
+     *
+     * @param connection The connection the statements are prepared on.
+     * @param finalizer Closes a statement of this connection; only used when the cache is created.
+     */
+    Cache& cacheFor(Connection connection, const typename Cache::Finalizer& finalizer)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto& cache = m_caches[connection];
+        if (!cache) {
+            cache = std::make_unique<Cache>(m_capacity.load(std::memory_order_relaxed), finalizer, m_counters);
+        }
+        return *cache;
+    }
+
+    /**
+     * @brief Forgets the cache of a connection that is about to be closed.
+     *
+     * @param connection The connection being closed.
+     * @param finalize Whether the statements still have to be closed one by one.
+     */
+    void remove(Connection connection, bool finalize)
+    {
+        std::unique_ptr<Cache> cache;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            const auto it = m_caches.find(connection);
+            if (it == m_caches.end()) {
+                return;
+            }
+            cache = std::move(it->second);
+            m_caches.erase(it);
+        }
+        if (!finalize) {
+            cache->abandon();
+        }
+    }
+
+    /**
+     * @brief Sets the number of statements kept per connection.
+     */
+    void setCapacity(std::size_t capacity)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_capacity.store(capacity, std::memory_order_relaxed);
+        for (auto& [connection, cache] : m_caches) {
+            cache->setCapacity(capacity);
+        }
+    }
+
+    /**
+     * @brief Returns the hit, miss, eviction and invalidation counters of all caches.
+     */
+    StatementCacheStatistics statistics() const { return m_counters.snapshot(); }
+
+private:
+    mutable std::mutex                                          m_mutex     {};
+    std::unordered_map<Connection, std::unique_ptr<Cache>>      m_caches    {};
+    std::atomic<std::size_t>                                    m_capacity  { STATEMENT_CACHE_CONSTANTS::DEFAULT_CAPACITY };
+    StatementCacheCounters                                      m_counters  {};
+};
+
+CELL_NAMESPACE_END
+
+#endif // CELL_DATABASE_STATEMENT_CACHE_ABSTRACT_HPP
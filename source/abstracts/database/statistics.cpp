@@ -0,0 +1,152 @@
+#if __has_include("statistics.hpp")
+#   include "statistics.hpp"
+#else
+#   error "Cell's statistics was not found!"
+#endif
+
+CELL_USING_NAMESPACE Cell;
+
+CELL_NAMESPACE_BEGIN(Cell::Abstracts)
+
+namespace {
+
+/**
+ * @brief Returns the bias correction of the harmonic mean for a number of registers.
+ */
+double alpha(std::size_t registers)
+{
+    switch (registers) {
+    case 16:
+        return 0.673;
+    case 32:
+        return 0.697;
+    case 64:
+        return 0.709;
+    default:
+        return 0.7213 / (1.0 + 1.079 / static_cast<double>(registers));
+    }
+}
+
+}  // namespace
+
+HyperLogLog::HyperLogLog(Types::u8 precision)
+    : m_precision(precision)
+{
+    if (precision < 4 || precision > 16) {
+        throw std::invalid_argument("The precision of a HyperLogLog sketch must be from 4 to 16.");
+    }
+    m_registers.assign(std::size_t { 1 } << precision, 0);
+}
+
+void HyperLogLog::add(std::string_view value)
+{
+    const std::uint64_t hashed = hash(value);
+    const std::size_t index = static_cast<std::size_t>(hashed >> (64 - m_precision));
+    // The bits left after the index; all zero counts as the longest possible run
+    const std::uint64_t rest = hashed << m_precision;
+    const auto rank = static_cast<Types::u8>(rest == 0 ? 64 - m_precision + 1 : std::countl_zero(rest) + 1);
+    m_registers[index] = std::max(m_registers[index], rank);
+}
+
+void HyperLogLog::merge(const HyperLogLog& other)
+{
+    if (other.m_precision != m_precision) {
+        throw std::invalid_argument("Only HyperLogLog sketches of the same precision can be merged.");
+    }
+    for (std::size_t i = 0; i < m_registers.size(); ++i) {
+        m_registers[i] = std::max(m_registers[i], other.m_registers[i]);
+    }
+}
+
+double HyperLogLog::estimate() const
+{
+    const auto registers = static_cast<double>(m_registers.size());
+    double sum = 0.0;
+    std::size_t zeros = 0;
+    for (const auto rank : m_registers) {
+        sum += std::ldexp(1.0, -static_cast<int>(rank));
+        zeros += rank == 0 ? 1 : 0;
+    }
+    const double raw = alpha(m_registers.size()) * registers * registers / sum;
+
+    // Linear counting is more accurate while many registers are still empty; 64-bit hashes need no
+    // correction at the large end
+    if (raw <= 2.5 * registers && zeros > 0) {
+        return registers * std::log(registers / static_cast<double>(zeros));
+    }
+    return raw;
+}
+
+double HyperLogLog::standardError() const
+{
+    return 1.04 / std::sqrt(static_cast<double>(m_registers.size()));
+}
+
+std::uint64_t HyperLogLog::hash(std::string_view value)
+{
+    // FNV-1a, then the MurmurHash3 finalizer so every input bit reaches the index bits
+    std::uint64_t hashed = 14695981039346656037ull;
+    for (const char character : value) {
+        hashed ^= static_cast<unsigned char>(character);
+        hashed *= 1099511628211ull;
+    }
+    hashed ^= hashed >> 33;
+    hashed *= 0xff51afd7ed558ccdull;
+    hashed ^= hashed >> 33;
+    hashed *= 0xc4ceb9fe1a85ec53ull;
+    hashed ^= hashed >> 33;
+    return hashed;
+}
+
+double StatisticsEstimator::sampleFraction(std::uint64_t sampleRows, std::uint64_t estimatedRows)
+{
+    if (sampleRows == 0 || estimatedRows <= sampleRows) {
+        return 1.0;
+    }
+    return std::max(static_cast<double>(sampleRows) / static_cast<double>(estimatedRows), 1e-6);
+}
+
+std::uint64_t StatisticsEstimator::scaleDistinct(double sampleDistinct, std::uint64_t sampleRows, std::uint64_t totalRows, double relativeError)
+{
+    if (sampleRows == 0 || sampleDistinct <= 0.0) {
+        return 0;
+    }
+    if (sampleRows >= totalRows) {
+        return static_cast<std::uint64_t>(std::llround(sampleDistinct));
+    }
+
+    const auto n = static_cast<double>(sampleRows);
+    const auto total = static_cast<double>(totalRows);
+    // A sample without repeats, as far as the count can tell, says the column is unique
+    if (sampleDistinct >= n * (1.0 - relativeError)) {
+        return totalRows;
+    }
+    const double distinct = sampleDistinct;
+
+    // The expected distinct count of the sample grows with D, so bisect between d and N
+    const double missed = std::log1p(-n / total);
+    const auto expected = [&](double values) { return values * -std::expm1(missed * total / values); };
+    double low = distinct;
+    double high = total;
+    for (int i = 0; i < 100 && high - low > 0.5; ++i) {
+        const double middle = (low + high) / 2.0;
+        (expected(middle) < distinct ? low : high) = middle;
+    }
+    return static_cast<std::uint64_t>(std::llround((low + high) / 2.0));
+}
+
+QueryCache::RowsPtr StatisticsEstimator::cached(QueryCache& cache,
+                                                const StatisticsOptions& options,
+                                                std::string_view statistic,
+                                                const std::string& tableName,
+                                                const std::string& columnName,
+                                                const Compute& compute)
+{
+    QueryCacheOptions cacheOptions;
+    cacheOptions.ttl = options.ttl;
+    cacheOptions.tables = { tableName };
+    // The key cannot collide with a query: no statement starts with a NUL
+    return cache.getOrLoad(std::string("\0statistics:", 12) + std::string(statistic), { tableName, columnName }, cacheOptions, compute);
+}
+
+CELL_NAMESPACE_END
@@ -0,0 +1,175 @@
+/*!
+ * @file        statistics.hpp
+ * @brief       Approximate table statistics for the Cell Engine.
+ * @details     This file defines the statistics modes, a HyperLogLog sketch and the estimators shared by the drivers.
+ * @author      Kambiz Asadzadeh
+ * @since       07 Jun 2023
+ * @version     1.0
+ * @note        This is part of the Cell Engine, developed by Kambiz Asadzadeh.
+ *
+ * @license     This file is licensed under the terms of the Genyleap License. See the LICENSE.md file for more information.
+ * @copyright   Copyright (c) 2025 The Genyleap | Kambiz Asadzadeh. All rights reserved.
+ * @see         https://github.com/genyleap/cell
+ */
+
+#ifndef CELL_DATABASE_STATISTICS_ABSTRACT_HPP
+#define CELL_DATABASE_STATISTICS_ABSTRACT_HPP
+
+//! Cell's Common.
+#if __has_include(<common>)
+#   include <common>
+#else
+#   error "Cell's common was not found!"
+#endif
+
+//! Cell's Core (Core Only).
+#if __has_include(<core>)
+#   include <core>
+#else
+#   error "Cell's requirements was not found!"
+#endif
+
+#if __has_include("querycache.hpp")
+#   include "querycache.hpp"
+#else
+#   error "Cell's querycache was not found!"
+#endif
+
+CELL_NAMESPACE_BEGIN(Cell::Abstracts)
+
+/**
+ * @brief Constants related to table statistics.
+ */
+struct STATISTICS_CONSTANTS final
+{
+    __cell_static_const_constexpr std::chrono::seconds  DEFAULT_TTL             { 30 };     //!< Lifetime of a cached statistic.
+    __cell_static_const_constexpr std::uint64_t         DEFAULT_SAMPLE_ROWS     = 100000;   //!< Rows a sampled statistic reads.
+    __cell_static_const_constexpr Types::u8             HYPERLOGLOG_PRECISION   = 14;       //!< 16384 registers, about 0.8% standard error.
+};
+
+/**
+ * @brief How the aggregate methods of a driver answer.
+ */
+enum class StatisticsMode : Types::u8
+{
+    Exact,  //!< Every call runs the aggregate over the whole table.
+    Fast    //!< Catalog estimates, index ends and samples, cached for a while.
+};
+
+/**
+ * @brief Statistics settings of a connection.
+ *
+ * In the fast mode getRowCount() reads the server's row estimate, getMinValue() and getMaxValue() read
+ * one end of the column's index, getAverageValue() and getSumValue() are taken from a sample where the
+ * server can read one without a full scan, and every result (getDistinctValues() included) is cached
+ * for the lifetime below. Writes made through a driver that shares the query cache drop the statistics
+ * of the tables they touch; other writers are seen once the lifetime runs out.
+ */
+struct StatisticsOptions final
+{
+    StatisticsMode              mode        { StatisticsMode::Exact };                  //!< Exact unless a caller opts in.
+    std::chrono::milliseconds   ttl         { STATISTICS_CONSTANTS::DEFAULT_TTL };      //!< Lifetime of a cached statistic in the fast mode.
+    std::uint64_t               sampleRows  { STATISTICS_CONSTANTS::DEFAULT_SAMPLE_ROWS }; //!< Rows a sampled statistic aims to read.
+};
+
+/**
+ * @brief A HyperLogLog sketch that counts distinct values in a fixed amount of memory.
+ *
+ * Each value is hashed to 64 bits; the first bits pick a register and the register keeps the longest
+ * run of leading zeros seen in the rest. The harmonic mean of the registers estimates the number of
+ * distinct values with a standard error of about 1.04 / sqrt(2^precision), and small counts are
+ * corrected with linear counting. Sketches of the same precision can be merged.
+ */
+class HyperLogLog {
+public:
+    /**
+     * @brief Constructs an empty sketch.
+     *
+     * @param precision Bits that pick a register, from 4 to 16.
+     * @throws std::invalid_argument If the precision is out of range.
+     */
+    explicit HyperLogLog(Types::u8 precision = STATISTICS_CONSTANTS::HYPERLOGLOG_PRECISION);
+
+    /**
+     * @brief Adds a value.
+     */
+    void add(std::string_view value);
+
+    /**
+     * @brief Adds the values of another sketch.
+     *
+     * @throws std::invalid_argument If the precisions differ.
+     */
+    void merge(const HyperLogLog& other);
+
+    /**
+     * @brief Returns the estimated number of distinct values added.
+     */
+    double estimate() const;
+
+    /**
+     * @brief Returns the relative standard error of the estimate, 1.04 / sqrt(2^precision).
+     */
+    double standardError() const;
+
+    /**
+     * @brief Returns the 64-bit hash the sketch uses for a value.
+     */
+    static std::uint64_t hash(std::string_view value);
+
+private:
+    Types::u8               m_precision {}; //!< Bits that pick a register.
+    std::vector<Types::u8>  m_registers {}; //!< Longest run of leading zeros plus one, per register.
+};
+
+/**
+ * @brief Estimators the drivers share for the fast statistics mode.
+ */
+class StatisticsEstimator {
+public:
+    using Compute = std::function<QueryCache::Rows()>;
+
+    /**
+     * @brief Returns the fraction of a table to sample so about sampleRows rows are read.
+     *
+     * @return A fraction from one in a million to 1; 1 when the table is no larger than the sample.
+     */
+    static double sampleFraction(std::uint64_t sampleRows, std::uint64_t estimatedRows);
+
+    /**
+     * @brief Scales the distinct count of a uniform sample to the whole table.
+     *
+     * Solves d = D * (1 - (1 - n/N)^(N/D)) for D, the expected number of distinct values a sample of
+     * n rows out of N finds when each of D values occurs N/D times. A sample that is nearly all
+     * distinct scales towards N, one that repeats its values stays close to d.
+     *
+     * @param sampleDistinct Distinct values in the sample.
+     * @param sampleRows Rows in the sample.
+     * @param totalRows Rows in the table.
+     * @param relativeError Error of sampleDistinct; a sample within it of all distinct counts as all distinct.
+     */
+    static std::uint64_t scaleDistinct(double sampleDistinct, std::uint64_t sampleRows, std::uint64_t totalRows, double relativeError = 0.0);
+
+    /**
+     * @brief Returns a statistic from the query cache, computing it once for all concurrent callers.
+     *
+     * The statistic is tagged with its table, so writes that invalidate the table drop it.
+     *
+     * @param cache The query cache of the connection.
+     * @param options The lifetime of the statistic.
+     * @param statistic Its name, e.g. "rows" or "max"; part of the key.
+     * @param tableName The table.
+     * @param columnName The column, or empty for a statistic of the whole table.
+     * @param compute Computes the statistic; it throws to report an error, which is then not cached.
+     */
+    static QueryCache::RowsPtr cached(QueryCache& cache,
+                                      const StatisticsOptions& options,
+                                      std::string_view statistic,
+                                      const std::string& tableName,
+                                      const std::string& columnName,
+                                      const Compute& compute);
+};
+
+CELL_NAMESPACE_END
+
+#endif  // CELL_DATABASE_STATISTICS_ABSTRACT_HPP
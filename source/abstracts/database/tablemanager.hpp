@@ -30,6 +30,12 @@
 #   error "Cell's requirements was not found!"
 #endif
 
+#if __has_include("schemacatalog.hpp")
+#   include "schemacatalog.hpp"
+#else
+#   error "Cell's schemacatalog was not found!"
+#endif
+
 CELL_NAMESPACE_BEGIN(Cell::Abstracts)
 
 /**
@@ -78,6 +84,18 @@ public:
      */
     __cell_virtual std::string getTablePrimaryKey(const std::string& tableName) = __cell_zero;
 
+    /**
+     * @brief Get the cached schema of the database.
+     *
+     * The snapshot is shared by every connection of the pool and reloaded, with one statement, after a
+     * schema change made through this interface. It describes every table's columns with their types,
+     * primary key, foreign keys and indexes.
+     *
+     * @return The current snapshot; it stays valid while held, even after a reload.
+     * @throws std::runtime_error If the schema cannot be loaded.
+     */
+    __cell_virtual SchemaSnapshotPtr schema() = __cell_zero;
+
     /**
      * @brief Get the foreign key of a specific table.
      *
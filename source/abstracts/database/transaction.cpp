@@ -22,4 +22,164 @@ DatabaseTransaction::~DatabaseTransaction()
 {
 }
 
+#if defined(USE_MYSQL_MARIADB) || defined(USE_POSTGRESQL) || defined(USE_SQLITE) || defined(USE_MSSQL) || defined(USE_ORACLE)
+
+Transaction::Transaction(ConnectionLease lease, const TransactionDialect& dialect, const TransactionOptions& options)
+    : m_lease(std::move(lease)), m_dialect(&dialect)
+{
+    for (const auto& statement : m_dialect->begin(options)) {
+        m_dialect->execute(m_lease.connection(), statement);
+    }
+    m_active = true;
+}
+
+Transaction::~Transaction()
+{
+    if (m_active) {
+        try {
+            rollback();
+        } catch (const std::exception&) {
+            // The session state is unknown; do not hand it to the next borrower
+            m_lease.discard();
+        }
+    }
+}
+
+Transaction::Transaction(Transaction&& other) noexcept
+    : m_lease(std::move(other.m_lease))
+    , m_dialect(other.m_dialect)
+    , m_active(std::exchange(other.m_active, false))
+{
+}
+
+Transaction& Transaction::operator=(Transaction&& other) noexcept
+{
+    if (this != &other) {
+        if (m_active) {
+            try {
+                rollback();
+            } catch (const std::exception&) {
+                m_lease.discard();
+            }
+        }
+        m_lease = std::move(other.m_lease);
+        m_dialect = other.m_dialect;
+        m_active = std::exchange(other.m_active, false);
+    }
+    return *this;
+}
+
+void Transaction::execute(const std::string& sql)
+{
+    if (!m_active) {
+        throw std::logic_error("Transaction is not active.");
+    }
+    m_dialect->execute(m_lease.connection(), sql);
+}
+
+void Transaction::savepoint(const std::string& name)
+{
+    checkSavepoint(name);
+    m_dialect->execute(m_lease.connection(), "SAVEPOINT " + name);
+}
+
+void Transaction::releaseSavepoint(const std::string& name)
+{
+    checkSavepoint(name);
+    m_dialect->execute(m_lease.connection(), "RELEASE SAVEPOINT " + name);
+}
+
+void Transaction::rollbackToSavepoint(const std::string& name)
+{
+    checkSavepoint(name);
+    m_dialect->execute(m_lease.connection(), "ROLLBACK TO SAVEPOINT " + name);
+}
+
+void Transaction::commit()
+{
+    if (!m_active) {
+        throw std::logic_error("Transaction is not active.");
+    }
+    m_active = false;
+    m_dialect->execute(m_lease.connection(), "COMMIT");
+}
+
+void Transaction::rollback()
+{
+    if (!m_active) {
+        return;
+    }
+    m_active = false;
+    m_dialect->execute(m_lease.connection(), "ROLLBACK");
+}
+
+bool Transaction::isActive() const
+{
+    return m_active;
+}
+
+const ConnectionLease& Transaction::lease() const
+{
+    return m_lease;
+}
+
+PinnedTransaction* PinnedTransactions::current()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // Entries are erased only by their own thread, so the pointer stays valid after the lock is released
+    const auto it = m_transactions.find(std::this_thread::get_id());
+    return it != m_transactions.end() ? &it->second : nullptr;
+}
+
+bool PinnedTransactions::pin(Transaction transaction)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_transactions.try_emplace(std::this_thread::get_id(), PinnedTransaction { .transaction = std::move(transaction) }).second;
+}
+
+std::optional<PinnedTransaction> PinnedTransactions::unpin()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto node = m_transactions.extract(std::this_thread::get_id());
+    if (node.empty()) {
+        return std::nullopt;
+    }
+    return std::move(node.mapped());
+}
+
+void PinnedTransactions::clear()
+{
+    std::unordered_map<std::thread::id, PinnedTransaction> transactions;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        transactions.swap(m_transactions);
+    }
+    // Destroying a transaction rolls it back outside the lock
+}
+
+void Transaction::checkSavepoint(const std::string& name) const
+{
+    if (!m_active) {
+        throw std::logic_error("Transaction is not active.");
+    }
+    const bool identifier = !name.empty() && !std::isdigit(static_cast<unsigned char>(name.front()))
+                            && std::all_of(name.begin(), name.end(), [](unsigned char c) { return std::isalnum(c) || c == '_'; });
+    if (!identifier) {
+        throw std::invalid_argument("Invalid savepoint name: " + name);
+    }
+}
+
+std::chrono::milliseconds retryBackoff(Types::uint attempt)
+{
+    const auto exponent = std::min<Types::uint>(attempt > 0 ? attempt - 1 : 0, 16);
+    const auto ceiling = std::min(TRANSACTION_CONSTANTS::INITIAL_BACKOFF * (1u << exponent), TRANSACTION_CONSTANTS::MAX_BACKOFF);
+
+    // Jitter between half and all of the ceiling keeps retrying clients from colliding again
+    thread_local std::mt19937 generator { std::random_device {}() };
+    std::uniform_int_distribution<std::chrono::milliseconds::rep> distribution(ceiling.count() / 2, ceiling.count());
+    return std::chrono::milliseconds(distribution(generator));
+}
+
+#endif
+
 CELL_NAMESPACE_END
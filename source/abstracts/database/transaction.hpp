@@ -30,6 +30,14 @@
 #   error "Cell's requirements was not found!"
 #endif
 
+#if defined(USE_MYSQL_MARIADB) || defined(USE_POSTGRESQL) || defined(USE_SQLITE) || defined(USE_MSSQL) || defined(USE_ORACLE)
+#if __has_include("connectionlease.hpp")
+#   include "connectionlease.hpp"
+#else
+#   error "Cell's connectionlease was not found!"
+#endif
+#endif
+
 CELL_NAMESPACE_BEGIN(Cell::Abstracts)
 
 /**
@@ -70,6 +78,252 @@ public:
     __cell_virtual bool rollbackTransaction() = __cell_zero;
 };
 
+//! Scoped transactions run on a leased connection, so they need a driver.
+#if defined(USE_MYSQL_MARIADB) || defined(USE_POSTGRESQL) || defined(USE_SQLITE) || defined(USE_MSSQL) || defined(USE_ORACLE)
+
+/**
+ * @brief Constants related to scoped transactions.
+ */
+struct TRANSACTION_CONSTANTS final
+{
+    __cell_static_const_constexpr Types::uint DEFAULT_MAX_ATTEMPTS = 5;                            //!< Attempts made by retryTransaction().
+    __cell_static_const_constexpr std::chrono::milliseconds INITIAL_BACKOFF {10};                  //!< Delay before the first retry.
+    __cell_static_const_constexpr std::chrono::milliseconds MAX_BACKOFF {1000};                    //!< Upper bound of the retry delay.
+};
+
+/**
+ * @brief Transaction isolation levels.
+ */
+enum class IsolationLevel : Types::u8
+{
+    Default,            //!< The server's default level.
+    ReadCommitted,      //!< READ COMMITTED.
+    RepeatableRead,     //!< REPEATABLE READ.
+    Serializable        //!< SERIALIZABLE.
+};
+
+/**
+ * @brief Options used when a transaction is opened.
+ */
+struct TransactionOptions final
+{
+    IsolationLevel isolation    { IsolationLevel::Default };    //!< The isolation level.
+    bool           readOnly     { false };                      //!< Open the transaction as READ ONLY.
+};
+
+/**
+ * @brief Thrown when the server aborted a statement because of a serialization failure or deadlock.
+ *
+ * The transaction must be rolled back; running it again from the start is expected to succeed.
+ */
+struct SerializationFailure : std::runtime_error
+{
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * @brief The driver-specific parts of a transaction.
+ */
+struct TransactionDialect final
+{
+    /**
+     * @brief Runs a statement that returns no rows on a connection.
+     * @throws SerializationFailure If the statement may succeed when the transaction is retried.
+     * @throws std::runtime_error On any other failure.
+     */
+    void (*execute)(const Types::SqlConnection& connection, const std::string& sql) {};
+
+    /**
+     * @brief Builds the statements that open a transaction with the given options.
+     */
+    std::vector<std::string> (*begin)(const TransactionOptions& options) {};
+};
+
+/**
+ * @brief A transaction pinned to a single leased connection.
+ *
+ * BEGIN, every statement, savepoint and the final COMMIT or ROLLBACK run on the same connection, which
+ * is returned to the pool only when the transaction is destroyed. A transaction that is neither committed
+ * nor rolled back is rolled back automatically.
+ */
+class Transaction {
+public:
+    /**
+     * @brief Opens a transaction on a leased connection.
+     *
+     * @param lease The connection the transaction is pinned to.
+     * @param dialect The driver-specific statements.
+     * @param options The isolation level and access mode.
+     * @throws std::runtime_error If the transaction cannot be opened.
+     */
+    Transaction(ConnectionLease lease, const TransactionDialect& dialect, const TransactionOptions& options = {});
+
+    /**
+     * @brief Rolls the transaction back if it is still open and returns the connection to the pool.
+     */
+    ~Transaction();
+
+    Transaction(Transaction&& other) noexcept;
+    Transaction& operator=(Transaction&& other) noexcept;
+
+    /**
+     * @brief Disable copy construction and assignment for a class.
+     */
+    CELL_DISABLE_COPY(Transaction)
+
+    /**
+     * @brief Runs a statement inside the transaction.
+     *
+     * @throws SerializationFailure If the transaction should be retried.
+     * @throws std::runtime_error On any other failure.
+     */
+    void execute(const std::string& sql);
+
+    /**
+     * @brief Creates a savepoint.
+     *
+     * @param name The savepoint name; letters, digits and underscores only.
+     */
+    void savepoint(const std::string& name);
+
+    /**
+     * @brief Releases a savepoint, keeping the work done after it.
+     */
+    void releaseSavepoint(const std::string& name);
+
+    /**
+     * @brief Undoes the work done after a savepoint; the transaction stays open.
+     */
+    void rollbackToSavepoint(const std::string& name);
+
+    /**
+     * @brief Commits the transaction.
+     *
+     * The transaction is closed even if the commit fails.
+     */
+    void commit();
+
+    /**
+     * @brief Rolls the transaction back.
+     */
+    void rollback();
+
+    /**
+     * @brief Checks whether the transaction is still open.
+     */
+    bool isActive() const;
+
+    /**
+     * @brief Returns the connection the transaction is pinned to.
+     */
+    const ConnectionLease& lease() const;
+
+private:
+    /**
+     * @brief Ensures the transaction is open and a savepoint name is a plain identifier.
+     */
+    void checkSavepoint(const std::string& name) const;
+
+    ConnectionLease             m_lease         {};         //!< The pinned connection.
+    const TransactionDialect*   m_dialect       {};         //!< The driver-specific statements.
+    bool                        m_active        { false };  //!< True between BEGIN and COMMIT/ROLLBACK.
+};
+
+/**
+ * @brief A transaction opened by beginTransaction() and what it wrote.
+ */
+struct PinnedTransaction final
+{
+    Transaction                 transaction;                    //!< The transaction and its connection.
+    std::vector<std::string>    writtenTables   {};             //!< Tables written inside the transaction.
+    bool                        writtenUnknown  { false };      //!< Whether it wrote tables that cannot be told.
+    bool                        schemaChanged   { false };      //!< Whether it changed the schema.
+};
+
+/**
+ * @brief The transactions opened by beginTransaction(), one per calling thread.
+ *
+ * The begin/commit/rollback calls carry no handle, so a transaction belongs to the thread that opened it:
+ * that thread's statements run on its pinned connection while other threads keep using the pool. Only the
+ * owning thread uses its entry, so the lock guards the map itself.
+ */
+class PinnedTransactions {
+public:
+    PinnedTransactions() = default;
+
+    /**
+     * @brief Disable copy construction and assignment for a class.
+     */
+    CELL_DISABLE_COPY(PinnedTransactions)
+
+    /**
+     * @brief Returns the transaction of the calling thread, or nullptr if it has none open.
+     */
+    PinnedTransaction* current();
+
+    /**
+     * @brief Pins an open transaction to the calling thread.
+     *
+     * @return False if the thread already has a transaction open; the new one is rolled back.
+     */
+    bool pin(Transaction transaction);
+
+    /**
+     * @brief Unpins the transaction of the calling thread and hands it to the caller.
+     */
+    std::optional<PinnedTransaction> unpin();
+
+    /**
+     * @brief Rolls back the transactions that threads left open.
+     *
+     * Called by the driver's destructor, once no other thread can be using the connection.
+     */
+    void clear();
+
+private:
+    mutable Types::Mutex                                        m_mutex         {}; //!< Guards the map.
+    std::unordered_map<std::thread::id, PinnedTransaction>      m_transactions  {}; //!< Open transactions by thread.
+};
+
+/**
+ * @brief Returns the delay before retry number @p attempt: exponential, capped and jittered.
+ */
+__cell_export std::chrono::milliseconds retryBackoff(Types::uint attempt);
+
+/**
+ * @brief Runs a transaction body, retrying the whole transaction on serialization failures.
+ *
+ * @param begin Opens a new transaction, e.g. `[&] { return connection.transaction(options); }`.
+ * @param body Receives the transaction; the transaction is committed when it returns.
+ * @param maxAttempts The number of attempts before the failure is rethrown.
+ * @return The value returned by the body.
+ */
+template <typename Begin, typename Body>
+auto retryTransaction(Begin&& begin, Body&& body, Types::uint maxAttempts = TRANSACTION_CONSTANTS::DEFAULT_MAX_ATTEMPTS)
+{
+    for (Types::uint attempt = 1;; ++attempt) {
+        try {
+            Transaction transaction = begin();
+            if constexpr (std::is_void_v<std::invoke_result_t<Body&, Transaction&>>) {
+                body(transaction);
+                transaction.commit();
+                return;
+            } else {
+                auto result = body(transaction);
+                transaction.commit();
+                return result;
+            }
+        } catch (const SerializationFailure&) {
+            if (attempt >= maxAttempts) {
+                throw;
+            }
+        }
+        std::this_thread::sleep_for(retryBackoff(attempt));
+    }
+}
+
+#endif
+
 CELL_NAMESPACE_END
 
 #endif  // CELL_DATABASE_ABSTRACT_HPP
@@ -44,7 +44,7 @@ void EventLoop::addTask(Task task)
         std::lock_guard<std::mutex> lock(mutex);
 
         // Add the task to the task queue
-        taskQueue.push(std::move(task));
+        taskQueue.push({ std::move(task), std::chrono::steady_clock::now() });
     }
 
     // Notify the worker thread that a new task is available
@@ -57,6 +57,24 @@ bool EventLoop::getIsRunning() const
     return isRunning;
 }
 
+bool EventLoop::isWorkerThread() const
+{
+    // A loop that was never started has no thread id, which no calling thread compares equal to
+    return std::this_thread::get_id() == workerThread.get_id();
+}
+
+std::chrono::steady_clock::duration EventLoop::currentQueueDelay() const
+{
+    // Written by the worker thread right before it runs the task, read by the task and by other threads
+    return std::chrono::steady_clock::duration(queueDelay.load(std::memory_order_relaxed));
+}
+
+std::size_t EventLoop::pendingTasks() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return taskQueue.size();
+}
+
 void EventLoop::run()
 {
     while (true) {
@@ -71,7 +89,8 @@ void EventLoop::run()
                 return;
 
             // Retrieve the task from the front of the task queue
-            task = std::move(taskQueue.front());
+            task = std::move(taskQueue.front().task);
+            queueDelay.store((std::chrono::steady_clock::now() - taskQueue.front().queuedAt).count(), std::memory_order_relaxed);
             taskQueue.pop();
         }
 
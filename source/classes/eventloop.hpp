@@ -81,11 +81,36 @@ public:
      */
     bool getIsRunning() const;
 
+    /**
+     * @brief Returns true if called from the worker thread, i.e. from within a task.
+     */
+    bool isWorkerThread() const;
+
+    /**
+     * @brief Returns how long the task that is currently executing waited in the queue.
+     * @note Only meaningful when called from within a task.
+     */
+    std::chrono::steady_clock::duration currentQueueDelay() const;
+
+    /**
+     * @brief Returns the number of tasks waiting to be executed.
+     */
+    std::size_t pendingTasks() const;
+
 private:
-    bool isRunning;                             //!< Flag indicating if the event loop is running.
+    /**
+     * @brief A queued task together with the time it was queued.
+     */
+    struct QueuedTask final {
+        Task task;                                      //!< The task to execute.
+        std::chrono::steady_clock::time_point queuedAt; //!< When the task was added.
+    };
+
+    std::atomic<bool> isRunning;                //!< Flag indicating if the event loop is running.
     std::thread workerThread;                   //!< The worker thread that executes the event loop.
-    std::queue<Task> taskQueue;                 //!< Queue of tasks to be processed by the event loop.
-    std::mutex mutex;                           //!< Mutex for synchronizing access to the task queue.
+    std::queue<QueuedTask> taskQueue;           //!< Queue of tasks to be processed by the event loop.
+    std::atomic<std::chrono::steady_clock::rep> queueDelay { 0 }; //!< Queue delay of the task currently executing, in clock ticks.
+    mutable std::mutex mutex;                   //!< Mutex for synchronizing access to the task queue.
     std::condition_variable conditionVariable;  //!< Condition variable for task synchronization.
     EventLoopType loopType;                     //!< The type of event loop being used.
 
@@ -0,0 +1,321 @@
+#if __has_include("binarylog.hpp")
+#   include "binarylog.hpp"
+#else
+#   error "Cell's "binarylog.hpp" was not found!"
+#endif
+
+CELL_NAMESPACE_BEGIN(Cell::Utility)
+
+namespace {
+
+/**
+ * @brief Formats one argument with a format spec, the part of a replacement field after the colon.
+ */
+bool formatArgument(std::string& out, std::string_view spec, const LogArgument& argument)
+{
+    const std::string field = "{:" + std::string(spec) + "}";
+    try {
+        std::visit([&](const auto& value) {
+            // A local copy: make_format_args takes lvalues only
+            auto copy = value;
+            out += std::vformat(field, std::make_format_args(copy));
+        }, argument);
+        return true;
+    } catch (const std::format_error&) {
+        return false;
+    }
+}
+
+/**
+ * @brief Returns the argument a field refers to: the number before the colon, or the next one.
+ */
+Types::Optional<std::size_t> argumentIndex(std::string_view id, std::size_t& nextIndex)
+{
+    if (id.empty()) {
+        return nextIndex++;
+    }
+    std::size_t index {};
+    const auto result = std::from_chars(id.data(), id.data() + id.size(), index);
+    if (result.ec != std::errc() || result.ptr != id.data() + id.size()) {
+        return __cell_null_optional;
+    }
+    return index;
+}
+
+}  // namespace
+
+std::vector<LogArgument> decodeLogArguments(std::span<const std::byte> bytes)
+{
+    std::vector<LogArgument> arguments;
+    std::size_t position = 0;
+    const auto take = [&](void* data, std::size_t size) {
+        if (bytes.size() - position < size) {
+            throw std::runtime_error("A deferred log record ends inside an argument.");
+        }
+        std::memcpy(data, bytes.data() + position, size);
+        position += size;
+    };
+
+    while (position < bytes.size()) {
+        LogArgumentKind kind {};
+        take(&kind, 1);
+        switch (kind) {
+        case LogArgumentKind::Bool:
+        case LogArgumentKind::Char: {
+            char value {};
+            take(&value, 1);
+            arguments.emplace_back(kind == LogArgumentKind::Bool ? LogArgument(value != 0) : LogArgument(value));
+            break;
+        }
+        case LogArgumentKind::Signed: {
+            std::int64_t value {};
+            take(&value, sizeof value);
+            arguments.emplace_back(value);
+            break;
+        }
+        case LogArgumentKind::Unsigned: {
+            std::uint64_t value {};
+            take(&value, sizeof value);
+            arguments.emplace_back(value);
+            break;
+        }
+        case LogArgumentKind::Float: {
+            double value {};
+            take(&value, sizeof value);
+            arguments.emplace_back(value);
+            break;
+        }
+        case LogArgumentKind::Float32: {
+            float value {};
+            take(&value, sizeof value);
+            arguments.emplace_back(value);
+            break;
+        }
+        case LogArgumentKind::String: {
+            std::uint32_t size {};
+            take(&size, sizeof size);
+            if (bytes.size() - position < size) {
+                throw std::runtime_error("A deferred log record ends inside a string argument.");
+            }
+            arguments.emplace_back(std::string_view(reinterpret_cast<const char*>(bytes.data() + position), size));
+            position += size;
+            break;
+        }
+        case LogArgumentKind::Pointer: {
+            std::uint64_t value {};
+            take(&value, sizeof value);
+            arguments.emplace_back(reinterpret_cast<const void*>(static_cast<std::uintptr_t>(value)));
+            break;
+        }
+        default:
+            throw std::runtime_error("A deferred log record holds an argument of an unknown kind.");
+        }
+    }
+    return arguments;
+}
+
+std::string formatLogArguments(std::string_view format, std::span<const LogArgument> arguments)
+{
+    std::string out;
+    out.reserve(format.size() + arguments.size() * 8);
+    std::size_t nextIndex = 0;
+
+    for (std::size_t i = 0; i < format.size(); ++i) {
+        const char character = format[i];
+        if (character == '}') {
+            out += '}';
+            i += i + 1 < format.size() && format[i + 1] == '}' ? 1 : 0;
+            continue;
+        }
+        if (character != '{') {
+            out += character;
+            continue;
+        }
+        if (i + 1 < format.size() && format[i + 1] == '{') {
+            out += '{';
+            ++i;
+            continue;
+        }
+
+        // The closing brace of the field, past any nested width or precision fields
+        std::size_t close = i + 1;
+        for (int depth = 1; close < format.size(); ++close) {
+            depth += format[close] == '{' ? 1 : format[close] == '}' ? -1 : 0;
+            if (depth == 0) {
+                break;
+            }
+        }
+        const std::string_view field = format.substr(i, close - i + 1);
+        const std::string_view body = format.substr(i + 1, close - i - 1);
+        i = close;
+
+        const std::size_t colon = body.find(':');
+        const auto index = argumentIndex(body.substr(0, colon), nextIndex);
+        std::string spec(colon == std::string_view::npos ? std::string_view() : body.substr(colon + 1));
+
+        // Nested fields take the next arguments after the field itself, as in std::format
+        bool valid = index.has_value() && *index < arguments.size() && close < format.size();
+        for (std::size_t open = spec.find('{'); valid && open != std::string::npos; open = spec.find('{', open)) {
+            const std::size_t end = spec.find('}', open);
+            const auto nested = end == std::string::npos ? __cell_null_optional : argumentIndex(std::string_view(spec).substr(open + 1, end - open - 1), nextIndex);
+            valid = nested.has_value() && *nested < arguments.size();
+            if (valid) {
+                std::string value;
+                valid = formatArgument(value, {}, arguments[*nested]);
+                spec.replace(open, end - open + 1, value);
+                open += value.size();
+            }
+        }
+        if (!valid || !formatArgument(out, spec, arguments[*index])) {
+            out += field;
+        }
+    }
+    return out;
+}
+
+ClogReader::ClogReader(std::istream& input)
+    : m_input(input)
+{
+    char magic[4] {};
+    std::uint16_t version {};
+    std::uint16_t byteOrder {};
+    if (!read(magic, sizeof magic) || std::string_view(magic, sizeof magic) != CLOG_CONSTANTS::MAGIC) {
+        throw std::runtime_error("The file is not a Cell binary log.");
+    }
+    if (!read(version) || version != CLOG_CONSTANTS::VERSION) {
+        throw std::runtime_error("The binary log has an unknown version.");
+    }
+    if (!read(byteOrder) || byteOrder != CLOG_CONSTANTS::ENDIANNESS) {
+        throw std::runtime_error("The binary log was written on a machine of another byte order.");
+    }
+}
+
+Types::Optional<ClogEntry> ClogReader::next()
+{
+    for (;;) {
+        ClogTag tag {};
+        if (!read(tag)) {
+            // A clean end of the file is not a truncation
+            m_truncated = false;
+            return __cell_null_optional;
+        }
+
+        switch (tag) {
+        case ClogTag::Session: {
+            std::int64_t system {};
+            std::int64_t steady {};
+            if (!read(system) || !read(steady)) {
+                return __cell_null_optional;
+            }
+            m_clockOffset = system - steady;
+            m_sites.clear();
+            m_threads.clear();
+            break;
+        }
+        case ClogTag::Thread: {
+            std::uint32_t index {};
+            std::uint16_t size {};
+            std::string threadId;
+            if (!read(index) || !read(size) || !readText(threadId, size)) {
+                return __cell_null_optional;
+            }
+            m_threads[index] = std::move(threadId);
+            break;
+        }
+        case ClogTag::Site: {
+            std::uint64_t id {};
+            Site site;
+            std::uint16_t formatSize {};
+            std::uint16_t fileSize {};
+            std::uint16_t functionSize {};
+            if (!read(id) || !read(site.counter) || !read(site.line) || !read(site.type)
+                || !read(formatSize) || !read(fileSize) || !read(functionSize)
+                || !readText(site.format, formatSize) || !readText(site.file, fileSize) || !readText(site.function, functionSize)) {
+                return __cell_null_optional;
+            }
+            m_sites[id] = std::move(site);
+            break;
+        }
+        case ClogTag::Deferred: {
+            std::uint64_t id {};
+            std::uint32_t threadIndex {};
+            std::int64_t steady {};
+            ClogEntry entry;
+            std::uint32_t size {};
+            if (!read(id) || !read(threadIndex) || !read(steady) || !read(entry.mode) || !read(size)) {
+                return __cell_null_optional;
+            }
+            std::vector<std::byte> arguments(size);
+            if (!read(arguments.data(), size)) {
+                return __cell_null_optional;
+            }
+            const auto site = m_sites.find(id);
+            if (site == m_sites.end()) {
+                throw std::runtime_error("A deferred log record uses a site the file does not define.");
+            }
+            entry.type = site->second.type;
+            entry.time = steady + m_clockOffset;
+            entry.counter = site->second.counter;
+            entry.line = site->second.line;
+            entry.threadId = thread(threadIndex);
+            entry.function = site->second.function;
+            entry.file = site->second.file;
+            entry.message = formatLogArguments(site->second.format, decodeLogArguments(arguments));
+            return entry;
+        }
+        case ClogTag::Text: {
+            std::uint32_t threadIndex {};
+            std::int64_t seconds {};
+            std::uint16_t functionSize {};
+            std::uint16_t fileSize {};
+            std::uint32_t messageSize {};
+            ClogEntry entry;
+            if (!read(threadIndex) || !read(seconds) || !read(entry.counter) || !read(entry.line)
+                || !read(entry.type) || !read(entry.mode) || !read(functionSize) || !read(fileSize) || !read(messageSize)
+                || !readText(entry.function, functionSize) || !readText(entry.file, fileSize) || !readText(entry.message, messageSize)) {
+                return __cell_null_optional;
+            }
+            entry.time = seconds * 1000000000;
+            entry.threadId = thread(threadIndex);
+            return entry;
+        }
+        default:
+            throw std::runtime_error("The binary log holds a record of an unknown kind.");
+        }
+    }
+}
+
+bool ClogReader::truncated() const
+{
+    return m_truncated;
+}
+
+bool ClogReader::read(void* data, std::size_t size)
+{
+    m_input.read(static_cast<char*>(data), static_cast<std::streamsize>(size));
+    const auto count = static_cast<std::size_t>(m_input.gcount());
+    // A record cut short means the writer died in the middle of it; next() clears this at a clean end
+    m_truncated = count != size;
+    return count == size;
+}
+
+template <typename T>
+bool ClogReader::read(T& value)
+{
+    return read(&value, sizeof value);
+}
+
+bool ClogReader::readText(std::string& text, std::size_t size)
+{
+    text.resize(size);
+    return read(text.data(), size);
+}
+
+const std::string& ClogReader::thread(std::uint32_t index) const
+{
+    static const std::string unknown;
+    const auto found = m_threads.find(index);
+    return found != m_threads.end() ? found->second : unknown;
+}
+
+CELL_NAMESPACE_END
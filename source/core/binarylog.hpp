@@ -0,0 +1,284 @@
+/*!
+ * Gen3 License
+ *
+ * @file        binarylog.hpp
+ * @brief       This file is part of the Cell engine.
+ * @author      <a href='https://github.com/thecompez'>Kambiz Asadzadeh</a>
+ * @package     libCell
+ * @copyright   Copyright (c) 2025 The Genyleap. All rights reserved.
+ * @license     https://github.com/genyleap/cell/blob/main/LICENSE.md
+ */
+
+#ifndef CELL_BINARY_LOG_HPP
+#define CELL_BINARY_LOG_HPP
+
+#if __has_include("common.hpp")
+#   include "common.hpp"
+#else
+#   error "Cell's "common.hpp" was not found!"
+#endif
+
+CELL_NAMESPACE_BEGIN(Cell::Utility)
+
+/**
+ * @brief Constants of the binary log file (.clog).
+ *
+ * A file starts with the magic, the version and the byte order mark, each session of a process with a
+ * Session record; every other record is one ClogTag byte and its fields, in the byte order of the
+ * machine that wrote it. Sites and threads are defined once per session, before their first use.
+ */
+struct CLOG_CONSTANTS final
+{
+    __cell_static_const_constexpr std::string_view  MAGIC       = "CLOG";   //!< First bytes of a file.
+    __cell_static_const_constexpr std::uint16_t     VERSION     = 1;        //!< Layout of the records.
+    __cell_static_const_constexpr std::uint16_t     ENDIANNESS  = 0x0102;   //!< Reads 0x0201 on a machine of the other order.
+    __cell_static_const_constexpr std::size_t       HEADER_SIZE = 8;        //!< Magic, version and byte order mark.
+};
+
+/**
+ * @brief The kind of a record in a .clog file.
+ */
+enum class ClogTag : Types::u8
+{
+    Session     =   0x1,    //!< i64 system_clock and i64 steady_clock nanoseconds of one moment; resets sites and threads.
+    Thread      =   0x2,    //!< u32 index, u16 length and the thread id.
+    Site        =   0x3,    //!< u64 id, u32 counter, u32 line, u8 type, u16 format, file and function lengths, the texts.
+    Deferred    =   0x4,    //!< u64 site id, u32 thread, i64 steady_clock nanoseconds, u8 mode, u32 argument bytes, the arguments.
+    Text        =   0x5     //!< u32 thread, i64 time in seconds, u32 counter, u32 line, u8 type, u8 mode, u16 function and
+                            //!< file lengths, u32 message length, the texts.
+};
+
+/**
+ * @brief The encoding of an argument of a deferred record; one byte in front of its value.
+ */
+enum class LogArgumentKind : Types::u8
+{
+    Bool        =   0x0,    //!< One byte.
+    Char        =   0x1,    //!< One byte.
+    Signed      =   0x2,    //!< i64.
+    Unsigned    =   0x3,    //!< u64.
+    Float       =   0x4,    //!< double; long double is narrowed to it.
+    String      =   0x5,    //!< u32 length and the bytes.
+    Pointer     =   0x6,    //!< u64 address.
+    Float32     =   0x7     //!< float, kept as it is so it prints as std::format prints a float.
+};
+
+/**
+ * @brief A call site of LogDeferred: its format string and where it is, fixed at compile time.
+ *
+ * The id hashes the file, the line and the format string, so it is the same in every run of a build.
+ */
+struct LogSite final
+{
+    std::string_view    format      {};     //!< The std::format string.
+    std::string_view    file        {};     //!< __FILE__ of the call.
+    std::string_view    function    {};     //!< __FUNCTION__ of the call.
+    std::uint32_t       counter     {};     //!< __COUNTER__ of the call, printed as the log id.
+    std::uint32_t       line        {};     //!< __LINE__ of the call.
+    Types::u8           type        {};     //!< The LoggerType.
+    std::uint64_t       id          {};     //!< Identifies the site in a .clog file.
+
+    constexpr LogSite(std::string_view format, std::string_view file, std::string_view function,
+                      std::uint32_t counter, std::uint32_t line, Types::u8 type)
+        : format(format), file(file), function(function), counter(counter), line(line), type(type)
+        , id(makeId(file, line, format))
+    {
+    }
+
+    /**
+     * @brief FNV-1a of the file, the line and the format string.
+     */
+    static constexpr std::uint64_t makeId(std::string_view file, std::uint32_t line, std::string_view format)
+    {
+        std::uint64_t hashed = 14695981039346656037ull;
+        const auto mix = [&hashed](unsigned char byte) {
+            hashed ^= byte;
+            hashed *= 1099511628211ull;
+        };
+        for (const char character : file) {
+            mix(static_cast<unsigned char>(character));
+        }
+        for (int shift = 0; shift < 32; shift += 8) {
+            mix(static_cast<unsigned char>(line >> shift));
+        }
+        for (const char character : format) {
+            mix(static_cast<unsigned char>(character));
+        }
+        return hashed;
+    }
+};
+
+/**
+ * @brief Returns how an argument type is stored in a deferred record.
+ *
+ * Booleans, characters, integers, floating point numbers, strings and pointers have an encoding; other
+ * types need Logger::formatted(), which formats on the calling thread.
+ */
+template <typename T>
+constexpr LogArgumentKind logArgumentKind()
+{
+    using Type = std::remove_cvref_t<T>;
+    if constexpr (std::is_same_v<Type, bool>) {
+        return LogArgumentKind::Bool;
+    } else if constexpr (std::is_same_v<Type, char>) {
+        return LogArgumentKind::Char;
+    } else if constexpr (std::is_integral_v<Type> && std::is_signed_v<Type>) {
+        return LogArgumentKind::Signed;
+    } else if constexpr (std::is_integral_v<Type>) {
+        return LogArgumentKind::Unsigned;
+    } else if constexpr (std::is_same_v<Type, float>) {
+        return LogArgumentKind::Float32;
+    } else if constexpr (std::is_floating_point_v<Type>) {
+        return LogArgumentKind::Float;
+    } else if constexpr (std::is_null_pointer_v<Type>) {
+        // Before the strings: nullptr converts to std::string_view through const char*
+        return LogArgumentKind::Pointer;
+    } else if constexpr (std::is_convertible_v<const Type&, std::string_view>) {
+        return LogArgumentKind::String;
+    } else if constexpr (std::is_pointer_v<Type>) {
+        return LogArgumentKind::Pointer;
+    } else {
+        static_assert(sizeof(Type) == 0, "This argument type has no binary encoding; log it with Logger::formatted().");
+    }
+}
+
+/**
+ * @brief Returns the bytes an argument takes in a deferred record.
+ */
+template <typename T>
+constexpr std::size_t logArgumentSize(const T& value)
+{
+    constexpr LogArgumentKind kind = logArgumentKind<T>();
+    if constexpr (kind == LogArgumentKind::Bool || kind == LogArgumentKind::Char) {
+        return 2;
+    } else if constexpr (kind == LogArgumentKind::String) {
+        return 1 + sizeof(std::uint32_t) + std::string_view(value).size();
+    } else if constexpr (kind == LogArgumentKind::Float32) {
+        return 1 + sizeof(float);
+    } else {
+        return 1 + sizeof(std::uint64_t);
+    }
+}
+
+/**
+ * @brief Writes an argument at out and moves out past it.
+ */
+template <typename T>
+void encodeLogArgument(std::byte*& out, const T& value)
+{
+    constexpr LogArgumentKind kind = logArgumentKind<T>();
+    *out++ = static_cast<std::byte>(kind);
+    const auto put = [&out](const auto& field) {
+        std::memcpy(out, &field, sizeof field);
+        out += sizeof field;
+    };
+    if constexpr (kind == LogArgumentKind::Bool || kind == LogArgumentKind::Char) {
+        *out++ = static_cast<std::byte>(value);
+    } else if constexpr (kind == LogArgumentKind::Signed) {
+        put(static_cast<std::int64_t>(value));
+    } else if constexpr (kind == LogArgumentKind::Unsigned) {
+        put(static_cast<std::uint64_t>(value));
+    } else if constexpr (kind == LogArgumentKind::Float) {
+        put(static_cast<double>(value));
+    } else if constexpr (kind == LogArgumentKind::Float32) {
+        put(value);
+    } else if constexpr (kind == LogArgumentKind::String) {
+        const std::string_view text(value);
+        put(static_cast<std::uint32_t>(text.size()));
+        std::memcpy(out, text.data(), text.size());
+        out += text.size();
+    } else if constexpr (std::is_null_pointer_v<std::remove_cvref_t<T>>) {
+        put(std::uint64_t { 0 });
+    } else {
+        put(static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(value)));
+    }
+}
+
+/**
+ * @brief An argument read back from a deferred record; strings point into the record.
+ */
+using LogArgument = std::variant<bool, char, std::int64_t, std::uint64_t, double, std::string_view, const void*, float>;
+
+/**
+ * @brief Reads the arguments of a deferred record.
+ *
+ * @throws std::runtime_error If the bytes end inside an argument or hold an unknown kind.
+ */
+__cell_export std::vector<LogArgument> decodeLogArguments(std::span<const std::byte> bytes);
+
+/**
+ * @brief Formats decoded arguments with a std::format string.
+ *
+ * The replacement fields are formatted one at a time, automatic and manual indexing and nested width
+ * and precision fields included; a field that does not fit its argument is copied as it is.
+ */
+__cell_export std::string formatLogArguments(std::string_view format, std::span<const LogArgument> arguments);
+
+/**
+ * @brief A record read back from a .clog file.
+ */
+struct ClogEntry final
+{
+    Types::u8       type        {};     //!< The LoggerType.
+    Types::u8       mode        {};     //!< The Logger::LoggerModel when it was logged.
+    std::int64_t    time        {};     //!< Nanoseconds since the epoch, of the system clock.
+    std::uint32_t   counter     {};     //!< The log id.
+    std::uint32_t   line        {};     //!< The line of the call.
+    std::string     threadId    {};     //!< The thread, as Logger prints it.
+    std::string     function    {};     //!< The function of the call.
+    std::string     file        {};     //!< The file of the call.
+    std::string     message     {};     //!< The message, formatted.
+};
+
+/**
+ * @brief Reads the records of a .clog file in order.
+ */
+class __cell_export ClogReader {
+public:
+    /**
+     * @brief Reads and checks the file header.
+     *
+     * @throws std::runtime_error If the stream is not a .clog file of a known version and byte order.
+     */
+    explicit ClogReader(std::istream& input);
+
+    /**
+     * @brief Returns the next log record, or nothing at the end of the file.
+     *
+     * A record cut off by a crash ends the file; truncated() then returns true.
+     *
+     * @throws std::runtime_error If a record is malformed or uses an undefined site.
+     */
+    Types::Optional<ClogEntry> next();
+
+    /**
+     * @brief Returns true if the file ended inside a record.
+     */
+    bool truncated() const;
+
+private:
+    struct Site final
+    {
+        std::string     format      {};
+        std::string     file        {};
+        std::string     function    {};
+        std::uint32_t   counter     {};
+        std::uint32_t   line        {};
+        Types::u8       type        {};
+    };
+
+    bool read(void* data, std::size_t size);
+    template <typename T> bool read(T& value);
+    bool readText(std::string& text, std::size_t size);
+    const std::string& thread(std::uint32_t index) const;
+
+    std::istream&                                   m_input;
+    std::unordered_map<std::uint64_t, Site>         m_sites         {};
+    std::unordered_map<std::uint32_t, std::string>  m_threads       {};
+    std::int64_t                                    m_clockOffset   {};     //!< System minus steady clock, in nanoseconds.
+    bool                                            m_truncated     { false };
+};
+
+CELL_NAMESPACE_END
+
+#endif  // CELL_BINARY_LOG_HPP
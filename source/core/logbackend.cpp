@@ -0,0 +1,1388 @@
+#if __has_include("logbackend.hpp")
+#   include "logbackend.hpp"
+#else
+#   error "Cell's "logbackend.hpp" was not found!"
+#endif
+
+#if __has_include("logrotation.hpp")
+#   include "logrotation.hpp"
+#else
+#   error "Cell's "logrotation.hpp" was not found!"
+#endif
+
+#if defined(PLATFORM_WINDOWS)
+#   include <io.h>
+#   include <fcntl.h>
+#   include <sys/stat.h>
+#else
+#   include <fcntl.h>
+#   include <signal.h>
+#   include <unistd.h>
+#   include <sys/stat.h>
+#endif
+
+CELL_NAMESPACE_BEGIN(Cell::Utility)
+
+namespace {
+
+/**
+ * @brief The body of a LogRing::Kind::Text record; function, file and message follow it.
+ */
+struct TextRecord final
+{
+    LogRing::Header header          {};
+    std::uint32_t   counter         {};
+    std::uint32_t   line            {};
+    std::int64_t    occurTime       {};
+    std::uint32_t   messageLength   {};
+    std::uint16_t   functionLength  {};
+    std::uint16_t   fileLength      {};
+};
+
+/**
+ * @brief The body of a LogRing::Kind::Deferred record; the encoded arguments follow it.
+ */
+struct DeferredRecord final
+{
+    LogRing::Header header          {};
+    const LogSite*  site            {};
+    std::int64_t    steadyTime      {};     //!< steady_clock nanoseconds of the call.
+    std::uint32_t   argumentBytes   {};
+    std::uint32_t   spare           {};
+};
+
+constexpr std::array<std::string_view, 9> TypeNames {
+    "Default", "Info", "Warning", "Critical", "Failed", "Success", "Done", "Paused", "InProgress"
+};
+
+//! The escape sequences NativeTerminal writes for each LoggerType, and its Reset.
+constexpr std::array<std::string_view, 9> TypeStyles {
+    "\033[0m", "\033[0;37m", "\033[0;33m", "\033[0;31m", "\033[41m", "\033[0;32m", "\033[42m", "\033[0;36m", "\033[0;93m"
+};
+constexpr std::string_view ResetStyle = "\033[0;37m";
+
+std::string_view typeName(Types::u8 type)
+{
+    return type < TypeNames.size() ? TypeNames[type] : TypeNames[LoggerType::Default];
+}
+
+#if defined(PLATFORM_WINDOWS)
+constexpr int StandardError = 2;
+
+int openForAppend(const std::string& path)
+{
+    return ::_open(path.c_str(), _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY, _S_IREAD | _S_IWRITE);
+}
+
+long writeSome(int descriptor, const char* data, std::size_t size)
+{
+    return ::_write(descriptor, data, static_cast<unsigned int>(std::min<std::size_t>(size, INT_MAX)));
+}
+
+void closeDescriptor(int descriptor)
+{
+    ::_close(descriptor);
+}
+
+std::int64_t fileSize(int descriptor)
+{
+    return ::_lseeki64(descriptor, 0, SEEK_END);
+}
+
+std::time_t modifiedTime(int descriptor)
+{
+    struct _stat64 status {};
+    return ::_fstat64(descriptor, &status) == 0 ? static_cast<std::time_t>(status.st_mtime) : std::time(nullptr);
+}
+#else
+constexpr int StandardError = STDERR_FILENO;
+
+int openForAppend(const std::string& path)
+{
+    return ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+}
+
+long writeSome(int descriptor, const char* data, std::size_t size)
+{
+    return static_cast<long>(::write(descriptor, data, size));
+}
+
+void closeDescriptor(int descriptor)
+{
+    ::close(descriptor);
+}
+
+std::int64_t fileSize(int descriptor)
+{
+    return static_cast<std::int64_t>(::lseek(descriptor, 0, SEEK_END));
+}
+
+std::time_t modifiedTime(int descriptor)
+{
+    struct stat status {};
+    return ::fstat(descriptor, &status) == 0 ? status.st_mtime : std::time(nullptr);
+}
+#endif
+
+std::int64_t nanoseconds(auto timePoint)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(timePoint.time_since_epoch()).count();
+}
+
+/**
+ * @brief Returns the difference between local time and UTC at a moment, in seconds.
+ */
+long utcOffset(std::time_t time)
+{
+    std::tm local {};
+#if defined(PLATFORM_WINDOWS)
+    localtime_s(&local, &time);
+#else
+    localtime_r(&time, &local);
+#endif
+    using namespace std::chrono;
+    const sys_days day = year { local.tm_year + 1900 } / month { static_cast<unsigned>(local.tm_mon + 1) } / static_cast<unsigned>(local.tm_mday);
+    const auto seconds = day + hours { local.tm_hour } + minutes { local.tm_min } + std::chrono::seconds { local.tm_sec };
+    return static_cast<long>(seconds.time_since_epoch().count() - time);
+}
+
+/**
+ * @brief Appends a time as "%Y/%m/%d %H:%M:%S", or with iso as "%Y-%m-%dT%H:%M:%S+hh:mm", without the C
+ *        library, so signal handlers can use it.
+ */
+void appendDateTime(LogSink& sink, std::time_t time, long offset, bool iso = false)
+{
+    using namespace std::chrono;
+    const sys_seconds local { seconds { time + offset } };
+    const sys_days day = floor<days>(local);
+    const year_month_day date { day };
+    const hh_mm_ss clock { local - day };
+
+    const auto twoDigits = [](char* out, unsigned value) {
+        out[0] = static_cast<char>('0' + value / 10 % 10);
+        out[1] = static_cast<char>('0' + value % 10);
+    };
+    char text[] = "0000/00/00 00:00:00+00:00";
+    const int year = static_cast<int>(date.year());
+    twoDigits(text, static_cast<unsigned>(year / 100));
+    twoDigits(text + 2, static_cast<unsigned>(year % 100));
+    twoDigits(text + 5, static_cast<unsigned>(date.month()));
+    twoDigits(text + 8, static_cast<unsigned>(date.day()));
+    twoDigits(text + 11, static_cast<unsigned>(clock.hours().count()));
+    twoDigits(text + 14, static_cast<unsigned>(clock.minutes().count()));
+    twoDigits(text + 17, static_cast<unsigned>(clock.seconds().count()));
+    if (!iso) {
+        sink.append(std::string_view(text, 19));
+        return;
+    }
+    text[4] = text[7] = '-';
+    text[10] = 'T';
+    text[19] = offset < 0 ? '-' : '+';
+    const unsigned minutes = static_cast<unsigned>((offset < 0 ? -offset : offset) / 60);
+    twoDigits(text + 20, minutes / 60);
+    twoDigits(text + 23, minutes % 60);
+    sink.append(std::string_view(text, sizeof text - 1));
+}
+
+/**
+ * @brief Appends a record in the layout of the synchronous Logger::echo(), without the newline.
+ */
+void appendLine(LogSink& sink, const LogLine& line, std::string_view threadId, long offset)
+{
+    sink.append(" => Log Id : [");
+    sink.append(std::uint64_t { line.counter });
+    if (line.mode == Mode::User) {
+        sink.append("] : [");
+    } else {
+        sink.append("][ Line : ");
+        sink.append(std::uint64_t { line.line });
+        sink.append("] [ Function : ");
+        sink.append(line.function);
+        sink.append("] [ Thread Id : ");
+        sink.append(threadId);
+        sink.append("] [ File : ");
+        sink.append(line.file);
+        sink.append("] ] : [");
+    }
+    sink.append(typeName(line.type));
+    sink.append("] ");
+    sink.append(line.message);
+    sink.append(" { DateTime: ");
+    appendDateTime(sink, line.occurTime, offset);
+    sink.append(" }");
+}
+
+/**
+ * @brief Appends text with some characters replaced, in runs between them.
+ *
+ * @param escape Returns the replacement of a character, or an empty view to keep it.
+ */
+template <typename Escape>
+void appendEscaped(LogSink& sink, std::string_view text, Escape&& escape)
+{
+    std::size_t begin = 0;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        const std::string_view replacement = escape(text[i]);
+        if (!replacement.empty()) {
+            sink.append(text.substr(begin, i - begin));
+            sink.append(replacement);
+            begin = i + 1;
+        }
+    }
+    sink.append(text.substr(begin));
+}
+
+/**
+ * @brief Appends a JSON string, quotes included.
+ */
+void appendJsonString(LogSink& sink, std::string_view text)
+{
+    static constexpr std::string_view hex = "0123456789abcdef";
+    // One escape per control character, built once; the view must outlive the call
+    static constexpr auto controls = [] {
+        std::array<std::array<char, 6>, 0x20> escapes {};
+        for (std::size_t c = 0; c < escapes.size(); ++c) {
+            escapes[c] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF] };
+        }
+        return escapes;
+    }();
+    sink.append("\"");
+    appendEscaped(sink, text, [](char character) -> std::string_view {
+        switch (character) {
+        case '"':  return "\\\"";
+        case '\\': return "\\\\";
+        case '\n': return "\\n";
+        case '\r': return "\\r";
+        case '\t': return "\\t";
+        default:
+            if (static_cast<unsigned char>(character) < 0x20) {
+                return std::string_view(controls[static_cast<unsigned char>(character)].data(), 6);
+            }
+            return {};
+        }
+    });
+    sink.append("\"");
+}
+
+/**
+ * @brief Appends a CSV field, quoted when it holds a separator, a quote or a line break.
+ */
+void appendCsvField(LogSink& sink, std::string_view text)
+{
+    if (text.find_first_of(",\"\r\n") == std::string_view::npos) {
+        sink.append(text);
+        return;
+    }
+    sink.append("\"");
+    appendEscaped(sink, text, [](char character) -> std::string_view {
+        return character == '"' ? "\"\"" : std::string_view();
+    });
+    sink.append("\"");
+}
+
+/**
+ * @brief Appends text for an XML attribute or element.
+ */
+void appendXmlText(LogSink& sink, std::string_view text)
+{
+    appendEscaped(sink, text, [](char character) -> std::string_view {
+        switch (character) {
+        case '<':  return "&lt;";
+        case '>':  return "&gt;";
+        case '&':  return "&amp;";
+        case '"':  return "&quot;";
+        case '\n': return "&#10;";
+        case '\r': return "&#13;";
+        default:   return {};
+        }
+    });
+}
+
+/**
+ * @brief The first line of a CSV log file.
+ */
+constexpr std::string_view CsvHeader = "time,id,type,line,function,thread,file,message\n";
+
+/**
+ * @brief Appends a record and its newline in a text format of the log file.
+ *
+ * Json writes one object per line, Csv one row under CsvHeader, Xml one element per line and the other
+ * formats Logger's text line. The location of the call is left out in Mode::User, as on the console.
+ * Only the sink's buffer is written to, so the fatal signal handler can use it too.
+ */
+void appendRecord(LogSink& sink, OutputFormat format, const LogLine& line, std::string_view threadId, long offset)
+{
+    const bool located = line.mode != Mode::User;
+    switch (format) {
+    case OutputFormat::Json:
+        sink.append("{\"time\":\"");
+        appendDateTime(sink, line.occurTime, offset, true);
+        sink.append("\",\"id\":");
+        sink.append(std::uint64_t { line.counter });
+        sink.append(",\"type\":\"");
+        sink.append(typeName(line.type));
+        sink.append("\"");
+        if (located) {
+            sink.append(",\"line\":");
+            sink.append(std::uint64_t { line.line });
+            sink.append(",\"function\":");
+            appendJsonString(sink, line.function);
+            sink.append(",\"thread\":");
+            appendJsonString(sink, threadId);
+            sink.append(",\"file\":");
+            appendJsonString(sink, line.file);
+        }
+        sink.append(",\"message\":");
+        appendJsonString(sink, line.message);
+        sink.append("}\n");
+        break;
+    case OutputFormat::Csv:
+        appendDateTime(sink, line.occurTime, offset, true);
+        sink.append(",");
+        sink.append(std::uint64_t { line.counter });
+        sink.append(",");
+        sink.append(typeName(line.type));
+        sink.append(",");
+        if (located) {
+            sink.append(std::uint64_t { line.line });
+            sink.append(",");
+            appendCsvField(sink, line.function);
+            sink.append(",");
+            appendCsvField(sink, threadId);
+            sink.append(",");
+            appendCsvField(sink, line.file);
+        } else {
+            sink.append(",,,");
+        }
+        sink.append(",");
+        appendCsvField(sink, line.message);
+        sink.append("\n");
+        break;
+    case OutputFormat::Xml:
+        sink.append("<record time=\"");
+        appendDateTime(sink, line.occurTime, offset, true);
+        sink.append("\" id=\"");
+        sink.append(std::uint64_t { line.counter });
+        sink.append("\" type=\"");
+        sink.append(typeName(line.type));
+        if (located) {
+            sink.append("\" line=\"");
+            sink.append(std::uint64_t { line.line });
+            sink.append("\" function=\"");
+            appendXmlText(sink, line.function);
+            sink.append("\" thread=\"");
+            appendXmlText(sink, threadId);
+            sink.append("\" file=\"");
+            appendXmlText(sink, line.file);
+        }
+        sink.append("\">");
+        appendXmlText(sink, line.message);
+        sink.append("</record>\n");
+        break;
+    default:
+        appendLine(sink, line, threadId, offset);
+        sink.append(__cell_newline);
+        break;
+    }
+}
+
+/**
+ * @brief Appends the bytes of a field of a .clog record.
+ */
+template <typename T>
+void appendRaw(LogSink& sink, const T& value)
+{
+    sink.append(std::string_view(reinterpret_cast<const char*>(&value), sizeof value));
+}
+
+/**
+ * @brief Appends the file header, if the file is empty, and a Session record.
+ */
+void appendClogSession(LogSink& sink, bool emptyFile)
+{
+    if (emptyFile) {
+        sink.append(CLOG_CONSTANTS::MAGIC);
+        appendRaw(sink, CLOG_CONSTANTS::VERSION);
+        appendRaw(sink, CLOG_CONSTANTS::ENDIANNESS);
+    }
+    appendRaw(sink, ClogTag::Session);
+    appendRaw(sink, nanoseconds(std::chrono::system_clock::now()));
+    appendRaw(sink, nanoseconds(std::chrono::steady_clock::now()));
+}
+
+void appendClogThread(LogSink& sink, std::uint32_t index, std::string_view threadId)
+{
+    appendRaw(sink, ClogTag::Thread);
+    appendRaw(sink, index);
+    appendRaw(sink, static_cast<std::uint16_t>(threadId.size()));
+    sink.append(threadId);
+}
+
+void appendClogText(LogSink& sink, std::uint32_t thread, const LogLine& line)
+{
+    const std::string_view function = line.function.substr(0, std::numeric_limits<std::uint16_t>::max());
+    const std::string_view file = line.file.substr(0, std::numeric_limits<std::uint16_t>::max());
+    appendRaw(sink, ClogTag::Text);
+    appendRaw(sink, thread);
+    appendRaw(sink, static_cast<std::int64_t>(line.occurTime));
+    appendRaw(sink, line.counter);
+    appendRaw(sink, line.line);
+    appendRaw(sink, line.type);
+    appendRaw(sink, line.mode);
+    appendRaw(sink, static_cast<std::uint16_t>(function.size()));
+    appendRaw(sink, static_cast<std::uint16_t>(file.size()));
+    appendRaw(sink, static_cast<std::uint32_t>(line.message.size()));
+    sink.append(function);
+    sink.append(file);
+    sink.append(line.message);
+}
+
+/**
+ * @brief Clears the drain flag of the backend when the scope ends.
+ */
+struct DrainGuard final
+{
+    std::atomic<bool>& flag;
+    ~DrainGuard() { flag.store(false, std::memory_order_release); }
+};
+
+/**
+ * @brief The owning thread's ring; marked retired when the thread exits so the writer can free it.
+ */
+struct ProducerSlot final
+{
+    LogRing*        ring            { nullptr };
+    std::size_t     pendingBytes    { 0 };      //!< Size of the deferred record awaiting commitDeferred().
+    Types::u8       pendingType     { 0 };
+    ~ProducerSlot()
+    {
+        if (ring != nullptr) {
+            ring->retired.store(true, std::memory_order_release);
+        }
+    }
+};
+
+thread_local ProducerSlot producer;
+
+constexpr std::array FatalSignals {
+    SIGSEGV, SIGFPE, SIGILL, SIGABRT,
+#if !defined(PLATFORM_WINDOWS)
+    SIGBUS,
+#endif
+};
+
+#if defined(PLATFORM_WINDOWS)
+std::array<void (*)(int), FatalSignals.size()> previousHandlers {};
+#else
+std::array<struct sigaction, FatalSignals.size()> previousHandlers {};
+#endif
+
+void restoreSignal(std::size_t index)
+{
+#if defined(PLATFORM_WINDOWS)
+    std::signal(FatalSignals[index], previousHandlers[index]);
+#else
+    ::sigaction(FatalSignals[index], &previousHandlers[index], nullptr);
+#endif
+}
+
+void onFatalSignal(int signal)
+{
+    AsyncLogBackend::instance().emergencyFlush();
+    // Hand the signal to whoever had it before; under the default action the process ends as it would have
+    for (std::size_t i = 0; i < FatalSignals.size(); ++i) {
+        if (FatalSignals[i] == signal) {
+            restoreSignal(i);
+        }
+    }
+    std::raise(signal);
+}
+
+void stopAtExit()
+{
+    AsyncLogBackend::instance().stop();
+}
+
+}  // namespace
+
+std::string logFilePath(OutputFormat format)
+{
+    std::string path = std::string(LogFolder) + "/" + std::string(LogFilePrefix);
+    switch (format) {
+    case OutputFormat::Dedicated:
+        path.append(FileFormats::Dedicated);
+        break;
+    case OutputFormat::Json:
+        path.append(FileFormats::Json);
+        break;
+    case OutputFormat::Xml:
+        path.append(FileFormats::Xml);
+        break;
+    case OutputFormat::Csv:
+        path.append(FileFormats::Csv);
+        break;
+    case OutputFormat::RawText:
+        path.append(FileFormats::RawText);
+        break;
+    }
+    return path;
+}
+
+bool appendLogFile(const std::string& path, OutputFormat format, const LogLine& line, std::string_view threadId)
+{
+    std::error_code error;
+    std::filesystem::create_directories(std::string(LogFolder), error);
+    int descriptor = openForAppend(path);
+    if (descriptor < 0) {
+        return false;
+    }
+    std::int64_t size = fileSize(descriptor);
+    LogRotation& rotation = LogRotation::instance();
+    if (rotation.due(static_cast<std::uint64_t>(std::max<std::int64_t>(size, 0)), modifiedTime(descriptor), line.occurTime)) {
+        closeDescriptor(descriptor);
+        rotation.rotate(path, line.occurTime);
+        descriptor = openForAppend(path);
+        if (descriptor < 0) {
+            return false;
+        }
+        size = fileSize(descriptor);
+    }
+
+    // Everything leaves in one write(), so appends of other processes do not interleave with it
+    LogSink sink(ASYNC_LOGGER_CONSTANTS::BATCH_BYTES);
+    sink.open(descriptor, true);
+    if (format == OutputFormat::Dedicated) {
+        // The record comes with a session and a thread definition of its own, so it decodes wherever it lands
+        appendClogSession(sink, size == 0);
+        appendClogThread(sink, 0, threadId);
+        appendClogText(sink, 0, line);
+    } else {
+        if (format == OutputFormat::Csv && size == 0) {
+            sink.append(CsvHeader);
+        }
+        appendRecord(sink, format, line, threadId, utcOffset(line.occurTime));
+    }
+    return sink.flush();
+}
+
+LogRing::LogRing(std::size_t capacity, std::string threadId)
+    : m_buffer(std::make_unique<std::byte[]>(capacity))
+    , m_mask(capacity - 1)
+    , m_threadId(std::move(threadId))
+{
+}
+
+std::byte* LogRing::reserve(std::size_t bytes)
+{
+    const std::size_t capacity = m_mask + 1;
+    std::uint64_t head = m_head.load(std::memory_order_relaxed);
+    const std::size_t offset = head & m_mask;
+    // A record never wraps; what is left before the end becomes padding
+    const std::size_t padding = capacity - offset < bytes ? capacity - offset : 0;
+
+    if (head + padding + bytes - m_cachedTail > capacity) {
+        m_cachedTail = m_tail.load(std::memory_order_acquire);
+        if (head + padding + bytes - m_cachedTail > capacity) {
+            return nullptr;
+        }
+    }
+    if (padding > 0) {
+        const Header header { static_cast<std::uint32_t>(padding), Kind::Padding };
+        std::memcpy(m_buffer.get() + offset, &header, sizeof header);
+        head += padding;
+    }
+    m_reservedHead = head;
+    return m_buffer.get() + (head & m_mask);
+}
+
+void LogRing::commit(std::size_t bytes)
+{
+    m_head.store(m_reservedHead + bytes, std::memory_order_release);
+}
+
+std::span<const std::byte> LogRing::peek()
+{
+    std::uint64_t tail = m_tail.load(std::memory_order_relaxed);
+    for (;;) {
+        if (tail == m_cachedHead) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail == m_cachedHead) {
+                return {};
+            }
+        }
+        const std::byte* record = m_buffer.get() + (tail & m_mask);
+        Header header;
+        std::memcpy(&header, record, sizeof header);
+        if (header.kind != Kind::Padding) {
+            return { record, header.size };
+        }
+        tail += header.size;
+        m_tail.store(tail, std::memory_order_release);
+    }
+}
+
+void LogRing::release(std::size_t bytes)
+{
+    m_tail.store(m_tail.load(std::memory_order_relaxed) + bytes, std::memory_order_release);
+}
+
+bool LogRing::empty() const
+{
+    return m_tail.load(std::memory_order_acquire) == m_head.load(std::memory_order_acquire);
+}
+
+std::size_t LogRing::used() const
+{
+    const std::uint64_t tail = m_tail.load(std::memory_order_acquire);
+    return static_cast<std::size_t>(m_head.load(std::memory_order_acquire) - tail);
+}
+
+std::size_t LogRing::capacity() const
+{
+    return m_mask + 1;
+}
+
+const std::string& LogRing::threadId() const
+{
+    return m_threadId;
+}
+
+LogSink::LogSink(std::size_t capacity)
+    : m_buffer(std::make_unique<char[]>(capacity))
+    , m_capacity(capacity)
+{
+}
+
+LogSink::~LogSink()
+{
+    open(-1, false);
+}
+
+void LogSink::open(int descriptor, bool owned)
+{
+    flush();
+    if (m_owned && m_descriptor >= 0) {
+        closeDescriptor(m_descriptor);
+    }
+    m_descriptor = descriptor;
+    m_owned = owned && descriptor >= 0;
+    m_appended = 0;
+}
+
+bool LogSink::isOpen() const
+{
+    return m_descriptor >= 0;
+}
+
+void LogSink::append(std::string_view text)
+{
+    if (m_descriptor < 0) {
+        return;
+    }
+    m_appended += text.size();
+    if (m_length + text.size() > m_capacity) {
+        flush();
+        if (text.size() > m_capacity) {
+            // Too large to buffer: write it as it is, behind what was buffered before it
+            m_length = text.size();
+            const char* data = text.data();
+            while (m_length > 0) {
+                const long written = writeSome(m_descriptor, data, m_length);
+                if (written < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (written <= 0) {
+                    break;
+                }
+                data += written;
+                m_length -= static_cast<std::size_t>(written);
+            }
+            m_length = 0;
+            return;
+        }
+    }
+    std::memcpy(m_buffer.get() + m_length, text.data(), text.size());
+    m_length += text.size();
+}
+
+void LogSink::append(std::uint64_t number)
+{
+    char digits[20];
+    const auto result = std::to_chars(std::begin(digits), std::end(digits), number);
+    append(std::string_view(digits, static_cast<std::size_t>(result.ptr - digits)));
+}
+
+std::uint64_t LogSink::appended() const
+{
+    return m_appended;
+}
+
+bool LogSink::flush()
+{
+    const char* data = m_buffer.get();
+    std::size_t remaining = m_length;
+    m_length = 0;
+    while (remaining > 0 && m_descriptor >= 0) {
+        const long written = writeSome(m_descriptor, data, remaining);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            return false;
+        }
+        data += written;
+        remaining -= static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+AsyncLogBackend::AsyncLogBackend()
+    : m_file(ASYNC_LOGGER_CONSTANTS::BATCH_BYTES)
+    , m_console(ASYNC_LOGGER_CONSTANTS::BATCH_BYTES)
+{
+}
+
+AsyncLogBackend& AsyncLogBackend::instance()
+{
+    // Never destroyed: threads may still log while static objects are torn down
+    static AsyncLogBackend* backend = new AsyncLogBackend();
+    return *backend;
+}
+
+void AsyncLogBackend::start(const AsyncLoggerOptions& options, const ConfigStruct& config)
+{
+    std::lock_guard<std::mutex> lifecycle(m_lifecycle);
+    if (m_writer.joinable()) {
+        stopWriter();
+    }
+
+    m_options = options;
+    m_clockOffset = nanoseconds(std::chrono::system_clock::now()) - nanoseconds(std::chrono::steady_clock::now());
+    m_ringBytes.store(std::bit_ceil(std::max(options.ringBytes, ASYNC_LOGGER_CONSTANTS::MIN_RING_BYTES)), std::memory_order_relaxed);
+    m_policy.store(options.overflowPolicy, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pendingConfig = config;
+        m_wakeRequested = false;
+    }
+    m_console.open(options.console ? StandardError : -1, false);
+    if (options.flushOnFatalSignal) {
+        installSignalHandlers();
+    }
+
+    m_running.store(true, std::memory_order_release);
+    m_writer = std::thread(&AsyncLogBackend::run, this);
+
+    static std::once_flag registered;
+    std::call_once(registered, [] { std::atexit(stopAtExit); });
+}
+
+void AsyncLogBackend::stop()
+{
+    std::lock_guard<std::mutex> lifecycle(m_lifecycle);
+    if (m_writer.joinable()) {
+        stopWriter();
+    }
+}
+
+void AsyncLogBackend::stopWriter()
+{
+    m_running.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_wakeRequested = true;
+    }
+    m_wakeup.notify_one();
+    m_writer.join();
+
+    // A producer that saw the writer running finishes its record before the last drain
+    {
+        lockDrain();
+        DrainGuard guard { m_draining };
+        for (const auto& slot : m_rings) {
+            const LogRing* ring = slot.load(std::memory_order_seq_cst);
+            while (ring != nullptr && ring->writing.load(std::memory_order_seq_cst)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    // Records pushed while the writer finished its last round
+    drain();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_flushCompleted = m_flushRequested;
+    }
+    m_flushed.notify_all();
+
+    lockDrain();
+    DrainGuard guard { m_draining };
+    m_file.open(-1, false);
+    m_console.open(-1, false);
+    restoreSignalHandlers();
+
+    // Archives of the last rotations are finished before the program goes on, e.g. to exit
+    LogRotation::instance().wait();
+}
+
+bool AsyncLogBackend::running() const noexcept
+{
+    return m_running.load(std::memory_order_acquire);
+}
+
+bool AsyncLogBackend::push(std::uint32_t counter, std::time_t occurTime, std::uint32_t line,
+                           std::string_view function, std::string_view file, std::string_view message,
+                           int type, Mode mode)
+{
+    LogRing* ring = ringOfThisThread();
+    if (ring == nullptr) {
+        return false;
+    }
+    // Paired with stopWriter(): either the record is seen stopping here, or it is waited for and drained
+    ring->writing.store(true, std::memory_order_seq_cst);
+    if (!m_running.load(std::memory_order_seq_cst)) {
+        ring->writing.store(false, std::memory_order_release);
+        return false;
+    }
+
+    function = function.substr(0, std::numeric_limits<std::uint16_t>::max());
+    file = file.substr(0, std::numeric_limits<std::uint16_t>::max());
+    // A record may take a quarter of the ring at most, so it always fits once the writer catches up
+    const std::size_t fixed = sizeof(TextRecord) + function.size() + file.size();
+    const std::size_t limit = ring->capacity() / 4;
+    message = message.substr(0, limit > fixed ? limit - fixed : 0);
+    const std::size_t bytes = LogRing::align(fixed + message.size());
+
+    std::byte* slot = ring->reserve(bytes);
+    if (slot == nullptr) {
+        if (m_policy.load(std::memory_order_relaxed) != OverflowPolicy::Block) {
+            ring->dropped.store(ring->dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            ring->writing.store(false, std::memory_order_release);
+            return true;
+        }
+        m_blocked.fetch_add(1, std::memory_order_relaxed);
+        while ((slot = ring->reserve(bytes)) == nullptr) {
+            if (!running()) {
+                ring->writing.store(false, std::memory_order_release);
+                return false;
+            }
+            wake();
+            std::this_thread::yield();
+        }
+    }
+
+    TextRecord record;
+    record.header = { static_cast<std::uint32_t>(bytes), LogRing::Kind::Text, static_cast<Types::u8>(type), mode };
+    record.counter = counter;
+    record.line = line;
+    record.occurTime = static_cast<std::int64_t>(occurTime);
+    record.messageLength = static_cast<std::uint32_t>(message.size());
+    record.functionLength = static_cast<std::uint16_t>(function.size());
+    record.fileLength = static_cast<std::uint16_t>(file.size());
+
+    std::byte* cursor = slot;
+    std::memcpy(cursor, &record, sizeof record);
+    cursor += sizeof record;
+    std::memcpy(cursor, function.data(), function.size());
+    cursor += function.size();
+    std::memcpy(cursor, file.data(), file.size());
+    cursor += file.size();
+    std::memcpy(cursor, message.data(), message.size());
+    ring->commit(bytes);
+    ring->writing.store(false, std::memory_order_release);
+
+    // Errors should reach the file soon, and a ring past half full should not wait for the interval
+    if (type == LoggerType::Critical || type == LoggerType::Failed || ring->used() > ring->capacity() / 2) {
+        wake();
+    }
+    return true;
+}
+
+Logger::DeferredSlot AsyncLogBackend::reserveDeferred(const LogSite& site, std::size_t argumentBytes, Mode mode)
+{
+    if (!running()) {
+        return { nullptr, true };
+    }
+    LogRing* ring = ringOfThisThread();
+    const std::size_t bytes = LogRing::align(sizeof(DeferredRecord) + argumentBytes);
+    if (ring == nullptr || bytes > ring->capacity() / 4) {
+        return { nullptr, true };
+    }
+    // Paired with stopWriter() as in push(); cleared by commitDeferred()
+    ring->writing.store(true, std::memory_order_seq_cst);
+    if (!m_running.load(std::memory_order_seq_cst)) {
+        ring->writing.store(false, std::memory_order_release);
+        return { nullptr, true };
+    }
+
+    std::byte* slot = ring->reserve(bytes);
+    if (slot == nullptr) {
+        if (m_policy.load(std::memory_order_relaxed) != OverflowPolicy::Block) {
+            ring->dropped.store(ring->dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            ring->writing.store(false, std::memory_order_release);
+            return {};
+        }
+        m_blocked.fetch_add(1, std::memory_order_relaxed);
+        while ((slot = ring->reserve(bytes)) == nullptr) {
+            if (!running()) {
+                ring->writing.store(false, std::memory_order_release);
+                return { nullptr, true };
+            }
+            wake();
+            std::this_thread::yield();
+        }
+    }
+
+    DeferredRecord record;
+    record.header = { static_cast<std::uint32_t>(bytes), LogRing::Kind::Deferred, site.type, mode };
+    record.site = &site;
+    record.steadyTime = nanoseconds(std::chrono::steady_clock::now());
+    record.argumentBytes = static_cast<std::uint32_t>(argumentBytes);
+    std::memcpy(slot, &record, sizeof record);
+    producer.pendingBytes = bytes;
+    producer.pendingType = site.type;
+    return { slot + sizeof record, false };
+}
+
+void AsyncLogBackend::commitDeferred()
+{
+    LogRing* ring = producer.ring;
+    ring->commit(producer.pendingBytes);
+    ring->writing.store(false, std::memory_order_release);
+    if (producer.pendingType == LoggerType::Critical || producer.pendingType == LoggerType::Failed
+        || ring->used() > ring->capacity() / 2) {
+        wake();
+    }
+}
+
+void AsyncLogBackend::flush()
+{
+    if (!running()) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    const std::uint64_t ticket = ++m_flushRequested;
+    m_wakeRequested = true;
+    m_wakeup.notify_one();
+    m_flushed.wait(lock, [&] { return m_flushCompleted >= ticket; });
+}
+
+void AsyncLogBackend::configure(const ConfigStruct& config)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pendingConfig = config;
+        m_wakeRequested = true;
+    }
+    m_wakeup.notify_one();
+}
+
+AsyncLoggerStatistics AsyncLogBackend::statistics()
+{
+    AsyncLoggerStatistics statistics;
+    statistics.written = m_written.load(std::memory_order_relaxed);
+    statistics.blocked = m_blocked.load(std::memory_order_relaxed);
+    statistics.batches = m_batches.load(std::memory_order_relaxed);
+
+    // Rings are freed under the drain flag, so hold it while reading them
+    lockDrain();
+    DrainGuard guard { m_draining };
+    statistics.dropped = m_droppedRetired.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < m_slotsUsed.load(std::memory_order_acquire); ++i) {
+        if (const LogRing* ring = m_rings[i].load(std::memory_order_acquire)) {
+            statistics.dropped += ring->dropped.load(std::memory_order_relaxed);
+            ++statistics.threads;
+        }
+    }
+    return statistics;
+}
+
+void AsyncLogBackend::emergencyFlush() noexcept
+{
+    // The writer holds the flag for one round; wait about a second for it, then leave the rings alone
+    for (int attempt = 0; m_draining.exchange(true, std::memory_order_acquire); ++attempt) {
+        if (attempt == 1000) {
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    DrainGuard guard { m_draining };
+    drainRings(true);
+}
+
+LogRing* AsyncLogBackend::ringOfThisThread()
+{
+    if (producer.ring != nullptr) {
+        return producer.ring;
+    }
+
+    std::unique_ptr<LogRing> ring;
+    for (std::size_t i = 0; i < m_rings.size(); ++i) {
+        if (m_rings[i].load(std::memory_order_relaxed) != nullptr) {
+            continue;
+        }
+        if (!ring) {
+            std::ostringstream threadId;
+            threadId << std::this_thread::get_id();
+            ring = std::make_unique<LogRing>(m_ringBytes.load(std::memory_order_relaxed), threadId.str());
+        }
+        ring->slot = static_cast<std::uint32_t>(i);
+        LogRing* expected = nullptr;
+        // Sequentially consistent, so stopWriter() finds the ring once the thread has seen it running
+        if (m_rings[i].compare_exchange_strong(expected, ring.get(), std::memory_order_seq_cst)) {
+            std::size_t used = m_slotsUsed.load(std::memory_order_relaxed);
+            while (used < i + 1 && !m_slotsUsed.compare_exchange_weak(used, i + 1, std::memory_order_acq_rel)) {
+            }
+            producer.ring = ring.release();
+            return producer.ring;
+        }
+    }
+    return nullptr;
+}
+
+void AsyncLogBackend::run()
+{
+    for (;;) {
+        std::uint64_t flushTarget = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            flushTarget = m_flushRequested;
+        }
+        const bool stopping = !running();
+
+        drain();
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (flushTarget > m_flushCompleted) {
+            m_flushCompleted = flushTarget;
+            m_flushed.notify_all();
+        }
+        if (stopping) {
+            return;
+        }
+        // Sleeping for the interval lets records pile up into one write(); push() wakes us when it matters
+        // A wake() that missed m_sleeping has set m_urgent before the exchange sees it
+        if (!m_wakeRequested) {
+            m_sleeping.store(true, std::memory_order_seq_cst);
+            if (!m_urgent.exchange(false, std::memory_order_seq_cst)) {
+                m_wakeup.wait_for(lock, m_options.flushInterval, [&] { return m_wakeRequested; });
+            }
+            m_sleeping.store(false, std::memory_order_release);
+        }
+        m_wakeRequested = false;
+    }
+}
+
+std::size_t AsyncLogBackend::drain()
+{
+    lockDrain();
+    DrainGuard guard { m_draining };
+    applyConfiguration();
+    return drainRings(false);
+}
+
+std::size_t AsyncLogBackend::drainRings(bool inSignalHandler)
+{
+    std::size_t records = 0;
+    const std::size_t slots = m_slotsUsed.load(std::memory_order_acquire);
+    for (std::size_t i = 0; i < slots; ++i) {
+        LogRing* ring = m_rings[i].load(std::memory_order_acquire);
+        if (ring == nullptr) {
+            continue;
+        }
+        for (auto record = ring->peek(); !record.empty(); record = ring->peek()) {
+            format(*ring, record, inSignalHandler);
+            ring->release(record.size());
+            ++records;
+        }
+        reportDropped(*ring);
+
+        // Retired is set after the thread's last push, so an empty retired ring stays empty
+        if (!inSignalHandler && ring->retired.load(std::memory_order_acquire) && ring->empty()) {
+            m_rings[i].store(nullptr, std::memory_order_release);
+            m_droppedRetired.fetch_add(ring->dropped.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            delete ring;
+        }
+    }
+    if (records > 0) {
+        m_file.flush();
+        m_console.flush();
+        m_batches.fetch_add(1, std::memory_order_relaxed);
+    }
+    return records;
+}
+
+void AsyncLogBackend::format(LogRing& ring, std::span<const std::byte> bytes, bool inSignalHandler)
+{
+    LogRing::Header header;
+    std::memcpy(&header, bytes.data(), sizeof header);
+
+    if (header.kind == LogRing::Kind::Text) {
+        TextRecord record;
+        std::memcpy(&record, bytes.data(), sizeof record);
+        const char* text = reinterpret_cast<const char*>(bytes.data() + sizeof record);
+        LogLine line { record.counter, record.line, static_cast<std::time_t>(record.occurTime), header.type, header.mode };
+        line.function = std::string_view(text, record.functionLength);
+        line.file = std::string_view(text + record.functionLength, record.fileLength);
+        line.message = std::string_view(text + record.functionLength + record.fileLength, record.messageLength);
+        if (!inSignalHandler) {
+            refreshOffset(line.occurTime);
+            rotateIfDue(line.occurTime);
+        }
+        emit(ring, line, true);
+    } else if (header.kind == LogRing::Kind::Deferred) {
+        DeferredRecord record;
+        std::memcpy(&record, bytes.data(), sizeof record);
+        const LogSite& site = *record.site;
+        const auto arguments = bytes.subspan(sizeof record, record.argumentBytes);
+        LogLine line { site.counter, site.line, static_cast<std::time_t>((record.steadyTime + m_clockOffset) / 1000000000),
+                       header.type, header.mode, site.function, site.file, site.format };
+        if (!inSignalHandler) {
+            rotateIfDue(line.occurTime);
+        }
+
+        // A .clog keeps the arguments as they are; only other destinations need the message
+        const bool binaryFile = m_binary && m_file.isOpen();
+        if (binaryFile) {
+            defineThread(ring);
+            defineSite(site);
+            appendRaw(m_file, ClogTag::Deferred);
+            appendRaw(m_file, site.id);
+            appendRaw(m_file, ring.slot);
+            appendRaw(m_file, record.steadyTime);
+            appendRaw(m_file, header.mode);
+            appendRaw(m_file, record.argumentBytes);
+            m_file.append(std::string_view(reinterpret_cast<const char*>(arguments.data()), arguments.size()));
+        }
+        if (m_console.isOpen() || (m_file.isOpen() && !binaryFile)) {
+            // Formatting allocates, so a signal handler prints the format string instead
+            std::string message;
+            if (!inSignalHandler) {
+                refreshOffset(line.occurTime);
+                try {
+                    message = formatLogArguments(site.format, decodeLogArguments(arguments));
+                    line.message = message;
+                } catch (const std::exception&) {
+                }
+            }
+            emit(ring, line, !binaryFile);
+        }
+    } else {
+        return;
+    }
+    m_written.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AsyncLogBackend::refreshOffset(std::time_t occurTime)
+{
+    if (occurTime / 60 != m_offsetMinute) {
+        m_offsetMinute = occurTime / 60;
+        m_utcOffset.store(utcOffset(occurTime), std::memory_order_relaxed);
+    }
+}
+
+void AsyncLogBackend::emit(LogRing& ring, const LogLine& line, bool toFile)
+{
+    const long offset = m_utcOffset.load(std::memory_order_relaxed);
+    if (m_console.isOpen()) {
+#if !defined(PLATFORM_WINDOWS)
+        m_console.append(TypeStyles[line.type < TypeStyles.size() ? line.type : 0]);
+#endif
+        appendLine(m_console, line, ring.threadId(), offset);
+#if !defined(PLATFORM_WINDOWS)
+        m_console.append(ResetStyle);
+#endif
+        m_console.append(__cell_newline);
+    }
+    if (!toFile || !m_file.isOpen()) {
+        return;
+    }
+    if (m_binary) {
+        defineThread(ring);
+        appendClogText(m_file, ring.slot, line);
+    } else {
+        appendRecord(m_file, m_format, line, ring.threadId(), offset);
+    }
+}
+
+void AsyncLogBackend::defineThread(LogRing& ring)
+{
+    if (ring.definedIn != m_session) {
+        appendClogThread(m_file, ring.slot, ring.threadId());
+        ring.definedIn = m_session;
+    }
+}
+
+void AsyncLogBackend::defineSite(const LogSite& site)
+{
+    // Open addressing without allocation; a full table only means a site is defined again
+    const std::size_t mask = m_definedSites.size() - 1;
+    for (std::size_t probe = 0; probe < m_definedSites.size(); ++probe) {
+        std::uint64_t& slot = m_definedSites[(site.id + probe) & mask];
+        if (slot == site.id) {
+            return;
+        }
+        if (slot == 0) {
+            slot = site.id;
+            break;
+        }
+    }
+    const std::string_view format = site.format.substr(0, std::numeric_limits<std::uint16_t>::max());
+    const std::string_view file = site.file.substr(0, std::numeric_limits<std::uint16_t>::max());
+    const std::string_view function = site.function.substr(0, std::numeric_limits<std::uint16_t>::max());
+    appendRaw(m_file, ClogTag::Site);
+    appendRaw(m_file, site.id);
+    appendRaw(m_file, site.counter);
+    appendRaw(m_file, site.line);
+    appendRaw(m_file, site.type);
+    appendRaw(m_file, static_cast<std::uint16_t>(format.size()));
+    appendRaw(m_file, static_cast<std::uint16_t>(file.size()));
+    appendRaw(m_file, static_cast<std::uint16_t>(function.size()));
+    m_file.append(format);
+    m_file.append(file);
+    m_file.append(function);
+}
+
+void AsyncLogBackend::openFile()
+{
+    std::error_code error;
+    std::filesystem::create_directories(std::string(LogFolder), error);
+    const int descriptor = openForAppend(m_filePath);
+    m_file.open(descriptor, true);
+    if (descriptor < 0) {
+        if (System::DeveloperMode::IsEnable) {
+            m_console.append("Failed to open log file.");
+            m_console.append(__cell_newline);
+        }
+        return;
+    }
+    const std::int64_t size = fileSize(descriptor);
+    m_fileBase = static_cast<std::uint64_t>(std::max<std::int64_t>(size, 0));
+    m_lastWrite = m_fileBase == 0 ? std::time(nullptr) : modifiedTime(descriptor);
+    if (m_binary) {
+        openClog(descriptor);
+    } else if (m_format == OutputFormat::Csv && m_fileBase == 0) {
+        m_file.append(CsvHeader);
+    }
+}
+
+void AsyncLogBackend::rotateIfDue(std::time_t now)
+{
+    if (!m_file.isOpen()) {
+        return;
+    }
+    LogRotation& rotation = LogRotation::instance();
+    if (rotation.due(m_fileBase + m_file.appended(), m_lastWrite, now)) {
+        // Everything buffered belongs to the old file; a failed rename keeps writing to it
+        m_file.open(-1, false);
+        rotation.rotate(m_filePath, now);
+        openFile();
+    }
+    m_lastWrite = now;
+}
+
+void AsyncLogBackend::openClog(int descriptor)
+{
+    // Threads and sites are defined again in every session
+    ++m_session;
+    m_definedSites.fill(0);
+    appendClogSession(m_file, fileSize(descriptor) == 0);
+    m_file.flush();
+}
+
+void AsyncLogBackend::reportDropped(LogRing& ring)
+{
+    const std::uint64_t dropped = ring.dropped.load(std::memory_order_relaxed);
+    if (dropped == ring.reported || m_policy.load(std::memory_order_relaxed) != OverflowPolicy::Count) {
+        ring.reported = dropped;
+        return;
+    }
+
+    // Built in place: this also runs inside the fatal signal handler
+    char text[128];
+    char* end = std::to_chars(std::begin(text), std::end(text), dropped - ring.reported).ptr;
+    constexpr std::string_view suffix = " log records were dropped because the ring buffer of the thread was full.";
+    end = std::copy(suffix.begin(), suffix.end(), end);
+    ring.reported = dropped;
+
+    LogLine line;
+    line.occurTime = std::time(nullptr);
+    line.type = LoggerType::Warning;
+    line.mode = Mode::User;
+    line.message = std::string_view(text, static_cast<std::size_t>(end - text));
+    emit(ring, line, true);
+}
+
+void AsyncLogBackend::applyConfiguration()
+{
+    Types::Optional<ConfigStruct> config;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        config.swap(m_pendingConfig);
+    }
+    if (!config) {
+        return;
+    }
+    m_file.open(-1, false);
+    m_format = config->outputFormat;
+    m_binary = m_format == OutputFormat::Dedicated;
+    if (config->storage != Storage::InFile) {
+        return;
+    }
+
+    // The file stays open: one open() per configuration, or per rotation, instead of one per record
+    m_filePath = logFilePath(m_format);
+    openFile();
+}
+
+void AsyncLogBackend::lockDrain()
+{
+    while (m_draining.exchange(true, std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+}
+
+void AsyncLogBackend::wake()
+{
+    // Only a sleeping writer needs the mutex and a notification; a busy one sees m_urgent before it sleeps
+    m_urgent.store(true, std::memory_order_seq_cst);
+    if (!m_sleeping.load(std::memory_order_seq_cst)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_wakeRequested = true;
+    }
+    m_wakeup.notify_one();
+}
+
+void AsyncLogBackend::installSignalHandlers()
+{
+    if (m_signalsInstalled) {
+        return;
+    }
+    for (std::size_t i = 0; i < FatalSignals.size(); ++i) {
+#if defined(PLATFORM_WINDOWS)
+        previousHandlers[i] = std::signal(FatalSignals[i], onFatalSignal);
+#else
+        struct sigaction action {};
+        action.sa_handler = onFatalSignal;
+        sigemptyset(&action.sa_mask);
+        ::sigaction(FatalSignals[i], &action, &previousHandlers[i]);
+#endif
+    }
+    m_signalsInstalled = true;
+}
+
+void AsyncLogBackend::restoreSignalHandlers()
+{
+    if (!m_signalsInstalled) {
+        return;
+    }
+    for (std::size_t i = 0; i < FatalSignals.size(); ++i) {
+        restoreSignal(i);
+    }
+    m_signalsInstalled = false;
+}
+
+CELL_NAMESPACE_END
@@ -0,0 +1,342 @@
+/*!
+ * Gen3 License
+ *
+ * @file        logbackend.hpp
+ * @brief       This file is part of the Cell engine.
+ * @author      <a href='https://github.com/thecompez'>Kambiz Asadzadeh</a>
+ * @package     libCell
+ * @copyright   Copyright (c) 2025 The Genyleap. All rights reserved.
+ * @license     https://github.com/genyleap/cell/blob/main/LICENSE.md
+ */
+
+#ifndef CELL_LOG_BACKEND_HPP
+#define CELL_LOG_BACKEND_HPP
+
+#if __has_include("logger.hpp")
+#   include "logger.hpp"
+#else
+#   error "Cell's "logger.hpp" was not found!"
+#endif
+
+#if __has_include("binarylog.hpp")
+#   include "binarylog.hpp"
+#else
+#   error "Cell's "binarylog.hpp" was not found!"
+#endif
+
+CELL_NAMESPACE_BEGIN(Cell::Utility)
+
+/**
+ * @brief Returns the path of the log file for an output format, e.g. "logs/log.txt".
+ */
+__cell_export std::string logFilePath(OutputFormat format);
+
+/**
+ * @brief A record as the writer prints it; the texts point into the ring.
+ */
+struct LogLine final
+{
+    std::uint32_t       counter     {};     //!< The log id.
+    std::uint32_t       line        {};     //!< The line of the call.
+    std::time_t         occurTime   {};     //!< Seconds since the epoch.
+    Types::u8           type        {};     //!< The LoggerType.
+    Mode                mode        {};     //!< The Logger::LoggerModel at the time of the call.
+    std::string_view    function    {};     //!< The function of the call.
+    std::string_view    file        {};     //!< The file of the call.
+    std::string_view    message     {};     //!< The message.
+};
+
+/**
+ * @brief Appends one record to a log file on the calling thread, for the synchronous Logger::echo().
+ *
+ * The file is rotated first if LogRotation says so. A .clog record comes with a session and a thread
+ * definition of its own, so it decodes wherever it lands.
+ *
+ * @return False if the file could not be opened or written.
+ */
+__cell_export bool appendLogFile(const std::string& path, OutputFormat format, const LogLine& line, std::string_view threadId);
+
+/**
+ * @brief A single-producer, single-consumer ring of variable-length log records.
+ *
+ * The owning thread reserves room, fills it and commits; the writer peeks at the oldest record and
+ * releases it once formatted. Records are aligned to eight bytes and start with a Header; a record
+ * that does not fit before the end of the buffer leaves a padding record there and starts over at
+ * the front. Neither side locks: each publishes its position with one release store.
+ */
+class LogRing {
+public:
+    /**
+     * @brief The kind of a record.
+     */
+    enum class Kind : Types::u8
+    {
+        Padding     =   0x0,    //!< Unused bytes up to the end of the buffer.
+        Text        =   0x1,    //!< A record written by Logger::echo().
+        Deferred    =   0x2     //!< A LogSite, a steady_clock time and the raw arguments of LogDeferred.
+    };
+
+    /**
+     * @brief The first eight bytes of every record.
+     */
+    struct Header final
+    {
+        std::uint32_t   size    {};  //!< Bytes of the record, header included, aligned to eight.
+        Kind            kind    {};  //!< What follows the header.
+        Types::u8       type    {};  //!< The LoggerType.
+        Mode            mode    {};  //!< The Logger::LoggerModel at the time of the call.
+        Types::u8       spare   {};  //!< Unused.
+    };
+
+    __cell_static_const_constexpr std::size_t ALIGNMENT = 8;
+
+    /**
+     * @brief Constructs an empty ring.
+     *
+     * @param capacity Bytes of the buffer; a power of two.
+     * @param threadId The owning thread, as Logger prints it.
+     */
+    LogRing(std::size_t capacity, std::string threadId);
+
+    /**
+     * @brief Returns room for a record of the given size, or nullptr if the ring is full.
+     *
+     * Producer only. The room stays reserved until commit(); a later reserve() replaces it.
+     */
+    std::byte* reserve(std::size_t bytes);
+
+    /**
+     * @brief Publishes the record written into the last reserved room.
+     */
+    void commit(std::size_t bytes);
+
+    /**
+     * @brief Returns the oldest record, or an empty span if there is none.
+     *
+     * Consumer only; padding is skipped.
+     */
+    std::span<const std::byte> peek();
+
+    /**
+     * @brief Frees the record returned by peek().
+     */
+    void release(std::size_t bytes);
+
+    /**
+     * @brief Returns true if the producer has published nothing the consumer has not released.
+     */
+    bool empty() const;
+
+    /**
+     * @brief Returns the bytes in use; may be stale by the time it returns.
+     */
+    std::size_t used() const;
+
+    std::size_t capacity() const;
+
+    const std::string& threadId() const;
+
+    /**
+     * @brief Rounds a record size up to the alignment of the ring.
+     */
+    static constexpr std::size_t align(std::size_t bytes)
+    {
+        return (bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    }
+
+    std::atomic<bool>           retired     { false };  //!< Set when the owning thread exits.
+    std::atomic<bool>           writing     { false };  //!< Set while the owning thread reserves and commits a record.
+    std::atomic<std::uint64_t>  dropped     { 0 };      //!< Records the owning thread discarded.
+    std::uint64_t               reported    { 0 };      //!< Dropped records the writer has logged.
+    std::uint32_t               slot        { 0 };      //!< Index of the ring in the backend; the thread of a .clog record.
+    std::uint64_t               definedIn   { 0 };      //!< The .clog session the writer last defined the thread in.
+
+private:
+    std::unique_ptr<std::byte[]>    m_buffer        {};
+    std::size_t                     m_mask          {};
+    std::string                     m_threadId      {};
+
+    alignas(64) std::atomic<std::uint64_t>  m_head          { 0 };  //!< Next byte the producer writes.
+    std::uint64_t                           m_reservedHead  { 0 };  //!< Start of the reserved room, past any padding.
+    std::uint64_t                           m_cachedTail    { 0 };  //!< Producer's last view of m_tail.
+
+    alignas(64) std::atomic<std::uint64_t>  m_tail          { 0 };  //!< Next byte the consumer reads.
+    std::uint64_t                           m_cachedHead    { 0 };  //!< Consumer's last view of m_head.
+};
+
+/**
+ * @brief A fixed buffer in front of a file descriptor.
+ *
+ * Appending never allocates, so the writer and the fatal signal handler share it; a full buffer is
+ * written out with write(), and text larger than the buffer is written directly.
+ */
+class LogSink {
+public:
+    explicit LogSink(std::size_t capacity);
+    ~LogSink();
+
+    LogSink(const LogSink&) = delete;
+    LogSink& operator=(const LogSink&) = delete;
+
+    /**
+     * @brief Writes what is buffered and switches to another descriptor; -1 disables the sink.
+     *
+     * @param owned Close the descriptor when it is replaced.
+     */
+    void open(int descriptor, bool owned);
+
+    bool isOpen() const;
+
+    void append(std::string_view text);
+    void append(std::uint64_t number);
+
+    /**
+     * @brief Returns the bytes appended since open().
+     */
+    std::uint64_t appended() const;
+
+    /**
+     * @brief Writes out the buffered bytes; returns false if a write() failed.
+     */
+    bool flush();
+
+private:
+    std::unique_ptr<char[]> m_buffer        {};
+    std::size_t             m_capacity      {};
+    std::size_t             m_length        {};
+    int                     m_descriptor    { -1 };
+    bool                    m_owned         { false };
+    std::uint64_t           m_appended      { 0 };
+};
+
+/**
+ * @brief The background writer behind Logger's asynchronous mode.
+ *
+ * A process has one instance; it is never destroyed, so threads that log during static destruction
+ * still find it. Each logging thread registers a LogRing in a fixed table of slots the first time it
+ * logs. The writer takes the drain flag, empties every ring into the sinks, writes them and releases
+ * the flag; the fatal signal handler takes the same flag so it can finish the job without a lock.
+ */
+class AsyncLogBackend {
+public:
+    static AsyncLogBackend& instance();
+
+    /**
+     * @brief Starts the writer, or restarts it with new options.
+     */
+    void start(const AsyncLoggerOptions& options, const ConfigStruct& config);
+
+    /**
+     * @brief Drains every ring, stops the writer and restores the previous signal handlers.
+     */
+    void stop();
+
+    bool running() const noexcept;
+
+    /**
+     * @brief Copies a record into the ring of the calling thread.
+     *
+     * @return False if the caller should write the record itself: the thread has no ring or the
+     *         writer stopped before the record was reserved or while the caller waited for room.
+     */
+    bool push(std::uint32_t counter, std::time_t occurTime, std::uint32_t line,
+              std::string_view function, std::string_view file, std::string_view message,
+              int type, Mode mode);
+
+    /**
+     * @brief Reserves a deferred record in the ring of the calling thread and fills in all but the arguments.
+     *
+     * A slot with arguments must be committed with commitDeferred() before the thread logs again, and
+     * the writer is not stopped until it is.
+     */
+    Logger::DeferredSlot reserveDeferred(const LogSite& site, std::size_t argumentBytes, Mode mode);
+
+    /**
+     * @brief Publishes the record of the last reserveDeferred().
+     */
+    void commitDeferred();
+
+    /**
+     * @brief Blocks until the writer has written every record pushed before the call.
+     */
+    void flush();
+
+    /**
+     * @brief Makes the writer use a new configuration, from its next round on.
+     */
+    void configure(const ConfigStruct& config);
+
+    AsyncLoggerStatistics statistics();
+
+    /**
+     * @brief Writes pending records from a signal handler; async-signal-safe.
+     */
+    void emergencyFlush() noexcept;
+
+private:
+    AsyncLogBackend();
+
+    LogRing* ringOfThisThread();
+    void run();
+    void stopWriter();
+    std::size_t drain();
+    std::size_t drainRings(bool inSignalHandler);
+    void format(LogRing& ring, std::span<const std::byte> record, bool inSignalHandler);
+    void emit(LogRing& ring, const LogLine& line, bool toFile);
+    void defineThread(LogRing& ring);
+    void defineSite(const LogSite& site);
+    void openFile();
+    void openClog(int descriptor);
+    void rotateIfDue(std::time_t now);
+    void refreshOffset(std::time_t occurTime);
+    void reportDropped(LogRing& ring);
+    void applyConfiguration();
+    void lockDrain();
+    void wake();
+    void installSignalHandlers();
+    void restoreSignalHandlers();
+
+    std::array<std::atomic<LogRing*>, ASYNC_LOGGER_CONSTANTS::MAX_PRODUCERS> m_rings {};
+
+    AsyncLoggerOptions              m_options       {};
+    std::atomic<bool>               m_running       { false };
+    std::atomic<bool>               m_draining      { false };
+    std::atomic<bool>               m_sleeping      { false };
+    std::atomic<bool>               m_urgent        { false };  //!< A producer asked for a wakeup; ordered against m_sleeping.
+    std::atomic<std::size_t>        m_slotsUsed     { 0 };
+    std::atomic<std::size_t>        m_ringBytes     { ASYNC_LOGGER_CONSTANTS::DEFAULT_RING_BYTES };
+    std::atomic<OverflowPolicy>     m_policy        { OverflowPolicy::Count };
+    std::atomic<long>               m_utcOffset     { 0 };
+    std::time_t                     m_offsetMinute  { -1 };
+    std::int64_t                    m_clockOffset   { 0 };      //!< System minus steady clock, in nanoseconds.
+    std::string                     m_filePath      {};
+    OutputFormat                    m_format        { OutputFormat::RawText };
+    bool                            m_binary        { false };  //!< The file is a .clog.
+    std::uint64_t                   m_fileBase      { 0 };      //!< Size of the file when it was opened.
+    std::time_t                     m_lastWrite     { 0 };      //!< Time of the last record in the file.
+    std::uint64_t                   m_session       { 0 };      //!< Counts the .clog sessions opened.
+    std::array<std::uint64_t, ASYNC_LOGGER_CONSTANTS::MAX_DEFINED_SITES> m_definedSites {};
+    bool                            m_signalsInstalled { false };
+
+    LogSink                         m_file;
+    LogSink                         m_console;
+
+    std::thread                     m_writer        {};
+    std::mutex                      m_mutex         {};
+    std::mutex                      m_lifecycle     {};
+    std::condition_variable         m_wakeup        {};
+    std::condition_variable         m_flushed       {};
+    bool                            m_wakeRequested { false };
+    std::uint64_t                   m_flushRequested { 0 };
+    std::uint64_t                   m_flushCompleted { 0 };
+    Types::Optional<ConfigStruct>   m_pendingConfig {};
+
+    std::atomic<std::uint64_t>      m_written       { 0 };
+    std::atomic<std::uint64_t>      m_blocked       { 0 };
+    std::atomic<std::uint64_t>      m_batches       { 0 };
+    std::atomic<std::uint64_t>      m_droppedRetired { 0 };
+};
+
+CELL_NAMESPACE_END
+
+#endif  // CELL_LOG_BACKEND_HPP
@@ -16,6 +16,18 @@
 #   error "Cell's "filesystem.hpp" was not found!"
 #endif
 
+#if __has_include("logbackend.hpp")
+#   include "logbackend.hpp"
+#else
+#   error "Cell's "logbackend.hpp" was not found!"
+#endif
+
+#if __has_include("logrotation.hpp")
+#   include "logrotation.hpp"
+#else
+#   error "Cell's "logrotation.hpp" was not found!"
+#endif
+
 CELL_USING_NAMESPACE Cell::Terminal;
 
 CELL_NAMESPACE_BEGIN(Cell::Utility)
@@ -24,10 +36,101 @@ CELL_NAMESPACE_BEGIN(Cell::Utility)
 std::mutex Logger::configMutex;
 std::mutex Logger::logFileMutex;
 
+namespace {
+
+/**
+ * @brief The registered log channels and the levels set for them by name.
+ */
+struct ChannelRegistry final
+{
+    std::mutex                                  mutex   {};
+    LogChannel*                                 head    { nullptr };
+    std::unordered_map<std::string, LogLevel>   levels  {};
+};
+
+ChannelRegistry& channelRegistry()
+{
+    // Never destroyed, so channels destroyed after it can still unregister
+    static ChannelRegistry* registry = new ChannelRegistry();
+    return *registry;
+}
+
+}  // namespace
+
+LogChannel::LogChannel(std::string_view name)
+    : m_name(name)
+{
+    ChannelRegistry& registry = channelRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    const auto level = registry.levels.find(std::string(name));
+    m_own = level != registry.levels.end();
+    m_level.store(m_own ? static_cast<Types::u8>(level->second) : Logger::minimumLevelValue.load(), std::memory_order_relaxed);
+    m_next = registry.head;
+    registry.head = this;
+}
+
+LogChannel::~LogChannel()
+{
+    ChannelRegistry& registry = channelRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (LogChannel** link = &registry.head; *link != nullptr; link = &(*link)->m_next) {
+        if (*link == this) {
+            *link = m_next;
+            break;
+        }
+    }
+}
+
+void Logger::setMinimumLevel(LogLevel level)
+{
+    ChannelRegistry& registry = channelRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    minimumLevelValue.store(static_cast<Types::u8>(level), std::memory_order_relaxed);
+    for (LogChannel* channel = registry.head; channel != nullptr; channel = channel->m_next) {
+        if (!channel->m_own) {
+            channel->m_level.store(static_cast<Types::u8>(level), std::memory_order_relaxed);
+        }
+    }
+}
+
+void Logger::setMinimumLevel(std::string_view name, LogLevel level)
+{
+    ChannelRegistry& registry = channelRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.levels[std::string(name)] = level;
+    for (LogChannel* channel = registry.head; channel != nullptr; channel = channel->m_next) {
+        if (channel->m_name == name) {
+            channel->m_own = true;
+            channel->m_level.store(static_cast<Types::u8>(level), std::memory_order_relaxed);
+        }
+    }
+}
+
+void Logger::resetMinimumLevel(std::string_view name)
+{
+    ChannelRegistry& registry = channelRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.levels.erase(std::string(name));
+    for (LogChannel* channel = registry.head; channel != nullptr; channel = channel->m_next) {
+        if (channel->m_name == name) {
+            channel->m_own = false;
+            channel->m_level.store(minimumLevelValue.load(), std::memory_order_relaxed);
+        }
+    }
+}
+
+LogLevel Logger::minimumLevel() noexcept
+{
+    return static_cast<LogLevel>(minimumLevelValue.load(std::memory_order_relaxed));
+}
+
 void Logger::set(const ConfigStruct& config)
 {
     std::lock_guard<std::mutex> lock(configMutex);
     configStruct = config;
+    if (AsyncLogBackend::instance().running()) {
+        AsyncLogBackend::instance().configure(config);
+    }
 }
 
 bool Logger::validateConfig(const ConfigStruct& config)
@@ -88,6 +191,12 @@ void Logger::echo(const unsigned int    counter,
                   std::string_view      message,
                   const int             type)
 {
+    // In the asynchronous mode the record is copied into this thread's ring and written later
+    AsyncLogBackend& backend = AsyncLogBackend::instance();
+    if (backend.running() && backend.push(counter, occurTime, line, function, file, message, type, LoggerModel)) {
+        return;
+    }
+
     std::thread::id threadId = std::this_thread::get_id();
     std::stringstream strThreadId;
     strThreadId << threadId;
@@ -102,21 +211,7 @@ void Logger::echo(const unsigned int    counter,
 
     const std::string folderPath = LogFolder.data();
 
-    std::string logfileTemp = folderPath + "/" + LogFilePrefix.data();
-
-    //! Maybe we can produce the file based on time in this section.
-    //! Use std::chrono...
-    //! Todo...
-    if(configStruct.value().outputFormat == OutputFormat::Dedicated)
-        logfileTemp.append(FileFormats::Dedicated.data());
-    if(configStruct.value().outputFormat == OutputFormat::RawText)
-        logfileTemp.append(FileFormats::RawText.data());
-    if(configStruct.value().outputFormat == OutputFormat::Json)
-        logfileTemp.append(FileFormats::Json.data());
-    if(configStruct.value().outputFormat == OutputFormat::Xml)
-        logfileTemp.append(FileFormats::Xml.data());
-    if(configStruct.value().outputFormat == OutputFormat::Csv)
-        logfileTemp.append(FileFormats::Csv.data());
+    const std::string logfileTemp = logFilePath(configStruct.value().outputFormat);
 
     // Create the folder if it does not exist
     if (!fs::exists(folderPath)) {
@@ -126,10 +221,14 @@ void Logger::echo(const unsigned int    counter,
         }
     }
 
-    // Open the log file in append mode
-    std::ofstream logFile(logfileTemp, std::ios::app);
-    if (!logFile.is_open()) {
-        (System::DeveloperMode::IsEnable) ? Log("Failed to open log file.", LoggerType::Critical) : DO_NOTHING;
+    // The record is encoded in the output format (a .clog takes binary records, which cell-logdecode turns
+    // back into lines) and the file is rotated first when it is due
+    if (configStruct->storage == Storage::InFile) {
+        std::lock_guard<std::mutex> lock(logFileMutex);
+        const LogLine record { counter, line, occurTime, static_cast<Types::u8>(type), LoggerModel, function, file, message };
+        if (!appendLogFile(logfileTemp, configStruct->outputFormat, record, strThreadId.str())) {
+            (System::DeveloperMode::IsEnable) ? Log("Failed to open log file.", LoggerType::Critical) : DO_NOTHING;
+        }
     }
 
     switch (type) {
@@ -201,25 +300,6 @@ void Logger::echo(const unsigned int    counter,
         {
             // Todo..
         }
-        if(configStruct->storage == Storage::InFile)
-        {
-            std::lock_guard<std::mutex> lock(logFileMutex);
-            if (logFile.is_open())
-            {
-                // Write the current time and the message to the file
-                logFile << " => Log Id : [" << counter
-                        << "] : ["  << typeStr << "] "
-                        << message << " { DateTime: "
-                        << std::put_time(localtime(&occurTime), "%Y/%m/%d %H:%M:%S") << " }"
-                        << __cell_newline;
-                // Close the file
-                logFile.close();
-            }
-            else
-            {
-                (System::DeveloperMode::IsEnable) ? Log("Failed to open log file.", LoggerType::Critical) : DO_NOTHING;
-            }
-        }
         if(configStruct->storage == Storage::External)
         {
             // Todo..
@@ -247,29 +327,6 @@ void Logger::echo(const unsigned int    counter,
         {
             // Todo..
         }
-        if(configStruct->storage == Storage::InFile)
-        {
-            std::lock_guard<std::mutex> lock(logFileMutex);
-            if (logFile.is_open())
-            {
-                // Write the current time and the message to the file
-                logFile << " => Log Id : [" << counter  << "]"
-                        << "[ Line : "  << line << "] "
-                        << "[ Function : "  << function << "] "
-                        << "[ Thread Id : "  << strThreadId.str() << "] "
-                        << "[ File : "  << file << "] "
-                        << "] : ["    << typeStr << "] "
-                        << message    << " { DateTime: "
-                        << std::put_time(localtime(&occurTime), "%Y/%m/%d %H:%M:%S") << " }" << __cell_newline;
-                // Close the file
-                logFile.close();
-            }
-            else
-            {
-                (System::DeveloperMode::IsEnable) ? Log("Failed to open log file.", LoggerType::Critical) : DO_NOTHING;
-            }
-
-        }
         if(configStruct->storage == Storage::External)
         {
             // Todo..
@@ -297,28 +354,6 @@ void Logger::echo(const unsigned int    counter,
         {
             // Todo..
         }
-        if(configStruct->storage == Storage::InFile)
-        {
-            if (logFile.is_open())
-            {
-                // Write the current time and the message to the file
-                logFile << " => Log Id : [" << counter  << "]"
-                        << "[ Line : "  << line << "] "
-                        << "[ Function : "  << function << "] "
-                        << "[ Thread Id : "  << strThreadId.str() << "] "
-                        << "[ File : "  << file << "] "
-                        << "] : ["    << typeStr << "] "
-                        << message    << " { DateTime: "
-                        << std::put_time(localtime(&occurTime), "%Y/%m/%d %H:%M:%S") << " }" << __cell_newline;
-                // Close the file
-                logFile.close();
-            }
-            else
-            {
-                (System::DeveloperMode::IsEnable) ? Log("Failed to open log file.", LoggerType::Critical) : DO_NOTHING;
-            }
-
-        }
         if(configStruct->storage == Storage::External)
         {
             // Todo..
@@ -330,9 +365,56 @@ void Logger::echo(const unsigned int    counter,
 
         std::lock_guard<std::mutex> lock(mutex_l);
     }
+}
+
+void Logger::startAsync(const AsyncLoggerOptions& options)
+{
+    ConfigStruct config;
+    {
+        std::lock_guard<std::mutex> lock(configMutex);
+        config = configStruct.value_or(ConfigStruct());
+    }
+    AsyncLogBackend::instance().start(options, config);
+}
 
-    // Close the file
-    logFile.close();
+void Logger::stopAsync()
+{
+    AsyncLogBackend::instance().stop();
+}
+
+bool Logger::isAsync()
+{
+    return AsyncLogBackend::instance().running();
+}
+
+void Logger::flush()
+{
+    AsyncLogBackend::instance().flush();
+}
+
+Logger::DeferredSlot Logger::reserveDeferred(const LogSite& site, std::size_t argumentBytes)
+{
+    return AsyncLogBackend::instance().reserveDeferred(site, argumentBytes, LoggerModel);
+}
+
+void Logger::commitDeferred()
+{
+    AsyncLogBackend::instance().commitDeferred();
+}
+
+AsyncLoggerStatistics Logger::asyncStatistics()
+{
+    return AsyncLogBackend::instance().statistics();
+}
+
+void Logger::setRotation(const LogRotationOptions& options)
+{
+    LogRotation::instance().configure(options);
+}
+
+LogRotationOptions Logger::rotation()
+{
+    return LogRotation::instance().options();
 }
 
 std::mutex Tracer::configMutex;
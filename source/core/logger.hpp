@@ -30,6 +30,12 @@
 #   error "Cell's "core/filesystem.hpp" was not found!"
 #endif
 
+#if __has_include("core/binarylog.hpp")
+#   include "core/binarylog.hpp"
+#else
+#   error "Cell's "core/binarylog.hpp" was not found!"
+#endif
+
 CELL_NAMESPACE_BEGIN(Cell::Utility)
 
 /*!
@@ -145,13 +151,202 @@ struct ConfigStruct
     Storage         storage         {   Storage::Disable        };
 };
 
+/**
+ * @brief Constants related to the asynchronous logger.
+ */
+struct ASYNC_LOGGER_CONSTANTS final
+{
+    __cell_static_const_constexpr std::size_t               DEFAULT_RING_BYTES      = 1 << 16;  //!< Ring buffer of each logging thread.
+    __cell_static_const_constexpr std::size_t               MIN_RING_BYTES          = 1 << 12;  //!< Smallest ring buffer accepted.
+    __cell_static_const_constexpr std::size_t               BATCH_BYTES             = 1 << 16;  //!< Bytes formatted before a write().
+    __cell_static_const_constexpr std::size_t               MAX_PRODUCERS           = 1024;     //!< Threads that can own a ring at once.
+    __cell_static_const_constexpr std::size_t               MAX_DEFINED_SITES       = 4096;     //!< LogDeferred sites a .clog session remembers defining.
+    __cell_static_const_constexpr std::chrono::milliseconds DEFAULT_FLUSH_INTERVAL  { 50 };     //!< Longest a record waits for the writer.
+};
+
+/**
+ * @brief What a logging thread does when its ring buffer is full.
+ */
+enum class OverflowPolicy : Types::u8
+{
+    Block   =   0x0,    //!< Wait until the writer makes room.
+    Drop    =   0x1,    //!< Discard the record.
+    Count   =   0x2     //!< Discard the record; the writer then logs how many records the thread lost.
+};
+
+/**
+ * @brief Settings of the asynchronous logger.
+ */
+struct AsyncLoggerOptions final
+{
+    OverflowPolicy              overflowPolicy      { OverflowPolicy::Count };                          //!< Behaviour of a full ring.
+    std::size_t                 ringBytes           { ASYNC_LOGGER_CONSTANTS::DEFAULT_RING_BYTES };     //!< Per thread, rounded up to a power of two.
+    std::chrono::milliseconds   flushInterval       { ASYNC_LOGGER_CONSTANTS::DEFAULT_FLUSH_INTERVAL }; //!< How often an idle writer looks for records.
+    bool                        console             { true };                                           //!< Echo records to the standard error.
+    bool                        flushOnFatalSignal  { true };                                           //!< Write pending records when the process crashes.
+};
+
+/**
+ * @brief When the log file is rotated and which rotated files are kept.
+ *
+ * A rotated file is renamed aside, e.g. logs/log.json to logs/log-20251018T160433Z-000.json, and a new
+ * file is started; a background thread then compresses it to .json.gz and removes the oldest archives
+ * beyond the retention limits.
+ */
+struct LogRotationOptions final
+{
+    std::uint64_t           maxBytes        { 0 };      //!< Rotate once the file has reached this size; 0 disables.
+    std::chrono::seconds    interval        { 0 };      //!< Rotate when a record falls into a new interval since the epoch, e.g. 24h at midnight UTC; 0 disables.
+    bool                    compress        { true };   //!< Gzip rotated files in the background.
+    std::size_t             maxArchives     { 0 };      //!< Rotated files kept; 0 keeps all.
+    std::uint64_t           maxArchiveBytes { 0 };      //!< Total size of the rotated files kept; 0 is unlimited.
+};
+
+/**
+ * @brief Counters of the asynchronous logger since it was first started.
+ */
+struct AsyncLoggerStatistics final
+{
+    std::uint64_t   written     {}; //!< Records formatted by the writer.
+    std::uint64_t   dropped     {}; //!< Records discarded because a ring was full.
+    std::uint64_t   blocked     {}; //!< Times a logging thread waited for room.
+    std::uint64_t   batches     {}; //!< Rounds of the writer that ended in a write().
+    std::uint64_t   threads     {}; //!< Threads that currently own a ring.
+};
+
+/**
+ * @brief The severity of a record, for filtering; each LoggerType has one.
+ */
+enum class LogLevel : Types::u8
+{
+    Debug       =   0x0,    //!< Progress reports: Paused and InProgress.
+    Info        =   0x1,    //!< Default, Info, Success and Done.
+    Warning     =   0x2,    //!< Warning.
+    Error       =   0x3,    //!< Critical and Failed.
+    Off         =   0x4     //!< Nothing; as a minimum level, it disables logging.
+};
+
+/**
+ * Records below this level are compiled out: the calls of Log, LogTagged and LogDeferred become
+ * constant false branches the optimizer removes. The value is a LogLevel, 0 (Debug) by default,
+ * and is set with the CMake cache variable of the same name.
+ */
+#if !defined(CELL_LOG_MIN_LEVEL)
+#   define CELL_LOG_MIN_LEVEL 0
+#endif
+
+/**
+ * @brief Returns the level of a LoggerType.
+ */
+constexpr LogLevel logLevelOf(int type) noexcept
+{
+    switch (type) {
+    case LoggerType::Paused:
+    case LoggerType::InProgress:
+        return LogLevel::Debug;
+    case LoggerType::Warning:
+        return LogLevel::Warning;
+    case LoggerType::Critical:
+    case LoggerType::Failed:
+        return LogLevel::Error;
+    default:
+        return LogLevel::Info;
+    }
+}
+
+/**
+ * @brief Returns true if records of a LoggerType pass the compile-time floor, CELL_LOG_MIN_LEVEL.
+ */
+constexpr bool logLevelCompiled(int type) noexcept
+{
+#if CELL_LOG_MIN_LEVEL > 0
+    return static_cast<int>(logLevelOf(type)) >= CELL_LOG_MIN_LEVEL;
+#else
+    static_cast<void>(type);
+    return true;
+#endif
+}
+
+/**
+ * @brief A subsystem that logs with LogTagged, e.g. "WebServer", with a minimum level of its own.
+ *
+ * A channel holds the level that applies to it, its own or else the one of Logger::setMinimumLevel(),
+ * so checking it is one relaxed load and one comparison. Channels are objects with static storage
+ * duration; they register themselves by name, and a level set for a name before the channel exists is
+ * applied when it is constructed.
+ */
+class __cell_export LogChannel {
+public:
+    explicit LogChannel(std::string_view name);
+    ~LogChannel();
+
+    LogChannel(const LogChannel&) = delete;
+    LogChannel& operator=(const LogChannel&) = delete;
+
+    std::string_view name() const noexcept
+    {
+        return m_name;
+    }
+
+    /**
+     * @brief Returns true if records of a LoggerType are logged on this channel.
+     */
+    bool isEnabled(int type) const noexcept
+    {
+        return logLevelCompiled(type)
+               && static_cast<Types::u8>(logLevelOf(type)) >= m_level.load(std::memory_order_relaxed);
+    }
+
+private:
+    friend class Logger;
+
+    std::string_view            m_name      {};
+    std::atomic<Types::u8>      m_level     { 0 };
+    bool                        m_own       { false };      //!< The level was set for this channel.
+    LogChannel*                 m_next      { nullptr };    //!< The next registered channel.
+};
+
 #define Log(message, type)                                                                 \
-Logger::echo(__cell_compiler_counter,                                                      \
-             std::chrono::system_clock::to_time_t(std::chrono::system_clock::now()),       \
-             __cell_compiler_line,                                                         \
-             __cell_compiler_function,                                                     \
-             __cell_compiler_file,                                                         \
-             message, type)
+(Logger::isEnabled(type)                                                                   \
+    ? Logger::echo(__cell_compiler_counter,                                                \
+                   std::chrono::system_clock::to_time_t(std::chrono::system_clock::now()), \
+                   __cell_compiler_line,                                                   \
+                   __cell_compiler_function,                                               \
+                   __cell_compiler_file,                                                   \
+                   message, type)                                                          \
+    : void())
+
+/**
+ * Logs as Log does, if the LogChannel channel lets the type through; the message is only built then.
+ */
+#define LogTagged(channel, message, type)                                                  \
+((channel).isEnabled(type)                                                                 \
+    ? Logger::echo(__cell_compiler_counter,                                                \
+                   std::chrono::system_clock::to_time_t(std::chrono::system_clock::now()), \
+                   __cell_compiler_line,                                                   \
+                   __cell_compiler_function,                                               \
+                   __cell_compiler_file,                                                   \
+                   message, type)                                                          \
+    : void())
+
+/**
+ * Logs a std::format string and its arguments without formatting them on the calling thread. The call
+ * site is a LogSite fixed at compile time; in the asynchronous mode the call copies a pointer to it, a
+ * steady_clock time and the raw argument bytes into the ring, and the writer formats the record or,
+ * with OutputFormat::Dedicated, stores it as it is in the .clog file for cell-logdecode.
+ */
+#define LogDeferred(type, format, ...)                                                     \
+do {                                                                                       \
+    static constexpr LogSite __cell_log_site { format,                                     \
+                                               __cell_compiler_file,                       \
+                                               __cell_compiler_function,                   \
+                                               __cell_compiler_counter,                    \
+                                               __cell_compiler_line,                       \
+                                               type };                                     \
+    if (Logger::isEnabled(type)) {                                                         \
+        Logger::deferred(__cell_log_site, format __VA_OPT__(,) __VA_ARGS__);               \
+    }                                                                                      \
+} while (false)
 
     class Logger;
 /*!
@@ -202,6 +397,10 @@ public:
         std::format_string<Args...> format,  // Ensures compile-time format string
         Args&&... args)
     {
+        if (!isEnabled(type)) {
+            return;
+        }
+
         // Format the message using std::format
         std::string message = std::format(format, std::forward<Args>(args)...);
 
@@ -216,11 +415,142 @@ public:
             type);
     }
 
+    /**
+     * @brief Room for the arguments of a deferred record, as reserved in the ring of the calling thread.
+     */
+    struct DeferredSlot final
+    {
+        std::byte*  arguments   { nullptr };    //!< Where the arguments go; null if there is no room.
+        bool        fallback    { false };      //!< No ring: format and log the record synchronously.
+    };
+
+    /**
+     * @brief Logs a call of LogDeferred; use the macro, which supplies the site.
+     *
+     * The format string is checked against the arguments at compile time, as std::format does, but it
+     * is only applied by the writer or by cell-logdecode. Without the asynchronous mode, or for a
+     * record larger than a quarter of the ring, the message is formatted and echoed at once.
+     *
+     * @param site The call site.
+     * @param format The format string of the site.
+     * @param args Booleans, characters, numbers, strings or pointers.
+     */
+    template<typename... Args>
+    __cell_maybe_unused static void deferred(
+        const LogSite& site,
+        std::format_string<const Args&...> format,
+        const Args&... args)
+    {
+        const std::size_t bytes = (std::size_t { 0 } + ... + logArgumentSize(args));
+        const DeferredSlot slot = reserveDeferred(site, bytes);
+        if (slot.arguments != nullptr) {
+            std::byte* out = slot.arguments;
+            (encodeLogArgument(out, args), ...);
+            commitDeferred();
+        } else if (slot.fallback) {
+            echo(site.counter,
+                 std::chrono::system_clock::to_time_t(std::chrono::system_clock::now()),
+                 site.line,
+                 site.function,
+                 site.file,
+                 std::format(format, args...),
+                 site.type);
+        }
+    }
+
+    /**
+     * @brief Returns true if records of a LoggerType are logged: they pass CELL_LOG_MIN_LEVEL and the
+     *        minimum level set at runtime.
+     *
+     * Log and LogDeferred check this before they evaluate their arguments.
+     */
+    static bool isEnabled(int type) noexcept
+    {
+        return logLevelCompiled(type)
+               && static_cast<Types::u8>(logLevelOf(type)) >= minimumLevelValue.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Sets the minimum level of Log and of every LogChannel without a level of its own.
+     */
+    static void setMinimumLevel(LogLevel level);
+
+    /**
+     * @brief Sets the minimum level of a LogChannel by name, e.g. "WebServer" or "Router".
+     *
+     * The level also applies to a channel of that name constructed later.
+     */
+    static void setMinimumLevel(std::string_view channel, LogLevel level);
+
+    /**
+     * @brief Makes a LogChannel follow the minimum level of Log again.
+     */
+    static void resetMinimumLevel(std::string_view channel);
+
+    /**
+     * @brief Returns the minimum level of Log.
+     */
+    static LogLevel minimumLevel() noexcept;
+
     void set(const ConfigStruct& config);
     Types::Optional<ConfigStruct> get();
     void reset();
 
+    /**
+     * @brief Moves formatting and writing off the calling threads.
+     *
+     * Each thread that logs gets a lock-free ring buffer; echo() copies the record into it and returns.
+     * One background thread formats the records, keeps the log file open and writes each round with
+     * a single write() per destination. A thread whose ring is full follows the overflow policy, and a
+     * thread that cannot get a ring falls back to the synchronous path. Starting again applies new options;
+     * a new ring size applies to threads that have not logged yet.
+     *
+     * @param options The ring size, overflow policy, flush interval and crash handling.
+     */
+    static void startAsync(const AsyncLoggerOptions& options = AsyncLoggerOptions());
+
+    /**
+     * @brief Writes every pending record, stops the background thread and logs synchronously again.
+     */
+    static void stopAsync();
+
+    /**
+     * @brief Returns true while records are written by the background thread.
+     */
+    static bool isAsync();
+
+    /**
+     * @brief Blocks until every record logged before the call has been written.
+     *
+     * Returns at once in the synchronous mode, where echo() has already written the record.
+     */
+    static void flush();
+
+    /**
+     * @brief Returns the counters of the asynchronous logger.
+     */
+    static AsyncLoggerStatistics asyncStatistics();
+
+    /**
+     * @brief Sets when the log file is rotated, for the synchronous and the asynchronous mode.
+     *
+     * Rotation is off until this is called with a size or an interval.
+     */
+    static void setRotation(const LogRotationOptions& options);
+
+    /**
+     * @brief Returns the rotation settings.
+     */
+    static LogRotationOptions rotation();
+
 private:
+    friend class LogChannel;
+
+    inline static std::atomic<Types::u8> minimumLevelValue { 0 };
+
+    static DeferredSlot reserveDeferred(const LogSite& site, std::size_t argumentBytes);
+    static void commitDeferred();
+
     static FileSystem::FileManager fileManager;
     bool validateConfig(const ConfigStruct& config);
     void adjustConfig(ConfigStruct& config);
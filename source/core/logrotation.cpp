@@ -0,0 +1,207 @@
+#if __has_include("logrotation.hpp")
+#   include "logrotation.hpp"
+#else
+#   error "Cell's "logrotation.hpp" was not found!"
+#endif
+
+#if __has_include("modules/compression/gzip.hpp")
+#   include "modules/compression/gzip.hpp"
+#else
+#   error "Cell's "modules/compression/gzip.hpp" was not found!"
+#endif
+
+CELL_USING_NAMESPACE Cell::Modules::BuiltIn::Compression;
+
+CELL_NAMESPACE_BEGIN(Cell::Utility)
+
+namespace {
+
+/**
+ * @brief Returns a time as "20251018T160433Z".
+ */
+std::string archiveStamp(std::time_t time)
+{
+    std::tm utc {};
+#if defined(PLATFORM_WINDOWS)
+    gmtime_s(&utc, &time);
+#else
+    gmtime_r(&time, &utc);
+#endif
+    char text[32];
+    const std::size_t size = std::strftime(text, sizeof text, "%Y%m%dT%H%M%SZ", &utc);
+    return std::string(text, size);
+}
+
+}  // namespace
+
+LogRotation& LogRotation::instance()
+{
+    // Never destroyed, like the asynchronous backend that rotates through it
+    static LogRotation* rotation = new LogRotation();
+    return *rotation;
+}
+
+void LogRotation::configure(const LogRotationOptions& options)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_options = options;
+    m_maxBytes.store(options.maxBytes, std::memory_order_relaxed);
+    m_interval.store(options.interval.count(), std::memory_order_relaxed);
+}
+
+LogRotationOptions LogRotation::options() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_options;
+}
+
+bool LogRotation::due(std::uint64_t size, std::time_t lastWrite, std::time_t now) const noexcept
+{
+    const std::uint64_t maxBytes = m_maxBytes.load(std::memory_order_relaxed);
+    if (maxBytes > 0 && size >= maxBytes) {
+        return true;
+    }
+    // Intervals are counted from the epoch, so daily files change at midnight UTC whenever the process started
+    const std::int64_t interval = m_interval.load(std::memory_order_relaxed);
+    return interval > 0 && size > 0 && static_cast<std::int64_t>(now) / interval != static_cast<std::int64_t>(lastWrite) / interval;
+}
+
+bool LogRotation::rotate(const std::string& path, std::time_t now)
+{
+    const std::filesystem::path file(path);
+    const std::string prefix = (file.parent_path() / file.stem()).string() + "-" + archiveStamp(now) + "-";
+    const std::string extension = file.extension().string();
+
+    // A sequence number keeps rotations within one second apart and sorts like the time before it
+    std::error_code error;
+    bool renamed = false;
+    for (int sequence = 0; sequence < 1000 && !renamed; ++sequence) {
+        char number[4];
+        std::snprintf(number, sizeof number, "%03d", sequence);
+        const std::string archive = prefix + number + extension;
+        if (std::filesystem::exists(archive, error) || std::filesystem::exists(archive + std::string(Gzip::GZIP_CONSTANTS::GZIP_SUFFIX), error)) {
+            continue;
+        }
+        std::filesystem::rename(path, archive, error);
+        if (error) {
+            return false;
+        }
+        renamed = true;
+    }
+    if (!renamed) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (std::find(m_queue.begin(), m_queue.end(), path) == m_queue.end()) {
+        m_queue.push_back(path);
+    }
+    if (!m_worker.joinable()) {
+        m_worker = std::thread(&LogRotation::run, this);
+    }
+    m_wakeup.notify_one();
+    return true;
+}
+
+void LogRotation::wait()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this] { return m_queue.empty() && !m_busy; });
+}
+
+std::vector<std::filesystem::path> LogRotation::archives(const std::string& path)
+{
+    const std::filesystem::path file(path);
+    const std::string prefix = file.stem().string() + "-";
+    const std::string extension = file.extension().string();
+    const std::string compressed = extension + std::string(Gzip::GZIP_CONSTANTS::GZIP_SUFFIX);
+
+    std::vector<std::filesystem::path> found;
+    std::error_code error;
+    const std::filesystem::path folder = file.parent_path().empty() ? std::filesystem::path(".") : file.parent_path();
+    for (const auto& entry : std::filesystem::directory_iterator(folder, error)) {
+        const std::string name = entry.path().filename().string();
+        if (entry.is_regular_file(error) && name.starts_with(prefix)
+            && (name.ends_with(extension) || name.ends_with(compressed))) {
+            found.push_back(entry.path());
+        }
+    }
+    // The names start with the time of the rotation, so they sort from the oldest
+    std::sort(found.begin(), found.end());
+    return found;
+}
+
+void LogRotation::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        m_wakeup.wait(lock, [this] { return !m_queue.empty(); });
+        const std::string path = m_queue.front();
+        m_queue.pop_front();
+        m_busy = true;
+        const bool compressArchives = m_options.compress;
+        lock.unlock();
+
+        if (compressArchives) {
+            compress(path);
+        }
+        prune(path);
+
+        lock.lock();
+        m_busy = false;
+        if (m_queue.empty()) {
+            m_idle.notify_all();
+        }
+    }
+}
+
+void LogRotation::compress(const std::string& path)
+{
+    // Archives a previous process left uncompressed are picked up too
+    const std::string extension = std::filesystem::path(path).extension().string();
+    Gzip gzip;
+    for (const auto& archive : archives(path)) {
+        if (archive.extension().string() != extension) {
+            continue;
+        }
+        // Gzip names its output after the stem; the rename publishes the finished file under the full name
+        const std::filesystem::path output = archive.parent_path() / (archive.stem().string() + std::string(Gzip::GZIP_CONSTANTS::GZIP_SUFFIX));
+        std::error_code error;
+        try {
+            gzip.compressFile(archive.string(), false, Gzip::CompressionLevel::Default);
+            std::filesystem::rename(output, archive.string() + std::string(Gzip::GZIP_CONSTANTS::GZIP_SUFFIX), error);
+            if (!error) {
+                std::filesystem::remove(archive, error);
+            }
+        } catch (const std::exception&) {
+            std::filesystem::remove(output, error);
+        }
+    }
+}
+
+void LogRotation::prune(const std::string& path)
+{
+    const LogRotationOptions limits = options();
+    std::vector<std::filesystem::path> found = archives(path);
+
+    std::error_code error;
+    std::uint64_t total = 0;
+    for (const auto& archive : found) {
+        const std::uint64_t size = std::filesystem::file_size(archive, error);
+        total += error ? 0 : size;
+    }
+    // Oldest first, until both limits hold
+    for (std::size_t i = 0; i < found.size(); ++i) {
+        const std::size_t left = found.size() - i;
+        if ((limits.maxArchives == 0 || left <= limits.maxArchives) && (limits.maxArchiveBytes == 0 || total <= limits.maxArchiveBytes)) {
+            break;
+        }
+        std::uint64_t size = std::filesystem::file_size(found[i], error);
+        size = error ? 0 : size;
+        if (std::filesystem::remove(found[i], error)) {
+            total -= std::min(total, size);
+        }
+    }
+}
+
+CELL_NAMESPACE_END
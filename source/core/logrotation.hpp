@@ -0,0 +1,86 @@
+/*!
+ * Gen3 License
+ *
+ * @file        logrotation.hpp
+ * @brief       This file is part of the Cell engine.
+ * @author      <a href='https://github.com/thecompez'>Kambiz Asadzadeh</a>
+ * @package     libCell
+ * @copyright   Copyright (c) 2025 The Genyleap. All rights reserved.
+ * @license     https://github.com/genyleap/cell/blob/main/LICENSE.md
+ */
+
+#ifndef CELL_LOG_ROTATION_HPP
+#define CELL_LOG_ROTATION_HPP
+
+#if __has_include("logger.hpp")
+#   include "logger.hpp"
+#else
+#   error "Cell's "logger.hpp" was not found!"
+#endif
+
+CELL_NAMESPACE_BEGIN(Cell::Utility)
+
+/**
+ * @brief Rotates log files and archives the rotated ones.
+ *
+ * A process has one instance. Whoever writes the file asks due() before a record and, if it says so,
+ * closes the file, calls rotate() and opens the path again. rotate() renames the file in one step, so a
+ * reader sees either the old file or the new one; compressing and pruning the archives happens on a
+ * thread of its own, started with the first rotation.
+ */
+class __cell_export LogRotation {
+public:
+    static LogRotation& instance();
+
+    void configure(const LogRotationOptions& options);
+
+    LogRotationOptions options() const;
+
+    /**
+     * @brief Returns true if the next record must start a new file.
+     *
+     * @param size The size of the file.
+     * @param lastWrite When the file was last written to.
+     * @param now The time of the record.
+     */
+    bool due(std::uint64_t size, std::time_t lastWrite, std::time_t now) const noexcept;
+
+    /**
+     * @brief Renames a closed log file to a new archive name and queues the archive.
+     *
+     * @return False if the file could not be renamed; the caller goes on writing to it.
+     */
+    bool rotate(const std::string& path, std::time_t now);
+
+    /**
+     * @brief Blocks until every queued archive has been compressed and the retention limits applied.
+     */
+    void wait();
+
+    /**
+     * @brief Returns the archives of a log file, oldest first.
+     */
+    static std::vector<std::filesystem::path> archives(const std::string& path);
+
+private:
+    LogRotation() = default;
+
+    void run();
+    void compress(const std::string& path);
+    void prune(const std::string& path);
+
+    std::atomic<std::uint64_t>  m_maxBytes      { 0 };
+    std::atomic<std::int64_t>   m_interval      { 0 };  //!< Seconds.
+
+    mutable std::mutex          m_mutex         {};
+    std::condition_variable     m_wakeup        {};
+    std::condition_variable     m_idle          {};
+    LogRotationOptions          m_options       {};
+    std::deque<std::string>     m_queue         {};     //!< Log files with new archives.
+    bool                        m_busy          { false };
+    std::thread                 m_worker        {};
+};
+
+CELL_NAMESPACE_END
+
+#endif  // CELL_LOG_ROTATION_HPP
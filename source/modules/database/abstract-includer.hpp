@@ -13,6 +13,72 @@
 #error "Cell's abstracts/database/connectionpool.hpp was not found!"
 #endif
 
+#if __has_include("abstracts/database/connectionlease.hpp")
+#include "abstracts/database/connectionlease.hpp"
+#else
+#error "Cell's abstracts/database/connectionlease.hpp was not found!"
+#endif
+
+#if __has_include("abstracts/database/statementcache.hpp")
+#include "abstracts/database/statementcache.hpp"
+#else
+#error "Cell's abstracts/database/statementcache.hpp was not found!"
+#endif
+
+#if __has_include("abstracts/database/querycache.hpp")
+#include "abstracts/database/querycache.hpp"
+#else
+#error "Cell's abstracts/database/querycache.hpp was not found!"
+#endif
+
+#if __has_include("abstracts/database/statistics.hpp")
+#include "abstracts/database/statistics.hpp"
+#else
+#error "Cell's abstracts/database/statistics.hpp was not found!"
+#endif
+
+#if __has_include("abstracts/database/keyset.hpp")
+#include "abstracts/database/keyset.hpp"
+#else
+#error "Cell's abstracts/database/keyset.hpp was not found!"
+#endif
+
+#if __has_include("abstracts/database/migration.hpp")
+#include "abstracts/database/migration.hpp"
+#else
+#error "Cell's abstracts/database/migration.hpp was not found!"
+#endif
+
+#if __has_include("abstracts/database/sqlscript.hpp")
+#include "abstracts/database/sqlscript.hpp"
+#else
+#error "Cell's abstracts/database/sqlscript.hpp was not found!"
+#endif
+
+#if __has_include("abstracts/database/schemacatalog.hpp")
+#include "abstracts/database/schemacatalog.hpp"
+#else
+#error "Cell's abstracts/database/schemacatalog.hpp was not found!"
+#endif
+
+#if __has_include("abstracts/database/poolrouter.hpp")
+#include "abstracts/database/poolrouter.hpp"
+#else
+#error "Cell's abstracts/database/poolrouter.hpp was not found!"
+#endif
+
+#if __has_include("abstracts/database/resultset.hpp")
+#include "abstracts/database/resultset.hpp"
+#else
+#error "Cell's abstracts/database/resultset.hpp was not found!"
+#endif
+
+#if __has_include("abstracts/database/cursor.hpp")
+#include "abstracts/database/cursor.hpp"
+#else
+#error "Cell's abstracts/database/cursor.hpp was not found!"
+#endif
+
 #if __has_include("abstracts/database/datamanipulator.hpp")
 #include "abstracts/database/datamanipulator.hpp"
 #else
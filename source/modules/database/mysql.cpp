@@ -19,6 +19,322 @@ CELL_USING_NAMESPACE Cell::Types;
 
 CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Database)
 
+namespace {
+
+void executeOnMySql(const SqlConnection& connection, const std::string& sql)
+{
+    MySqlPtr mysqlConnection = std::get<MySqlPtr>(connection);
+    if (mysql_real_query(mysqlConnection, sql.c_str(), sql.length()) == 0) {
+        // Drain a result set so the connection stays usable for the next statement
+        if (MYSQL_RES* result = mysql_store_result(mysqlConnection)) {
+            mysql_free_result(result);
+        }
+        return;
+    }
+
+    // ER_LOCK_DEADLOCK, ER_LOCK_WAIT_TIMEOUT and SQLSTATE 40001 succeed when the transaction is run again
+    const std::string message = mysql_error(mysqlConnection);
+    const unsigned int error = mysql_errno(mysqlConnection);
+    if (error == 1213 || error == 1205 || std::string_view(mysql_sqlstate(mysqlConnection)) == "40001") {
+        throw Abstracts::SerializationFailure(message);
+    }
+    throw Exception(Exception::Reason::Database, message).getRuntimeError();
+}
+
+std::vector<std::string> beginOnMySql(const Abstracts::TransactionOptions& options)
+{
+    // SET TRANSACTION without a scope applies to the next transaction only
+    std::vector<std::string> statements;
+    switch (options.isolation) {
+    case Abstracts::IsolationLevel::Default:
+        break;
+    case Abstracts::IsolationLevel::ReadCommitted:
+        statements.emplace_back("SET TRANSACTION ISOLATION LEVEL READ COMMITTED");
+        break;
+    case Abstracts::IsolationLevel::RepeatableRead:
+        statements.emplace_back("SET TRANSACTION ISOLATION LEVEL REPEATABLE READ");
+        break;
+    case Abstracts::IsolationLevel::Serializable:
+        statements.emplace_back("SET TRANSACTION ISOLATION LEVEL SERIALIZABLE");
+        break;
+    }
+    statements.emplace_back(options.readOnly ? "START TRANSACTION READ ONLY" : "START TRANSACTION");
+    return statements;
+}
+
+const Abstracts::TransactionDialect mySqlDialect {
+    .execute = &executeOnMySql,
+    .begin   = &beginOnMySql
+};
+
+std::string mySqlPlaceholder(std::size_t)
+{
+    return "?";
+}
+
+std::string quoteMySqlIdentifier(std::string_view name)
+{
+    std::string quoted = "`";
+    for (const char character : name) {
+        quoted += character == '`' ? "``" : std::string(1, character);
+    }
+    return quoted + "`";
+}
+
+const Abstracts::KeysetDialect mySqlKeyset {
+    .placeholder     = &mySqlPlaceholder,
+    .quoteIdentifier = &quoteMySqlIdentifier
+};
+
+const Abstracts::SqlScriptDialect mySqlScript {
+    .backslashEscapes   = true,
+    .backtickQuotes     = true
+};
+
+/**
+ * @brief Reads the columns, indexes and foreign keys of every table of the current database in one round trip.
+ *
+ * The rows are laid out as Abstracts::SchemaCatalog::parse() expects.
+ */
+constexpr std::string_view mySqlSchemaCatalog =
+    "SELECT 'c', c.TABLE_NAME, c.COLUMN_NAME, c.COLUMN_TYPE, NULL, IF(c.IS_NULLABLE = 'YES', 't', 'f'),"
+    " c.COLUMN_DEFAULT, c.ORDINAL_POSITION, NULL"
+    " FROM INFORMATION_SCHEMA.COLUMNS c WHERE c.TABLE_SCHEMA = DATABASE()"
+    " UNION ALL"
+    " SELECT 'i', s.TABLE_NAME, s.INDEX_NAME, GROUP_CONCAT(s.COLUMN_NAME ORDER BY s.SEQ_IN_INDEX SEPARATOR '\x1f'),"
+    " IF(MIN(s.NON_UNIQUE) = 0, 't', 'f'), IF(s.INDEX_NAME = 'PRIMARY', 't', 'f'), NULL, NULL, NULL"
+    " FROM INFORMATION_SCHEMA.STATISTICS s WHERE s.TABLE_SCHEMA = DATABASE() GROUP BY s.TABLE_NAME, s.INDEX_NAME"
+    " UNION ALL"
+    " SELECT 'f', k.TABLE_NAME, k.CONSTRAINT_NAME, GROUP_CONCAT(k.COLUMN_NAME ORDER BY k.ORDINAL_POSITION SEPARATOR '\x1f'),"
+    " MIN(k.REFERENCED_TABLE_NAME), GROUP_CONCAT(k.REFERENCED_COLUMN_NAME ORDER BY k.ORDINAL_POSITION SEPARATOR '\x1f'), NULL, NULL, NULL"
+    " FROM INFORMATION_SCHEMA.KEY_COLUMN_USAGE k WHERE k.TABLE_SCHEMA = DATABASE() AND k.REFERENCED_TABLE_NAME IS NOT NULL"
+    " GROUP BY k.TABLE_NAME, k.CONSTRAINT_NAME";
+
+//! The row estimate of a table of the current database; TABLE_ROWS is NULL for a view.
+constexpr std::string_view mySqlRowEstimate =
+    "SELECT TABLE_ROWS FROM INFORMATION_SCHEMA.TABLES WHERE TABLE_SCHEMA = DATABASE() AND TABLE_NAME = ?";
+
+//! The row estimate of a table of another database.
+constexpr std::string_view mySqlQualifiedRowEstimate =
+    "SELECT TABLE_ROWS FROM INFORMATION_SCHEMA.TABLES WHERE TABLE_SCHEMA = ? AND TABLE_NAME = ?";
+
+/**
+ * @brief Whether a statement error means the cached handle can no longer be used.
+ */
+bool isStaleStatement(unsigned int error)
+{
+    // ER_UNKNOWN_STMT_HANDLER, and ER_NEED_REPREPARE once the server gave up re-preparing after DDL
+    return error == 1243 || error == 1615;
+}
+
+/**
+ * @brief Whether the session is gone, along with every statement prepared on it.
+ */
+bool isConnectionLost(unsigned int error)
+{
+    // CR_SERVER_GONE_ERROR, CR_SERVER_LOST
+    return error == 2006 || error == 2013;
+}
+
+MYSQL_STMT* prepareOnMySql(MySqlPtr connection, const std::string& sql)
+{
+    MYSQL_STMT* statement = mysql_stmt_init(connection);
+    if (!statement) {
+        throw Exception(Exception::Reason::Database, mysql_error(connection)).getRuntimeError();
+    }
+    if (mysql_stmt_prepare(statement, sql.c_str(), sql.length()) != 0) {
+        const std::string message = mysql_stmt_error(statement);
+        mysql_stmt_close(statement);
+        throw Exception(Exception::Reason::Database, message).getRuntimeError();
+    }
+
+    // Let mysql_stmt_store_result() compute column widths so result buffers can be sized up front
+    my_bool updateMaxLength = 1;
+    mysql_stmt_attr_set(statement, STMT_ATTR_UPDATE_MAX_LENGTH, &updateMaxLength);
+    return statement;
+}
+
+/**
+ * @brief Binds and executes a statement taken from the connection's prepared statement cache.
+ *
+ * The statement is prepared once per connection. A handle the server rejects as stale is dropped from
+ * the cache and prepared once more.
+ *
+ * @return The executed statement; it stays owned by the cache.
+ * @throws std::runtime_error If preparing, binding or executing fails.
+ */
+MYSQL_STMT* executeCached(MySqlConnectionPool& pool, MySqlPtr connection, const std::string& sql, const std::vector<std::string>& params)
+{
+    std::vector<MYSQL_BIND> bindParams(params.size());
+    std::vector<ulong> paramLengths(params.size());
+    for (std::size_t i = 0; i < params.size(); ++i) {
+        paramLengths[i] = params[i].length();
+        bindParams[i].buffer_type = MYSQL_TYPE_STRING;
+        bindParams[i].buffer = const_cast<char*>(params[i].data());
+        bindParams[i].buffer_length = paramLengths[i];
+        bindParams[i].length = &paramLengths[i];
+    }
+
+    auto& cache = pool.statementCache(connection);
+    for (int attempt = 0;; ++attempt) {
+        MYSQL_STMT** cached = cache.find(sql);
+        MYSQL_STMT* statement = cached ? *cached : cache.insert(sql, prepareOnMySql(connection, sql));
+
+        if (mysql_stmt_param_count(statement) != params.size()) {
+            throw Exception(Exception::Reason::Database, "Incorrect number of parameters for the prepared statement.").getRuntimeError();
+        }
+        if ((params.empty() || mysql_stmt_bind_param(statement, bindParams.data()) == 0) && mysql_stmt_execute(statement) == 0) {
+            return statement;
+        }
+
+        const std::string message = mysql_stmt_error(statement);
+        if (attempt > 0 || !isStaleStatement(mysql_stmt_errno(statement))) {
+            throw Exception(Exception::Reason::Database, message).getRuntimeError();
+        }
+        cache.invalidate(sql);
+    }
+}
+
+/**
+ * @brief Reads the whole result set of an executed statement as text, with NULL as "NULL".
+ */
+std::vector<std::vector<std::string>> fetchStatementRows(MYSQL_STMT* statement)
+{
+    std::vector<std::vector<std::string>> rows;
+    std::unique_ptr<MYSQL_RES, decltype(&mysql_free_result)> metadata(mysql_stmt_result_metadata(statement), &mysql_free_result);
+    if (!metadata) {
+        return rows;
+    }
+    if (mysql_stmt_store_result(statement) != 0) {
+        throw Exception(Exception::Reason::Database, mysql_stmt_error(statement)).getRuntimeError();
+    }
+
+    const uint numFields = mysql_num_fields(metadata.get());
+    const MYSQL_FIELD* fields = mysql_fetch_fields(metadata.get());
+    std::vector<MYSQL_BIND> bindResults(numFields);
+    std::vector<std::vector<char>> buffers(numFields);
+    std::vector<ulong> lengths(numFields);
+    std::vector<my_bool> isNull(numFields);
+    for (uint i = 0; i < numFields; ++i) {
+        // Numbers and dates are converted to text by the client, which needs a little room
+        buffers[i].resize(std::max<ulong>(fields[i].max_length, 64) + 1);
+        bindResults[i].buffer_type = MYSQL_TYPE_STRING;
+        bindResults[i].buffer = buffers[i].data();
+        bindResults[i].buffer_length = buffers[i].size();
+        bindResults[i].length = &lengths[i];
+        bindResults[i].is_null = &isNull[i];
+    }
+    if (mysql_stmt_bind_result(statement, bindResults.data()) != 0) {
+        const std::string message = mysql_stmt_error(statement);
+        mysql_stmt_free_result(statement);
+        throw Exception(Exception::Reason::Database, message).getRuntimeError();
+    }
+
+    rows.reserve(mysql_stmt_num_rows(statement));
+    int status = 0;
+    while ((status = mysql_stmt_fetch(statement)) == 0 || status == MYSQL_DATA_TRUNCATED) {
+        std::vector<std::string> row;
+        row.reserve(numFields);
+        for (uint i = 0; i < numFields; ++i) {
+            if (isNull[i]) {
+                row.emplace_back("NULL");
+            } else if (lengths[i] < buffers[i].size()) {
+                row.emplace_back(buffers[i].data(), lengths[i]);
+            } else {
+                // The value did not fit; fetch it again at its full length
+                std::string value(lengths[i], __cell_null_character);
+                MYSQL_BIND column {};
+                column.buffer_type = MYSQL_TYPE_STRING;
+                column.buffer = value.data();
+                column.buffer_length = value.size();
+                mysql_stmt_fetch_column(statement, &column, i, 0);
+                row.push_back(std::move(value));
+            }
+        }
+        rows.push_back(std::move(row));
+    }
+
+    const std::string message = status == 1 ? mysql_stmt_error(statement) : "";
+    mysql_stmt_free_result(statement);
+    if (status == 1) {
+        throw Exception(Exception::Reason::Database, message).getRuntimeError();
+    }
+    return rows;
+}
+
+/**
+ * @brief Closes a leased connection instead of pooling it when its session was lost.
+ */
+void discardIfLost(Abstracts::ConnectionLease& lease, MySqlPtr connection)
+{
+    if (lease && isConnectionLost(mysql_errno(connection))) {
+        lease.discard();
+    }
+}
+
+//! Upper bound of one multi-row INSERT, well below the smallest default max_allowed_packet (4 MiB).
+constexpr std::size_t bulkInsertStatementBytes = 1024 * 1024;
+
+//! Bytes collected before an export writes to its file.
+constexpr std::size_t exportBufferBytes = 256 * 1024;
+
+/**
+ * @brief Appends a value in the default LOAD DATA format: backslash escapes for the characters it treats specially.
+ */
+void appendLoadDataEscaped(std::string& buffer, std::string_view value)
+{
+    for (const char character : value) {
+        switch (character) {
+        case '\\': buffer += "\\\\"; break;
+        case '\t': buffer += "\\t"; break;
+        case '\n': buffer += "\\n"; break;
+        case '\r': buffer += "\\r"; break;
+        case '\b': buffer += "\\b"; break;
+        case '\0': buffer += "\\0"; break;
+        case '\x1a': buffer += "\\Z"; break;
+        default: buffer += character; break;
+        }
+    }
+}
+
+/**
+ * @brief The file served to LOAD DATA LOCAL INFILE while an import runs.
+ */
+struct LocalInfile final
+{
+    std::string     path    {};
+    std::ifstream   file    {};
+};
+
+/**
+ * @brief Lets the server read one client file, and only that one, for LOAD DATA LOCAL INFILE.
+ */
+void serveLocalInfile(MySqlPtr connection, LocalInfile& infile)
+{
+    mysql_set_local_infile_handler(
+        connection,
+        [](void** state, const char* filename, void* data) -> int {
+            auto* infile = static_cast<LocalInfile*>(data);
+            *state = infile;
+            // A server asking for any other file than the one named in the statement is refused
+            return filename && infile->path == filename && infile->file.is_open() ? 0 : 1;
+        },
+        [](void* state, char* buffer, unsigned int length) -> int {
+            auto* infile = static_cast<LocalInfile*>(state);
+            infile->file.read(buffer, length);
+            return infile->file.bad() ? -1 : static_cast<int>(infile->file.gcount());
+        },
+        [](void*) {},
+        [](void* state, char* message, unsigned int length) -> int {
+            const auto* infile = static_cast<const LocalInfile*>(state);
+            std::snprintf(message, length, "Cannot read %s.", infile ? infile->path.c_str() : "the requested file");
+            return 2000;
+        },
+        &infile);
+}
+
+}  // namespace
+
 void* MySQLDatabaseConnection::get()
 {
     auto connection = connectionPool.getConnection();
@@ -36,6 +352,8 @@ MySQLDatabaseConnection::MySQLDatabaseConnection(MySqlConnectionPool& connection
 
 MySQLDatabaseConnection::~MySQLDatabaseConnection()
 {
+    // Threads may have left a transaction open; it is rolled back before the pool connections go away
+    m_transactions.clear();
     disconnect();
 }
 
@@ -61,7 +379,7 @@ bool MySQLDatabaseConnection::connect()
                                connectionPool.m_poolData.port, __cell_nullptr, 0) == __cell_nullptr)
         {
             // Handle connection error
-            m_mysqlData.lastError = mysql_error(connection);
+            setLastError(mysql_error(connection));
             mysql_close(connection);
             connection = __cell_nullptr;
             return false;
@@ -78,7 +396,7 @@ bool MySQLDatabaseConnection::connect()
                               __cell_nullptr, __cell_nullptr) != 0)
             {
                 // Handle SSL/TLS configuration error
-                m_mysqlData.lastError = mysql_error(connection);
+                setLastError(mysql_error(connection));
                 mysql_close(connection);
                 connection = __cell_nullptr;
                 return false;
@@ -92,8 +410,9 @@ bool MySQLDatabaseConnection::connect()
 }
 
 bool MySQLDatabaseConnection::disconnect() {
+    // The dedicated connection comes from connect(), not from the pool
     if (connection) {
-        connectionPool.releaseConnection(connection);
+        mysql_close(connection);
         connection = __cell_nullptr;
     }
     return true;
@@ -128,8 +447,7 @@ bool MySQLDatabaseConnection::isConnected()
 
 bool MySQLDatabaseConnection::isQueryCached(const std::string& sql)
 {
-    std::unique_lock<std::mutex> lock(m_mysqlData.cacheMutex);
-    return m_mysqlData.queryCache.count(sql) > 0;
+    return queryCache()->contains(sql);
 }
 
 bool MySQLDatabaseConnection::isConnectionAlive()
@@ -144,28 +462,11 @@ bool MySQLDatabaseConnection::isConnectionAlive()
 
 int MySQLDatabaseConnection::getActiveConnectionsCount()
 {
-    if (!isConnected()) {
-        return 0;
-    }
-
-    int activeConnections = 0;
-
-    // Access the connection pool's data to count active connections
-    std::lock_guard<std::mutex> lock(connectionPool.m_poolData.mutex);
-    for (const auto& connection : connectionPool.m_poolData.connections) {
-        if (std::holds_alternative<MYSQL*>(connection)) {
-            MYSQL* mysqlConnection = std::get<MYSQL*>(connection);
-            if (mysqlConnection != nullptr && mysql_ping(mysqlConnection) == 0) {
-                activeConnections++;
-            }
-        }
-    }
-
-    return activeConnections;
+    // Open pool connections, idle or borrowed; validation happens on borrow rather than here
+    const auto statistics = connectionPool.statistics();
+    return static_cast<int>(statistics.idle + statistics.inUse);
 }
 
-
-
 std::string MySQLDatabaseConnection::getConnectionHealthStatus()
 {
     auto& engine = engineController.getEngine();
@@ -235,7 +536,14 @@ std::string MySQLDatabaseConnection::getDatabaseServerVersion()
 
 std::map<std::string, std::string> MySQLDatabaseConnection::getConnectionStatistics()
 {
-    std::map<std::string, std::string> stats;
+    std::map<std::string, std::string> stats = connectionPool.statisticsMap();
+
+    const auto statements = connectionPool.statementCacheStatistics();
+    stats["statement_cache_hits"] = std::to_string(statements.hits);
+    stats["statement_cache_misses"] = std::to_string(statements.misses);
+    stats["statement_cache_evictions"] = std::to_string(statements.evictions);
+    stats["statement_cache_invalidations"] = std::to_string(statements.invalidations);
+    stats["statement_cache_hit_ratio"] = std::to_string(statements.hitRatio());
 
     if (!isConnected()) {
         //! Handle not being connected
@@ -258,7 +566,7 @@ std::map<std::string, std::string> MySQLDatabaseConnection::getConnectionStatist
         }
     } else {
         // Handle error retrieving connection stats
-        m_mysqlData.lastError = mysql_error(connection);
+        setLastError(mysql_error(connection));
         // You can log the error, throw an exception, or handle it in any other desired way
     }
 
@@ -288,7 +596,7 @@ std::chrono::seconds MySQLDatabaseConnection::getConnectionUptime()
     } else {
         //! Handle error retrieving connection stats
         //! Todo...
-        m_mysqlData.lastError = mysql_error(connection);
+        setLastError(mysql_error(connection));
         // You can log the error, throw an exception, or handle it in any other desired way
     }
 
@@ -321,108 +629,160 @@ std::vector<std::string> MySQLDatabaseConnection::getConnectionActivityLog()
 
 bool MySQLDatabaseConnection::executePreparedStatementSync(const std::string& sql, const std::vector<std::string>& params)
 {
-    auto& engine = engineController.getEngine();
-    auto language = createLanguageObject()->getLanguageCode();
+    return executeWithParamsSync(sql, params);
+}
 
-    if (!isConnected()) {
-        m_mysqlData.lastError = safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
-                                                    engine.meta()->returnView(MYSQL_CONSTANTS::DRIVER_NAME));
+std::future<bool> MySQLDatabaseConnection::executePreparedStatementAsync(const std::string& sql, const std::vector<std::string>& params)
+{
+    return std::async(std::launch::async, [this, sql, params]() {
+        return executePreparedStatementSync(sql, params);
+    });
+}
+
+bool MySQLDatabaseConnection::beginTransaction()
+{
+    // The transaction belongs to the calling thread; other threads keep using the pool
+    if (m_transactions.current()) {
+        setLastError("A transaction is already in progress.");
         return false;
     }
 
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<MySqlPtr>(connection)) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "invalid_connection_pool");
+    try {
+        m_transactions.pin(transaction());
+        return true;
+    } catch (const std::exception& e) {
+        setLastError(e.what());
         return false;
     }
+}
 
-    MySqlPtr mysqlConnection = std::get<MySqlPtr>(connection);
+bool MySQLDatabaseConnection::commitTransaction()
+{
+    // The pinned connection goes back to the pool whatever the outcome
+    auto pinned = m_transactions.unpin();
+    if (!pinned) {
+        setLastError("No transaction is in progress.");
+        return false;
+    }
 
-    // Prepare the statement
-    MYSQL_STMT* statement = mysql_stmt_init(mysqlConnection);
-    if (!statement) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "failed_initialize_prepared_statement") + std::string(mysql_error(mysqlConnection));
-        connectionPool.releaseConnection(mysqlConnection);  // Release the connection back to the pool
+    try {
+        pinned->transaction.commit();
+    } catch (const std::exception& e) {
+        setLastError(e.what());
         return false;
     }
 
-    if (mysql_stmt_prepare(statement, sql.c_str(), sql.length()) != 0) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "failed_prepared_statement") + std::string(mysql_error(mysqlConnection));
-        mysql_stmt_close(statement);
-        connectionPool.releaseConnection(mysqlConnection);  // Release the connection back to the pool
+    // Results loaded while the transaction was open may predate its writes, and replicas have yet to replay them
+    if (pinned->writtenUnknown) {
+        queryCache()->invalidateAll();
+    } else if (!pinned->writtenTables.empty()) {
+        queryCache()->invalidate(pinned->writtenTables);
+    }
+    if (pinned->writtenUnknown || !pinned->writtenTables.empty()) {
+        m_lastWriteAt.store(std::chrono::steady_clock::now(), std::memory_order_relaxed);
+    }
+    return true;
+}
+
+bool MySQLDatabaseConnection::rollbackTransaction()
+{
+    auto pinned = m_transactions.unpin();
+    if (!pinned) {
+        setLastError("No transaction is in progress.");
         return false;
     }
 
-    // Bind the parameters
-    ulong numParams = mysql_stmt_param_count(statement);
-    if (numParams != params.size()) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "incorrect_number_of_parameters");
-        mysql_stmt_close(statement);
-        connectionPool.releaseConnection(mysqlConnection);  // Release the connection back to the pool
+    try {
+        pinned->transaction.rollback();
+        return true;
+    } catch (const std::exception& e) {
+        setLastError(e.what());
         return false;
     }
+}
 
-    std::vector<MYSQL_BIND> bindParams(numParams);
-    std::vector<std::string> paramValues(numParams);
-    std::vector<ulong> paramLengths(numParams);
-    std::vector<my_bool> paramIsNull(numParams);
+Abstracts::ConnectionLease MySQLDatabaseConnection::leaseConnection()
+{
+    return Abstracts::ConnectionLease(connectionPool);
+}
 
-    for (ulong i = 0; i < numParams; ++i) {
-        paramValues[i] = params[i];
-        paramLengths[i] = paramValues[i].length();
-        paramIsNull[i] = (paramLengths[i] == 0);
+Abstracts::Transaction MySQLDatabaseConnection::transaction(const Abstracts::TransactionOptions& options)
+{
+    return Abstracts::Transaction(leaseConnection(), mySqlDialect, options);
+}
 
-        bindParams[i].buffer_type = MYSQL_TYPE_STRING;
-        bindParams[i].buffer = const_cast<char*>(paramValues[i].c_str());
-        bindParams[i].buffer_length = paramLengths[i];
-        bindParams[i].length = &paramLengths[i];
-        bindParams[i].is_null = &paramIsNull[i];
+MySqlPtr MySQLDatabaseConnection::acquireConnection(Abstracts::ConnectionLease& lease)
+{
+    if (auto* pinned = m_transactions.current()) {
+        return pinned->transaction.lease().get<MySqlPtr>();
     }
+    lease = leaseConnection();
+    return lease.get<MySqlPtr>();
+}
 
-    if (mysql_stmt_bind_param(statement, bindParams.data()) != 0) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "failed_bind_parameters") + std::string(mysql_error(mysqlConnection));
-        mysql_stmt_close(statement);
-        connectionPool.releaseConnection(mysqlConnection);  // Release the connection back to the pool
-        return false;
+MySqlPtr MySQLDatabaseConnection::acquireReadConnection(const std::string& sql, Abstracts::ConnectionLease& lease, MySqlConnectionPool*& pool,
+                                                        bool allowReplica)
+{
+    pool = &connectionPool;
+    // A transaction reads its own writes, and anything that may write belongs on the primary
+    const auto router = allowReplica ? replicaRouter() : nullptr;
+    if (!router || m_transactions.current() || !Abstracts::PoolRouter::isReadOnly(sql)) {
+        return acquireConnection(lease);
     }
+    // Only MySqlConnectionPools are handed to the router
+    pool = static_cast<MySqlConnectionPool*>(&router->readPool(m_lastWriteAt.load(std::memory_order_relaxed)));
+    lease = Abstracts::ConnectionLease(*pool);
+    return lease.get<MySqlPtr>();
+}
 
-    // Execute the statement
-    if (mysql_stmt_execute(statement) != 0) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "failed_execute_prepared_statement") + std::string(mysql_error(mysqlConnection));
-        mysql_stmt_close(statement);
-        connectionPool.releaseConnection(mysqlConnection);  // Release the connection back to the pool
-        return false;
+void MySQLDatabaseConnection::setReplicas(const std::vector<std::reference_wrapper<MySqlConnectionPool>>& replicas,
+                                          const Abstracts::ReplicaRoutingOptions& options)
+{
+    std::shared_ptr<Abstracts::PoolRouter> router;
+    if (!replicas.empty()) {
+        std::vector<Abstracts::ConnectionPool*> pools;
+        pools.reserve(replicas.size());
+        for (MySqlConnectionPool& replica : replicas) {
+            pools.push_back(&replica);
+        }
+        router = std::make_shared<Abstracts::PoolRouter>(connectionPool, std::move(pools), options);
     }
 
-    mysql_stmt_close(statement);
-    connectionPool.releaseConnection(mysqlConnection);  // Release the connection back to the pool
-    return true;
+    // Readers switch from one router to the other without seeing none; the old one, and its probe thread,
+    // stop once the last read that picked it has its connection
+    std::lock_guard<std::mutex> lock(m_routerMutex);
+    m_router.swap(router);
 }
 
-std::future<bool> MySQLDatabaseConnection::executePreparedStatementAsync(const std::string& sql, const std::vector<std::string>& params)
+std::shared_ptr<Abstracts::PoolRouter> MySQLDatabaseConnection::replicaRouter() const
 {
-    return std::async(std::launch::async, [this, sql, params]() {
-        return executePreparedStatementSync(sql, params);
-    });
+    std::lock_guard<std::mutex> lock(m_routerMutex);
+    return m_router;
 }
 
-bool MySQLDatabaseConnection::beginTransaction()
+std::vector<Abstracts::ReplicaStatus> MySQLDatabaseConnection::replicaStatus() const
 {
-    const std::string sql = "BEGIN";
-    return executeSync(sql);
+    const auto router = replicaRouter();
+    return router ? router->status() : std::vector<Abstracts::ReplicaStatus> {};
 }
 
-bool MySQLDatabaseConnection::commitTransaction()
+void MySQLDatabaseConnection::recordWrite(const std::optional<std::vector<std::string>>& tables)
 {
-    const std::string sql = "COMMIT";
-    return executeSync(sql);
-}
+    // Invalidated now for the statements that do not join the transaction, and again on commit
+    if (tables) {
+        queryCache()->invalidate(*tables);
+    } else {
+        queryCache()->invalidateAll();
+    }
+    m_lastWriteAt.store(std::chrono::steady_clock::now(), std::memory_order_relaxed);
 
-bool MySQLDatabaseConnection::rollbackTransaction()
-{
-    const std::string sql = "ROLLBACK";
-    return executeSync(sql);
+    if (auto* pinned = m_transactions.current()) {
+        if (tables) {
+            pinned->writtenTables.insert(pinned->writtenTables.end(), tables->begin(), tables->end());
+        } else {
+            pinned->writtenUnknown = true;
+        }
+    }
 }
 
 bool MySQLDatabaseConnection::executeSync(const std::string& sql)
@@ -430,26 +790,24 @@ bool MySQLDatabaseConnection::executeSync(const std::string& sql)
     auto language = createLanguageObject()->getLanguageCode();
 
     if (!connectionPool.isInitialized()) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "failed_bind_parameters");
+        setLastError(safeTranslate(language, "exceptions", "failed_bind_parameters"));
         return false;
     }
 
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<MySqlPtr>(connection)) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "invalid_connection_pool");
-        return false;
-    }
-
-    MySqlPtr mysqlConnection = std::get<MySqlPtr>(connection);
-
-    if (mysql_query(mysqlConnection, sql.c_str()) != 0) {
-        m_mysqlData.lastError = mysql_error(mysqlConnection);
-        connectionPool.releaseConnection(mysqlConnection);
+    // Statements issued between beginTransaction() and commit/rollback run on the pinned connection
+    try {
+        if (auto* pinned = m_transactions.current()) {
+            pinned->transaction.execute(sql);
+        } else {
+            Abstracts::ConnectionLease lease = leaseConnection();
+            executeOnMySql(lease.connection(), sql);
+        }
+        recordWrite(Abstracts::QueryCache::tablesWrittenBy(sql));
+        return true;
+    } catch (const std::exception& e) {
+        setLastError(e.what());
         return false;
     }
-
-    connectionPool.releaseConnection(mysqlConnection);
-    return true;
 }
 
 
@@ -466,46 +824,33 @@ bool MySQLDatabaseConnection::executeBatchSync(const std::vector<std::string>& s
     auto& engine = engineController.getEngine();
     auto language = createLanguageObject()->getLanguageCode();
     if (!isConnected()) {
-        m_mysqlData.lastError = safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
-                                                    engine.meta()->returnView(MYSQL_CONSTANTS::DRIVER_NAME));
+        setLastError(safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
+                                         engine.meta()->returnView(MYSQL_CONSTANTS::DRIVER_NAME)));
         return false;
     }
 
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<MySqlPtr>(connection)) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "invalid_connection_pool");
-        return false;
-    }
-
-    MySqlPtr mysqlConnection = std::get<MySqlPtr>(connection);
-
-    // Begin the transaction
-    if (mysql_autocommit(mysqlConnection, 0) != 0) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "failed_start_transaction") + std::string(mysql_error(mysqlConnection));
-        connectionPool.releaseConnection(mysqlConnection);  // Release the connection back to the pool
+    // Inside beginTransaction() the batch joins the pinned transaction; otherwise it runs in one of its own,
+    // so the connection goes back to the pool with autocommit untouched
+    try {
+        if (auto* pinned = m_transactions.current()) {
+            for (const std::string& sql : sqlBatch) {
+                pinned->transaction.execute(sql);
+            }
+        } else {
+            Abstracts::Transaction batch = transaction();
+            for (const std::string& sql : sqlBatch) {
+                batch.execute(sql);
+            }
+            batch.commit();
+        }
+    } catch (const std::exception& e) {
+        setLastError(safeTranslate(language, "exceptions", "failed_execute_sql_statement") + std::string(e.what()));
         return false;
     }
 
-    // Execute each statement in the batch
     for (const std::string& sql : sqlBatch) {
-        if (mysql_query(mysqlConnection, sql.c_str()) != 0) {
-            m_mysqlData.lastError = safeTranslate(language, "exceptions", "failed_execute_sql_statement") + std::string(mysql_error(mysqlConnection));
-            mysql_rollback(mysqlConnection);  // Rollback the transaction
-            connectionPool.releaseConnection(mysqlConnection);  // Release the connection back to the pool
-            return false;
-        }
+        recordWrite(Abstracts::QueryCache::tablesWrittenBy(sql));
     }
-
-    // Commit the transaction
-    if (mysql_commit(mysqlConnection) != 0) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "failed_commit_transaction") + std::string(mysql_error(mysqlConnection));
-        mysql_rollback(mysqlConnection);  // Rollback the transaction
-        connectionPool.releaseConnection(mysqlConnection);  // Release the connection back to the pool
-        return false;
-    }
-
-    connectionPool.releaseConnection(mysqlConnection);  // Release the connection back to the pool
     return true;
 }
 
@@ -522,8 +867,8 @@ bool MySQLDatabaseConnection::executeProcedureSync(const std::string& procedure)
     auto& engine = engineController.getEngine();
     auto language = createLanguageObject()->getLanguageCode();
     if (!isConnected()) {
-        m_mysqlData.lastError = safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
-                                                    engine.meta()->returnView(MYSQL_CONSTANTS::DRIVER_NAME));
+        setLastError(safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
+                                         engine.meta()->returnView(MYSQL_CONSTANTS::DRIVER_NAME)));
         return false;
     }
 
@@ -540,70 +885,54 @@ std::future<bool> MySQLDatabaseConnection::executeProcedureAsync(const std::stri
 
 std::vector<std::vector<std::string>> MySQLDatabaseConnection::querySync(const std::string& sql)
 {
-    auto language = createLanguageObject()->getLanguageCode();
-
-    std::vector<std::vector<std::string>> queryResult;
-
-    // Check if the query result is already cached
-    if (isQueryCached(sql)) {
-        return m_mysqlData.queryCache[sql];
+    try {
+        return queryResult(sql)->toRows(false, "NULL");
+    } catch (const std::exception& e) {
+        auto language = createLanguageObject()->getLanguageCode();
+        setLastError(safeTranslate(language, "exceptions", "failed_execute_sql_query") + std::string(e.what()));
+        return {};
     }
+}
 
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<MySqlPtr>(connection)) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "invalid_connection_pool");
-        return queryResult;
-    }
+Abstracts::ResultSetPtr MySQLDatabaseConnection::queryResult(const std::string& sql)
+{
+    return readResult(sql, true);
+}
 
-    MySqlPtr mysqlConnection = std::get<MySqlPtr>(connection);
+Abstracts::ResultSetPtr MySQLDatabaseConnection::readResult(const std::string& sql, bool allowReplica)
+{
+    // Get a connection from a replica, the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    MySqlConnectionPool* pool = nullptr;
+    MySqlPtr mysqlConnection = acquireReadConnection(sql, lease, pool, allowReplica);
 
-    // Execute the query
     if (mysql_real_query(mysqlConnection, sql.c_str(), sql.length()) != 0) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "failed_execute_sql_query") + std::string(mysql_error(mysqlConnection));
-        connectionPool.releaseConnection(mysqlConnection);  // Release the connection back to the pool
-        return queryResult;
-    }
-
-    m_result = mysql_store_result(mysqlConnection);
-    if (!m_result) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "failed_retrieve_query_result") + std::string(mysql_error(mysqlConnection));
-        connectionPool.releaseConnection(mysqlConnection);  // Release the connection back to the pool
-        return queryResult;
+        const std::string message = mysql_error(mysqlConnection);
+        discardIfLost(lease, mysqlConnection);
+        throw Exception(Exception::Reason::Database, message).getRuntimeError();
     }
 
-    // Get the number of fields in the result set
-    uint numFields = mysql_num_fields(m_result);
-
-    // Fetch each row from the result set
-    MYSQL_ROW row;
-    while ((row = mysql_fetch_row(m_result))) {
-        std::vector<std::string> rowResult;
-
-        // Fetch each field value in the row
-        for (uint i = 0; i < numFields; ++i) {
-            // Check if the field value is NULL
-            if (row[i] == __cell_nullptr) {
-                rowResult.push_back("NULL");
-            } else {
-                rowResult.push_back(row[i]);
-            }
-        }
-
-        queryResult.push_back(rowResult);
+    MYSQL_RES* result = mysql_store_result(mysqlConnection);
+    if (!result) {
+        const std::string message = mysql_field_count(mysqlConnection) == 0 ? "The statement did not return a result set." : mysql_error(mysqlConnection);
+        throw Exception(Exception::Reason::Database, message).getRuntimeError();
     }
+    return std::make_unique<MySqlResultSet>(result);
+}
 
-    mysql_free_result(m_result);
-
-    // Cache the query result
-    m_mysqlData.cacheMutex.lock();
-    m_mysqlData.queryCache[sql] = queryResult;
-    m_mysqlData.cacheMutex.unlock();
-
-    // Release the connection back to the pool
-    connectionPool.releaseConnection(mysqlConnection);
+std::future<Abstracts::ResultSetPtr> MySQLDatabaseConnection::queryResultAsync(const std::string& sql)
+{
+    return std::async(std::launch::async, [this, sql]() {
+        return queryResult(sql);
+    });
+}
 
-    return queryResult;
+Abstracts::CursorPtr MySQLDatabaseConnection::openCursor(const std::string& sql)
+{
+    // Get a connection from the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    MySqlPtr mysqlConnection = acquireConnection(lease);
+    return std::make_unique<MySqlCursor>(std::move(lease), mysqlConnection, sql);
 }
 
 std::future<std::vector<std::vector<std::string>>> MySQLDatabaseConnection::queryAsync(const std::string& sql)
@@ -611,12 +940,6 @@ std::future<std::vector<std::vector<std::string>>> MySQLDatabaseConnection::quer
     std::promise<std::vector<std::vector<std::string>>> promise;
     std::future<std::vector<std::vector<std::string>>> future = promise.get_future();
 
-    // Check if the query result is already cached
-    if (isQueryCached(sql)) {
-        promise.set_value(m_mysqlData.queryCache[sql]);
-        return future;
-    }
-
     // Execute the query asynchronously
     std::thread queryThread([sql, promise = std::move(promise), this]() mutable {
         std::vector<std::vector<std::string>> queryResult;
@@ -628,14 +951,14 @@ std::future<std::vector<std::vector<std::string>>> MySQLDatabaseConnection::quer
         }
 
         if (mysql_real_query(connection, sql.c_str(), sql.length()) != 0) {
-            m_mysqlData.lastError = mysql_error(connection);
+            setLastError(mysql_error(connection));
             promise.set_value(queryResult);
             return;
         }
 
         m_result = mysql_store_result(connection);
         if (!m_result) {
-            m_mysqlData.lastError = mysql_error(connection);
+            setLastError(mysql_error(connection));
             promise.set_value(queryResult);
             return;
         }
@@ -651,10 +974,6 @@ std::future<std::vector<std::vector<std::string>>> MySQLDatabaseConnection::quer
             queryResult.push_back(rowResult);
         }
 
-        // Cache the query result
-        std::lock_guard<std::mutex> lock(m_mysqlData.cacheMutex);
-        m_mysqlData.queryCache[sql] = queryResult;
-
         mysql_free_result(m_result);
 
         promise.set_value(queryResult);
@@ -706,75 +1025,77 @@ void MySQLDatabaseConnection::setConnectionTimeout(int timeoutSeconds) {
 
 std::vector<std::vector<std::string>> MySQLDatabaseConnection::queryWithParamsSync(const std::string& sql, const std::vector<std::string>& params)
 {
-    auto language = createLanguageObject()->getLanguageCode();
+    // Get a connection from a replica, the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    MySqlConnectionPool* pool = nullptr;
+    MySqlPtr mysqlConnection = acquireReadConnection(sql, lease, pool);
 
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<MySqlPtr>(connection)) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "invalid_connection_pool");
+    std::vector<std::vector<std::string>> queryResult;
+    try {
+        queryResult = fetchStatementRows(executeCached(*pool, mysqlConnection, sql, params));
+    } catch (const std::exception& e) {
+        auto language = createLanguageObject()->getLanguageCode();
+        setLastError(safeTranslate(language, "exceptions", "failed_execute_sql_query") + std::string(e.what()));
+        discardIfLost(lease, mysqlConnection);
         return {};
     }
 
-    MySqlPtr mysqlConnection = std::get<MySqlPtr>(connection);
-
-    // Combine the SQL string and parameter values
-    std::string preparedSql = sql;
-    for (const std::string& param : params) {
-        // Replace "?" placeholders in the SQL string with parameter values
-        size_t pos = preparedSql.find("?");
-        if (pos != std::string::npos) {
-            preparedSql.replace(pos, 1, param);
-        }
-    }
+    return queryResult;
+}
 
-    // Check if the query result is already cached
-    std::unique_lock<std::mutex> lock(m_mysqlData.cacheMutex);
-    if (m_mysqlData.queryCache.count(preparedSql) > 0) {
-        return m_mysqlData.queryCache[preparedSql];
-    }
+std::future<std::vector<std::vector<std::string>>> MySQLDatabaseConnection::queryWithParamsAsync(const std::string& sql, const std::vector<std::string>& params)
+{
+    return std::async(std::launch::async, [this, sql, params]() {
+        return queryWithParamsSync(sql, params);
+    });
+}
 
-    // Execute the query and retrieve the result
-    if (mysql_real_query(mysqlConnection, preparedSql.c_str(), preparedSql.length()) != 0) {
-        // Handle query execution error
-        m_mysqlData.lastError = mysql_error(mysqlConnection);
-        connectionPool.releaseConnection(mysqlConnection);
-        return {};
+std::vector<std::vector<std::string>> MySQLDatabaseConnection::queryCached(const std::string& sql,
+                                                                           const std::vector<std::string>& params,
+                                                                           const Abstracts::QueryCacheOptions& options)
+{
+    // Inside a transaction the live data is read, including the transaction's own writes
+    if (m_transactions.current()) {
+        return params.empty() ? querySync(sql) : queryWithParamsSync(sql, params);
     }
 
-    m_result = mysql_store_result(mysqlConnection);
-    if (!m_result) {
-        // Handle result retrieval error
-        m_mysqlData.lastError = mysql_error(mysqlConnection);
-        connectionPool.releaseConnection(mysqlConnection);
+    try {
+        // A replica may not have replayed the write that invalidated the entry yet, so misses are loaded from the primary
+        const auto rows = queryCache()->getOrLoad(sql, params, options, [this, &sql, &params]() {
+            if (params.empty()) {
+                return readResult(sql, false)->toRows(false, "NULL");
+            }
+            Abstracts::ConnectionLease lease;
+            MySqlConnectionPool* pool = nullptr;
+            MySqlPtr mysqlConnection = acquireReadConnection(sql, lease, pool, false);
+            try {
+                return fetchStatementRows(executeCached(*pool, mysqlConnection, sql, params));
+            } catch (const std::exception&) {
+                discardIfLost(lease, mysqlConnection);
+                throw;
+            }
+        });
+        return *rows;
+    } catch (const std::exception& e) {
+        auto language = createLanguageObject()->getLanguageCode();
+        setLastError(safeTranslate(language, "exceptions", "failed_execute_sql_query") + std::string(e.what()));
         return {};
     }
+}
 
-    // Process the result into a vector of vector of strings
-    std::vector<std::vector<std::string>> queryResult;
-    MYSQL_ROW row;
-    while ((row = mysql_fetch_row(m_result))) {
-        std::vector<std::string> rowResult;
-        uint numFields = mysql_num_fields(m_result);
-        for (uint i = 0; i < numFields; ++i) {
-            rowResult.push_back(row[i] ? row[i] : "NULL");
-        }
-        queryResult.push_back(rowResult);
+void MySQLDatabaseConnection::setQueryCache(std::shared_ptr<Abstracts::QueryCache> cache)
+{
+    if (!cache) {
+        throw std::invalid_argument("The query cache must not be null.");
     }
-
-    // Cache the query result
-    m_mysqlData.queryCache[preparedSql] = queryResult;
-
-    // Release the connection back to the pool
-    connectionPool.releaseConnection(mysqlConnection);
-
-    return queryResult;
+    std::lock_guard<std::mutex> lock(m_mysqlData.cacheMutex);
+    m_mysqlData.queryCache = std::move(cache);
 }
 
-std::future<std::vector<std::vector<std::string>>> MySQLDatabaseConnection::queryWithParamsAsync(const std::string& sql, const std::vector<std::string>& params)
+std::shared_ptr<Abstracts::QueryCache> MySQLDatabaseConnection::queryCache() const
 {
-    return std::async(std::launch::async, [this, sql, params]() {
-        return queryWithParamsSync(sql, params);
-    });
+    std::lock_guard<std::mutex> lock(m_mysqlData.cacheMutex);
+    return m_mysqlData.queryCache;
 }
 
 std::string MySQLDatabaseConnection::sanitizeInput(const std::string& input)
@@ -811,543 +1132,241 @@ std::string MySQLDatabaseConnection::sanitizeInput(const std::string& input)
 
 bool MySQLDatabaseConnection::executeWithParamsSync(const std::string& sql, const std::vector<std::string>& params)
 {
-    auto language = createLanguageObject()->getLanguageCode();
-
-    // Get a connection from the pool
-    SqlConnection connection = connectionPool.getConnection();
-
-    // Use visitor pattern to extract the MySqlPtr pointer from the SqlConnection variant
-    MySqlPtr mysqlConnection = std::visit([language](auto&& arg) -> MySqlPtr {
-        using T = std::decay_t<decltype(arg)>;
-        if constexpr (std::is_same_v<T, MySqlPtr>) {
-            return arg;
-        } else {
-            throw std::runtime_error(safeTranslate(language, "exceptions", "invalid_connection_error"));
-        }
-    }, connection);
-
-    // Combine the SQL string and parameter values
-    std::string preparedSql = sql;
-    for (const std::string& param : params) {
-        // Replace "?" placeholders in the SQL string with parameter values
-        size_t pos = preparedSql.find("?");
-        if (pos != std::string::npos) {
-            preparedSql.replace(pos, 1, param);
-        }
-    }
-
-    // Execute the query
-    if (mysql_real_query(mysqlConnection, preparedSql.c_str(), preparedSql.length()) != 0) {
-        // Handle query execution error
-        m_mysqlData.lastError = mysql_error(mysqlConnection);
-        connectionPool.releaseConnection(connection);
+    // Get a connection from the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    MySqlPtr mysqlConnection = acquireConnection(lease);
+
+    try {
+        MYSQL_STMT* statement = executeCached(connectionPool, mysqlConnection, sql, params);
+        // Drain a result set so the statement can be executed again
+        mysql_stmt_free_result(statement);
+    } catch (const std::exception& e) {
+        auto language = createLanguageObject()->getLanguageCode();
+        setLastError(safeTranslate(language, "exceptions", "failed_execute_prepared_statement") + std::string(e.what()));
+        discardIfLost(lease, mysqlConnection);
         return false;
     }
-
-    // Release the connection back to the pool
-    connectionPool.releaseConnection(connection);
-
+    recordWrite(Abstracts::QueryCache::tablesWrittenBy(sql));
     return true;
 }
 
 std::future<bool> MySQLDatabaseConnection::executeWithParamsAsync(const std::string& sql, const std::vector<std::string>& params)
 {
-    auto language = createLanguageObject()->getLanguageCode();
-    return std::async(std::launch::async, [this, sql, params, language]() {
-        // Get a connection from the pool
-        SqlConnection connection = connectionPool.getConnection();
-
-        // Use visitor pattern to extract the MySqlPtr pointer from the SqlConnection variant
-        MySqlPtr mysqlConnection = std::visit([language](auto&& arg) -> MySqlPtr {
-            using T = std::decay_t<decltype(arg)>;
-            if constexpr (std::is_same_v<T, MySqlPtr>) {
-                return arg;
-            } else {
-                throw std::runtime_error(safeTranslate(language, "exceptions", "invalid_connection_pool"));
-            }
-        }, connection);
-
-        // Combine the SQL string and parameter values
-        std::string preparedSql = sql;
-        for (const std::string& param : params) {
-            // Replace "?" placeholders in the SQL string with parameter values
-            size_t pos = preparedSql.find("?");
-            if (pos != std::string::npos) {
-                preparedSql.replace(pos, 1, param);
-            }
-        }
-
-        // Execute the query
-        if (mysql_real_query(mysqlConnection, preparedSql.c_str(), preparedSql.length()) != 0) {
-            // Handle query execution error
-            m_mysqlData.lastError = mysql_error(mysqlConnection);
-            connectionPool.releaseConnection(connection);
-            return false;
-        }
-
-        // Release the connection back to the pool
-        connectionPool.releaseConnection(connection);
-
-        return true;
+    return std::async(std::launch::async, [this, sql, params]() {
+        return executeWithParamsSync(sql, params);
     });
 }
 
-
 bool MySQLDatabaseConnection::executeBatchWithParamsSync(const std::string& sql, const std::vector<std::vector<std::string>>& paramsBatch)
 {
-    auto language = createLanguageObject()->getLanguageCode();
-
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<MySqlPtr>(connection)) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "invalid_connection_pool");
-        return false;
-    }
-
-    MySqlPtr mysqlConnection = std::get<MySqlPtr>(connection);
-
-    // Prepare the SQL statement
-    MYSQL_STMT* stmt = mysql_stmt_init(mysqlConnection);
-    if (!stmt) {
-        m_mysqlData.lastError = mysql_error(mysqlConnection);
-        connectionPool.releaseConnection(mysqlConnection);
-        return false;
-    }
-
-    if (mysql_stmt_prepare(stmt, sql.c_str(), sql.length()) != 0) {
-        m_mysqlData.lastError = mysql_stmt_error(stmt);
-        mysql_stmt_close(stmt);
-        connectionPool.releaseConnection(mysqlConnection);
-        return false;
-    }
-
-    // Bind parameters and execute the batch
-    for (const auto& params : paramsBatch) {
-        if (params.size() > 0) {
-            MYSQL_BIND bindParams[params.size()];
-            std::memset(bindParams, 0, sizeof(bindParams));
-
-            for (size_t i = 0; i < params.size(); ++i) {
-                const std::string& param = params[i];
-                bindParams[i].buffer_type = MYSQL_TYPE_STRING;
-                bindParams[i].buffer = const_cast<char*>(param.c_str());
-                bindParams[i].buffer_length = param.length();
-                bindParams[i].is_null = 0;
-                bindParams[i].length = __cell_nullptr;
-            }
-
-            if (mysql_stmt_bind_param(stmt, bindParams) != 0) {
-                m_mysqlData.lastError = mysql_stmt_error(stmt);
-                mysql_stmt_close(stmt);
-                connectionPool.releaseConnection(mysqlConnection);
-                return false;
-            }
-        }
-
-        if (mysql_stmt_execute(stmt) != 0) {
-            m_mysqlData.lastError = mysql_stmt_error(stmt);
-            mysql_stmt_close(stmt);
-            connectionPool.releaseConnection(mysqlConnection);
-            return false;
-        }
-
-        // Reset the statement for the next batch
-        mysql_stmt_reset(stmt);
-    }
-
-    // Clean up the statement
-    mysql_stmt_close(stmt);
-
-    // Release the connection back to the pool
-    connectionPool.releaseConnection(mysqlConnection);
-
-    return true;
-}
-
-std::future<bool> MySQLDatabaseConnection::executeBatchWithParamsAsync(const std::string& sql, const std::vector<std::vector<std::string>>& paramsBatch)
-{
-    auto language = createLanguageObject()->getLanguageCode();
-    return std::async(std::launch::async, [this, language, sql, paramsBatch]() {
-        // Get a connection from the connection pool
-        SqlConnection connection = connectionPool.getConnection();
-        MySqlPtr mysqlConnection = std::visit([language](auto&& arg) -> MySqlPtr {
-            using T = std::decay_t<decltype(arg)>;
-            if constexpr (std::is_same_v<T, MySqlPtr>) {
-                return arg;
-            } else {
-                throw std::runtime_error(safeTranslate(language, "exceptions", "invalid_connection_error"));
-            }
-        }, connection);
+    // Get a connection from the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    MySqlPtr mysqlConnection = acquireConnection(lease);
 
-        if (!mysqlConnection) {
-            m_mysqlData.lastError = safeTranslate(language, "exceptions", "invalid_connection_pool");
-            return false;
+    // The batch is atomic; inside a caller's transaction it simply becomes part of it
+    const bool ownTransaction = !m_transactions.current();
+    try {
+        if (ownTransaction) {
+            executeOnMySql(mysqlConnection, std::string(MYSQL_CONSTANTS::BEGIN));
         }
 
-        // Prepare the SQL statement
-        MYSQL_STMT* stmt = mysql_stmt_init(mysqlConnection);
-        if (!stmt) {
-            m_mysqlData.lastError = mysql_error(mysqlConnection);
-            connectionPool.releaseConnection(mysqlConnection);
-            return false;
-        }
-
-        if (mysql_stmt_prepare(stmt, sql.c_str(), sql.length()) != 0) {
-            m_mysqlData.lastError = mysql_stmt_error(stmt);
-            mysql_stmt_close(stmt);
-            connectionPool.releaseConnection(mysqlConnection);
-            return false;
-        }
-
-        // Bind parameters and execute the batch
+        // The statement is prepared once and every row only binds and executes
         for (const auto& params : paramsBatch) {
-            if (params.size() > 0) {
-                MYSQL_BIND bindParams[params.size()];
-                std::memset(bindParams, 0, sizeof(bindParams));
-
-                for (size_t i = 0; i < params.size(); ++i) {
-                    const std::string& param = params[i];
-                    bindParams[i].buffer_type = MYSQL_TYPE_STRING;
-                    bindParams[i].buffer = const_cast<char*>(param.c_str());
-                    bindParams[i].buffer_length = param.length();
-                    bindParams[i].is_null = 0;
-                    bindParams[i].length = __cell_nullptr;
-                }
-
-                if (mysql_stmt_bind_param(stmt, bindParams) != 0) {
-                    m_mysqlData.lastError = mysql_stmt_error(stmt);
-                    mysql_stmt_close(stmt);
-                    connectionPool.releaseConnection(mysqlConnection);
-                    return false;
-                }
-            }
-
-            if (mysql_stmt_execute(stmt) != 0) {
-                m_mysqlData.lastError = mysql_stmt_error(stmt);
-                mysql_stmt_close(stmt);
-                connectionPool.releaseConnection(mysqlConnection);
-                return false;
-            }
-
-            // Reset the statement for the next batch
-            mysql_stmt_reset(stmt);
+            mysql_stmt_free_result(executeCached(connectionPool, mysqlConnection, sql, params));
         }
 
-        // Clean up the statement
-        mysql_stmt_close(stmt);
-
-        // Release the connection back to the pool
-        connectionPool.releaseConnection(mysqlConnection);
-
-        return true;
-    });
-}
-
-bool MySQLDatabaseConnection::executeProcedureWithParamsSync(const std::string& procedure, const std::vector<std::string>& params)
-{
-    auto& engine = engineController.getEngine();
-    auto language = createLanguageObject()->getLanguageCode();
-
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<MySqlPtr>(connection)) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "invalid_connection_pool");
-        return false;
-    }
-
-    MySqlPtr mysqlConnection = std::get<MySqlPtr>(connection);
-
-    // Prepare the statement
-    MYSQL_STMT* stmt = mysql_stmt_init(mysqlConnection);
-    if (!stmt) {
-        m_mysqlData.lastError = mysql_error(mysqlConnection);
-        connectionPool.releaseConnection(mysqlConnection);
-        return false;
-    }
-
-    std::string sql = engine.meta()->returnView(MYSQL_CONSTANTS::CALL) + FROM_CELL_STRING(__cell_space) + procedure + "(";
-    for (size_t i = 0; i < params.size(); ++i) {
-        sql += "?";
-        if (i < params.size() - 1) {
-            sql += ",";
+        if (ownTransaction) {
+            executeOnMySql(mysqlConnection, std::string(MYSQL_CONSTANTS::COMMIT));
         }
-    }
-    sql += ")";
-
-    if (mysql_stmt_prepare(stmt, sql.c_str(), sql.length()) != 0) {
-        m_mysqlData.lastError = mysql_stmt_error(stmt);
-        mysql_stmt_close(stmt);
-        connectionPool.releaseConnection(mysqlConnection);
-        return false;
-    }
-
-    // Bind the parameters
-    std::vector<MYSQL_BIND> paramBinds(params.size());
-    std::vector<std::string> paramBuffers(params.size());
-
-    for (size_t i = 0; i < params.size(); ++i) {
-        paramBuffers[i] = params[i];
-        paramBinds[i].buffer_type = MYSQL_TYPE_STRING;
-        paramBinds[i].buffer = (void*)paramBuffers[i].c_str();
-        paramBinds[i].buffer_length = paramBuffers[i].length();
-        paramBinds[i].is_null = 0;
-        paramBinds[i].length = &paramBinds[i].buffer_length;
-    }
-
-    if (mysql_stmt_bind_param(stmt, paramBinds.data()) != 0) {
-        m_mysqlData.lastError = mysql_stmt_error(stmt);
-        mysql_stmt_close(stmt);
-        connectionPool.releaseConnection(mysqlConnection);
-        return false;
-    }
-
-    // Execute the statement
-    if (mysql_stmt_execute(stmt) != 0) {
-        m_mysqlData.lastError = mysql_stmt_error(stmt);
-        mysql_stmt_close(stmt);
-        connectionPool.releaseConnection(mysqlConnection);
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        if (ownTransaction) {
+            const std::string rollback(MYSQL_CONSTANTS::ROLLBACK);
+            mysql_real_query(mysqlConnection, rollback.c_str(), rollback.length());
+        }
+        discardIfLost(lease, mysqlConnection);
         return false;
     }
-
-    mysql_stmt_close(stmt);
-    connectionPool.releaseConnection(mysqlConnection);
-
+    recordWrite(Abstracts::QueryCache::tablesWrittenBy(sql));
     return true;
 }
 
-std::future<bool> MySQLDatabaseConnection::executeProcedureWithParamsAsync(const std::string& procedure, const std::vector<std::string>& params)
-{
-    return std::async(std::launch::async, [this, procedure, params]() {
-        return executeProcedureWithParamsSync(procedure, params);
-    });
-}
-
-
-std::vector<std::string> MySQLDatabaseConnection::getTableNames()
-{
-    auto& engine = engineController.getEngine();
-    auto language = createLanguageObject()->getLanguageCode();
-
-    std::vector<std::string> tableNames;
-
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<MySqlPtr>(connection)) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "invalid_connection_pool");
-        return tableNames;
-    }
-
-    MySqlPtr mysqlConnection = std::get<MySqlPtr>(connection);
-
-    // Execute the SHOW TABLES query
-    if (mysql_real_query(mysqlConnection, engine.meta()->returnView(MYSQL_CONSTANTS::SHOW_TABLES), 11) != 0) {
-        m_mysqlData.lastError = mysql_error(mysqlConnection);
-        connectionPool.releaseConnection(mysqlConnection);
-        return tableNames;
-    }
-
-    m_result = mysql_store_result(mysqlConnection);
-    if (!m_result) {
-        m_mysqlData.lastError = mysql_error(mysqlConnection);
-        connectionPool.releaseConnection(mysqlConnection);
-        return tableNames;
-    }
-
-    // Process the result and extract the table names
-    MYSQL_ROW row;
-    while ((row = mysql_fetch_row(m_result))) {
-        tableNames.push_back(row[0]);
-    }
-
-    mysql_free_result(m_result);
-    connectionPool.releaseConnection(mysqlConnection);
-
-    return tableNames;
-}
-
-
-std::vector<std::string> MySQLDatabaseConnection::getTableColumns(const std::string& tableName)
-{
-    auto language = createLanguageObject()->getLanguageCode();
-
-    std::vector<std::string> columnNames;
-
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<MySqlPtr>(connection)) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "invalid_connection_pool");
-        return columnNames;
-    }
-
-    MySqlPtr mysqlConnection = std::get<MySqlPtr>(connection);
-
-    // Prepare the query to retrieve column names
-    std::string query = "SELECT COLUMN_NAME FROM INFORMATION_SCHEMA.COLUMNS WHERE TABLE_NAME = '";
-    query += sanitizeInput(tableName) + "'";
-
-    // Execute the query
-    if (mysql_real_query(mysqlConnection, query.c_str(), query.length()) != 0) {
-        m_mysqlData.lastError = mysql_error(mysqlConnection);
-        connectionPool.releaseConnection(mysqlConnection);
-        return columnNames;
-    }
-
-    m_result = mysql_store_result(mysqlConnection);
-    if (!m_result) {
-        m_mysqlData.lastError = mysql_error(mysqlConnection);
-        connectionPool.releaseConnection(mysqlConnection);
-        return columnNames;
-    }
-
-    // Process the result and extract the column names
-    MYSQL_ROW row;
-    while ((row = mysql_fetch_row(m_result))) {
-        columnNames.push_back(row[0]);
-    }
-
-    mysql_free_result(m_result);
-    connectionPool.releaseConnection(mysqlConnection);
-
-    return columnNames;
-}
-
-
-std::vector<std::string> MySQLDatabaseConnection::getTableColumnTypes(const std::string& tableName)
-{
-    auto language = createLanguageObject()->getLanguageCode();
-
-    std::vector<std::string> columnTypes;
-
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<MySqlPtr>(connection)) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "invalid_connection_pool");
-        return columnTypes;
-    }
-
-    MySqlPtr mysqlConnection = std::get<MySqlPtr>(connection);
-
-    // Prepare the query to retrieve column types
-    std::string query = "SELECT COLUMN_TYPE FROM INFORMATION_SCHEMA.COLUMNS WHERE TABLE_NAME = '";
-    query += sanitizeInput(tableName) + "'";
-
-    // Execute the query
-    if (mysql_real_query(mysqlConnection, query.c_str(), query.length()) != 0) {
-        m_mysqlData.lastError = mysql_error(mysqlConnection);
-        connectionPool.releaseConnection(mysqlConnection);
-        return columnTypes;
-    }
-
-    m_result = mysql_store_result(mysqlConnection);
-    if (!m_result) {
-        m_mysqlData.lastError = mysql_error(mysqlConnection);
-        connectionPool.releaseConnection(mysqlConnection);
-        return columnTypes;
-    }
-
-    // Process the result and extract the column types
-    MYSQL_ROW row;
-    while ((row = mysql_fetch_row(m_result))) {
-        columnTypes.push_back(row[0]);
-    }
-
-    mysql_free_result(m_result);
-    connectionPool.releaseConnection(mysqlConnection);
-
-    return columnTypes;
+std::future<bool> MySQLDatabaseConnection::executeBatchWithParamsAsync(const std::string& sql, const std::vector<std::vector<std::string>>& paramsBatch)
+{
+    return std::async(std::launch::async, [this, sql, paramsBatch]() {
+        return executeBatchWithParamsSync(sql, paramsBatch);
+    });
 }
 
-std::string MySQLDatabaseConnection::getTablePrimaryKey(const std::string& tableName)
+bool MySQLDatabaseConnection::executeProcedureWithParamsSync(const std::string& procedure, const std::vector<std::string>& params)
 {
+    auto& engine = engineController.getEngine();
     auto language = createLanguageObject()->getLanguageCode();
 
-    std::string primaryKey;
+    // Get a connection from the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    MySqlPtr mysqlConnection = acquireConnection(lease);
 
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<MySqlPtr>(connection)) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "invalid_connection_pool");
-        return primaryKey;
+    // Prepare the statement
+    MYSQL_STMT* stmt = mysql_stmt_init(mysqlConnection);
+    if (!stmt) {
+        setLastError(mysql_error(mysqlConnection));
+        return false;
     }
 
-    MySqlPtr mysqlConnection = std::get<MySqlPtr>(connection);
+    std::string sql = engine.meta()->returnView(MYSQL_CONSTANTS::CALL) + FROM_CELL_STRING(__cell_space) + procedure + "(";
+    for (size_t i = 0; i < params.size(); ++i) {
+        sql += "?";
+        if (i < params.size() - 1) {
+            sql += ",";
+        }
+    }
+    sql += ")";
+
+    if (mysql_stmt_prepare(stmt, sql.c_str(), sql.length()) != 0) {
+        setLastError(mysql_stmt_error(stmt));
+        mysql_stmt_close(stmt);
+        return false;
+    }
 
-    // Prepare the query to retrieve the primary key column
-    std::string query = "SELECT COLUMN_NAME FROM INFORMATION_SCHEMA.KEY_COLUMN_USAGE WHERE TABLE_NAME = '";
-    query += sanitizeInput(tableName) + "' AND CONSTRAINT_NAME = 'PRIMARY'";
+    // Bind the parameters
+    std::vector<MYSQL_BIND> paramBinds(params.size());
+    std::vector<std::string> paramBuffers(params.size());
 
-    // Execute the query
-    if (mysql_real_query(mysqlConnection, query.c_str(), query.length()) != 0) {
-        m_mysqlData.lastError = mysql_error(mysqlConnection);
-        connectionPool.releaseConnection(mysqlConnection);
-        return primaryKey;
+    for (size_t i = 0; i < params.size(); ++i) {
+        paramBuffers[i] = params[i];
+        paramBinds[i].buffer_type = MYSQL_TYPE_STRING;
+        paramBinds[i].buffer = (void*)paramBuffers[i].c_str();
+        paramBinds[i].buffer_length = paramBuffers[i].length();
+        paramBinds[i].is_null = 0;
+        paramBinds[i].length = &paramBinds[i].buffer_length;
     }
 
-    m_result = mysql_store_result(mysqlConnection);
-    if (!m_result) {
-        m_mysqlData.lastError = mysql_error(mysqlConnection);
-        connectionPool.releaseConnection(mysqlConnection);
-        return primaryKey;
+    if (mysql_stmt_bind_param(stmt, paramBinds.data()) != 0) {
+        setLastError(mysql_stmt_error(stmt));
+        mysql_stmt_close(stmt);
+        return false;
     }
 
-    // Process the result and extract the primary key column
-    MYSQL_ROW row;
-    if ((row = mysql_fetch_row(m_result))) {
-        primaryKey = row[0];
+    // Execute the statement
+    if (mysql_stmt_execute(stmt) != 0) {
+        setLastError(mysql_stmt_error(stmt));
+        mysql_stmt_close(stmt);
+        return false;
     }
 
-    mysql_free_result(m_result);
-    connectionPool.releaseConnection(mysqlConnection);
+    mysql_stmt_close(stmt);
+
+    // A procedure may write any table
+    recordWrite(std::nullopt);
+    return true;
+}
 
-    return primaryKey;
+std::future<bool> MySQLDatabaseConnection::executeProcedureWithParamsAsync(const std::string& procedure, const std::vector<std::string>& params)
+{
+    return std::async(std::launch::async, [this, procedure, params]() {
+        return executeProcedureWithParamsSync(procedure, params);
+    });
 }
 
 
-std::pair<std::string, std::string> MySQLDatabaseConnection::getTableForeignKey(const std::string& tableName, const std::string& foreignKey)
+Abstracts::SchemaSnapshotPtr MySQLDatabaseConnection::schema()
 {
-    auto language = createLanguageObject()->getLanguageCode();
+    return connectionPool.schemaCatalog().snapshot([this]() {
+        // A connection of its own, never a replica: the catalog is shared and must see every committed change
+        Abstracts::ConnectionLease lease = leaseConnection();
+        MySqlPtr mysqlConnection = lease.get<MySqlPtr>();
+        if (mysql_real_query(mysqlConnection, mySqlSchemaCatalog.data(), mySqlSchemaCatalog.size()) != 0) {
+            const std::string message = mysql_error(mysqlConnection);
+            discardIfLost(lease, mysqlConnection);
+            throw Exception(Exception::Reason::Database, message).getRuntimeError();
+        }
+        MYSQL_RES* result = mysql_store_result(mysqlConnection);
+        if (!result) {
+            throw Exception(Exception::Reason::Database, mysql_error(mysqlConnection)).getRuntimeError();
+        }
+        return Abstracts::SchemaCatalog::parse(MySqlResultSet(result));
+    });
+}
 
-    std::pair<std::string, std::string> foreignKeyInfo;
+void MySQLDatabaseConnection::recordSchemaChange()
+{
+    // DDL commits implicitly in MySQL, so other connections see the change at once
+    connectionPool.schemaCatalog().invalidate();
+}
 
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<MySqlPtr>(connection)) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "invalid_connection_pool");
-        return foreignKeyInfo;
+std::vector<std::string> MySQLDatabaseConnection::getTableNames()
+{
+    try {
+        return schema()->tableNames();
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return {};
     }
+}
 
-    MySqlPtr mysqlConnection = std::get<MySqlPtr>(connection);
-
-    // Prepare the query to retrieve the foreign key information
-    std::string query = "SELECT COLUMN_NAME, REFERENCED_TABLE_NAME FROM INFORMATION_SCHEMA.KEY_COLUMN_USAGE WHERE TABLE_NAME = '";
-    query += sanitizeInput(tableName) + "' AND CONSTRAINT_NAME = '";
-    query += sanitizeInput(foreignKey) + "'";
 
-    // Execute the query
-    if (mysql_real_query(mysqlConnection, query.c_str(), query.length()) != 0) {
-        m_mysqlData.lastError = mysql_error(mysqlConnection);
-        connectionPool.releaseConnection(mysqlConnection);
-        return foreignKeyInfo;
+std::vector<std::string> MySQLDatabaseConnection::getTableColumns(const std::string& tableName)
+{
+    std::vector<std::string> columnNames;
+    try {
+        const auto snapshot = schema();
+        if (const auto* table = snapshot->table(tableName)) {
+            for (const auto& column : table->columns) {
+                columnNames.push_back(column.name);
+            }
+        }
+    } catch (const std::exception& e) {
+        setLastError(e.what());
     }
+    return columnNames;
+}
 
-    m_result = mysql_store_result(mysqlConnection);
-    if (!m_result) {
-        m_mysqlData.lastError = mysql_error(mysqlConnection);
-        connectionPool.releaseConnection(mysqlConnection);
-        return foreignKeyInfo;
+
+std::vector<std::string> MySQLDatabaseConnection::getTableColumnTypes(const std::string& tableName)
+{
+    std::vector<std::string> columnTypes;
+    try {
+        const auto snapshot = schema();
+        if (const auto* table = snapshot->table(tableName)) {
+            for (const auto& column : table->columns) {
+                columnTypes.push_back(column.type);
+            }
+        }
+    } catch (const std::exception& e) {
+        setLastError(e.what());
     }
+    return columnTypes;
+}
 
-    // Process the result and extract the foreign key details
-    MYSQL_ROW row;
-    if ((row = mysql_fetch_row(m_result))) {
-        foreignKeyInfo.first = row[0];                // Column name
-        foreignKeyInfo.second = row[1];               // Referenced table name
+std::string MySQLDatabaseConnection::getTablePrimaryKey(const std::string& tableName)
+{
+    try {
+        const auto snapshot = schema();
+        const auto* table = snapshot->table(tableName);
+        return table && !table->primaryKey.empty() ? table->primaryKey.front() : std::string();
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return {};
     }
+}
 
-    mysql_free_result(m_result);
-    connectionPool.releaseConnection(mysqlConnection);
 
-    return foreignKeyInfo;
+std::pair<std::string, std::string> MySQLDatabaseConnection::getTableForeignKey(const std::string& tableName, const std::string& foreignKey)
+{
+    try {
+        const auto snapshot = schema();
+        const auto* table = snapshot->table(tableName);
+        const auto* constraint = table ? table->foreignKey(foreignKey) : nullptr;
+        if (!constraint || constraint->columns.empty()) {
+            return {};
+        }
+        // Column name and referenced table name
+        return { constraint->columns.front(), constraint->referencedTable };
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return {};
+    }
 }
 
 bool MySQLDatabaseConnection::createTable(const std::string& tableName, const std::vector<std::string>& columns)
@@ -1355,14 +1374,9 @@ bool MySQLDatabaseConnection::createTable(const std::string& tableName, const st
     auto& engine = engineController.getEngine();
     auto language = createLanguageObject()->getLanguageCode();
 
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<MySqlPtr>(connection)) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "invalid_connection_pool");
-        return false;
-    }
-
-    MySqlPtr mysqlConnection = std::get<MySqlPtr>(connection);
+    // Get a connection from the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    MySqlPtr mysqlConnection = acquireConnection(lease);
 
     // Construct the CREATE TABLE query
     std::string query = engine.meta()->returnView(MYSQL_CONSTANTS::CREATE_TABLE) + FROM_CELL_STRING(__cell_space);
@@ -1376,12 +1390,11 @@ bool MySQLDatabaseConnection::createTable(const std::string& tableName, const st
 
     // Execute the query
     if (mysql_real_query(mysqlConnection, query.c_str(), query.length()) != 0) {
-        m_mysqlData.lastError = mysql_error(mysqlConnection);
-        connectionPool.releaseConnection(mysqlConnection);
+        setLastError(mysql_error(mysqlConnection));
         return false;
     }
 
-    connectionPool.releaseConnection(mysqlConnection);
+    recordSchemaChange();
     return true;
 }
 
@@ -1390,14 +1403,9 @@ bool MySQLDatabaseConnection::dropTable(const std::string& tableName)
     auto& engine = engineController.getEngine();
     auto language = createLanguageObject()->getLanguageCode();
 
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<MySqlPtr>(connection)) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "invalid_connection_pool");
-        return false;
-    }
-
-    MySqlPtr mysqlConnection = std::get<MySqlPtr>(connection);
+    // Get a connection from the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    MySqlPtr mysqlConnection = acquireConnection(lease);
 
     // Construct the DROP TABLE query
     std::string query = engine.meta()->returnView(MYSQL_CONSTANTS::DROP_TABLE) + FROM_CELL_STRING(__cell_space);
@@ -1405,12 +1413,12 @@ bool MySQLDatabaseConnection::dropTable(const std::string& tableName)
 
     // Execute the query
     if (mysql_real_query(mysqlConnection, query.c_str(), query.length()) != 0) {
-        m_mysqlData.lastError = mysql_error(mysqlConnection);
-        connectionPool.releaseConnection(mysqlConnection);
+        setLastError(mysql_error(mysqlConnection));
         return false;
     }
 
-    connectionPool.releaseConnection(mysqlConnection);
+    recordWrite(std::vector<std::string> { tableName });
+    recordSchemaChange();
     return true;
 }
 
@@ -1422,26 +1430,21 @@ bool MySQLDatabaseConnection::addColumn(const std::string& tableName, const std:
     // Construct the ALTER TABLE query
     std::string alterQuery = "ALTER TABLE " + sanitizeInput(tableName) + " ADD COLUMN " + sanitizeInput(columnName) + " " + sanitizeInput(columnType);
 
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<MySqlPtr>(connection)) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "invalid_connection_pool");
-        return false;
-    }
-
-    MySqlPtr mysqlConnection = std::get<MySqlPtr>(connection);
+    // Get a connection from the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    MySqlPtr mysqlConnection = acquireConnection(lease);
 
     // Execute the query
     std::vector<std::vector<std::string>> result = querySync(alterQuery);
 
     // Check if the query execution was successful
     if (result.empty()) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "failed_add_column") + std::string(mysql_error(mysqlConnection));
-        connectionPool.releaseConnection(mysqlConnection);
+        setLastError(safeTranslate(language, "exceptions", "failed_add_column") + std::string(mysql_error(mysqlConnection)));
         return false;
     }
 
-    connectionPool.releaseConnection(mysqlConnection);
+    recordWrite(std::vector<std::string> { tableName });
+    recordSchemaChange();
     return true;
 }
 
@@ -1452,26 +1455,21 @@ bool MySQLDatabaseConnection::modifyColumn(const std::string& tableName, const s
     // Construct the ALTER TABLE query
     std::string alterQuery = "ALTER TABLE " + sanitizeInput(tableName) + " MODIFY COLUMN " + sanitizeInput(columnName) + " " + sanitizeInput(newColumnType);
 
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<MySqlPtr>(connection)) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "invalid_connection_pool");
-        return false;
-    }
-
-    MySqlPtr mysqlConnection = std::get<MySqlPtr>(connection);
+    // Get a connection from the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    MySqlPtr mysqlConnection = acquireConnection(lease);
 
     // Execute the query
     std::vector<std::vector<std::string>> result = querySync(alterQuery);
 
     // Check if the query execution was successful
     if (result.empty()) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "failed_modify_column") + std::string(mysql_error(mysqlConnection));
-        connectionPool.releaseConnection(mysqlConnection);
+        setLastError(safeTranslate(language, "exceptions", "failed_modify_column") + std::string(mysql_error(mysqlConnection)));
         return false;
     }
 
-    connectionPool.releaseConnection(mysqlConnection);
+    recordWrite(std::vector<std::string> { tableName });
+    recordSchemaChange();
     return true;
 }
 
@@ -1482,26 +1480,21 @@ bool MySQLDatabaseConnection::renameColumn(const std::string& tableName, const s
     // Construct the ALTER TABLE query
     std::string alterQuery = "ALTER TABLE " + sanitizeInput(tableName) + " CHANGE " + sanitizeInput(columnName) + " " + sanitizeInput(newColumnName);
 
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<MySqlPtr>(connection)) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "invalid_connection_pool");
-        return false;
-    }
-
-    MySqlPtr mysqlConnection = std::get<MySqlPtr>(connection);
+    // Get a connection from the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    MySqlPtr mysqlConnection = acquireConnection(lease);
 
     // Execute the query
     std::vector<std::vector<std::string>> result = querySync(alterQuery);
 
     // Check if the query execution was successful
     if (result.empty()) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "failed_rename_column") + std::string(mysql_error(mysqlConnection));
-        connectionPool.releaseConnection(mysqlConnection);
+        setLastError(safeTranslate(language, "exceptions", "failed_rename_column") + std::string(mysql_error(mysqlConnection)));
         return false;
     }
 
-    connectionPool.releaseConnection(mysqlConnection);
+    recordWrite(std::vector<std::string> { tableName });
+    recordSchemaChange();
     return true;
 }
 
@@ -1512,26 +1505,21 @@ bool MySQLDatabaseConnection::deleteColumn(const std::string& tableName, const s
     // Construct the ALTER TABLE query
     std::string alterQuery = "ALTER TABLE " + sanitizeInput(tableName) + " DROP COLUMN " + sanitizeInput(columnName);
 
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<MySqlPtr>(connection)) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "invalid_connection_pool");
-        return false;
-    }
-
-    MySqlPtr mysqlConnection = std::get<MySqlPtr>(connection);
+    // Get a connection from the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    MySqlPtr mysqlConnection = acquireConnection(lease);
 
     // Execute the query
     std::vector<std::vector<std::string>> result = querySync(alterQuery);
 
     // Check if the query execution was successful
     if (result.empty()) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "failed_delete_column") + std::string(mysql_error(mysqlConnection));
-        connectionPool.releaseConnection(mysqlConnection);
+        setLastError(safeTranslate(language, "exceptions", "failed_delete_column") + std::string(mysql_error(mysqlConnection)));
         return false;
     }
 
-    connectionPool.releaseConnection(mysqlConnection);
+    recordWrite(std::vector<std::string> { tableName });
+    recordSchemaChange();
     return true;
 }
 
@@ -1542,7 +1530,7 @@ bool MySQLDatabaseConnection::optimizeIndexes()
     // Get the list of table names
     std::vector<std::string> tableNames = getTableNames();
     if (tableNames.empty()) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "failed_retrieve_table_names");
+        setLastError(safeTranslate(language, "exceptions", "failed_retrieve_table_names"));
         return false;
     }
 
@@ -1551,26 +1539,14 @@ bool MySQLDatabaseConnection::optimizeIndexes()
         // Construct the OPTIMIZE TABLE query
         std::string optimizeQuery = "OPTIMIZE TABLE " + sanitizeInput(tableName);
 
-        // Get a connection from the connection pool
-        auto connection = connectionPool.getConnection();
-        if (!std::holds_alternative<MySqlPtr>(connection)) {
-            m_mysqlData.lastError = safeTranslate(language, "exceptions", "invalid_connection_pool");
-            return false;
-        }
-
-        MySqlPtr mysqlConnection = std::get<MySqlPtr>(connection);
-
-        // Execute the query
+        // Execute the query; querySync() runs it on the pinned connection inside a transaction
         std::vector<std::vector<std::string>> result = querySync(optimizeQuery);
 
         // Check if the query execution was successful
         if (result.empty()) {
-            m_mysqlData.lastError = safeTranslate(language, "exceptions", "failed_optimize_indexes_table") + tableName + ": " + std::string(mysql_error(mysqlConnection));
-            connectionPool.releaseConnection(mysqlConnection);
+            setLastError(safeTranslate(language, "exceptions", "failed_optimize_indexes_table") + tableName + ": " + getLastError());
             return false;
         }
-
-        connectionPool.releaseConnection(mysqlConnection);
     }
 
     return true;
@@ -1580,23 +1556,30 @@ bool MySQLDatabaseConnection::optimizeIndexes()
 std::vector<std::string> MySQLDatabaseConnection::getExistingIndexes(const std::string& tableName)
 {
     std::vector<std::string> indexNames;
-    std::string sql = "SHOW INDEXES FROM " + tableName;
-    std::vector<std::vector<std::string>> result = querySync(sql);
-
-    for (const auto& row : result) {
-        if (!row.empty()) {
-            indexNames.push_back(row[2]);
+    try {
+        const auto snapshot = schema();
+        if (const auto* table = snapshot->table(tableName)) {
+            for (const auto& index : table->indexes) {
+                indexNames.push_back(index.name);
+            }
         }
+    } catch (const std::exception& e) {
+        setLastError(e.what());
     }
-
     return indexNames;
 }
 
 
 bool MySQLDatabaseConnection::indexExists(const std::string& tableName, const std::string& indexName)
 {
-    std::vector<std::string> existingIndexes = getExistingIndexes(tableName);
-    return std::find(existingIndexes.begin(), existingIndexes.end(), indexName) != existingIndexes.end();
+    try {
+        const auto snapshot = schema();
+        const auto* table = snapshot->table(tableName);
+        return table && table->index(indexName);
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return false;
+    }
 }
 
 
@@ -1606,7 +1589,7 @@ bool MySQLDatabaseConnection::createIndex(const std::string& tableName, const st
     // Check if the index already exists
     if (indexExists(tableName, indexName))
     {
-        m_mysqlData.lastError = safeFormat()->print(safeTranslate(language, "exceptions", "index_already_exist_table"), indexName, tableName);
+        setLastError(safeFormat()->print(safeTranslate(language, "exceptions", "index_already_exist_table"), indexName, tableName));
         return false;
     }
 
@@ -1615,10 +1598,11 @@ bool MySQLDatabaseConnection::createIndex(const std::string& tableName, const st
 
     // Execute the SQL statement to create the index
     if (!executeSync(createIndexSQL)) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "failed_to_create_index") + getLastError();
+        setLastError(safeTranslate(language, "exceptions", "failed_to_create_index") + getLastError());
         return false;
     }
 
+    recordSchemaChange();
     return true;
 }
 
@@ -1627,7 +1611,7 @@ bool MySQLDatabaseConnection::dropIndex(const std::string& tableName, const std:
     auto language = createLanguageObject()->getLanguageCode();
     // Check if the index exists before dropping
     if (!indexExists(tableName, indexName)) {
-        m_mysqlData.lastError = safeFormat()->print(safeTranslate(language, "exceptions", "index_does_not_exist_table"), indexName, tableName);
+        setLastError(safeFormat()->print(safeTranslate(language, "exceptions", "index_does_not_exist_table"), indexName, tableName));
         return false;
     }
 
@@ -1636,10 +1620,11 @@ bool MySQLDatabaseConnection::dropIndex(const std::string& tableName, const std:
 
     // Execute the SQL statement to drop the index
     if (!executeSync(dropIndexSQL)) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "failed_to_drop_index") + getLastError();
+        setLastError(safeTranslate(language, "exceptions", "failed_to_drop_index") + getLastError());
         return false;
     }
 
+    recordSchemaChange();
     return true;
 }
 
@@ -1690,36 +1675,63 @@ bool MySQLDatabaseConnection::bulkInsert(const std::string& tableName, const std
     auto language = createLanguageObject()->getLanguageCode();
     // Check if the data is empty
     if (data.empty()) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "no_data_provided_for_bulk_insert");
+        setLastError(safeTranslate(language, "exceptions", "no_data_provided_for_bulk_insert"));
         return false;
     }
 
-    // Prepare the SQL statement for bulk insert
-    std::string sql = "INSERT INTO " + tableName + " VALUES ";
+    // Get a connection from the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    MySqlPtr mysqlConnection = acquireConnection(lease);
 
-    // Prepare the parameter values for bulk insert
-    std::vector<std::string> params;
-    for (const auto& row : data) {
-        // Construct the row values string
-        std::string rowValues;
-        for (const auto& value : row) {
-            rowValues += "'" + sanitizeInput(value) + "',";
+    // Rows are sent as multi-row INSERTs of bounded size; together they are atomic
+    const std::string prefix = "INSERT INTO " + tableName + " VALUES ";
+    const bool ownTransaction = !m_transactions.current();
+    try {
+        if (ownTransaction) {
+            executeOnMySql(mysqlConnection, std::string(MYSQL_CONSTANTS::BEGIN));
         }
-        // Remove the trailing comma
-        rowValues.pop_back();
 
-        // Append the row values to the SQL statement
-        sql += "(" + rowValues + "),";
-    }
-    // Remove the trailing comma
-    sql.pop_back();
+        std::string sql = prefix;
+        std::string tuple;
+        std::string escaped;
+        for (const auto& row : data) {
+            tuple = "(";
+            for (const auto& value : row) {
+                escaped.resize(value.size() * 2 + 1);
+                const auto length = mysql_real_escape_string(mysqlConnection, escaped.data(), value.data(), value.size());
+                tuple += '\'';
+                tuple.append(escaped.data(), length);
+                tuple += "',";
+            }
+            if (tuple.back() == ',') {
+                tuple.pop_back();
+            }
+            tuple += "),";
 
-    // Execute the bulk insert query
-    if (!executeSync(sql)) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "failed_perform_bulk_insert") + getLastError();
+            if (sql.size() > prefix.size() && sql.size() + tuple.size() > bulkInsertStatementBytes) {
+                sql.pop_back(); // Remove the trailing comma
+                executeOnMySql(mysqlConnection, sql);
+                sql = prefix;
+            }
+            sql += tuple;
+        }
+        sql.pop_back(); // Remove the trailing comma
+        executeOnMySql(mysqlConnection, sql);
+
+        if (ownTransaction) {
+            executeOnMySql(mysqlConnection, std::string(MYSQL_CONSTANTS::COMMIT));
+        }
+    } catch (const std::exception& e) {
+        setLastError(safeTranslate(language, "exceptions", "failed_perform_bulk_insert") + e.what());
+        if (ownTransaction) {
+            const std::string rollback(MYSQL_CONSTANTS::ROLLBACK);
+            mysql_real_query(mysqlConnection, rollback.c_str(), rollback.length());
+        }
+        discardIfLost(lease, mysqlConnection);
         return false;
     }
 
+    recordWrite(std::vector<std::string> { tableName });
     return true;
 }
 
@@ -1730,7 +1742,7 @@ bool MySQLDatabaseConnection::bulkUpdate(const std::string& tableName, const std
     auto language = createLanguageObject()->getLanguageCode();
     // Check if the data is empty
     if (data.empty()) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "no_data_provided_bulk_update");
+        setLastError(safeTranslate(language, "exceptions", "no_data_provided_bulk_update"));
         return false;
     }
 
@@ -1742,7 +1754,7 @@ bool MySQLDatabaseConnection::bulkUpdate(const std::string& tableName, const std
     for (const auto& row : data) {
         // Check if the row has the correct number of values
         if (row.size() < 2) {
-            m_mysqlData.lastError = safeTranslate(language, "exceptions", "invalid_data_format_bulk_update");
+            setLastError(safeTranslate(language, "exceptions", "invalid_data_format_bulk_update"));
             return false;
         }
 
@@ -1761,7 +1773,7 @@ bool MySQLDatabaseConnection::bulkUpdate(const std::string& tableName, const std
 
     // Execute the bulk update query
     if (!executeSync(sql)) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "invalid_perform_bulk_update") + getLastError();
+        setLastError(safeTranslate(language, "exceptions", "invalid_perform_bulk_update") + getLastError());
         return false;
     }
 
@@ -1780,7 +1792,7 @@ bool MySQLDatabaseConnection::bulkDelete(const std::string& tableName, const std
 
     // Execute the bulk delete query
     if (!executeSync(sql)) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "failed_perform_bulk_delete") + getLastError();
+        setLastError(safeTranslate(language, "exceptions", "failed_perform_bulk_delete") + getLastError());
         return false;
     }
 
@@ -1796,7 +1808,7 @@ bool MySQLDatabaseConnection::migrateData(const std::string& sourceTableName, co
 
     // Execute the data migration query
     if (!executeSync(sql)) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "failed_to_migrate_data") + getLastError();
+        setLastError(safeTranslate(language, "exceptions", "failed_to_migrate_data") + getLastError());
         return false;
     }
 
@@ -1821,128 +1833,227 @@ std::vector<std::vector<std::string>> MySQLDatabaseConnection::queryWithPaginati
     return result;
 }
 
+Abstracts::KeysetPage MySQLDatabaseConnection::queryWithKeyset(const std::string& sql,
+                                                               const std::vector<Abstracts::KeysetColumn>& ordering,
+                                                               std::size_t pageSize,
+                                                               const std::string& continuation)
+{
+    const auto query = Abstracts::KeysetPagination::build(sql, ordering, pageSize, continuation, mySqlKeyset);
+
+    // Get a connection from a replica, the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    MySqlConnectionPool* pool = nullptr;
+    MySqlPtr mysqlConnection = acquireReadConnection(query.sql, lease, pool);
+    try {
+        // Every page after the first has the same text, so it reuses one prepared statement
+        return Abstracts::KeysetPagination::page(fetchStatementRows(executeCached(*pool, mysqlConnection, query.sql, query.params)), ordering, pageSize);
+    } catch (const std::exception&) {
+        discardIfLost(lease, mysqlConnection);
+        throw;
+    }
+}
+
 std::string MySQLDatabaseConnection::getLastError()
 {
+    std::lock_guard<std::mutex> lock(m_mysqlData.errorMutex);
     return m_mysqlData.lastError;
 }
 
+void MySQLDatabaseConnection::setLastError(std::string error)
+{
+    std::lock_guard<std::mutex> lock(m_mysqlData.errorMutex);
+    m_mysqlData.lastError = std::move(error);
+}
+
 
 int MySQLDatabaseConnection::getRowCount(const std::string& tableName)
 {
-    // Generate the SQL statement to count the rows in the table
-    std::string countSQL = "SELECT COUNT(*) FROM " + tableName;
-
-    // Execute the SQL statement and retrieve the result
-    if (executeSync(countSQL)) {
-        std::vector<std::vector<std::string>> result = querySync(countSQL);
-        if (!result.empty() && !result[0].empty()) {
-            // Convert the count value from string to integer
-            return std::stoi(result[0][0]);
+    try {
+        if (m_mysqlData.statistics.mode == Abstracts::StatisticsMode::Fast) {
+            return static_cast<int>(std::min<std::uint64_t>(estimateRowCount(tableName), std::numeric_limits<int>::max()));
         }
+        return std::stoi(queryScalar("SELECT COUNT(*) FROM " + tableName).value_or("0"));
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return -1;
     }
-
-    // Return -1 if the count retrieval failed
-    return -1;
 }
 
 
 std::string MySQLDatabaseConnection::getMaxValue(const std::string& tableName, const std::string& columnName)
 {
-    auto& engine = engineController.getEngine();
-    auto language = createLanguageObject()->getLanguageCode();
-    if (!isConnected()) {
-        m_mysqlData.lastError = safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
-                                                    engine.meta()->returnView(MYSQL_CONSTANTS::DRIVER_NAME));
+    try {
+        if (m_mysqlData.statistics.mode == Abstracts::StatisticsMode::Fast) {
+            // With an index on the column this reads its last entry
+            const auto rows = statistic("max", tableName, columnName, [this, &tableName, &columnName]() {
+                return queryResult("SELECT " + columnName + " FROM " + tableName + " WHERE " + columnName + " IS NOT NULL ORDER BY "
+                                   + columnName + " DESC LIMIT 1")->toRows(false);
+            });
+            return rows->empty() ? __cell_null_str : rows->front().front();
+        }
+        return queryScalar("SELECT MAX(" + columnName + ") FROM " + tableName).value_or(__cell_null_str);
+    } catch (const std::exception& e) {
+        setLastError(e.what());
         return __cell_null_str;
     }
-
-    std::string sql = "SELECT MAX(" + columnName + ") FROM " + tableName;
-    std::vector<std::vector<std::string>> result = querySync(sql);
-    if (!result.empty() && !result[0].empty()) {
-        return result[0][0];
-    }
-
-    return __cell_null_str;
 }
 
 std::string MySQLDatabaseConnection::getMinValue(const std::string& tableName, const std::string& columnName)
 {
-    auto& engine = engineController.getEngine();
-    auto language = createLanguageObject()->getLanguageCode();
-    if (!isConnected()) {
-        m_mysqlData.lastError = safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
-                                                    engine.meta()->returnView(MYSQL_CONSTANTS::DRIVER_NAME));
+    try {
+        if (m_mysqlData.statistics.mode == Abstracts::StatisticsMode::Fast) {
+            // With an index on the column this reads its first entry
+            const auto rows = statistic("min", tableName, columnName, [this, &tableName, &columnName]() {
+                return queryResult("SELECT " + columnName + " FROM " + tableName + " WHERE " + columnName + " IS NOT NULL ORDER BY "
+                                   + columnName + " LIMIT 1")->toRows(false);
+            });
+            return rows->empty() ? __cell_null_str : rows->front().front();
+        }
+        return queryScalar("SELECT MIN(" + columnName + ") FROM " + tableName).value_or(__cell_null_str);
+    } catch (const std::exception& e) {
+        setLastError(e.what());
         return __cell_null_str;
     }
-
-    std::string sql = "SELECT MIN(" + columnName + ") FROM " + tableName;
-    std::vector<std::vector<std::string>> result = querySync(sql);
-    if (!result.empty() && !result[0].empty()) {
-        return result[0][0];
-    }
-
-    return __cell_null_str;
 }
 
 double MySQLDatabaseConnection::getAverageValue(const std::string& tableName, const std::string& columnName)
 {
-    auto& engine = engineController.getEngine();
-    auto language = createLanguageObject()->getLanguageCode();
-    if (!isConnected()) {
-        m_mysqlData.lastError = safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
-                                                    engine.meta()->returnView(MYSQL_CONSTANTS::DRIVER_NAME));
+    try {
+        const auto rows = statistic("average", tableName, columnName, [this, &tableName, &columnName]() {
+            return Abstracts::QueryCache::Rows { { queryScalar("SELECT AVG(" + columnName + ") FROM " + tableName).value_or("0") } };
+        });
+        return std::stod(rows->front().front());
+    } catch (const std::exception& e) {
+        setLastError(e.what());
         return 0.0;
     }
-
-    std::string sql = "SELECT AVG(" + columnName + ") FROM " + tableName;
-    std::vector<std::vector<std::string>> result = querySync(sql);
-    if (!result.empty() && !result[0].empty()) {
-        return std::stod(result[0][0]);
-    }
-
-    return 0.0;
 }
 
 double MySQLDatabaseConnection::getSumValue(const std::string& tableName, const std::string& columnName)
 {
-    auto& engine = engineController.getEngine();
-    auto language = createLanguageObject()->getLanguageCode();
-    if (!isConnected()) {
-        m_mysqlData.lastError = safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
-                                                    engine.meta()->returnView(MYSQL_CONSTANTS::DRIVER_NAME));
+    try {
+        const auto rows = statistic("sum", tableName, columnName, [this, &tableName, &columnName]() {
+            return Abstracts::QueryCache::Rows { { queryScalar("SELECT SUM(" + columnName + ") FROM " + tableName).value_or("0") } };
+        });
+        return std::stod(rows->front().front());
+    } catch (const std::exception& e) {
+        setLastError(e.what());
         return 0.0;
     }
+}
 
-    std::string sql = "SELECT SUM(" + columnName + ") FROM " + tableName;
-    std::vector<std::vector<std::string>> result = querySync(sql);
-    if (!result.empty() && !result[0].empty()) {
-        return std::stod(result[0][0]);
+std::vector<std::string> MySQLDatabaseConnection::getDistinctValues(const std::string& tableName, const std::string& columnName)
+{
+    std::vector<std::string> distinctValues;
+    try {
+        const auto rows = statistic("distinct-values", tableName, columnName, [this, &tableName, &columnName]() {
+            return queryResult("SELECT DISTINCT " + columnName + " FROM " + tableName)->toRows(false, "NULL");
+        });
+        for (const auto& row : *rows) {
+            distinctValues.push_back(row[0]);
+        }
+    } catch (const std::exception& e) {
+        setLastError(e.what());
     }
+    return distinctValues;
+}
 
-    return 0.0;
+void MySQLDatabaseConnection::setStatisticsOptions(const Abstracts::StatisticsOptions& options)
+{
+    m_mysqlData.statistics = options;
 }
 
-std::vector<std::string> MySQLDatabaseConnection::getDistinctValues(const std::string& tableName, const std::string& columnName)
+Abstracts::StatisticsOptions MySQLDatabaseConnection::statisticsOptions() const
 {
-    auto& engine = engineController.getEngine();
-    auto language = createLanguageObject()->getLanguageCode();
-    std::vector<std::string> distinctValues;
+    return m_mysqlData.statistics;
+}
 
-    if (!isConnected()) {
-        m_mysqlData.lastError = safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
-                                                    engine.meta()->returnView(MYSQL_CONSTANTS::DRIVER_NAME));
-        return distinctValues;
+std::uint64_t MySQLDatabaseConnection::estimateRowCount(const std::string& tableName)
+{
+    const auto rows = statistic("rows", tableName, {}, [this, &tableName]() {
+        std::string unquoted;
+        std::copy_if(tableName.begin(), tableName.end(), std::back_inserter(unquoted), [](char character) { return character != '`'; });
+        const auto dot = unquoted.find('.');
+        const auto estimate = dot == std::string::npos
+                                  ? queryScalar(std::string(mySqlRowEstimate), { unquoted })
+                                  : queryScalar(std::string(mySqlQualifiedRowEstimate), { unquoted.substr(0, dot), unquoted.substr(dot + 1) });
+        if (estimate) {
+            return Abstracts::QueryCache::Rows { { *estimate } };
+        }
+        // A view has no estimate, and a table that does not exist fails here
+        return Abstracts::QueryCache::Rows { { queryScalar("SELECT COUNT(*) FROM " + tableName).value_or("0") } };
+    });
+    return std::stoull(rows->front().front());
+}
+
+std::uint64_t MySQLDatabaseConnection::estimateDistinctCount(const std::string& tableName, const std::string& columnName)
+{
+    const auto rows = statistic("distinct", tableName, columnName, [this, &tableName, &columnName]() {
+        const std::uint64_t total = estimateRowCount(tableName);
+        const double fraction = Abstracts::StatisticsEstimator::sampleFraction(m_mysqlData.statistics.sampleRows, total);
+        // The scan still reads every row, but only the sample is sent and nothing is sorted
+        std::string sql = "SELECT " + columnName + " FROM " + tableName;
+        if (fraction < 1.0) {
+            sql += " WHERE RAND() < " + std::to_string(fraction);
+        }
+
+        const auto result = queryResult(sql);
+        Abstracts::HyperLogLog sketch;
+        std::uint64_t values = 0;
+        for (std::size_t row = 0; row < result->rowCount(); ++row) {
+            if (!result->isNull(row, 0)) {
+                sketch.add(result->value(row, 0));
+                ++values;
+            }
+        }
+        if (fraction >= 1.0 || result->rowCount() == 0) {
+            return Abstracts::QueryCache::Rows { { std::to_string(std::llround(sketch.estimate())) } };
+        }
+        const auto nonNull = static_cast<std::uint64_t>(static_cast<double>(total) * static_cast<double>(values)
+                                                        / static_cast<double>(result->rowCount()));
+        const auto distinct = Abstracts::StatisticsEstimator::scaleDistinct(sketch.estimate(), values, nonNull, sketch.standardError());
+        return Abstracts::QueryCache::Rows { { std::to_string(distinct) } };
+    });
+    return std::stoull(rows->front().front());
+}
+
+Abstracts::QueryCache::RowsPtr MySQLDatabaseConnection::statistic(std::string_view name,
+                                                                  const std::string& tableName,
+                                                                  const std::string& columnName,
+                                                                  const Abstracts::StatisticsEstimator::Compute& compute)
+{
+    // A transaction reads its own writes, which the cache must neither serve nor keep
+    if (m_mysqlData.statistics.mode != Abstracts::StatisticsMode::Fast || m_transactions.current()) {
+        return std::make_shared<const Abstracts::QueryCache::Rows>(compute());
     }
+    return Abstracts::StatisticsEstimator::cached(*queryCache(), m_mysqlData.statistics, name, tableName, columnName, compute);
+}
 
-    std::string sql = "SELECT DISTINCT " + columnName + " FROM " + tableName;
-    std::vector<std::vector<std::string>> result = querySync(sql);
-    for (const std::vector<std::string>& row : result) {
-        if (!row.empty()) {
-            distinctValues.push_back(row[0]);
+std::optional<std::string> MySQLDatabaseConnection::queryScalar(const std::string& sql, const std::vector<std::string>& params)
+{
+    if (params.empty()) {
+        const auto result = queryResult(sql);
+        if (result->rowCount() == 0 || result->columnCount() == 0 || result->isNull(0, 0)) {
+            return std::nullopt;
         }
+        return std::string(result->value(0, 0));
     }
 
-    return distinctValues;
+    // Get a connection from a replica, the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    MySqlConnectionPool* pool = nullptr;
+    MySqlPtr mysqlConnection = acquireReadConnection(sql, lease, pool);
+    std::vector<std::vector<std::string>> rows;
+    try {
+        rows = fetchStatementRows(executeCached(*pool, mysqlConnection, sql, params));
+    } catch (const std::exception&) {
+        discardIfLost(lease, mysqlConnection);
+        throw;
+    }
+    if (rows.empty() || rows[0].empty() || rows[0][0] == "NULL") {
+        return std::nullopt;
+    }
+    return rows[0][0];
 }
 
 bool MySQLDatabaseConnection::executeScriptFromFile(const std::string& filename)
@@ -1950,26 +2061,44 @@ bool MySQLDatabaseConnection::executeScriptFromFile(const std::string& filename)
     auto& engine = engineController.getEngine();
     auto language = createLanguageObject()->getLanguageCode();
     if (!isConnected()) {
-        m_mysqlData.lastError = safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
-                                                    engine.meta()->returnView(MYSQL_CONSTANTS::DRIVER_NAME));
+        setLastError(safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
+                                         engine.meta()->returnView(MYSQL_CONSTANTS::DRIVER_NAME)));
         return false;
     }
 
-    std::ifstream file(filename);
+    std::ifstream file(filename, std::ios::binary);
     if (!file.is_open()) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "failed_to_open_script_file") + filename;
+        setLastError(safeTranslate(language, "exceptions", "failed_to_open_script_file") + filename);
         return false;
     }
 
-    std::string line;
-    std::string script;
-    while (std::getline(file, line)) {
-        script += line + __cell_newline;
+    // One connection for the whole script, so its SET and START TRANSACTION apply to the statements that follow
+    Abstracts::ConnectionLease lease;
+    MySqlPtr mysqlConnection = acquireConnection(lease);
+    Abstracts::SqlScriptReader reader(file, mySqlScript);
+    bool succeeded = true;
+    try {
+        while (const auto statement = reader.next()) {
+            try {
+                executeOnMySql(mysqlConnection, *statement);
+            } catch (const std::exception& e) {
+                throw Exception(Exception::Reason::Database, filename + ":" + std::to_string(reader.line()) + ": " + e.what()).getRuntimeError();
+            }
+        }
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        succeeded = false;
     }
 
-    file.close();
+    // A transaction the script left open must not reach the next borrower
+    if (lease && (mysqlConnection->server_status & SERVER_STATUS_IN_TRANS)) {
+        lease.discard();
+    }
 
-    return executeSync(script);
+    // The script may have written to or changed any table
+    recordWrite(std::nullopt);
+    recordSchemaChange();
+    return succeeded;
 }
 
 bool MySQLDatabaseConnection::backupDatabase(const std::string& backupFilename)
@@ -2000,7 +2129,8 @@ bool MySQLDatabaseConnection::restoreDatabase(const std::string& backupFilename)
 
     // Check the result of the command execution
     if (result == 0) {
-        // Restoration successful
+        // Restoration successful; any table may have changed
+        recordWrite(std::nullopt);
         return true;
     } else {
         // Restoration failed
@@ -2016,8 +2146,8 @@ std::vector<std::string> MySQLDatabaseConnection::getDatabaseList()
     std::vector<std::string> databaseList;
 
     if (!isConnected()) {
-        m_mysqlData.lastError = safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
-                                                    engine.meta()->returnView(MYSQL_CONSTANTS::DRIVER_NAME));
+        setLastError(safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
+                                         engine.meta()->returnView(MYSQL_CONSTANTS::DRIVER_NAME)));
         return databaseList;
     }
 
@@ -2037,8 +2167,8 @@ bool MySQLDatabaseConnection::createDatabase(const std::string& databaseName)
     auto& engine = engineController.getEngine();
     auto language = createLanguageObject()->getLanguageCode();
     if (!isConnected()) {
-        m_mysqlData.lastError = safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
-                                                    engine.meta()->returnView(MYSQL_CONSTANTS::DRIVER_NAME));
+        setLastError(safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
+                                         engine.meta()->returnView(MYSQL_CONSTANTS::DRIVER_NAME)));
         return false;
     }
     std::string sql = engine.meta()->returnView(MYSQL_CONSTANTS::CREATE_DATABASE) + FROM_CELL_STRING(__cell_space) + databaseName;
@@ -2050,8 +2180,8 @@ bool MySQLDatabaseConnection::dropDatabase(const std::string& databaseName)
     auto& engine = engineController.getEngine();
     auto language = createLanguageObject()->getLanguageCode();
     if (!isConnected()) {
-        m_mysqlData.lastError = safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
-                                                    engine.meta()->returnView(MYSQL_CONSTANTS::DRIVER_NAME));
+        setLastError(safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
+                                         engine.meta()->returnView(MYSQL_CONSTANTS::DRIVER_NAME)));
         return false;
     }
 
@@ -2065,8 +2195,8 @@ bool MySQLDatabaseConnection::grantPrivileges(const std::string& username, const
     auto& engine = engineController.getEngine();
     auto language = createLanguageObject()->getLanguageCode();
     if (!isConnected()) {
-        m_mysqlData.lastError = safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
-                                                    engine.meta()->returnView(MYSQL_CONSTANTS::DRIVER_NAME));
+        setLastError(safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
+                                         engine.meta()->returnView(MYSQL_CONSTANTS::DRIVER_NAME)));
         return false;
     }
 
@@ -2085,8 +2215,8 @@ bool MySQLDatabaseConnection::revokePrivileges(const std::string& username, cons
     auto& engine = engineController.getEngine();
     auto language = createLanguageObject()->getLanguageCode();
     if (!isConnected()) {
-        m_mysqlData.lastError = safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
-                                                    engine.meta()->returnView(MYSQL_CONSTANTS::DRIVER_NAME));
+        setLastError(safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
+                                         engine.meta()->returnView(MYSQL_CONSTANTS::DRIVER_NAME)));
         return false;
     }
 
@@ -2106,18 +2236,13 @@ int MySQLDatabaseConnection::getTableSize(const std::string& tableName)
     auto& engine = engineController.getEngine();
     auto language = createLanguageObject()->getLanguageCode();
     if (!isConnected()) {
-        m_mysqlData.lastError = safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
-                                                    engine.meta()->returnView(MYSQL_CONSTANTS::DRIVER_NAME));
+        setLastError(safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
+                                         engine.meta()->returnView(MYSQL_CONSTANTS::DRIVER_NAME)));
         return -1;
     }
 
-    std::string sql = "SELECT COUNT(*) FROM " + tableName;
-    std::vector<std::vector<std::string>> result = querySync(sql);
-    if (!result.empty() && !result[0].empty()) {
-        return std::stoi(result[0][0]);
-    }
-
-    return -1;
+    // The size is the row count here, so it follows the statistics mode as getRowCount() does
+    return getRowCount(tableName);
 }
 
 void MySQLDatabaseConnection::executeNonQuery(const std::string& sql)
@@ -2125,8 +2250,8 @@ void MySQLDatabaseConnection::executeNonQuery(const std::string& sql)
     auto& engine = engineController.getEngine();
     auto language = createLanguageObject()->getLanguageCode();
     if (!isConnected()) {
-        m_mysqlData.lastError = safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
-                                                    engine.meta()->returnView(MYSQL_CONSTANTS::DRIVER_NAME));
+        setLastError(safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
+                                         engine.meta()->returnView(MYSQL_CONSTANTS::DRIVER_NAME)));
         return;
     }
 
@@ -2138,13 +2263,36 @@ void MySQLDatabaseConnection::importTable(const std::string& tableName, const st
     auto& engine = engineController.getEngine();
     auto language = createLanguageObject()->getLanguageCode();
     if (!isConnected()) {
-        m_mysqlData.lastError = safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
-                                                    engine.meta()->returnView(MYSQL_CONSTANTS::DRIVER_NAME));
+        setLastError(safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
+                                         engine.meta()->returnView(MYSQL_CONSTANTS::DRIVER_NAME)));
         return;
     }
 
-    std::string sql = "LOAD DATA INFILE '" + filePath + "' INTO TABLE " + tableName;
-    executeSync(sql);
+    LocalInfile infile { .path = filePath, .file = std::ifstream(filePath, std::ios::binary) };
+    if (!infile.file) {
+        setLastError("Cannot open " + filePath + " for reading.");
+        return;
+    }
+
+    // Get a connection from the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    MySqlPtr mysqlConnection = acquireConnection(lease);
+
+    // The client streams the file, so it need not be on the server and no FILE privilege is required
+    std::string escapedPath(filePath.size() * 2 + 1, __cell_null_character);
+    escapedPath.resize(mysql_real_escape_string(mysqlConnection, escapedPath.data(), filePath.data(), filePath.size()));
+    const std::string sql = "LOAD DATA LOCAL INFILE '" + escapedPath + "' INTO TABLE " + tableName;
+
+    serveLocalInfile(mysqlConnection, infile);
+    try {
+        executeOnMySql(mysqlConnection, sql);
+        MySqlConnectionPool::refuseLocalInfile(mysqlConnection);
+        recordWrite(std::vector<std::string> { tableName });
+    } catch (const std::exception& e) {
+        MySqlConnectionPool::refuseLocalInfile(mysqlConnection);
+        setLastError(e.what());
+        discardIfLost(lease, mysqlConnection);
+    }
 }
 
 void MySQLDatabaseConnection::exportTable(const std::string& tableName, const std::string& filePath)
@@ -2152,13 +2300,48 @@ void MySQLDatabaseConnection::exportTable(const std::string& tableName, const st
     auto& engine = engineController.getEngine();
     auto language = createLanguageObject()->getLanguageCode();
     if (!isConnected()) {
-        m_mysqlData.lastError = safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
-                                                    engine.meta()->returnView(MYSQL_CONSTANTS::DRIVER_NAME));
+        setLastError(safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
+                                         engine.meta()->returnView(MYSQL_CONSTANTS::DRIVER_NAME)));
         return;
     }
 
-    std::string sql = "SELECT * INTO OUTFILE '" + filePath + "' FROM " + tableName;
-    executeSync(sql);
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        setLastError("Cannot open " + filePath + " for writing.");
+        return;
+    }
+
+    // Rows are streamed into a file on the client, in the format importTable() reads back
+    try {
+        std::string buffer;
+        buffer.reserve(exportBufferBytes);
+        auto cursor = openCursor(engine.meta()->returnView(MYSQL_CONSTANTS::SELECT) + " * FROM " + tableName);
+        cursor->forEach([&](const Abstracts::ResultRow row) {
+            for (std::size_t column = 0; column < row.size(); ++column) {
+                if (column > 0) {
+                    buffer += '\t';
+                }
+                if (row.isNull(column)) {
+                    buffer += "\\N";
+                } else {
+                    appendLoadDataEscaped(buffer, row[column]);
+                }
+            }
+            buffer += '\n';
+            if (buffer.size() >= exportBufferBytes) {
+                file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                buffer.clear();
+            }
+        });
+        file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return;
+    }
+
+    if (!file.flush()) {
+        setLastError("Cannot write " + filePath + ".");
+    }
 }
 
 bool MySQLDatabaseConnection::validateSqlQuery(const std::string& query)
@@ -2167,7 +2350,7 @@ bool MySQLDatabaseConnection::validateSqlQuery(const std::string& query)
     auto language = createLanguageObject()->getLanguageCode();
     // Check if the query is empty
     if (query.empty()) {        
-        m_mysqlData.lastError = "SQL query is empty.";
+        setLastError("SQL query is empty.");
         return false;
     }
 
@@ -2177,7 +2360,7 @@ bool MySQLDatabaseConnection::validateSqlQuery(const std::string& query)
     std::transform(upperQuery.begin(), upperQuery.end(), upperQuery.begin(), ::toupper);
     if (upperQuery.find("DROP") != std::string::npos || upperQuery.find("DELETE") != std::string::npos || upperQuery.find("TRUNCATE") != std::string::npos)
     {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "invalid_sql_query_harmful");
+        setLastError(safeTranslate(language, "exceptions", "invalid_sql_query_harmful"));
         return false;
     }
 
@@ -2194,7 +2377,7 @@ bool MySQLDatabaseConnection::validateParams(const std::vector<std::string>& par
 
     // Check if the parameters vector is empty
     if (params.empty()) {
-        m_mysqlData.lastError = safeTranslate(language, "exceptions", "query_parameters_are_empty");
+        setLastError(safeTranslate(language, "exceptions", "query_parameters_are_empty"));
         return false;
     }
 
@@ -2202,7 +2385,7 @@ bool MySQLDatabaseConnection::validateParams(const std::vector<std::string>& par
     for (const std::string& param : params) {
         // Check if a parameter is empty
         if (param.empty()) {
-            m_mysqlData.lastError = safeTranslate(language, "exceptions", "empty_query_parameter_detected");
+            setLastError(safeTranslate(language, "exceptions", "empty_query_parameter_detected"));
             return false;
         }
 
@@ -41,6 +41,18 @@
 #   error "Cell's "mysqlconnectionpool.hpp" was not found!"
 #endif
 
+#if __has_include("mysqlresultset.hpp")
+#   include "mysqlresultset.hpp"
+#else
+#   error "Cell's "mysqlresultset.hpp" was not found!"
+#endif
+
+#if __has_include("mysqlcursor.hpp")
+#   include "mysqlcursor.hpp"
+#else
+#   error "Cell's "mysqlcursor.hpp" was not found!"
+#endif
+
 CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Database)
 
 /**
@@ -197,6 +209,10 @@ public:
     /**
      * @brief Begins a transaction.
      *
+     * The transaction is pinned to one pooled connection until commitTransaction() or rollbackTransaction()
+     * from the same thread; the statements that thread issues in between run on that connection, while other
+     * threads keep using the pool.
+     *
      * @return True if the transaction is successfully started, false otherwise.
      */
     bool beginTransaction() __cell_override;
@@ -215,6 +231,38 @@ public:
      */
     bool rollbackTransaction() __cell_override;
 
+    /**
+     * @brief Leases a connection from the pool for the current scope.
+     *
+     * @return A lease that returns the connection to the pool when it is destroyed.
+     */
+    Abstracts::ConnectionLease leaseConnection();
+
+    /**
+     * @brief Opens a transaction pinned to a single pooled connection.
+     *
+     * The transaction is rolled back automatically unless it is committed before it goes out of scope.
+     *
+     * @param options The isolation level and access mode.
+     * @return The open transaction.
+     */
+    Abstracts::Transaction transaction(const Abstracts::TransactionOptions& options = {});
+
+    /**
+     * @brief Runs a transaction body and commits it, retrying the whole transaction on serialization failures and deadlocks.
+     *
+     * @param body Receives the Abstracts::Transaction; its return value is returned.
+     * @param options The isolation level and access mode.
+     * @param maxAttempts The number of attempts before the failure is rethrown.
+     */
+    template <typename Body>
+    auto runTransaction(Body&& body,
+                        const Abstracts::TransactionOptions& options = {},
+                        Types::uint maxAttempts = Abstracts::TRANSACTION_CONSTANTS::DEFAULT_MAX_ATTEMPTS)
+    {
+        return Abstracts::retryTransaction([&] { return transaction(options); }, std::forward<Body>(body), maxAttempts);
+    }
+
     /**
      * @brief Executes an SQL query synchronously.
      *
@@ -297,6 +345,33 @@ public:
      */
     std::future<std::vector<std::vector<std::string>>> queryAsync(const std::string& sql) __cell_override;
 
+    /**
+     * @brief Executes an SQL query and returns a result set that reads the values in place.
+     *
+     * Unlike querySync(), no value is copied.
+     *
+     * @param sql The SQL query to execute.
+     * @return The result set.
+     * @throws std::runtime_error If the query fails.
+     */
+    Abstracts::ResultSetPtr queryResult(const std::string& sql);
+
+    /**
+     * @brief Executes queryResult() asynchronously; the result set is moved, not copied, into the future.
+     */
+    std::future<Abstracts::ResultSetPtr> queryResultAsync(const std::string& sql);
+
+    /**
+     * @brief Opens a cursor that streams the result of a query row by row, with constant memory.
+     *
+     * The cursor keeps its connection (or the one pinned by beginTransaction()) until it is exhausted or closed.
+     *
+     * @param sql The query to stream.
+     * @return The open cursor.
+     * @throws std::runtime_error If the query cannot be started.
+     */
+    Abstracts::CursorPtr openCursor(const std::string& sql);
+
     /**
      * @brief Executes an SQL query with parameters synchronously and returns the result as a 2D vector of strings.
      *
@@ -315,6 +390,52 @@ public:
      */
     std::future<std::vector<std::vector<std::string>>> queryWithParamsAsync(const std::string& sql, const std::vector<std::string>& params) __cell_override;
 
+    /**
+     * @brief Executes an SQL query through the query cache.
+     *
+     * Only queries made through this method are cached. Inside a transaction the cache is bypassed so
+     * the transaction's own writes are seen. Misses are loaded from the primary, never a replica, so a
+     * lagging replica's rows are not cached as fresh.
+     *
+     * @param sql The SQL query, with placeholders if params is not empty.
+     * @param params The parameters to be bound to the query.
+     * @param options The lifetime of the result and the tables it depends on.
+     * @return A 2D vector of strings representing the result of the query.
+     */
+    std::vector<std::vector<std::string>> queryCached(const std::string& sql,
+                                                      const std::vector<std::string>& params = {},
+                                                      const Abstracts::QueryCacheOptions& options = {}) __cell_override;
+
+    /**
+     * @brief Uses a query cache, e.g. one shared with other connections and drivers.
+     *
+     * @param cache The cache to use from now on.
+     */
+    void setQueryCache(std::shared_ptr<Abstracts::QueryCache> cache) __cell_override;
+
+    /**
+     * @brief Returns the query cache used by this connection.
+     */
+    std::shared_ptr<Abstracts::QueryCache> queryCache() const __cell_override;
+
+    /**
+     * @brief Sends reads to replica pools from now on.
+     *
+     * Statements that cannot write go to a healthy replica when the session has not written within
+     * the stickiness window and no transaction is open; everything else uses the pool this connection
+     * was constructed with. Call it before the connection is shared between threads.
+     *
+     * @param replicas The pools of the replicas, which must outlive this connection; empty to stop routing.
+     * @param options The selection policy, lag limit, stickiness window and probe interval.
+     */
+    void setReplicas(const std::vector<std::reference_wrapper<MySqlConnectionPool>>& replicas,
+                     const Abstracts::ReplicaRoutingOptions& options = {});
+
+    /**
+     * @brief Returns the last measurement of every replica given to setReplicas().
+     */
+    std::vector<Abstracts::ReplicaStatus> replicaStatus() const;
+
     /**
      * @brief Executes an SQL query with parameters synchronously.
      *
@@ -392,6 +513,14 @@ public:
      */
     void setConnectionTimeout(int timeoutSeconds) __cell_override;
 
+    /**
+     * @brief Returns the schema catalog of the connection pool, reloading it after a schema change.
+     *
+     * The catalog is read from INFORMATION_SCHEMA with one statement over a connection of its own, and
+     * covers the tables of the current database.
+     */
+    Abstracts::SchemaSnapshotPtr schema() __cell_override;
+
     /**
      * @brief Retrieves the names of all tables in the database.
      *
@@ -554,6 +683,9 @@ public:
     /**
      * @brief Performs a bulk insert of data into a table.
      *
+     * The rows are escaped on the connection and sent as multi-row INSERTs of bounded size, all in one
+     * transaction unless a transaction is already open.
+     *
      * @param tableName The name of the table.
      * @param data A vector of vectors representing the data rows to insert.
      * @return True if the bulk insert is successful, false otherwise.
@@ -599,9 +731,26 @@ public:
      */
     std::vector<std::vector<std::string>> queryWithPagination(const std::string& sql, int pageNumber, int pageSize) __cell_override;
 
+    /**
+     * @brief Retrieves query results page by page by seeking past the ordering key of the previous page.
+     *
+     * @param sql The SQL query, without ORDER BY or LIMIT.
+     * @param ordering The key columns, most significant first.
+     * @param pageSize The number of rows of a page.
+     * @param continuation The token of the previous page; empty for the first page.
+     * @return The rows of the page, without a header, and the token of the next one.
+     */
+    Abstracts::KeysetPage queryWithKeyset(const std::string& sql,
+                                          const std::vector<Abstracts::KeysetColumn>& ordering,
+                                          std::size_t pageSize,
+                                          const std::string& continuation = {}) __cell_override;
+
     /**
      * @brief Retrieves the number of rows in a table.
      *
+     * In the fast statistics mode this is estimateRowCount(); the aggregates below likewise follow
+     * setStatisticsOptions().
+     *
      * @param tableName The name of the table.
      * @return The total number of rows in the table.
      */
@@ -652,9 +801,58 @@ public:
      */
     std::vector<std::string> getDistinctValues(const std::string& tableName, const std::string& columnName) __cell_override;
 
+    /**
+     * @brief Chooses how the aggregate methods answer from now on.
+     *
+     * The exact mode is the default. In the fast mode row counts come from information_schema.TABLES,
+     * MIN and MAX read one end of an index on the column when there is one, and every result is kept in
+     * the query cache for the configured lifetime. AVG and SUM stay exact, since MySQL has no sampling
+     * that avoids a full scan, but are cached too. Call it before the connection is shared between threads.
+     *
+     * @param options The mode, the lifetime of cached statistics and the sample size.
+     */
+    void setStatisticsOptions(const Abstracts::StatisticsOptions& options);
+
+    /**
+     * @brief Returns the statistics settings of this connection.
+     */
+    Abstracts::StatisticsOptions statisticsOptions() const;
+
+    /**
+     * @brief Estimates the number of rows in a table from information_schema.TABLES.
+     *
+     * InnoDB's TABLE_ROWS comes from sampled index statistics and may be off by tens of percent; the
+     * server itself caches it for information_schema_stats_expiry seconds. A view, which has no
+     * estimate, is counted exactly.
+     *
+     * @param tableName The table, as `table` or `database.table`.
+     * @return The estimated number of rows.
+     * @throws std::runtime_error If the table does not exist or a query fails.
+     */
+    std::uint64_t estimateRowCount(const std::string& tableName);
+
+    /**
+     * @brief Estimates the number of distinct non-NULL values of a column.
+     *
+     * About the configured number of rows, picked with RAND(), are streamed through a HyperLogLog
+     * sketch and scaled to the whole table; see Abstracts::StatisticsEstimator. Tables no larger than
+     * the sample are read whole.
+     *
+     * @param tableName The table.
+     * @param columnName The column.
+     * @return The estimated number of distinct values.
+     * @throws std::runtime_error If a query fails.
+     */
+    std::uint64_t estimateDistinctCount(const std::string& tableName, const std::string& columnName);
+
     /**
      * @brief Executes a script by reading and executing SQL statements from a file.
      *
+     * The file is read while it runs: each statement is sent as soon as its terminator is read, on one
+     * connection, so session settings and transactions in the script carry over to its later statements.
+     * The first failing statement stops the script, and the last error names its line. A transaction the
+     * script leaves open is rolled back. DELIMITER commands are not supported.
+     *
      * @param filename The name of the file containing the SQL script.
      * @return True if the script execution is successful, false otherwise.
      */
@@ -723,7 +921,7 @@ public:
      * @brief Retrieves the size of a table in the database.
      *
      * @param tableName The name of the table.
-     * @return The size of the table in bytes.
+     * @return The number of rows of the table, the estimate of it in the fast statistics mode, or -1 on failure.
      */
     int getTableSize(const std::string& tableName) __cell_override;
 
@@ -737,6 +935,9 @@ public:
     /**
      * @brief Imports data into a table from a file.
      *
+     * The file is read on the client with LOAD DATA LOCAL INFILE, in the default tab separated format,
+     * so it need not be on the server. The server must allow it (local_infile=ON).
+     *
      * @param tableName The name of the table.
      * @param filePath The path to the file containing the data to import.
      */
@@ -745,6 +946,8 @@ public:
     /**
      * @brief Exports data from a table to a file.
      *
+     * The rows are streamed into a file on the client, in the format importTable() reads back.
+     *
      * @param tableName The name of the table.
      * @param filePath The path to the file where the data will be exported.
      */
@@ -759,6 +962,76 @@ public:
 
 
 private:
+    /**
+     * @brief Records the error returned by getLastError(); safe to call from std::async threads.
+     */
+    void setLastError(std::string error);
+
+    /**
+     * @brief Returns the connection pinned by beginTransaction(), or leases one from the pool.
+     *
+     * @param lease Receives the lease when no transaction is pinned.
+     */
+    Types::MySqlPtr acquireConnection(Abstracts::ConnectionLease& lease);
+
+    /**
+     * @brief Returns the current replica router, or nullptr without replicas.
+     */
+    std::shared_ptr<Abstracts::PoolRouter> replicaRouter() const;
+
+    /**
+     * @brief Returns a connection for a read, from a replica when the statement and the session allow it.
+     *
+     * @param sql The statement to be run.
+     * @param lease Receives the lease when no transaction is pinned.
+     * @param pool Receives the pool the connection belongs to.
+     * @param allowReplica False to read from the primary whatever the statement.
+     */
+    Types::MySqlPtr acquireReadConnection(const std::string& sql, Abstracts::ConnectionLease& lease, MySqlConnectionPool*& pool,
+                                          bool allowReplica = true);
+
+    /**
+     * @brief Runs queryResult(), optionally keeping the read off the replicas.
+     */
+    Abstracts::ResultSetPtr readResult(const std::string& sql, bool allowReplica);
+
+    /**
+     * @brief Notes a write made through this connection.
+     *
+     * The cached results that depend on the tables are dropped, and reads stay on the primary for the
+     * stickiness window. Inside a transaction the tables are remembered and invalidated when it
+     * commits, since other sessions only see the write from then on.
+     *
+     * @param tables The tables written, or std::nullopt if they cannot be told.
+     */
+    void recordWrite(const std::optional<std::vector<std::string>>& tables);
+
+    /**
+     * @brief Notes a schema change made through this connection by invalidating the pool's schema catalog.
+     */
+    void recordSchemaChange();
+
+    /**
+     * @brief Returns a statistic, from the query cache in the fast statistics mode.
+     *
+     * Outside the fast mode, and inside a transaction, it is computed every time.
+     */
+    Abstracts::QueryCache::RowsPtr statistic(std::string_view name,
+                                             const std::string& tableName,
+                                             const std::string& columnName,
+                                             const Abstracts::StatisticsEstimator::Compute& compute);
+
+    /**
+     * @brief Executes a query expected to return at most one value.
+     *
+     * With parameters the query runs as a prepared statement, whose rows spell NULL as the text "NULL";
+     * that text then reads as std::nullopt too.
+     *
+     * @return The value, or std::nullopt if there is no row or it is NULL.
+     * @throws std::runtime_error If the query fails.
+     */
+    std::optional<std::string> queryScalar(const std::string& sql, const std::vector<std::string>& params = {});
+
     /**
      * @brief Validates the syntax of an SQL query.
      *
@@ -782,6 +1055,10 @@ private:
     MySqlPtr             connection;        //!< Pointer to the MySQL connection object.
     MYSQL_RES*           m_result;          //!< Pointer to the MySQL result set.
     MySqlConnectionPool& connectionPool;    //!< Reference to the MySQL connection pool.
+    Abstracts::PinnedTransactions m_transactions;        //!< Transactions opened by beginTransaction(), per calling thread.
+    std::shared_ptr<Abstracts::PoolRouter> m_router;     //!< Sends reads to replicas; empty without replicas.
+    mutable Types::Mutex     m_routerMutex;      //!< Guards m_router; readers take a copy.
+    std::atomic<std::chrono::steady_clock::time_point> m_lastWriteAt {}; //!< Last write of this session, for read-your-writes.
 };
 
 CELL_NAMESPACE_END
@@ -37,80 +37,124 @@ MySqlConnectionPool::MySqlConnectionPool(const std::string& host,
 
 MySqlConnectionPool::~MySqlConnectionPool()
 {
-    for (SqlConnection connection : m_poolData.connections)
-    {
-        if (std::holds_alternative<MySqlPtr>(connection)) {
-            MySqlPtr mysqlConnection = std::get<MySqlPtr>(connection);
-            mysql_close(mysqlConnection);
-        }
-    }
+    shutdown();
 }
 
-void MySqlConnectionPool::initialize()
+SqlConnection MySqlConnectionPool::openConnection()
 {
-    for (int i = 0; i < m_poolData.poolSize; ++i) {
-        MySqlPtr connection = mysql_init(__cell_nullptr);
-        if (connection != __cell_nullptr
-            && mysql_real_connect(connection,
-                                  m_poolData.host.value().c_str(),
-                                  m_poolData.user.value().c_str(),
-                                  m_poolData.password.value().c_str(),
-                                  m_poolData.database.value().c_str(),
-                                  m_poolData.port, __cell_nullptr, 0) != __cell_nullptr)
-        {
-            // Configure SSL/TLS if necessary
-            if (m_poolData.keyPath.has_value() && m_poolData.certPath.has_value() && m_poolData.caPath.has_value())
-            {
-                if (mysql_ssl_set(connection, m_poolData.keyPath.value().c_str(), m_poolData.certPath.value().c_str(), m_poolData.caPath.value().c_str(), __cell_nullptr, __cell_nullptr) != 0)
-                {
-                    // Handle SSL/TLS configuration error
-                    throw Exception(Exception::Reason::Database, "SSL/TLS configuration error occurred.").getRuntimeError();
-                    mysql_close(connection);
-                    continue;  // Skip this connection and proceed with the next one
-                }
-            }
-
-            std::lock_guard<std::mutex> lock(m_poolData.mutex);
-            m_poolData.connections.push_back(connection);
-        } else {
-            // Failed to create or connect to a MySQL connection
-            // Handle the error or log the failure
-            throw Exception(Exception::Reason::Database, "Failed to create or connect to a MySQL connection.").getRuntimeError();
-            if (connection != __cell_nullptr) {
-                mysql_close(connection);
-            }
+    MySqlPtr connection = mysql_init(__cell_nullptr);
+    if (connection == __cell_nullptr) {
+        throw Exception(Exception::Reason::Database, "Failed to initialize 'MySQL' connection.").getRuntimeError();
+    }
+
+    // SSL/TLS has to be configured before the connection is established
+    if (m_poolData.keyPath.has_value() && m_poolData.certPath.has_value() && m_poolData.caPath.has_value()) {
+        if (mysql_ssl_set(connection, m_poolData.keyPath.value().c_str(), m_poolData.certPath.value().c_str(), m_poolData.caPath.value().c_str(), __cell_nullptr, __cell_nullptr) != 0) {
+            mysql_close(connection);
+            throw Exception(Exception::Reason::Database, "SSL/TLS configuration error occurred.").getRuntimeError();
         }
     }
+
+    // The capability is negotiated at connect time; refuseLocalInfile() keeps it closed until an import opens it
+    const unsigned int localInfile = 1;
+    mysql_options(connection, MYSQL_OPT_LOCAL_INFILE, &localInfile);
+    refuseLocalInfile(connection);
+
+    if (mysql_real_connect(connection,
+                           m_poolData.host.value().c_str(),
+                           m_poolData.user.value().c_str(),
+                           m_poolData.password.value().c_str(),
+                           m_poolData.database.value().c_str(),
+                           m_poolData.port, __cell_nullptr, 0) == __cell_nullptr) {
+        const std::string message = mysql_error(connection);
+        mysql_close(connection);
+        throw Exception(Exception::Reason::Database, "Failed to create or connect to a MySQL connection: " + message).getRuntimeError();
+    }
+    return connection;
 }
 
-bool MySqlConnectionPool::isInitialized() const
+bool MySqlConnectionPool::pingConnection(const SqlConnection& connection)
 {
-    return !m_poolData.connections.empty();
+    return mysql_ping(std::get<MySqlPtr>(connection)) == 0;
 }
 
-SqlConnection MySqlConnectionPool::getConnection()
+std::optional<std::chrono::milliseconds> MySqlConnectionPool::replicationLag(const SqlConnection& connection)
 {
-    // Wait until a connection becomes available
-    std::unique_lock<std::mutex> lock(m_poolData.mutex);
-    while (m_poolData.connections.empty()) {
-        m_poolData.condition.wait(lock);
+    MySqlPtr mysqlConnection = std::get<MySqlPtr>(connection);
+
+    // MySQL before 8.0.22 and MariaDB before 10.5 only know the older spelling
+    const std::string replicaStatus = "SHOW REPLICA STATUS";
+    const std::string slaveStatus = "SHOW SLAVE STATUS";
+    if (mysql_real_query(mysqlConnection, replicaStatus.c_str(), replicaStatus.length()) != 0
+        && mysql_real_query(mysqlConnection, slaveStatus.c_str(), slaveStatus.length()) != 0) {
+        throw Exception(Exception::Reason::Database, mysql_error(mysqlConnection)).getRuntimeError();
+    }
+    std::unique_ptr<MYSQL_RES, decltype(&mysql_free_result)> result(mysql_store_result(mysqlConnection), &mysql_free_result);
+    if (!result) {
+        throw Exception(Exception::Reason::Database, mysql_error(mysqlConnection)).getRuntimeError();
     }
 
-    // Retrieve a connection from the pool
-    SqlConnection connection = m_poolData.connections.front();
-    m_poolData.connections.pop_front();
-    return connection;
+    MYSQL_ROW row = mysql_fetch_row(result.get());
+    if (!row) {
+        return std::chrono::milliseconds::zero();
+    }
+    const unsigned int count = mysql_num_fields(result.get());
+    const MYSQL_FIELD* fields = mysql_fetch_fields(result.get());
+    for (unsigned int i = 0; i < count; ++i) {
+        const std::string_view name = fields[i].name;
+        if (name != "Seconds_Behind_Source" && name != "Seconds_Behind_Master") {
+            continue;
+        }
+        // NULL while the replication threads are stopped
+        if (!row[i]) {
+            return std::nullopt;
+        }
+        const std::string_view value = row[i];
+        std::int64_t seconds {};
+        std::from_chars(value.data(), value.data() + value.size(), seconds);
+        return std::chrono::seconds(seconds);
+    }
+    return std::nullopt;
+}
+
+void MySqlConnectionPool::closeConnection(const SqlConnection& connection)
+{
+    if (MySqlPtr mysqlConnection = std::get<MySqlPtr>(connection)) {
+        // Statement handles are client-side allocations and must be closed before the connection
+        m_statementCaches.remove(mysqlConnection, true);
+        mysql_close(mysqlConnection);
+    }
+}
+
+Abstracts::StatementCache<MYSQL_STMT*>& MySqlConnectionPool::statementCache(MySqlPtr connection)
+{
+    return m_statementCaches.cacheFor(connection, [](MYSQL_STMT*& statement) {
+        mysql_stmt_close(statement);
+    });
 }
 
-void MySqlConnectionPool::releaseConnection(SqlConnection connection)
+void MySqlConnectionPool::setStatementCacheCapacity(std::size_t capacity)
 {
-    std::lock_guard<std::mutex> lock(m_poolData.mutex);
+    m_statementCaches.setCapacity(capacity);
+}
 
-    // Add the connection back to the pool
-    m_poolData.connections.push_back(connection);
+Abstracts::StatementCacheStatistics MySqlConnectionPool::statementCacheStatistics() const
+{
+    return m_statementCaches.statistics();
+}
 
-    // Notify a waiting thread about the availability of a connection
-    m_poolData.condition.notify_one();
+void MySqlConnectionPool::refuseLocalInfile(MySqlPtr connection)
+{
+    mysql_set_local_infile_handler(
+        connection,
+        [](void** state, const char*, void*) -> int { *state = __cell_nullptr; return 1; },
+        [](void*, char*, unsigned int) -> int { return -1; },
+        [](void*) {},
+        [](void*, char* message, unsigned int length) -> int {
+            std::snprintf(message, length, "LOAD DATA LOCAL is only served during an import.");
+            return 2000;
+        },
+        __cell_nullptr);
 }
 
 void MySqlConnectionPool::enableEncryption(const std::string& keyPath, const std::string& certPath, const std::string& caPath)
@@ -75,44 +75,70 @@ public:
     CELL_MAKE_FRIEND(MySQLDatabaseConnection)
 
     /**
-     * @brief Initializes the connection pool.
+     * @brief Enables encryption for MySQL connections using the specified key, certificate, and CA paths.
      *
-     * This function initializes the MySQL connection pool by establishing initial connections.
+     * @param keyPath The path to the private key file for encryption.
+     * @param certPath The path to the certificate file for encryption.
+     * @param caPath The path to the CA certificate file for encryption.
      */
-    void initialize() __cell_override;
+    void enableEncryption(const std::string& keyPath, const std::string& certPath, const std::string& caPath) __cell_override;
 
     /**
-     * @brief Checks if the connection pool is initialized.
+     * @brief Returns the prepared statement cache of a pooled connection.
+     *
+     * Only the current holder of the connection may use the returned cache.
      *
-     * @return `true` if the connection pool is initialized, `false` otherwise.
+     * @param connection The connection the statements are prepared on.
      */
-    bool isInitialized() const __cell_override;
+    Abstracts::StatementCache<MYSQL_STMT*>& statementCache(Types::MySqlPtr connection);
 
     /**
-     * @brief Retrieves a MySQL connection from the pool.
+     * @brief Sets how many prepared statements each connection keeps.
      *
-     * @return A SqlConnection object representing a MySQL connection.
+     * @param capacity The maximum number of statements per connection.
+     */
+    void setStatementCacheCapacity(std::size_t capacity);
+
+    /**
+     * @brief Returns the hit, miss, eviction and invalidation counters of the statement caches.
+     */
+    Abstracts::StatementCacheStatistics statementCacheStatistics() const;
+
+    /**
+     * @brief Reads Seconds_Behind_Source of a MySQL or MariaDB replica; a server that is not a replica reports none.
      */
-    Types::SqlConnection getConnection() __cell_override;
+    std::optional<std::chrono::milliseconds> replicationLag(const Types::SqlConnection& connection) __cell_override;
 
     /**
-     * @brief Releases a MySQL connection and returns it to the pool.
+     * @brief Makes a connection refuse the server's requests for client files.
      *
-     * @param connection The SqlConnection object representing the MySQL connection to release.
+     * Pooled connections announce LOAD DATA LOCAL support so importTable() can stream a file, but the
+     * file is only handed out while an import is running; any other request is refused.
+     *
+     * @param connection The connection to protect.
      */
-    void releaseConnection(Types::SqlConnection connection) __cell_override;
+    static void refuseLocalInfile(Types::MySqlPtr connection);
 
+protected:
     /**
-     * @brief Enables encryption for MySQL connections using the specified key, certificate, and CA paths.
+     * @brief Opens a new MySQL connection using the pool settings.
      *
-     * @param keyPath The path to the private key file for encryption.
-     * @param certPath The path to the certificate file for encryption.
-     * @param caPath The path to the CA certificate file for encryption.
+     * @throws std::runtime_error If the connection cannot be established.
      */
-    void enableEncryption(const std::string& keyPath, const std::string& certPath, const std::string& caPath) __cell_override;
+    Types::SqlConnection openConnection() __cell_override;
+
+    /**
+     * @brief Checks a MySQL connection with a round trip to the server.
+     */
+    bool pingConnection(const Types::SqlConnection& connection) __cell_override;
+
+    /**
+     * @brief Closes a MySQL connection.
+     */
+    void closeConnection(const Types::SqlConnection& connection) __cell_override;
 
 private:
-    Abstracts::PoolData m_poolData{}; //!< The pool data used to manage MySQL connections.
+    Abstracts::StatementCacheRegistry<Types::MySqlPtr, MYSQL_STMT*> m_statementCaches {}; //!< Prepared statements per connection.
 };
 
 CELL_NAMESPACE_END
@@ -0,0 +1,142 @@
+#if __has_include("mysqlcursor.hpp")
+#   include "mysqlcursor.hpp"
+#else
+#   error "Cell's "mysqlcursor.hpp" was not found!"
+#endif
+
+#if defined(USE_MYSQL_MARIADB)
+
+#if __has_include("core/core.hpp")
+#   include "core/core.hpp"
+#else
+#   error "Cell's "core/core.hpp" was not found!"
+#endif
+
+CELL_USING_NAMESPACE Cell;
+CELL_USING_NAMESPACE Cell::System;
+CELL_USING_NAMESPACE Cell::Types;
+
+CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Database)
+
+namespace {
+
+/**
+ * @brief Whether the session is gone (CR_SERVER_GONE_ERROR, CR_SERVER_LOST).
+ */
+bool isConnectionLost(MySqlPtr connection)
+{
+    const unsigned int error = mysql_errno(connection);
+    return error == 2006 || error == 2013;
+}
+
+}  // namespace
+
+std::size_t MySqlStreamRow::rowCount() const
+{
+    return m_row ? 1 : 0;
+}
+
+std::size_t MySqlStreamRow::columnCount() const
+{
+    return m_result ? mysql_num_fields(m_result) : 0;
+}
+
+std::string_view MySqlStreamRow::columnName(std::size_t column) const
+{
+    const MYSQL_FIELD& field = mysql_fetch_fields(m_result)[column];
+    return std::string_view(field.name, field.name_length);
+}
+
+bool MySqlStreamRow::isNull(std::size_t, std::size_t column) const
+{
+    return m_row[column] == __cell_nullptr;
+}
+
+std::string_view MySqlStreamRow::value(std::size_t, std::size_t column) const
+{
+    const char* data = m_row[column];
+    return data ? std::string_view(data, m_lengths[column]) : std::string_view();
+}
+
+void MySqlStreamRow::reset(MYSQL_RES* result, MYSQL_ROW row, const ulong* lengths)
+{
+    m_result = result;
+    m_row = row;
+    m_lengths = lengths;
+}
+
+MySqlCursor::MySqlCursor(Abstracts::ConnectionLease lease, MySqlPtr connection, const std::string& sql)
+    : m_lease(std::move(lease))
+    , m_connection(connection)
+{
+    if (mysql_real_query(m_connection, sql.c_str(), sql.length()) != 0) {
+        const std::string message = mysql_error(m_connection);
+        if (m_lease && isConnectionLost(m_connection)) {
+            m_lease.discard();
+        }
+        throw Exception(Exception::Reason::Database, message).getRuntimeError();
+    }
+
+    m_result = mysql_use_result(m_connection);
+    if (!m_result) {
+        const std::string message = mysql_field_count(m_connection) == 0 ? "The statement did not return a result set." : mysql_error(m_connection);
+        throw Exception(Exception::Reason::Database, message).getRuntimeError();
+    }
+}
+
+MySqlCursor::~MySqlCursor()
+{
+    close();
+}
+
+const Abstracts::ResultSet* MySqlCursor::fetch()
+{
+    if (!m_result) {
+        return __cell_nullptr;
+    }
+
+    MYSQL_ROW row = mysql_fetch_row(m_result);
+    if (!row) {
+        // The end of an unbuffered result and a read error look the same; only mysql_errno() tells
+        const std::string message = mysql_errno(m_connection) != 0 ? mysql_error(m_connection) : "";
+        finish(isConnectionLost(m_connection));
+        if (!message.empty()) {
+            throw Exception(Exception::Reason::Database, message).getRuntimeError();
+        }
+        return __cell_nullptr;
+    }
+
+    m_current.reset(m_result, row, mysql_fetch_lengths(m_result));
+    return &m_current;
+}
+
+void MySqlCursor::close()
+{
+    finish(false);
+}
+
+void MySqlCursor::finish(bool discard)
+{
+    if (!m_result) {
+        return;
+    }
+
+    // Reads whatever is left of the result so the connection can run the next statement
+    mysql_free_result(m_result);
+    m_result = __cell_nullptr;
+    m_current.reset(__cell_nullptr, __cell_nullptr, __cell_nullptr);
+    if (discard) {
+        m_lease.discard();
+    } else {
+        m_lease.release();
+    }
+}
+
+bool MySqlCursor::isOpen() const
+{
+    return m_result != __cell_nullptr;
+}
+
+CELL_NAMESPACE_END
+
+#endif
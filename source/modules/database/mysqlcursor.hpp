@@ -0,0 +1,108 @@
+/*!
+ * @file        mysqlcursor.hpp
+ * @brief       Database MySQL cursor for the Cell Engine.
+ * @details     This file defines MySqlCursor, which streams a query with mysql_use_result().
+ * @author      Kambiz Asadzadeh
+ * @since       07 Jun 2023
+ * @version     1.0
+ * @note        This is part of the Cell Engine, developed by Kambiz Asadzadeh.
+ *
+ * @license     This file is licensed under the terms of the Genyleap License. See the LICENSE.md file for more information.
+ * @copyright   Copyright (c) 2025 The Genyleap | Kambiz Asadzadeh. All rights reserved.
+ * @see         https://github.com/genyleap/cell
+ */
+
+#ifndef CELL_MYSQL_CURSOR_HPP
+#define CELL_MYSQL_CURSOR_HPP
+
+#if defined(USE_MYSQL_MARIADB)
+
+#if __has_include("common.hpp")
+#   include "common.hpp"
+#else
+#   error "Cell's "common.hpp" was not found!"
+#endif
+
+#if __has_include("abstract-includer.hpp")
+#   include "abstract-includer.hpp"
+#else
+#   error "Cell's "abstract-includer.hpp" was not found!"
+#endif
+
+CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Database)
+
+/**
+ * @brief The row an unbuffered MySQL result is positioned on, as a one-row result set.
+ */
+class __cell_export MySqlStreamRow final : public Abstracts::ResultSet
+{
+public:
+    MySqlStreamRow() = default;
+
+    std::size_t rowCount() const __cell_override;
+    std::size_t columnCount() const __cell_override;
+    std::string_view columnName(std::size_t column) const __cell_override;
+    bool isNull(std::size_t row, std::size_t column) const __cell_override;
+    std::string_view value(std::size_t row, std::size_t column) const __cell_override;
+
+    /**
+     * @brief Points the view at the row just fetched from a result.
+     */
+    void reset(MYSQL_RES* result, MYSQL_ROW row, const ulong* lengths);
+
+private:
+    MYSQL_RES*      m_result    {};
+    MYSQL_ROW       m_row       {};
+    const ulong*    m_lengths   {};
+};
+
+/**
+ * @brief Streams a MySQL query with mysql_use_result(), one row per batch.
+ *
+ * Rows are read off the socket as they are fetched; the server blocks once the socket buffers are full,
+ * so a slow consumer holds the query open rather than growing client memory. Keep the consumer faster
+ * than the server's net_write_timeout. Closing early reads and discards the remaining rows, because the
+ * connection cannot be reused before the result is drained.
+ *
+ * @note This class is marked with the "__cell_export" attribute, indicating
+ *       it is part of the "cell" module for exporting purposes.
+ */
+class __cell_export MySqlCursor final : public Abstracts::Cursor
+{
+public:
+    /**
+     * @brief Sends the query and starts an unbuffered result.
+     *
+     * @param lease The lease of the connection, or an empty lease when the connection is pinned by a transaction.
+     * @param connection The connection to run the query on.
+     * @param sql The query to stream.
+     * @throws std::runtime_error If the query fails or returns no result set.
+     */
+    MySqlCursor(Abstracts::ConnectionLease lease, Types::MySqlPtr connection, const std::string& sql);
+
+    /**
+     * @brief Closes the cursor if it is still open.
+     */
+    ~MySqlCursor();
+
+    const Abstracts::ResultSet* fetch() __cell_override;
+    void close() __cell_override;
+    bool isOpen() const __cell_override;
+
+private:
+    /**
+     * @brief Frees the result and gives the connection back, or closes it when the session was lost.
+     */
+    void finish(bool discard);
+
+    Abstracts::ConnectionLease  m_lease         {}; //!< Owned connection, if not pinned.
+    Types::MySqlPtr             m_connection    {}; //!< The connection the result is read from.
+    MYSQL_RES*                  m_result        {}; //!< The unbuffered result.
+    MySqlStreamRow              m_current       {}; //!< The row handed out last.
+};
+
+CELL_NAMESPACE_END
+
+#endif
+
+#endif // CELL_MYSQL_CURSOR_HPP
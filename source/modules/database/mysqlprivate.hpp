@@ -78,6 +78,7 @@ struct MYSQL_CONSTANTS final
 struct MySQLData final
 {
     std::string          lastError;         //!< Last error message encountered.
+    mutable Types::Mutex errorMutex;        //!< Guards lastError, which std::async threads write too.
 
     int connectionTimeout;                  //!< Connection timeout duration in seconds.
 
@@ -87,8 +88,10 @@ struct MySQLData final
     Types::OptionalString password  {};     //!< Optional password for the database user.
     Types::OptionalString database  {};     //!< Optional name of the database to connect to.
 
-    Types::QueryCache    queryCache {};     //!< Cache for storing query results.
-    Types::Mutex         cacheMutex {};     //!< Mutex for synchronizing access to the query cache.
+    std::shared_ptr<Abstracts::QueryCache> queryCache { std::make_shared<Abstracts::QueryCache>() };  //!< Results of the queries that opt in; may be shared.
+    mutable Types::Mutex        cacheMutex              {};         //!< Guards the query cache pointer.
+
+    Abstracts::StatisticsOptions statistics {};                      //!< How the aggregate methods answer.
 };
 
 CELL_NAMESPACE_END
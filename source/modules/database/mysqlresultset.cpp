@@ -0,0 +1,78 @@
+#if __has_include("mysqlresultset.hpp")
+#   include "mysqlresultset.hpp"
+#else
+#   error "Cell's "mysqlresultset.hpp" was not found!"
+#endif
+
+#if defined(USE_MYSQL_MARIADB)
+
+CELL_USING_NAMESPACE Cell;
+CELL_USING_NAMESPACE Cell::Types;
+
+CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Database)
+
+MySqlResultSet::MySqlResultSet(MYSQL_RES* result)
+    : m_result(result)
+    , m_columns(mysql_num_fields(result))
+{
+    const std::size_t rows = static_cast<std::size_t>(mysql_num_rows(result));
+    m_rows.reserve(rows);
+    m_lengths.reserve(rows * m_columns);
+    m_nulls.assign((rows * m_columns + 63) / 64, 0);
+
+    // mysql_fetch_lengths() reuses one buffer, so the lengths are copied while walking the rows
+    MYSQL_ROW row;
+    while ((row = mysql_fetch_row(result))) {
+        const ulong* lengths = mysql_fetch_lengths(result);
+        for (std::size_t column = 0; column < m_columns; ++column) {
+            if (!row[column]) {
+                const std::size_t bit = m_rows.size() * m_columns + column;
+                m_nulls[bit / 64] |= std::uint64_t { 1 } << (bit % 64);
+            }
+            m_lengths.push_back(lengths[column]);
+        }
+        m_rows.push_back(row);
+    }
+}
+
+MySqlResultSet::~MySqlResultSet()
+{
+    mysql_free_result(m_result);
+}
+
+std::size_t MySqlResultSet::rowCount() const
+{
+    return m_rows.size();
+}
+
+std::size_t MySqlResultSet::columnCount() const
+{
+    return m_columns;
+}
+
+std::string_view MySqlResultSet::columnName(std::size_t column) const
+{
+    const MYSQL_FIELD& field = mysql_fetch_fields(m_result)[column];
+    return std::string_view(field.name, field.name_length);
+}
+
+bool MySqlResultSet::isNull(std::size_t row, std::size_t column) const
+{
+    const std::size_t bit = row * m_columns + column;
+    return (m_nulls[bit / 64] >> (bit % 64)) & 1;
+}
+
+std::string_view MySqlResultSet::value(std::size_t row, std::size_t column) const
+{
+    const char* data = m_rows[row][column];
+    return data ? std::string_view(data, m_lengths[row * m_columns + column]) : std::string_view();
+}
+
+const MYSQL_RES* MySqlResultSet::native() const
+{
+    return m_result;
+}
+
+CELL_NAMESPACE_END
+
+#endif
@@ -0,0 +1,81 @@
+/*!
+ * @file        mysqlresultset.hpp
+ * @brief       Database MySQL result set for the Cell Engine.
+ * @details     This file defines MySqlResultSet, a zero-copy view over a stored MYSQL_RES.
+ * @author      Kambiz Asadzadeh
+ * @since       07 Jun 2023
+ * @version     1.0
+ * @note        This is part of the Cell Engine, developed by Kambiz Asadzadeh.
+ *
+ * @license     This file is licensed under the terms of the Genyleap License. See the LICENSE.md file for more information.
+ * @copyright   Copyright (c) 2025 The Genyleap | Kambiz Asadzadeh. All rights reserved.
+ * @see         https://github.com/genyleap/cell
+ */
+
+#ifndef CELL_MYSQL_RESULT_SET_HPP
+#define CELL_MYSQL_RESULT_SET_HPP
+
+#if defined(USE_MYSQL_MARIADB)
+
+#if __has_include("common.hpp")
+#   include "common.hpp"
+#else
+#   error "Cell's "common.hpp" was not found!"
+#endif
+
+#if __has_include("abstract-includer.hpp")
+#   include "abstract-includer.hpp"
+#else
+#   error "Cell's "abstract-includer.hpp" was not found!"
+#endif
+
+CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Database)
+
+/**
+ * @brief A MySQL query result that reads values straight out of a stored MYSQL_RES.
+ *
+ * A stored result is a linked list of rows, so the constructor walks it once to index the rows, their
+ * lengths and a null bitmap; after that every access is O(1) and no value is copied.
+ *
+ * @note This class is marked with the "__cell_export" attribute, indicating
+ *       it is part of the "cell" module for exporting purposes.
+ */
+class __cell_export MySqlResultSet final : public Abstracts::ResultSet
+{
+public:
+    /**
+     * @brief Takes ownership of a result obtained with mysql_store_result().
+     *
+     * @param result The stored result; it is freed with the result set.
+     */
+    explicit MySqlResultSet(MYSQL_RES* result);
+
+    /**
+     * @brief Frees the MYSQL_RES.
+     */
+    ~MySqlResultSet();
+
+    std::size_t rowCount() const __cell_override;
+    std::size_t columnCount() const __cell_override;
+    std::string_view columnName(std::size_t column) const __cell_override;
+    bool isNull(std::size_t row, std::size_t column) const __cell_override;
+    std::string_view value(std::size_t row, std::size_t column) const __cell_override;
+
+    /**
+     * @brief Returns the native result, still owned by the result set.
+     */
+    const MYSQL_RES* native() const;
+
+private:
+    MYSQL_RES*                  m_result    {}; //!< The owned result.
+    std::size_t                 m_columns   {}; //!< Number of fields.
+    std::vector<MYSQL_ROW>      m_rows      {}; //!< Row pointers into the result's memory.
+    std::vector<ulong>          m_lengths   {}; //!< Value lengths, row-major.
+    std::vector<std::uint64_t>  m_nulls     {}; //!< One bit per value, row-major.
+};
+
+CELL_NAMESPACE_END
+
+#endif
+
+#endif // CELL_MYSQL_RESULT_SET_HPP
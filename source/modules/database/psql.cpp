@@ -19,6 +19,406 @@ CELL_USING_NAMESPACE Cell::Types;
 
 CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Database)
 
+namespace {
+
+void executeOnPostgreSql(const SqlConnection& connection, const std::string& sql)
+{
+    PostgreSqlPtr postgresConnection = std::get<PostgreSqlPtr>(connection);
+    std::unique_ptr<PGresult, decltype(&PQclear)> result(PQexec(postgresConnection, sql.c_str()), &PQclear);
+
+    const auto status = PQresultStatus(result.get());
+    if (status == PGRES_COMMAND_OK || status == PGRES_TUPLES_OK) {
+        return;
+    }
+
+    // serialization_failure and deadlock_detected succeed when the transaction is run again
+    const std::string message = PQerrorMessage(postgresConnection);
+    const char* sqlState = PQresultErrorField(result.get(), PG_DIAG_SQLSTATE);
+    if (sqlState && (std::string_view(sqlState) == "40001" || std::string_view(sqlState) == "40P01")) {
+        throw Abstracts::SerializationFailure(message);
+    }
+    throw Exception(Exception::Reason::Database, message).getRuntimeError();
+}
+
+std::vector<std::string> beginOnPostgreSql(const Abstracts::TransactionOptions& options)
+{
+    std::string sql(POSTGRESQL_CONSTANTS::BEGIN);
+    switch (options.isolation) {
+    case Abstracts::IsolationLevel::Default:
+        break;
+    case Abstracts::IsolationLevel::ReadCommitted:
+        sql += " ISOLATION LEVEL READ COMMITTED";
+        break;
+    case Abstracts::IsolationLevel::RepeatableRead:
+        sql += " ISOLATION LEVEL REPEATABLE READ";
+        break;
+    case Abstracts::IsolationLevel::Serializable:
+        sql += " ISOLATION LEVEL SERIALIZABLE";
+        break;
+    }
+    if (options.readOnly) {
+        sql += " READ ONLY";
+    }
+    return { sql };
+}
+
+const Abstracts::TransactionDialect postgreSqlDialect {
+    .execute = &executeOnPostgreSql,
+    .begin   = &beginOnPostgreSql
+};
+
+std::string postgreSqlPlaceholder(std::size_t position)
+{
+    return "$" + std::to_string(position);
+}
+
+std::string quotePostgreSqlIdentifier(std::string_view name)
+{
+    std::string quoted = "\"";
+    for (const char character : name) {
+        quoted += character == '"' ? "\"\"" : std::string(1, character);
+    }
+    return quoted + "\"";
+}
+
+const Abstracts::KeysetDialect postgreSqlKeyset {
+    .placeholder     = &postgreSqlPlaceholder,
+    .quoteIdentifier = &quotePostgreSqlIdentifier
+};
+
+using PostgreSqlResult = std::unique_ptr<PGresult, decltype(&PQclear)>;
+
+/**
+ * @brief Reads the columns, indexes and foreign keys of every visible table in one round trip.
+ *
+ * The rows are laid out as Abstracts::SchemaCatalog::parse() expects.
+ */
+constexpr const char* postgreSqlSchemaCatalog =
+    "SELECT 'c', c.relname, a.attname, format_type(a.atttypid, a.atttypmod), a.atttypid::text,"
+    " (NOT a.attnotnull)::text, pg_get_expr(d.adbin, d.adrelid), a.attnum::text, NULL"
+    " FROM pg_attribute a JOIN pg_class c ON c.oid = a.attrelid"
+    " LEFT JOIN pg_attrdef d ON d.adrelid = a.attrelid AND d.adnum = a.attnum"
+    " WHERE c.relkind IN ('r', 'p', 'v', 'm', 'f') AND a.attnum > 0 AND NOT a.attisdropped"
+    " AND pg_table_is_visible(c.oid) AND c.relnamespace <> 'pg_catalog'::regnamespace"
+    " UNION ALL"
+    " SELECT 'i', t.relname, i.relname,"
+    " (SELECT string_agg(a.attname, chr(31) ORDER BY k.n) FROM unnest(x.indkey::int2[]) WITH ORDINALITY AS k(attnum, n)"
+    " JOIN pg_attribute a ON a.attrelid = x.indrelid AND a.attnum = k.attnum),"
+    " x.indisunique::text, x.indisprimary::text, NULL, NULL, NULL"
+    " FROM pg_index x JOIN pg_class t ON t.oid = x.indrelid JOIN pg_class i ON i.oid = x.indexrelid"
+    " WHERE pg_table_is_visible(t.oid) AND t.relnamespace <> 'pg_catalog'::regnamespace"
+    " UNION ALL"
+    " SELECT 'f', t.relname, k.conname,"
+    " (SELECT string_agg(a.attname, chr(31) ORDER BY u.n) FROM unnest(k.conkey) WITH ORDINALITY AS u(attnum, n)"
+    " JOIN pg_attribute a ON a.attrelid = k.conrelid AND a.attnum = u.attnum),"
+    " r.relname,"
+    " (SELECT string_agg(a.attname, chr(31) ORDER BY u.n) FROM unnest(k.confkey) WITH ORDINALITY AS u(attnum, n)"
+    " JOIN pg_attribute a ON a.attrelid = k.confrelid AND a.attnum = u.attnum),"
+    " NULL, NULL, NULL"
+    " FROM pg_constraint k JOIN pg_class t ON t.oid = k.conrelid JOIN pg_class r ON r.oid = k.confrelid"
+    " WHERE k.contype = 'f' AND pg_table_is_visible(t.oid) AND t.relnamespace <> 'pg_catalog'::regnamespace";
+
+bool isStalePreparedStatement(std::string_view sqlState, std::string_view message)
+{
+    // invalid_sql_statement_name: the statement is gone (DISCARD ALL, a pooler reset)
+    if (sqlState == "26000") {
+        return true;
+    }
+    // feature_not_supported covers many errors; only the plan an ALTER TABLE invalidated is fixed by preparing
+    // again. A server with translated messages gets the error instead of the retry.
+    return sqlState == "0A000" && message == "cached plan must not change result type";
+}
+
+bool isStalePreparedStatement(const PGresult* result)
+{
+    const char* sqlState = PQresultErrorField(result, PG_DIAG_SQLSTATE);
+    const char* message = PQresultErrorField(result, PG_DIAG_MESSAGE_PRIMARY);
+    return sqlState && message && isStalePreparedStatement(sqlState, message);
+}
+
+/**
+ * @brief Runs a parameterised statement through the connection's prepared statement cache.
+ *
+ * The statement is parsed and planned once per connection; later calls only bind and execute. A
+ * statement the server rejects as stale is dropped from the cache and, outside a transaction,
+ * prepared and run once more.
+ */
+PostgreSqlResult executeCached(PostgreSqlConnectionPool& pool, PostgreSqlPtr connection, const std::string& sql, const std::vector<std::string>& params,
+                               Abstracts::ResultFormat format = Abstracts::ResultFormat::Text)
+{
+    std::vector<const char*> values;
+    values.reserve(params.size());
+    for (const auto& param : params) {
+        values.push_back(param.c_str());
+    }
+    const int count = static_cast<int>(params.size());
+
+    auto& cache = pool.statementCache(connection);
+    for (int attempt = 0;; ++attempt) {
+        std::string* name = cache.find(sql);
+        if (!name) {
+            std::string fresh = "cell_stmt_" + std::to_string(cache.nextSequence());
+            PostgreSqlResult prepared(PQprepare(connection, fresh.c_str(), sql.c_str(), count, __cell_nullptr), &PQclear);
+            if (PQresultStatus(prepared.get()) != PGRES_COMMAND_OK) {
+                return prepared;
+            }
+            name = &cache.insert(sql, std::move(fresh));
+        }
+
+        PostgreSqlResult result(PQexecPrepared(connection, name->c_str(), count, values.data(), __cell_nullptr, __cell_nullptr, static_cast<int>(format)), &PQclear);
+        const auto status = PQresultStatus(result.get());
+        if (status == PGRES_COMMAND_OK || status == PGRES_TUPLES_OK || !isStalePreparedStatement(result.get())) {
+            return result;
+        }
+
+        cache.invalidate(sql);
+        // Inside a transaction the error has already aborted it, so only a standalone statement is retried
+        if (attempt > 0 || PQtransactionStatus(connection) != PQTRANS_IDLE) {
+            return result;
+        }
+    }
+}
+
+/**
+ * @brief Drops the cached results that depend on the tables, or every result if they are unknown.
+ */
+void invalidateCached(Abstracts::QueryCache& cache, const std::optional<std::vector<std::string>>& tables)
+{
+    if (tables) {
+        cache.invalidate(*tables);
+    } else {
+        cache.invalidateAll();
+    }
+}
+
+/**
+ * @brief Sends a query through the reactor and converts its result set once it arrives.
+ *
+ * Failures are recorded as the connection's last error and reported as the failed value, like the
+ * synchronous calls do.
+ */
+template <typename T, typename Convert>
+std::future<T> submitConverted(PostgreSqlReactor& reactor, Abstracts::ConnectionLease lease, PostgreSqlPtr connection, const std::string& sql,
+                               const std::vector<std::string>& params, PostgreSqlData& data, T failed, Convert convert)
+{
+    auto promise = std::make_shared<std::promise<T>>();
+    auto future = promise->get_future();
+    reactor.submit(std::move(lease), connection, sql, params, Abstracts::ResultFormat::Text,
+                   [promise, &data, failed = std::move(failed), convert = std::move(convert)](Abstracts::ResultSetPtr result, std::exception_ptr error) mutable {
+                       if (error) {
+                           try {
+                               std::rethrow_exception(error);
+                           } catch (const std::exception& e) {
+                               // Written from the reactor thread while callers may read or write it
+                               std::lock_guard<std::mutex> lock(data.errorMutex);
+                               data.lastError = e.what();
+                           }
+                           promise->set_value(std::move(failed));
+                           return;
+                       }
+                       promise->set_value(convert(*result));
+                   });
+    return future;
+}
+
+/**
+ * @brief Lists the tables of a backup, largest first so the longest copies start early.
+ */
+constexpr const char* postgreSqlBackupTables =
+    "SELECT c.oid::regclass::text FROM pg_class c JOIN pg_namespace n ON n.oid = c.relnamespace"
+    " WHERE c.relkind = 'r' AND c.relpersistence <> 't'"
+    " AND n.nspname NOT IN ('pg_catalog', 'information_schema') AND n.nspname NOT LIKE 'pg\\_toast%'"
+    " ORDER BY pg_relation_size(c.oid) DESC, 1";
+
+//! Pairs of a table and a table its foreign keys reference.
+constexpr const char* postgreSqlBackupReferences =
+    "SELECT DISTINCT conrelid::regclass::text, confrelid::regclass::text FROM pg_constraint"
+    " WHERE contype = 'f' AND conrelid <> confrelid";
+
+//! Sequences that have handed out a value; the others need no restore.
+constexpr const char* postgreSqlBackupSequences =
+    "SELECT format('%I.%I', schemaname, sequencename), last_value FROM pg_sequences WHERE last_value IS NOT NULL";
+
+/**
+ * @brief Estimates the rows of a table the way the planner does.
+ *
+ * reltuples per page as of the last VACUUM or ANALYZE, times the pages the table has now. It is -1 when
+ * there is no estimate to scale: a table never analyzed, a partitioned table, or one that was empty
+ * when it was analyzed and has pages since.
+ */
+constexpr const char* postgreSqlRowEstimate =
+    "SELECT CASE"
+    " WHEN c.relkind NOT IN ('r', 'm') OR c.reltuples < 0 OR (c.relpages = 0 AND pg_relation_size(c.oid) > 0) THEN -1"
+    " WHEN c.relpages = 0 THEN 0"
+    " ELSE (c.reltuples / c.relpages * (pg_relation_size(c.oid) / current_setting('block_size')::integer))::bigint END"
+    " FROM pg_class c WHERE c.oid = to_regclass($1)";
+
+const Abstracts::SqlScriptDialect postgreSqlScript {
+    .dollarQuotes   = true,
+    .escapeStrings  = true,
+    .nestedComments = true
+};
+
+using GzipFile = std::unique_ptr<gzFile_s, decltype(&gzclose)>;
+
+/**
+ * @brief Runs a query that returns rows on a connection.
+ */
+PostgreSqlResult selectOnPostgreSql(PostgreSqlPtr connection, const char* sql)
+{
+    PostgreSqlResult result(PQexec(connection, sql), &PQclear);
+    if (PQresultStatus(result.get()) != PGRES_TUPLES_OK) {
+        throw Exception(Exception::Reason::Database, PQresultErrorMessage(result.get())).getRuntimeError();
+    }
+    return result;
+}
+
+/**
+ * @brief Returns the file of a table: its position keeps it unique, and its name is kept readable.
+ */
+std::string backupFileName(std::size_t index, std::string_view table)
+{
+    std::string name = std::to_string(index) + "-";
+    for (const char character : table) {
+        const bool safe = std::isalnum(static_cast<unsigned char>(character)) || character == '_' || character == '.' || character == '-';
+        name += safe ? character : '_';
+    }
+    return name + std::string(POSTGRESQL_BACKUP_CONSTANTS::TABLE_FILE_SUFFIX);
+}
+
+/**
+ * @brief Numbers the tables in waves, each after the waves of the tables it references.
+ *
+ * Tables left in a cycle of references share the last wave.
+ */
+void assignRestoreWaves(std::vector<PostgreSqlBackupTable>& tables, const PGresult* references)
+{
+    std::unordered_map<std::string, std::vector<std::string>> referenced;
+    for (int row = 0; row < PQntuples(references); ++row) {
+        referenced[PQgetvalue(references, row, 0)].emplace_back(PQgetvalue(references, row, 1));
+    }
+
+    std::unordered_set<std::string> remaining;
+    for (const auto& table : tables) {
+        remaining.insert(table.name);
+    }
+    for (Types::uint wave = 0; !remaining.empty(); ++wave) {
+        std::vector<std::string> ready;
+        for (const auto& name : remaining) {
+            const auto& parents = referenced[name];
+            if (std::ranges::none_of(parents, [&remaining](const std::string& parent) { return remaining.contains(parent); })) {
+                ready.push_back(name);
+            }
+        }
+        if (ready.empty()) {
+            ready.assign(remaining.begin(), remaining.end());
+        }
+        for (const auto& name : ready) {
+            remaining.erase(name);
+            std::ranges::find(tables, name, &PostgreSqlBackupTable::name)->wave = wave;
+        }
+    }
+}
+
+/**
+ * @brief Runs work on a number of workers at once, the calling thread being worker 0.
+ *
+ * The first failure stops the others from taking more work and is rethrown once all have returned.
+ */
+void runWorkers(Types::uint count, const std::function<void(Types::uint worker, const std::atomic<bool>& stopped)>& work)
+{
+    std::atomic<bool> stopped { false };
+    std::exception_ptr failure;
+    std::mutex failureMutex;
+    const auto guarded = [&](Types::uint worker) {
+        try {
+            work(worker, stopped);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(failureMutex);
+            if (!failure) {
+                failure = std::current_exception();
+            }
+            stopped.store(true, std::memory_order_relaxed);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(count > 0 ? count - 1 : 0);
+    for (Types::uint worker = 1; worker < count; ++worker) {
+        workers.emplace_back(guarded, worker);
+    }
+    guarded(0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
+
+/**
+ * @brief Streams a table through zlib into its file.
+ */
+void dumpTable(PostgreSqlPtr connection, const std::filesystem::path& directory, PostgreSqlBackupTable& table, const PostgreSqlBackupOptions& options)
+{
+    const auto path = directory / table.file;
+    std::string mode = "wb";
+    if (options.compressionLevel >= Z_NO_COMPRESSION && options.compressionLevel <= Z_BEST_COMPRESSION) {
+        mode += std::to_string(options.compressionLevel);
+    }
+    GzipFile file(gzopen(path.string().c_str(), mode.c_str()), &gzclose);
+    if (!file) {
+        throw Exception(Exception::Reason::Database, "Failed to create the backup file '" + path.string() + "'.").getRuntimeError();
+    }
+    gzbuffer(file.get(), static_cast<unsigned>(POSTGRESQL_BACKUP_CONSTANTS::CHUNK_SIZE));
+
+    // An empty lease: the connection belongs to the worker's snapshot transaction
+    PostgreSqlCopyOut reader({}, connection, table.name, options.format);
+    table.rows = reader.forEach([&](std::string_view chunk) {
+        if (gzwrite(file.get(), chunk.data(), static_cast<unsigned>(chunk.size())) != static_cast<int>(chunk.size())) {
+            throw Exception(Exception::Reason::Database, "Failed to write the backup file '" + path.string() + "'.").getRuntimeError();
+        }
+        table.bytes += chunk.size();
+    });
+    if (gzclose(file.release()) != Z_OK) {
+        throw Exception(Exception::Reason::Database, "Failed to write the backup file '" + path.string() + "'.").getRuntimeError();
+    }
+}
+
+/**
+ * @brief Streams the file of a table into it with COPY FROM STDIN.
+ */
+void loadTable(PostgreSqlPtr connection, const std::filesystem::path& directory, const PostgreSqlBackupTable& table, Abstracts::ResultFormat format)
+{
+    const auto path = directory / table.file;
+    GzipFile file(gzopen(path.string().c_str(), "rb"), &gzclose);
+    if (!file) {
+        throw Exception(Exception::Reason::Database, "Failed to open the backup file '" + path.string() + "'.").getRuntimeError();
+    }
+    gzbuffer(file.get(), static_cast<unsigned>(POSTGRESQL_BACKUP_CONSTANTS::CHUNK_SIZE));
+
+    PostgreSqlCopyOptions copyOptions;
+    copyOptions.format = format;
+    PostgreSqlCopyIn writer({}, connection, table.name, copyOptions);
+    std::string buffer(POSTGRESQL_BACKUP_CONSTANTS::CHUNK_SIZE, '\0');
+    for (;;) {
+        const int read = gzread(file.get(), buffer.data(), static_cast<unsigned>(buffer.size()));
+        if (read < 0) {
+            throw Exception(Exception::Reason::Database, "Failed to read the backup file '" + path.string() + "'.").getRuntimeError();
+        }
+        if (read == 0) {
+            break;
+        }
+        writer.writeRaw(std::string_view(buffer.data(), static_cast<std::size_t>(read)));
+    }
+    if (const auto stored = writer.finish(); stored != table.rows) {
+        throw Exception(Exception::Reason::Database, "The backup of " + table.name + " has " + std::to_string(table.rows)
+                                                     + " rows but " + std::to_string(stored) + " were loaded.").getRuntimeError();
+    }
+}
+
+}  // namespace
+
 void* PostgreSqlDatabaseConnection::get()
 {
     auto connection = connectionPool.getConnection();
@@ -36,6 +436,8 @@ PostgreSqlDatabaseConnection::PostgreSqlDatabaseConnection(PostgreSqlConnectionP
 
 PostgreSqlDatabaseConnection::~PostgreSqlDatabaseConnection()
 {
+    // Threads may have left a transaction open; it is rolled back before the pool connections go away
+    m_transactions.clear();
     disconnect();
 }
 
@@ -64,7 +466,7 @@ bool PostgreSqlDatabaseConnection::connect()
 
         if (PQstatus(connection) != CONNECTION_OK) {
             // Handle connection error
-            m_PostgreSqlData.lastError = PQerrorMessage(connection);
+            setLastError(PQerrorMessage(connection));
             PQfinish(connection);
             connection = nullptr;
             return false;
@@ -79,8 +481,9 @@ bool PostgreSqlDatabaseConnection::connect()
 
 bool PostgreSqlDatabaseConnection::disconnect()
 {
+    // The dedicated connection comes from connect(), not from the pool
     if (connection) {
-        connectionPool.releaseConnection(connection);
+        PQfinish(connection);
         connection = __cell_nullptr;
     }
     return true;
@@ -115,8 +518,7 @@ bool PostgreSqlDatabaseConnection::isConnected()
 
 bool PostgreSqlDatabaseConnection::isQueryCached(const std::string& sql)
 {
-    std::unique_lock<std::mutex> lock(m_PostgreSqlData.cacheMutex);
-    return m_PostgreSqlData.queryCache.count(sql) > 0;
+    return queryCache()->contains(sql);
 }
 
 
@@ -132,27 +534,11 @@ bool PostgreSqlDatabaseConnection::isConnectionAlive()
 
 int PostgreSqlDatabaseConnection::getActiveConnectionsCount()
 {
-    if (!isConnected()) {
-        return 0;
-    }
-
-    int activeConnections = 0;
-
-    // Access the connection pool's data to count active connections
-    std::lock_guard<std::mutex> lock(connectionPool.m_poolData.mutex);
-    for (const auto& connection : connectionPool.m_poolData.connections) {
-        if (std::holds_alternative<PGconn*>(connection)) {
-            PGconn* pgConnection = std::get<PGconn*>(connection);
-            if (pgConnection != nullptr && PQstatus(pgConnection) == CONNECTION_OK) {
-                activeConnections++;
-            }
-        }
-    }
-
-    return activeConnections;
+    // Open pool connections, idle or borrowed; validation happens on borrow rather than here
+    const auto statistics = connectionPool.statistics();
+    return static_cast<int>(statistics.idle + statistics.inUse);
 }
 
-
 std::string PostgreSqlDatabaseConnection::getConnectionHealthStatus()
 {
     if (connection == __cell_nullptr) {
@@ -199,7 +585,14 @@ std::string PostgreSqlDatabaseConnection::getDatabaseServerVersion()
 
 std::map<std::string, std::string> PostgreSqlDatabaseConnection::getConnectionStatistics()
 {
-    std::map<std::string, std::string> statistics;
+    std::map<std::string, std::string> statistics = connectionPool.statisticsMap();
+
+    const auto statements = connectionPool.statementCacheStatistics();
+    statistics["statement_cache_hits"] = std::to_string(statements.hits);
+    statistics["statement_cache_misses"] = std::to_string(statements.misses);
+    statistics["statement_cache_evictions"] = std::to_string(statements.evictions);
+    statistics["statement_cache_invalidations"] = std::to_string(statements.invalidations);
+    statistics["statement_cache_hit_ratio"] = std::to_string(statements.hitRatio());
 
     if (connection == __cell_nullptr) {
         statistics["error"] = "Not connected to the PostgreSQL server.";
@@ -295,183 +688,212 @@ std::vector<std::string> PostgreSqlDatabaseConnection::getConnectionActivityLog(
 
 bool PostgreSqlDatabaseConnection::executePreparedStatementSync(const std::string& sql, const std::vector<std::string>& params)
 {
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<PostgreSqlPtr>(connection)) {
-        // Invalid connection from the pool
+    return executeWithParamsSync(sql, params);
+}
+
+std::future<bool> PostgreSqlDatabaseConnection::executePreparedStatementAsync(const std::string& sql, const std::vector<std::string>& params)
+{
+    return std::async(std::launch::async, [this, sql, params]() {
+        return executePreparedStatementSync(sql, params);
+    });
+}
+
+bool PostgreSqlDatabaseConnection::beginTransaction()
+{
+    // The transaction belongs to the calling thread; other threads keep using the pool
+    if (m_transactions.current()) {
+        setLastError("A transaction is already in progress.");
         return false;
     }
 
-    PostgreSqlPtr postgreSqlConnection = std::get<PostgreSqlPtr>(connection);
+    try {
+        m_transactions.pin(transaction());
+        return true;
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return false;
+    }
+}
 
-    // Construct the prepared statement query
-    std::string preparedStatement = "PREPARE statement_name AS " + sql;
+bool PostgreSqlDatabaseConnection::commitTransaction()
+{
+    // The pinned connection goes back to the pool whatever the outcome
+    auto pinned = m_transactions.unpin();
+    if (!pinned) {
+        setLastError("No transaction is in progress.");
+        return false;
+    }
 
-    // Execute the prepare statement
-    PGresult* prepareResult = PQexec(postgreSqlConnection, preparedStatement.c_str());
-    if (PQresultStatus(prepareResult) != PGRES_COMMAND_OK) {
-        // Failed to prepare the statement
-        PQclear(prepareResult);
-        connectionPool.releaseConnection(postgreSqlConnection);
+    try {
+        pinned->transaction.commit();
+    } catch (const std::exception& e) {
+        setLastError(e.what());
         return false;
     }
-    PQclear(prepareResult);
 
-    // Construct the parameter binding query
-    std::string bindParamsQuery = "EXECUTE statement_name (";
-    for (size_t i = 0; i < params.size(); ++i) {
-        if (i > 0) {
-            bindParamsQuery += ", ";
-        }
-        bindParamsQuery += "'" + params[i] + "'";
+    // Results loaded while the transaction was open may predate its writes, and replicas have yet to replay them
+    if (pinned->writtenUnknown || !pinned->writtenTables.empty()) {
+        invalidateCached(*queryCache(), pinned->writtenUnknown ? std::nullopt : std::make_optional(std::move(pinned->writtenTables)));
+        m_lastWriteAt.store(std::chrono::steady_clock::now(), std::memory_order_relaxed);
     }
-    bindParamsQuery += ")";
+    if (pinned->schemaChanged) {
+        connectionPool.schemaCatalog().invalidate();
+    }
+    return true;
+}
 
-    // Execute the parameter binding query
-    PGresult* bindParamsResult = PQexec(postgreSqlConnection, bindParamsQuery.c_str());
-    if (PQresultStatus(bindParamsResult) != PGRES_COMMAND_OK) {
-        // Failed to bind the parameters
-        PQclear(bindParamsResult);
-        connectionPool.releaseConnection(postgreSqlConnection);
+bool PostgreSqlDatabaseConnection::rollbackTransaction()
+{
+    auto pinned = m_transactions.unpin();
+    if (!pinned) {
+        setLastError("No transaction is in progress.");
         return false;
     }
-    PQclear(bindParamsResult);
 
-    // Deallocate the prepared statement
-    PGresult* deallocateResult = PQexec(postgreSqlConnection, "DEALLOCATE statement_name");
-    if (PQresultStatus(deallocateResult) != PGRES_COMMAND_OK) {
-        // Failed to deallocate the prepared statement
-        PQclear(deallocateResult);
-        connectionPool.releaseConnection(postgreSqlConnection);
+    try {
+        pinned->transaction.rollback();
+        return true;
+    } catch (const std::exception& e) {
+        setLastError(e.what());
         return false;
     }
-    PQclear(deallocateResult);
-
-    // Release the connection back to the pool
-    connectionPool.releaseConnection(postgreSqlConnection);
-
-    // The prepared statement execution was successful
-    return true;
 }
 
-std::future<bool> PostgreSqlDatabaseConnection::executePreparedStatementAsync(const std::string& sql, const std::vector<std::string>& params)
+Abstracts::ConnectionLease PostgreSqlDatabaseConnection::leaseConnection()
 {
-    return std::async(std::launch::async, [this, sql, params]() {
-        return executePreparedStatementSync(sql, params);
-    });
+    return Abstracts::ConnectionLease(connectionPool);
 }
 
-bool PostgreSqlDatabaseConnection::beginTransaction()
+Abstracts::Transaction PostgreSqlDatabaseConnection::transaction(const Abstracts::TransactionOptions& options)
 {
-    const std::string sql = "BEGIN";
-    return executeSync(sql);
+    return Abstracts::Transaction(leaseConnection(), postgreSqlDialect, options);
 }
 
-bool PostgreSqlDatabaseConnection::commitTransaction()
+PostgreSqlPtr PostgreSqlDatabaseConnection::acquireConnection(Abstracts::ConnectionLease& lease)
 {
-    const std::string sql = "COMMIT";
-    return executeSync(sql);
+    if (auto* pinned = m_transactions.current()) {
+        return pinned->transaction.lease().get<PostgreSqlPtr>();
+    }
+    lease = leaseConnection();
+    return lease.get<PostgreSqlPtr>();
 }
 
-bool PostgreSqlDatabaseConnection::rollbackTransaction()
+PostgreSqlPtr PostgreSqlDatabaseConnection::acquireReadConnection(const std::string& sql, Abstracts::ConnectionLease& lease, PostgreSqlConnectionPool*& pool,
+                                                                  bool allowReplica)
 {
-    const std::string sql = "ROLLBACK";
-    return executeSync(sql);
+    pool = &connectionPool;
+    // A transaction reads its own writes, and anything that may write belongs on the primary
+    const auto router = allowReplica ? replicaRouter() : nullptr;
+    if (!router || m_transactions.current() || !Abstracts::PoolRouter::isReadOnly(sql)) {
+        return acquireConnection(lease);
+    }
+    // Only PostgreSqlConnectionPools are handed to the router
+    pool = static_cast<PostgreSqlConnectionPool*>(&router->readPool(m_lastWriteAt.load(std::memory_order_relaxed)));
+    lease = Abstracts::ConnectionLease(*pool);
+    return lease.get<PostgreSqlPtr>();
 }
 
-bool PostgreSqlDatabaseConnection::executeSync(const std::string& sql)
+void PostgreSqlDatabaseConnection::setReplicas(const std::vector<std::reference_wrapper<PostgreSqlConnectionPool>>& replicas,
+                                               const Abstracts::ReplicaRoutingOptions& options)
 {
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<PostgreSqlPtr>(connection))
-    {
-        // Failed to acquire a valid connection from the pool
-        // Handle the error accordingly
-        return false;
+    std::shared_ptr<Abstracts::PoolRouter> router;
+    if (!replicas.empty()) {
+        std::vector<Abstracts::ConnectionPool*> pools;
+        pools.reserve(replicas.size());
+        for (PostgreSqlConnectionPool& replica : replicas) {
+            pools.push_back(&replica);
+        }
+        router = std::make_shared<Abstracts::PoolRouter>(connectionPool, std::move(pools), options);
     }
 
-    PostgreSqlPtr postgresConnection = std::get<PostgreSqlPtr>(connection);
+    // Readers switch from one router to the other without seeing none; the old one, and its probe thread,
+    // stop once the last read that picked it has its connection
+    std::lock_guard<std::mutex> lock(m_routerMutex);
+    m_router.swap(router);
+}
 
-    // Execute the SQL statement
-    PGresult* result = PQexec(postgresConnection, sql.c_str());
+std::shared_ptr<Abstracts::PoolRouter> PostgreSqlDatabaseConnection::replicaRouter() const
+{
+    std::lock_guard<std::mutex> lock(m_routerMutex);
+    return m_router;
+}
 
-    if (PQresultStatus(result) == PGRES_COMMAND_OK)
-    {
-        PQclear(result);
+std::vector<Abstracts::ReplicaStatus> PostgreSqlDatabaseConnection::replicaStatus() const
+{
+    const auto router = replicaRouter();
+    return router ? router->status() : std::vector<Abstracts::ReplicaStatus> {};
+}
 
-        // Release the connection back to the pool
-        connectionPool.releaseConnection(postgresConnection);
+void PostgreSqlDatabaseConnection::recordWrite(const std::optional<std::vector<std::string>>& tables)
+{
+    // Invalidated now for the statements that do not join the transaction, and again on commit
+    invalidateCached(*queryCache(), tables);
+    m_lastWriteAt.store(std::chrono::steady_clock::now(), std::memory_order_relaxed);
 
-        return true; // SQL statement executed successfully
+    if (auto* pinned = m_transactions.current()) {
+        if (tables) {
+            pinned->writtenTables.insert(pinned->writtenTables.end(), tables->begin(), tables->end());
+        } else {
+            pinned->writtenUnknown = true;
+        }
     }
-    else
-    {
-        // Handle the error if the SQL statement failed to execute
-        const char* errorMessage = PQerrorMessage(postgresConnection);
-        // You can set an error message or perform additional error handling here
-        PQclear(result);
+}
 
-        // Release the connection back to the pool
-        connectionPool.releaseConnection(postgresConnection);
+bool PostgreSqlDatabaseConnection::executeSync(const std::string& sql)
+{
+    // Statements issued between beginTransaction() and commit/rollback run on the pinned connection
+    if (auto* pinned = m_transactions.current()) {
+        try {
+            pinned->transaction.execute(sql);
+            recordWrite(Abstracts::QueryCache::tablesWrittenBy(sql));
+            return true;
+        } catch (const std::exception& e) {
+            setLastError(e.what());
+            return false;
+        }
+    }
 
+    try {
+        Abstracts::ConnectionLease lease = leaseConnection();
+        executeOnPostgreSql(lease.connection(), sql);
+        recordWrite(Abstracts::QueryCache::tablesWrittenBy(sql));
+        return true;
+    } catch (const std::exception& e) {
+        setLastError(e.what());
         return false;
     }
 }
 
 std::future<bool> PostgreSqlDatabaseConnection::executeAsync(const std::string& sql)
 {
-    return std::async(std::launch::async, [this, sql]() {
-        return executeSync(sql);
-    });
+    // Get a connection from the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    PostgreSqlPtr postgresqlConnection = acquireConnection(lease);
+    // The cache is invalidated once the write has completed; inside a transaction (no lease taken), again on commit
+    auto tables = Abstracts::QueryCache::tablesWrittenBy(sql);
+    if (!lease) {
+        recordWrite(tables);
+    }
+    return submitConverted(m_reactor, std::move(lease), postgresqlConnection, sql, {}, m_PostgreSqlData, false,
+                           [this, cache = queryCache(), tables = std::move(tables)](const Abstracts::ResultSet&) {
+                               invalidateCached(*cache, tables);
+                               m_lastWriteAt.store(std::chrono::steady_clock::now(), std::memory_order_relaxed);
+                               return true;
+                           });
 }
 
 bool PostgreSqlDatabaseConnection::executeBatchSync(const std::vector<std::string>& sqlBatch)
 {
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<PostgreSqlPtr>(connection))
-    {
-        // Failed to acquire a valid connection from the pool
-        // Handle the error accordingly
-        return false;
-    }
-
-    PostgreSqlPtr postgresConnection = std::get<PostgreSqlPtr>(connection);
-
-    // Start a transaction
-    PQexec(postgresConnection, "BEGIN");
-
-    // Execute each SQL statement in the batch
-    for (const std::string& sql : sqlBatch)
-    {
-        PGresult* result = PQexec(postgresConnection, sql.c_str());
-
-        if (PQresultStatus(result) != PGRES_COMMAND_OK)
-        {
-            // Handle the error if any statement failed to execute
-            const char* errorMessage = PQerrorMessage(postgresConnection);
-            // You can set an error message or perform additional error handling here
-            PQclear(result);
-
-            // Rollback the transaction
-            PQexec(postgresConnection, "ROLLBACK");
-
-            // Release the connection back to the pool
-            connectionPool.releaseConnection(postgresConnection);
-
-            return false;
+    try {
+        queryPipelined(sqlBatch);
+        for (const std::string& sql : sqlBatch) {
+            recordWrite(Abstracts::QueryCache::tablesWrittenBy(sql));
         }
-
-        PQclear(result);
+        return true;
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return false;
     }
-
-    // Commit the transaction
-    PQexec(postgresConnection, "COMMIT");
-
-    // Release the connection back to the pool
-    connectionPool.releaseConnection(postgresConnection);
-
-    return true; // All SQL statements executed successfully
 }
 
 std::future<bool> PostgreSqlDatabaseConnection::executeBatchAsync(const std::vector<std::string>& sqlBatch)
@@ -484,16 +906,9 @@ std::future<bool> PostgreSqlDatabaseConnection::executeBatchAsync(const std::vec
 
 bool PostgreSqlDatabaseConnection::executeProcedureSync(const std::string& procedure)
 {
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<PostgreSqlPtr>(connection))
-    {
-        // Failed to acquire a valid connection from the pool
-        // Handle the error accordingly
-        return false;
-    }
-
-    PostgreSqlPtr postgresConnection = std::get<PostgreSqlPtr>(connection);
+    // Get a connection from the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    PostgreSqlPtr postgresConnection = acquireConnection(lease);
 
     // Execute the stored procedure
     PGresult* result = PQexec(postgresConnection, procedure.c_str());
@@ -505,17 +920,13 @@ bool PostgreSqlDatabaseConnection::executeProcedureSync(const std::string& proce
         // You can set an error message or perform additional error handling here
         PQclear(result);
 
-        // Release the connection back to the pool
-        connectionPool.releaseConnection(postgresConnection);
-
         return false;
     }
 
     PQclear(result);
 
-    // Release the connection back to the pool
-    connectionPool.releaseConnection(postgresConnection);
-
+    // A procedure may write any table
+    recordWrite(std::nullopt);
     return true; // The procedure executed successfully
 }
 
@@ -529,73 +940,117 @@ std::future<bool> PostgreSqlDatabaseConnection::executeProcedureAsync(const std:
 
 std::vector<std::vector<std::string>> PostgreSqlDatabaseConnection::querySync(const std::string& sql)
 {
-    std::vector<std::vector<std::string>> result;
-
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<PostgreSqlPtr>(connection)) {
-        return result;  // Invalid connection
+    try {
+        // Row 0 holds the column names and NULL reads as an empty string, as callers expect
+        return queryResult(sql)->toRows(true);
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return {};
     }
+}
 
-    PostgreSqlPtr postgresqlConnection = std::get<PostgreSqlPtr>(connection);
+Abstracts::ResultSetPtr PostgreSqlDatabaseConnection::queryResult(const std::string& sql, const std::vector<std::string>& params, Abstracts::ResultFormat format)
+{
+    return readResult(sql, params, format, true);
+}
 
-    // Execute the SQL query
-    PGresult* queryResult = PQexec(postgresqlConnection, sql.c_str());
+Abstracts::ResultSetPtr PostgreSqlDatabaseConnection::readResult(const std::string& sql, const std::vector<std::string>& params, Abstracts::ResultFormat format,
+                                                                 bool allowReplica)
+{
+    // Get a connection from a replica, the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    PostgreSqlConnectionPool* pool = nullptr;
+    PostgreSqlPtr postgresqlConnection = acquireReadConnection(sql, lease, pool, allowReplica);
 
-    // Check if the query execution was successful
-    if (PQresultStatus(queryResult) != PGRES_TUPLES_OK) {
-        // Query execution failed
-        PQclear(queryResult);
-        connectionPool.releaseConnection(postgresqlConnection);
-        return result;
+    // The simple query protocol only returns text; anything else goes through a prepared statement
+    PostgreSqlResult result = params.empty() && format == Abstracts::ResultFormat::Text
+                                  ? PostgreSqlResult(PQexec(postgresqlConnection, sql.c_str()), &PQclear)
+                                  : executeCached(*pool, postgresqlConnection, sql, params, format);
+    if (PQresultStatus(result.get()) != PGRES_TUPLES_OK) {
+        throw Exception(Exception::Reason::Database, PQresultErrorMessage(result.get())).getRuntimeError();
     }
+    return std::make_unique<PostgreSqlResultSet>(result.release(), format);
+}
 
-    // Get the number of rows and columns in the result set
-    int numRows = PQntuples(queryResult);
-    int numCols = PQnfields(queryResult);
-
-    // Fetch the column names
-    std::vector<std::string> columnNames;
-    for (int col = 0; col < numCols; ++col) {
-        columnNames.push_back(PQfname(queryResult, col));
-    }
-    result.push_back(columnNames);
+std::future<Abstracts::ResultSetPtr> PostgreSqlDatabaseConnection::queryResultAsync(const std::string& sql, const std::vector<std::string>& params, Abstracts::ResultFormat format)
+{
+    // Get a connection from a replica, the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    PostgreSqlConnectionPool* pool = nullptr;
+    PostgreSqlPtr postgresqlConnection = acquireReadConnection(sql, lease, pool);
+    return m_reactor.submit(std::move(lease), postgresqlConnection, sql, params, format);
+}
 
-    // Fetch the row data
-    for (int row = 0; row < numRows; ++row) {
-        std::vector<std::string> rowData;
-        for (int col = 0; col < numCols; ++col) {
-            rowData.push_back(PQgetvalue(queryResult, row, col));
-        }
-        result.push_back(rowData);
-    }
+Abstracts::CursorPtr PostgreSqlDatabaseConnection::openCursor(const std::string& sql, const std::vector<std::string>& params, const Abstracts::CursorOptions& options)
+{
+    // Get a connection from the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    PostgreSqlPtr postgresqlConnection = acquireConnection(lease);
+    return std::make_unique<PostgreSqlCursor>(std::move(lease), postgresqlConnection, sql, params, options);
+}
 
-    // Release the query result
-    PQclear(queryResult);
+std::unique_ptr<PostgreSqlCopyIn> PostgreSqlDatabaseConnection::openCopyIn(const std::string& tableName, const PostgreSqlCopyOptions& options)
+{
+    // Get a connection from the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    PostgreSqlPtr postgresqlConnection = acquireConnection(lease);
+    auto writer = std::make_unique<PostgreSqlCopyIn>(std::move(lease), postgresqlConnection, tableName, options);
+    recordWrite(std::vector<std::string> { tableName });
+    return writer;
+}
 
-    // Release the connection back to the pool
-    connectionPool.releaseConnection(postgresqlConnection);
+std::uint64_t PostgreSqlDatabaseConnection::copyIn(const std::string& tableName, const std::vector<std::vector<std::string>>& rows, const PostgreSqlCopyOptions& options)
+{
+    auto writer = openCopyIn(tableName, options);
+    for (const auto& row : rows) {
+        writer->writeRow(row);
+    }
+    const std::uint64_t stored = writer->finish();
+    recordWrite(std::vector<std::string> { tableName });
+    return stored;
+}
 
-    return result;
+std::unique_ptr<PostgreSqlCopyOut> PostgreSqlDatabaseConnection::openCopyOut(const std::string& source, Abstracts::ResultFormat format)
+{
+    // Get a connection from the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    PostgreSqlPtr postgresqlConnection = acquireConnection(lease);
+    return std::make_unique<PostgreSqlCopyOut>(std::move(lease), postgresqlConnection, source, format);
 }
 
 std::future<std::vector<std::vector<std::string>>> PostgreSqlDatabaseConnection::queryAsync(const std::string& sql)
 {
-    return std::async(std::launch::async, [this, sql]() {
-        return querySync(sql);
-    });
+    // Get a connection from a replica, the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    PostgreSqlConnectionPool* pool = nullptr;
+    PostgreSqlPtr postgresqlConnection = acquireReadConnection(sql, lease, pool);
+    return submitConverted(m_reactor, std::move(lease), postgresqlConnection, sql, {}, m_PostgreSqlData, std::vector<std::vector<std::string>> {},
+                           [](const Abstracts::ResultSet& result) { return result.toRows(true); });
 }
 
-std::string PostgreSqlDatabaseConnection::escapeString(const std::string& str)
+std::vector<Abstracts::ResultSetPtr> PostgreSqlDatabaseConnection::queryPipelined(const std::vector<std::string>& statements)
 {
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<PostgreSqlPtr>(connection)) {
-        // Handle invalid connection pool error
-        return "";
+    // Get a connection from the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    PostgreSqlPtr postgresqlConnection = acquireConnection(lease);
+
+    PostgreSqlPipeline pipeline(postgresqlConnection);
+    for (const auto& sql : statements) {
+        pipeline.add(sql);
     }
+    return pipeline.sync();
+}
 
-    PostgreSqlPtr pgConnection = std::get<PostgreSqlPtr>(connection);
+std::size_t PostgreSqlDatabaseConnection::pendingAsyncQueries() const
+{
+    return m_reactor.pending();
+}
+
+std::string PostgreSqlDatabaseConnection::escapeString(const std::string& str)
+{
+    // Inside a transaction the pinned connection escapes too, rather than waiting for a second one
+    Abstracts::ConnectionLease lease;
+    PostgreSqlPtr pgConnection = acquireConnection(lease);
 
     // Allocate memory for the escaped string
     std::unique_ptr<char, decltype(&PQfreemem)> escapedStr(
@@ -609,9 +1064,6 @@ std::string PostgreSqlDatabaseConnection::escapeString(const std::string& str)
     // Convert the escaped string to std::string
     std::string escapedString(escapedStr.get());
 
-    // Release the connection back to the pool
-    connectionPool.releaseConnection(pgConnection);
-
     return escapedString;
 }
 
@@ -645,75 +1097,79 @@ std::vector<std::vector<std::string>> PostgreSqlDatabaseConnection::queryWithPar
 {
     std::vector<std::vector<std::string>> resultRows;
 
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<PostgreSqlPtr>(connection)) {
-        // Handle invalid connection pool error
+    // Get a connection from a replica, the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    PostgreSqlConnectionPool* pool = nullptr;
+    PostgreSqlPtr pgConnection = acquireReadConnection(sql, lease, pool);
+
+    PostgreSqlResult execResult = executeCached(*pool, pgConnection, sql, params);
+    if (PQresultStatus(execResult.get()) != PGRES_TUPLES_OK) {
+        setLastError(PQresultErrorMessage(execResult.get()));
         return resultRows;
     }
 
-    PostgreSqlPtr pgConnection = std::get<PostgreSqlPtr>(connection);
-
-    // Prepare the statement
-    const char* stmtName = "";
-    int numParams = static_cast<int>(params.size());
-    const Oid* paramTypes = nullptr;
-    const int* paramLengths = nullptr;
-    const int* paramFormats = nullptr;
-    int resultFormat = 0;  // 0 means text format
-    PGresult* prepareResult = PQprepare(pgConnection, stmtName, sql.c_str(), numParams, paramTypes);
-    if (PQresultStatus(prepareResult) != PGRES_COMMAND_OK) {
-        // Handle error in preparing the statement
-        PQclear(prepareResult);
-        connectionPool.releaseConnection(pgConnection);
-        return resultRows;
-    }
-    PQclear(prepareResult);
-
-    // Convert the parameters to an array of const char*
-    std::vector<const char*> paramValues(params.size());
-    std::vector<int> paramLengthsVec(params.size());
-    std::vector<int> paramFormatsVec(params.size(), 0);  // 0 means text format
-    for (size_t i = 0; i < params.size(); ++i) {
-        paramValues[i] = params[i].c_str();
-        paramLengthsVec[i] = static_cast<int>(params[i].length());
-    }
-
-    // Execute the statement with the parameters
-    PGresult* execResult = PQexecPrepared(pgConnection, stmtName, numParams, paramValues.data(), paramLengthsVec.data(), paramFormatsVec.data(), resultFormat);
-    if (PQresultStatus(execResult) != PGRES_TUPLES_OK) {
-        // Handle error in executing the statement
-        PQclear(execResult);
-        connectionPool.releaseConnection(pgConnection);
-        return resultRows;
-    }
-
-    // Fetch the result rows and store them in the resultRows vector
-    int numRows = PQntuples(execResult);
-    int numCols = PQnfields(execResult);
+    // Fetch the result rows and store them in the resultRows vector
+    const int numRows = PQntuples(execResult.get());
+    const int numCols = PQnfields(execResult.get());
+    resultRows.reserve(numRows);
 
     for (int row = 0; row < numRows; ++row) {
         std::vector<std::string> resultRow;
+        resultRow.reserve(numCols);
         for (int col = 0; col < numCols; ++col) {
-            char* value = PQgetvalue(execResult, row, col);
-            resultRow.push_back(value ? value : "");
+            resultRow.emplace_back(PQgetvalue(execResult.get(), row, col), PQgetlength(execResult.get(), row, col));
         }
-        resultRows.push_back(resultRow);
+        resultRows.push_back(std::move(resultRow));
     }
 
-    PQclear(execResult);
-
-    // Release the connection back to the pool
-    connectionPool.releaseConnection(pgConnection);
-
     return resultRows;
 }
 
 std::future<std::vector<std::vector<std::string>>> PostgreSqlDatabaseConnection::queryWithParamsAsync(const std::string& sql, const std::vector<std::string>& params)
 {
-    return std::async(std::launch::async, [this, sql, params]() {
-        return queryWithParamsSync(sql, params);
-    });
+    // Get a connection from a replica, the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    PostgreSqlConnectionPool* pool = nullptr;
+    PostgreSqlPtr postgresqlConnection = acquireReadConnection(sql, lease, pool);
+    return submitConverted(m_reactor, std::move(lease), postgresqlConnection, sql, params, m_PostgreSqlData, std::vector<std::vector<std::string>> {},
+                           [](const Abstracts::ResultSet& result) { return result.toRows(false); });
+}
+
+std::vector<std::vector<std::string>> PostgreSqlDatabaseConnection::queryCached(const std::string& sql,
+                                                                                const std::vector<std::string>& params,
+                                                                                const Abstracts::QueryCacheOptions& options)
+{
+    // Inside a transaction the live data is read, including the transaction's own writes
+    if (m_transactions.current()) {
+        return params.empty() ? querySync(sql) : queryWithParamsSync(sql, params);
+    }
+
+    try {
+        // Rows are shaped like querySync() and queryWithParamsSync() return them. A replica may not have
+        // replayed the write that invalidated the entry yet, so misses are loaded from the primary
+        const auto rows = queryCache()->getOrLoad(sql, params, options, [this, &sql, &params]() {
+            return readResult(sql, params, Abstracts::ResultFormat::Text, false)->toRows(params.empty());
+        });
+        return *rows;
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return {};
+    }
+}
+
+void PostgreSqlDatabaseConnection::setQueryCache(std::shared_ptr<Abstracts::QueryCache> cache)
+{
+    if (!cache) {
+        throw std::invalid_argument("The query cache must not be null.");
+    }
+    std::lock_guard<std::mutex> lock(m_PostgreSqlData.cacheMutex);
+    m_PostgreSqlData.queryCache = std::move(cache);
+}
+
+std::shared_ptr<Abstracts::QueryCache> PostgreSqlDatabaseConnection::queryCache() const
+{
+    std::lock_guard<std::mutex> lock(m_PostgreSqlData.cacheMutex);
+    return m_PostgreSqlData.queryCache;
 }
 
 std::string PostgreSqlDatabaseConnection::sanitizeInput(const std::string& input)
@@ -754,114 +1210,86 @@ std::string PostgreSqlDatabaseConnection::sanitizeInput(const std::string& input
 
 bool PostgreSqlDatabaseConnection::executeWithParamsSync(const std::string& sql, const std::vector<std::string>& params)
 {
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<PostgreSqlPtr>(connection)) {
-        // Handle the error, return false, or throw an exception
-        return false;
-    }
-
-    PostgreSqlPtr postgresqlConnection = std::get<PostgreSqlPtr>(connection);
+    // Get a connection from the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    PostgreSqlPtr postgresqlConnection = acquireConnection(lease);
 
-    // Convert the parameter values to const char* array
-    std::vector<const char*> paramValues;
-    std::vector<int> paramLengths;
-    std::vector<int> paramFormats;
-    for (const std::string& param : params) {
-        paramValues.push_back(param.c_str());
-        paramLengths.push_back(static_cast<int>(param.length()));
-        paramFormats.push_back(1); // Binary format
-    }
-
-    // Execute the SQL statement with the parameters
-    PGresult* result = PQexecParams(postgresqlConnection, sql.c_str(), params.size(), NULL, paramValues.data(), paramLengths.data(), paramFormats.data(), 0);
-    if (PQresultStatus(result) != PGRES_COMMAND_OK) {
-        PQclear(result);
-        connectionPool.releaseConnection(postgresqlConnection);  // Release the connection back to the pool
-        // Handle the error, return false, or throw an exception
+    PostgreSqlResult result = executeCached(connectionPool, postgresqlConnection, sql, params);
+    const auto status = PQresultStatus(result.get());
+    if (status != PGRES_COMMAND_OK && status != PGRES_TUPLES_OK) {
+        setLastError(PQresultErrorMessage(result.get()));
         return false;
     }
-
-    PQclear(result);
-    connectionPool.releaseConnection(postgresqlConnection);  // Release the connection back to the pool
+    recordWrite(Abstracts::QueryCache::tablesWrittenBy(sql));
     return true;
 }
 
 std::future<bool> PostgreSqlDatabaseConnection::executeWithParamsAsync(const std::string& sql, const std::vector<std::string>& params)
 {
-    return std::async(std::launch::async, [this, sql, params]() {
-        return executeWithParamsSync(sql, params);
-    });
+    // Get a connection from the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    PostgreSqlPtr postgresqlConnection = acquireConnection(lease);
+    // The cache is invalidated once the write has completed; inside a transaction (no lease taken), again on commit
+    auto tables = Abstracts::QueryCache::tablesWrittenBy(sql);
+    if (!lease) {
+        recordWrite(tables);
+    }
+    return submitConverted(m_reactor, std::move(lease), postgresqlConnection, sql, params, m_PostgreSqlData, false,
+                           [this, cache = queryCache(), tables = std::move(tables)](const Abstracts::ResultSet&) {
+                               invalidateCached(*cache, tables);
+                               m_lastWriteAt.store(std::chrono::steady_clock::now(), std::memory_order_relaxed);
+                               return true;
+                           });
 }
 
 bool PostgreSqlDatabaseConnection::executeBatchWithParamsSync(const std::string& sql, const std::vector<std::vector<std::string>>& paramsBatch)
 {
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<PostgreSqlPtr>(connection)) {
-        // Handle invalid connection from the pool
-        return false;
-    }
-
-    PostgreSqlPtr postgreSqlConnection = std::get<PostgreSqlPtr>(connection);
-
-    // Begin the transaction
-    if (PQtransactionStatus(postgreSqlConnection) != PQTRANS_ACTIVE) {
-        if (PQexec(postgreSqlConnection, "BEGIN") == nullptr) {
-            // Handle transaction start failure
-            connectionPool.releaseConnection(postgreSqlConnection);  // Release the connection back to the pool
-            return false;
-        }
-    }
-
-    // Prepare the statement
-    PGresult* result = PQprepare(postgreSqlConnection, "", sql.c_str(), 0, nullptr);
-    if (result == nullptr || PQresultStatus(result) != PGRES_COMMAND_OK) {
-        // Handle statement preparation failure
-        PQclear(result);
-        connectionPool.releaseConnection(postgreSqlConnection);  // Release the connection back to the pool
-        return false;
+    if (paramsBatch.empty()) {
+        return true;
     }
-    PQclear(result);
 
-    // Execute the prepared statement for each set of parameters in the batch
-    for (const auto& params : paramsBatch) {
-        const int paramCount = params.size();
-        const char** paramValues = new const char*[paramCount];
-        int* paramLengths = new int[paramCount];
-        int* paramFormats = new int[paramCount];
-
-        for (int i = 0; i < paramCount; ++i) {
-            paramValues[i] = params[i].c_str();
-            paramLengths[i] = params[i].length();
-            paramFormats[i] = 0;  // Treat all parameters as text
-        }
+    // Get a connection from the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    PostgreSqlPtr postgreSqlConnection = acquireConnection(lease);
 
-        result = PQexecPrepared(postgreSqlConnection, "", paramCount, paramValues, paramLengths, paramFormats, 0);
-        delete[] paramValues;
-        delete[] paramLengths;
-        delete[] paramFormats;
-
-        if (result == nullptr || PQresultStatus(result) != PGRES_COMMAND_OK) {
-            // Handle statement execution failure
-            PQclear(result);
-            connectionPool.releaseConnection(postgreSqlConnection);  // Release the connection back to the pool
-            return false;
-        }
-        PQclear(result);
-    }
+    auto& cache = connectionPool.statementCache(postgreSqlConnection);
+    const int count = static_cast<int>(paramsBatch.front().size());
+    for (int attempt = 0;; ++attempt) {
+        try {
+            // The statement is prepared once; every row is then bound and executed within a single round trip
+            std::string* name = cache.find(sql);
+            if (!name) {
+                std::string fresh = "cell_stmt_" + std::to_string(cache.nextSequence());
+                PostgreSqlResult prepared(PQprepare(postgreSqlConnection, fresh.c_str(), sql.c_str(), count, __cell_nullptr), &PQclear);
+                if (PQresultStatus(prepared.get()) != PGRES_COMMAND_OK) {
+                    throw Exception(Exception::Reason::Database, PQresultErrorMessage(prepared.get())).getRuntimeError();
+                }
+                name = &cache.insert(sql, std::move(fresh));
+            }
 
-    // Commit the transaction
-    if (PQtransactionStatus(postgreSqlConnection) == PQTRANS_ACTIVE) {
-        if (PQexec(postgreSqlConnection, "COMMIT") == nullptr) {
-            // Handle transaction commit failure
-            connectionPool.releaseConnection(postgreSqlConnection);  // Release the connection back to the pool
+            PostgreSqlPipeline pipeline(postgreSqlConnection);
+            for (const auto& params : paramsBatch) {
+                pipeline.addPrepared(*name, params);
+            }
+            try {
+                pipeline.sync();
+            } catch (const std::exception&) {
+                // A stale statement is dropped; outside a transaction nothing ran, so the batch is sent again once
+                if (isStalePreparedStatement(pipeline.lastSqlState(), pipeline.lastErrorMessage())) {
+                    cache.invalidate(sql);
+                    if (attempt == 0 && PQtransactionStatus(postgreSqlConnection) == PQTRANS_IDLE) {
+                        continue;
+                    }
+                }
+                throw;
+            }
+            recordWrite(Abstracts::QueryCache::tablesWrittenBy(sql));
+            return true;
+        } catch (const std::exception& e) {
+            setLastError(e.what());
             return false;
         }
     }
-
-    connectionPool.releaseConnection(postgreSqlConnection);  // Release the connection back to the pool
-    return true;
 }
 
 std::future<bool> PostgreSqlDatabaseConnection::executeBatchWithParamsAsync(const std::string& sql, const std::vector<std::vector<std::string>>& paramsBatch)
@@ -883,21 +1311,15 @@ bool PostgreSqlDatabaseConnection::executeProcedureWithParamsSync(const std::str
     }
     sql += ")";
 
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<PostgreSqlPtr>(connection)) {
-        // Handle invalid connection
-        return false;
-    }
-
-    PostgreSqlPtr postgreSqlConnection = std::get<PostgreSqlPtr>(connection);
+    // Get a connection from the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    PostgreSqlPtr postgreSqlConnection = acquireConnection(lease);
 
     // Execute the procedure
     auto result = PQexec(postgreSqlConnection, sql.c_str());
     if (PQresultStatus(result) != PGRES_COMMAND_OK) {
         // Handle execution error
         PQclear(result);
-        connectionPool.releaseConnection(postgreSqlConnection);  // Release the connection back to the pool
         return false;
     }
 
@@ -907,7 +1329,9 @@ bool PostgreSqlDatabaseConnection::executeProcedureWithParamsSync(const std::str
     }
 
     PQclear(result);
-    connectionPool.releaseConnection(postgreSqlConnection);  // Release the connection back to the pool
+
+    // A procedure may write any table
+    recordWrite(std::nullopt);
     return true;
 }
 
@@ -918,191 +1342,102 @@ std::future<bool> PostgreSqlDatabaseConnection::executeProcedureWithParamsAsync(
     });
 }
 
-std::vector<std::string> PostgreSqlDatabaseConnection::getTableNames()
+Abstracts::SchemaSnapshotPtr PostgreSqlDatabaseConnection::schema()
 {
-    std::vector<std::string> tableNames;
-
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<PostgreSqlPtr>(connection)) {
-        // Handle invalid connection
-        return tableNames;
-    }
-
-    PostgreSqlPtr postgreSqlConnection = std::get<PostgreSqlPtr>(connection);
-
-    // Retrieve the table names using a query
-    std::string query = "SELECT table_name FROM information_schema.tables WHERE table_schema = 'public'";
+    return connectionPool.schemaCatalog().snapshot([this]() {
+        // A connection of its own, never the pinned one: the catalog is shared and must not see uncommitted DDL
+        Abstracts::ConnectionLease lease = leaseConnection();
+        PostgreSqlResult result(PQexec(lease.get<PostgreSqlPtr>(), postgreSqlSchemaCatalog), &PQclear);
+        if (PQresultStatus(result.get()) != PGRES_TUPLES_OK) {
+            throw Exception(Exception::Reason::Database, PQresultErrorMessage(result.get())).getRuntimeError();
+        }
+        return Abstracts::SchemaCatalog::parse(PostgreSqlResultSet(result.release(), Abstracts::ResultFormat::Text));
+    });
+}
 
-    auto result = PQexec(postgreSqlConnection, query.c_str());
-    if (PQresultStatus(result) != PGRES_TUPLES_OK) {
-        // Handle query error
-        PQclear(result);
-        connectionPool.releaseConnection(postgreSqlConnection);  // Release the connection back to the pool
-        return tableNames;
+void PostgreSqlDatabaseConnection::recordSchemaChange()
+{
+    connectionPool.schemaCatalog().invalidate();
+    // DDL runs on the pinned connection, so other connections keep seeing the old schema until the transaction commits
+    if (auto* pinned = m_transactions.current()) {
+        pinned->schemaChanged = true;
     }
+}
 
-    int rowCount = PQntuples(result);
-    for (int i = 0; i < rowCount; ++i) {
-        char* tableName = PQgetvalue(result, i, 0);
-        tableNames.push_back(tableName);
+std::vector<std::string> PostgreSqlDatabaseConnection::getTableNames()
+{
+    try {
+        return schema()->tableNames();
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return {};
     }
-
-    PQclear(result);
-    connectionPool.releaseConnection(postgreSqlConnection);  // Release the connection back to the pool
-    return tableNames;
 }
 
 std::vector<std::string> PostgreSqlDatabaseConnection::getTableColumns(const std::string& tableName)
 {
     std::vector<std::string> columnNames;
-
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<PostgreSqlPtr>(connection)) {
-        // Handle invalid connection
-        return columnNames;
-    }
-
-    PostgreSqlPtr postgreSqlConnection = std::get<PostgreSqlPtr>(connection);
-
-    // Retrieve the column names using a query
-    std::string query = "SELECT column_name FROM information_schema.columns WHERE table_name = '" + tableName + "'";
-
-    auto result = PQexec(postgreSqlConnection, query.c_str());
-    if (PQresultStatus(result) != PGRES_TUPLES_OK) {
-        // Handle query error
-        PQclear(result);
-        connectionPool.releaseConnection(postgreSqlConnection);  // Release the connection back to the pool
-        return columnNames;
-    }
-
-    int rowCount = PQntuples(result);
-    for (int i = 0; i < rowCount; ++i) {
-        char* columnName = PQgetvalue(result, i, 0);
-        columnNames.push_back(columnName);
+    try {
+        const auto snapshot = schema();
+        if (const auto* table = snapshot->table(tableName)) {
+            for (const auto& column : table->columns) {
+                columnNames.push_back(column.name);
+            }
+        }
+    } catch (const std::exception& e) {
+        setLastError(e.what());
     }
-
-    PQclear(result);
-    connectionPool.releaseConnection(postgreSqlConnection);  // Release the connection back to the pool
     return columnNames;
 }
 
 std::vector<std::string> PostgreSqlDatabaseConnection::getTableColumnTypes(const std::string& tableName)
 {
     std::vector<std::string> columnTypes;
-
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<PostgreSqlPtr>(connection)) {
-        // Handle invalid connection
-        return columnTypes;
-    }
-
-    PostgreSqlPtr postgreSqlConnection = std::get<PostgreSqlPtr>(connection);
-
-    // Retrieve the column types using a query
-    std::string query = "SELECT data_type FROM information_schema.columns WHERE table_name = '" + tableName + "'";
-
-    auto result = PQexec(postgreSqlConnection, query.c_str());
-    if (PQresultStatus(result) != PGRES_TUPLES_OK) {
-        // Handle query error
-        PQclear(result);
-        connectionPool.releaseConnection(postgreSqlConnection);  // Release the connection back to the pool
-        return columnTypes;
-    }
-
-    int rowCount = PQntuples(result);
-    for (int i = 0; i < rowCount; ++i) {
-        char* columnType = PQgetvalue(result, i, 0);
-        columnTypes.push_back(columnType);
+    try {
+        const auto snapshot = schema();
+        if (const auto* table = snapshot->table(tableName)) {
+            for (const auto& column : table->columns) {
+                columnTypes.push_back(column.type);
+            }
+        }
+    } catch (const std::exception& e) {
+        setLastError(e.what());
     }
-
-    PQclear(result);
-    connectionPool.releaseConnection(postgreSqlConnection);  // Release the connection back to the pool
     return columnTypes;
 }
 
 std::string PostgreSqlDatabaseConnection::getTablePrimaryKey(const std::string& tableName)
 {
-    std::string primaryKey;
-
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<PostgreSqlPtr>(connection)) {
-        // Handle invalid connection
-        return primaryKey;
+    try {
+        const auto snapshot = schema();
+        const auto* table = snapshot->table(tableName);
+        return table && !table->primaryKey.empty() ? table->primaryKey.front() : std::string();
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return {};
     }
-
-    PostgreSqlPtr postgreSqlConnection = std::get<PostgreSqlPtr>(connection);
-
-    // Retrieve the primary key using a query
-    std::string query = "SELECT column_name FROM information_schema.key_column_usage WHERE table_name = '" + tableName + "' AND constraint_name LIKE '%_pkey'";
-
-    auto result = PQexec(postgreSqlConnection, query.c_str());
-    if (PQresultStatus(result) != PGRES_TUPLES_OK) {
-        // Handle query error
-        PQclear(result);
-        connectionPool.releaseConnection(postgreSqlConnection);  // Release the connection back to the pool
-        return primaryKey;
-    }
-
-    int rowCount = PQntuples(result);
-    if (rowCount > 0) {
-        primaryKey = PQgetvalue(result, 0, 0);
-    }
-
-    PQclear(result);
-    connectionPool.releaseConnection(postgreSqlConnection);  // Release the connection back to the pool
-    return primaryKey;
 }
 
 
 std::pair<std::string, std::string> PostgreSqlDatabaseConnection::getTableForeignKey(const std::string& tableName, const std::string& foreignKey)
 {
-    std::pair<std::string, std::string> foreignKeyInfo;
-
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<PostgreSqlPtr>(connection)) {
-        // Handle invalid connection
-        return foreignKeyInfo;
-    }
-
-    PostgreSqlPtr postgreSqlConnection = std::get<PostgreSqlPtr>(connection);
-
-    // Retrieve foreign key information using a query
-    std::string query = "SELECT conname, conrelid::regclass, confrelid::regclass FROM pg_constraint WHERE conname = '" + foreignKey + "' AND conrelid::regclass = '" + tableName + "'";
-
-    auto result = PQexec(postgreSqlConnection, query.c_str());
-    if (PQresultStatus(result) != PGRES_TUPLES_OK) {
-        // Handle query error
-        PQclear(result);
-        connectionPool.releaseConnection(postgreSqlConnection);  // Release the connection back to the pool
-        return foreignKeyInfo;
-    }
-
-    int rowCount = PQntuples(result);
-    if (rowCount > 0) {
-        foreignKeyInfo.first = PQgetvalue(result, 0, 0);  // Constraint name
-        foreignKeyInfo.second = PQgetvalue(result, 0, 2);  // Referenced table name
+    try {
+        const auto snapshot = schema();
+        const auto* table = snapshot->table(tableName);
+        const auto* constraint = table ? table->foreignKey(foreignKey) : nullptr;
+        // Constraint name and referenced table name
+        return constraint ? std::make_pair(constraint->name, constraint->referencedTable) : std::pair<std::string, std::string> {};
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return {};
     }
-
-    PQclear(result);
-    connectionPool.releaseConnection(postgreSqlConnection);  // Release the connection back to the pool
-    return foreignKeyInfo;
 }
 
 bool PostgreSqlDatabaseConnection::createTable(const std::string& tableName, const std::vector<std::string>& columns)
 {
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<PostgreSqlPtr>(connection)) {
-        // Handle invalid connection
-        return false;
-    }
-
-    PostgreSqlPtr postgreSqlConnection = std::get<PostgreSqlPtr>(connection);
+    // Get a connection from the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    PostgreSqlPtr postgreSqlConnection = acquireConnection(lease);
 
     // Construct the CREATE TABLE statement
     std::string createStatement = "CREATE TABLE " + tableName + " (";
@@ -1118,25 +1453,19 @@ bool PostgreSqlDatabaseConnection::createTable(const std::string& tableName, con
     if (PQresultStatus(result) != PGRES_COMMAND_OK) {
         // Handle query error
         PQclear(result);
-        connectionPool.releaseConnection(postgreSqlConnection);  // Release the connection back to the pool
         return false;
     }
 
     PQclear(result);
-    connectionPool.releaseConnection(postgreSqlConnection);  // Release the connection back to the pool
+    recordSchemaChange();
     return true;
 }
 
 bool PostgreSqlDatabaseConnection::dropTable(const std::string& tableName)
 {
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<PostgreSqlPtr>(connection)) {
-        // Handle invalid connection
-        return false;
-    }
-
-    PostgreSqlPtr postgreSqlConnection = std::get<PostgreSqlPtr>(connection);
+    // Get a connection from the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    PostgreSqlPtr postgreSqlConnection = acquireConnection(lease);
 
     // Construct the DROP TABLE statement
     std::string dropStatement = "DROP TABLE IF EXISTS " + tableName;
@@ -1146,25 +1475,20 @@ bool PostgreSqlDatabaseConnection::dropTable(const std::string& tableName)
     if (PQresultStatus(result) != PGRES_COMMAND_OK) {
         // Handle query error
         PQclear(result);
-        connectionPool.releaseConnection(postgreSqlConnection);  // Release the connection back to the pool
         return false;
     }
 
     PQclear(result);
-    connectionPool.releaseConnection(postgreSqlConnection);  // Release the connection back to the pool
+    recordWrite(std::vector<std::string> { tableName });
+    recordSchemaChange();
     return true;
 }
 
 bool PostgreSqlDatabaseConnection::addColumn(const std::string& tableName, const std::string& columnName, const std::string& columnType)
 {
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<PostgreSqlPtr>(connection)) {
-        // Handle invalid connection
-        return false;
-    }
-
-    PostgreSqlPtr postgreSqlConnection = std::get<PostgreSqlPtr>(connection);
+    // Get a connection from the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    PostgreSqlPtr postgreSqlConnection = acquireConnection(lease);
 
     // Construct the ALTER TABLE statement to add the column
     std::string alterStatement = "ALTER TABLE " + tableName + " ADD COLUMN " + columnName + " " + columnType;
@@ -1174,25 +1498,20 @@ bool PostgreSqlDatabaseConnection::addColumn(const std::string& tableName, const
     if (PQresultStatus(result) != PGRES_COMMAND_OK) {
         // Handle query error
         PQclear(result);
-        connectionPool.releaseConnection(postgreSqlConnection);  // Release the connection back to the pool
         return false;
     }
 
     PQclear(result);
-    connectionPool.releaseConnection(postgreSqlConnection);  // Release the connection back to the pool
+    recordWrite(std::vector<std::string> { tableName });
+    recordSchemaChange();
     return true;
 }
 
 bool PostgreSqlDatabaseConnection::modifyColumn(const std::string& tableName, const std::string& columnName, const std::string& newColumnType)
 {
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<PostgreSqlPtr>(connection)) {
-        // Handle invalid connection
-        return false;
-    }
-
-    PostgreSqlPtr postgreSqlConnection = std::get<PostgreSqlPtr>(connection);
+    // Get a connection from the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    PostgreSqlPtr postgreSqlConnection = acquireConnection(lease);
 
     // Construct the ALTER TABLE statement to modify the column type
     std::string alterStatement = "ALTER TABLE " + tableName + " ALTER COLUMN " + columnName + " TYPE " + newColumnType;
@@ -1202,25 +1521,20 @@ bool PostgreSqlDatabaseConnection::modifyColumn(const std::string& tableName, co
     if (PQresultStatus(result) != PGRES_COMMAND_OK) {
         // Handle query error
         PQclear(result);
-        connectionPool.releaseConnection(postgreSqlConnection);  // Release the connection back to the pool
         return false;
     }
 
     PQclear(result);
-    connectionPool.releaseConnection(postgreSqlConnection);  // Release the connection back to the pool
+    recordWrite(std::vector<std::string> { tableName });
+    recordSchemaChange();
     return true;
 }
 
 bool PostgreSqlDatabaseConnection::renameColumn(const std::string& tableName, const std::string& columnName, const std::string& newColumnName)
 {
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<PostgreSqlPtr>(connection)) {
-        // Handle invalid connection
-        return false;
-    }
-
-    PostgreSqlPtr postgreSqlConnection = std::get<PostgreSqlPtr>(connection);
+    // Get a connection from the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    PostgreSqlPtr postgreSqlConnection = acquireConnection(lease);
 
     // Construct the ALTER TABLE statement to rename the column
     std::string alterStatement = "ALTER TABLE " + tableName + " RENAME COLUMN " + columnName + " TO " + newColumnName;
@@ -1230,25 +1544,20 @@ bool PostgreSqlDatabaseConnection::renameColumn(const std::string& tableName, co
     if (PQresultStatus(result) != PGRES_COMMAND_OK) {
         // Handle query error
         PQclear(result);
-        connectionPool.releaseConnection(postgreSqlConnection);  // Release the connection back to the pool
         return false;
     }
 
     PQclear(result);
-    connectionPool.releaseConnection(postgreSqlConnection);  // Release the connection back to the pool
+    recordWrite(std::vector<std::string> { tableName });
+    recordSchemaChange();
     return true;
 }
 
 bool PostgreSqlDatabaseConnection::deleteColumn(const std::string& tableName, const std::string& columnName)
 {
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<PostgreSqlPtr>(connection)) {
-        // Handle invalid connection
-        return false;
-    }
-
-    PostgreSqlPtr postgreSqlConnection = std::get<PostgreSqlPtr>(connection);
+    // Get a connection from the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    PostgreSqlPtr postgreSqlConnection = acquireConnection(lease);
 
     // Construct the ALTER TABLE statement to drop the column
     std::string alterStatement = "ALTER TABLE " + tableName + " DROP COLUMN " + columnName;
@@ -1258,37 +1567,30 @@ bool PostgreSqlDatabaseConnection::deleteColumn(const std::string& tableName, co
     if (PQresultStatus(result) != PGRES_COMMAND_OK) {
         // Handle query error
         PQclear(result);
-        connectionPool.releaseConnection(postgreSqlConnection);  // Release the connection back to the pool
         return false;
     }
 
     PQclear(result);
-    connectionPool.releaseConnection(postgreSqlConnection);  // Release the connection back to the pool
+    recordWrite(std::vector<std::string> { tableName });
+    recordSchemaChange();
     return true;
 }
 
 bool PostgreSqlDatabaseConnection::optimizeIndexes()
 {
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<PostgreSqlPtr>(connection)) {
-        // Handle invalid connection
-        return false;
-    }
-
-    PostgreSqlPtr postgreSqlConnection = std::get<PostgreSqlPtr>(connection);
+    // Get a connection from the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    PostgreSqlPtr postgreSqlConnection = acquireConnection(lease);
 
     // Execute the VACUUM ANALYZE command to optimize indexes
     auto result = PQexec(postgreSqlConnection, "VACUUM ANALYZE");
     if (PQresultStatus(result) != PGRES_COMMAND_OK) {
         // Handle query error
         PQclear(result);
-        connectionPool.releaseConnection(postgreSqlConnection);  // Release the connection back to the pool
         return false;
     }
 
     PQclear(result);
-    connectionPool.releaseConnection(postgreSqlConnection);  // Release the connection back to the pool
     return true;
 }
 
@@ -1296,41 +1598,29 @@ bool PostgreSqlDatabaseConnection::optimizeIndexes()
 std::vector<std::string> PostgreSqlDatabaseConnection::getExistingIndexes(const std::string& tableName)
 {
     std::vector<std::string> indexes;
-
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<PostgreSqlPtr>(connection)) {
-        // Handle invalid connection
-        return indexes;
-    }
-
-    PostgreSqlPtr postgreSqlConnection = std::get<PostgreSqlPtr>(connection);
-
-    // Construct the query to retrieve the existing indexes
-    std::string query = "SELECT indexname FROM pg_indexes WHERE tablename = $1";
-    const char* paramValues[1] = { tableName.c_str() };
-    int paramLengths[1] = { static_cast<int>(tableName.length()) };
-    int paramFormats[1] = { 0 };
-
-    // Execute the query
-    auto result = PQexecParams(postgreSqlConnection, query.c_str(), 1, nullptr, paramValues, paramLengths, paramFormats, 0);
-    if (PQresultStatus(result) == PGRES_TUPLES_OK) {
-        // Retrieve the index names from the query result
-        int numRows = PQntuples(result);
-        for (int i = 0; i < numRows; ++i) {
-            indexes.push_back(PQgetvalue(result, i, 0));
+    try {
+        const auto snapshot = schema();
+        if (const auto* table = snapshot->table(tableName)) {
+            for (const auto& index : table->indexes) {
+                indexes.push_back(index.name);
+            }
         }
+    } catch (const std::exception& e) {
+        setLastError(e.what());
     }
-
-    PQclear(result);
-    connectionPool.releaseConnection(postgreSqlConnection);  // Release the connection back to the pool
     return indexes;
 }
 
 bool PostgreSqlDatabaseConnection::indexExists(const std::string& tableName, const std::string& indexName)
 {
-    std::vector<std::string> existingIndexes = getExistingIndexes(tableName);
-    return std::find(existingIndexes.begin(), existingIndexes.end(), indexName) != existingIndexes.end();
+    try {
+        const auto snapshot = schema();
+        const auto* table = snapshot->table(tableName);
+        return table && table->index(indexName);
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return false;
+    }
 }
 
 bool PostgreSqlDatabaseConnection::createIndex(const std::string& tableName, const std::string& indexName, const std::vector<std::string>& columns)
@@ -1343,14 +1633,22 @@ bool PostgreSqlDatabaseConnection::createIndex(const std::string& tableName, con
     indexColumns = indexColumns.substr(0, indexColumns.length() - 1);
 
     std::string query = "CREATE INDEX " + indexName + " ON " + tableName + " (" + indexColumns + ")";
-    return executeSync(query);
+    if (!executeSync(query)) {
+        return false;
+    }
+    recordSchemaChange();
+    return true;
 }
 
 
 bool PostgreSqlDatabaseConnection::dropIndex(const std::string& tableName, const std::string& indexName)
 {
     std::string query = "DROP INDEX IF EXISTS " + indexName + " ON " + tableName;
-    return executeSync(query);
+    if (!executeSync(query)) {
+        return false;
+    }
+    recordSchemaChange();
+    return true;
 }
 
 unsigned int PostgreSqlDatabaseConnection::getLastInsertID()
@@ -1388,133 +1686,47 @@ std::string PostgreSqlDatabaseConnection::generateDropIndexSQL(const std::string
 
 bool PostgreSqlDatabaseConnection::bulkInsert(const std::string& tableName, const std::vector<std::vector<std::string>>& data)
 {
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<PostgreSqlPtr>(connection)) {
-        // Handle the error
-        return false;
-    }
-
-    PostgreSqlPtr pgConnection = std::get<PostgreSqlPtr>(connection);
-
-    // Construct the INSERT statement
-    std::string insertStatement = "INSERT INTO " + tableName + " VALUES ";
-
-    // Construct the VALUES clause with placeholders
-    std::string valuesClause;
-    for (const auto& row : data)
-    {
-        valuesClause += "(";
-        for (const auto& columnValue : row)
-        {
-            std::string escapedValue = PQescapeLiteral(pgConnection, columnValue.c_str(), columnValue.length());
-            valuesClause += escapedValue;
-            valuesClause += ",";
-            PQfreemem(const_cast<char*>(escapedValue.c_str()));
-        }
-        valuesClause.pop_back(); // Remove the trailing comma
-        valuesClause += "),";
+    if (data.empty()) {
+        return true;
     }
-    valuesClause.pop_back(); // Remove the trailing comma
-
-    // Concatenate the INSERT statement and VALUES clause
-    insertStatement += valuesClause;
-
-    // Execute the bulk INSERT statement
-    PGresult* result = PQexec(pgConnection, insertStatement.c_str());
-    if (PQresultStatus(result) != PGRES_COMMAND_OK)
-    {
-        // Handle the error
-        std::string errorMessage = PQerrorMessage(pgConnection);
-        PQclear(result);
-        // Log or throw an exception with the error message
-
-        // Release the connection back to the pool
-        connectionPool.releaseConnection(pgConnection);
+    try {
+        copyIn(tableName, data);
+        return true;
+    } catch (const std::exception& e) {
+        setLastError(e.what());
         return false;
     }
-
-    PQclear(result);
-
-    // Release the connection back to the pool
-    connectionPool.releaseConnection(pgConnection);
-
-    return true;
 }
 
 bool PostgreSqlDatabaseConnection::bulkUpdate(const std::string& tableName, const std::vector<std::vector<std::string>>& data, const std::string& condition)
 {
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<PostgreSqlPtr>(connection)) {
-        // Handle the error
+    if (data.empty()) {
+        setLastError("No data was provided for the bulk update.");
         return false;
     }
 
-    PostgreSqlPtr pgConnection = std::get<PostgreSqlPtr>(connection);
-
-    // Construct the UPDATE statement
-    std::string updateStatement = "UPDATE " + tableName + " SET ";
-
-    // Get the column names
-    std::string columnNames;
-    for (const auto& column : data.front())
-    {
-        columnNames += column + ",";
-    }
-    columnNames.pop_back(); // Remove the trailing comma
-
-    // Construct the SET clause with column-value pairs
-    std::string setClause;
-    for (const auto& row : data)
-    {
-        setClause += "(";
-        for (const auto& columnValue : row)
-        {
-            std::string escapedValue = PQescapeLiteral(pgConnection, columnValue.c_str(), columnValue.length());
-            setClause += columnValue + " = " + escapedValue + ",";
-            PQfreemem(const_cast<char*>(escapedValue.c_str()));
+    // The values are bound as $1, $2, ... rather than spliced into the statement
+    std::string sql = std::string(POSTGRESQL_CONSTANTS::UPDATE) + " " + tableName + " " + std::string(POSTGRESQL_CONSTANTS::SET) + " ";
+    std::vector<std::string> params;
+    params.reserve(data.size());
+    for (const auto& row : data) {
+        if (row.size() < 2) {
+            setLastError("Every row of a bulk update must hold a column name and a value.");
+            return false;
         }
-        setClause.pop_back(); // Remove the trailing comma
-        setClause += "),";
-    }
-    setClause.pop_back(); // Remove the trailing comma
-
-    // Concatenate the UPDATE statement, SET clause, and condition
-    updateStatement += setClause + " WHERE " + condition;
-
-    // Execute the bulk UPDATE statement
-    PGresult* result = PQexec(pgConnection, updateStatement.c_str());
-    if (PQresultStatus(result) != PGRES_COMMAND_OK)
-    {
-        // Handle the error
-        std::string errorMessage = PQerrorMessage(pgConnection);
-        PQclear(result);
-        // Log or throw an exception with the error message
-
-        // Release the connection back to the pool
-        connectionPool.releaseConnection(pgConnection);
-        return false;
+        params.push_back(row[1]);
+        sql += (params.size() == 1 ? "" : ", ") + row[0] + " = $" + std::to_string(params.size());
     }
+    sql += " WHERE " + condition;
 
-    PQclear(result);
-
-    // Release the connection back to the pool
-    connectionPool.releaseConnection(pgConnection);
-
-    return true;
+    return executeWithParamsSync(sql, params);
 }
 
 bool PostgreSqlDatabaseConnection::bulkDelete(const std::string& tableName, const std::string& condition)
 {
-    // Get a connection from the connection pool
-    auto connection = connectionPool.getConnection();
-    if (!std::holds_alternative<PostgreSqlPtr>(connection)) {
-        // Handle the error
-        return false;
-    }
-
-    PostgreSqlPtr pgConnection = std::get<PostgreSqlPtr>(connection);
+    // Get a connection from the connection pool, or the one pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    PostgreSqlPtr pgConnection = acquireConnection(lease);
 
     // Construct the DELETE statement
     std::string deleteStatement = "DELETE FROM " + tableName + " WHERE " + condition;
@@ -1527,54 +1739,88 @@ bool PostgreSqlDatabaseConnection::bulkDelete(const std::string& tableName, cons
         std::string errorMessage = PQerrorMessage(pgConnection);
         PQclear(result);
         // Log or throw an exception with the error message
-
-        // Release the connection back to the pool
-        connectionPool.releaseConnection(pgConnection);
         return false;
     }
 
     PQclear(result);
 
-    // Release the connection back to the pool
-    connectionPool.releaseConnection(pgConnection);
-
+    recordWrite(std::vector<std::string> { tableName });
     return true;
 }
 
 bool PostgreSqlDatabaseConnection::migrateData(const std::string& sourceTableName, const std::string& destinationTableName)
 {
-    // Construct the SELECT statement
-    std::string selectStatement = "SELECT * FROM " + sourceTableName;
-
-    // Execute the SELECT statement to fetch the data from the source table
-    std::vector<std::vector<std::string>> data = querySync(selectStatement);
+    // The rows are copied inside the server instead of through the client
+    return executeSync("INSERT INTO " + destinationTableName + " SELECT * FROM " + sourceTableName);
+}
 
-    // Check if the SELECT query was successful
-    if (data.empty())
-    {
-        // Handle the error
-        return false;
+Abstracts::MigrationProgress PostgreSqlDatabaseConnection::migrateTable(const std::string& sourceTableName,
+                                                                        PostgreSqlDatabaseConnection& destination,
+                                                                        const std::string& destinationTableName,
+                                                                        const Abstracts::MigrationOptions& options)
+{
+    if (m_transactions.current() || destination.m_transactions.current()) {
+        throw Exception(Exception::Reason::Database, "A table migration commits chunk by chunk and cannot run inside a transaction.").getRuntimeError();
     }
 
-    // Construct the INSERT INTO statement
-    std::string insertStatement = "INSERT INTO " + destinationTableName + " VALUES ";
+    if (&destination.connectionPool == &connectionPool) {
+        // Same server: one statement, no row crosses the network
+        const auto startedAt = std::chrono::steady_clock::now();
+        const auto moved = queryResult("WITH moved AS (INSERT INTO " + destinationTableName + " SELECT * FROM " + sourceTableName
+                                       + " RETURNING 1) SELECT count(*) FROM moved");
+        recordWrite(std::vector<std::string> { destinationTableName });
 
-    // Iterate over the rows of data and construct the INSERT INTO statement
-    for (const auto& row : data)
-    {
-        std::string values;
-        for (const auto& value : row)
-        {
-            values += "'" + escapeString(value) + "', ";
+        Abstracts::MigrationProgress progress;
+        progress.rows = moved->get<std::uint64_t>(0, 0).value_or(0);
+        progress.chunks = 1;
+        progress.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startedAt);
+        progress.finished = true;
+        if (options.onProgress) {
+            options.onProgress(progress);
         }
-        values = values.substr(0, values.size() - 2);  // Remove the trailing comma and space
+        return progress;
+    }
 
-        insertStatement += "(" + values + "), ";
+    // Quantiles of the first key column split it into ranges of about the same number of rows
+    std::vector<std::string> boundaries;
+    if (options.parallelism > 1 && !options.key.empty()) {
+        std::string fractions;
+        for (Types::uint i = 1; i < options.parallelism; ++i) {
+            fractions += (i == 1 ? "" : ", ") + std::to_string(static_cast<double>(i) / options.parallelism);
+        }
+        const std::string column = quotePostgreSqlIdentifier(options.key.front().name);
+        const auto bounds = queryResult("SELECT b FROM (SELECT DISTINCT unnest(percentile_disc(ARRAY[" + fractions + "]::float8[]) WITHIN GROUP (ORDER BY "
+                                        + column + ")) AS b FROM " + sourceTableName + ") AS bounds ORDER BY b");
+        for (std::size_t row = 0; row < bounds->rowCount(); ++row) {
+            if (!bounds->isNull(row, 0)) {
+                boundaries.emplace_back(bounds->value(row, 0));
+            }
+        }
     }
-    insertStatement = insertStatement.substr(0, insertStatement.size() - 2);  // Remove the trailing comma and space
 
-    // Execute the INSERT INTO statement to insert the data into the destination table
-    return executeSync(insertStatement);
+    Abstracts::TableMigration migration("SELECT * FROM " + sourceTableName, postgreSqlKeyset, options);
+    const auto progress = migration.run(
+        [this](const Abstracts::KeysetQuery& query) {
+            return queryResult(query.sql, query.params);
+        },
+        [&destination, &destinationTableName](const Abstracts::ResultSet& chunk, std::size_t rows, std::size_t columns) {
+            // Each chunk is its own COPY, committed when it finishes
+            auto writer = destination.openCopyIn(destinationTableName);
+            for (std::size_t row = 0; row < rows; ++row) {
+                for (std::size_t column = 0; column < columns; ++column) {
+                    if (chunk.isNull(row, column)) {
+                        writer->null();
+                    } else {
+                        writer->value(chunk.value(row, column));
+                    }
+                }
+                writer->endRow();
+            }
+            writer->finish();
+        },
+        boundaries);
+    destination.recordWrite(std::vector<std::string> { destinationTableName });
+    return progress;
 }
 
 
@@ -1594,126 +1840,218 @@ std::vector<std::vector<std::string>> PostgreSqlDatabaseConnection::queryWithPag
     return querySync(paginatedSql);
 }
 
+Abstracts::KeysetPage PostgreSqlDatabaseConnection::queryWithKeyset(const std::string& sql,
+                                                                    const std::vector<Abstracts::KeysetColumn>& ordering,
+                                                                    std::size_t pageSize,
+                                                                    const std::string& continuation)
+{
+    const auto query = Abstracts::KeysetPagination::build(sql, ordering, pageSize, continuation, postgreSqlKeyset);
+    // Every page after the first has the same text, so it reuses one prepared statement
+    return Abstracts::KeysetPagination::page(queryResult(query.sql, query.params)->toRows(false), ordering, pageSize);
+}
+
 std::string PostgreSqlDatabaseConnection::getLastError()
 {
+    std::lock_guard<std::mutex> lock(m_PostgreSqlData.errorMutex);
     return m_PostgreSqlData.lastError;
 }
 
+void PostgreSqlDatabaseConnection::setLastError(std::string error)
+{
+    std::lock_guard<std::mutex> lock(m_PostgreSqlData.errorMutex);
+    m_PostgreSqlData.lastError = std::move(error);
+}
+
 
 int PostgreSqlDatabaseConnection::getRowCount(const std::string& tableName)
 {
-    // Construct the SQL query to get the row count
-    std::string query = "SELECT COUNT(*) FROM " + tableName;
-
-    // Execute the query and retrieve the result
-    auto result = querySync(query);
-    if (!result.empty() && !result[0].empty()) {
-        // Extract the row count from the result
-        return std::stoi(result[0][0]);
+    try {
+        if (m_PostgreSqlData.statistics.mode == Abstracts::StatisticsMode::Fast) {
+            return static_cast<int>(std::min<std::uint64_t>(estimateRowCount(tableName), std::numeric_limits<int>::max()));
+        }
+        return std::stoi(queryScalar("SELECT COUNT(*) FROM " + tableName).value_or("0"));
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return 0;
     }
-
-    // Return 0 if the result is empty or the row count couldn't be extracted
-    return 0;
 }
 
 std::string PostgreSqlDatabaseConnection::getMaxValue(const std::string& tableName, const std::string& columnName)
 {
-    // Construct the SQL query to get the maximum value
-    std::string query = "SELECT MAX(" + columnName + ") FROM " + tableName;
-
-    // Execute the query and retrieve the result
-    auto result = querySync(query);
-    if (!result.empty() && !result[0].empty()) {
-        // Return the maximum value from the result
-        return result[0][0];
+    try {
+        if (m_PostgreSqlData.statistics.mode == Abstracts::StatisticsMode::Fast) {
+            // With a b-tree on the column this reads the last entry of the index
+            const auto rows = statistic("max", tableName, columnName, [this, &tableName, &columnName]() {
+                return queryResult("SELECT " + columnName + " FROM " + tableName + " WHERE " + columnName + " IS NOT NULL ORDER BY "
+                                   + columnName + " DESC LIMIT 1")->toRows(false);
+            });
+            return rows->empty() ? std::string() : rows->front().front();
+        }
+        return queryScalar("SELECT MAX(" + columnName + ") FROM " + tableName).value_or(std::string());
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return {};
     }
-
-    // Return an empty string if the result is empty or the maximum value couldn't be retrieved
-    return "";
 }
 
 std::string PostgreSqlDatabaseConnection::getMinValue(const std::string& tableName, const std::string& columnName)
 {
-    // Construct the SQL query to get the minimum value
-    std::string query = "SELECT MIN(" + columnName + ") FROM " + tableName;
-
-    // Execute the query and retrieve the result
-    auto result = querySync(query);
-    if (!result.empty() && !result[0].empty()) {
-        // Return the minimum value from the result
-        return result[0][0];
+    try {
+        if (m_PostgreSqlData.statistics.mode == Abstracts::StatisticsMode::Fast) {
+            // With a b-tree on the column this reads the first entry of the index
+            const auto rows = statistic("min", tableName, columnName, [this, &tableName, &columnName]() {
+                return queryResult("SELECT " + columnName + " FROM " + tableName + " WHERE " + columnName + " IS NOT NULL ORDER BY "
+                                   + columnName + " LIMIT 1")->toRows(false);
+            });
+            return rows->empty() ? std::string() : rows->front().front();
+        }
+        return queryScalar("SELECT MIN(" + columnName + ") FROM " + tableName).value_or(std::string());
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return {};
     }
-
-    // Return an empty string if the result is empty or the minimum value couldn't be retrieved
-    return "";
 }
 
 double PostgreSqlDatabaseConnection::getAverageValue(const std::string& tableName, const std::string& columnName)
 {
-    // Construct the SQL query to calculate the average value
-    std::string query = "SELECT AVG(" + columnName + ") FROM " + tableName;
-
-    // Execute the query and retrieve the result
-    auto result = querySync(query);
-    if (!result.empty() && !result[0].empty()) {
-        // Convert the average value from string to double and return it
-        return std::stod(result[0][0]);
+    try {
+        if (m_PostgreSqlData.statistics.mode == Abstracts::StatisticsMode::Fast) {
+            return sampledAggregates(tableName, columnName).first;
+        }
+        return std::stod(queryScalar("SELECT AVG(" + columnName + ") FROM " + tableName).value_or("0"));
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return 0.0;
     }
-
-    // Return 0.0 if the result is empty or the average value couldn't be calculated
-    return 0.0;
 }
 
 double PostgreSqlDatabaseConnection::getSumValue(const std::string& tableName, const std::string& columnName)
 {
-    auto& engine = engineController.getEngine();
-    auto language = createLanguageObject()->getLanguageCode();
-    if (!isConnected()) {
-        m_PostgreSqlData.lastError = safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
-                                                    engine.meta()->returnView(POSTGRESQL_CONSTANTS::DRIVER_NAME));
+    try {
+        if (m_PostgreSqlData.statistics.mode == Abstracts::StatisticsMode::Fast) {
+            return sampledAggregates(tableName, columnName).second;
+        }
+        return std::stod(queryScalar("SELECT SUM(" + columnName + ") FROM " + tableName).value_or("0"));
+    } catch (const std::exception& e) {
+        setLastError(e.what());
         return 0.0;
     }
-
-    // Construct the SQL query to calculate the sum of values
-    std::string query = "SELECT SUM(" + columnName + ") FROM " + tableName;
-
-    // Execute the query and retrieve the result
-    auto result = querySync(query);
-    if (!result.empty() && !result[0].empty()) {
-        // Convert the sum value from string to double and return it
-        return std::stod(result[0][0]);
-    }
-
-    // Return 0.0 if the result is empty or the sum value couldn't be calculated
-    return 0.0;
 }
 
 std::vector<std::string> PostgreSqlDatabaseConnection::getDistinctValues(const std::string& tableName, const std::string& columnName)
 {
-    auto& engine = engineController.getEngine();
-    auto language = createLanguageObject()->getLanguageCode();
     std::vector<std::string> distinctValues;
-
-    if (!isConnected()) {
-        m_PostgreSqlData.lastError = safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
-                                                    engine.meta()->returnView(POSTGRESQL_CONSTANTS::DRIVER_NAME));
-        return distinctValues;
+    try {
+        const auto rows = statistic("distinct-values", tableName, columnName, [this, &tableName, &columnName]() {
+            return queryResult("SELECT DISTINCT " + columnName + " FROM " + tableName)->toRows(false);
+        });
+        for (const auto& row : *rows) {
+            distinctValues.push_back(row[0]);
+        }
+    } catch (const std::exception& e) {
+        setLastError(e.what());
     }
+    return distinctValues;
+}
 
-    // Construct the SQL query to retrieve distinct values
-    std::string query = "SELECT DISTINCT " + columnName + " FROM " + tableName;
+void PostgreSqlDatabaseConnection::setStatisticsOptions(const Abstracts::StatisticsOptions& options)
+{
+    m_PostgreSqlData.statistics = options;
+}
 
-    // Execute the query and retrieve the result
-    auto result = querySync(query);
+Abstracts::StatisticsOptions PostgreSqlDatabaseConnection::statisticsOptions() const
+{
+    return m_PostgreSqlData.statistics;
+}
 
-    // Extract the distinct values from the result
-    for (const auto& row : result) {
-        if (!row.empty()) {
-            distinctValues.push_back(row[0]);
+std::uint64_t PostgreSqlDatabaseConnection::estimateRowCount(const std::string& tableName)
+{
+    const auto rows = statistic("rows", tableName, {}, [this, &tableName]() {
+        const auto estimate = queryScalar(postgreSqlRowEstimate, { tableName });
+        if (!estimate) {
+            throw Exception(Exception::Reason::Database, "The table '" + tableName + "' does not exist.").getRuntimeError();
+        }
+        if (estimate->front() != '-') {
+            return Abstracts::QueryCache::Rows { { *estimate } };
+        }
+        // Never analyzed, or partitioned: no estimate to scale
+        return Abstracts::QueryCache::Rows { { queryScalar("SELECT COUNT(*) FROM " + tableName).value_or("0") } };
+    });
+    return std::stoull(rows->front().front());
+}
+
+std::uint64_t PostgreSqlDatabaseConnection::estimateDistinctCount(const std::string& tableName, const std::string& columnName)
+{
+    const auto rows = statistic("distinct", tableName, columnName, [this, &tableName, &columnName]() {
+        const std::uint64_t total = estimateRowCount(tableName);
+        const double fraction = Abstracts::StatisticsEstimator::sampleFraction(m_PostgreSqlData.statistics.sampleRows, total);
+        // BERNOULLI picks rows independently; the pages SYSTEM picks would repeat clustered values
+        std::string sql = "SELECT " + columnName + " FROM " + tableName;
+        if (fraction < 1.0) {
+            sql += " TABLESAMPLE BERNOULLI (" + std::to_string(fraction * 100.0) + ")";
+        }
+
+        const auto result = queryResult(sql);
+        Abstracts::HyperLogLog sketch;
+        std::uint64_t values = 0;
+        for (std::size_t row = 0; row < result->rowCount(); ++row) {
+            if (!result->isNull(row, 0)) {
+                sketch.add(result->value(row, 0));
+                ++values;
+            }
+        }
+        if (fraction >= 1.0 || result->rowCount() == 0) {
+            return Abstracts::QueryCache::Rows { { std::to_string(std::llround(sketch.estimate())) } };
         }
+        const auto nonNull = static_cast<std::uint64_t>(static_cast<double>(total) * static_cast<double>(values)
+                                                        / static_cast<double>(result->rowCount()));
+        const auto distinct = Abstracts::StatisticsEstimator::scaleDistinct(sketch.estimate(), values, nonNull, sketch.standardError());
+        return Abstracts::QueryCache::Rows { { std::to_string(distinct) } };
+    });
+    return std::stoull(rows->front().front());
+}
+
+Abstracts::QueryCache::RowsPtr PostgreSqlDatabaseConnection::statistic(std::string_view name,
+                                                                       const std::string& tableName,
+                                                                       const std::string& columnName,
+                                                                       const Abstracts::StatisticsEstimator::Compute& compute)
+{
+    // A transaction reads its own writes, which the cache must neither serve nor keep
+    if (m_PostgreSqlData.statistics.mode != Abstracts::StatisticsMode::Fast || m_transactions.current()) {
+        return std::make_shared<const Abstracts::QueryCache::Rows>(compute());
     }
+    return Abstracts::StatisticsEstimator::cached(*queryCache(), m_PostgreSqlData.statistics, name, tableName, columnName, compute);
+}
 
-    return distinctValues;
+std::pair<double, double> PostgreSqlDatabaseConnection::sampledAggregates(const std::string& tableName, const std::string& columnName)
+{
+    const auto rows = statistic("aggregates", tableName, columnName, [this, &tableName, &columnName]() {
+        const std::uint64_t total = estimateRowCount(tableName);
+        const double fraction = Abstracts::StatisticsEstimator::sampleFraction(m_PostgreSqlData.statistics.sampleRows, total);
+        if (fraction < 1.0) {
+            // SYSTEM reads whole pages at random, so the sample costs its own size and not the table's
+            const auto sample = queryResult("SELECT AVG(" + columnName + "), COUNT(" + columnName + "), COUNT(*) FROM " + tableName
+                                            + " TABLESAMPLE SYSTEM (" + std::to_string(fraction * 100.0) + ")");
+            const auto sampled = std::stod(std::string(sample->value(0, 2)));
+            if (sampled > 0) {
+                const double average = sample->isNull(0, 0) ? 0.0 : std::stod(std::string(sample->value(0, 0)));
+                const double nonNull = std::stod(std::string(sample->value(0, 1))) / sampled * static_cast<double>(total);
+                return Abstracts::QueryCache::Rows { { std::to_string(average), std::to_string(average * nonNull) } };
+            }
+        }
+        const auto exact = queryResult("SELECT COALESCE(AVG(" + columnName + "), 0), COALESCE(SUM(" + columnName + "), 0) FROM " + tableName);
+        return Abstracts::QueryCache::Rows { { std::string(exact->value(0, 0)), std::string(exact->value(0, 1)) } };
+    });
+    return { std::stod(rows->front()[0]), std::stod(rows->front()[1]) };
+}
+
+std::optional<std::string> PostgreSqlDatabaseConnection::queryScalar(const std::string& sql, const std::vector<std::string>& params)
+{
+    const auto result = queryResult(sql, params);
+    if (result->rowCount() == 0 || result->columnCount() == 0 || result->isNull(0, 0)) {
+        return std::nullopt;
+    }
+    return std::string(result->value(0, 0));
 }
 
 
@@ -1722,64 +2060,173 @@ bool PostgreSqlDatabaseConnection::executeScriptFromFile(const std::string& file
     auto& engine = engineController.getEngine();
     auto language = createLanguageObject()->getLanguageCode();
     if (!isConnected()) {
-        m_PostgreSqlData.lastError = safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
-                                                    engine.meta()->returnView(POSTGRESQL_CONSTANTS::DRIVER_NAME));
+        setLastError(safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
+                                         engine.meta()->returnView(POSTGRESQL_CONSTANTS::DRIVER_NAME)));
         return false;
     }
 
-
-    std::ifstream file(filename);
+    std::ifstream file(filename, std::ios::binary);
     if (!file.is_open()) {
-        m_PostgreSqlData.lastError = safeTranslate(language, "exceptions", "failed_to_open_script_file") + filename;
+        setLastError(safeTranslate(language, "exceptions", "failed_to_open_script_file") + filename);
         return false;
     }
 
-    std::string line;
-    std::string script;
-    while (std::getline(file, line)) {
-        script += line + __cell_newline;
+    // One connection for the whole script, so its SET and BEGIN apply to the statements that follow
+    Abstracts::ConnectionLease lease;
+    PostgreSqlPtr postgresqlConnection = acquireConnection(lease);
+    Abstracts::SqlScriptReader reader(file, postgreSqlScript);
+    bool succeeded = true;
+    try {
+        while (const auto statement = reader.next()) {
+            try {
+                executeOnPostgreSql(postgresqlConnection, *statement);
+            } catch (const std::exception& e) {
+                throw Exception(Exception::Reason::Database, filename + ":" + std::to_string(reader.line()) + ": " + e.what()).getRuntimeError();
+            }
+        }
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        succeeded = false;
     }
 
-    file.close();
+    // A transaction the script left open must not reach the next borrower
+    if (lease && PQtransactionStatus(postgresqlConnection) != PQTRANS_IDLE) {
+        lease.discard();
+    }
 
-    return executeSync(script);
+    // The script may have written to or changed any table
+    recordWrite(std::nullopt);
+    recordSchemaChange();
+    return succeeded;
 }
 
 bool PostgreSqlDatabaseConnection::backupDatabase(const std::string& backupFilename)
 {
-    std::string command = "pg_dump -U <username> -h <hostname> <database_name> > " + backupFilename;
-
-    // Execute the backup command
-    int result = std::system(command.c_str());
-
-    // Check the result of the backup command
-    if (result == 0) {
-        // Backup successful
+    try {
+        backup(backupFilename);
         return true;
-    } else {
-        // Backup failed
+    } catch (const std::exception& e) {
+        setLastError(e.what());
         return false;
     }
 }
 
 bool PostgreSqlDatabaseConnection::restoreDatabase(const std::string& backupFilename)
 {
-    // Build the command to execute
-    std::string command = "pg_restore -U <username> -h <hostname> -p <port> -d <database> " + backupFilename;
-
-    // Execute the command
-    int result = std::system(command.c_str());
-
-    // Check the result of the command execution
-    if (result == 0) {
-        // Restoration successful
+    try {
+        restore(backupFilename);
         return true;
-    } else {
-        // Restoration failed
+    } catch (const std::exception& e) {
+        setLastError(e.what());
         return false;
     }
 }
 
+PostgreSqlBackupManifest PostgreSqlDatabaseConnection::backup(const std::string& directory, const PostgreSqlBackupOptions& options)
+{
+    const std::filesystem::path root(directory);
+    std::filesystem::create_directories(root);
+
+    // The coordinator's snapshot is the one every worker reads in
+    Abstracts::TransactionOptions snapshotOptions;
+    snapshotOptions.isolation = Abstracts::IsolationLevel::RepeatableRead;
+    snapshotOptions.readOnly = true;
+    Abstracts::Transaction coordinator(leaseConnection(), postgreSqlDialect, snapshotOptions);
+    PostgreSqlPtr coordinatorConnection = coordinator.lease().get<PostgreSqlPtr>();
+    const std::string snapshot = PQgetvalue(selectOnPostgreSql(coordinatorConnection, "SELECT pg_export_snapshot()").get(), 0, 0);
+
+    PostgreSqlBackupManifest manifest;
+    manifest.format = options.format;
+    manifest.createdAt = std::chrono::system_clock::now();
+    {
+        const auto tables = selectOnPostgreSql(coordinatorConnection, postgreSqlBackupTables);
+        for (int row = 0; row < PQntuples(tables.get()); ++row) {
+            PostgreSqlBackupTable table;
+            table.name = PQgetvalue(tables.get(), row, 0);
+            table.file = backupFileName(static_cast<std::size_t>(row), table.name);
+            manifest.tables.push_back(std::move(table));
+        }
+        assignRestoreWaves(manifest.tables, selectOnPostgreSql(coordinatorConnection, postgreSqlBackupReferences).get());
+
+        // Sequences are not transactional; their current position covers every row of the snapshot
+        const auto sequences = selectOnPostgreSql(coordinatorConnection, postgreSqlBackupSequences);
+        for (int row = 0; row < PQntuples(sequences.get()); ++row) {
+            manifest.sequences.push_back({ PQgetvalue(sequences.get(), row, 0), std::stoll(PQgetvalue(sequences.get(), row, 1)) });
+        }
+    }
+
+    // Workers take the next table until none is left; the coordinator is worker 0 and keeps the snapshot alive
+    std::atomic<std::size_t> nextTable { 0 };
+    const auto workers = static_cast<Types::uint>(std::min<std::size_t>(std::max<Types::uint>(options.parallelism, 1), manifest.tables.size()));
+    runWorkers(workers, [&](Types::uint worker, const std::atomic<bool>& stopped) {
+        std::optional<Abstracts::Transaction> imported;
+        PostgreSqlPtr connection = coordinatorConnection;
+        if (worker > 0) {
+            imported.emplace(leaseConnection(), postgreSqlDialect, snapshotOptions);
+            imported->execute("SET TRANSACTION SNAPSHOT '" + snapshot + "'");
+            connection = imported->lease().get<PostgreSqlPtr>();
+        }
+        for (std::size_t index; !stopped.load(std::memory_order_relaxed) && (index = nextTable.fetch_add(1)) < manifest.tables.size();) {
+            dumpTable(connection, root, manifest.tables[index], options);
+        }
+        if (imported) {
+            imported->commit();
+        }
+    });
+    coordinator.commit();
+
+    manifest.write(root);
+    return manifest;
+}
+
+PostgreSqlBackupManifest PostgreSqlDatabaseConnection::restore(const std::string& directory, const PostgreSqlRestoreOptions& options)
+{
+    const std::filesystem::path root(directory);
+    auto manifest = PostgreSqlBackupManifest::read(root);
+
+    if (options.truncate && !manifest.tables.empty()) {
+        std::string sql = "TRUNCATE ";
+        for (std::size_t i = 0; i < manifest.tables.size(); ++i) {
+            sql += (i == 0 ? "" : ", ") + manifest.tables[i].name;
+        }
+        Abstracts::ConnectionLease lease = leaseConnection();
+        executeOnPostgreSql(lease.connection(), sql);
+    }
+
+    std::map<Types::uint, std::vector<const PostgreSqlBackupTable*>> waves;
+    for (const auto& table : manifest.tables) {
+        waves[table.wave].push_back(&table);
+    }
+    // Each wave completes before the next starts, so every referenced row is already there
+    for (const auto& [wave, tables] : waves) {
+        std::atomic<std::size_t> nextTable { 0 };
+        const auto workers = static_cast<Types::uint>(std::min<std::size_t>(std::max<Types::uint>(options.parallelism, 1), tables.size()));
+        runWorkers(workers, [&](Types::uint, const std::atomic<bool>& stopped) {
+            Abstracts::ConnectionLease lease = leaseConnection();
+            for (std::size_t index; !stopped.load(std::memory_order_relaxed) && (index = nextTable.fetch_add(1)) < tables.size();) {
+                loadTable(lease.get<PostgreSqlPtr>(), root, *tables[index], manifest.format);
+            }
+        });
+    }
+
+    if (!manifest.sequences.empty()) {
+        Abstracts::ConnectionLease lease = leaseConnection();
+        for (const auto& sequence : manifest.sequences) {
+            const std::string value = std::to_string(sequence.value);
+            const char* values[] = { sequence.name.c_str(), value.c_str() };
+            PostgreSqlResult result(PQexecParams(lease.get<PostgreSqlPtr>(), "SELECT setval($1::regclass, $2::bigint)", 2,
+                                                 __cell_nullptr, values, __cell_nullptr, __cell_nullptr, 0), &PQclear);
+            if (PQresultStatus(result.get()) != PGRES_TUPLES_OK) {
+                throw Exception(Exception::Reason::Database, PQresultErrorMessage(result.get())).getRuntimeError();
+            }
+        }
+    }
+
+    // Any table may have changed
+    recordWrite(std::nullopt);
+    return manifest;
+}
+
 std::vector<std::string> PostgreSqlDatabaseConnection::getDatabaseList()
 {
     std::vector<std::string> databaseList;
@@ -1832,8 +2279,8 @@ bool PostgreSqlDatabaseConnection::grantPrivileges(const std::string& username,
     auto language = createLanguageObject()->getLanguageCode();
 
     if (!isConnected()) {
-        m_PostgreSqlData.lastError = safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
-                                                         engine.meta()->returnView(POSTGRESQL_CONSTANTS::DRIVER_NAME));
+        setLastError(safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
+                                         engine.meta()->returnView(POSTGRESQL_CONSTANTS::DRIVER_NAME)));
         return false;
     }
 
@@ -1864,8 +2311,8 @@ bool PostgreSqlDatabaseConnection::revokePrivileges(const std::string& username,
     auto language = createLanguageObject()->getLanguageCode();
 
     if (!isConnected()) {
-        m_PostgreSqlData.lastError = safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
-                                                         engine.meta()->returnView(POSTGRESQL_CONSTANTS::DRIVER_NAME));
+        setLastError(safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
+                                         engine.meta()->returnView(POSTGRESQL_CONSTANTS::DRIVER_NAME)));
         return false;
     }
     // Sanitize the username and database name to prevent SQL injection
@@ -1891,41 +2338,16 @@ bool PostgreSqlDatabaseConnection::revokePrivileges(const std::string& username,
 
 int PostgreSqlDatabaseConnection::getTableSize(const std::string& tableName)
 {
-    auto& engine = engineController.getEngine();
-    auto language = createLanguageObject()->getLanguageCode();
-
-    if (!isConnected()) {
-        m_PostgreSqlData.lastError = safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
-                                                    engine.meta()->returnView(POSTGRESQL_CONSTANTS::DRIVER_NAME));
-        return false;
-    }
-
-    // Sanitize the table name to prevent SQL injection
-    std::string sanitizedTableName = sanitizeInput(tableName);
-
-    // SQL statement to get the table size
-    std::string sql = "SELECT pg_size_pretty(pg_total_relation_size('" + sanitizedTableName + "')) AS table_size";
-
-    // Execute the query
-    std::vector<std::vector<std::string>> result = querySync(sql);
-
-    // Extract the table size from the result
-    if (!result.empty() && result[0].size() > 0) {
-        // The table size is in the first row and first column
-        std::string sizeString = result[0][0];
-
-        // Parse the size string to an integer
-        try {
-            int size = std::stoi(sizeString);
-            return size;
-        } catch (...) {
-            // Failed to parse the size, return -1 indicating an error
-            return -1;
-        }
+    try {
+        // Bytes of the table with its indexes and TOAST data, from the size of its files
+        const auto rows = statistic("size", tableName, {}, [this, &tableName]() {
+            return Abstracts::QueryCache::Rows { { queryScalar("SELECT pg_total_relation_size(to_regclass($1))", { tableName }).value_or("-1") } };
+        });
+        return static_cast<int>(std::min<long long>(std::stoll(rows->front().front()), std::numeric_limits<int>::max()));
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return -1;
     }
-
-    // Return -1 if the size could not be retrieved
-    return -1;
 }
 
 void PostgreSqlDatabaseConnection::executeNonQuery(const std::string& sql)
@@ -1934,8 +2356,8 @@ void PostgreSqlDatabaseConnection::executeNonQuery(const std::string& sql)
     auto language = createLanguageObject()->getLanguageCode();
 
     if (!isConnected()) {
-        m_PostgreSqlData.lastError = safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
-                                                         engine.meta()->returnView(POSTGRESQL_CONSTANTS::DRIVER_NAME));
+        setLastError(safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
+                                         engine.meta()->returnView(POSTGRESQL_CONSTANTS::DRIVER_NAME)));
         return;
     }
 
@@ -1948,16 +2370,45 @@ void PostgreSqlDatabaseConnection::importTable(const std::string& tableName, con
     auto language = createLanguageObject()->getLanguageCode();
 
     if (!isConnected()) {
-        m_PostgreSqlData.lastError = safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
-                                                    engine.meta()->returnView(POSTGRESQL_CONSTANTS::DRIVER_NAME));
+        setLastError(safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
+                                         engine.meta()->returnView(POSTGRESQL_CONSTANTS::DRIVER_NAME)));
         return;
     }
 
-    // Construct the COPY command
-    std::string copyCommand = "COPY " + tableName + " FROM '" + filePath + "'";
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file) {
+        setLastError("Cannot open " + filePath + " for reading.");
+        return;
+    }
 
-    // Execute the COPY command
-    executeNonQuery(copyCommand);
+    // A file written by COPY ... WITH (FORMAT binary) starts with its signature
+    constexpr std::string_view binarySignature { "PGCOPY\n\377\r\n\0", 11 };
+    PostgreSqlCopyOptions options;
+    std::string chunk(options.bufferSize, '\0');
+    file.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+    std::size_t length = static_cast<std::size_t>(file.gcount());
+    if (std::string_view(chunk.data(), length).starts_with(binarySignature)) {
+        options.format = Abstracts::ResultFormat::Binary;
+    }
+
+    try {
+        // The file is streamed chunk by chunk, so its size does not matter
+        auto writer = openCopyIn(tableName, options);
+        while (length > 0) {
+            writer->writeRaw(std::string_view(chunk.data(), length));
+            file.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+            length = static_cast<std::size_t>(file.gcount());
+        }
+        if (file.bad()) {
+            writer->abort("the file could not be read");
+            setLastError("Cannot read " + filePath + ".");
+            return;
+        }
+        writer->finish();
+        recordWrite(std::vector<std::string> { tableName });
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+    }
 }
 
 
@@ -1966,15 +2417,30 @@ void PostgreSqlDatabaseConnection::exportTable(const std::string& tableName, con
     auto& engine = engineController.getEngine();
     auto language = createLanguageObject()->getLanguageCode();
     if (!isConnected()) {
-        m_PostgreSqlData.lastError = safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
-                                                    engine.meta()->returnView(POSTGRESQL_CONSTANTS::DRIVER_NAME));
+        setLastError(safeFormat()->print(safeTranslate(language, "exceptions", "not_connected_to_server"),
+                                         engine.meta()->returnView(POSTGRESQL_CONSTANTS::DRIVER_NAME)));
+        return;
+    }
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        setLastError("Cannot open " + filePath + " for writing.");
         return;
     }
-    // Construct the COPY command
-    std::string copyCommand = "COPY " + tableName + " TO '" + filePath + "'";
 
-    // Execute the COPY command
-    executeNonQuery(copyCommand);
+    try {
+        // Each chunk is written as it arrives, so memory does not grow with the table
+        auto reader = openCopyOut(tableName);
+        reader->forEach([&file](std::string_view chunk) {
+            file.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        });
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return;
+    }
+
+    if (!file.flush()) {
+        setLastError("Cannot write " + filePath + ".");
+    }
 }
 
 
@@ -1985,7 +2451,7 @@ bool PostgreSqlDatabaseConnection::validateSqlQuery(const std::string& query)
 
     // Check if the query is empty
     if (query.empty()) {
-        m_PostgreSqlData.lastError = "SQL query is empty.";
+        setLastError("SQL query is empty.");
         return false;
     }
 
@@ -1997,7 +2463,7 @@ bool PostgreSqlDatabaseConnection::validateSqlQuery(const std::string& query)
     if (upperQuery.find("DROP") != std::string::npos ||
         upperQuery.find("DELETE") != std::string::npos ||
         upperQuery.find("TRUNCATE") != std::string::npos) {
-        m_PostgreSqlData.lastError = safeTranslate(language, "exceptions", "invalid_sql_query_harmful");
+        setLastError(safeTranslate(language, "exceptions", "invalid_sql_query_harmful"));
         return false;
     }
 
@@ -2014,7 +2480,7 @@ bool PostgreSqlDatabaseConnection::validateParams(const std::vector<std::string>
 
     // Check if the parameters vector is empty
     if (params.empty()) {
-        m_PostgreSqlData.lastError = safeTranslate(language, "exceptions", "query_parameters_are_empty");
+        setLastError(safeTranslate(language, "exceptions", "query_parameters_are_empty"));
         return false;
     }
 
@@ -2022,7 +2488,7 @@ bool PostgreSqlDatabaseConnection::validateParams(const std::vector<std::string>
     for (const std::string& param : params) {
         // Check if a parameter is empty
         if (param.empty()) {
-            m_PostgreSqlData.lastError = safeTranslate(language, "exceptions", "empty_query_parameter_detected");
+            setLastError(safeTranslate(language, "exceptions", "empty_query_parameter_detected"));
             return false;
         }
 
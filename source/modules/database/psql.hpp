@@ -41,6 +41,36 @@
 #   error "Cell's "psqlconnectionpool.hpp" was not found!"
 #endif
 
+#if __has_include("psqlresultset.hpp")
+#   include "psqlresultset.hpp"
+#else
+#   error "Cell's "psqlresultset.hpp" was not found!"
+#endif
+
+#if __has_include("psqlcursor.hpp")
+#   include "psqlcursor.hpp"
+#else
+#   error "Cell's "psqlcursor.hpp" was not found!"
+#endif
+
+#if __has_include("psqlcopy.hpp")
+#   include "psqlcopy.hpp"
+#else
+#   error "Cell's "psqlcopy.hpp" was not found!"
+#endif
+
+#if __has_include("psqlbackup.hpp")
+#   include "psqlbackup.hpp"
+#else
+#   error "Cell's "psqlbackup.hpp" was not found!"
+#endif
+
+#if __has_include("psqlasync.hpp")
+#   include "psqlasync.hpp"
+#else
+#   error "Cell's "psqlasync.hpp" was not found!"
+#endif
+
 CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Database)
 
 /**
@@ -198,6 +228,10 @@ public:
     /**
      * @brief Begins a transaction.
      *
+     * The transaction is pinned to one pooled connection until commitTransaction() or rollbackTransaction()
+     * from the same thread; the statements that thread issues in between run on that connection, while other
+     * threads keep using the pool.
+     *
      * @return True if the transaction is successfully started, false otherwise.
      */
     bool beginTransaction() __cell_override;
@@ -216,6 +250,38 @@ public:
      */
     bool rollbackTransaction() __cell_override;
 
+    /**
+     * @brief Leases a connection from the pool for the current scope.
+     *
+     * @return A lease that returns the connection to the pool when it is destroyed.
+     */
+    Abstracts::ConnectionLease leaseConnection();
+
+    /**
+     * @brief Opens a transaction pinned to a single pooled connection.
+     *
+     * The transaction is rolled back automatically unless it is committed before it goes out of scope.
+     *
+     * @param options The isolation level and access mode.
+     * @return The open transaction.
+     */
+    Abstracts::Transaction transaction(const Abstracts::TransactionOptions& options = {});
+
+    /**
+     * @brief Runs a transaction body and commits it, retrying the whole transaction on serialization failures and deadlocks.
+     *
+     * @param body Receives the Abstracts::Transaction; its return value is returned.
+     * @param options The isolation level and access mode.
+     * @param maxAttempts The number of attempts before the failure is rethrown.
+     */
+    template <typename Body>
+    auto runTransaction(Body&& body,
+                        const Abstracts::TransactionOptions& options = {},
+                        Types::uint maxAttempts = Abstracts::TRANSACTION_CONSTANTS::DEFAULT_MAX_ATTEMPTS)
+    {
+        return Abstracts::retryTransaction([&] { return transaction(options); }, std::forward<Body>(body), maxAttempts);
+    }
+
     /**
      * @brief Executes an SQL query synchronously.
      *
@@ -227,6 +293,9 @@ public:
     /**
      * @brief Executes an SQL query asynchronously.
      *
+     * The query is sent without blocking and completed by the driver's reactor thread; no thread is
+     * created per query.
+     *
      * @param sql The SQL query to execute.
      * @return A future object that can be used to obtain the result of the execution.
      */
@@ -253,6 +322,8 @@ public:
     /**
      * @brief Executes a batch of SQL queries synchronously.
      *
+     * The batch is sent in pipeline mode, so it costs one round trip, and is all-or-nothing.
+     *
      * @param sqlBatch A vector of SQL queries to execute as a batch.
      * @return True if the execution is successful for all queries, false otherwise.
      */
@@ -293,11 +364,107 @@ public:
     /**
      * @brief Executes an SQL query asynchronously and returns the result as a future object.
      *
+     * The query is sent without blocking and completed by the driver's reactor thread.
+     *
      * @param sql The SQL query to execute.
      * @return A future object that can be used to obtain the result of the query.
      */
     std::future<std::vector<std::vector<std::string>>> queryAsync(const std::string& sql) __cell_override;
 
+    /**
+     * @brief Executes an SQL query and returns a result set that reads the values in place.
+     *
+     * Unlike querySync(), no value is copied and the column names are not mixed into the rows.
+     *
+     * @param sql The SQL query to execute.
+     * @param params Values for $1, $2, ...; when given, the statement goes through the prepared statement cache.
+     * @param format Abstracts::ResultFormat::Binary returns numbers in their binary representation.
+     * @return The result set.
+     * @throws std::runtime_error If the query fails.
+     */
+    Abstracts::ResultSetPtr queryResult(const std::string& sql,
+                                        const std::vector<std::string>& params = {},
+                                        Abstracts::ResultFormat format = Abstracts::ResultFormat::Text);
+
+    /**
+     * @brief Executes queryResult() asynchronously; the result set is moved, not copied, into the future.
+     *
+     * The query is sent without blocking and completed by the driver's reactor thread; statements with
+     * params run as unnamed statements rather than through the prepared statement cache.
+     */
+    std::future<Abstracts::ResultSetPtr> queryResultAsync(const std::string& sql,
+                                                          const std::vector<std::string>& params = {},
+                                                          Abstracts::ResultFormat format = Abstracts::ResultFormat::Text);
+
+    /**
+     * @brief Opens a cursor that streams the result of a query in batches, with constant memory.
+     *
+     * The cursor keeps its connection (or the one pinned by beginTransaction()) until it is exhausted or closed.
+     *
+     * @param sql The query to stream.
+     * @param params Values for $1, $2, ...
+     * @param options The batch size and result format.
+     * @return The open cursor.
+     * @throws std::runtime_error If the query cannot be started.
+     */
+    Abstracts::CursorPtr openCursor(const std::string& sql,
+                                    const std::vector<std::string>& params = {},
+                                    const Abstracts::CursorOptions& options = {});
+
+    /**
+     * @brief Starts a COPY ... FROM STDIN that streams rows into a table.
+     *
+     * The writer keeps its connection (or the one pinned by beginTransaction()) until it is finished or aborted.
+     * Cached results of the table are invalidated when the writer is opened; results cached before finish()
+     * returns are not, so invalidate the table again through queryCache() afterwards if it is read through
+     * queryCached() meanwhile. copyIn() does this itself.
+     *
+     * @param tableName The target table.
+     * @param options The format, target columns and batch size.
+     * @return The open writer.
+     * @throws std::runtime_error If the server refuses the COPY.
+     */
+    std::unique_ptr<PostgreSqlCopyIn> openCopyIn(const std::string& tableName, const PostgreSqlCopyOptions& options = {});
+
+    /**
+     * @brief Loads rows into a table with a single COPY ... FROM STDIN.
+     *
+     * @param tableName The target table.
+     * @param rows The rows; every value is stored as given, none as NULL.
+     * @param options The format, target columns and batch size.
+     * @return The number of rows stored.
+     * @throws std::runtime_error If the server rejects the data; nothing is stored.
+     */
+    std::uint64_t copyIn(const std::string& tableName, const std::vector<std::vector<std::string>>& rows, const PostgreSqlCopyOptions& options = {});
+
+    /**
+     * @brief Starts a COPY ... TO STDOUT that streams a table or a query out of the server.
+     *
+     * The reader keeps its connection (or the one pinned by beginTransaction()) until it has been read to the end.
+     *
+     * @param source A table, optionally followed by a column list, or a query in parentheses.
+     * @param format COPY text or binary format.
+     * @return The open reader.
+     * @throws std::runtime_error If the server refuses the COPY.
+     */
+    std::unique_ptr<PostgreSqlCopyOut> openCopyOut(const std::string& source, Abstracts::ResultFormat format = Abstracts::ResultFormat::Text);
+
+    /**
+     * @brief Runs several statements in one round trip with libpq pipeline mode.
+     *
+     * The statements are all-or-nothing unless a transaction is already open, in which case they become part of it.
+     *
+     * @param statements The statements, one per entry.
+     * @return One result set per statement, in order.
+     * @throws std::runtime_error With the error of the first statement that failed.
+     */
+    std::vector<Abstracts::ResultSetPtr> queryPipelined(const std::vector<std::string>& statements);
+
+    /**
+     * @brief Returns the number of asynchronous queries in flight.
+     */
+    std::size_t pendingAsyncQueries() const;
+
     /**
      * @brief Executes an SQL query with parameters synchronously and returns the result as a 2D vector of strings.
      *
@@ -310,12 +477,60 @@ public:
     /**
      * @brief Executes an SQL query with parameters asynchronously and returns the result as a future object.
      *
+     * The query is sent without blocking, as an unnamed statement, and completed by the driver's reactor thread.
+     *
      * @param sql The SQL query with placeholders.
      * @param params The parameters to be bound to the query.
      * @return A future object that can be used to obtain the result of the query.
      */
     std::future<std::vector<std::vector<std::string>>> queryWithParamsAsync(const std::string& sql, const std::vector<std::string>& params) __cell_override;
 
+    /**
+     * @brief Executes an SQL query through the query cache.
+     *
+     * Only queries made through this method are cached. Inside a transaction the cache is bypassed so
+     * the transaction's own writes are seen. Misses are loaded from the primary, never a replica, so a
+     * lagging replica's rows are not cached as fresh.
+     *
+     * @param sql The SQL query, with placeholders if params is not empty.
+     * @param params The parameters to be bound to the query.
+     * @param options The lifetime of the result and the tables it depends on.
+     * @return A 2D vector of strings representing the result of the query.
+     */
+    std::vector<std::vector<std::string>> queryCached(const std::string& sql,
+                                                      const std::vector<std::string>& params = {},
+                                                      const Abstracts::QueryCacheOptions& options = {}) __cell_override;
+
+    /**
+     * @brief Uses a query cache, e.g. one shared with other connections and drivers.
+     *
+     * @param cache The cache to use from now on.
+     */
+    void setQueryCache(std::shared_ptr<Abstracts::QueryCache> cache) __cell_override;
+
+    /**
+     * @brief Returns the query cache used by this connection.
+     */
+    std::shared_ptr<Abstracts::QueryCache> queryCache() const __cell_override;
+
+    /**
+     * @brief Sends reads to replica pools from now on.
+     *
+     * Statements that cannot write go to a healthy replica when the session has not written within
+     * the stickiness window and no transaction is open; everything else uses the pool this connection
+     * was constructed with. Call it before the connection is shared between threads.
+     *
+     * @param replicas The pools of the replicas, which must outlive this connection; empty to stop routing.
+     * @param options The selection policy, lag limit, stickiness window and probe interval.
+     */
+    void setReplicas(const std::vector<std::reference_wrapper<PostgreSqlConnectionPool>>& replicas,
+                     const Abstracts::ReplicaRoutingOptions& options = {});
+
+    /**
+     * @brief Returns the last measurement of every replica given to setReplicas().
+     */
+    std::vector<Abstracts::ReplicaStatus> replicaStatus() const;
+
     /**
      * @brief Executes an SQL query with parameters synchronously.
      *
@@ -328,6 +543,8 @@ public:
     /**
      * @brief Executes an SQL query with parameters asynchronously.
      *
+     * The query is sent without blocking, as an unnamed statement, and completed by the driver's reactor thread.
+     *
      * @param sql The SQL query with placeholders.
      * @param params The parameters to be bound to the query.
      * @return A future object that can be used to obtain the result of the execution.
@@ -393,6 +610,15 @@ public:
      */
     void setConnectionTimeout(int timeoutSeconds) __cell_override;
 
+    /**
+     * @brief Returns the schema catalog of the connection pool, reloading it after a schema change.
+     *
+     * The catalog is read from pg_catalog with one statement over a connection of its own, and covers
+     * the tables visible in the search path. Each column carries its type OID, ready to be passed as a
+     * parameter type when a statement is prepared.
+     */
+    Abstracts::SchemaSnapshotPtr schema() __cell_override;
+
     /**
      * @brief Retrieves the names of all tables in the database.
      *
@@ -555,6 +781,8 @@ public:
     /**
      * @brief Performs a bulk insert of data into a table.
      *
+     * The rows are streamed with COPY ... FROM STDIN; see copyIn().
+     *
      * @param tableName The name of the table.
      * @param data A vector of vectors representing the data rows to insert.
      * @return True if the bulk insert is successful, false otherwise.
@@ -562,12 +790,12 @@ public:
     bool bulkInsert(const std::string& tableName, const std::vector<std::vector<std::string>>& data) __cell_override;
 
     /**
-     * @brief Performs a bulk update of data in a table based on a condition.
+     * @brief Sets columns of the rows matching a condition.
      *
      * @param tableName The name of the table.
-     * @param data A vector of vectors representing the data rows to update.
-     * @param condition The condition for updating the data.
-     * @return True if the bulk update is successful, false otherwise.
+     * @param data Pairs of a column name and its new value; the values are bound, not spliced.
+     * @param condition The WHERE condition.
+     * @return True if the update is successful, false otherwise.
      */
     bool bulkUpdate(const std::string& tableName, const std::vector<std::vector<std::string>>& data, const std::string& condition) __cell_override;
 
@@ -583,12 +811,34 @@ public:
     /**
      * @brief Migrates data from a source table to a destination table.
      *
+     * Both tables are on this server, so the rows are copied by one INSERT ... SELECT and never leave it.
+     *
      * @param sourceTableName The name of the source table.
      * @param destinationTableName The name of the destination table.
      * @return True if the data migration is successful, false otherwise.
      */
     bool migrateData(const std::string& sourceTableName, const std::string& destinationTableName) __cell_override;
 
+    /**
+     * @brief Copies a table into a table of another connection in bounded, keyset-ordered chunks.
+     *
+     * When both connections share a pool the copy is a single INSERT ... SELECT on the server. Otherwise
+     * each chunk is read by its key and streamed into the destination with COPY, so memory is bounded by
+     * one chunk per worker. With a parallelism above one the key's first column is split at its quantiles
+     * into ranges copied over separate pooled connections at once. See Abstracts::TableMigration.
+     *
+     * @param sourceTableName The table to read.
+     * @param destination The connection of the destination; it may be this one.
+     * @param destinationTableName The table to write, with the source's columns in the same order.
+     * @param options The key, chunk size, parallelism and progress callback.
+     * @return The final progress.
+     * @throws std::runtime_error If either connection has an open transaction or a chunk fails; the chunks written before stay.
+     */
+    Abstracts::MigrationProgress migrateTable(const std::string& sourceTableName,
+                                              PostgreSqlDatabaseConnection& destination,
+                                              const std::string& destinationTableName,
+                                              const Abstracts::MigrationOptions& options = {});
+
 
     /**
      * @brief Executes a query with pagination, returning a subset of results based on the specified page number and page size.
@@ -600,9 +850,26 @@ public:
      */
     std::vector<std::vector<std::string>> queryWithPagination(const std::string& sql, int pageNumber, int pageSize) __cell_override;
 
+    /**
+     * @brief Retrieves query results page by page by seeking past the ordering key of the previous page.
+     *
+     * @param sql The SQL query, without ORDER BY or LIMIT.
+     * @param ordering The key columns, most significant first.
+     * @param pageSize The number of rows of a page.
+     * @param continuation The token of the previous page; empty for the first page.
+     * @return The rows of the page, without a header, and the token of the next one.
+     */
+    Abstracts::KeysetPage queryWithKeyset(const std::string& sql,
+                                          const std::vector<Abstracts::KeysetColumn>& ordering,
+                                          std::size_t pageSize,
+                                          const std::string& continuation = {}) __cell_override;
+
     /**
      * @brief Retrieves the number of rows in a table.
      *
+     * In the fast statistics mode this is estimateRowCount(); the aggregates below likewise follow
+     * setStatisticsOptions().
+     *
      * @param tableName The name of the table.
      * @return The total number of rows in the table.
      */
@@ -653,30 +920,112 @@ public:
      */
     std::vector<std::string> getDistinctValues(const std::string& tableName, const std::string& columnName) __cell_override;
 
+    /**
+     * @brief Chooses how the aggregate methods answer from now on.
+     *
+     * The exact mode is the default. In the fast mode row counts come from pg_class.reltuples scaled
+     * to the table's current size, MIN and MAX read one end of an index on the column when there is
+     * one, AVG and SUM are taken from a TABLESAMPLE SYSTEM sample, and every result is kept in the
+     * query cache for the configured lifetime. Call it before the connection is shared between threads.
+     *
+     * @param options The mode, the lifetime of cached statistics and the sample size.
+     */
+    void setStatisticsOptions(const Abstracts::StatisticsOptions& options);
+
+    /**
+     * @brief Returns the statistics settings of this connection.
+     */
+    Abstracts::StatisticsOptions statisticsOptions() const;
+
+    /**
+     * @brief Estimates the number of rows in a table from the catalog.
+     *
+     * The planner's own estimate: reltuples per page of the last VACUUM or ANALYZE times the pages the
+     * table has now. A table that was never analyzed, or a partitioned one, is counted exactly.
+     *
+     * @param tableName The table, qualified or not.
+     * @return The estimated number of rows.
+     * @throws std::runtime_error If the table does not exist or the query fails.
+     */
+    std::uint64_t estimateRowCount(const std::string& tableName);
+
+    /**
+     * @brief Estimates the number of distinct non-NULL values of a column.
+     *
+     * A TABLESAMPLE BERNOULLI sample of about the configured number of rows is streamed through a
+     * HyperLogLog sketch and scaled to the whole table; see Abstracts::StatisticsEstimator. Tables no
+     * larger than the sample are read whole.
+     *
+     * @param tableName The table.
+     * @param columnName The column.
+     * @return The estimated number of distinct values.
+     * @throws std::runtime_error If a query fails.
+     */
+    std::uint64_t estimateDistinctCount(const std::string& tableName, const std::string& columnName);
+
     /**
      * @brief Executes a script by reading and executing SQL statements from a file.
      *
+     * The file is read while it runs: each statement is sent as soon as its terminator is read, on one
+     * connection, so session settings and transactions in the script carry over to its later statements.
+     * The first failing statement stops the script, and the last error names its line. A transaction the
+     * script leaves open is rolled back. See Abstracts::SqlScriptReader.
+     *
      * @param filename The name of the file containing the SQL script.
      * @return True if the script execution is successful, false otherwise.
      */
     bool executeScriptFromFile(const std::string& filename) __cell_override;
 
     /**
-     * @brief Creates a backup of the database to a file.
+     * @brief Creates a backup of the database in a directory; see backup().
      *
-     * @param backupFilename The name of the backup file.
+     * @param backupFilename The backup directory.
      * @return True if the database backup is successful, false otherwise.
      */
     bool backupDatabase(const std::string& backupFilename) __cell_override;
 
     /**
-     * @brief Restores a database from a backup file.
+     * @brief Restores a database from a backup directory; see restore().
      *
-     * @param backupFilename The name of the backup file to restore from.
+     * @param backupFilename The backup directory to restore from.
      * @return True if the database restore is successful, false otherwise.
      */
     bool restoreDatabase(const std::string& backupFilename) __cell_override;
 
+    /**
+     * @brief Writes the rows of every table and the positions of the sequences into a directory.
+     *
+     * The backup runs in the driver, without pg_dump. One connection opens a REPEATABLE READ transaction
+     * and exports its snapshot; the other workers import it, so every table is read as of the same
+     * moment while they copy different tables at once. Each table is streamed with COPY TO STDOUT
+     * through zlib into a file of its own, largest tables first, and a manifest listing them is written
+     * when all are complete.
+     *
+     * Only data is saved: the schema must already exist where the backup is restored, e.g. created by
+     * the application's migrations.
+     *
+     * @param directory The backup directory; it is created if needed.
+     * @param options The number of connections, the compression level and the COPY format.
+     * @return The manifest.
+     * @throws std::runtime_error If a table cannot be read or a file cannot be written; no manifest is written.
+     */
+    PostgreSqlBackupManifest backup(const std::string& directory, const PostgreSqlBackupOptions& options = {});
+
+    /**
+     * @brief Loads a directory written by backup() into the existing tables.
+     *
+     * Tables are loaded with COPY FROM STDIN over several pooled connections at once, in waves so a
+     * table is only loaded after every table its foreign keys reference; tables in a cycle of foreign
+     * keys come last and need deferrable constraints. Each table is committed when its COPY finishes.
+     * The sequences are then set to their saved positions.
+     *
+     * @param directory The backup directory.
+     * @param options The number of connections and whether the tables are emptied first.
+     * @return The manifest.
+     * @throws std::runtime_error If the manifest is missing or a table fails to load; tables loaded before stay.
+     */
+    PostgreSqlBackupManifest restore(const std::string& directory, const PostgreSqlRestoreOptions& options = {});
+
     /**
      * @brief Retrieves the list of databases available in the server.
      *
@@ -723,8 +1072,10 @@ public:
     /**
      * @brief Retrieves the size of a table in the database.
      *
+     * The size includes indexes and TOAST data and is cached in the fast statistics mode.
+     *
      * @param tableName The name of the table.
-     * @return The size of the table in bytes.
+     * @return The size of the table in bytes, at most INT_MAX, or -1 on failure.
      */
     int getTableSize(const std::string& tableName) __cell_override;
 
@@ -738,6 +1089,10 @@ public:
     /**
      * @brief Imports data into a table from a file.
      *
+     * The file is read on the client and streamed with COPY ... FROM STDIN, so neither superuser rights
+     * nor access to the server's file system are needed. Files in COPY binary format are recognised by
+     * their signature; anything else is read as COPY text format.
+     *
      * @param tableName The name of the table.
      * @param filePath The path to the file containing the data to import.
      */
@@ -746,6 +1101,8 @@ public:
     /**
      * @brief Exports data from a table to a file.
      *
+     * The table is streamed with COPY ... TO STDOUT into a file on the client, in COPY text format.
+     *
      * @param tableName The name of the table.
      * @param filePath The path to the file where the data will be exported.
      */
@@ -759,6 +1116,81 @@ public:
     std::string getLastError() __cell_override;
 
 private:
+    /**
+     * @brief Records the error returned by getLastError(); safe to call from the reactor and std::async threads.
+     */
+    void setLastError(std::string error);
+
+    /**
+     * @brief Returns the connection pinned by beginTransaction(), or leases one from the pool.
+     *
+     * @param lease Receives the lease when no transaction is pinned.
+     */
+    Types::PostgreSqlPtr acquireConnection(Abstracts::ConnectionLease& lease);
+
+    /**
+     * @brief Returns the current replica router, or nullptr without replicas.
+     */
+    std::shared_ptr<Abstracts::PoolRouter> replicaRouter() const;
+
+    /**
+     * @brief Returns a connection for a read, from a replica when the statement and the session allow it.
+     *
+     * @param sql The statement to be run.
+     * @param lease Receives the lease when no transaction is pinned.
+     * @param pool Receives the pool the connection belongs to.
+     * @param allowReplica False to read from the primary whatever the statement.
+     */
+    Types::PostgreSqlPtr acquireReadConnection(const std::string& sql, Abstracts::ConnectionLease& lease, PostgreSqlConnectionPool*& pool,
+                                               bool allowReplica = true);
+
+    /**
+     * @brief Runs queryResult(), optionally keeping the read off the replicas.
+     */
+    Abstracts::ResultSetPtr readResult(const std::string& sql, const std::vector<std::string>& params, Abstracts::ResultFormat format,
+                                       bool allowReplica);
+
+    /**
+     * @brief Notes a write made through this connection.
+     *
+     * The cached results that depend on the tables are dropped, and reads stay on the primary for the
+     * stickiness window. Inside a transaction the tables are remembered and invalidated when it
+     * commits, since other sessions only see the write from then on.
+     *
+     * @param tables The tables written, or std::nullopt if they cannot be told.
+     */
+    void recordWrite(const std::optional<std::vector<std::string>>& tables);
+
+    /**
+     * @brief Notes a schema change made through this connection.
+     *
+     * The pool's schema catalog is invalidated now and, inside a transaction, again when it commits.
+     */
+    void recordSchemaChange();
+
+    /**
+     * @brief Returns a statistic, from the query cache in the fast statistics mode.
+     *
+     * Outside the fast mode, and inside a transaction, it is computed every time.
+     */
+    Abstracts::QueryCache::RowsPtr statistic(std::string_view name,
+                                             const std::string& tableName,
+                                             const std::string& columnName,
+                                             const Abstracts::StatisticsEstimator::Compute& compute);
+
+    /**
+     * @brief Returns the average and the sum of a column, from a sample in the fast statistics mode.
+     */
+    std::pair<double, double> sampledAggregates(const std::string& tableName, const std::string& columnName);
+
+    /**
+     * @brief Executes a query expected to return at most one value.
+     *
+     * @return The value, or std::nullopt if there is no row or it is NULL.
+     * @throws std::runtime_error If the query fails.
+     */
+    std::optional<std::string> queryScalar(const std::string& sql, const std::vector<std::string>& params = {});
+
     /**
      * @brief Validates the syntax of an SQL query.
      *
@@ -780,6 +1212,11 @@ private:
     PostgreSqlData           m_PostgreSqlData;
     PostgreSqlPtr            connection;         //!< Pointer to the MySQL connection object.
     PostgreSqlConnectionPool& connectionPool;    //!< Reference to the MySQL connection pool.
+    Abstracts::PinnedTransactions m_transactions;        //!< Transactions opened by beginTransaction(), per calling thread.
+    std::shared_ptr<Abstracts::PoolRouter> m_router;     //!< Sends reads to replicas; empty without replicas.
+    mutable Types::Mutex     m_routerMutex;      //!< Guards m_router; readers take a copy.
+    std::atomic<std::chrono::steady_clock::time_point> m_lastWriteAt {}; //!< Last write of this session, for read-your-writes.
+    PostgreSqlReactor        m_reactor;          //!< Completes the asynchronous queries; destroyed first.
 };
 
 CELL_NAMESPACE_END
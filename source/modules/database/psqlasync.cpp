@@ -0,0 +1,489 @@
+#if __has_include("psqlasync.hpp")
+#   include "psqlasync.hpp"
+#else
+#   error "Cell's "psqlasync.hpp" was not found!"
+#endif
+
+#if defined(USE_POSTGRESQL)
+
+#if __has_include("core/core.hpp")
+#   include "core/core.hpp"
+#else
+#   error "Cell's "core/core.hpp" was not found!"
+#endif
+
+#if __has_include("psqlresultset.hpp")
+#   include "psqlresultset.hpp"
+#else
+#   error "Cell's "psqlresultset.hpp" was not found!"
+#endif
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+CELL_USING_NAMESPACE Cell;
+CELL_USING_NAMESPACE Cell::System;
+CELL_USING_NAMESPACE Cell::Types;
+
+CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Database)
+
+namespace {
+
+using PostgreSqlResult = std::unique_ptr<PGresult, decltype(&PQclear)>;
+
+std::exception_ptr databaseError(const std::string& message)
+{
+    return std::make_exception_ptr(Exception(Exception::Reason::Database, message).getRuntimeError());
+}
+
+std::vector<const char*> parameterValues(const std::vector<std::string>& params)
+{
+    std::vector<const char*> values;
+    values.reserve(params.size());
+    for (const auto& param : params) {
+        values.push_back(param.c_str());
+    }
+    return values;
+}
+
+bool isSuccess(ExecStatusType status)
+{
+    return status == PGRES_COMMAND_OK || status == PGRES_TUPLES_OK || status == PGRES_EMPTY_QUERY;
+}
+
+}  // namespace
+
+/**
+ * @brief A query in flight.
+ */
+struct PostgreSqlReactor::Operation final
+{
+    Abstracts::ConnectionLease  lease       {};                         //!< Returned when the query completes.
+    PostgreSqlPtr               connection  {};                         //!< The connection the query runs on.
+    Abstracts::ResultFormat     format      {};                         //!< Format of the values.
+    Completion                  completion  {};                         //!< Receives the outcome.
+    PostgreSqlResult            result      { __cell_nullptr, &PQclear };  //!< Last successful result.
+    std::string                 error       {};                         //!< First error reported by the server.
+    bool                        flushing    { false };                  //!< Whether the query is not fully sent yet.
+    bool                        broken      { false };                  //!< Whether the connection must not be reused.
+};
+
+PostgreSqlReactor::PostgreSqlReactor()
+{
+    if (::pipe(m_wakeup.data()) != 0) {
+        throw Exception(Exception::Reason::Database, "Failed to create the wake-up pipe of the PostgreSql reactor.").getRuntimeError();
+    }
+    for (const int descriptor : m_wakeup) {
+        ::fcntl(descriptor, F_SETFL, ::fcntl(descriptor, F_GETFL) | O_NONBLOCK);
+        ::fcntl(descriptor, F_SETFD, FD_CLOEXEC);
+    }
+}
+
+PostgreSqlReactor::~PostgreSqlReactor()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    wake();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    for (const int descriptor : m_wakeup) {
+        ::close(descriptor);
+    }
+}
+
+void PostgreSqlReactor::submit(Abstracts::ConnectionLease lease,
+                               PostgreSqlPtr connection,
+                               const std::string& sql,
+                               const std::vector<std::string>& params,
+                               Abstracts::ResultFormat format,
+                               Completion completion)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stopping) {
+            throw std::logic_error("The PostgreSql reactor is shutting down.");
+        }
+    }
+
+    auto operation = std::make_unique<Operation>();
+    operation->lease = std::move(lease);
+    operation->connection = connection;
+    operation->format = format;
+    operation->completion = std::move(completion);
+
+    // The simple query protocol only returns text; anything else goes through an unnamed statement
+    const auto values = parameterValues(params);
+    const bool sent = PQsetnonblocking(connection, 1) == 0
+                      && (params.empty() && format == Abstracts::ResultFormat::Text
+                              ? PQsendQuery(connection, sql.c_str())
+                              : PQsendQueryParams(connection, sql.c_str(), static_cast<int>(params.size()), __cell_nullptr,
+                                                  values.data(), __cell_nullptr, __cell_nullptr, static_cast<int>(format))) == 1;
+    const int flushed = sent ? PQflush(connection) : -1;
+    if (flushed < 0) {
+        operation->broken = PQstatus(connection) == CONNECTION_BAD;
+        ++m_pending;
+        complete(*operation, databaseError(PQerrorMessage(connection)));
+        return;
+    }
+    operation->flushing = flushed == 1;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_thread.joinable()) {
+            m_thread = std::thread(&PostgreSqlReactor::run, this);
+        }
+        m_incoming.push_back(std::move(operation));
+    }
+    ++m_pending;
+    wake();
+}
+
+std::future<Abstracts::ResultSetPtr> PostgreSqlReactor::submit(Abstracts::ConnectionLease lease,
+                                                               PostgreSqlPtr connection,
+                                                               const std::string& sql,
+                                                               const std::vector<std::string>& params,
+                                                               Abstracts::ResultFormat format)
+{
+    auto promise = std::make_shared<std::promise<Abstracts::ResultSetPtr>>();
+    auto future = promise->get_future();
+    submit(std::move(lease), connection, sql, params, format, [promise](Abstracts::ResultSetPtr result, std::exception_ptr error) {
+        if (error) {
+            promise->set_exception(error);
+        } else {
+            promise->set_value(std::move(result));
+        }
+    });
+    return future;
+}
+
+std::size_t PostgreSqlReactor::pending() const
+{
+    return m_pending.load(std::memory_order_relaxed);
+}
+
+void PostgreSqlReactor::run()
+{
+    std::vector<std::unique_ptr<Operation>> active;
+    std::vector<pollfd> descriptors;
+
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (auto& operation : m_incoming) {
+                active.push_back(std::move(operation));
+            }
+            m_incoming.clear();
+            if (m_stopping) {
+                break;
+            }
+        }
+
+        descriptors.clear();
+        descriptors.push_back({ m_wakeup[0], POLLIN, 0 });
+        for (const auto& operation : active) {
+            const short events = static_cast<short>(POLLIN | (operation->flushing ? POLLOUT : 0));
+            descriptors.push_back({ PQsocket(operation->connection), events, 0 });
+        }
+
+        if (::poll(descriptors.data(), static_cast<nfds_t>(descriptors.size()), -1) < 0) {
+            continue;
+        }
+
+        if (descriptors.front().revents & POLLIN) {
+            char drain[64];
+            while (::read(m_wakeup[0], drain, sizeof(drain)) > 0) {
+            }
+        }
+
+        // descriptors[i + 1] belongs to active[i]; completed operations are compacted away afterwards
+        for (std::size_t i = 0; i < active.size(); ++i) {
+            const short events = descriptors[i + 1].revents;
+            if (events != 0 && advance(*active[i], events)) {
+                active[i].reset();
+            }
+        }
+        std::erase(active, __cell_nullptr);
+    }
+
+    // Whatever is still in flight leaves its connection mid-query
+    for (auto& operation : active) {
+        operation->broken = true;
+        complete(*operation, databaseError("The PostgreSql reactor was shut down before the query completed."));
+    }
+}
+
+void PostgreSqlReactor::wake()
+{
+    const char signal = 1;
+    [[maybe_unused]] const auto written = ::write(m_wakeup[1], &signal, 1);
+}
+
+bool PostgreSqlReactor::advance(Operation& operation, short events)
+{
+    PostgreSqlPtr connection = operation.connection;
+
+    if (events & POLLOUT) {
+        const int flushed = PQflush(connection);
+        if (flushed < 0) {
+            operation.broken = true;
+            complete(operation, databaseError(PQerrorMessage(connection)));
+            return true;
+        }
+        operation.flushing = flushed == 1;
+    }
+
+    if (events & (POLLIN | POLLERR | POLLHUP)) {
+        if (PQconsumeInput(connection) == 0) {
+            operation.broken = true;
+            complete(operation, databaseError(PQerrorMessage(connection)));
+            return true;
+        }
+    }
+
+    // Only whole results are taken, so PQgetResult never blocks here
+    while (!PQisBusy(connection)) {
+        PGresult* next = PQgetResult(connection);
+        if (next == __cell_nullptr) {
+            complete(operation, operation.error.empty() ? __cell_nullptr : databaseError(operation.error));
+            return true;
+        }
+
+        PostgreSqlResult result(next, &PQclear);
+        const auto status = PQresultStatus(result.get());
+        if (isSuccess(status)) {
+            if (operation.error.empty()) {
+                operation.result = std::move(result);
+            }
+        } else if (status == PGRES_COPY_IN || status == PGRES_COPY_OUT || status == PGRES_COPY_BOTH) {
+            // COPY needs its own protocol; use PostgreSqlCopyIn/PostgreSqlCopyOut instead
+            operation.broken = true;
+            complete(operation, databaseError("COPY cannot be run asynchronously."));
+            return true;
+        } else if (operation.error.empty()) {
+            operation.error = PQresultErrorMessage(result.get());
+        }
+    }
+    return false;
+}
+
+void PostgreSqlReactor::complete(Operation& operation, std::exception_ptr error)
+{
+    Abstracts::ResultSetPtr resultSet;
+    if (!error) {
+        PGresult* result = operation.result ? operation.result.release() : PQmakeEmptyPGresult(operation.connection, PGRES_COMMAND_OK);
+        resultSet = std::make_unique<PostgreSqlResultSet>(result, operation.format);
+    }
+
+    // The connection goes back first, so the next borrower does not wait for the completion
+    if (operation.broken) {
+        operation.lease.discard();
+    } else {
+        PQsetnonblocking(operation.connection, 0);
+        operation.lease.release();
+    }
+    --m_pending;
+
+    try {
+        operation.completion(std::move(resultSet), error);
+    } catch (...) {
+        // A completion must not take the reactor down with it
+    }
+}
+
+PostgreSqlPipeline::PostgreSqlPipeline(PostgreSqlPtr connection)
+    : m_connection(connection)
+{
+#if defined(LIBPQ_HAS_PIPELINING)
+    if (PQenterPipelineMode(m_connection) != 1) {
+        throw Exception(Exception::Reason::Database, PQerrorMessage(m_connection)).getRuntimeError();
+    }
+    // Sending without blocking lets flush() read results while the server is still taking the batch
+    if (PQsetnonblocking(m_connection, 1) != 0) {
+        PQexitPipelineMode(m_connection);
+        throw Exception(Exception::Reason::Database, PQerrorMessage(m_connection)).getRuntimeError();
+    }
+    m_pipelined = true;
+#endif
+}
+
+PostgreSqlPipeline::~PostgreSqlPipeline()
+{
+    if (size() > 0) {
+        try {
+            sync();
+        } catch (const std::exception&) {
+        }
+    }
+#if defined(LIBPQ_HAS_PIPELINING)
+    if (m_pipelined) {
+        PQsetnonblocking(m_connection, 0);
+        PQexitPipelineMode(m_connection);
+    }
+#endif
+}
+
+void PostgreSqlPipeline::add(const std::string& sql, const std::vector<std::string>& params, Abstracts::ResultFormat format)
+{
+    send(Queued { .text = sql, .params = params, .format = format, .prepared = false });
+}
+
+void PostgreSqlPipeline::addPrepared(const std::string& name, const std::vector<std::string>& params, Abstracts::ResultFormat format)
+{
+    send(Queued { .text = name, .params = params, .format = format, .prepared = true });
+}
+
+std::vector<Abstracts::ResultSetPtr> PostgreSqlPipeline::sync()
+{
+    std::vector<Abstracts::ResultSetPtr> results;
+    std::string error;
+    m_sqlState.clear();
+    m_errorMessage.clear();
+
+    const auto keep = [&](PostgreSqlResult result, Abstracts::ResultFormat format) {
+        const auto status = PQresultStatus(result.get());
+        if (!isSuccess(status) && error.empty()) {
+            // Statements after a failure come back as PGRES_PIPELINE_ABORTED; the first error is the one to report
+            error = PQresultErrorMessage(result.get());
+            const char* sqlState = PQresultErrorField(result.get(), PG_DIAG_SQLSTATE);
+            m_sqlState = sqlState ? sqlState : "";
+            const char* message = PQresultErrorField(result.get(), PG_DIAG_MESSAGE_PRIMARY);
+            m_errorMessage = message ? message : "";
+        }
+        results.push_back(std::make_unique<PostgreSqlResultSet>(result.release(), format));
+    };
+
+#if defined(LIBPQ_HAS_PIPELINING)
+    if (m_pipelined) {
+        const auto queued = std::exchange(m_queued, {});
+
+        if (PQpipelineSync(m_connection) != 1) {
+            throw Exception(Exception::Reason::Database, PQerrorMessage(m_connection)).getRuntimeError();
+        }
+        flush();
+
+        results.reserve(queued.size());
+        for (const auto& statement : queued) {
+            // Each statement yields its result followed by a null
+            PostgreSqlResult result(PQgetResult(m_connection), &PQclear);
+            if (!result) {
+                throw Exception(Exception::Reason::Database, PQerrorMessage(m_connection)).getRuntimeError();
+            }
+            while (PGresult* extra = PQgetResult(m_connection)) {
+                PQclear(extra);
+            }
+            keep(std::move(result), statement.format);
+        }
+
+        PostgreSqlResult synced(PQgetResult(m_connection), &PQclear);
+        if (PQresultStatus(synced.get()) != PGRES_PIPELINE_SYNC) {
+            throw Exception(Exception::Reason::Database, PQerrorMessage(m_connection)).getRuntimeError();
+        }
+        if (!error.empty()) {
+            throw Exception(Exception::Reason::Database, error).getRuntimeError();
+        }
+        return results;
+    }
+#endif
+
+    // Without pipeline mode the batch keeps its all-or-nothing outcome with an explicit transaction
+    auto queued = std::exchange(m_queued, {});
+    const bool ownTransaction = queued.size() > 1 && PQtransactionStatus(m_connection) == PQTRANS_IDLE;
+    if (ownTransaction) {
+        PQclear(PQexec(m_connection, "BEGIN"));
+    }
+    results.reserve(queued.size());
+    for (const auto& statement : queued) {
+        const auto values = parameterValues(statement.params);
+        const int count = static_cast<int>(statement.params.size());
+        PostgreSqlResult result(statement.prepared
+                                    ? PQexecPrepared(m_connection, statement.text.c_str(), count, values.data(), __cell_nullptr, __cell_nullptr,
+                                                     static_cast<int>(statement.format))
+                                    : PQexecParams(m_connection, statement.text.c_str(), count, __cell_nullptr, values.data(), __cell_nullptr,
+                                                   __cell_nullptr, static_cast<int>(statement.format)),
+                                &PQclear);
+        keep(std::move(result), statement.format);
+        if (!error.empty()) {
+            break;
+        }
+    }
+    if (ownTransaction) {
+        PQclear(PQexec(m_connection, error.empty() ? "COMMIT" : "ROLLBACK"));
+    }
+    if (!error.empty()) {
+        throw Exception(Exception::Reason::Database, error).getRuntimeError();
+    }
+    return results;
+}
+
+std::size_t PostgreSqlPipeline::size() const
+{
+    return m_queued.size();
+}
+
+const std::string& PostgreSqlPipeline::lastSqlState() const
+{
+    return m_sqlState;
+}
+
+const std::string& PostgreSqlPipeline::lastErrorMessage() const
+{
+    return m_errorMessage;
+}
+
+void PostgreSqlPipeline::send(Queued statement)
+{
+    if (!m_pipelined) {
+        m_queued.push_back(std::move(statement));
+        return;
+    }
+
+#if defined(LIBPQ_HAS_PIPELINING)
+    const auto values = parameterValues(statement.params);
+    const int count = static_cast<int>(statement.params.size());
+    const int sent = statement.prepared
+                         ? PQsendQueryPrepared(m_connection, statement.text.c_str(), count, values.data(), __cell_nullptr, __cell_nullptr,
+                                               static_cast<int>(statement.format))
+                         : PQsendQueryParams(m_connection, statement.text.c_str(), count, __cell_nullptr, values.data(), __cell_nullptr,
+                                             __cell_nullptr, static_cast<int>(statement.format));
+    if (sent != 1) {
+        throw Exception(Exception::Reason::Database, PQerrorMessage(m_connection)).getRuntimeError();
+    }
+    // Only the format is needed to read the result back
+    m_queued.push_back(Queued { .format = statement.format });
+
+    // Keep libpq's buffer from growing with the batch; what the socket does not take now goes at sync()
+    if (PQflush(m_connection) < 0) {
+        throw Exception(Exception::Reason::Database, PQerrorMessage(m_connection)).getRuntimeError();
+    }
+#endif
+}
+
+void PostgreSqlPipeline::flush()
+{
+    for (;;) {
+        const int flushed = PQflush(m_connection);
+        if (flushed == 0) {
+            return;
+        }
+        if (flushed < 0) {
+            throw Exception(Exception::Reason::Database, PQerrorMessage(m_connection)).getRuntimeError();
+        }
+
+        // The server may stop reading until its results are read; buffer them in libpq meanwhile
+        pollfd descriptor { PQsocket(m_connection), POLLIN | POLLOUT, 0 };
+        if (::poll(&descriptor, 1, -1) < 0) {
+            continue;
+        }
+        if ((descriptor.revents & (POLLIN | POLLERR | POLLHUP)) && PQconsumeInput(m_connection) == 0) {
+            throw Exception(Exception::Reason::Database, PQerrorMessage(m_connection)).getRuntimeError();
+        }
+    }
+}
+
+CELL_NAMESPACE_END
+
+#endif
@@ -0,0 +1,238 @@
+/*!
+ * @file        psqlasync.hpp
+ * @brief       Database PostgreSql asynchronous execution for the Cell Engine.
+ * @details     This file defines PostgreSqlReactor, which runs queries without a thread per query, and PostgreSqlPipeline, which batches statements into one round trip.
+ * @author      Kambiz Asadzadeh
+ * @since       07 Jun 2023
+ * @version     1.0
+ * @note        This is part of the Cell Engine, developed by Kambiz Asadzadeh.
+ *
+ * @license     This file is licensed under the terms of the Genyleap License. See the LICENSE.md file for more information.
+ * @copyright   Copyright (c) 2025 The Genyleap | Kambiz Asadzadeh. All rights reserved.
+ * @see         https://github.com/genyleap/cell
+ */
+
+#ifndef CELL_PSQL_ASYNC_HPP
+#define CELL_PSQL_ASYNC_HPP
+
+#if defined(USE_POSTGRESQL)
+
+#if __has_include("common.hpp")
+#   include "common.hpp"
+#else
+#   error "Cell's "common.hpp" was not found!"
+#endif
+
+#if __has_include("abstract-includer.hpp")
+#   include "abstract-includer.hpp"
+#else
+#   error "Cell's "abstract-includer.hpp" was not found!"
+#endif
+
+CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Database)
+
+/**
+ * @brief Multiplexes the sockets of in-flight PostgreSql queries on one thread.
+ *
+ * A query is sent with PQsendQuery/PQsendQueryParams on a connection switched to non-blocking mode,
+ * and its socket is then watched with poll() until PQconsumeInput has read the whole result. Any
+ * number of queries in flight cost one thread in total instead of one thread each, and the thread
+ * sleeps in poll() while the server works.
+ *
+ * The thread is started by the first submit(). Completions run on it and must not block.
+ *
+ * @note This class is marked with the "__cell_export" attribute, indicating
+ *       it is part of the "cell" module for exporting purposes.
+ */
+class __cell_export PostgreSqlReactor final
+{
+public:
+    /**
+     * @brief Receives the result of a query: the result set, or the error it failed with.
+     */
+    using Completion = std::function<void(Abstracts::ResultSetPtr result, std::exception_ptr error)>;
+
+    PostgreSqlReactor();
+
+    /**
+     * @brief Stops the thread; queries still in flight fail and their connections are discarded.
+     */
+    ~PostgreSqlReactor();
+
+    /**
+     * @brief Disable copy construction and assignment for a class.
+     */
+    CELL_DISABLE_COPY(PostgreSqlReactor)
+
+    /**
+     * @brief Sends a query and returns at once.
+     *
+     * @param lease The lease of the connection, or an empty lease when the connection is pinned by a transaction;
+     *              it is released when the query completes.
+     * @param connection The idle connection to run the query on.
+     * @param sql The query; without params it may hold several statements, and the last result is reported.
+     * @param params Values for $1, $2, ...
+     * @param format The format of the returned values.
+     * @param completion Called once, on the reactor thread, when the query has completed or failed.
+     */
+    void submit(Abstracts::ConnectionLease lease,
+                Types::PostgreSqlPtr connection,
+                const std::string& sql,
+                const std::vector<std::string>& params,
+                Abstracts::ResultFormat format,
+                Completion completion);
+
+    /**
+     * @brief Sends a query and returns a future of its result set.
+     */
+    std::future<Abstracts::ResultSetPtr> submit(Abstracts::ConnectionLease lease,
+                                                Types::PostgreSqlPtr connection,
+                                                const std::string& sql,
+                                                const std::vector<std::string>& params = {},
+                                                Abstracts::ResultFormat format = Abstracts::ResultFormat::Text);
+
+    /**
+     * @brief Returns the number of queries in flight.
+     */
+    std::size_t pending() const;
+
+private:
+    struct Operation;
+
+    /**
+     * @brief Polls the sockets until the reactor is destroyed.
+     */
+    void run();
+
+    /**
+     * @brief Interrupts poll() so new operations are picked up.
+     */
+    void wake();
+
+    /**
+     * @brief Reads whatever has arrived for an operation; returns true once it has completed.
+     */
+    bool advance(Operation& operation, short events);
+
+    /**
+     * @brief Reports the outcome of an operation and returns its connection.
+     */
+    void complete(Operation& operation, std::exception_ptr error);
+
+    mutable std::mutex                          m_mutex     {};         //!< Guards m_incoming, m_stopping and the thread.
+    std::vector<std::unique_ptr<Operation>>     m_incoming  {};         //!< Sent, not yet watched by the thread.
+    std::atomic<std::size_t>                    m_pending   {};         //!< Operations in flight.
+    std::array<int, 2>                          m_wakeup    { -1, -1 }; //!< Self-pipe that interrupts poll().
+    std::thread                                 m_thread    {};         //!< The reactor thread.
+    bool                                        m_stopping  { false };  //!< Set by the destructor.
+};
+
+/**
+ * @brief Sends a batch of statements in libpq pipeline mode, so the whole batch costs one round trip.
+ *
+ * Statements are queued with add() or addPrepared() and sent, with a single sync, by sync(). The
+ * statements of one sync run as one implicit transaction unless a transaction is already open: if one
+ * of them fails, the ones after it are skipped and none is committed.
+ *
+ * With a libpq older than 14, which has no pipeline mode, the statements are run one by one inside a
+ * transaction, which keeps the same outcome at the cost of a round trip each.
+ *
+ * @note This class is marked with the "__cell_export" attribute, indicating
+ *       it is part of the "cell" module for exporting purposes.
+ */
+class __cell_export PostgreSqlPipeline final
+{
+public:
+    /**
+     * @brief Switches a connection to pipeline mode.
+     *
+     * @param connection An idle connection; it must not be used by anything else until the pipeline is destroyed.
+     * @throws std::runtime_error If the connection cannot enter pipeline mode.
+     */
+    explicit PostgreSqlPipeline(Types::PostgreSqlPtr connection);
+
+    /**
+     * @brief Drains anything still queued and leaves pipeline mode.
+     */
+    ~PostgreSqlPipeline();
+
+    /**
+     * @brief Disable copy construction and assignment for a class.
+     */
+    CELL_DISABLE_COPY(PostgreSqlPipeline)
+
+    /**
+     * @brief Queues one statement.
+     *
+     * @param sql A single statement.
+     * @param params Values for $1, $2, ...
+     * @param format The format of the returned values.
+     */
+    void add(const std::string& sql, const std::vector<std::string>& params = {}, Abstracts::ResultFormat format = Abstracts::ResultFormat::Text);
+
+    /**
+     * @brief Queues an execution of a statement already prepared on the connection.
+     *
+     * @param name The name the statement was prepared under.
+     * @param params Values for $1, $2, ...
+     * @param format The format of the returned values.
+     */
+    void addPrepared(const std::string& name, const std::vector<std::string>& params = {}, Abstracts::ResultFormat format = Abstracts::ResultFormat::Text);
+
+    /**
+     * @brief Sends the queued statements and waits for all their results.
+     *
+     * @return One result set per statement, in order.
+     * @throws std::runtime_error With the error of the first statement that failed.
+     */
+    std::vector<Abstracts::ResultSetPtr> sync();
+
+    /**
+     * @brief Returns the number of statements queued since the last sync().
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Returns the server's SQLSTATE of the error thrown by the last sync(), or an empty string.
+     */
+    const std::string& lastSqlState() const;
+
+    /**
+     * @brief Returns the server's primary message of the error thrown by the last sync(), or an empty string.
+     */
+    const std::string& lastErrorMessage() const;
+
+private:
+    /**
+     * @brief A statement queued since the last sync().
+     */
+    struct Queued final
+    {
+        std::string                 text        {}; //!< The SQL, or the prepared statement name.
+        std::vector<std::string>    params      {}; //!< Parameter values.
+        Abstracts::ResultFormat     format      {}; //!< Result format.
+        bool                        prepared    {}; //!< Whether text is a statement name.
+    };
+
+    /**
+     * @brief Sends one statement, or keeps it for the fallback path.
+     */
+    void send(Queued statement);
+
+    /**
+     * @brief Writes out libpq's send buffer, reading results meanwhile so the server never stalls.
+     */
+    void flush();
+
+    Types::PostgreSqlPtr        m_connection    {};         //!< The connection in pipeline mode.
+    std::vector<Queued>         m_queued        {};         //!< Statements since the last sync(); only their format once sent.
+    std::string                 m_sqlState      {};         //!< SQLSTATE of the last failure.
+    std::string                 m_errorMessage  {};         //!< Primary message of the last failure.
+    bool                        m_pipelined     { false };  //!< Whether pipeline mode is in use.
+};
+
+CELL_NAMESPACE_END
+
+#endif
+
+#endif // CELL_PSQL_ASYNC_HPP
@@ -0,0 +1,187 @@
+#if __has_include("psqlbackup.hpp")
+#   include "psqlbackup.hpp"
+#else
+#   error "Cell's "psqlbackup.hpp" was not found!"
+#endif
+
+#if defined(USE_POSTGRESQL)
+
+#if __has_include("core/core.hpp")
+#   include "core/core.hpp"
+#else
+#   error "Cell's "core/core.hpp" was not found!"
+#endif
+
+CELL_USING_NAMESPACE Cell;
+CELL_USING_NAMESPACE Cell::System;
+CELL_USING_NAMESPACE Cell::Types;
+
+CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Database)
+
+namespace {
+
+/**
+ * @brief Escapes the characters that would end a field or a line of the manifest.
+ */
+std::string escapeField(std::string_view value)
+{
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (const char character : value) {
+        switch (character) {
+        case '\\':
+            escaped += "\\\\";
+            break;
+        case '\t':
+            escaped += "\\t";
+            break;
+        case '\n':
+            escaped += "\\n";
+            break;
+        case '\r':
+            escaped += "\\r";
+            break;
+        default:
+            escaped += character;
+        }
+    }
+    return escaped;
+}
+
+std::string unescapeField(std::string_view value)
+{
+    std::string unescaped;
+    unescaped.reserve(value.size());
+    for (std::size_t i = 0; i < value.size(); ++i) {
+        if (value[i] != '\\' || i + 1 == value.size()) {
+            unescaped += value[i];
+            continue;
+        }
+        switch (value[++i]) {
+        case 't':
+            unescaped += '\t';
+            break;
+        case 'n':
+            unescaped += '\n';
+            break;
+        case 'r':
+            unescaped += '\r';
+            break;
+        default:
+            unescaped += value[i];
+        }
+    }
+    return unescaped;
+}
+
+std::vector<std::string_view> splitFields(std::string_view line)
+{
+    std::vector<std::string_view> fields;
+    while (true) {
+        const auto tab = line.find('\t');
+        fields.push_back(line.substr(0, tab));
+        if (tab == std::string_view::npos) {
+            return fields;
+        }
+        line.remove_prefix(tab + 1);
+    }
+}
+
+template <typename T>
+T parseNumber(std::string_view field, const std::filesystem::path& path)
+{
+    T value {};
+    const auto [end, error] = std::from_chars(field.data(), field.data() + field.size(), value);
+    if (error != std::errc {} || end != field.data() + field.size()) {
+        throw Exception(Exception::Reason::Database, "Malformed backup manifest '" + path.string() + "'.").getRuntimeError();
+    }
+    return value;
+}
+
+}  // namespace
+
+void PostgreSqlBackupManifest::write(const std::filesystem::path& directory) const
+{
+    const auto path = directory / POSTGRESQL_BACKUP_CONSTANTS::MANIFEST_FILE;
+    auto temporary = path;
+    temporary += ".tmp";
+
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file << POSTGRESQL_BACKUP_CONSTANTS::MANIFEST_SIGNATURE << '\t' << POSTGRESQL_BACKUP_CONSTANTS::MANIFEST_VERSION << '\n'
+             << "format\t" << (format == Abstracts::ResultFormat::Binary ? "binary" : "text") << '\n'
+             << "created\t" << std::chrono::duration_cast<std::chrono::seconds>(createdAt.time_since_epoch()).count() << '\n';
+        for (const auto& table : tables) {
+            file << "table\t" << table.wave << '\t' << table.rows << '\t' << table.bytes << '\t'
+                 << escapeField(table.file) << '\t' << escapeField(table.name) << '\n';
+        }
+        for (const auto& sequence : sequences) {
+            file << "sequence\t" << sequence.value << '\t' << escapeField(sequence.name) << '\n';
+        }
+        file.flush();
+        if (!file) {
+            throw Exception(Exception::Reason::Database, "Failed to write the backup manifest '" + temporary.string() + "'.").getRuntimeError();
+        }
+    }
+
+    // A rename replaces the manifest at once, so a reader never sees half of one
+    std::filesystem::rename(temporary, path);
+}
+
+PostgreSqlBackupManifest PostgreSqlBackupManifest::read(const std::filesystem::path& directory)
+{
+    const auto path = directory / POSTGRESQL_BACKUP_CONSTANTS::MANIFEST_FILE;
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw Exception(Exception::Reason::Database, "No backup manifest at '" + path.string() + "'.").getRuntimeError();
+    }
+    const auto malformed = [&path]() {
+        return Exception(Exception::Reason::Database, "Malformed backup manifest '" + path.string() + "'.").getRuntimeError();
+    };
+
+    std::string line;
+    if (!std::getline(file, line)) {
+        throw malformed();
+    }
+    const auto header = splitFields(line);
+    if (header.size() != 2 || header[0] != POSTGRESQL_BACKUP_CONSTANTS::MANIFEST_SIGNATURE) {
+        throw malformed();
+    }
+    if (parseNumber<Types::uint>(header[1], path) > POSTGRESQL_BACKUP_CONSTANTS::MANIFEST_VERSION) {
+        throw Exception(Exception::Reason::Database, "The backup manifest '" + path.string() + "' is of a newer version.").getRuntimeError();
+    }
+
+    PostgreSqlBackupManifest manifest;
+    while (std::getline(file, line)) {
+        if (line.empty()) {
+            continue;
+        }
+        const auto fields = splitFields(line);
+        if (fields[0] == "format" && fields.size() == 2) {
+            manifest.format = fields[1] == "binary" ? Abstracts::ResultFormat::Binary : Abstracts::ResultFormat::Text;
+        } else if (fields[0] == "created" && fields.size() == 2) {
+            manifest.createdAt = std::chrono::system_clock::time_point(std::chrono::seconds(parseNumber<std::int64_t>(fields[1], path)));
+        } else if (fields[0] == "table" && fields.size() == 6) {
+            PostgreSqlBackupTable table;
+            table.wave = parseNumber<Types::uint>(fields[1], path);
+            table.rows = parseNumber<std::uint64_t>(fields[2], path);
+            table.bytes = parseNumber<std::uint64_t>(fields[3], path);
+            table.file = unescapeField(fields[4]);
+            table.name = unescapeField(fields[5]);
+            // A table file never leaves the backup directory
+            if (table.file.empty() || table.file == ".." || table.file.find_first_of("/\\:") != std::string::npos) {
+                throw malformed();
+            }
+            manifest.tables.push_back(std::move(table));
+        } else if (fields[0] == "sequence" && fields.size() == 3) {
+            manifest.sequences.push_back({ unescapeField(fields[2]), parseNumber<std::int64_t>(fields[1], path) });
+        } else {
+            throw malformed();
+        }
+    }
+    return manifest;
+}
+
+CELL_NAMESPACE_END
+
+#endif
@@ -0,0 +1,120 @@
+/*!
+ * @file        psqlbackup.hpp
+ * @brief       Database PostgreSql logical backup for the Cell Engine.
+ * @details     This file defines the options and the manifest of a parallel COPY based backup.
+ * @author      Kambiz Asadzadeh
+ * @since       07 Jun 2023
+ * @version     1.0
+ * @note        This is part of the Cell Engine, developed by Kambiz Asadzadeh.
+ *
+ * @license     This file is licensed under the terms of the Genyleap License. See the LICENSE.md file for more information.
+ * @copyright   Copyright (c) 2025 The Genyleap | Kambiz Asadzadeh. All rights reserved.
+ * @see         https://github.com/genyleap/cell
+ */
+
+#ifndef CELL_PSQL_BACKUP_HPP
+#define CELL_PSQL_BACKUP_HPP
+
+#if defined(USE_POSTGRESQL)
+
+#if __has_include("common.hpp")
+#   include "common.hpp"
+#else
+#   error "Cell's "common.hpp" was not found!"
+#endif
+
+#if __has_include("abstract-includer.hpp")
+#   include "abstract-includer.hpp"
+#else
+#   error "Cell's "abstract-includer.hpp" was not found!"
+#endif
+
+CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Database)
+
+/**
+ * @brief Constants related to PostgreSql backups.
+ */
+struct POSTGRESQL_BACKUP_CONSTANTS final
+{
+    __cell_static_const_constexpr std::string_view MANIFEST_FILE        = "manifest.tsv";           //!< The manifest, written last.
+    __cell_static_const_constexpr std::string_view MANIFEST_SIGNATURE   = "cell-postgresql-backup"; //!< First field of the manifest.
+    __cell_static_const_constexpr Types::uint      MANIFEST_VERSION     = 1;                        //!< Layout of the manifest.
+    __cell_static_const_constexpr std::string_view TABLE_FILE_SUFFIX    = ".copy.gz";               //!< Suffix of a table's file.
+    __cell_static_const_constexpr Types::uint      DEFAULT_PARALLELISM  = 4;                        //!< Tables copied at the same time.
+    __cell_static_const_constexpr std::size_t      CHUNK_SIZE           = 256 * 1024;               //!< Bytes zlib buffers and restore reads at a time.
+};
+
+/**
+ * @brief Options of a backup.
+ */
+struct PostgreSqlBackupOptions final
+{
+    Types::uint             parallelism         { POSTGRESQL_BACKUP_CONSTANTS::DEFAULT_PARALLELISM };   //!< Pooled connections copying tables at the same time.
+    int                     compressionLevel    { Z_DEFAULT_COMPRESSION };                              //!< zlib level, from Z_NO_COMPRESSION to Z_BEST_COMPRESSION.
+    Abstracts::ResultFormat format              { Abstracts::ResultFormat::Text };                      //!< COPY text or binary format.
+};
+
+/**
+ * @brief Options of a restore.
+ */
+struct PostgreSqlRestoreOptions final
+{
+    Types::uint parallelism { POSTGRESQL_BACKUP_CONSTANTS::DEFAULT_PARALLELISM };   //!< Pooled connections loading tables at the same time.
+    bool        truncate    { false };                                              //!< Empty the tables of the backup first.
+};
+
+/**
+ * @brief A table of a backup.
+ */
+struct PostgreSqlBackupTable final
+{
+    std::string     name    {}; //!< The table, qualified and quoted where needed.
+    std::string     file    {}; //!< Its file, relative to the backup directory.
+    Types::uint     wave    {}; //!< Tables of a wave are restored after every table they reference.
+    std::uint64_t   rows    {}; //!< Rows copied.
+    std::uint64_t   bytes   {}; //!< Uncompressed size of the COPY data.
+};
+
+/**
+ * @brief A sequence of a backup.
+ */
+struct PostgreSqlBackupSequence final
+{
+    std::string     name    {}; //!< The sequence, qualified and quoted.
+    std::int64_t    value   {}; //!< Its last value.
+};
+
+/**
+ * @brief Describes the files of a backup.
+ *
+ * The manifest is a tab-separated text file written after every table file is complete, so a directory
+ * without one holds no usable backup. Names are escaped so a tab or a newline in a quoted identifier
+ * cannot break a line.
+ */
+struct PostgreSqlBackupManifest final
+{
+    Abstracts::ResultFormat                 format      { Abstracts::ResultFormat::Text };  //!< COPY format of the table files.
+    std::chrono::system_clock::time_point   createdAt   {};                                 //!< When the snapshot was taken.
+    std::vector<PostgreSqlBackupTable>      tables      {};                                 //!< The tables.
+    std::vector<PostgreSqlBackupSequence>   sequences   {};                                 //!< Sequences that have been used.
+
+    /**
+     * @brief Writes the manifest into a backup directory, replacing the old one at once.
+     *
+     * @throws std::runtime_error If the file cannot be written.
+     */
+    void write(const std::filesystem::path& directory) const;
+
+    /**
+     * @brief Reads the manifest of a backup directory.
+     *
+     * @throws std::runtime_error If the directory has no manifest or it is malformed.
+     */
+    static PostgreSqlBackupManifest read(const std::filesystem::path& directory);
+};
+
+CELL_NAMESPACE_END
+
+#endif
+
+#endif // CELL_PSQL_BACKUP_HPP
@@ -37,74 +37,90 @@ PostgreSqlConnectionPool::PostgreSqlConnectionPool(const std::string& host,
 
 PostgreSqlConnectionPool::~PostgreSqlConnectionPool()
 {
-    for (auto& connection : m_poolData.connections)
-    {
-        if (std::holds_alternative<PostgreSqlPtr>(connection))
-        {
-            PostgreSqlPtr& postgresConnection = std::get<PostgreSqlPtr>(connection);
-            if (postgresConnection)
-            {
-                PQfinish(postgresConnection);
-                postgresConnection = nullptr;
-            }
-        }
-        // Handle other connection types if necessary
-    }
+    shutdown();
 }
 
-void PostgreSqlConnectionPool::initialize()
+SqlConnection PostgreSqlConnectionPool::openConnection()
 {
     std::string connectionString = "host=" + m_poolData.host.value() + " port=" + std::to_string(m_poolData.port) + " dbname=" + m_poolData.database.value() + " user=" + m_poolData.user.value() + " password=" + m_poolData.password.value();
-    for (int i = 0; i < m_poolData.poolSize; ++i) {
-        PostgreSqlPtr connection = PQconnectdb(connectionString.c_str());
-        if (PQstatus(connection) == CONNECTION_OK) {
-            // Configure SSL/TLS if necessary
-            if (m_poolData.keyPath.has_value() && m_poolData.certPath.has_value() && m_poolData.caPath.has_value()) {
-                std::string sslModeParam = "sslmode=require sslcert=" + m_poolData.certPath.value() +
-                                           " sslkey=" + m_poolData.keyPath.value() +
-                                           " sslrootcert=" + m_poolData.caPath.value();
-                PQclear(PQexec(connection, sslModeParam.c_str()));
-            }
-
-            std::lock_guard<std::mutex> lock(m_poolData.mutex);
-            m_poolData.connections.push_back(connection);
-        } else {
-            // Failed to create or connect to a PostgreSQL connection
-            // Handle the error or log the failure
-            throw Exception(Exception::Reason::Database, "Failed to create or connect to a PostgreSQL connection.").getRuntimeError();
-            PQfinish(connection);
-        }
+
+    // Configure SSL/TLS if necessary
+    if (m_poolData.keyPath.has_value() && m_poolData.certPath.has_value() && m_poolData.caPath.has_value()) {
+        connectionString += " sslmode=require sslcert=" + m_poolData.certPath.value() +
+                            " sslkey=" + m_poolData.keyPath.value() +
+                            " sslrootcert=" + m_poolData.caPath.value();
+    }
+
+    PostgreSqlPtr connection = PQconnectdb(connectionString.c_str());
+    if (PQstatus(connection) != CONNECTION_OK) {
+        const std::string message = PQerrorMessage(connection);
+        PQfinish(connection);
+        throw Exception(Exception::Reason::Database, "Failed to create or connect to a PostgreSQL connection: " + message).getRuntimeError();
     }
+    return connection;
 }
 
-bool PostgreSqlConnectionPool::isInitialized() const
+bool PostgreSqlConnectionPool::pingConnection(const SqlConnection& connection)
 {
-    return !m_poolData.connections.empty();
+    PostgreSqlPtr postgresConnection = std::get<PostgreSqlPtr>(connection);
+    if (PQstatus(postgresConnection) != CONNECTION_OK) {
+        return false;
+    }
+
+    // An empty query is the cheapest round trip the protocol offers
+    PGresult* result = PQexec(postgresConnection, "");
+    const bool alive = PQresultStatus(result) == PGRES_EMPTY_QUERY && PQtransactionStatus(postgresConnection) == PQTRANS_IDLE;
+    PQclear(result);
+    return alive;
 }
 
-SqlConnection PostgreSqlConnectionPool::getConnection()
+std::optional<std::chrono::milliseconds> PostgreSqlConnectionPool::replicationLag(const SqlConnection& connection)
 {
-    // Wait until a connection becomes available
-    std::unique_lock<std::mutex> lock(m_poolData.mutex);
-    while (m_poolData.connections.empty()) {
-        m_poolData.condition.wait(lock);
+    // An idle primary stops advancing the replay timestamp, so a caught-up streaming standby counts as current
+    static constexpr const char* sql =
+        "SELECT CASE WHEN NOT pg_is_in_recovery() THEN 0"
+        " WHEN pg_last_wal_receive_lsn() = pg_last_wal_replay_lsn()"
+        " AND EXISTS (SELECT 1 FROM pg_stat_wal_receiver WHERE status = 'streaming') THEN 0"
+        " ELSE (EXTRACT(EPOCH FROM now() - pg_last_xact_replay_timestamp()) * 1000)::bigint END";
+
+    PostgreSqlPtr postgresConnection = std::get<PostgreSqlPtr>(connection);
+    std::unique_ptr<PGresult, decltype(&PQclear)> result(PQexec(postgresConnection, sql), &PQclear);
+    if (PQresultStatus(result.get()) != PGRES_TUPLES_OK || PQntuples(result.get()) != 1) {
+        throw Exception(Exception::Reason::Database, PQresultErrorMessage(result.get())).getRuntimeError();
+    }
+    if (PQgetisnull(result.get(), 0, 0)) {
+        return std::nullopt;
     }
+    const std::string_view value = PQgetvalue(result.get(), 0, 0);
+    std::int64_t milliseconds {};
+    std::from_chars(value.data(), value.data() + value.size(), milliseconds);
+    return std::chrono::milliseconds(std::max<std::int64_t>(milliseconds, 0));
+}
 
-    // Retrieve a connection from the pool
-    SqlConnection connection = m_poolData.connections.front();
-    m_poolData.connections.pop_front();
-    return connection;
+void PostgreSqlConnectionPool::closeConnection(const SqlConnection& connection)
+{
+    if (PostgreSqlPtr postgresConnection = std::get<PostgreSqlPtr>(connection)) {
+        // Prepared statements die with the session, no need to deallocate them one by one
+        m_statementCaches.remove(postgresConnection, false);
+        PQfinish(postgresConnection);
+    }
 }
 
-void PostgreSqlConnectionPool::releaseConnection(SqlConnection connection)
+Abstracts::StatementCache<std::string>& PostgreSqlConnectionPool::statementCache(PostgreSqlPtr connection)
 {
-    std::lock_guard<std::mutex> lock(m_poolData.mutex);
+    return m_statementCaches.cacheFor(connection, [connection](std::string& name) {
+        PQclear(PQexec(connection, ("DEALLOCATE " + name).c_str()));
+    });
+}
 
-    // Add the connection back to the pool
-    m_poolData.connections.push_back(connection);
+void PostgreSqlConnectionPool::setStatementCacheCapacity(std::size_t capacity)
+{
+    m_statementCaches.setCapacity(capacity);
+}
 
-    // Notify a waiting thread about the availability of a connection
-    m_poolData.condition.notify_one();
+Abstracts::StatementCacheStatistics PostgreSqlConnectionPool::statementCacheStatistics() const
+{
+    return m_statementCaches.statistics();
 }
 
 void PostgreSqlConnectionPool::enableEncryption(const std::string& keyPath, const std::string& certPath, const std::string& caPath)
@@ -75,44 +75,63 @@ public:
     CELL_MAKE_FRIEND(PostgreSqlDatabaseConnection)
 
     /**
-     * @brief Initializes the connection pool.
+     * @brief Enables encryption for PostgreSql connections using the specified key, certificate, and CA paths.
      *
-     * This function initializes the PostgreSql connection pool by establishing initial connections.
+     * @param keyPath The path to the private key file for encryption.
+     * @param certPath The path to the certificate file for encryption.
+     * @param caPath The path to the CA certificate file for encryption.
      */
-    void initialize() __cell_override;
+    void enableEncryption(const std::string& keyPath, const std::string& certPath, const std::string& caPath) __cell_override;
 
     /**
-     * @brief Checks if the connection pool is initialized.
+     * @brief Returns the prepared statement cache of a pooled connection.
      *
-     * @return `true` if the connection pool is initialized, `false` otherwise.
+     * Only the current holder of the connection may use the returned cache.
+     *
+     * @param connection The connection the statements are prepared on.
      */
-    bool isInitialized() const __cell_override;
+    Abstracts::StatementCache<std::string>& statementCache(Types::PostgreSqlPtr connection);
 
     /**
-     * @brief Retrieves a PostgreSql connection from the pool.
+     * @brief Sets how many prepared statements each connection keeps.
      *
-     * @return A SqlConnection object representing a PostgreSql connection.
+     * @param capacity The maximum number of statements per connection.
      */
-    Types::SqlConnection getConnection() __cell_override;
+    void setStatementCacheCapacity(std::size_t capacity);
 
     /**
-     * @brief Releases a PostgreSql connection and returns it to the pool.
+     * @brief Returns the hit, miss, eviction and invalidation counters of the statement caches.
+     */
+    Abstracts::StatementCacheStatistics statementCacheStatistics() const;
+
+    /**
+     * @brief Measures the replay lag of a PostgreSql standby; a primary reports none.
      *
-     * @param connection The SqlConnection object representing the PostgreSql connection to release.
+     * A standby that has replayed everything it received while streaming is not behind; otherwise the
+     * lag is the age of the last replayed transaction.
      */
-    void releaseConnection(Types::SqlConnection connection) __cell_override;
+    std::optional<std::chrono::milliseconds> replicationLag(const Types::SqlConnection& connection) __cell_override;
 
+protected:
     /**
-     * @brief Enables encryption for PostgreSql connections using the specified key, certificate, and CA paths.
+     * @brief Opens a new PostgreSql connection using the pool settings.
      *
-     * @param keyPath The path to the private key file for encryption.
-     * @param certPath The path to the certificate file for encryption.
-     * @param caPath The path to the CA certificate file for encryption.
+     * @throws std::runtime_error If the connection cannot be established.
      */
-    void enableEncryption(const std::string& keyPath, const std::string& certPath, const std::string& caPath) __cell_override;
+    Types::SqlConnection openConnection() __cell_override;
+
+    /**
+     * @brief Checks a PostgreSql connection with a round trip to the server.
+     */
+    bool pingConnection(const Types::SqlConnection& connection) __cell_override;
+
+    /**
+     * @brief Closes a PostgreSql connection.
+     */
+    void closeConnection(const Types::SqlConnection& connection) __cell_override;
 
 private:
-    Abstracts::PoolData m_poolData{}; //!< The pool data used to manage PostgreSql connections.
+    Abstracts::StatementCacheRegistry<Types::PostgreSqlPtr, std::string> m_statementCaches {}; //!< Prepared statements per connection.
 };
 CELL_NAMESPACE_END
 
@@ -0,0 +1,429 @@
+#if __has_include("psqlcopy.hpp")
+#   include "psqlcopy.hpp"
+#else
+#   error "Cell's "psqlcopy.hpp" was not found!"
+#endif
+
+#if defined(USE_POSTGRESQL)
+
+#if __has_include("core/core.hpp")
+#   include "core/core.hpp"
+#else
+#   error "Cell's "core/core.hpp" was not found!"
+#endif
+
+CELL_USING_NAMESPACE Cell;
+CELL_USING_NAMESPACE Cell::System;
+CELL_USING_NAMESPACE Cell::Types;
+
+CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Database)
+
+namespace {
+
+//! Signature, flags and header extension length that open every binary COPY stream.
+constexpr std::string_view binaryHeader { "PGCOPY\n\377\r\n\0\0\0\0\0\0\0\0\0", 19 };
+
+//! Field count that ends a binary COPY stream.
+constexpr std::string_view binaryTrailer { "\377\377", 2 };
+
+using PostgreSqlResult = std::unique_ptr<PGresult, decltype(&PQclear)>;
+
+std::string copyFormatClause(Abstracts::ResultFormat format)
+{
+    return format == Abstracts::ResultFormat::Binary ? " WITH (FORMAT binary)" : "";
+}
+
+void startCopy(PostgreSqlPtr connection, const std::string& sql, ExecStatusType expected)
+{
+    PostgreSqlResult result(PQexec(connection, sql.c_str()), &PQclear);
+    if (PQresultStatus(result.get()) != expected) {
+        throw Exception(Exception::Reason::Database, PQresultErrorMessage(result.get())).getRuntimeError();
+    }
+}
+
+/**
+ * @brief Reads the results that follow the end of a COPY, returning the row count of the first one.
+ */
+std::uint64_t collectCopyResult(PostgreSqlPtr connection, std::string& error)
+{
+    std::uint64_t rows = 0;
+    bool first = true;
+    while (PGresult* next = PQgetResult(connection)) {
+        PostgreSqlResult result(next, &PQclear);
+        if (!first) {
+            continue;
+        }
+        first = false;
+        if (PQresultStatus(result.get()) != PGRES_COMMAND_OK) {
+            error = PQresultErrorMessage(result.get());
+            continue;
+        }
+        const std::string_view tuples = PQcmdTuples(result.get());
+        std::from_chars(tuples.data(), tuples.data() + tuples.size(), rows);
+    }
+    return rows;
+}
+
+/**
+ * @brief Appends a value in COPY text format: backslash escapes for the characters COPY treats specially.
+ */
+void appendEscaped(std::string& buffer, std::string_view value)
+{
+    for (const char character : value) {
+        switch (character) {
+        case '\\': buffer += "\\\\"; break;
+        case '\t': buffer += "\\t"; break;
+        case '\n': buffer += "\\n"; break;
+        case '\r': buffer += "\\r"; break;
+        case '\b': buffer += "\\b"; break;
+        case '\f': buffer += "\\f"; break;
+        case '\v': buffer += "\\v"; break;
+        default: buffer += character; break;
+        }
+    }
+}
+
+}  // namespace
+
+PostgreSqlCopyIn::PostgreSqlCopyIn(Abstracts::ConnectionLease lease,
+                                   PostgreSqlPtr connection,
+                                   const std::string& tableName,
+                                   const PostgreSqlCopyOptions& options)
+    : m_lease(std::move(lease))
+    , m_connection(connection)
+    , m_options(options)
+{
+    m_options.bufferSize = std::max<std::size_t>(m_options.bufferSize, 1);
+
+    std::string sql = "COPY " + tableName;
+    if (!m_options.columns.empty()) {
+        sql += " (";
+        for (std::size_t i = 0; i < m_options.columns.size(); ++i) {
+            sql += (i == 0 ? "" : ", ") + m_options.columns[i];
+        }
+        sql += ")";
+    }
+    sql += " FROM STDIN" + copyFormatClause(m_options.format);
+    startCopy(m_connection, sql, PGRES_COPY_IN);
+    m_open = true;
+
+    m_buffer.reserve(m_options.bufferSize + m_options.bufferSize / 8);
+    if (m_options.format == Abstracts::ResultFormat::Binary) {
+        m_buffer.append(binaryHeader);
+    }
+}
+
+PostgreSqlCopyIn::~PostgreSqlCopyIn()
+{
+    if (m_open) {
+        abort();
+    }
+}
+
+PostgreSqlCopyIn& PostgreSqlCopyIn::value(std::string_view value)
+{
+    beginField();
+    if (m_options.format == Abstracts::ResultFormat::Binary) {
+        appendBigEndian(static_cast<std::int32_t>(value.size()));
+        m_buffer.append(value);
+    } else {
+        appendEscaped(m_buffer, value);
+    }
+    return *this;
+}
+
+PostgreSqlCopyIn& PostgreSqlCopyIn::null()
+{
+    beginField();
+    if (m_options.format == Abstracts::ResultFormat::Binary) {
+        appendBigEndian(std::int32_t { -1 });
+    } else {
+        m_buffer += "\\N";
+    }
+    return *this;
+}
+
+PostgreSqlCopyIn& PostgreSqlCopyIn::integer(std::int64_t value)
+{
+    return appendInteger(value);
+}
+
+PostgreSqlCopyIn& PostgreSqlCopyIn::int16(std::int16_t value)
+{
+    return appendInteger(value);
+}
+
+PostgreSqlCopyIn& PostgreSqlCopyIn::int32(std::int32_t value)
+{
+    return appendInteger(value);
+}
+
+PostgreSqlCopyIn& PostgreSqlCopyIn::int64(std::int64_t value)
+{
+    return appendInteger(value);
+}
+
+template <typename T>
+PostgreSqlCopyIn& PostgreSqlCopyIn::appendInteger(T value)
+{
+    beginField();
+    if (m_options.format == Abstracts::ResultFormat::Binary) {
+        // The server rejects a field whose length differs from the column type's
+        appendBigEndian(static_cast<std::int32_t>(sizeof(T)));
+        appendBigEndian(value);
+    } else {
+        char digits[24];
+        const auto [end, error] = std::to_chars(std::begin(digits), std::end(digits), value);
+        m_buffer.append(digits, end);
+    }
+    return *this;
+}
+
+PostgreSqlCopyIn& PostgreSqlCopyIn::real(double value)
+{
+    beginField();
+    if (m_options.format == Abstracts::ResultFormat::Binary) {
+        std::uint64_t bits {};
+        std::memcpy(&bits, &value, sizeof(bits));
+        appendBigEndian(std::int32_t { 8 });
+        appendBigEndian(bits);
+    } else {
+        // 17 significant digits read back as the same double
+        char digits[32];
+        const int length = std::snprintf(digits, sizeof(digits), "%.17g", value);
+        m_buffer.append(digits, static_cast<std::size_t>(length));
+    }
+    return *this;
+}
+
+PostgreSqlCopyIn& PostgreSqlCopyIn::boolean(bool value)
+{
+    beginField();
+    if (m_options.format == Abstracts::ResultFormat::Binary) {
+        appendBigEndian(std::int32_t { 1 });
+        m_buffer += value ? '\1' : '\0';
+    } else {
+        m_buffer += value ? 't' : 'f';
+    }
+    return *this;
+}
+
+void PostgreSqlCopyIn::endRow()
+{
+    if (!m_open) {
+        throw std::logic_error("The COPY is not in progress.");
+    }
+    if (m_options.format == Abstracts::ResultFormat::Binary) {
+        if (!m_inRow) {
+            // A row without fields still carries its field count
+            appendBigEndian(std::int16_t { 0 });
+        } else {
+            const std::uint16_t count = m_fields;
+            m_buffer[m_rowStart] = static_cast<char>(count >> 8);
+            m_buffer[m_rowStart + 1] = static_cast<char>(count & 0xFF);
+        }
+    } else {
+        m_buffer += '\n';
+    }
+    m_inRow = false;
+    m_fields = 0;
+
+    // Only whole rows are sent, so the field count above can always be patched in place
+    if (m_buffer.size() >= m_options.bufferSize) {
+        flush();
+    }
+}
+
+void PostgreSqlCopyIn::writeRow(const std::vector<std::string>& row)
+{
+    for (const auto& column : row) {
+        value(column);
+    }
+    endRow();
+}
+
+void PostgreSqlCopyIn::writeRaw(std::string_view data)
+{
+    if (!m_open) {
+        throw std::logic_error("The COPY is not in progress.");
+    }
+    if (m_inRow) {
+        throw std::logic_error("Raw COPY data cannot be written in the middle of a row.");
+    }
+    // The caller's data carries its own header
+    if (m_options.format == Abstracts::ResultFormat::Binary && !m_raw && m_buffer == binaryHeader) {
+        m_buffer.clear();
+    }
+    m_raw = true;
+    m_buffer.append(data);
+    if (m_buffer.size() >= m_options.bufferSize) {
+        flush();
+    }
+}
+
+std::uint64_t PostgreSqlCopyIn::finish()
+{
+    if (!m_open) {
+        throw std::logic_error("The COPY is not in progress.");
+    }
+    if (m_inRow) {
+        endRow();
+    }
+    if (m_options.format == Abstracts::ResultFormat::Binary && !m_raw) {
+        m_buffer.append(binaryTrailer);
+    }
+    flush();
+
+    if (PQputCopyEnd(m_connection, __cell_nullptr) != 1) {
+        const std::string message = PQerrorMessage(m_connection);
+        m_open = false;
+        m_lease.discard();
+        throw Exception(Exception::Reason::Database, message).getRuntimeError();
+    }
+    return complete();
+}
+
+void PostgreSqlCopyIn::abort(const std::string& reason)
+{
+    if (!m_open) {
+        return;
+    }
+    m_buffer.clear();
+    if (PQputCopyEnd(m_connection, reason.c_str()) != 1) {
+        m_open = false;
+        m_lease.discard();
+        return;
+    }
+    try {
+        complete();
+    } catch (const std::exception&) {
+        // The server reports the abort as an error, which is what was asked for
+    }
+}
+
+bool PostgreSqlCopyIn::isOpen() const
+{
+    return m_open;
+}
+
+void PostgreSqlCopyIn::beginField()
+{
+    if (!m_open) {
+        throw std::logic_error("The COPY is not in progress.");
+    }
+    if (!m_inRow) {
+        m_inRow = true;
+        m_rowStart = m_buffer.size();
+        if (m_options.format == Abstracts::ResultFormat::Binary) {
+            // Placeholder for the field count, patched by endRow()
+            appendBigEndian(std::int16_t { 0 });
+        }
+    } else if (m_options.format == Abstracts::ResultFormat::Text) {
+        m_buffer += '\t';
+    }
+    ++m_fields;
+}
+
+template <typename T>
+void PostgreSqlCopyIn::appendBigEndian(T value)
+{
+    const auto bits = static_cast<std::make_unsigned_t<T>>(value);
+    for (int shift = static_cast<int>(sizeof(T) - 1) * 8; shift >= 0; shift -= 8) {
+        m_buffer += static_cast<char>((bits >> shift) & 0xFF);
+    }
+}
+
+void PostgreSqlCopyIn::flush()
+{
+    if (m_buffer.empty()) {
+        return;
+    }
+    if (PQputCopyData(m_connection, m_buffer.data(), static_cast<int>(m_buffer.size())) != 1) {
+        const std::string message = PQerrorMessage(m_connection);
+        abort(message);
+        throw Exception(Exception::Reason::Database, message).getRuntimeError();
+    }
+    m_buffer.clear();
+}
+
+std::uint64_t PostgreSqlCopyIn::complete()
+{
+    m_open = false;
+    std::string error;
+    const std::uint64_t rows = collectCopyResult(m_connection, error);
+    m_lease.release();
+    if (!error.empty()) {
+        throw Exception(Exception::Reason::Database, error).getRuntimeError();
+    }
+    return rows;
+}
+
+PostgreSqlCopyOut::PostgreSqlCopyOut(Abstracts::ConnectionLease lease,
+                                     PostgreSqlPtr connection,
+                                     const std::string& source,
+                                     Abstracts::ResultFormat format)
+    : m_lease(std::move(lease))
+    , m_connection(connection)
+{
+    startCopy(m_connection, "COPY " + source + " TO STDOUT" + copyFormatClause(format), PGRES_COPY_OUT);
+    m_open = true;
+}
+
+PostgreSqlCopyOut::~PostgreSqlCopyOut()
+{
+    // The connection cannot run anything else until the COPY has been read to the end
+    try {
+        while (next()) {
+        }
+    } catch (const std::exception&) {
+    }
+}
+
+std::optional<std::string_view> PostgreSqlCopyOut::next()
+{
+    m_chunk.reset();
+    if (!m_open) {
+        return std::nullopt;
+    }
+
+    char* data = __cell_nullptr;
+    const int length = PQgetCopyData(m_connection, &data, 0);
+    if (length > 0) {
+        m_chunk.reset(data);
+        return std::string_view(data, static_cast<std::size_t>(length));
+    }
+    if (length == -1) {
+        complete();
+        return std::nullopt;
+    }
+
+    const std::string message = PQerrorMessage(m_connection);
+    m_open = false;
+    m_lease.discard();
+    throw Exception(Exception::Reason::Database, message).getRuntimeError();
+}
+
+std::uint64_t PostgreSqlCopyOut::rows() const
+{
+    return m_rows;
+}
+
+bool PostgreSqlCopyOut::isOpen() const
+{
+    return m_open;
+}
+
+void PostgreSqlCopyOut::complete()
+{
+    m_open = false;
+    std::string error;
+    m_rows = collectCopyResult(m_connection, error);
+    m_lease.release();
+    if (!error.empty()) {
+        throw Exception(Exception::Reason::Database, error).getRuntimeError();
+    }
+}
+
+CELL_NAMESPACE_END
+
+#endif
@@ -0,0 +1,304 @@
+/*!
+ * @file        psqlcopy.hpp
+ * @brief       Database PostgreSql COPY streaming for the Cell Engine.
+ * @details     This file defines PostgreSqlCopyIn and PostgreSqlCopyOut, which stream rows through COPY FROM STDIN and COPY TO STDOUT.
+ * @author      Kambiz Asadzadeh
+ * @since       07 Jun 2023
+ * @version     1.0
+ * @note        This is part of the Cell Engine, developed by Kambiz Asadzadeh.
+ *
+ * @license     This file is licensed under the terms of the Genyleap License. See the LICENSE.md file for more information.
+ * @copyright   Copyright (c) 2025 The Genyleap | Kambiz Asadzadeh. All rights reserved.
+ * @see         https://github.com/genyleap/cell
+ */
+
+#ifndef CELL_PSQL_COPY_HPP
+#define CELL_PSQL_COPY_HPP
+
+#if defined(USE_POSTGRESQL)
+
+#if __has_include("common.hpp")
+#   include "common.hpp"
+#else
+#   error "Cell's "common.hpp" was not found!"
+#endif
+
+#if __has_include("abstract-includer.hpp")
+#   include "abstract-includer.hpp"
+#else
+#   error "Cell's "abstract-includer.hpp" was not found!"
+#endif
+
+CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Database)
+
+/**
+ * @brief Constants related to PostgreSql COPY streaming.
+ */
+struct POSTGRESQL_COPY_CONSTANTS final
+{
+    __cell_static_const_constexpr std::size_t DEFAULT_BUFFER_SIZE = 256 * 1024; //!< Bytes collected before they are handed to libpq.
+};
+
+/**
+ * @brief Options for a COPY operation.
+ */
+struct PostgreSqlCopyOptions final
+{
+    Abstracts::ResultFormat     format      { Abstracts::ResultFormat::Text };                  //!< COPY text or binary format.
+    std::vector<std::string>    columns     {};                                                 //!< Target columns; empty for all of them.
+    std::size_t                 bufferSize  { POSTGRESQL_COPY_CONSTANTS::DEFAULT_BUFFER_SIZE }; //!< Batch size in bytes.
+};
+
+/**
+ * @brief Streams rows into a table with COPY ... FROM STDIN.
+ *
+ * Rows are encoded into a local buffer that is handed to the server with PQputCopyData whenever it
+ * reaches PostgreSqlCopyOptions::bufferSize, so the whole load is one statement and memory stays
+ * bounded by the buffer. Values are written field by field and each row is closed with endRow().
+ *
+ * In text format value() escapes its argument; in binary format it is written as is, so it must
+ * already be the server's binary representation of the column type. The integer writers, real() and
+ * boolean() encode for either format; in binary format the writer must match the column width (int16()
+ * for smallint, int32() for integer, int64() or integer() for bigint, real() for double precision).
+ *
+ * Nothing is visible to other sessions until finish() succeeds; a writer destroyed before that
+ * aborts the COPY.
+ *
+ * @note This class is marked with the "__cell_export" attribute, indicating
+ *       it is part of the "cell" module for exporting purposes.
+ */
+class __cell_export PostgreSqlCopyIn final
+{
+public:
+    /**
+     * @brief Starts the COPY on the server.
+     *
+     * @param lease The lease of the connection, or an empty lease when the connection is pinned by a transaction.
+     * @param connection The connection to copy on.
+     * @param tableName The target table.
+     * @param options The format, target columns and batch size.
+     * @throws std::runtime_error If the server refuses the COPY.
+     */
+    PostgreSqlCopyIn(Abstracts::ConnectionLease lease,
+                     Types::PostgreSqlPtr connection,
+                     const std::string& tableName,
+                     const PostgreSqlCopyOptions& options);
+
+    /**
+     * @brief Aborts the COPY if it was not finished.
+     */
+    ~PostgreSqlCopyIn();
+
+    /**
+     * @brief Disable copy construction and assignment for a class.
+     */
+    CELL_DISABLE_COPY(PostgreSqlCopyIn)
+
+    /**
+     * @brief Appends a value to the current row.
+     */
+    PostgreSqlCopyIn& value(std::string_view value);
+
+    /**
+     * @brief Appends a NULL to the current row.
+     */
+    PostgreSqlCopyIn& null();
+
+    /**
+     * @brief Appends an integer to the current row; an int8 column in binary format.
+     */
+    PostgreSqlCopyIn& integer(std::int64_t value);
+
+    /**
+     * @brief Appends an integer to the current row; an int2 (smallint) column in binary format.
+     */
+    PostgreSqlCopyIn& int16(std::int16_t value);
+
+    /**
+     * @brief Appends an integer to the current row; an int4 (integer) column in binary format.
+     */
+    PostgreSqlCopyIn& int32(std::int32_t value);
+
+    /**
+     * @brief Appends an integer to the current row; an int8 (bigint) column in binary format.
+     */
+    PostgreSqlCopyIn& int64(std::int64_t value);
+
+    /**
+     * @brief Appends a floating point number to the current row; a float8 column in binary format.
+     */
+    PostgreSqlCopyIn& real(double value);
+
+    /**
+     * @brief Appends a boolean to the current row.
+     */
+    PostgreSqlCopyIn& boolean(bool value);
+
+    /**
+     * @brief Closes the current row, sending the buffer once it is full.
+     *
+     * @throws std::runtime_error If the data cannot be sent; the COPY is aborted.
+     */
+    void endRow();
+
+    /**
+     * @brief Appends a row of values.
+     *
+     * @throws std::runtime_error If the data cannot be sent; the COPY is aborted.
+     */
+    void writeRow(const std::vector<std::string>& row);
+
+    /**
+     * @brief Sends data that is already in the COPY format, e.g. a chunk of a file written by COPY TO.
+     *
+     * @throws std::logic_error If a row is still open.
+     * @throws std::runtime_error If the data cannot be sent; the COPY is aborted.
+     */
+    void writeRaw(std::string_view data);
+
+    /**
+     * @brief Sends the rest of the data and ends the COPY.
+     *
+     * @return The number of rows the server stored.
+     * @throws std::runtime_error If the server rejects the data; nothing is stored.
+     */
+    std::uint64_t finish();
+
+    /**
+     * @brief Ends the COPY without storing anything.
+     *
+     * @param reason The message the server reports for the failed statement.
+     */
+    void abort(const std::string& reason = "aborted by the client");
+
+    /**
+     * @brief Checks whether data may still be written.
+     */
+    bool isOpen() const;
+
+private:
+    /**
+     * @brief Starts a field, writing the separator or the field count placeholder.
+     */
+    void beginField();
+
+    /**
+     * @brief Appends an integer in network byte order.
+     */
+    template <typename T>
+    void appendBigEndian(T value);
+
+    /**
+     * @brief Appends an integer field, as many bytes wide as T in binary format.
+     */
+    template <typename T>
+    PostgreSqlCopyIn& appendInteger(T value);
+
+    /**
+     * @brief Hands the buffer to libpq.
+     */
+    void flush();
+
+    /**
+     * @brief Collects the results of the ended COPY and returns the connection.
+     */
+    std::uint64_t complete();
+
+    Abstracts::ConnectionLease      m_lease         {};         //!< Owned connection, if not pinned.
+    Types::PostgreSqlPtr            m_connection    {};         //!< The connection the COPY runs on.
+    PostgreSqlCopyOptions           m_options       {};         //!< Format, columns and batch size.
+    std::string                     m_buffer        {};         //!< Encoded rows not sent yet.
+    std::size_t                     m_rowStart      {};         //!< Offset of the current row in m_buffer.
+    Types::u16                      m_fields        {};         //!< Fields written to the current row.
+    bool                            m_inRow         { false };  //!< Whether a row is open.
+    bool                            m_raw           { false };  //!< Whether writeRaw() supplied the header and trailer.
+    bool                            m_open          { false };  //!< Whether the COPY is in progress.
+};
+
+/**
+ * @brief Streams a table or a query out of the server with COPY ... TO STDOUT.
+ *
+ * next() returns one chunk at a time straight from libpq's buffer (one row per chunk), so memory stays
+ * constant whatever the size of the table. Chunks are in the COPY format requested and can be written
+ * to a file and loaded back with PostgreSqlCopyIn::writeRaw().
+ *
+ * @note This class is marked with the "__cell_export" attribute, indicating
+ *       it is part of the "cell" module for exporting purposes.
+ */
+class __cell_export PostgreSqlCopyOut final
+{
+public:
+    /**
+     * @brief Starts the COPY on the server.
+     *
+     * @param lease The lease of the connection, or an empty lease when the connection is pinned by a transaction.
+     * @param connection The connection to copy on.
+     * @param source A table, optionally followed by a column list, or a query in parentheses.
+     * @param format COPY text or binary format.
+     * @throws std::runtime_error If the server refuses the COPY.
+     */
+    PostgreSqlCopyOut(Abstracts::ConnectionLease lease,
+                      Types::PostgreSqlPtr connection,
+                      const std::string& source,
+                      Abstracts::ResultFormat format);
+
+    /**
+     * @brief Drains the COPY if it was not read to the end.
+     */
+    ~PostgreSqlCopyOut();
+
+    /**
+     * @brief Disable copy construction and assignment for a class.
+     */
+    CELL_DISABLE_COPY(PostgreSqlCopyOut)
+
+    /**
+     * @brief Reads the next chunk; the previous one is invalidated.
+     *
+     * @return The chunk, or std::nullopt once the COPY is complete.
+     * @throws std::runtime_error If the COPY fails.
+     */
+    std::optional<std::string_view> next();
+
+    /**
+     * @brief Reads the rest of the COPY, giving every chunk to a sink.
+     *
+     * @return The number of rows the server sent.
+     */
+    template <typename Sink>
+    std::uint64_t forEach(Sink&& sink)
+    {
+        while (const auto chunk = next()) {
+            sink(*chunk);
+        }
+        return m_rows;
+    }
+
+    /**
+     * @brief Returns the number of rows sent, once the COPY is complete.
+     */
+    std::uint64_t rows() const;
+
+    /**
+     * @brief Checks whether chunks may still be read.
+     */
+    bool isOpen() const;
+
+private:
+    /**
+     * @brief Collects the result of the COPY and returns the connection.
+     */
+    void complete();
+
+    Abstracts::ConnectionLease                  m_lease         {};                     //!< Owned connection, if not pinned.
+    Types::PostgreSqlPtr                        m_connection    {};                     //!< The connection the COPY runs on.
+    std::unique_ptr<char, decltype(&PQfreemem)> m_chunk         { nullptr, &PQfreemem };//!< The chunk handed out last.
+    std::uint64_t                               m_rows          {};                     //!< Rows reported by the server.
+    bool                                        m_open          { false };              //!< Whether the COPY is in progress.
+};
+
+CELL_NAMESPACE_END
+
+#endif
+
+#endif // CELL_PSQL_COPY_HPP
@@ -0,0 +1,140 @@
+#if __has_include("psqlcursor.hpp")
+#   include "psqlcursor.hpp"
+#else
+#   error "Cell's "psqlcursor.hpp" was not found!"
+#endif
+
+#if defined(USE_POSTGRESQL)
+
+#if __has_include("core/core.hpp")
+#   include "core/core.hpp"
+#else
+#   error "Cell's "core/core.hpp" was not found!"
+#endif
+
+CELL_USING_NAMESPACE Cell;
+CELL_USING_NAMESPACE Cell::System;
+CELL_USING_NAMESPACE Cell::Types;
+
+CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Database)
+
+namespace {
+
+std::atomic<std::uint64_t> cursorSequence {};
+
+}  // namespace
+
+PostgreSqlCursor::PostgreSqlCursor(Abstracts::ConnectionLease lease,
+                                   PostgreSqlPtr connection,
+                                   const std::string& sql,
+                                   const std::vector<std::string>& params,
+                                   const Abstracts::CursorOptions& options)
+    : m_lease(std::move(lease))
+    , m_connection(connection)
+    , m_options(options)
+    , m_name("cell_cursor_" + std::to_string(cursorSequence.fetch_add(1, std::memory_order_relaxed) + 1))
+    , m_ownTransaction(PQtransactionStatus(connection) == PQTRANS_IDLE)
+{
+    m_options.batchSize = std::max<std::size_t>(m_options.batchSize, 1);
+    m_fetch = "FETCH FORWARD " + std::to_string(m_options.batchSize) + " FROM " + m_name;
+
+    // A cursor only lives as long as its transaction
+    if (m_ownTransaction) {
+        run("BEGIN");
+    }
+
+    std::vector<const char*> values;
+    values.reserve(params.size());
+    for (const auto& param : params) {
+        values.push_back(param.c_str());
+    }
+
+    const std::string declare = "DECLARE " + m_name + " NO SCROLL CURSOR FOR " + sql;
+    std::unique_ptr<PGresult, decltype(&PQclear)> result(
+        PQexecParams(m_connection, declare.c_str(), static_cast<int>(params.size()), __cell_nullptr, values.data(), __cell_nullptr, __cell_nullptr, 0),
+        &PQclear);
+    if (PQresultStatus(result.get()) != PGRES_COMMAND_OK) {
+        const std::string message = PQresultErrorMessage(result.get());
+        if (m_ownTransaction) {
+            PQclear(PQexec(m_connection, "ROLLBACK"));
+        }
+        throw Exception(Exception::Reason::Database, message).getRuntimeError();
+    }
+    m_open = true;
+}
+
+PostgreSqlCursor::~PostgreSqlCursor()
+{
+    close();
+}
+
+const Abstracts::ResultSet* PostgreSqlCursor::fetch()
+{
+    // Release the previous batch before the next one arrives
+    m_batch.reset();
+    if (!m_open) {
+        return __cell_nullptr;
+    }
+    if (m_exhausted) {
+        close();
+        return __cell_nullptr;
+    }
+
+    PGresult* result = PQexecParams(m_connection, m_fetch.c_str(), 0, __cell_nullptr, __cell_nullptr, __cell_nullptr, __cell_nullptr,
+                                    static_cast<int>(m_options.format));
+    if (PQresultStatus(result) != PGRES_TUPLES_OK) {
+        const std::string message = PQresultErrorMessage(result);
+        PQclear(result);
+        close();
+        throw Exception(Exception::Reason::Database, message).getRuntimeError();
+    }
+
+    const auto rows = static_cast<std::size_t>(PQntuples(result));
+    if (rows == 0) {
+        PQclear(result);
+        close();
+        return __cell_nullptr;
+    }
+
+    // A short batch is the last one; the next call closes without another round trip
+    m_exhausted = rows < m_options.batchSize;
+    m_batch = std::make_unique<PostgreSqlResultSet>(result, m_options.format);
+    return m_batch.get();
+}
+
+void PostgreSqlCursor::close()
+{
+    if (!m_open) {
+        return;
+    }
+    m_open = false;
+    m_batch.reset();
+
+    try {
+        // Committing our own transaction drops the cursor with it
+        run(m_ownTransaction ? "COMMIT" : "CLOSE " + m_name);
+    } catch (const std::exception&) {
+        if (m_ownTransaction) {
+            // The session is in an unknown state; do not hand it to the next borrower
+            m_lease.discard();
+        }
+    }
+    m_lease.release();
+}
+
+bool PostgreSqlCursor::isOpen() const
+{
+    return m_open;
+}
+
+void PostgreSqlCursor::run(const std::string& sql)
+{
+    std::unique_ptr<PGresult, decltype(&PQclear)> result(PQexec(m_connection, sql.c_str()), &PQclear);
+    if (PQresultStatus(result.get()) != PGRES_COMMAND_OK) {
+        throw Exception(Exception::Reason::Database, PQresultErrorMessage(result.get())).getRuntimeError();
+    }
+}
+
+CELL_NAMESPACE_END
+
+#endif
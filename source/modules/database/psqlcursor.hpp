@@ -0,0 +1,99 @@
+/*!
+ * @file        psqlcursor.hpp
+ * @brief       Database PostgreSql cursor for the Cell Engine.
+ * @details     This file defines PostgreSqlCursor, which streams a query through a server-side cursor.
+ * @author      Kambiz Asadzadeh
+ * @since       07 Jun 2023
+ * @version     1.0
+ * @note        This is part of the Cell Engine, developed by Kambiz Asadzadeh.
+ *
+ * @license     This file is licensed under the terms of the Genyleap License. See the LICENSE.md file for more information.
+ * @copyright   Copyright (c) 2025 The Genyleap | Kambiz Asadzadeh. All rights reserved.
+ * @see         https://github.com/genyleap/cell
+ */
+
+#ifndef CELL_PSQL_CURSOR_HPP
+#define CELL_PSQL_CURSOR_HPP
+
+#if defined(USE_POSTGRESQL)
+
+#if __has_include("common.hpp")
+#   include "common.hpp"
+#else
+#   error "Cell's "common.hpp" was not found!"
+#endif
+
+#if __has_include("abstract-includer.hpp")
+#   include "abstract-includer.hpp"
+#else
+#   error "Cell's "abstract-includer.hpp" was not found!"
+#endif
+
+#if __has_include("psqlresultset.hpp")
+#   include "psqlresultset.hpp"
+#else
+#   error "Cell's "psqlresultset.hpp" was not found!"
+#endif
+
+CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Database)
+
+/**
+ * @brief Streams a PostgreSql query with DECLARE ... CURSOR and FETCH batches.
+ *
+ * Each fetch() is one FETCH FORWARD round trip returning at most CursorOptions::batchSize rows. Outside
+ * a transaction the cursor opens its own and commits it when closed; inside one it only closes the
+ * server-side cursor.
+ *
+ * @note This class is marked with the "__cell_export" attribute, indicating
+ *       it is part of the "cell" module for exporting purposes.
+ */
+class __cell_export PostgreSqlCursor final : public Abstracts::Cursor
+{
+public:
+    /**
+     * @brief Declares the cursor on the server.
+     *
+     * @param lease The lease of the connection, or an empty lease when the connection is pinned by a transaction.
+     * @param connection The connection to run the cursor on.
+     * @param sql The query to stream.
+     * @param params Values for $1, $2, ...
+     * @param options The batch size and result format.
+     * @throws std::runtime_error If the cursor cannot be declared.
+     */
+    PostgreSqlCursor(Abstracts::ConnectionLease lease,
+                     Types::PostgreSqlPtr connection,
+                     const std::string& sql,
+                     const std::vector<std::string>& params,
+                     const Abstracts::CursorOptions& options);
+
+    /**
+     * @brief Closes the cursor if it is still open.
+     */
+    ~PostgreSqlCursor();
+
+    const Abstracts::ResultSet* fetch() __cell_override;
+    void close() __cell_override;
+    bool isOpen() const __cell_override;
+
+private:
+    /**
+     * @brief Runs a statement that returns no rows, throwing on failure.
+     */
+    void run(const std::string& sql);
+
+    Abstracts::ConnectionLease              m_lease         {};         //!< Owned connection, if not pinned.
+    Types::PostgreSqlPtr                    m_connection    {};         //!< The connection the cursor lives on.
+    Abstracts::CursorOptions                m_options       {};         //!< Batch size and format.
+    std::string                             m_name          {};         //!< Server-side cursor name.
+    std::string                             m_fetch         {};         //!< The FETCH statement.
+    std::unique_ptr<PostgreSqlResultSet>    m_batch         {};         //!< The batch handed out last.
+    bool                                    m_ownTransaction{ false };  //!< Whether the cursor began the transaction.
+    bool                                    m_open          { false };  //!< Whether the cursor is declared.
+    bool                                    m_exhausted     { false };  //!< Whether the last batch was short.
+};
+
+CELL_NAMESPACE_END
+
+#endif
+
+#endif // CELL_PSQL_CURSOR_HPP
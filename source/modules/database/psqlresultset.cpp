@@ -0,0 +1,153 @@
+#if __has_include("psqlresultset.hpp")
+#   include "psqlresultset.hpp"
+#else
+#   error "Cell's "psqlresultset.hpp" was not found!"
+#endif
+
+#if defined(USE_POSTGRESQL)
+
+CELL_USING_NAMESPACE Cell;
+CELL_USING_NAMESPACE Cell::Types;
+
+CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Database)
+
+namespace {
+
+//! Type OIDs from pg_type.h, which libpq does not install.
+constexpr Oid BOOLOID   = 16;
+constexpr Oid INT8OID   = 20;
+constexpr Oid INT2OID   = 21;
+constexpr Oid INT4OID   = 23;
+constexpr Oid OIDOID    = 26;
+constexpr Oid FLOAT4OID = 700;
+constexpr Oid FLOAT8OID = 701;
+
+std::uint64_t readNetworkOrder(std::string_view bytes)
+{
+    std::uint64_t value = 0;
+    for (const char byte : bytes) {
+        value = (value << 8) | static_cast<unsigned char>(byte);
+    }
+    return value;
+}
+
+template <typename Float, typename Bits>
+Float floatFromBits(Bits bits)
+{
+    static_assert(sizeof(Float) == sizeof(Bits));
+    Float value {};
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+}  // namespace
+
+PostgreSqlResultSet::PostgreSqlResultSet(PGresult* result, Abstracts::ResultFormat format)
+    : m_result(result)
+    , m_format(format)
+    , m_rows(static_cast<std::size_t>(PQntuples(result)))
+    , m_columns(static_cast<std::size_t>(PQnfields(result)))
+{
+}
+
+PostgreSqlResultSet::~PostgreSqlResultSet()
+{
+    PQclear(m_result);
+}
+
+std::size_t PostgreSqlResultSet::rowCount() const
+{
+    return m_rows;
+}
+
+std::size_t PostgreSqlResultSet::columnCount() const
+{
+    return m_columns;
+}
+
+std::string_view PostgreSqlResultSet::columnName(std::size_t column) const
+{
+    return PQfname(m_result, static_cast<int>(column));
+}
+
+bool PostgreSqlResultSet::isNull(std::size_t row, std::size_t column) const
+{
+    return PQgetisnull(m_result, static_cast<int>(row), static_cast<int>(column)) == 1;
+}
+
+std::string_view PostgreSqlResultSet::value(std::size_t row, std::size_t column) const
+{
+    const int r = static_cast<int>(row);
+    const int c = static_cast<int>(column);
+    return std::string_view(PQgetvalue(m_result, r, c), static_cast<std::size_t>(PQgetlength(m_result, r, c)));
+}
+
+Abstracts::ResultFormat PostgreSqlResultSet::format() const
+{
+    return m_format;
+}
+
+std::optional<std::int64_t> PostgreSqlResultSet::integer(std::size_t row, std::size_t column) const
+{
+    if (m_format == Abstracts::ResultFormat::Text || isNull(row, column)) {
+        return ResultSet::integer(row, column);
+    }
+    const auto bytes = value(row, column);
+    switch (columnType(column)) {
+    case INT2OID:
+        return static_cast<std::int16_t>(readNetworkOrder(bytes));
+    case INT4OID:
+        return static_cast<std::int32_t>(readNetworkOrder(bytes));
+    case INT8OID:
+        return static_cast<std::int64_t>(readNetworkOrder(bytes));
+    case OIDOID:
+        return static_cast<std::uint32_t>(readNetworkOrder(bytes));
+    case BOOLOID:
+        return bytes.size() == 1 && bytes[0] != 0 ? 1 : 0;
+    default:
+        return ResultSet::integer(row, column);
+    }
+}
+
+std::optional<double> PostgreSqlResultSet::real(std::size_t row, std::size_t column) const
+{
+    if (m_format == Abstracts::ResultFormat::Text || isNull(row, column)) {
+        return ResultSet::real(row, column);
+    }
+    switch (columnType(column)) {
+    case FLOAT4OID:
+        return static_cast<double>(floatFromBits<float>(static_cast<std::uint32_t>(readNetworkOrder(value(row, column)))));
+    case FLOAT8OID:
+        return floatFromBits<double>(readNetworkOrder(value(row, column)));
+    case INT2OID:
+    case INT4OID:
+    case INT8OID:
+    case OIDOID:
+        return static_cast<double>(*integer(row, column));
+    default:
+        return ResultSet::real(row, column);
+    }
+}
+
+std::optional<bool> PostgreSqlResultSet::boolean(std::size_t row, std::size_t column) const
+{
+    if (m_format == Abstracts::ResultFormat::Binary && columnType(column) == BOOLOID && !isNull(row, column)) {
+        const auto bytes = value(row, column);
+        return bytes.size() == 1 && bytes[0] != 0;
+    }
+    return ResultSet::boolean(row, column);
+}
+
+Oid PostgreSqlResultSet::columnType(std::size_t column) const
+{
+    return PQftype(m_result, static_cast<int>(column));
+}
+
+const PGresult* PostgreSqlResultSet::native() const
+{
+    return m_result;
+}
+
+CELL_NAMESPACE_END
+
+#endif
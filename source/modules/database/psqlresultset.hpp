@@ -0,0 +1,90 @@
+/*!
+ * @file        psqlresultset.hpp
+ * @brief       Database PostgreSql result set for the Cell Engine.
+ * @details     This file defines PostgreSqlResultSet, a zero-copy view over a PGresult.
+ * @author      Kambiz Asadzadeh
+ * @since       07 Jun 2023
+ * @version     1.0
+ * @note        This is part of the Cell Engine, developed by Kambiz Asadzadeh.
+ *
+ * @license     This file is licensed under the terms of the Genyleap License. See the LICENSE.md file for more information.
+ * @copyright   Copyright (c) 2025 The Genyleap | Kambiz Asadzadeh. All rights reserved.
+ * @see         https://github.com/genyleap/cell
+ */
+
+#ifndef CELL_PSQL_RESULT_SET_HPP
+#define CELL_PSQL_RESULT_SET_HPP
+
+#if defined(USE_POSTGRESQL)
+
+#if __has_include("common.hpp")
+#   include "common.hpp"
+#else
+#   error "Cell's "common.hpp" was not found!"
+#endif
+
+#if __has_include("abstract-includer.hpp")
+#   include "abstract-includer.hpp"
+#else
+#   error "Cell's "abstract-includer.hpp" was not found!"
+#endif
+
+CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Database)
+
+/**
+ * @brief A PostgreSql query result that reads values straight out of the PGresult.
+ *
+ * With Abstracts::ResultFormat::Binary, bool, int2, int4, int8, oid, float4 and float8 columns are
+ * decoded from their network representation; other types are read as text.
+ *
+ * @note This class is marked with the "__cell_export" attribute, indicating
+ *       it is part of the "cell" module for exporting purposes.
+ */
+class __cell_export PostgreSqlResultSet final : public Abstracts::ResultSet
+{
+public:
+    /**
+     * @brief Takes ownership of a result.
+     *
+     * @param result A successful PGresult; it is cleared with the result set.
+     * @param format The format the values were requested in.
+     */
+    PostgreSqlResultSet(PGresult* result, Abstracts::ResultFormat format);
+
+    /**
+     * @brief Clears the PGresult.
+     */
+    ~PostgreSqlResultSet();
+
+    std::size_t rowCount() const __cell_override;
+    std::size_t columnCount() const __cell_override;
+    std::string_view columnName(std::size_t column) const __cell_override;
+    bool isNull(std::size_t row, std::size_t column) const __cell_override;
+    std::string_view value(std::size_t row, std::size_t column) const __cell_override;
+    Abstracts::ResultFormat format() const __cell_override;
+    std::optional<std::int64_t> integer(std::size_t row, std::size_t column) const __cell_override;
+    std::optional<double> real(std::size_t row, std::size_t column) const __cell_override;
+    std::optional<bool> boolean(std::size_t row, std::size_t column) const __cell_override;
+
+    /**
+     * @brief Returns the type OID of a column.
+     */
+    Oid columnType(std::size_t column) const;
+
+    /**
+     * @brief Returns the native result, still owned by the result set.
+     */
+    const PGresult* native() const;
+
+private:
+    PGresult*               m_result    {}; //!< The owned result.
+    Abstracts::ResultFormat m_format    {}; //!< The format the values were requested in.
+    std::size_t             m_rows      {}; //!< Cached PQntuples().
+    std::size_t             m_columns   {}; //!< Cached PQnfields().
+};
+
+CELL_NAMESPACE_END
+
+#endif
+
+#endif // CELL_PSQL_RESULT_SET_HPP
@@ -0,0 +1,1207 @@
+#if __has_include("sqlite.hpp")
+#   include "sqlite.hpp"
+#else
+#   error "Cell's "sqlite.hpp" was not found!"
+#endif
+
+#if defined(USE_SQLITE)
+
+#if __has_include("core/core.hpp")
+#   include "core/core.hpp"
+#else
+#   error "Cell's "core/core.hpp" was not found!"
+#endif
+
+CELL_USING_NAMESPACE Cell;
+CELL_USING_NAMESPACE Cell::System;
+CELL_USING_NAMESPACE Cell::Utility;
+CELL_USING_NAMESPACE Cell::Types;
+
+CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Database)
+
+namespace {
+
+void executeOnSqlite(const SqlConnection& connection, const std::string& sql)
+{
+    SqlitePtr sqliteConnection = std::get<SqlitePtr>(connection);
+    char* error = __cell_nullptr;
+    const int status = sqlite3_exec(sqliteConnection, sql.c_str(), __cell_nullptr, __cell_nullptr, &error);
+    if (status == SQLITE_OK) {
+        return;
+    }
+    const std::string message = error ? error : sqlite3_errmsg(sqliteConnection);
+    sqlite3_free(error);
+    throwSqliteError(status, message);
+}
+
+std::vector<std::string> beginOnSqlite(const Abstracts::TransactionOptions& options)
+{
+    // Every SQLite transaction is serializable; a writer takes the lock up front so it never fails on an upgrade
+    return { std::string(options.readOnly ? SQLITE_CONSTANTS::BEGIN : SQLITE_CONSTANTS::BEGIN_IMMEDIATE) };
+}
+
+const Abstracts::TransactionDialect sqliteDialect {
+    .execute = &executeOnSqlite,
+    .begin   = &beginOnSqlite
+};
+
+std::string sqlitePlaceholder(std::size_t)
+{
+    return "?";
+}
+
+std::string quoteSqliteIdentifier(std::string_view name)
+{
+    std::string quoted = "\"";
+    for (const char character : name) {
+        quoted += character == '"' ? "\"\"" : std::string(1, character);
+    }
+    return quoted + "\"";
+}
+
+const Abstracts::KeysetDialect sqliteKeyset {
+    .placeholder     = &sqlitePlaceholder,
+    .quoteIdentifier = &quoteSqliteIdentifier
+};
+
+/**
+ * @brief Reads the columns, indexes and foreign keys of every table in one statement.
+ *
+ * The rows are laid out as Abstracts::SchemaCatalog::parse() expects. Foreign keys have no names in SQLite and
+ * are named by their id, which getTableForeignKey() accepts too.
+ */
+const std::string sqliteSchemaCatalog =
+    "SELECT 'c', m.name, p.name, p.type, NULL, CASE WHEN p.\"notnull\" THEN 'f' ELSE 't' END, p.dflt_value, p.cid + 1, NULLIF(p.pk, 0)"
+    " FROM sqlite_master AS m JOIN pragma_table_info(m.name) AS p"
+    " WHERE m.type IN ('table', 'view') AND m.name NOT LIKE 'sqlite\\_%' ESCAPE '\\'"
+    " UNION ALL"
+    " SELECT 'i', m.name, l.name,"
+    " (SELECT group_concat(name, char(31)) FROM (SELECT name FROM pragma_index_info(l.name) ORDER BY seqno)),"
+    " CASE WHEN l.\"unique\" THEN 't' ELSE 'f' END, CASE WHEN l.origin = 'pk' THEN 't' ELSE 'f' END, NULL, NULL, NULL"
+    " FROM sqlite_master AS m JOIN pragma_index_list(m.name) AS l"
+    " WHERE m.type = 'table' AND m.name NOT LIKE 'sqlite\\_%' ESCAPE '\\'"
+    " UNION ALL"
+    " SELECT 'f', m.name, CAST(f.id AS TEXT), group_concat(f.\"from\", char(31)), f.\"table\", group_concat(f.\"to\", char(31)), NULL, NULL, NULL"
+    " FROM sqlite_master AS m JOIN pragma_foreign_key_list(m.name) AS f"
+    " WHERE m.type = 'table' GROUP BY m.name, f.id";
+
+/**
+ * @brief Resets a statement and clears its bindings when the scope ends.
+ *
+ * A statement left mid-step keeps its read snapshot, which stops the writer from checkpointing past it.
+ */
+struct StatementReset final
+{
+    sqlite3_stmt* statement;
+
+    ~StatementReset()
+    {
+        sqlite3_reset(statement);
+        sqlite3_clear_bindings(statement);
+    }
+};
+
+/**
+ * @brief Binds a statement taken from the connection's prepared statement cache.
+ *
+ * The statement is prepared once per connection; SQLite prepares it again by itself when the schema
+ * changes. The values are bound without a copy and must outlive the execution.
+ *
+ * @return The bound statement; it stays owned by the cache and must be reset after use.
+ * @throws std::runtime_error If preparing or binding fails, or the text holds more than one statement.
+ */
+sqlite3_stmt* prepareCached(SqliteConnectionPool& pool, SqlitePtr connection, const std::string& sql, const std::vector<std::string>& params)
+{
+    auto& cache = pool.statementCache(connection);
+    sqlite3_stmt** cached = cache.find(sql);
+    sqlite3_stmt* statement = cached ? *cached : __cell_nullptr;
+    if (!statement) {
+        const char* tail = __cell_nullptr;
+        // PERSISTENT keeps a long-lived statement out of the connection's small lookaside allocator
+        const int status = sqlite3_prepare_v3(connection, sql.c_str(), static_cast<int>(sql.size()), SQLITE_PREPARE_PERSISTENT, &statement, &tail);
+        if (status != SQLITE_OK) {
+            throwSqliteError(status, sqlite3_errmsg(connection));
+        }
+        if (!statement) {
+            throw Exception(Exception::Reason::Database, "The statement is empty.").getRuntimeError();
+        }
+        const std::string_view rest(tail, static_cast<std::size_t>(sql.c_str() + sql.size() - tail));
+        if (rest.find_first_not_of(" \t\r\n;") != std::string_view::npos) {
+            sqlite3_finalize(statement);
+            throw Exception(Exception::Reason::Database, "Only one statement can be prepared at a time.").getRuntimeError();
+        }
+        cache.insert(sql, statement);
+    }
+
+    if (sqlite3_bind_parameter_count(statement) != static_cast<int>(params.size())) {
+        throw Exception(Exception::Reason::Database, "Incorrect number of parameters for the prepared statement.").getRuntimeError();
+    }
+    for (std::size_t i = 0; i < params.size(); ++i) {
+        const int status = sqlite3_bind_text(statement, static_cast<int>(i + 1), params[i].data(), static_cast<int>(params[i].size()), SQLITE_STATIC);
+        if (status != SQLITE_OK) {
+            sqlite3_clear_bindings(statement);
+            throwSqliteError(status, sqlite3_errmsg(connection));
+        }
+    }
+    return statement;
+}
+
+/**
+ * @brief Runs a cached statement to completion, discarding any rows.
+ */
+void executeCached(SqliteConnectionPool& pool, SqlitePtr connection, const std::string& sql, const std::vector<std::string>& params)
+{
+    StatementReset reset { prepareCached(pool, connection, sql, params) };
+    int status;
+    while ((status = sqlite3_step(reset.statement)) == SQLITE_ROW) {
+    }
+    if (status != SQLITE_DONE) {
+        throwSqliteError(status, sqlite3_errmsg(connection));
+    }
+}
+
+/**
+ * @brief Rolls back a transaction opened by a batch; the batch has already failed.
+ */
+void rollbackQuietly(SqlitePtr connection)
+{
+    const std::string rollback(SQLITE_CONSTANTS::ROLLBACK);
+    sqlite3_exec(connection, rollback.c_str(), __cell_nullptr, __cell_nullptr, __cell_nullptr);
+}
+
+}  // namespace
+
+void* SqliteDatabaseConnection::get()
+{
+    auto connection = connectionPool.getConnection();
+    if (std::holds_alternative<SqlitePtr>(connection)) {
+        return static_cast<void*>(std::get<SqlitePtr>(connection));
+    } else {
+        throw Exception(Exception::Reason::Database, "Invalid connection type").getRuntimeError();
+    }
+}
+
+SqliteDatabaseConnection::SqliteDatabaseConnection(SqliteConnectionPool& connectionPool)
+    : connectionPool(connectionPool)
+{
+}
+
+SqliteDatabaseConnection::~SqliteDatabaseConnection()
+{
+    // Threads may have left a transaction open; it is rolled back before the pool connections go away
+    m_transactions.clear();
+    disconnect();
+}
+
+bool SqliteDatabaseConnection::connect()
+{
+    try {
+        connectionPool.initialize();
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return false;
+    }
+    m_sqliteData.connectedAt = std::chrono::steady_clock::now();
+    m_sqliteData.connected = true;
+    return true;
+}
+
+bool SqliteDatabaseConnection::disconnect()
+{
+    // The pool may serve other connections, so only the calling thread's transaction ends here
+    if (m_transactions.current()) {
+        rollbackTransaction();
+    }
+    m_sqliteData.connected = false;
+    return true;
+}
+
+std::future<bool> SqliteDatabaseConnection::connectAsync()
+{
+    return std::async(std::launch::async, [this]() {
+        return connect();
+    });
+}
+
+std::future<bool> SqliteDatabaseConnection::disconnectAsync()
+{
+    return std::async(std::launch::async, [this]() {
+        return disconnect();
+    });
+}
+
+bool SqliteDatabaseConnection::isConnected()
+{
+    return m_sqliteData.connected && connectionPool.isInitialized();
+}
+
+bool SqliteDatabaseConnection::isQueryCached(const std::string& sql)
+{
+    return queryCache()->contains(sql);
+}
+
+bool SqliteDatabaseConnection::isConnectionAlive()
+{
+    if (!isConnected()) {
+        return false;
+    }
+    try {
+        Abstracts::ConnectionLease lease(connectionPool);
+        return connectionPool.pingConnection(lease.connection());
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return false;
+    }
+}
+
+int SqliteDatabaseConnection::getActiveConnectionsCount()
+{
+    // Open pool connections, idle or borrowed, of the readers and the writer
+    const auto readers = connectionPool.statistics();
+    int count = static_cast<int>(readers.idle + readers.inUse);
+    if (&connectionPool.writer() != &connectionPool) {
+        const auto writer = connectionPool.writer().statistics();
+        count += static_cast<int>(writer.idle + writer.inUse);
+    }
+    return count;
+}
+
+int SqliteDatabaseConnection::getMaxConnectionsCount()
+{
+    const auto poolSize = [](SqliteConnectionPool& pool) {
+        std::lock_guard<std::mutex> lock(pool.m_poolData.mutex);
+        return static_cast<int>(pool.m_poolData.poolSize);
+    };
+    int count = poolSize(connectionPool);
+    if (&connectionPool.writer() != &connectionPool) {
+        count += poolSize(connectionPool.writer());
+    }
+    return count;
+}
+
+std::string SqliteDatabaseConnection::getConnectionHealthStatus()
+{
+    if (!isConnected()) {
+        return "Not connected to the SQLite database.";
+    }
+    return isConnectionAlive() ? "Connection is healthy." : "Connection is unhealthy.";
+}
+
+std::string SqliteDatabaseConnection::getDatabaseServerVersion()
+{
+    // The engine is linked in, so its version is the library's
+    return sqlite3_libversion();
+}
+
+std::map<std::string, std::string> SqliteDatabaseConnection::getConnectionStatistics()
+{
+    std::map<std::string, std::string> stats = connectionPool.statisticsMap();
+    if (&connectionPool.writer() != &connectionPool) {
+        for (const auto& [key, value] : connectionPool.writer().statisticsMap()) {
+            stats["writer_" + key] = value;
+        }
+    }
+
+    const auto statements = connectionPool.statementCacheStatistics();
+    stats["statement_cache_hits"] = std::to_string(statements.hits);
+    stats["statement_cache_misses"] = std::to_string(statements.misses);
+    stats["statement_cache_evictions"] = std::to_string(statements.evictions);
+    stats["statement_cache_invalidations"] = std::to_string(statements.invalidations);
+    stats["statement_cache_hit_ratio"] = std::to_string(statements.hitRatio());
+
+    stats["sqlite_memory_used"] = std::to_string(sqlite3_memory_used());
+    stats["sqlite_memory_highwater"] = std::to_string(sqlite3_memory_highwater(0));
+    return stats;
+}
+
+std::chrono::seconds SqliteDatabaseConnection::getConnectionUptime()
+{
+    if (!isConnected()) {
+        return std::chrono::seconds(0);
+    }
+    return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - m_sqliteData.connectedAt);
+}
+
+std::vector<std::string> SqliteDatabaseConnection::getConnectionActivityLog()
+{
+    return {};
+}
+
+void SqliteDatabaseConnection::setConnectionTimeout(int timeoutSeconds)
+{
+    connectionPool.setBusyTimeout(std::chrono::seconds(timeoutSeconds));
+}
+
+bool SqliteDatabaseConnection::beginTransaction()
+{
+    // The transaction belongs to the calling thread; other threads wait for the writer as usual
+    if (m_transactions.current()) {
+        setLastError("A transaction is already in progress.");
+        return false;
+    }
+
+    try {
+        m_transactions.pin(transaction());
+        return true;
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return false;
+    }
+}
+
+bool SqliteDatabaseConnection::commitTransaction()
+{
+    // The pinned connection goes back to the pool whatever the outcome
+    auto pinned = m_transactions.unpin();
+    if (!pinned) {
+        setLastError("No transaction is in progress.");
+        return false;
+    }
+
+    try {
+        pinned->transaction.commit();
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return false;
+    }
+
+    // Results loaded while the transaction was open may predate its writes
+    if (pinned->writtenUnknown) {
+        queryCache()->invalidateAll();
+    } else if (!pinned->writtenTables.empty()) {
+        queryCache()->invalidate(pinned->writtenTables);
+    }
+    if (pinned->schemaChanged) {
+        connectionPool.schemaCatalog().invalidate();
+    }
+    return true;
+}
+
+bool SqliteDatabaseConnection::rollbackTransaction()
+{
+    auto pinned = m_transactions.unpin();
+    if (!pinned) {
+        setLastError("No transaction is in progress.");
+        return false;
+    }
+
+    // A database without readers may have loaded the catalog over the pinned connection
+    if (pinned->schemaChanged) {
+        connectionPool.schemaCatalog().invalidate();
+    }
+
+    try {
+        pinned->transaction.rollback();
+        return true;
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return false;
+    }
+}
+
+Abstracts::Transaction SqliteDatabaseConnection::transaction(const Abstracts::TransactionOptions& options)
+{
+    // A reader's snapshot does not hold up the writer, so read-only transactions stay off it
+    SqliteConnectionPool& pool = options.readOnly ? connectionPool : connectionPool.writer();
+    return Abstracts::Transaction(Abstracts::ConnectionLease(pool), sqliteDialect, options);
+}
+
+SqlitePtr SqliteDatabaseConnection::acquireConnection(Abstracts::ConnectionLease& lease)
+{
+    if (auto* pinned = m_transactions.current()) {
+        return pinned->transaction.lease().get<SqlitePtr>();
+    }
+    // The writer pool holds one connection, so concurrent writers queue here rather than on the file lock
+    lease = Abstracts::ConnectionLease(connectionPool.writer());
+    return lease.get<SqlitePtr>();
+}
+
+SqlitePtr SqliteDatabaseConnection::acquireReadConnection(const std::string& sql, Abstracts::ConnectionLease& lease, SqliteConnectionPool*& pool)
+{
+    // A transaction reads its own writes, and anything that may write needs the writer
+    if (m_transactions.current() || !Abstracts::PoolRouter::isReadOnly(sql)) {
+        pool = &connectionPool.writer();
+        return acquireConnection(lease);
+    }
+    pool = &connectionPool;
+    lease = Abstracts::ConnectionLease(connectionPool);
+    return lease.get<SqlitePtr>();
+}
+
+void SqliteDatabaseConnection::recordWrite(SqlitePtr connection, const std::optional<std::vector<std::string>>& tables)
+{
+    // The rowid belongs to the shared writer connection, so it is read while this caller still holds it
+    m_sqliteData.lastInsertId.store(sqlite3_last_insert_rowid(connection), std::memory_order_relaxed);
+
+    // Invalidated now for the statements that do not join the transaction, and again on commit
+    if (tables) {
+        queryCache()->invalidate(*tables);
+    } else {
+        queryCache()->invalidateAll();
+    }
+
+    if (auto* pinned = m_transactions.current()) {
+        if (tables) {
+            pinned->writtenTables.insert(pinned->writtenTables.end(), tables->begin(), tables->end());
+        } else {
+            pinned->writtenUnknown = true;
+        }
+    }
+}
+
+bool SqliteDatabaseConnection::executeSync(const std::string& sql)
+{
+    // Statements issued between beginTransaction() and commit/rollback run on the pinned connection
+    try {
+        Abstracts::ConnectionLease lease;
+        SqlitePtr sqliteConnection = acquireConnection(lease);
+        executeOnSqlite(sqliteConnection, sql);
+        recordWrite(sqliteConnection, Abstracts::QueryCache::tablesWrittenBy(sql));
+        return true;
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return false;
+    }
+}
+
+std::future<bool> SqliteDatabaseConnection::executeAsync(const std::string& sql)
+{
+    return std::async(std::launch::async, [this, sql]() {
+        return executeSync(sql);
+    });
+}
+
+bool SqliteDatabaseConnection::executePreparedStatementSync(const std::string& sql, const std::vector<std::string>& params)
+{
+    return executeWithParamsSync(sql, params);
+}
+
+std::future<bool> SqliteDatabaseConnection::executePreparedStatementAsync(const std::string& sql, const std::vector<std::string>& params)
+{
+    return std::async(std::launch::async, [this, sql, params]() {
+        return executePreparedStatementSync(sql, params);
+    });
+}
+
+bool SqliteDatabaseConnection::executeBatchSync(const std::vector<std::string>& sqlBatch)
+{
+    // The batch is atomic and syncs the journal once; inside a caller's transaction it simply becomes part of it
+    Abstracts::ConnectionLease lease;
+    SqlitePtr sqliteConnection = __cell_nullptr;
+    const bool ownTransaction = !m_transactions.current();
+    try {
+        sqliteConnection = acquireConnection(lease);
+        if (ownTransaction) {
+            executeOnSqlite(sqliteConnection, std::string(SQLITE_CONSTANTS::BEGIN_IMMEDIATE));
+        }
+        for (const std::string& sql : sqlBatch) {
+            executeOnSqlite(sqliteConnection, sql);
+        }
+        if (ownTransaction) {
+            executeOnSqlite(sqliteConnection, std::string(SQLITE_CONSTANTS::COMMIT));
+        }
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        if (ownTransaction && sqliteConnection && !sqlite3_get_autocommit(sqliteConnection)) {
+            rollbackQuietly(sqliteConnection);
+        }
+        return false;
+    }
+
+    for (const std::string& sql : sqlBatch) {
+        recordWrite(sqliteConnection, Abstracts::QueryCache::tablesWrittenBy(sql));
+    }
+    return true;
+}
+
+std::future<bool> SqliteDatabaseConnection::executeBatchAsync(const std::vector<std::string>& sqlBatch)
+{
+    return std::async(std::launch::async, [this, sqlBatch]() {
+        return executeBatchSync(sqlBatch);
+    });
+}
+
+bool SqliteDatabaseConnection::executeProcedureSync(const std::string&)
+{
+    setLastError("SQLite has no stored procedures.");
+    return false;
+}
+
+std::future<bool> SqliteDatabaseConnection::executeProcedureAsync(const std::string& procedure)
+{
+    return std::async(std::launch::async, [this, procedure]() {
+        return executeProcedureSync(procedure);
+    });
+}
+
+std::vector<std::vector<std::string>> SqliteDatabaseConnection::querySync(const std::string& sql)
+{
+    try {
+        return queryResult(sql)->toRows(false, "NULL");
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return {};
+    }
+}
+
+std::future<std::vector<std::vector<std::string>>> SqliteDatabaseConnection::queryAsync(const std::string& sql)
+{
+    return std::async(std::launch::async, [this, sql]() {
+        return querySync(sql);
+    });
+}
+
+Abstracts::ResultSetPtr SqliteDatabaseConnection::queryResult(const std::string& sql, const std::vector<std::string>& params)
+{
+    // Get a reader, the writer, or the connection pinned by beginTransaction()
+    Abstracts::ConnectionLease lease;
+    SqliteConnectionPool* pool = __cell_nullptr;
+    SqlitePtr sqliteConnection = acquireReadConnection(sql, lease, pool);
+
+    StatementReset reset { prepareCached(*pool, sqliteConnection, sql, params) };
+    auto result = std::make_unique<SqliteResultSet>(reset.statement);
+    if (!sqlite3_stmt_readonly(reset.statement)) {
+        // An INSERT ... RETURNING or similar was sent through a query
+        recordWrite(sqliteConnection, Abstracts::QueryCache::tablesWrittenBy(sql));
+    }
+    return result;
+}
+
+std::future<Abstracts::ResultSetPtr> SqliteDatabaseConnection::queryResultAsync(const std::string& sql, const std::vector<std::string>& params)
+{
+    return std::async(std::launch::async, [this, sql, params]() {
+        return queryResult(sql, params);
+    });
+}
+
+std::vector<std::vector<std::string>> SqliteDatabaseConnection::queryWithParamsSync(const std::string& sql, const std::vector<std::string>& params)
+{
+    try {
+        return queryResult(sql, params)->toRows(false, "NULL");
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return {};
+    }
+}
+
+std::future<std::vector<std::vector<std::string>>> SqliteDatabaseConnection::queryWithParamsAsync(const std::string& sql, const std::vector<std::string>& params)
+{
+    return std::async(std::launch::async, [this, sql, params]() {
+        return queryWithParamsSync(sql, params);
+    });
+}
+
+std::vector<std::vector<std::string>> SqliteDatabaseConnection::queryCached(const std::string& sql,
+                                                                            const std::vector<std::string>& params,
+                                                                            const Abstracts::QueryCacheOptions& options)
+{
+    // Inside a transaction the live data is read, including the transaction's own writes
+    if (m_transactions.current()) {
+        return queryWithParamsSync(sql, params);
+    }
+
+    try {
+        const auto rows = queryCache()->getOrLoad(sql, params, options, [this, &sql, &params]() {
+            return queryResult(sql, params)->toRows(false, "NULL");
+        });
+        return *rows;
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return {};
+    }
+}
+
+void SqliteDatabaseConnection::setQueryCache(std::shared_ptr<Abstracts::QueryCache> cache)
+{
+    if (!cache) {
+        throw std::invalid_argument("The query cache must not be null.");
+    }
+    std::lock_guard<std::mutex> lock(m_sqliteData.cacheMutex);
+    m_sqliteData.queryCache = std::move(cache);
+}
+
+std::shared_ptr<Abstracts::QueryCache> SqliteDatabaseConnection::queryCache() const
+{
+    std::lock_guard<std::mutex> lock(m_sqliteData.cacheMutex);
+    return m_sqliteData.queryCache;
+}
+
+bool SqliteDatabaseConnection::executeWithParamsSync(const std::string& sql, const std::vector<std::string>& params)
+{
+    // Get the writer, or the connection pinned by beginTransaction()
+    try {
+        Abstracts::ConnectionLease lease;
+        SqlitePtr sqliteConnection = acquireConnection(lease);
+        executeCached(connectionPool.writer(), sqliteConnection, sql, params);
+        recordWrite(sqliteConnection, Abstracts::QueryCache::tablesWrittenBy(sql));
+        return true;
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return false;
+    }
+}
+
+std::future<bool> SqliteDatabaseConnection::executeWithParamsAsync(const std::string& sql, const std::vector<std::string>& params)
+{
+    return std::async(std::launch::async, [this, sql, params]() {
+        return executeWithParamsSync(sql, params);
+    });
+}
+
+bool SqliteDatabaseConnection::executeBatchWithParamsSync(const std::string& sql, const std::vector<std::vector<std::string>>& paramsBatch)
+{
+    // The batch is atomic; inside a caller's transaction it simply becomes part of it
+    Abstracts::ConnectionLease lease;
+    SqlitePtr sqliteConnection = __cell_nullptr;
+    const bool ownTransaction = !m_transactions.current();
+    try {
+        sqliteConnection = acquireConnection(lease);
+        if (ownTransaction) {
+            executeOnSqlite(sqliteConnection, std::string(SQLITE_CONSTANTS::BEGIN_IMMEDIATE));
+        }
+
+        // The statement is prepared once and every row only binds and steps
+        for (const auto& params : paramsBatch) {
+            executeCached(connectionPool.writer(), sqliteConnection, sql, params);
+        }
+
+        if (ownTransaction) {
+            executeOnSqlite(sqliteConnection, std::string(SQLITE_CONSTANTS::COMMIT));
+        }
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        if (ownTransaction && sqliteConnection && !sqlite3_get_autocommit(sqliteConnection)) {
+            rollbackQuietly(sqliteConnection);
+        }
+        return false;
+    }
+    recordWrite(sqliteConnection, Abstracts::QueryCache::tablesWrittenBy(sql));
+    return true;
+}
+
+std::future<bool> SqliteDatabaseConnection::executeBatchWithParamsAsync(const std::string& sql, const std::vector<std::vector<std::string>>& paramsBatch)
+{
+    return std::async(std::launch::async, [this, sql, paramsBatch]() {
+        return executeBatchWithParamsSync(sql, paramsBatch);
+    });
+}
+
+bool SqliteDatabaseConnection::executeProcedureWithParamsSync(const std::string&, const std::vector<std::string>&)
+{
+    setLastError("SQLite has no stored procedures.");
+    return false;
+}
+
+std::future<bool> SqliteDatabaseConnection::executeProcedureWithParamsAsync(const std::string& procedure, const std::vector<std::string>& params)
+{
+    return std::async(std::launch::async, [this, procedure, params]() {
+        return executeProcedureWithParamsSync(procedure, params);
+    });
+}
+
+void SqliteDatabaseConnection::executeNonQuery(const std::string& sql)
+{
+    if (!executeSync(sql)) {
+        throw Exception(Exception::Reason::Database, getLastError()).getRuntimeError();
+    }
+}
+
+Abstracts::SchemaSnapshotPtr SqliteDatabaseConnection::schema()
+{
+    return connectionPool.schemaCatalog().snapshot([this]() {
+        Abstracts::ConnectionLease lease;
+        SqlitePtr sqliteConnection = __cell_nullptr;
+        if (&connectionPool.writer() != &connectionPool) {
+            // A reader only sees committed changes, never the DDL of an open transaction
+            lease = Abstracts::ConnectionLease(connectionPool);
+            sqliteConnection = lease.get<SqlitePtr>();
+        } else {
+            // The database has a single connection, pinned or not
+            sqliteConnection = acquireConnection(lease);
+        }
+        StatementReset reset { prepareCached(connectionPool, sqliteConnection, sqliteSchemaCatalog, {}) };
+        return Abstracts::SchemaCatalog::parse(SqliteResultSet(reset.statement));
+    });
+}
+
+bool SqliteDatabaseConnection::executeSchemaChange(const std::string& sql)
+{
+    if (!executeSync(sql)) {
+        return false;
+    }
+    connectionPool.schemaCatalog().invalidate();
+    // Readers keep seeing the old schema until the transaction ends
+    if (auto* pinned = m_transactions.current()) {
+        pinned->schemaChanged = true;
+    }
+    return true;
+}
+
+std::vector<std::string> SqliteDatabaseConnection::getTableNames()
+{
+    try {
+        return schema()->tableNames();
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return {};
+    }
+}
+
+std::vector<std::string> SqliteDatabaseConnection::getTableColumns(const std::string& tableName)
+{
+    std::vector<std::string> columns;
+    try {
+        const auto snapshot = schema();
+        if (const auto* table = snapshot->table(tableName)) {
+            for (const auto& column : table->columns) {
+                columns.push_back(column.name);
+            }
+        }
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+    }
+    return columns;
+}
+
+std::vector<std::string> SqliteDatabaseConnection::getTableColumnTypes(const std::string& tableName)
+{
+    std::vector<std::string> columnTypes;
+    try {
+        const auto snapshot = schema();
+        if (const auto* table = snapshot->table(tableName)) {
+            for (const auto& column : table->columns) {
+                columnTypes.push_back(column.type);
+            }
+        }
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+    }
+    return columnTypes;
+}
+
+std::string SqliteDatabaseConnection::getTablePrimaryKey(const std::string& tableName)
+{
+    try {
+        const auto snapshot = schema();
+        const auto* table = snapshot->table(tableName);
+        return table && !table->primaryKey.empty() ? table->primaryKey.front() : std::string();
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return {};
+    }
+}
+
+std::pair<std::string, std::string> SqliteDatabaseConnection::getTableForeignKey(const std::string& tableName, const std::string& foreignKey)
+{
+    try {
+        const auto snapshot = schema();
+        const auto* table = snapshot->table(tableName);
+        if (!table) {
+            return {};
+        }
+        for (const auto& constraint : table->foreignKeys) {
+            if (!constraint.columns.empty() && (constraint.name == foreignKey || constraint.columns.front() == foreignKey)) {
+                return { constraint.columns.front(), constraint.referencedTable };
+            }
+        }
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+    }
+    return {};
+}
+
+bool SqliteDatabaseConnection::createTable(const std::string& tableName, const std::vector<std::string>& columns)
+{
+    std::string sql = "CREATE TABLE " + tableName + " (";
+    for (std::size_t i = 0; i < columns.size(); ++i) {
+        sql += (i == 0 ? "" : ", ") + columns[i];
+    }
+    sql += ")";
+    return executeSchemaChange(sql);
+}
+
+bool SqliteDatabaseConnection::dropTable(const std::string& tableName)
+{
+    return executeSchemaChange("DROP TABLE " + tableName);
+}
+
+bool SqliteDatabaseConnection::addColumn(const std::string& tableName, const std::string& columnName, const std::string& columnType)
+{
+    return executeSchemaChange(std::string(SQLITE_CONSTANTS::ALTER_TABLE) + " " + tableName + " ADD COLUMN " + columnName + " " + columnType);
+}
+
+bool SqliteDatabaseConnection::modifyColumn(const std::string& tableName, const std::string& columnName, const std::string&)
+{
+    setLastError("SQLite cannot change the type of " + tableName + "." + columnName + " in place; the table has to be rebuilt.");
+    return false;
+}
+
+bool SqliteDatabaseConnection::renameColumn(const std::string& tableName, const std::string& columnName, const std::string& newColumnName)
+{
+    return executeSchemaChange(std::string(SQLITE_CONSTANTS::ALTER_TABLE) + " " + tableName + " RENAME COLUMN " + columnName + " TO " + newColumnName);
+}
+
+bool SqliteDatabaseConnection::deleteColumn(const std::string& tableName, const std::string& columnName)
+{
+    return executeSchemaChange(std::string(SQLITE_CONSTANTS::ALTER_TABLE) + " " + tableName + " DROP COLUMN " + columnName);
+}
+
+uint SqliteDatabaseConnection::getLastInsertID()
+{
+    return static_cast<uint>(m_sqliteData.lastInsertId.load(std::memory_order_relaxed));
+}
+
+std::vector<std::string> SqliteDatabaseConnection::getExistingIndexes(const std::string& tableName)
+{
+    std::vector<std::string> indexNames;
+    try {
+        const auto snapshot = schema();
+        if (const auto* table = snapshot->table(tableName)) {
+            for (const auto& index : table->indexes) {
+                indexNames.push_back(index.name);
+            }
+        }
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+    }
+    return indexNames;
+}
+
+bool SqliteDatabaseConnection::indexExists(const std::string& tableName, const std::string& indexName)
+{
+    try {
+        const auto snapshot = schema();
+        const auto* table = snapshot->table(tableName);
+        return table && table->index(indexName);
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return false;
+    }
+}
+
+bool SqliteDatabaseConnection::createIndex(const std::string& tableName, const std::string& indexName, const std::vector<std::string>& columns)
+{
+    if (indexExists(tableName, indexName)) {
+        setLastError("The index " + indexName + " already exists on " + tableName + ".");
+        return false;
+    }
+    return executeSchemaChange(generateCreateIndexSQL(tableName, indexName, columns));
+}
+
+bool SqliteDatabaseConnection::dropIndex(const std::string& tableName, const std::string& indexName)
+{
+    if (!indexExists(tableName, indexName)) {
+        setLastError("The index " + indexName + " does not exist on " + tableName + ".");
+        return false;
+    }
+    return executeSchemaChange(generateDropIndexSQL(tableName, indexName));
+}
+
+std::string SqliteDatabaseConnection::generateCreateIndexSQL(const std::string& tableName, const std::string& indexName, const std::vector<std::string>& columns)
+{
+    std::string createIndexSQL = "CREATE INDEX " + indexName + " ON " + tableName + " (";
+    for (std::size_t i = 0; i < columns.size(); ++i) {
+        createIndexSQL += (i == 0 ? "" : ", ") + columns[i];
+    }
+    createIndexSQL += ")";
+    return createIndexSQL;
+}
+
+std::string SqliteDatabaseConnection::generateDropIndexSQL(const std::string&, const std::string& indexName)
+{
+    // Index names are unique per database in SQLite
+    return "DROP INDEX " + indexName;
+}
+
+bool SqliteDatabaseConnection::bulkInsert(const std::string& tableName, const std::vector<std::vector<std::string>>& data)
+{
+    if (data.empty()) {
+        setLastError("No data was provided for the bulk insert.");
+        return false;
+    }
+
+    // One INSERT per row width; each is prepared once and every row only binds and steps
+    const auto insertFor = [&tableName](std::size_t width) {
+        std::string sql = std::string(SQLITE_CONSTANTS::INSERT_INTO) + " " + tableName + " VALUES (";
+        for (std::size_t i = 0; i < width; ++i) {
+            sql += i == 0 ? "?" : ", ?";
+        }
+        return sql + ")";
+    };
+
+    Abstracts::ConnectionLease lease;
+    SqlitePtr sqliteConnection = __cell_nullptr;
+    const bool ownTransaction = !m_transactions.current();
+    try {
+        sqliteConnection = acquireConnection(lease);
+        if (ownTransaction) {
+            executeOnSqlite(sqliteConnection, std::string(SQLITE_CONSTANTS::BEGIN_IMMEDIATE));
+        }
+
+        std::size_t width = data.front().size();
+        std::string sql = insertFor(width);
+        for (const auto& row : data) {
+            if (row.size() != width) {
+                width = row.size();
+                sql = insertFor(width);
+            }
+            executeCached(connectionPool.writer(), sqliteConnection, sql, row);
+        }
+
+        if (ownTransaction) {
+            executeOnSqlite(sqliteConnection, std::string(SQLITE_CONSTANTS::COMMIT));
+        }
+    } catch (const std::exception& e) {
+        setLastError(std::string("Failed to perform the bulk insert: ") + e.what());
+        if (ownTransaction && sqliteConnection && !sqlite3_get_autocommit(sqliteConnection)) {
+            rollbackQuietly(sqliteConnection);
+        }
+        return false;
+    }
+
+    recordWrite(sqliteConnection, std::vector<std::string> { tableName });
+    return true;
+}
+
+bool SqliteDatabaseConnection::bulkUpdate(const std::string& tableName, const std::vector<std::vector<std::string>>& data, const std::string& condition)
+{
+    if (data.empty()) {
+        setLastError("No data was provided for the bulk update.");
+        return false;
+    }
+
+    // The values are bound rather than spliced into the statement
+    std::string sql = std::string(SQLITE_CONSTANTS::UPDATE) + " " + tableName + " SET ";
+    std::vector<std::string> params;
+    params.reserve(data.size());
+    for (const auto& row : data) {
+        if (row.size() < 2) {
+            setLastError("Every row of a bulk update must hold a column name and a value.");
+            return false;
+        }
+        sql += (params.empty() ? "" : ", ") + row[0] + " = ?";
+        params.push_back(row[1]);
+    }
+    sql += " " + std::string(SQLITE_CONSTANTS::WHERE) + " " + condition;
+
+    return executeWithParamsSync(sql, params);
+}
+
+bool SqliteDatabaseConnection::bulkDelete(const std::string& tableName, const std::string& condition)
+{
+    return executeSync(std::string(SQLITE_CONSTANTS::DELETE_FROM) + " " + tableName + " " + std::string(SQLITE_CONSTANTS::WHERE) + " " + condition);
+}
+
+bool SqliteDatabaseConnection::migrateData(const std::string& sourceTableName, const std::string& destinationTableName)
+{
+    return executeSync(std::string(SQLITE_CONSTANTS::INSERT_INTO) + " " + destinationTableName + " SELECT * FROM " + sourceTableName);
+}
+
+std::vector<std::vector<std::string>> SqliteDatabaseConnection::queryWithPagination(const std::string& sql, int pageNumber, int pageSize)
+{
+    const int offset = (pageNumber - 1) * pageSize;
+    return querySync(sql + " " + std::string(SQLITE_CONSTANTS::LIMIT) + " " + std::to_string(pageSize)
+                     + " " + std::string(SQLITE_CONSTANTS::OFFSET) + " " + std::to_string(offset));
+}
+
+Abstracts::KeysetPage SqliteDatabaseConnection::queryWithKeyset(const std::string& sql,
+                                                                const std::vector<Abstracts::KeysetColumn>& ordering,
+                                                                std::size_t pageSize,
+                                                                const std::string& continuation)
+{
+    // Every page after the first has the same text, so it reuses one prepared statement
+    const auto query = Abstracts::KeysetPagination::build(sql, ordering, pageSize, continuation, sqliteKeyset);
+    return Abstracts::KeysetPagination::page(queryResult(query.sql, query.params)->toRows(false), ordering, pageSize);
+}
+
+std::string SqliteDatabaseConnection::getLastError()
+{
+    std::lock_guard<std::mutex> lock(m_sqliteData.errorMutex);
+    return m_sqliteData.lastError;
+}
+
+void SqliteDatabaseConnection::setLastError(std::string error)
+{
+    std::lock_guard<std::mutex> lock(m_sqliteData.errorMutex);
+    m_sqliteData.lastError = std::move(error);
+}
+
+std::optional<std::string> SqliteDatabaseConnection::queryScalar(const std::string& sql)
+{
+    const auto result = queryResult(sql);
+    if (result->rowCount() == 0 || result->columnCount() == 0 || result->isNull(0, 0)) {
+        return std::nullopt;
+    }
+    return std::string(result->value(0, 0));
+}
+
+int SqliteDatabaseConnection::getRowCount(const std::string& tableName)
+{
+    try {
+        if (m_sqliteData.statistics.mode == Abstracts::StatisticsMode::Fast) {
+            return static_cast<int>(std::min<std::uint64_t>(estimateRowCount(tableName), std::numeric_limits<int>::max()));
+        }
+        return std::stoi(queryScalar("SELECT COUNT(*) FROM " + tableName).value_or("0"));
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return -1;
+    }
+}
+
+std::string SqliteDatabaseConnection::getMaxValue(const std::string& tableName, const std::string& columnName)
+{
+    try {
+        if (m_sqliteData.statistics.mode == Abstracts::StatisticsMode::Fast) {
+            // With an index on the column this reads its last entry
+            const auto rows = statistic("max", tableName, columnName, [this, &tableName, &columnName]() {
+                return queryResult("SELECT " + columnName + " FROM " + tableName + " WHERE " + columnName + " IS NOT NULL ORDER BY "
+                                   + columnName + " DESC LIMIT 1")->toRows(false);
+            });
+            return rows->empty() ? std::string() : rows->front().front();
+        }
+        return queryScalar("SELECT MAX(" + columnName + ") FROM " + tableName).value_or(std::string());
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return {};
+    }
+}
+
+std::string SqliteDatabaseConnection::getMinValue(const std::string& tableName, const std::string& columnName)
+{
+    try {
+        if (m_sqliteData.statistics.mode == Abstracts::StatisticsMode::Fast) {
+            // With an index on the column this reads its first entry
+            const auto rows = statistic("min", tableName, columnName, [this, &tableName, &columnName]() {
+                return queryResult("SELECT " + columnName + " FROM " + tableName + " WHERE " + columnName + " IS NOT NULL ORDER BY "
+                                   + columnName + " LIMIT 1")->toRows(false);
+            });
+            return rows->empty() ? std::string() : rows->front().front();
+        }
+        return queryScalar("SELECT MIN(" + columnName + ") FROM " + tableName).value_or(std::string());
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return {};
+    }
+}
+
+double SqliteDatabaseConnection::getAverageValue(const std::string& tableName, const std::string& columnName)
+{
+    try {
+        const auto rows = statistic("average", tableName, columnName, [this, &tableName, &columnName]() {
+            return Abstracts::QueryCache::Rows { { queryScalar("SELECT AVG(" + columnName + ") FROM " + tableName).value_or("0") } };
+        });
+        return std::stod(rows->front().front());
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return 0.0;
+    }
+}
+
+double SqliteDatabaseConnection::getSumValue(const std::string& tableName, const std::string& columnName)
+{
+    try {
+        // TOTAL() is a float and 0.0 over no rows, where SUM() would be NULL or overflow
+        const auto rows = statistic("sum", tableName, columnName, [this, &tableName, &columnName]() {
+            return Abstracts::QueryCache::Rows { { queryScalar("SELECT TOTAL(" + columnName + ") FROM " + tableName).value_or("0") } };
+        });
+        return std::stod(rows->front().front());
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+        return 0.0;
+    }
+}
+
+std::vector<std::string> SqliteDatabaseConnection::getDistinctValues(const std::string& tableName, const std::string& columnName)
+{
+    std::vector<std::string> distinctValues;
+    try {
+        const auto rows = statistic("distinct-values", tableName, columnName, [this, &tableName, &columnName]() {
+            return queryResult("SELECT DISTINCT " + columnName + " FROM " + tableName)->toRows(false);
+        });
+        for (const auto& row : *rows) {
+            distinctValues.push_back(row[0]);
+        }
+    } catch (const std::exception& e) {
+        setLastError(e.what());
+    }
+    return distinctValues;
+}
+
+void SqliteDatabaseConnection::setStatisticsOptions(const Abstracts::StatisticsOptions& options)
+{
+    m_sqliteData.statistics = options;
+}
+
+Abstracts::StatisticsOptions SqliteDatabaseConnection::statisticsOptions() const
+{
+    return m_sqliteData.statistics;
+}
+
+std::uint64_t SqliteDatabaseConnection::estimateRowCount(const std::string& tableName)
+{
+    const auto rows = statistic("rows", tableName, {}, [this, &tableName]() {
+        // The first number of every sqlite_stat1 row of a table is its row count; a partial index counts fewer
+        std::optional<std::uint64_t> estimate;
+        if (queryScalar("SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = 'sqlite_stat1'")) {
+            const auto stats = queryResult("SELECT stat FROM sqlite_stat1 WHERE tbl = ?", { tableName });
+            for (std::size_t row = 0; row < stats->rowCount(); ++row) {
+                std::uint64_t count {};
+                const auto stat = stats->value(row, 0);
+                if (std::from_chars(stat.data(), stat.data() + stat.size(), count).ec == std::errc {}) {
+                    estimate = std::max(estimate.value_or(0), count);
+                }
+            }
+        }
+        return Abstracts::QueryCache::Rows {
+            { estimate ? std::to_string(*estimate) : queryScalar("SELECT COUNT(*) FROM " + tableName).value_or("0") }
+        };
+    });
+    return std::stoull(rows->front().front());
+}
+
+std::uint64_t SqliteDatabaseConnection::estimateDistinctCount(const std::string& tableName, const std::string& columnName)
+{
+    const auto rows = statistic("distinct", tableName, columnName, [this, &tableName, &columnName]() {
+        const std::uint64_t total = estimateRowCount(tableName);
+        const double fraction = Abstracts::StatisticsEstimator::sampleFraction(m_sqliteData.statistics.sampleRows, total);
+        // The scan still reads every row, but only the sample is materialized and nothing is sorted
+        std::string sql = "SELECT " + columnName + " FROM " + tableName;
+        if (fraction < 1.0) {
+            sql += " WHERE abs(random() % 1000000) < " + std::to_string(std::llround(fraction * 1000000.0));
+        }
+
+        const auto result = queryResult(sql);
+        Abstracts::HyperLogLog sketch;
+        std::uint64_t values = 0;
+        for (std::size_t row = 0; row < result->rowCount(); ++row) {
+            if (!result->isNull(row, 0)) {
+                sketch.add(result->value(row, 0));
+                ++values;
+            }
+        }
+        if (fraction >= 1.0 || result->rowCount() == 0) {
+            return Abstracts::QueryCache::Rows { { std::to_string(std::llround(sketch.estimate())) } };
+        }
+        const auto nonNull = static_cast<std::uint64_t>(static_cast<double>(total) * static_cast<double>(values)
+                                                        / static_cast<double>(result->rowCount()));
+        const auto distinct = Abstracts::StatisticsEstimator::scaleDistinct(sketch.estimate(), values, nonNull, sketch.standardError());
+        return Abstracts::QueryCache::Rows { { std::to_string(distinct) } };
+    });
+    return std::stoull(rows->front().front());
+}
+
+Abstracts::QueryCache::RowsPtr SqliteDatabaseConnection::statistic(std::string_view name,
+                                                                   const std::string& tableName,
+                                                                   const std::string& columnName,
+                                                                   const Abstracts::StatisticsEstimator::Compute& compute)
+{
+    // A transaction reads its own writes, which the cache must neither serve nor keep
+    if (m_sqliteData.statistics.mode != Abstracts::StatisticsMode::Fast || m_transactions.current()) {
+        return std::make_shared<const Abstracts::QueryCache::Rows>(compute());
+    }
+    return Abstracts::StatisticsEstimator::cached(*queryCache(), m_sqliteData.statistics, name, tableName, columnName, compute);
+}
+
+CELL_NAMESPACE_END
+
+#endif
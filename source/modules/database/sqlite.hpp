@@ -0,0 +1,613 @@
+/*!
+ * @file        sqlite.hpp
+ * @brief       Database SQLite manager for the Cell Engine.
+ * @details     This file defines the SQLite database connection, an embedded driver over a local database file.
+ * @author      Kambiz Asadzadeh
+ * @since       07 Jun 2023
+ * @version     1.0
+ * @note        This is part of the Cell Engine, developed by Kambiz Asadzadeh.
+ *
+ * @license     This file is licensed under the terms of the Genyleap License. See the LICENSE.md file for more information.
+ * @copyright   Copyright (c) 2025 The Genyleap | Kambiz Asadzadeh. All rights reserved.
+ * @see         https://github.com/genyleap/cell
+ */
+
+#ifndef CELL_SQLITE_HPP
+#define CELL_SQLITE_HPP
+
+#if defined(USE_SQLITE)
+
+#if __has_include("common.hpp")
+#   include "common.hpp"
+#else
+#   error "Cell's "common.hpp" was not found!"
+#endif
+
+#if __has_include("abstract-includer.hpp")
+#   include "abstract-includer.hpp"
+#else
+#   error "Cell's "abstract-includer.hpp" was not found!"
+#endif
+
+#if __has_include("sqliteprivate.hpp")
+#   include "sqliteprivate.hpp"
+#else
+#   error "Cell's "sqliteprivate.hpp" was not found!"
+#endif
+
+#if __has_include("sqliteconnectionpool.hpp")
+#   include "sqliteconnectionpool.hpp"
+#else
+#   error "Cell's "sqliteconnectionpool.hpp" was not found!"
+#endif
+
+#if __has_include("sqliteresultset.hpp")
+#   include "sqliteresultset.hpp"
+#else
+#   error "Cell's "sqliteresultset.hpp" was not found!"
+#endif
+
+CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Database)
+
+/**
+ * @class SqliteDatabaseConnection
+ * @brief Represents a connection to a SQLite database file.
+ *
+ * Writes, transactions and batches run on the pool's single writer connection, so writers of the
+ * process queue for it instead of failing on the file lock. Statements that cannot write run on the
+ * reader connections, which in WAL mode work alongside the writer. Every statement is prepared once
+ * per connection and kept in its statement cache, and batches and bulk inserts run in one transaction,
+ * so the journal is synced once per batch rather than once per row.
+ *
+ * This class inherits from Abstracts::DatabaseConnection, Abstracts::DatabaseTransaction,
+ * Abstracts::DataManipulator, Abstracts::QueryExecutor and Abstracts::TableManager.
+ *
+ * @note This class is marked with the "__cell_export" attribute, indicating
+ *       it is part of the "cell" module for exporting purposes.
+ */
+class __cell_export SqliteDatabaseConnection : public
+                                               Abstracts::DatabaseConnection,
+                                               Abstracts::DatabaseTransaction,
+                                               Abstracts::DataManipulator,
+                                               Abstracts::QueryExecutor,
+                                               Abstracts::TableManager
+{
+public:
+    /**
+     * @brief Constructs a SqliteDatabaseConnection object.
+     *
+     * @param connectionPool The pool of the database file.
+     */
+    SqliteDatabaseConnection(SqliteConnectionPool& connectionPool);
+
+    /**
+     * @brief Destroys the SqliteDatabaseConnection object, rolling back an open transaction.
+     */
+    ~SqliteDatabaseConnection();
+
+    /**
+     * @brief Borrows a reader connection from the pool.
+     *
+     * @return The sqlite3 handle; it must be returned with releaseConnection() on the pool.
+     */
+    void* get() __cell_override;
+
+    /**
+     * @brief Opens the pool's connections, switching the file to WAL mode.
+     *
+     * @return True if the database could be opened, false otherwise.
+     */
+    bool connect() __cell_override;
+
+    /**
+     * @brief Rolls back an open transaction; the pool stays open for other connections.
+     *
+     * @return Always true.
+     */
+    bool disconnect() __cell_override;
+
+    /**
+     * @brief Checks if connect() succeeded and disconnect() was not called since.
+     */
+    bool isConnected() __cell_override;
+
+    /**
+     * @brief Checks that a reader connection can run a statement.
+     */
+    bool isConnectionAlive() __cell_override;
+
+    /**
+     * @brief Retrieves the counters of the reader pool, the writer pool (prefixed "writer_") and the statement caches.
+     */
+    std::map<std::string, std::string> getConnectionStatistics() __cell_override;
+
+    /**
+     * @brief Retrieves the number of open connections, the writer's included.
+     */
+    int getActiveConnectionsCount() __cell_override;
+
+    /**
+     * @brief Retrieves the maximum number of connections, the writer's included.
+     */
+    int getMaxConnectionsCount() __cell_override;
+
+    /**
+     * @brief Retrieves the health status of the database connection.
+     */
+    std::string getConnectionHealthStatus() __cell_override;
+
+    /**
+     * @brief Retrieves the version of the SQLite library.
+     */
+    std::string getDatabaseServerVersion() __cell_override;
+
+    /**
+     * @brief Retrieves the time since connect().
+     */
+    std::chrono::seconds getConnectionUptime() __cell_override;
+
+    /**
+     * @brief An embedded database has no server sessions to log.
+     *
+     * @return An empty vector.
+     */
+    std::vector<std::string> getConnectionActivityLog() __cell_override;
+
+    /**
+     * @brief Connects to the database asynchronously.
+     */
+    std::future<bool> connectAsync() __cell_override;
+
+    /**
+     * @brief Disconnects from the database asynchronously.
+     */
+    std::future<bool> disconnectAsync() __cell_override;
+
+    /**
+     * @brief Checks if the specified query is cached.
+     *
+     * @param sql The SQL query to check.
+     * @return True if the query is cached, false otherwise.
+     */
+    bool isQueryCached(const std::string& sql) __cell_override;
+
+    /**
+     * @brief Sets how long statements wait for a lock held by another process.
+     *
+     * @param timeoutSeconds The busy timeout, in seconds, of connections opened from now on.
+     */
+    void setConnectionTimeout(int timeoutSeconds) __cell_override;
+
+    /**
+     * @brief Begins a transaction on the writer connection.
+     *
+     * The transaction takes the write lock immediately (BEGIN IMMEDIATE), so it cannot fail later on a
+     * lock upgrade. Statements the calling thread makes until commitTransaction() or rollbackTransaction() run in it.
+     *
+     * @return True if the transaction is successfully started, false otherwise.
+     */
+    bool beginTransaction() __cell_override;
+
+    /**
+     * @brief Commits the current transaction.
+     *
+     * @return True if the transaction is successfully committed, false otherwise.
+     */
+    bool commitTransaction() __cell_override;
+
+    /**
+     * @brief Rolls back the current transaction.
+     *
+     * @return True if the transaction is successfully rolled back, false otherwise.
+     */
+    bool rollbackTransaction() __cell_override;
+
+    /**
+     * @brief Opens a transaction pinned to a single pooled connection.
+     *
+     * A read-only transaction runs on a reader connection and reads one snapshot of the database
+     * without holding up the writer; any other runs on the writer. SQLite transactions are always
+     * serializable, so the isolation level is ignored.
+     *
+     * @param options The access mode.
+     * @return The open transaction.
+     */
+    Abstracts::Transaction transaction(const Abstracts::TransactionOptions& options = {});
+
+    /**
+     * @brief Runs a transaction body and commits it, retrying the whole transaction when the database is busy.
+     *
+     * @param body Receives the Abstracts::Transaction; its return value is returned.
+     * @param options The access mode.
+     * @param maxAttempts The number of attempts before the failure is rethrown.
+     */
+    template <typename Body>
+    auto runTransaction(Body&& body,
+                        const Abstracts::TransactionOptions& options = {},
+                        Types::uint maxAttempts = Abstracts::TRANSACTION_CONSTANTS::DEFAULT_MAX_ATTEMPTS)
+    {
+        return Abstracts::retryTransaction([&] { return transaction(options); }, std::forward<Body>(body), maxAttempts);
+    }
+
+    /**
+     * @brief Executes one or more SQL statements on the writer connection.
+     *
+     * @param sql The SQL statements to execute.
+     * @return True if the execution is successful, false otherwise.
+     */
+    bool executeSync(const std::string& sql) __cell_override;
+
+    /**
+     * @brief Executes executeSync() asynchronously.
+     */
+    std::future<bool> executeAsync(const std::string& sql) __cell_override;
+
+    /**
+     * @brief Executes executeWithParamsSync().
+     */
+    bool executePreparedStatementSync(const std::string& sql, const std::vector<std::string>& params) __cell_override;
+
+    /**
+     * @brief Executes executeWithParamsSync() asynchronously.
+     */
+    std::future<bool> executePreparedStatementAsync(const std::string& sql, const std::vector<std::string>& params) __cell_override;
+
+    /**
+     * @brief Executes a batch of SQL statements in a single transaction.
+     *
+     * @param sqlBatch The SQL statements to execute.
+     * @return True if every statement succeeded and the batch was committed, false otherwise.
+     */
+    bool executeBatchSync(const std::vector<std::string>& sqlBatch) __cell_override;
+
+    /**
+     * @brief Executes executeBatchSync() asynchronously.
+     */
+    std::future<bool> executeBatchAsync(const std::vector<std::string>& sqlBatch) __cell_override;
+
+    /**
+     * @brief SQLite has no stored procedures.
+     *
+     * @return Always false.
+     */
+    bool executeProcedureSync(const std::string& procedure) __cell_override;
+
+    /**
+     * @brief SQLite has no stored procedures.
+     */
+    std::future<bool> executeProcedureAsync(const std::string& procedure) __cell_override;
+
+    /**
+     * @brief Executes an SQL query and returns its rows as strings, with NULL as "NULL".
+     *
+     * @param sql The SQL query to execute.
+     * @return A 2D vector of strings representing the result of the query.
+     */
+    std::vector<std::vector<std::string>> querySync(const std::string& sql) __cell_override;
+
+    /**
+     * @brief Executes querySync() asynchronously.
+     */
+    std::future<std::vector<std::vector<std::string>>> queryAsync(const std::string& sql) __cell_override;
+
+    /**
+     * @brief Executes an SQL query and returns its rows as a result set.
+     *
+     * The statement runs on a reader connection unless it may write or a transaction is open.
+     *
+     * @param sql The SQL query, with placeholders if params is not empty.
+     * @param params The parameters to be bound to the query.
+     * @return The result set.
+     * @throws std::runtime_error If the query fails.
+     */
+    Abstracts::ResultSetPtr queryResult(const std::string& sql, const std::vector<std::string>& params = {});
+
+    /**
+     * @brief Executes queryResult() asynchronously; the result set is moved, not copied, into the future.
+     */
+    std::future<Abstracts::ResultSetPtr> queryResultAsync(const std::string& sql, const std::vector<std::string>& params = {});
+
+    /**
+     * @brief Executes an SQL query with parameters and returns its rows as strings, with NULL as "NULL".
+     *
+     * @param sql The SQL query with placeholders.
+     * @param params The parameters to be bound to the query.
+     * @return A 2D vector of strings representing the result of the query.
+     */
+    std::vector<std::vector<std::string>> queryWithParamsSync(const std::string& sql, const std::vector<std::string>& params) __cell_override;
+
+    /**
+     * @brief Executes queryWithParamsSync() asynchronously.
+     */
+    std::future<std::vector<std::vector<std::string>>> queryWithParamsAsync(const std::string& sql, const std::vector<std::string>& params) __cell_override;
+
+    /**
+     * @brief Executes an SQL query through the query cache.
+     *
+     * Only queries made through this method are cached. Inside a transaction the cache is bypassed so
+     * the transaction's own writes are seen.
+     *
+     * @param sql The SQL query, with placeholders if params is not empty.
+     * @param params The parameters to be bound to the query.
+     * @param options The lifetime of the result and the tables it depends on.
+     * @return A 2D vector of strings representing the result of the query.
+     */
+    std::vector<std::vector<std::string>> queryCached(const std::string& sql,
+                                                      const std::vector<std::string>& params = {},
+                                                      const Abstracts::QueryCacheOptions& options = {}) __cell_override;
+
+    /**
+     * @brief Uses a query cache, e.g. one shared with other connections and drivers.
+     *
+     * @param cache The cache to use from now on.
+     */
+    void setQueryCache(std::shared_ptr<Abstracts::QueryCache> cache) __cell_override;
+
+    /**
+     * @brief Returns the query cache used by this connection.
+     */
+    std::shared_ptr<Abstracts::QueryCache> queryCache() const __cell_override;
+
+    /**
+     * @brief Executes a single SQL statement with parameters on the writer connection.
+     *
+     * @param sql The SQL statement with placeholders.
+     * @param params The parameters to be bound to the statement.
+     * @return True if the execution is successful, false otherwise.
+     */
+    bool executeWithParamsSync(const std::string& sql, const std::vector<std::string>& params) __cell_override;
+
+    /**
+     * @brief Executes executeWithParamsSync() asynchronously.
+     */
+    std::future<bool> executeWithParamsAsync(const std::string& sql, const std::vector<std::string>& params) __cell_override;
+
+    /**
+     * @brief Executes one statement for every set of parameters, in a single transaction.
+     *
+     * @param sql The SQL statement with placeholders.
+     * @param paramsBatch The parameters of every execution.
+     * @return True if every execution succeeded and the batch was committed, false otherwise.
+     */
+    bool executeBatchWithParamsSync(const std::string& sql, const std::vector<std::vector<std::string>>& paramsBatch) __cell_override;
+
+    /**
+     * @brief Executes executeBatchWithParamsSync() asynchronously.
+     */
+    std::future<bool> executeBatchWithParamsAsync(const std::string& sql, const std::vector<std::vector<std::string>>& paramsBatch) __cell_override;
+
+    /**
+     * @brief SQLite has no stored procedures.
+     *
+     * @return Always false.
+     */
+    bool executeProcedureWithParamsSync(const std::string& procedure, const std::vector<std::string>& params) __cell_override;
+
+    /**
+     * @brief SQLite has no stored procedures.
+     */
+    std::future<bool> executeProcedureWithParamsAsync(const std::string& procedure, const std::vector<std::string>& params) __cell_override;
+
+    /**
+     * @brief Executes one or more SQL statements.
+     *
+     * @throws std::runtime_error If a statement fails.
+     */
+    void executeNonQuery(const std::string& sql) __cell_override;
+
+    /**
+     * @brief Returns the schema catalog of the connection pool, reloading it after a schema change.
+     *
+     * The catalog is read with one statement over the sqlite_master and table-valued pragma functions,
+     * on a reader when the pool has them.
+     */
+    Abstracts::SchemaSnapshotPtr schema() __cell_override;
+
+    std::vector<std::string> getTableNames() __cell_override;
+    std::vector<std::string> getTableColumns(const std::string& tableName) __cell_override;
+    std::vector<std::string> getTableColumnTypes(const std::string& tableName) __cell_override;
+
+    /**
+     * @brief Retrieves the first column of the primary key of a table.
+     */
+    std::string getTablePrimaryKey(const std::string& tableName) __cell_override;
+
+    /**
+     * @brief Retrieves a foreign key of a table.
+     *
+     * SQLite foreign keys have no names, so the key is looked up by its column or its numeric id.
+     *
+     * @param tableName The name of the table.
+     * @param foreignKey The column of the foreign key, or its id in PRAGMA foreign_key_list.
+     * @return The column and the referenced table.
+     */
+    std::pair<std::string, std::string> getTableForeignKey(const std::string& tableName, const std::string& foreignKey) __cell_override;
+
+    bool createTable(const std::string& tableName, const std::vector<std::string>& columns) __cell_override;
+    bool dropTable(const std::string& tableName) __cell_override;
+    bool addColumn(const std::string& tableName, const std::string& columnName, const std::string& columnType) __cell_override;
+
+    /**
+     * @brief SQLite cannot change the type of a column in place; the table has to be rebuilt.
+     *
+     * @return Always false.
+     */
+    bool modifyColumn(const std::string& tableName, const std::string& columnName, const std::string& newColumnType) __cell_override;
+
+    bool renameColumn(const std::string& tableName, const std::string& columnName, const std::string& newColumnName) __cell_override;
+    bool deleteColumn(const std::string& tableName, const std::string& columnName) __cell_override;
+
+    /**
+     * @brief Retrieves the rowid of the last row inserted through this connection.
+     */
+    Types::uint getLastInsertID() __cell_override;
+
+    std::vector<std::string> getExistingIndexes(const std::string& tableName) __cell_override;
+    bool indexExists(const std::string& tableName, const std::string& indexName) __cell_override;
+    bool createIndex(const std::string& tableName, const std::string& indexName, const std::vector<std::string>& columns) __cell_override;
+    bool dropIndex(const std::string& tableName, const std::string& indexName) __cell_override;
+    std::string generateCreateIndexSQL(const std::string& tableName, const std::string& indexName, const std::vector<std::string>& columns) __cell_override;
+    std::string generateDropIndexSQL(const std::string& tableName, const std::string& indexName) __cell_override;
+
+    /**
+     * @brief Inserts rows into a table, in a single transaction.
+     *
+     * Every row is bound to one cached `INSERT ... VALUES (?, ...)` statement.
+     *
+     * @param tableName The name of the table.
+     * @param data The rows, with a value for every column.
+     * @return True if every row was inserted, false otherwise.
+     */
+    bool bulkInsert(const std::string& tableName, const std::vector<std::vector<std::string>>& data) __cell_override;
+
+    /**
+     * @brief Sets columns of the rows matching a condition.
+     *
+     * @param tableName The name of the table.
+     * @param data Pairs of a column name and its new value.
+     * @param condition The WHERE condition.
+     * @return True if the update is successful, false otherwise.
+     */
+    bool bulkUpdate(const std::string& tableName, const std::vector<std::vector<std::string>>& data, const std::string& condition) __cell_override;
+
+    bool bulkDelete(const std::string& tableName, const std::string& condition) __cell_override;
+    bool migrateData(const std::string& sourceTableName, const std::string& destinationTableName) __cell_override;
+    std::vector<std::vector<std::string>> queryWithPagination(const std::string& sql, int pageNumber, int pageSize) __cell_override;
+
+    /**
+     * @brief Reads one page of a query by its ordering key (see Abstracts::KeysetPagination).
+     *
+     * @throws std::invalid_argument If the ordering is empty, the page size is zero or the token is invalid.
+     * @throws std::runtime_error If the query fails.
+     */
+    Abstracts::KeysetPage queryWithKeyset(const std::string& sql,
+                                          const std::vector<Abstracts::KeysetColumn>& ordering,
+                                          std::size_t pageSize,
+                                          const std::string& continuation = {}) __cell_override;
+
+    int getRowCount(const std::string& tableName) __cell_override;
+    std::string getMaxValue(const std::string& tableName, const std::string& columnName) __cell_override;
+    std::string getMinValue(const std::string& tableName, const std::string& columnName) __cell_override;
+    double getAverageValue(const std::string& tableName, const std::string& columnName) __cell_override;
+    double getSumValue(const std::string& tableName, const std::string& columnName) __cell_override;
+    std::vector<std::string> getDistinctValues(const std::string& tableName, const std::string& columnName) __cell_override;
+
+    /**
+     * @brief Chooses how the aggregate methods answer from now on.
+     *
+     * The exact mode is the default. In the fast mode row counts come from sqlite_stat1, MIN and MAX
+     * read one end of an index on the column when there is one, and every result is kept in the query
+     * cache for the configured lifetime. AVG and SUM stay exact but are cached too. Call it before the
+     * connection is shared between threads.
+     *
+     * @param options The mode, the lifetime of cached statistics and the sample size.
+     */
+    void setStatisticsOptions(const Abstracts::StatisticsOptions& options);
+
+    /**
+     * @brief Returns the statistics settings of this connection.
+     */
+    Abstracts::StatisticsOptions statisticsOptions() const;
+
+    /**
+     * @brief Estimates the number of rows in a table from sqlite_stat1.
+     *
+     * The statistics are as old as the last ANALYZE or PRAGMA optimize; a table without them is counted
+     * exactly.
+     *
+     * @param tableName The table.
+     * @return The estimated number of rows.
+     * @throws std::runtime_error If a query fails.
+     */
+    std::uint64_t estimateRowCount(const std::string& tableName);
+
+    /**
+     * @brief Estimates the number of distinct non-NULL values of a column.
+     *
+     * About the configured number of rows, picked with random(), are streamed through a HyperLogLog
+     * sketch and scaled to the whole table; see Abstracts::StatisticsEstimator. Tables no larger than
+     * the sample are read whole.
+     *
+     * @param tableName The table.
+     * @param columnName The column.
+     * @return The estimated number of distinct values.
+     * @throws std::runtime_error If a query fails.
+     */
+    std::uint64_t estimateDistinctCount(const std::string& tableName, const std::string& columnName);
+
+    /**
+     * @brief Retrieves the last error message generated by the database connection.
+     *
+     * @return A string representing the last error message.
+     */
+    std::string getLastError() __cell_override;
+
+private:
+    /**
+     * @brief Records the error returned by getLastError(); safe to call from std::async threads.
+     */
+    void setLastError(std::string error);
+
+    /**
+     * @brief Returns the connection pinned by beginTransaction(), or leases the writer.
+     *
+     * @param lease Receives the lease when no transaction is pinned.
+     */
+    Types::SqlitePtr acquireConnection(Abstracts::ConnectionLease& lease);
+
+    /**
+     * @brief Returns a reader connection for a statement that cannot write, and the writer otherwise.
+     *
+     * @param sql The statement to be run.
+     * @param lease Receives the lease when no transaction is pinned.
+     * @param pool Receives the pool the connection belongs to.
+     */
+    Types::SqlitePtr acquireReadConnection(const std::string& sql, Abstracts::ConnectionLease& lease, SqliteConnectionPool*& pool);
+
+    /**
+     * @brief Notes a write made through the writer connection.
+     *
+     * The cached results that depend on the tables are dropped, and the rowid of the last insert is
+     * kept. Inside a transaction the tables are remembered and invalidated again when it commits.
+     *
+     * @param connection The writer connection, still held by the caller.
+     * @param tables The tables written, or std::nullopt if they cannot be told.
+     */
+    void recordWrite(Types::SqlitePtr connection, const std::optional<std::vector<std::string>>& tables);
+
+    /**
+     * @brief Executes a schema change and invalidates the pool's schema catalog.
+     *
+     * Inside a transaction the catalog is invalidated again when it ends.
+     *
+     * @return True if the statement succeeded.
+     */
+    bool executeSchemaChange(const std::string& sql);
+
+    /**
+     * @brief Executes a query expected to return at most one value.
+     *
+     * @return The value, or std::nullopt if there is no row or it is NULL.
+     * @throws std::runtime_error If the query fails.
+     */
+    std::optional<std::string> queryScalar(const std::string& sql);
+
+    /**
+     * @brief Returns a statistic, from the query cache in the fast statistics mode.
+     *
+     * Outside the fast mode, and inside a transaction, it is computed every time.
+     */
+    Abstracts::QueryCache::RowsPtr statistic(std::string_view name,
+                                             const std::string& tableName,
+                                             const std::string& columnName,
+                                             const Abstracts::StatisticsEstimator::Compute& compute);
+
+    SqliteData                              m_sqliteData;       //!< Errors, query cache and counters.
+    SqliteConnectionPool&                   connectionPool;     //!< Reference to the SQLite connection pool.
+    Abstracts::PinnedTransactions           m_transactions;     //!< Transactions opened by beginTransaction(), per calling thread.
+};
+
+CELL_NAMESPACE_END
+
+#endif
+#endif // CELL_SQLITE_HPP
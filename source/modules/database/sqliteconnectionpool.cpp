@@ -0,0 +1,174 @@
+#if __has_include("sqliteconnectionpool.hpp")
+#   include "sqliteconnectionpool.hpp"
+#else
+#   error "Cell's "sqliteconnectionpool.hpp" was not found!"
+#endif
+
+#if defined(USE_SQLITE)
+
+#if __has_include("core/core.hpp")
+#   include "core/core.hpp"
+#else
+#   error "Cell's "core/core.hpp" was not found!"
+#endif
+
+CELL_USING_NAMESPACE Cell;
+CELL_USING_NAMESPACE Cell::System;
+CELL_USING_NAMESPACE Cell::Utility;
+CELL_USING_NAMESPACE Cell::Types;
+
+CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Database)
+
+namespace {
+
+std::string_view synchronousPragma(SqliteSynchronous synchronous)
+{
+    switch (synchronous) {
+    case SqliteSynchronous::Off:
+        return "OFF";
+    case SqliteSynchronous::Full:
+        return "FULL";
+    case SqliteSynchronous::Normal:
+        break;
+    }
+    return "NORMAL";
+}
+
+}  // namespace
+
+SqliteConnectionPool::SqliteConnectionPool(const std::string& path, uint readers, const SqliteOptions& options)
+    : m_path(path), m_options(options), m_busyTimeoutMs(options.busyTimeout.count())
+{
+    m_poolData.database = path;
+
+    // A private in-memory database exists only inside one connection, which therefore does everything
+    if (path == SQLITE_POOL_CONSTANTS::MEMORY_DATABASE || readers == 0) {
+        m_poolData.poolSize = 1;
+        return;
+    }
+    m_readOnly = true;
+    m_poolData.poolSize = readers;
+    m_writer.reset(new SqliteConnectionPool(WriterRole {}, path, options));
+}
+
+SqliteConnectionPool::SqliteConnectionPool(WriterRole, const std::string& path, const SqliteOptions& options)
+    : m_path(path), m_options(options), m_busyTimeoutMs(options.busyTimeout.count())
+{
+    m_poolData.database = path;
+    m_poolData.poolSize = 1;
+}
+
+SqliteConnectionPool::~SqliteConnectionPool()
+{
+    // Readers close first so the writer's close is the last one and checkpoints the WAL into the file
+    shutdown();
+}
+
+void SqliteConnectionPool::initialize()
+{
+    if (m_writer) {
+        m_writer->initialize();
+    }
+    ConnectionPool::initialize();
+}
+
+SqliteConnectionPool& SqliteConnectionPool::writer()
+{
+    return m_writer ? *m_writer : *this;
+}
+
+SqlConnection SqliteConnectionPool::openConnection()
+{
+    // Each pooled connection is used by one thread at a time, so SQLite's own mutexes are not needed
+    SqlitePtr connection = __cell_nullptr;
+    const int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX;
+    if (sqlite3_open_v2(m_path.c_str(), &connection, flags, __cell_nullptr) != SQLITE_OK) {
+        const std::string message = connection ? sqlite3_errmsg(connection) : "out of memory";
+        sqlite3_close_v2(connection);
+        throw Exception(Exception::Reason::Database, "Failed to open the SQLite database '" + m_path + "': " + message).getRuntimeError();
+    }
+    sqlite3_busy_timeout(connection, static_cast<int>(m_busyTimeoutMs.load(std::memory_order_relaxed)));
+
+    // The journal mode is stored in the file, so only the writer sets it; readers must not write at all
+    std::string pragmas = "PRAGMA mmap_size = " + std::to_string(m_options.mmapSize) + ";"
+                          "PRAGMA cache_size = " + std::to_string(m_options.cacheSize) + ";";
+    if (m_readOnly) {
+        pragmas += "PRAGMA query_only = ON;";
+    } else {
+        pragmas += "PRAGMA journal_mode = WAL;"
+                   "PRAGMA synchronous = " + std::string(synchronousPragma(m_options.synchronous)) + ";";
+    }
+
+    char* error = __cell_nullptr;
+    if (sqlite3_exec(connection, pragmas.c_str(), __cell_nullptr, __cell_nullptr, &error) != SQLITE_OK) {
+        const std::string message = error ? error : sqlite3_errmsg(connection);
+        sqlite3_free(error);
+        sqlite3_close_v2(connection);
+        throw Exception(Exception::Reason::Database, "Failed to configure the SQLite database '" + m_path + "': " + message).getRuntimeError();
+    }
+    return connection;
+}
+
+bool SqliteConnectionPool::pingConnection(const SqlConnection& connection)
+{
+    return sqlite3_exec(std::get<SqlitePtr>(connection), "SELECT 1", __cell_nullptr, __cell_nullptr, __cell_nullptr) == SQLITE_OK;
+}
+
+void SqliteConnectionPool::closeConnection(const SqlConnection& connection)
+{
+    if (SqlitePtr sqliteConnection = std::get<SqlitePtr>(connection)) {
+        // Statements are finalized first, otherwise the connection would stay open as a zombie
+        m_statementCaches.remove(sqliteConnection, true);
+        sqlite3_close_v2(sqliteConnection);
+    }
+}
+
+Abstracts::StatementCache<sqlite3_stmt*>& SqliteConnectionPool::statementCache(SqlitePtr connection)
+{
+    return m_statementCaches.cacheFor(connection, [](sqlite3_stmt*& statement) {
+        sqlite3_finalize(statement);
+    });
+}
+
+void SqliteConnectionPool::setStatementCacheCapacity(std::size_t capacity)
+{
+    m_statementCaches.setCapacity(capacity);
+    if (m_writer) {
+        m_writer->setStatementCacheCapacity(capacity);
+    }
+}
+
+Abstracts::StatementCacheStatistics SqliteConnectionPool::statementCacheStatistics() const
+{
+    auto statistics = m_statementCaches.statistics();
+    if (m_writer) {
+        const auto writer = m_writer->statementCacheStatistics();
+        statistics.hits += writer.hits;
+        statistics.misses += writer.misses;
+        statistics.evictions += writer.evictions;
+        statistics.invalidations += writer.invalidations;
+    }
+    return statistics;
+}
+
+void SqliteConnectionPool::setBusyTimeout(std::chrono::milliseconds timeout)
+{
+    m_busyTimeoutMs.store(timeout.count(), std::memory_order_relaxed);
+    if (m_writer) {
+        m_writer->setBusyTimeout(timeout);
+    }
+}
+
+const std::string& SqliteConnectionPool::path() const
+{
+    return m_path;
+}
+
+void SqliteConnectionPool::enableEncryption(const std::string&, const std::string&, const std::string&)
+{
+    throw Exception(Exception::Reason::Database, "SQLite databases are local files and have no connection to encrypt.").getRuntimeError();
+}
+
+CELL_NAMESPACE_END
+
+#endif
@@ -0,0 +1,197 @@
+/*!
+ * @file        sqliteconnectionpool.hpp
+ * @brief       Database SQLite connection pool for the Cell Engine.
+ * @details     This file defines the SQLite connection pool: one writer connection and a pool of reader connections.
+ * @author      Kambiz Asadzadeh
+ * @since       07 Jun 2023
+ * @version     1.0
+ * @note        This is part of the Cell Engine, developed by Kambiz Asadzadeh.
+ *
+ * @license     This file is licensed under the terms of the Genyleap License. See the LICENSE.md file for more information.
+ * @copyright   Copyright (c) 2025 The Genyleap | Kambiz Asadzadeh. All rights reserved.
+ * @see         https://github.com/genyleap/cell
+ */
+
+#ifndef CELL_SQLITE_CONNECTION_POOL_HPP
+#define CELL_SQLITE_CONNECTION_POOL_HPP
+
+#if defined(USE_SQLITE)
+
+#if __has_include("common.hpp")
+#   include "common.hpp"
+#else
+#   error "Cell's "common.hpp" was not found!"
+#endif
+
+#if __has_include("abstract-includer.hpp")
+#   include "abstract-includer.hpp"
+#else
+#   error "Cell's "abstract-includer.hpp" was not found!"
+#endif
+
+CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Database)
+
+/**
+ * @brief Constants related to SQLite connections.
+ */
+struct SQLITE_POOL_CONSTANTS final
+{
+    __cell_static_const_constexpr std::string_view MEMORY_DATABASE      {":memory:"};       //!< Path of a private in-memory database.
+    __cell_static_const_constexpr std::int64_t DEFAULT_MMAP_SIZE        = 256 * 1024 * 1024; //!< Bytes of the file read through a memory map.
+    __cell_static_const_constexpr std::int64_t DEFAULT_CACHE_SIZE       = -64 * 1024;       //!< Page cache per connection; negative values are KiB.
+    __cell_static_const_constexpr std::chrono::milliseconds DEFAULT_BUSY_TIMEOUT {5000};    //!< How long a statement waits for a lock.
+};
+
+/**
+ * @brief How hard SQLite syncs the file to disk (PRAGMA synchronous).
+ */
+enum class SqliteSynchronous : Types::u8
+{
+    Off,        //!< Never syncs; a power loss may corrupt the database.
+    Normal,     //!< Syncs at checkpoints; with WAL a power loss may lose the last commits but never corrupts.
+    Full        //!< Syncs on every commit.
+};
+
+/**
+ * @brief Tuning of the connections of a SQLite pool.
+ */
+struct SqliteOptions final
+{
+    std::int64_t                mmapSize    { SQLITE_POOL_CONSTANTS::DEFAULT_MMAP_SIZE };       //!< PRAGMA mmap_size; 0 reads through the page cache only.
+    std::int64_t                cacheSize   { SQLITE_POOL_CONSTANTS::DEFAULT_CACHE_SIZE };      //!< PRAGMA cache_size; pages, or KiB when negative.
+    std::chrono::milliseconds   busyTimeout { SQLITE_POOL_CONSTANTS::DEFAULT_BUSY_TIMEOUT };    //!< How long a statement waits for a lock.
+    SqliteSynchronous           synchronous { SqliteSynchronous::Normal };                      //!< PRAGMA synchronous of the writer.
+};
+
+/**
+ * @brief A connection pool implementation for SQLite database files.
+ *
+ * SQLite lets one connection write at a time, so the pool keeps a single writer connection in a pool
+ * of its own (see writer()) and hands out reader connections from itself. The database is switched to
+ * WAL mode, in which readers never block the writer nor each other and always see the last commit.
+ * Readers are opened with PRAGMA query_only so a statement routed to them by mistake cannot write.
+ *
+ * An in-memory database, or a pool of zero readers, has no separate writer: every statement uses the
+ * one connection of this pool, and writer() returns the pool itself. An in-memory database lives as
+ * long as that connection.
+ *
+ * @note This class is marked with the "__cell_export" attribute, indicating
+ *       it is part of the "cell" module for exporting purposes.
+ */
+class __cell_export SqliteConnectionPool : public Abstracts::ConnectionPool
+{
+public:
+    /**
+     * @brief Constructs a SqliteConnectionPool object.
+     *
+     * @param path The path of the database file, created if missing, or ":memory:".
+     * @param readers The maximum number of reader connections.
+     * @param options The memory map, page cache, busy timeout and sync settings.
+     */
+    SqliteConnectionPool(const std::string& path, Types::uint readers, const SqliteOptions& options = {});
+
+    /**
+     * @brief Destroys the SqliteConnectionPool object.
+     */
+    ~SqliteConnectionPool();
+
+    /**
+     * @brief Disable copy construction and assignment for a class.
+     */
+    CELL_DISABLE_COPY(SqliteConnectionPool)
+
+    /**
+     * @brief Declare SqliteDatabaseConnection class as a friend of the specified class.
+     */
+    CELL_MAKE_FRIEND(SqliteDatabaseConnection)
+
+    /**
+     * @brief Opens the writer, which switches the file to WAL, and then the readers.
+     */
+    void initialize() __cell_override;
+
+    /**
+     * @brief Returns the pool holding the single writer connection.
+     */
+    SqliteConnectionPool& writer();
+
+    /**
+     * @brief SQLite files are local, so there is no transport to encrypt.
+     *
+     * @throws std::runtime_error Always.
+     */
+    void enableEncryption(const std::string& keyPath, const std::string& certPath, const std::string& caPath) __cell_override;
+
+    /**
+     * @brief Returns the prepared statement cache of a pooled connection.
+     *
+     * Only the current holder of the connection may use the returned cache.
+     *
+     * @param connection The connection the statements are prepared on.
+     */
+    Abstracts::StatementCache<sqlite3_stmt*>& statementCache(Types::SqlitePtr connection);
+
+    /**
+     * @brief Sets how many prepared statements each connection, the writer's included, keeps.
+     *
+     * @param capacity The maximum number of statements per connection.
+     */
+    void setStatementCacheCapacity(std::size_t capacity);
+
+    /**
+     * @brief Returns the hit, miss, eviction and invalidation counters of the statement caches, the writer's included.
+     */
+    Abstracts::StatementCacheStatistics statementCacheStatistics() const;
+
+    /**
+     * @brief Sets how long statements wait for a lock on connections opened from now on.
+     */
+    void setBusyTimeout(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Returns the path of the database.
+     */
+    const std::string& path() const;
+
+protected:
+    /**
+     * @brief Opens a new SQLite connection and applies the pool's pragmas.
+     *
+     * @throws std::runtime_error If the file cannot be opened or configured.
+     */
+    Types::SqlConnection openConnection() __cell_override;
+
+    /**
+     * @brief Checks that a SQLite connection can still run a statement.
+     */
+    bool pingConnection(const Types::SqlConnection& connection) __cell_override;
+
+    /**
+     * @brief Finalizes the cached statements of a SQLite connection and closes it.
+     */
+    void closeConnection(const Types::SqlConnection& connection) __cell_override;
+
+private:
+    /**
+     * @brief Selects the constructor of the writer pool.
+     */
+    struct WriterRole final {};
+
+    /**
+     * @brief Constructs the pool of the single writer connection.
+     */
+    SqliteConnectionPool(WriterRole, const std::string& path, const SqliteOptions& options);
+
+    std::string                                                         m_path              {};             //!< The database file.
+    SqliteOptions                                                       m_options           {};             //!< Connection tuning.
+    std::atomic<std::int64_t>                                           m_busyTimeoutMs     {};             //!< Busy timeout of new connections.
+    bool                                                                m_readOnly          { false };      //!< Whether this pool holds readers.
+    std::unique_ptr<SqliteConnectionPool>                               m_writer            {};             //!< The writer's pool; empty when this pool writes.
+    Abstracts::StatementCacheRegistry<Types::SqlitePtr, sqlite3_stmt*>  m_statementCaches   {};             //!< Prepared statements per connection.
+};
+
+CELL_NAMESPACE_END
+
+#endif
+
+#endif // CELL_SQLITE_CONNECTION_POOL_HPP
@@ -0,0 +1,83 @@
+/*!
+ * @file        sqliteprivate.hpp
+ * @brief       Database SQLite manager for the Cell Engine.
+ * @details     This file defines the constants and state of the SQLite database connection.
+ * @author      Kambiz Asadzadeh
+ * @since       07 Jun 2023
+ * @version     1.0
+ * @note        This is part of the Cell Engine, developed by Kambiz Asadzadeh.
+ *
+ * @license     This file is licensed under the terms of the Genyleap License. See the LICENSE.md file for more information.
+ * @copyright   Copyright (c) 2025 The Genyleap | Kambiz Asadzadeh. All rights reserved.
+ * @see         https://github.com/genyleap/cell
+ */
+
+#ifndef CELL_SQLITE_PRIVATE_HPP
+#define CELL_SQLITE_PRIVATE_HPP
+
+#if defined(USE_SQLITE)
+
+#if __has_include("common.hpp")
+#   include "common.hpp"
+#else
+#   error "Cell's "common.hpp" was not found!"
+#endif
+
+#if __has_include("abstract-includer.hpp")
+#   include "abstract-includer.hpp"
+#else
+#   error "Cell's "abstract-includer.hpp" was not found!"
+#endif
+
+#if __has_include("sqliteconnectionpool.hpp")
+#   include "sqliteconnectionpool.hpp"
+#else
+#   error "Cell's "sqliteconnectionpool.hpp" was not found!"
+#endif
+
+CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Database)
+
+/**
+ * @brief Constants related to SQLite operations.
+ *
+ * This struct provides static string views representing various SQLite operations, keywords, and clauses.
+ */
+struct SQLITE_CONSTANTS final
+{
+    __cell_static_const_constexpr std::string_view DRIVER_NAME          {"SQLite"};                     //!<The name of the SQLite driver.
+    __cell_static_const_constexpr std::string_view BEGIN                {"BEGIN DEFERRED"};             //!<Opens a transaction that takes locks as it needs them.
+    __cell_static_const_constexpr std::string_view BEGIN_IMMEDIATE      {"BEGIN IMMEDIATE"};            //!<Opens a transaction that takes the write lock up front.
+    __cell_static_const_constexpr std::string_view COMMIT               {"COMMIT"};                     //!<The COMMIT transaction keyword.
+    __cell_static_const_constexpr std::string_view ROLLBACK             {"ROLLBACK"};                   //!<The ROLLBACK transaction keyword.
+    __cell_static_const_constexpr std::string_view INSERT_INTO          {"INSERT INTO"};                //!<The INSERT INTO keyword.
+    __cell_static_const_constexpr std::string_view UPDATE               {"UPDATE"};                     //!<The UPDATE keyword.
+    __cell_static_const_constexpr std::string_view DELETE_FROM          {"DELETE FROM"};                //!<The DELETE FROM keyword.
+    __cell_static_const_constexpr std::string_view ALTER_TABLE          {"ALTER TABLE"};                //!<The ALTER TABLE keyword.
+    __cell_static_const_constexpr std::string_view WHERE                {"WHERE"};                      //!<The WHERE keyword.
+    __cell_static_const_constexpr std::string_view LIMIT                {"LIMIT"};                      //!<The LIMIT keyword.
+    __cell_static_const_constexpr std::string_view OFFSET               {"OFFSET"};                     //!<The OFFSET keyword.
+};
+
+/**
+ * @brief Represents the state of a SQLite database connection.
+ */
+struct SqliteData final
+{
+    std::string          lastError;         //!< Last error message encountered.
+    mutable Types::Mutex errorMutex;        //!< Guards lastError, which std::async threads write too.
+
+    std::atomic<std::int64_t>               lastInsertId    {};     //!< Rowid of the last row inserted through this connection.
+    std::chrono::steady_clock::time_point   connectedAt     {};     //!< When connect() succeeded.
+    std::atomic<bool>                       connected       { false }; //!< Whether connect() succeeded and disconnect() was not called.
+
+    std::shared_ptr<Abstracts::QueryCache> queryCache { std::make_shared<Abstracts::QueryCache>() };  //!< Results of the queries that opt in; may be shared.
+    mutable Types::Mutex        cacheMutex              {};         //!< Guards the query cache pointer.
+
+    Abstracts::StatisticsOptions statistics {};                      //!< How the aggregate methods answer.
+};
+
+CELL_NAMESPACE_END
+
+#endif
+
+#endif // CELL_SQLITE_PRIVATE_HPP
@@ -0,0 +1,99 @@
+#if __has_include("sqliteresultset.hpp")
+#   include "sqliteresultset.hpp"
+#else
+#   error "Cell's "sqliteresultset.hpp" was not found!"
+#endif
+
+#if defined(USE_SQLITE)
+
+#if __has_include("core/core.hpp")
+#   include "core/core.hpp"
+#else
+#   error "Cell's "core/core.hpp" was not found!"
+#endif
+
+CELL_USING_NAMESPACE Cell;
+CELL_USING_NAMESPACE Cell::Types;
+
+CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Database)
+
+SqliteResultSet::SqliteResultSet(sqlite3_stmt* statement)
+{
+    const int columns = sqlite3_column_count(statement);
+    m_names.reserve(static_cast<std::size_t>(columns));
+    for (int column = 0; column < columns; ++column) {
+        const char* name = sqlite3_column_name(statement, column);
+        m_names.emplace_back(name ? name : "");
+    }
+
+    m_offsets.push_back(0);
+    int status;
+    while ((status = sqlite3_step(statement)) == SQLITE_ROW) {
+        // One row may need several words when there are more than 64 columns
+        const std::size_t words = ((m_rows + 1) * m_names.size() + 63) / 64;
+        if (words > m_nulls.size()) {
+            m_nulls.resize(std::max(words, m_nulls.size() * 2), 0);
+        }
+        for (int column = 0; column < columns; ++column) {
+            const int type = sqlite3_column_type(statement, column);
+            if (type == SQLITE_NULL) {
+                const std::size_t bit = m_rows * m_names.size() + static_cast<std::size_t>(column);
+                m_nulls[bit / 64] |= std::uint64_t { 1 } << (bit % 64);
+            } else {
+                // The pointer has to be fetched before the size, which may convert the value first
+                const void* data = type == SQLITE_BLOB ? sqlite3_column_blob(statement, column)
+                                                       : static_cast<const void*>(sqlite3_column_text(statement, column));
+                const int bytes = sqlite3_column_bytes(statement, column);
+                if (data) {
+                    m_data.append(static_cast<const char*>(data), static_cast<std::size_t>(bytes));
+                }
+            }
+            m_offsets.push_back(m_data.size());
+        }
+        ++m_rows;
+    }
+    if (status != SQLITE_DONE) {
+        throwSqliteError(status, sqlite3_errmsg(sqlite3_db_handle(statement)));
+    }
+}
+
+std::size_t SqliteResultSet::rowCount() const
+{
+    return m_rows;
+}
+
+std::size_t SqliteResultSet::columnCount() const
+{
+    return m_names.size();
+}
+
+std::string_view SqliteResultSet::columnName(std::size_t column) const
+{
+    return m_names[column];
+}
+
+bool SqliteResultSet::isNull(std::size_t row, std::size_t column) const
+{
+    const std::size_t bit = row * m_names.size() + column;
+    return (m_nulls[bit / 64] >> (bit % 64)) & 1;
+}
+
+std::string_view SqliteResultSet::value(std::size_t row, std::size_t column) const
+{
+    const std::size_t index = row * m_names.size() + column;
+    return std::string_view(m_data).substr(m_offsets[index], m_offsets[index + 1] - m_offsets[index]);
+}
+
+void throwSqliteError(int status, const std::string& message)
+{
+    // SQLITE_BUSY (BUSY_SNAPSHOT included) and SQLITE_LOCKED succeed when the transaction is run again
+    const int primary = status & 0xFF;
+    if (primary == SQLITE_BUSY || primary == SQLITE_LOCKED) {
+        throw Abstracts::SerializationFailure(message);
+    }
+    throw Exception(Exception::Reason::Database, message).getRuntimeError();
+}
+
+CELL_NAMESPACE_END
+
+#endif
@@ -0,0 +1,86 @@
+/*!
+ * @file        sqliteresultset.hpp
+ * @brief       Database SQLite result set for the Cell Engine.
+ * @details     This file defines SqliteResultSet, a columnar copy of the rows of a SQLite statement.
+ * @author      Kambiz Asadzadeh
+ * @since       07 Jun 2023
+ * @version     1.0
+ * @note        This is part of the Cell Engine, developed by Kambiz Asadzadeh.
+ *
+ * @license     This file is licensed under the terms of the Genyleap License. See the LICENSE.md file for more information.
+ * @copyright   Copyright (c) 2025 The Genyleap | Kambiz Asadzadeh. All rights reserved.
+ * @see         https://github.com/genyleap/cell
+ */
+
+#ifndef CELL_SQLITE_RESULT_SET_HPP
+#define CELL_SQLITE_RESULT_SET_HPP
+
+#if defined(USE_SQLITE)
+
+#if __has_include("common.hpp")
+#   include "common.hpp"
+#else
+#   error "Cell's "common.hpp" was not found!"
+#endif
+
+#if __has_include("abstract-includer.hpp")
+#   include "abstract-includer.hpp"
+#else
+#   error "Cell's "abstract-includer.hpp" was not found!"
+#endif
+
+CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Database)
+
+/**
+ * @brief A SQLite query result read into one buffer.
+ *
+ * SQLite only keeps the current row of a statement, so the constructor steps through all of them and
+ * appends every value to a single buffer, with an offset per value and a null bitmap. That is one
+ * copy per value and a handful of allocations per result, after which every access is O(1) and views
+ * point into the buffer. Integers and reals are stored as SQLite renders them as text, and blobs as
+ * their raw bytes.
+ *
+ * @note This class is marked with the "__cell_export" attribute, indicating
+ *       it is part of the "cell" module for exporting purposes.
+ */
+class __cell_export SqliteResultSet final : public Abstracts::ResultSet
+{
+public:
+    /**
+     * @brief Reads every remaining row of a statement.
+     *
+     * @param statement A prepared and bound statement; it is left stepped to the end, not reset.
+     * @throws Abstracts::SerializationFailure If a step fails with SQLITE_BUSY or SQLITE_LOCKED.
+     * @throws std::runtime_error If a step fails otherwise.
+     */
+    explicit SqliteResultSet(sqlite3_stmt* statement);
+
+    std::size_t rowCount() const __cell_override;
+    std::size_t columnCount() const __cell_override;
+    std::string_view columnName(std::size_t column) const __cell_override;
+    bool isNull(std::size_t row, std::size_t column) const __cell_override;
+    std::string_view value(std::size_t row, std::size_t column) const __cell_override;
+
+private:
+    std::vector<std::string>    m_names     {}; //!< Column names.
+    std::size_t                 m_rows      {}; //!< Number of rows.
+    std::string                 m_data      {}; //!< Every value, back to back, row-major.
+    std::vector<std::size_t>    m_offsets   {}; //!< Start of each value in m_data, plus the end of the last one.
+    std::vector<std::uint64_t>  m_nulls     {}; //!< One bit per value, row-major.
+};
+
+/**
+ * @brief Throws the error of a failed SQLite call.
+ *
+ * @param status The result code of the call.
+ * @param message The error message of the connection.
+ * @throws Abstracts::SerializationFailure For SQLITE_BUSY and SQLITE_LOCKED, which succeed when the transaction is run again.
+ * @throws std::runtime_error For any other status.
+ */
+__cell_no_return void throwSqliteError(int status, const std::string& message);
+
+CELL_NAMESPACE_END
+
+#endif
+
+#endif // CELL_SQLITE_RESULT_SET_HPP
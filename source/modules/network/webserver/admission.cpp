@@ -0,0 +1,107 @@
+#if __has_include("admission.hpp")
+#   include "admission.hpp"
+#else
+#   error "Cell's admission was not found!"
+#endif
+
+CELL_USING_NAMESPACE Cell;
+CELL_USING_NAMESPACE Cell::Types;
+
+CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Network::WebServer)
+
+AdmissionController::AdmissionController()
+    : m_intervalStart(std::chrono::steady_clock::now())
+    , m_minimumDelay(std::chrono::steady_clock::duration::max())
+{
+}
+
+void AdmissionController::setQueueDelayTarget(std::chrono::milliseconds target, std::chrono::milliseconds interval)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_target = target;
+    m_interval = std::max(interval, target);
+    m_overloaded = false;
+}
+
+void AdmissionController::setRoutePriority(const std::string& pathPrefix, RequestPriority priority)
+{
+    // Writers copy the table under the mutex; readers keep whichever table they loaded
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto current = m_priorities.load(std::memory_order_acquire);
+    auto priorities = current ? std::make_shared<RoutePriorities>(*current) : std::make_shared<RoutePriorities>();
+    auto it = std::find_if(priorities->begin(), priorities->end(), [&](const auto& entry) { return entry.first == pathPrefix; });
+    if (it != priorities->end()) {
+        it->second = priority;
+    } else {
+        priorities->emplace_back(pathPrefix, priority);
+        std::stable_sort(priorities->begin(), priorities->end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.first.size() > rhs.first.size();
+        });
+    }
+    m_priorities.store(std::move(priorities), std::memory_order_release);
+}
+
+RequestPriority AdmissionController::priorityOf(std::string_view path) const
+{
+    const auto priorities = m_priorities.load(std::memory_order_acquire);
+    if (!priorities) {
+        return RequestPriority::Normal;
+    }
+    for (const auto& [prefix, priority] : *priorities) {
+        // "/api" covers "/api" and "/api/users", not "/apix"; "/static/" covers everything below it
+        if (path.starts_with(prefix)
+            && (path.size() == prefix.size() || prefix.ends_with('/') || path[prefix.size()] == '/')) {
+            return priority;
+        }
+    }
+    return RequestPriority::Normal;
+}
+
+bool AdmissionController::admit(std::chrono::steady_clock::duration queueDelay, RequestPriority priority)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_target == std::chrono::steady_clock::duration::zero()) {
+        ++m_statistics.admitted;
+        return true;
+    }
+
+    // Close the observation window: a standing queue exists if even the best request waited too long.
+    const auto now = std::chrono::steady_clock::now();
+    if (now - m_intervalStart >= m_interval) {
+        m_overloaded = m_minimumDelay != std::chrono::steady_clock::duration::max() && m_minimumDelay > m_target;
+        m_minimumDelay = std::chrono::steady_clock::duration::max();
+        m_intervalStart = now;
+    }
+    m_minimumDelay = std::min(m_minimumDelay, queueDelay);
+
+    bool admitted = true;
+    switch (priority) {
+    case RequestPriority::Critical:
+        break;
+    case RequestPriority::Normal:
+        admitted = queueDelay <= (m_overloaded ? m_target : m_interval);
+        break;
+    case RequestPriority::Sheddable:
+        admitted = !m_overloaded && queueDelay <= m_interval;
+        break;
+    }
+
+    m_statistics.overloaded = m_overloaded;
+    ++(admitted ? m_statistics.admitted : m_statistics.shed);
+    return admitted;
+}
+
+void AdmissionController::recordRejectedConnection()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_statistics.rejectedConnections;
+}
+
+AdmissionStatistics AdmissionController::statistics() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_statistics;
+}
+
+CELL_NAMESPACE_END
@@ -0,0 +1,138 @@
+/*!
+ * @file        admission.hpp
+ * @brief       This file is part of the Cell Engine.
+ * @details     Queue-delay based admission control for the web server.
+ * @author      <a href='https://github.com/thecompez'>Kambiz Asadzadeh</a>
+ * @package     Genyleap
+ * @since       29 Apr 2023
+ * @copyright   Copyright (c) 2025 The Genyleap. All rights reserved.
+ * @license     https://github.com/genyleap/cell/blob/main/LICENSE.md
+ *
+ */
+
+#ifndef CELL_WEBSERVER_ADMISSION_HPP
+#define CELL_WEBSERVER_ADMISSION_HPP
+
+#ifdef __has_include
+# if __has_include("common.hpp")
+#   include "common.hpp"
+#else
+#   error "Cell's "common.hpp" was not found!"
+# endif
+#endif
+
+CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Network::WebServer)
+
+/**
+ * @brief Constants related to admission control.
+ */
+struct ADMISSION_CONSTANTS final {
+    __cell_static_const_constexpr std::chrono::milliseconds DEFAULT_TARGET      { 50 };     //!< A reasonable target to pass to setQueueDelayTarget().
+    __cell_static_const_constexpr std::chrono::milliseconds DEFAULT_INTERVAL    { 500 };    //!< Window over which the minimum delay is observed.
+    __cell_static_const_constexpr int RETRY_AFTER_SECONDS = 1;                              //!< Retry-After value sent with shed requests.
+};
+
+/**
+ * @brief Shedding class of a route.
+ */
+enum class RequestPriority : Types::u8
+{
+    Critical    =   0x0,    //!< Never shed (health checks, control endpoints).
+    Normal      =   0x1,    //!< Shed when its own queue delay exceeds the current CoDel timeout.
+    Sheddable   =   0x2     //!< Shed as soon as the queue is considered overloaded.
+};
+
+/**
+ * @brief Counters describing the admission decisions made so far.
+ */
+struct AdmissionStatistics final
+{
+    std::uint64_t admitted              {}; //!< Requests that were handled.
+    std::uint64_t shed                  {}; //!< Requests rejected because of queue delay.
+    std::uint64_t rejectedConnections   {}; //!< Connections refused because the connection limit was reached.
+    bool          overloaded            {}; //!< True while the standing queue delay is above the target.
+};
+
+/**
+ * @class AdmissionController
+ * @brief Decides whether a dequeued request is still worth serving.
+ *
+ * Follows CoDel: the minimum queueing delay seen during each interval tells whether a standing queue has
+ * built up. While it has, requests are only served if they waited less than the target; otherwise they may
+ * wait up to one interval. Shed requests get a fast 503 instead of adding to the backlog.
+ *
+ * Shedding is off until a target is set, so a server only answers 503 once it opts in.
+ *
+ * @note This class is marked with the "__cell_export" attribute, indicating
+ *       it is part of the "cell" module for exporting purposes.
+ */
+class __cell_export AdmissionController {
+public:
+    using RoutePriorities = std::vector<std::pair<std::string, RequestPriority>>;
+
+    /**
+     * @brief Constructs an AdmissionController with shedding disabled until setQueueDelayTarget() is called.
+     */
+    AdmissionController();
+
+    /**
+     * @brief Disable copy construction and assignment for a class.
+     */
+    CELL_DISABLE_COPY(AdmissionController)
+
+    /**
+     * @brief Sets the CoDel parameters.
+     * @param target The acceptable standing queue delay (zero disables shedding).
+     * @param interval The window over which the minimum delay is observed.
+     */
+    void setQueueDelayTarget(std::chrono::milliseconds target, std::chrono::milliseconds interval);
+
+    /**
+     * @brief Assigns a priority to a path and every path below it.
+     *
+     * Prefixes match whole path segments: "/api" covers "/api" and "/api/users" but not "/apix". Priorities
+     * are meant to be set up before the server starts; lookups then read the table without locking.
+     * @param pathPrefix The path prefix; the longest matching prefix wins.
+     * @param priority The priority of the matching routes.
+     */
+    void setRoutePriority(const std::string& pathPrefix, RequestPriority priority);
+
+    /**
+     * @brief Returns the priority of a request path.
+     * @param path The request path.
+     * @return The priority of the longest prefix matching on a segment boundary, Normal if none matches.
+     */
+    RequestPriority priorityOf(std::string_view path) const;
+
+    /**
+     * @brief Records the queue delay of a dequeued request and decides whether to serve it.
+     * @param queueDelay The time the request spent waiting in the event loop.
+     * @param priority The priority of the request.
+     * @return True if the request should be served, false if it should be shed.
+     */
+    bool admit(std::chrono::steady_clock::duration queueDelay, RequestPriority priority);
+
+    /**
+     * @brief Records a connection refused because of the connection limit.
+     */
+    void recordRejectedConnection();
+
+    /**
+     * @brief Returns the admission counters.
+     */
+    AdmissionStatistics statistics() const;
+
+private:
+    mutable std::mutex                                      m_mutex             {};
+    std::chrono::steady_clock::duration                     m_target            {};     //!< Zero disables shedding.
+    std::chrono::steady_clock::duration                     m_interval          { ADMISSION_CONSTANTS::DEFAULT_INTERVAL };
+    std::chrono::steady_clock::time_point                   m_intervalStart     {};     //!< Start of the current observation window.
+    std::chrono::steady_clock::duration                     m_minimumDelay      {};     //!< Minimum delay seen in the current window.
+    bool                                                    m_overloaded        {};     //!< Verdict of the previous window.
+    std::atomic<std::shared_ptr<const RoutePriorities>>    m_priorities        {};     //!< Prefixes sorted longest first; replaced whole, never edited.
+    AdmissionStatistics                                     m_statistics        {};
+};
+
+CELL_NAMESPACE_END
+
+#endif  // CELL_WEBSERVER_ADMISSION_HPP
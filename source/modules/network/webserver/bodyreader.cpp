@@ -0,0 +1,212 @@
+#if __has_include("bodyreader.hpp")
+#   include "bodyreader.hpp"
+#else
+#   error "Cell's bodyreader was not found!"
+#endif
+
+CELL_USING_NAMESPACE Cell;
+CELL_USING_NAMESPACE Cell::Types;
+
+CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Network::WebServer)
+
+BodyReader::BodyReader(ReadCallback source,
+                       std::string prefetched,
+                       Encoding encoding,
+                       std::uint64_t contentLength,
+                       std::uint64_t maxBodySize)
+    : m_source(std::move(source))
+    , m_buffer(std::move(prefetched))
+    , m_encoding(encoding)
+    , m_contentLength(contentLength)
+    , m_maxBodySize(maxBodySize)
+{
+    if (m_encoding == Encoding::ContentLength) {
+        m_remaining = m_contentLength;
+        m_finished = (m_remaining == 0);
+    } else if (m_encoding == Encoding::None) {
+        m_finished = true;
+    }
+}
+
+std::size_t BodyReader::read(char* data, std::size_t length)
+{
+    if (m_finished || length == 0) {
+        return 0;
+    }
+
+    if (m_encoding == Encoding::Chunked && m_remaining == 0) {
+        if (!beginChunk()) {
+            return 0;
+        }
+    }
+
+    const auto wanted = static_cast<std::size_t>(std::min<std::uint64_t>(length, m_remaining));
+    const auto received = readRaw(data, wanted);
+    if (received == 0) {
+        throw std::runtime_error("Connection closed before the request body was complete.");
+    }
+
+    m_remaining -= received;
+    account(received);
+
+    if (m_encoding == Encoding::ContentLength && m_remaining == 0) {
+        m_finished = true;
+    }
+    return received;
+}
+
+std::string BodyReader::readAll()
+{
+    std::string result;
+    if (m_encoding == Encoding::ContentLength) {
+        result.reserve(static_cast<std::size_t>(m_remaining));
+    }
+
+    std::array<char, BODY_READER_CONSTANTS::BUFFER_SIZE> chunk {};
+    while (const auto received = read(chunk.data(), chunk.size())) {
+        result.append(chunk.data(), received);
+    }
+    return result;
+}
+
+void BodyReader::discard()
+{
+    std::array<char, BODY_READER_CONSTANTS::BUFFER_SIZE> chunk {};
+    while (read(chunk.data(), chunk.size()) != 0) {}
+}
+
+bool BodyReader::finished() const
+{
+    return m_finished;
+}
+
+std::uint64_t BodyReader::bytesRead() const
+{
+    return m_bytesRead;
+}
+
+BodyReader::Encoding BodyReader::encoding() const
+{
+    return m_encoding;
+}
+
+std::optional<std::uint64_t> BodyReader::contentLength() const
+{
+    if (m_encoding == Encoding::ContentLength) {
+        return m_contentLength;
+    }
+    return std::nullopt;
+}
+
+std::size_t BodyReader::readRaw(char* data, std::size_t length)
+{
+    if (m_bufferOffset < m_buffer.size()) {
+        const auto available = std::min(length, m_buffer.size() - m_bufferOffset);
+        std::memcpy(data, m_buffer.data() + m_bufferOffset, available);
+        m_bufferOffset += available;
+        return available;
+    }
+
+    // Large reads go straight into the caller's buffer to avoid an extra copy.
+    if (length >= BODY_READER_CONSTANTS::BUFFER_SIZE) {
+        const auto received = m_source(data, length);
+        if (received < 0) {
+            throw std::runtime_error("Failed to read the request body from the connection.");
+        }
+        return static_cast<std::size_t>(received);
+    }
+
+    if (!fill()) {
+        return 0;
+    }
+    return readRaw(data, length);
+}
+
+bool BodyReader::fill()
+{
+    m_buffer.resize(BODY_READER_CONSTANTS::BUFFER_SIZE);
+    m_bufferOffset = 0;
+
+    const auto received = m_source(m_buffer.data(), m_buffer.size());
+    if (received < 0) {
+        m_buffer.clear();
+        throw std::runtime_error("Failed to read the request body from the connection.");
+    }
+
+    m_buffer.resize(static_cast<std::size_t>(received));
+    return received > 0;
+}
+
+std::string BodyReader::readLine()
+{
+    std::string line;
+    for (;;) {
+        if (m_bufferOffset >= m_buffer.size() && !fill()) {
+            throw std::runtime_error("Connection closed inside the chunked body framing.");
+        }
+
+        const auto begin = m_buffer.data() + m_bufferOffset;
+        const auto end = m_buffer.data() + m_buffer.size();
+        const auto newline = std::find(begin, end, '\n');
+
+        line.append(begin, newline);
+        m_bufferOffset += static_cast<std::size_t>(newline - begin);
+
+        if (line.size() > BODY_READER_CONSTANTS::MAX_LINE_LENGTH) {
+            throw std::runtime_error("Chunked body framing line is too long.");
+        }
+
+        if (newline != end) {
+            ++m_bufferOffset;
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            return line;
+        }
+    }
+}
+
+bool BodyReader::beginChunk()
+{
+    if (m_chunkOpen) {
+        if (!readLine().empty()) {
+            throw std::runtime_error("Malformed chunked body: missing CRLF after chunk data.");
+        }
+        m_chunkOpen = false;
+    }
+
+    const auto line = readLine();
+    const auto sizeEnd = line.find_first_of("; \t");
+    const auto sizeField = std::string_view(line).substr(0, sizeEnd);
+
+    std::uint64_t chunkSize {};
+    const auto [ptr, ec] = std::from_chars(sizeField.data(), sizeField.data() + sizeField.size(), chunkSize, 16);
+    if (sizeField.empty() || ec != std::errc() || ptr != sizeField.data() + sizeField.size()) {
+        throw std::runtime_error("Malformed chunked body: invalid chunk size.");
+    }
+
+    if (chunkSize == 0) {
+        // Trailer headers are not exposed; read them up to the terminating empty line.
+        while (!readLine().empty()) {}
+        m_finished = true;
+        return false;
+    }
+
+    if (m_maxBodySize > 0 && m_bytesRead + chunkSize > m_maxBodySize) {
+        throw BodyTooLargeError("Request body exceeds the maximum allowed size.");
+    }
+
+    m_remaining = chunkSize;
+    m_chunkOpen = true;
+    return true;
+}
+
+void BodyReader::account(std::size_t length)
+{
+    m_bytesRead += length;
+    if (m_maxBodySize > 0 && m_bytesRead > m_maxBodySize) {
+        throw BodyTooLargeError("Request body exceeds the maximum allowed size.");
+    }
+}
+
+CELL_NAMESPACE_END
@@ -0,0 +1,173 @@
+/*!
+ * @file        bodyreader.hpp
+ * @brief       This file is part of the Cell Engine.
+ * @details     Streaming HTTP request body reader for the web server.
+ * @author      <a href='https://github.com/thecompez'>Kambiz Asadzadeh</a>
+ * @package     Genyleap
+ * @since       29 Apr 2023
+ * @copyright   Copyright (c) 2025 The Genyleap. All rights reserved.
+ * @license     https://github.com/genyleap/cell/blob/main/LICENSE.md
+ *
+ */
+
+#ifndef CELL_WEBSERVER_BODY_READER_HPP
+#define CELL_WEBSERVER_BODY_READER_HPP
+
+#ifdef __has_include
+# if __has_include("common.hpp")
+#   include "common.hpp"
+#else
+#   error "Cell's "common.hpp" was not found!"
+# endif
+#endif
+
+CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Network::WebServer)
+
+/**
+ * @brief Constants related to request body streaming.
+ */
+struct BODY_READER_CONSTANTS final {
+    __cell_static_const_constexpr std::size_t BUFFER_SIZE       = 16384;    //!< Size of the internal read-ahead buffer.
+    __cell_static_const_constexpr std::size_t MAX_LINE_LENGTH   = 4096;     //!< Maximum length of a chunk-size or trailer line.
+};
+
+/**
+ * @brief Thrown when a request body exceeds the configured maximum request size.
+ */
+struct __cell_export BodyTooLargeError final : public std::length_error {
+    using std::length_error::length_error;
+};
+
+/**
+ * @class BodyReader
+ * @brief Pulls the body of an HTTP request from the connection on demand.
+ *
+ * The reader understands both `Content-Length` delimited and `Transfer-Encoding: chunked`
+ * bodies and hands the decoded payload to the caller piece by piece, so a handler never has
+ * to hold more than one buffer of the body in memory. Bytes that were already received together
+ * with the request head are consumed first, then the reader falls back to the connection.
+ *
+ * @note This class is marked with the "__cell_export" attribute, indicating
+ *       it is part of the "cell" module for exporting purposes.
+ */
+class __cell_export BodyReader {
+public:
+    /**
+     * @brief Reads raw bytes from the connection (recv or SSL_read).
+     * @return The number of bytes read, 0 when the peer closed the connection, negative on error.
+     */
+    using ReadCallback = std::function<std::int64_t(char* data, std::size_t length)>;
+
+    /**
+     * @brief The framing used by the request body.
+     */
+    enum class Encoding : Types::u8
+    {
+        None            =   0x0,    //!< The request has no body.
+        ContentLength   =   0x1,    //!< The body length is given by the Content-Length header.
+        Chunked         =   0x2     //!< The body uses chunked transfer encoding.
+    };
+
+    /**
+     * @brief Constructs a BodyReader.
+     * @param source The callback used to pull more bytes from the connection.
+     * @param prefetched Body bytes that were received together with the request head.
+     * @param encoding The framing of the body.
+     * @param contentLength The announced body length when the encoding is ContentLength.
+     * @param maxBodySize The maximum number of decoded body bytes accepted (0 means unlimited).
+     */
+    BodyReader(ReadCallback source,
+               std::string prefetched,
+               Encoding encoding,
+               std::uint64_t contentLength,
+               std::uint64_t maxBodySize);
+
+    /**
+     * @brief Disable copy construction and assignment for a class.
+     */
+    CELL_DISABLE_COPY(BodyReader)
+
+    /**
+     * @brief Reads up to length bytes of the decoded body.
+     * @param data The destination buffer.
+     * @param length The capacity of the destination buffer.
+     * @return The number of bytes written to data, 0 once the whole body has been read.
+     * @throws BodyTooLargeError If the body grows beyond the configured maximum size.
+     * @throws std::runtime_error If the connection fails or the body framing is malformed.
+     */
+    std::size_t read(char* data, std::size_t length);
+
+    /**
+     * @brief Reads the remaining body into a string.
+     * @return The remaining body.
+     */
+    std::string readAll();
+
+    /**
+     * @brief Reads and drops the remaining body.
+     */
+    void discard();
+
+    /**
+     * @brief Checks if the whole body has been consumed.
+     * @return True once the end of the body has been reached.
+     */
+    bool finished() const;
+
+    /**
+     * @brief Returns the number of decoded body bytes handed out so far.
+     */
+    std::uint64_t bytesRead() const;
+
+    /**
+     * @brief Returns the framing of the body.
+     */
+    Encoding encoding() const;
+
+    /**
+     * @brief Returns the announced length of the body, if known in advance.
+     */
+    std::optional<std::uint64_t> contentLength() const;
+
+private:
+    /**
+     * @brief Copies raw (still encoded) bytes from the read-ahead buffer or the connection.
+     */
+    std::size_t readRaw(char* data, std::size_t length);
+
+    /**
+     * @brief Refills the read-ahead buffer from the connection.
+     * @return False if the peer closed the connection.
+     */
+    bool fill();
+
+    /**
+     * @brief Reads a CRLF terminated line of the chunked framing.
+     */
+    std::string readLine();
+
+    /**
+     * @brief Starts the next chunk, returning false once the last chunk was seen.
+     */
+    bool beginChunk();
+
+    /**
+     * @brief Accounts for body bytes handed to the caller and enforces the size limit.
+     */
+    void account(std::size_t length);
+
+    ReadCallback    m_source            {};     //!< Connection read callback.
+    std::string     m_buffer            {};     //!< Read-ahead buffer.
+    std::size_t     m_bufferOffset      {};     //!< Consumed prefix of the read-ahead buffer.
+    Encoding        m_encoding          {};     //!< Body framing.
+    std::uint64_t   m_contentLength     {};     //!< Announced length (ContentLength only).
+    std::uint64_t   m_remaining         {};     //!< Bytes left in the body or the current chunk.
+    std::uint64_t   m_maxBodySize       {};     //!< Maximum accepted body size (0 means unlimited).
+    std::uint64_t   m_bytesRead         {};     //!< Decoded bytes handed out so far.
+    bool            m_chunkOpen         {};     //!< True while a chunk still needs its trailing CRLF.
+    bool            m_finished          {};     //!< True once the end of the body was reached.
+};
+
+CELL_NAMESPACE_END
+
+#endif  // CELL_WEBSERVER_BODY_READER_HPP
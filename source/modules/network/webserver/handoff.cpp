@@ -0,0 +1,195 @@
+#if __has_include("handoff.hpp")
+#   include "handoff.hpp"
+#else
+#   error "Cell's handoff was not found!"
+#endif
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+CELL_USING_NAMESPACE Cell;
+CELL_USING_NAMESPACE Cell::Types;
+
+CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Network::WebServer)
+
+namespace {
+
+bool makeAddress(const std::string& path, sockaddr_un& address)
+{
+    address = {};
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+bool waitReadable(SocketType socket, std::chrono::milliseconds timeout)
+{
+    pollfd descriptor { socket, POLLIN, 0 };
+    int result = 0;
+    do {
+        result = poll(&descriptor, 1, static_cast<int>(timeout.count()));
+    } while (result < 0 && errno == EINTR);
+    return result > 0 && (descriptor.revents & POLLIN);
+}
+
+}  // namespace
+
+SocketType ListenerHandoff::createChannel(const std::string& path)
+{
+    sockaddr_un address {};
+    if (!makeAddress(path, address)) {
+        return -1;
+    }
+
+    SocketType channel = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (channel < 0) {
+        return -1;
+    }
+    fcntl(channel, F_SETFD, FD_CLOEXEC);
+
+    ::unlink(path.c_str());
+    if (bind(channel, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || listen(channel, 1) < 0) {
+        close(channel);
+        return -1;
+    }
+
+    // Only the owner may pick up the listeners.
+    ::chmod(path.c_str(), S_IRUSR | S_IWUSR);
+    return channel;
+}
+
+SocketType ListenerHandoff::acceptChannel(SocketType channel, std::chrono::milliseconds timeout)
+{
+    if (!waitReadable(channel, timeout)) {
+        return -1;
+    }
+    SocketType connection = accept(channel, nullptr, nullptr);
+    if (connection >= 0) {
+        fcntl(connection, F_SETFD, FD_CLOEXEC);
+    }
+    return connection;
+}
+
+SocketType ListenerHandoff::connectChannel(const std::string& path)
+{
+    sockaddr_un address {};
+    if (!makeAddress(path, address)) {
+        return -1;
+    }
+
+    SocketType connection = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (connection < 0) {
+        return -1;
+    }
+    fcntl(connection, F_SETFD, FD_CLOEXEC);
+
+    if (connect(connection, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        close(connection);
+        return -1;
+    }
+    return connection;
+}
+
+bool ListenerHandoff::sendSockets(SocketType connection, const std::vector<SocketType>& sockets)
+{
+    if (sockets.empty() || sockets.size() > HANDOFF_CONSTANTS::MAX_SOCKETS) {
+        return false;
+    }
+
+    // The payload carries the descriptor count; the descriptors travel as ancillary data.
+    auto count = static_cast<std::uint32_t>(sockets.size());
+    iovec payload { &count, sizeof(count) };
+
+    std::array<char, CMSG_SPACE(sizeof(int) * HANDOFF_CONSTANTS::MAX_SOCKETS)> control {};
+    msghdr message {};
+    message.msg_iov = &payload;
+    message.msg_iovlen = 1;
+    message.msg_control = control.data();
+    message.msg_controllen = CMSG_SPACE(sizeof(int) * sockets.size());
+
+    cmsghdr* header = CMSG_FIRSTHDR(&message);
+    header->cmsg_level = SOL_SOCKET;
+    header->cmsg_type = SCM_RIGHTS;
+    header->cmsg_len = CMSG_LEN(sizeof(int) * sockets.size());
+    std::memcpy(CMSG_DATA(header), sockets.data(), sizeof(int) * sockets.size());
+
+    ssize_t sent = 0;
+    do {
+        sent = sendmsg(connection, &message, 0);
+    } while (sent < 0 && errno == EINTR);
+    return sent == static_cast<ssize_t>(sizeof(count));
+}
+
+std::vector<SocketType> ListenerHandoff::receiveSockets(SocketType connection)
+{
+    std::uint32_t count = 0;
+    iovec payload { &count, sizeof(count) };
+
+    std::array<char, CMSG_SPACE(sizeof(int) * HANDOFF_CONSTANTS::MAX_SOCKETS)> control {};
+    msghdr message {};
+    message.msg_iov = &payload;
+    message.msg_iovlen = 1;
+    message.msg_control = control.data();
+    message.msg_controllen = control.size();
+
+    ssize_t received = 0;
+    do {
+        received = recvmsg(connection, &message, 0);
+    } while (received < 0 && errno == EINTR);
+
+    std::vector<SocketType> sockets;
+    if (received != static_cast<ssize_t>(sizeof(count)) || (message.msg_flags & MSG_CTRUNC)) {
+        return sockets;
+    }
+
+    for (cmsghdr* header = CMSG_FIRSTHDR(&message); header != nullptr; header = CMSG_NXTHDR(&message, header)) {
+        if (header->cmsg_level != SOL_SOCKET || header->cmsg_type != SCM_RIGHTS) {
+            continue;
+        }
+        const auto descriptors = (header->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        for (std::size_t i = 0; i < descriptors; ++i) {
+            int descriptor = -1;
+            std::memcpy(&descriptor, CMSG_DATA(header) + i * sizeof(int), sizeof(int));
+            fcntl(descriptor, F_SETFD, FD_CLOEXEC);
+            sockets.push_back(descriptor);
+        }
+    }
+
+    if (sockets.size() != count) {
+        for (const auto socket : sockets) {
+            close(socket);
+        }
+        sockets.clear();
+    }
+    return sockets;
+}
+
+bool ListenerHandoff::sendReady(SocketType connection)
+{
+    const char ready = HANDOFF_CONSTANTS::READY;
+    return send(connection, &ready, sizeof(ready), MSG_NOSIGNAL) == sizeof(ready);
+}
+
+bool ListenerHandoff::waitReady(SocketType connection, std::chrono::milliseconds timeout)
+{
+    if (!waitReadable(connection, timeout)) {
+        return false;
+    }
+    char ready = 0;
+    return recv(connection, &ready, sizeof(ready), 0) == sizeof(ready) && ready == HANDOFF_CONSTANTS::READY;
+}
+
+OptionalString ListenerHandoff::inheritedChannelPath()
+{
+    const char* path = std::getenv(HANDOFF_CONSTANTS::ENVIRONMENT_VARIABLE.data());
+    if (path == nullptr || *path == '\0') {
+        return std::nullopt;
+    }
+    return std::string(path);
+}
+
+CELL_NAMESPACE_END
@@ -0,0 +1,108 @@
+/*!
+ * @file        handoff.hpp
+ * @brief       This file is part of the Cell Engine.
+ * @details     Listening socket handoff between web server processes.
+ * @author      <a href='https://github.com/thecompez'>Kambiz Asadzadeh</a>
+ * @package     Genyleap
+ * @since       29 Apr 2023
+ * @copyright   Copyright (c) 2025 The Genyleap. All rights reserved.
+ * @license     https://github.com/genyleap/cell/blob/main/LICENSE.md
+ *
+ */
+
+#ifndef CELL_WEBSERVER_HANDOFF_HPP
+#define CELL_WEBSERVER_HANDOFF_HPP
+
+#ifdef __has_include
+# if __has_include("common.hpp")
+#   include "common.hpp"
+#else
+#   error "Cell's "common.hpp" was not found!"
+# endif
+#endif
+
+CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Network::WebServer)
+
+/**
+ * @brief Constants related to listening socket handoff.
+ */
+struct HANDOFF_CONSTANTS final {
+    __cell_static_const_constexpr std::string_view ENVIRONMENT_VARIABLE = "CELL_UPGRADE_SOCKET"; //!< Tells a new process where to fetch its listeners.
+    __cell_static_const_constexpr std::size_t MAX_SOCKETS = 16;     //!< Maximum number of descriptors passed in one handoff.
+    __cell_static_const_constexpr char READY = 'R';                 //!< Byte sent by the new process once it accepts connections.
+};
+
+/**
+ * @class ListenerHandoff
+ * @brief Passes listening sockets to another process over a UNIX domain socket (SCM_RIGHTS).
+ *
+ * The running process creates a channel, starts the new binary with HANDOFF_CONSTANTS::ENVIRONMENT_VARIABLE
+ * pointing at it, and sends its listening sockets once the new process connects. Both processes share the
+ * same kernel listening queue, so no connection is refused while the old process drains.
+ *
+ * @note This class is marked with the "__cell_export" attribute, indicating
+ *       it is part of the "cell" module for exporting purposes.
+ */
+class __cell_export ListenerHandoff {
+public:
+    /**
+     * @brief Creates a listening UNIX domain socket at the given path, replacing a stale one.
+     * @param path The file system path of the channel.
+     * @return The channel socket, or -1 on failure.
+     */
+    static Types::SocketType createChannel(const std::string& path);
+
+    /**
+     * @brief Waits for the new process to connect to the channel.
+     * @param channel The channel created by createChannel().
+     * @param timeout How long to wait for the connection.
+     * @return The connected socket, or -1 on timeout or failure.
+     */
+    static Types::SocketType acceptChannel(Types::SocketType channel, std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Connects to the channel of the previous process.
+     * @param path The file system path of the channel.
+     * @return The connected socket, or -1 on failure.
+     */
+    static Types::SocketType connectChannel(const std::string& path);
+
+    /**
+     * @brief Sends descriptors over a connected channel.
+     * @param connection The connected channel socket.
+     * @param sockets The descriptors to pass (at most HANDOFF_CONSTANTS::MAX_SOCKETS).
+     * @return True if the descriptors were sent.
+     */
+    static bool sendSockets(Types::SocketType connection, const std::vector<Types::SocketType>& sockets);
+
+    /**
+     * @brief Receives descriptors sent with sendSockets().
+     * @param connection The connected channel socket.
+     * @return The received descriptors, empty on failure.
+     */
+    static std::vector<Types::SocketType> receiveSockets(Types::SocketType connection);
+
+    /**
+     * @brief Tells the previous process that the listeners are in use.
+     * @param connection The connected channel socket.
+     * @return True if the notification was sent.
+     */
+    static bool sendReady(Types::SocketType connection);
+
+    /**
+     * @brief Waits until the new process reports that it accepts connections.
+     * @param connection The connected channel socket.
+     * @param timeout How long to wait.
+     * @return True if the new process reported readiness.
+     */
+    static bool waitReady(Types::SocketType connection, std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Returns the channel path handed down by the previous process, if any.
+     */
+    static Types::OptionalString inheritedChannelPath();
+};
+
+CELL_NAMESPACE_END
+
+#endif  // CELL_WEBSERVER_HANDOFF_HPP
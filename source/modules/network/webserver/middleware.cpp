@@ -0,0 +1,185 @@
+#if __has_include("middleware.hpp")
+#   include "middleware.hpp"
+#else
+#   error "Cell's middleware was not found!"
+#endif
+
+CELL_USING_NAMESPACE Cell;
+CELL_USING_NAMESPACE Cell::Types;
+
+CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Network::WebServer)
+
+namespace {
+
+/**
+ * @brief Adapts a std::function to the typed middleware interface for a single phase.
+ */
+struct PreRouteFunction final {
+    std::function<MiddlewareAction(MiddlewareContext&)> function;
+    MiddlewareAction preRoute(MiddlewareContext& context) { return function(context); }
+};
+
+struct PostRouteFunction final {
+    std::function<void(MiddlewareContext&)> function;
+    void postRoute(MiddlewareContext& context) { function(context); }
+};
+
+struct OnErrorFunction final {
+    std::function<void(MiddlewareContext&)> function;
+    void onError(MiddlewareContext& context) { function(context); }
+};
+
+}  // namespace
+
+void MiddlewarePipeline::addPreRoute(const std::string& name, std::function<MiddlewareAction(MiddlewareContext&)> middleware)
+{
+    add(name, PreRouteFunction { std::move(middleware) });
+}
+
+void MiddlewarePipeline::addPostRoute(const std::string& name, std::function<void(MiddlewareContext&)> middleware)
+{
+    add(name, PostRouteFunction { std::move(middleware) });
+}
+
+void MiddlewarePipeline::addOnError(const std::string& name, std::function<void(MiddlewareContext&)> middleware)
+{
+    add(name, OnErrorFunction { std::move(middleware) });
+}
+
+void MiddlewarePipeline::registerStage(const std::string& name, MiddlewarePhase phase, std::shared_ptr<void> object, Invoker invoker, AroundInvoker around)
+{
+    m_registered.push_back(Stage {
+        .name       = name,
+        .phase      = phase,
+        .invoker    = invoker,
+        .around     = around,
+        .object     = std::move(object),
+        .counters   = nullptr
+    });
+}
+
+void MiddlewarePipeline::append(const MiddlewarePipeline& other)
+{
+    for (const auto& stage : other.m_registered) {
+        registerStage(stage.name, stage.phase, stage.object, stage.invoker, stage.around);
+    }
+}
+
+void MiddlewarePipeline::clear()
+{
+    m_registered.clear();
+    m_preRoute.clear();
+    m_postRoute.clear();
+    m_onError.clear();
+    m_around.clear();
+    m_counters.reset();
+}
+
+void MiddlewarePipeline::compile()
+{
+    m_preRoute.clear();
+    m_postRoute.clear();
+    m_onError.clear();
+    m_around.clear();
+    m_counters = std::make_unique<StageCounters[]>(m_registered.size());
+
+    for (std::size_t i = 0; i < m_registered.size(); ++i) {
+        Stage stage = m_registered[i];
+        stage.counters = &m_counters[i];
+        switch (stage.phase) {
+        case MiddlewarePhase::PreRoute:
+            m_preRoute.push_back(std::move(stage));
+            break;
+        case MiddlewarePhase::PostRoute:
+            m_postRoute.push_back(std::move(stage));
+            break;
+        case MiddlewarePhase::OnError:
+            m_onError.push_back(std::move(stage));
+            break;
+        case MiddlewarePhase::Around:
+            m_around.push_back(std::move(stage));
+            break;
+        }
+    }
+}
+
+bool MiddlewarePipeline::empty() const
+{
+    return m_registered.empty();
+}
+
+MiddlewareAction MiddlewarePipeline::invoke(Stage& stage, MiddlewareContext& context)
+{
+    const auto started = std::chrono::steady_clock::now();
+    const auto action = stage.invoker(stage.object.get(), context);
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - started);
+
+    stage.counters->calls.fetch_add(1, std::memory_order_relaxed);
+    stage.counters->nanoseconds.fetch_add(static_cast<std::uint64_t>(elapsed.count()), std::memory_order_relaxed);
+    return action;
+}
+
+void MiddlewarePipeline::runAround(std::size_t index, MiddlewareContext& context, const std::function<void(MiddlewareContext&)>& terminal)
+{
+    if (index == m_around.size()) {
+        terminal(context);
+        return;
+    }
+
+    auto& stage = m_around[index];
+    bool proceeded = false;
+    const MiddlewareNext next = [&] {
+        proceeded = true;
+        runAround(index + 1, context, terminal);
+    };
+
+    const auto started = std::chrono::steady_clock::now();
+    stage.around(stage.object.get(), context, next);
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - started);
+
+    stage.counters->calls.fetch_add(1, std::memory_order_relaxed);
+    stage.counters->nanoseconds.fetch_add(static_cast<std::uint64_t>(elapsed.count()), std::memory_order_relaxed);
+    if (!proceeded) {
+        stage.counters->shortCircuits.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void MiddlewarePipeline::handleError(MiddlewareContext& context, const std::exception& error)
+{
+    context.error = &error;
+    context.response = Response();
+    context.response.setStatusCode(500);
+    context.response.setContentType("text/plain");
+    context.response.setContent("Internal server error.");
+
+    for (auto& stage : m_onError) {
+        try {
+            invoke(stage, context);
+        } catch (const std::exception&) {
+            // An error handler that fails leaves the previous response in place.
+        }
+    }
+    context.error = nullptr;
+}
+
+std::vector<MiddlewareMetrics> MiddlewarePipeline::metrics() const
+{
+    std::vector<MiddlewareMetrics> result;
+    if (!m_counters) {
+        return result;
+    }
+    result.reserve(m_registered.size());
+    for (std::size_t i = 0; i < m_registered.size(); ++i) {
+        const auto& counters = m_counters[i];
+        result.push_back(MiddlewareMetrics {
+            .name           = m_registered[i].name,
+            .phase          = m_registered[i].phase,
+            .calls          = counters.calls.load(std::memory_order_relaxed),
+            .shortCircuits  = counters.shortCircuits.load(std::memory_order_relaxed),
+            .totalTime      = std::chrono::nanoseconds(counters.nanoseconds.load(std::memory_order_relaxed))
+        });
+    }
+    return result;
+}
+
+CELL_NAMESPACE_END
@@ -0,0 +1,291 @@
+/*!
+ * @file        middleware.hpp
+ * @brief       This file is part of the Cell Engine.
+ * @details     Compiled middleware pipeline for the web server.
+ * @author      <a href='https://github.com/thecompez'>Kambiz Asadzadeh</a>
+ * @package     Genyleap
+ * @since       29 Apr 2023
+ * @copyright   Copyright (c) 2025 The Genyleap. All rights reserved.
+ * @license     https://github.com/genyleap/cell/blob/main/LICENSE.md
+ *
+ */
+
+#ifndef CELL_WEBSERVER_MIDDLEWARE_HPP
+#define CELL_WEBSERVER_MIDDLEWARE_HPP
+
+#ifdef __has_include
+# if __has_include("request.hpp")
+#   include "request.hpp"
+#else
+#   error "Cell's "request.hpp" was not found!"
+# endif
+#endif
+
+#ifdef __has_include
+# if __has_include("response.hpp")
+#   include "response.hpp"
+#else
+#   error "Cell's "response.hpp" was not found!"
+# endif
+#endif
+
+CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Network::WebServer)
+
+class Router;
+
+/**
+ * @brief The point of the request lifecycle at which a middleware runs.
+ */
+enum class MiddlewarePhase : Types::u8
+{
+    PreRoute    =   0x0,    //!< Before the handler; may answer the request itself.
+    PostRoute   =   0x1,    //!< After the handler (or a short-circuit) produced the response.
+    OnError     =   0x2,    //!< When the handler or a middleware threw.
+    Around      =   0x3     //!< Around the handler; sees and may change the response it produced.
+};
+
+/**
+ * @brief What a pre-route middleware wants to happen next.
+ */
+enum class MiddlewareAction : Types::u8
+{
+    Continue    =   0x0,    //!< Run the next middleware and eventually the handler.
+    Respond     =   0x1     //!< Skip the handler; the response in the context is sent as is.
+};
+
+/**
+ * @brief State shared by the middlewares of a single request.
+ */
+struct MiddlewareContext final
+{
+    Request&                request;                //!< The request being handled.
+    Response&               response;               //!< The response being built.
+    std::string_view        clientAddress   {};     //!< The IP address of the client.
+    const Router*           router          {};     //!< The router that handled the request, if it reached one.
+    const std::exception*   error           {};     //!< The exception being handled (OnError only).
+};
+
+/**
+ * @brief Runs the rest of the chain (the inner around stages and the handler) from an around stage.
+ *
+ * The response it produced is in the context when the call returns.
+ */
+using MiddlewareNext = std::function<void()>;
+
+/**
+ * @brief Per-middleware counters.
+ */
+struct MiddlewareMetrics final
+{
+    std::string                 name            {}; //!< The name given at registration.
+    MiddlewarePhase             phase           {}; //!< The phase the middleware runs in.
+    std::uint64_t               calls           {}; //!< Number of invocations.
+    std::uint64_t               shortCircuits   {}; //!< Number of times it answered the request itself.
+    std::chrono::nanoseconds    totalTime       {}; //!< Time spent inside the middleware.
+};
+
+/**
+ * @brief A middleware type whose phases are known at compile time.
+ *
+ * Any of the following members may be provided:
+ * - `MiddlewareAction preRoute(MiddlewareContext&)`
+ * - `void postRoute(MiddlewareContext&)`
+ * - `void onError(MiddlewareContext&)`
+ * - `void around(MiddlewareContext&, const MiddlewareNext&)`
+ */
+template <typename T>
+concept TypedMiddleware = requires(T& middleware, MiddlewareContext& context) {
+    { middleware.preRoute(context) } -> std::same_as<MiddlewareAction>;
+} || requires(T& middleware, MiddlewareContext& context) {
+    middleware.postRoute(context);
+} || requires(T& middleware, MiddlewareContext& context) {
+    middleware.onError(context);
+} || requires(T& middleware, MiddlewareContext& context, const MiddlewareNext& next) {
+    middleware.around(context, next);
+};
+
+/**
+ * @class MiddlewarePipeline
+ * @brief Ordered pre-route, post-route and on-error middleware, compiled into flat arrays.
+ *
+ * Middlewares are registered before the server starts; compile() then lays them out per phase in
+ * registration order. Each stage is a function pointer plus an object pointer, so running the pipeline
+ * is a loop over an array rather than a chain of nested std::function calls.
+ *
+ * @note This class is marked with the "__cell_export" attribute, indicating
+ *       it is part of the "cell" module for exporting purposes.
+ */
+class __cell_export MiddlewarePipeline {
+public:
+    MiddlewarePipeline() = default;
+
+    /**
+     * @brief Disable copy construction and assignment for a class.
+     */
+    CELL_DISABLE_COPY(MiddlewarePipeline)
+
+    /**
+     * @brief Registers a middleware type for every phase it implements.
+     * @param name The name reported in the metrics.
+     * @param middleware The middleware object (moved into the pipeline).
+     */
+    template <TypedMiddleware T>
+    void add(const std::string& name, T middleware)
+    {
+        auto object = std::make_shared<T>(std::move(middleware));
+        if constexpr (requires(T& m, MiddlewareContext& c) { m.preRoute(c); }) {
+            registerStage(name, MiddlewarePhase::PreRoute, object, [](void* self, MiddlewareContext& context) {
+                return static_cast<T*>(self)->preRoute(context);
+            });
+        }
+        if constexpr (requires(T& m, MiddlewareContext& c) { m.postRoute(c); }) {
+            registerStage(name, MiddlewarePhase::PostRoute, object, [](void* self, MiddlewareContext& context) {
+                static_cast<T*>(self)->postRoute(context);
+                return MiddlewareAction::Continue;
+            });
+        }
+        if constexpr (requires(T& m, MiddlewareContext& c) { m.onError(c); }) {
+            registerStage(name, MiddlewarePhase::OnError, object, [](void* self, MiddlewareContext& context) {
+                static_cast<T*>(self)->onError(context);
+                return MiddlewareAction::Continue;
+            });
+        }
+        if constexpr (requires(T& m, MiddlewareContext& c, const MiddlewareNext& n) { m.around(c, n); }) {
+            registerStage(name, MiddlewarePhase::Around, object, nullptr, [](void* self, MiddlewareContext& context, const MiddlewareNext& next) {
+                static_cast<T*>(self)->around(context, next);
+            });
+        }
+    }
+
+    /**
+     * @brief Registers a pre-route function.
+     * @param name The name reported in the metrics.
+     * @param middleware Returns MiddlewareAction::Respond to answer the request without the handler.
+     */
+    void addPreRoute(const std::string& name, std::function<MiddlewareAction(MiddlewareContext&)> middleware);
+
+    /**
+     * @brief Registers a post-route function.
+     * @param name The name reported in the metrics.
+     * @param middleware Inspects or rewrites the response.
+     */
+    void addPostRoute(const std::string& name, std::function<void(MiddlewareContext&)> middleware);
+
+    /**
+     * @brief Registers an on-error function.
+     * @param name The name reported in the metrics.
+     * @param middleware Turns the error in the context into a response.
+     */
+    void addOnError(const std::string& name, std::function<void(MiddlewareContext&)> middleware);
+
+    /**
+     * @brief Appends the middlewares registered in another pipeline, sharing their objects.
+     * @param other The pipeline to copy the registrations from.
+     */
+    void append(const MiddlewarePipeline& other);
+
+    /**
+     * @brief Removes every registered and compiled middleware.
+     */
+    void clear();
+
+    /**
+     * @brief Lays the registered middlewares out per phase; called when the server starts.
+     */
+    void compile();
+
+    /**
+     * @brief Checks whether any middleware is registered.
+     */
+    bool empty() const;
+
+    /**
+     * @brief Runs the pipeline around a terminal handler.
+     *
+     * Pre-route middlewares run in order until one responds; the terminal runs only if none did, wrapped
+     * by the around middlewares (the first registered is the outermost). Post-route middlewares always run. If anything throws, the response is reset to a 500 and the
+     * on-error middlewares get a chance to replace it.
+     * @param context The request context.
+     * @param terminal Produces the response (routing, static files).
+     */
+    template <typename Terminal>
+    void run(MiddlewareContext& context, Terminal&& terminal)
+    {
+        try {
+            bool answered = false;
+            for (auto& stage : m_preRoute) {
+                if (invoke(stage, context) == MiddlewareAction::Respond) {
+                    stage.counters->shortCircuits.fetch_add(1, std::memory_order_relaxed);
+                    answered = true;
+                    break;
+                }
+            }
+            if (!answered) {
+                if (m_around.empty()) {
+                    terminal(context);
+                } else {
+                    runAround(0, context, [&terminal](MiddlewareContext& ctx) { terminal(ctx); });
+                }
+            }
+            for (auto& stage : m_postRoute) {
+                invoke(stage, context);
+            }
+        } catch (const std::exception& e) {
+            handleError(context, e);
+        }
+    }
+
+    /**
+     * @brief Returns a snapshot of the per-middleware counters.
+     */
+    std::vector<MiddlewareMetrics> metrics() const;
+
+private:
+    using Invoker = MiddlewareAction (*)(void* self, MiddlewareContext& context);
+    using AroundInvoker = void (*)(void* self, MiddlewareContext& context, const MiddlewareNext& next);
+
+    /**
+     * @brief Counters of a compiled stage.
+     */
+    struct StageCounters final {
+        std::atomic<std::uint64_t> calls            {};
+        std::atomic<std::uint64_t> shortCircuits    {};
+        std::atomic<std::uint64_t> nanoseconds      {};
+    };
+
+    /**
+     * @brief A registered middleware for one phase.
+     */
+    struct Stage final {
+        std::string             name        {};
+        MiddlewarePhase         phase       {};
+        Invoker                 invoker     {};
+        AroundInvoker           around      {};
+        std::shared_ptr<void>   object      {};
+        StageCounters*          counters    {};
+    };
+
+    void registerStage(const std::string& name, MiddlewarePhase phase, std::shared_ptr<void> object, Invoker invoker, AroundInvoker around = nullptr);
+
+    MiddlewareAction invoke(Stage& stage, MiddlewareContext& context);
+
+    /**
+     * @brief Runs the around stages from index on, with the terminal innermost.
+     *
+     * The time recorded for an around stage includes the stages it wraps.
+     */
+    void runAround(std::size_t index, MiddlewareContext& context, const std::function<void(MiddlewareContext&)>& terminal);
+
+    void handleError(MiddlewareContext& context, const std::exception& error);
+
+    std::vector<Stage>                  m_registered    {};     //!< Registration order.
+    std::vector<Stage>                  m_preRoute      {};     //!< Compiled pre-route stages.
+    std::vector<Stage>                  m_postRoute     {};     //!< Compiled post-route stages.
+    std::vector<Stage>                  m_onError       {};     //!< Compiled on-error stages.
+    std::vector<Stage>                  m_around        {};     //!< Compiled around stages, outermost first.
+    std::unique_ptr<StageCounters[]>    m_counters      {};     //!< One entry per registered stage.
+};
+
+CELL_NAMESPACE_END
+
+#endif  // CELL_WEBSERVER_MIDDLEWARE_HPP
@@ -0,0 +1,291 @@
+#if __has_include("multipart.hpp")
+#   include "multipart.hpp"
+#else
+#   error "Cell's multipart was not found!"
+#endif
+
+#include <fcntl.h>
+#include <unistd.h>
+
+CELL_USING_NAMESPACE Cell;
+CELL_USING_NAMESPACE Cell::Types;
+
+CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Network::WebServer)
+
+namespace {
+
+bool equalsIgnoreCase(std::string_view lhs, std::string_view rhs)
+{
+    return lhs.size() == rhs.size()
+           && std::equal(lhs.begin(), lhs.end(), rhs.begin(), [](unsigned char a, unsigned char b) {
+                  return std::tolower(a) == std::tolower(b);
+              });
+}
+
+std::string_view trim(std::string_view value)
+{
+    const auto first = value.find_first_not_of(" \t");
+    if (first == std::string_view::npos) {
+        return {};
+    }
+    const auto last = value.find_last_not_of(" \t");
+    return value.substr(first, last - first + 1);
+}
+
+/**
+ * @brief Returns a parameter of a header value such as `form-data; name="a"; filename="b"`.
+ */
+std::optional<std::string> headerParameter(std::string_view value, std::string_view key)
+{
+    std::size_t position = value.find(';');
+    while (position != std::string_view::npos) {
+        const auto next = value.find(';', position + 1);
+        const auto token = trim(value.substr(position + 1, next == std::string_view::npos ? std::string_view::npos : next - position - 1));
+        const auto equals = token.find('=');
+        if (equals != std::string_view::npos && equalsIgnoreCase(trim(token.substr(0, equals)), key)) {
+            auto parameter = trim(token.substr(equals + 1));
+            if (parameter.size() >= 2 && parameter.front() == '"' && parameter.back() == '"') {
+                parameter = parameter.substr(1, parameter.size() - 2);
+            }
+            return std::string(parameter);
+        }
+        position = next;
+    }
+    return std::nullopt;
+}
+
+}  // namespace
+
+MultipartParser::MultipartParser(const std::string& boundary, const std::filesystem::path& uploadDirectory)
+    : m_delimiter("\r\n--" + boundary)
+    , m_uploadDirectory(uploadDirectory.empty() ? std::filesystem::temp_directory_path() : uploadDirectory)
+    , m_pending("\r\n") // Lets the first boundary match the same delimiter as the following ones.
+{
+    if (boundary.empty() || boundary.size() > 70) {
+        throw std::invalid_argument("Invalid multipart boundary.");
+    }
+}
+
+MultipartParser::~MultipartParser()
+{
+    closeFile();
+    for (const auto& file : m_files) {
+        std::error_code ec;
+        std::filesystem::remove(file.temporaryPath, ec);
+    }
+}
+
+OptionalString MultipartParser::boundaryFromContentType(std::string_view contentType)
+{
+    const auto separator = contentType.find(';');
+    if (!equalsIgnoreCase(trim(contentType.substr(0, separator)), "multipart/form-data")) {
+        return std::nullopt;
+    }
+    auto boundary = headerParameter(contentType, "boundary");
+    if (!boundary || boundary->empty()) {
+        return std::nullopt;
+    }
+    return boundary;
+}
+
+void MultipartParser::feed(std::string_view data)
+{
+    m_pending.append(data);
+
+    for (;;) {
+        switch (m_state) {
+        case State::Preamble: {
+            const auto position = m_pending.find(m_delimiter);
+            if (position == std::string::npos) {
+                if (m_pending.size() >= m_delimiter.size()) {
+                    m_pending.erase(0, m_pending.size() - m_delimiter.size() + 1);
+                }
+                return;
+            }
+            m_pending.erase(0, position + m_delimiter.size());
+            m_state = State::AfterBoundary;
+            break;
+        }
+        case State::AfterBoundary: {
+            if (m_pending.size() < 2) {
+                return;
+            }
+            if (m_pending.compare(0, 2, "--") == 0) {
+                m_pending.clear();
+                m_state = State::Done;
+                return;
+            }
+            if (m_pending.compare(0, 2, "\r\n") != 0) {
+                throw std::runtime_error("Malformed multipart body: unexpected data after boundary.");
+            }
+            m_pending.erase(0, 2);
+            m_state = State::Headers;
+            break;
+        }
+        case State::Headers: {
+            if (m_pending.size() >= 2 && m_pending.compare(0, 2, "\r\n") == 0) {
+                beginPart({});
+                m_pending.erase(0, 2);
+                m_state = State::Body;
+                break;
+            }
+            const auto position = m_pending.find("\r\n\r\n");
+            if (position == std::string::npos) {
+                if (m_pending.size() > MULTIPART_CONSTANTS::MAX_PART_HEADER_SIZE) {
+                    throw std::runtime_error("Malformed multipart body: part headers are too large.");
+                }
+                return;
+            }
+            beginPart(std::string_view(m_pending).substr(0, position));
+            m_pending.erase(0, position + 4);
+            m_state = State::Body;
+            break;
+        }
+        case State::Body: {
+            const auto position = m_pending.find(m_delimiter);
+            if (position == std::string::npos) {
+                // Keep enough bytes to recognise a delimiter split across two pieces.
+                const auto keep = m_delimiter.size() - 1;
+                if (m_pending.size() > keep) {
+                    const auto ready = m_pending.size() - keep;
+                    writePart(std::string_view(m_pending).substr(0, ready));
+                    m_pending.erase(0, ready);
+                }
+                return;
+            }
+            writePart(std::string_view(m_pending).substr(0, position));
+            endPart();
+            m_pending.erase(0, position + m_delimiter.size());
+            m_state = State::AfterBoundary;
+            break;
+        }
+        case State::Done:
+            // The epilogue is ignored.
+            m_pending.clear();
+            return;
+        }
+    }
+}
+
+void MultipartParser::finish()
+{
+    if (m_state != State::Done) {
+        throw std::runtime_error("Multipart body ended before the closing boundary.");
+    }
+}
+
+UploadedFiles MultipartParser::takeFiles()
+{
+    return std::exchange(m_files, {});
+}
+
+const std::unordered_map<std::string, std::string>& MultipartParser::fields() const
+{
+    return m_fields;
+}
+
+void MultipartParser::beginPart(std::string_view headerBlock)
+{
+    if (++m_partCount > MULTIPART_CONSTANTS::MAX_PARTS) {
+        throw std::runtime_error("Multipart body contains too many parts.");
+    }
+
+    std::string disposition;
+    std::string contentType = "text/plain";
+
+    std::size_t lineStart = 0;
+    while (lineStart < headerBlock.size()) {
+        auto lineEnd = headerBlock.find("\r\n", lineStart);
+        if (lineEnd == std::string_view::npos) {
+            lineEnd = headerBlock.size();
+        }
+        const auto line = headerBlock.substr(lineStart, lineEnd - lineStart);
+        const auto colon = line.find(':');
+        if (colon != std::string_view::npos) {
+            const auto name = trim(line.substr(0, colon));
+            const auto value = trim(line.substr(colon + 1));
+            if (equalsIgnoreCase(name, "Content-Disposition")) {
+                disposition = value;
+            } else if (equalsIgnoreCase(name, "Content-Type")) {
+                contentType = value;
+            }
+        }
+        lineStart = lineEnd + 2;
+    }
+
+    m_fieldName = headerParameter(disposition, "name").value_or(std::string());
+    m_fieldValue.clear();
+
+    auto fileName = headerParameter(disposition, "filename").value_or(std::string());
+    // Some clients send the full client-side path; keep only the last component.
+    if (const auto slash = fileName.find_last_of("/\\"); slash != std::string::npos) {
+        fileName.erase(0, slash + 1);
+    }
+
+    m_isFile = !fileName.empty();
+    if (!m_isFile) {
+        return;
+    }
+
+    auto pattern = (m_uploadDirectory / (std::string(MULTIPART_CONSTANTS::TEMP_FILE_PREFIX) + "XXXXXX")).string();
+    m_fileDescriptor = ::mkstemp(pattern.data());
+    if (m_fileDescriptor < 0) {
+        throw std::runtime_error("Failed to create a temporary file for an uploaded file.");
+    }
+
+    m_files.push_back(UploadedFile {
+        .fieldName      = m_fieldName,
+        .fileName       = std::move(fileName),
+        .contentType    = std::move(contentType),
+        .temporaryPath  = std::move(pattern),
+        .size           = 0
+    });
+}
+
+void MultipartParser::writePart(std::string_view data)
+{
+    if (data.empty()) {
+        return;
+    }
+
+    if (!m_isFile) {
+        if (m_fieldValue.size() + data.size() > MULTIPART_CONSTANTS::MAX_FIELD_SIZE) {
+            throw std::runtime_error("Multipart form field is too large.");
+        }
+        m_fieldValue.append(data);
+        return;
+    }
+
+    while (!data.empty()) {
+        const auto written = ::write(m_fileDescriptor, data.data(), data.size());
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("Failed to write an uploaded file to disk.");
+        }
+        data.remove_prefix(static_cast<std::size_t>(written));
+        m_files.back().size += static_cast<std::uint64_t>(written);
+    }
+}
+
+void MultipartParser::endPart()
+{
+    if (m_isFile) {
+        closeFile();
+    } else if (!m_fieldName.empty()) {
+        m_fields[m_fieldName] = std::move(m_fieldValue);
+    }
+    m_fieldValue.clear();
+    m_isFile = false;
+}
+
+void MultipartParser::closeFile()
+{
+    if (m_fileDescriptor >= 0) {
+        ::close(m_fileDescriptor);
+        m_fileDescriptor = -1;
+    }
+}
+
+CELL_NAMESPACE_END
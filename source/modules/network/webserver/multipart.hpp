@@ -0,0 +1,158 @@
+/*!
+ * @file        multipart.hpp
+ * @brief       This file is part of the Cell Engine.
+ * @details     Streaming multipart/form-data parser that spools uploaded files to disk.
+ * @author      <a href='https://github.com/thecompez'>Kambiz Asadzadeh</a>
+ * @package     Genyleap
+ * @since       29 Apr 2023
+ * @copyright   Copyright (c) 2025 The Genyleap. All rights reserved.
+ * @license     https://github.com/genyleap/cell/blob/main/LICENSE.md
+ *
+ */
+
+#ifndef CELL_WEBSERVER_MULTIPART_HPP
+#define CELL_WEBSERVER_MULTIPART_HPP
+
+#ifdef __has_include
+# if __has_include("common.hpp")
+#   include "common.hpp"
+#else
+#   error "Cell's "common.hpp" was not found!"
+# endif
+#endif
+
+CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Network::WebServer)
+
+/**
+ * @brief Constants related to multipart parsing.
+ */
+struct MULTIPART_CONSTANTS final {
+    __cell_static_const_constexpr std::size_t MAX_PART_HEADER_SIZE  = 8192;         //!< Maximum size of the header block of a single part.
+    __cell_static_const_constexpr std::size_t MAX_FIELD_SIZE        = 1048576;      //!< Maximum size of a non-file field kept in memory.
+    __cell_static_const_constexpr std::size_t MAX_PARTS             = 1024;         //!< Maximum number of parts in a single body.
+    __cell_static_const_constexpr std::string_view TEMP_FILE_PREFIX = "cell-upload-"; //!< Prefix of spooled upload files.
+};
+
+/**
+ * @brief Describes a file received in a multipart/form-data body.
+ */
+struct UploadedFile final
+{
+    std::string     fieldName       {}; //!< The form field name of the part.
+    std::string     fileName        {}; //!< The file name sent by the client.
+    std::string     contentType     {}; //!< The media type of the part.
+    std::string     temporaryPath   {}; //!< The path of the spooled file on disk.
+    std::uint64_t   size            {}; //!< The number of bytes written to the file.
+};
+
+using UploadedFiles = std::vector<UploadedFile>;
+
+/**
+ * @class MultipartParser
+ * @brief Incremental multipart/form-data parser.
+ *
+ * The parser is fed the request body in arbitrary pieces and never keeps more than one piece
+ * (plus the boundary length) in memory. File parts are written straight to temporary files,
+ * plain fields are kept in memory up to MULTIPART_CONSTANTS::MAX_FIELD_SIZE.
+ *
+ * Files that were not handed out through takeFiles() are removed when the parser is destroyed.
+ *
+ * @note This class is marked with the "__cell_export" attribute, indicating
+ *       it is part of the "cell" module for exporting purposes.
+ */
+class __cell_export MultipartParser {
+public:
+    /**
+     * @brief Constructs a MultipartParser.
+     * @param boundary The boundary taken from the Content-Type header.
+     * @param uploadDirectory The directory used for spooled files (defaults to the system temp directory).
+     */
+    explicit MultipartParser(const std::string& boundary, const std::filesystem::path& uploadDirectory = {});
+
+    /**
+     * @brief Destroys the parser and removes files that were not taken.
+     */
+    ~MultipartParser();
+
+    /**
+     * @brief Disable copy construction and assignment for a class.
+     */
+    CELL_DISABLE_COPY(MultipartParser)
+
+    /**
+     * @brief Extracts the boundary parameter from a multipart Content-Type value.
+     * @param contentType The Content-Type header value.
+     * @return The boundary, or std::nullopt if the value is not multipart/form-data.
+     */
+    static Types::OptionalString boundaryFromContentType(std::string_view contentType);
+
+    /**
+     * @brief Feeds the next piece of the body to the parser.
+     * @param data The body bytes.
+     * @throws std::runtime_error If the body is malformed or a file cannot be written.
+     */
+    void feed(std::string_view data);
+
+    /**
+     * @brief Signals the end of the body.
+     * @throws std::runtime_error If the closing boundary was not seen.
+     */
+    void finish();
+
+    /**
+     * @brief Hands over ownership of the spooled files.
+     * @return The files received so far.
+     */
+    UploadedFiles takeFiles();
+
+    /**
+     * @brief Returns the non-file fields received so far.
+     */
+    const std::unordered_map<std::string, std::string>& fields() const;
+
+private:
+    enum class State : Types::u8
+    {
+        Preamble,       //!< Looking for the first boundary.
+        AfterBoundary,  //!< Waiting for CRLF (next part) or "--" (end of body).
+        Headers,        //!< Reading the header block of a part.
+        Body,           //!< Reading the content of a part.
+        Done            //!< The closing boundary has been seen.
+    };
+
+    /**
+     * @brief Parses the header block of a part and opens its destination.
+     */
+    void beginPart(std::string_view headerBlock);
+
+    /**
+     * @brief Appends content to the current part.
+     */
+    void writePart(std::string_view data);
+
+    /**
+     * @brief Completes the current part.
+     */
+    void endPart();
+
+    /**
+     * @brief Closes the open spool file, if any.
+     */
+    void closeFile();
+
+    std::string                                     m_delimiter     {};     //!< "\r\n--" followed by the boundary.
+    std::filesystem::path                           m_uploadDirectory {};   //!< Directory of spooled files.
+    std::string                                     m_pending       {};     //!< Bytes not yet assigned to a part.
+    State                                           m_state         { State::Preamble };
+    std::size_t                                     m_partCount     {};     //!< Number of parts seen so far.
+    std::string                                     m_fieldName     {};     //!< Field name of the current part.
+    std::string                                     m_fieldValue    {};     //!< Value of the current non-file part.
+    bool                                            m_isFile        {};     //!< True if the current part is a file.
+    int                                             m_fileDescriptor { -1 }; //!< Descriptor of the open spool file.
+    UploadedFiles                                   m_files         {};     //!< Files received so far.
+    std::unordered_map<std::string, std::string>    m_fields        {};     //!< Non-file fields received so far.
+};
+
+CELL_NAMESPACE_END
+
+#endif  // CELL_WEBSERVER_MULTIPART_HPP
@@ -34,9 +34,32 @@ const std::unordered_map<std::string, std::string> Request::headers() const
     return m_requestStructure.headers;
 }
 
+const OptionalString& Request::httpVersion() const
+{
+    return m_requestStructure.httpVersion;
+}
+
 OptionalString Request::body() const
 {
-    return m_requestStructure.body.value();
+    return m_requestStructure.body;
+}
+
+OptionalString Request::header(std::string_view name) const
+{
+    for (const auto& [key, value] : m_requestStructure.headers) {
+        if (key.size() == name.size()
+            && std::equal(key.begin(), key.end(), name.begin(), [](unsigned char a, unsigned char b) {
+                   return std::tolower(a) == std::tolower(b);
+               })) {
+            return value;
+        }
+    }
+    return std::nullopt;
+}
+
+std::shared_ptr<BodyReader> Request::bodyReader() const
+{
+    return m_requestStructure.bodyReader;
 }
 
 void Request::setMethod(const std::string& method)
@@ -59,6 +82,32 @@ void Request::setBody(const std::string& body)
     m_requestStructure.body = body;
 }
 
+void Request::setHttpVersion(const std::string& version)
+{
+    m_requestStructure.httpVersion = version;
+}
+
+void Request::setBodyReader(std::shared_ptr<BodyReader> reader)
+{
+    m_requestStructure.bodyReader = std::move(reader);
+}
+
+void Request::setUploadedFiles(UploadedFiles files)
+{
+    m_requestStructure.uploadedFiles = std::shared_ptr<UploadedFiles>(new UploadedFiles(std::move(files)), [](UploadedFiles* uploaded) {
+        for (const auto& file : *uploaded) {
+            std::error_code ec;
+            std::filesystem::remove(file.temporaryPath, ec);
+        }
+        delete uploaded;
+    });
+}
+
+void Request::setFormField(const std::string& name, const std::string& value)
+{
+    m_requestStructure.formFields[name] = value;
+}
+
 void Request::setSessionId(const std::string& sessionId)
 {
     if (!m_requestStructure.cookies.getSessionIdCookie()) {
@@ -83,4 +132,24 @@ const std::unordered_map<std::string, std::string>& Request::pathParameters() co
     return m_requestStructure.pathParameters;
 }
 
+std::unordered_map<std::string, std::string> Request::getUploadedFiles() const
+{
+    std::unordered_map<std::string, std::string> files;
+    for (const auto& file : uploadedFiles()) {
+        files[file.fieldName] = file.temporaryPath;
+    }
+    return files;
+}
+
+const UploadedFiles& Request::uploadedFiles() const
+{
+    static const UploadedFiles noFiles;
+    return m_requestStructure.uploadedFiles ? *m_requestStructure.uploadedFiles : noFiles;
+}
+
+const std::unordered_map<std::string, std::string>& Request::formFields() const
+{
+    return m_requestStructure.formFields;
+}
+
 CELL_NAMESPACE_END
@@ -13,6 +13,18 @@
 #   error "Cell's "classes/cookies.hpp" was not found!"
 #endif
 
+#if __has_include("bodyreader.hpp")
+#   include "bodyreader.hpp"
+#else
+#   error "Cell's "bodyreader.hpp" was not found!"
+#endif
+
+#if __has_include("multipart.hpp")
+#   include "multipart.hpp"
+#else
+#   error "Cell's "multipart.hpp" was not found!"
+#endif
+
 CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Network::WebServer)
 
 /**
@@ -27,6 +39,9 @@ struct RequestStructure final
     Types::OptionalString       body          {}; //!< The body of the request.
     Globals::Storage::Cookies   cookies       {}; //!< The cookies received in the request.
     std::unordered_map<std::string, std::string> pathParameters {}; //!< Dynamic path parameters (e.g., `/user/{id}`).
+    std::unordered_map<std::string, std::string> formFields {}; //!< Non-file fields of a multipart/form-data body.
+    std::shared_ptr<BodyReader>  bodyReader    {}; //!< Streaming reader for bodies that were not buffered.
+    std::shared_ptr<UploadedFiles> uploadedFiles {}; //!< Spooled uploads, removed from disk with the last request copy.
 };
 
 /**
@@ -59,10 +74,27 @@ public:
 
     /**
      * @brief Get the body of the request.
-     * @return The optional body of the request.
+     * @return The optional body of the request, std::nullopt if the body was not buffered.
      */
     Types::OptionalString body() const;
 
+    /**
+     * @brief Returns a header value using a case-insensitive name lookup.
+     * @param name The name of the header.
+     * @return The header value, or std::nullopt if the header is absent.
+     */
+    Types::OptionalString header(std::string_view name) const;
+
+    /**
+     * @brief Returns the streaming reader of the request body.
+     *
+     * Bodies that are chunked or larger than the buffering threshold are not copied into body();
+     * handlers read them from this reader instead.
+     *
+     * @return The body reader, or nullptr if the body was buffered or the request has no body.
+     */
+    std::shared_ptr<BodyReader> bodyReader() const;
+
     /**
      * @brief Returns the headers of the request
      *
@@ -95,6 +127,35 @@ public:
      */
     void setBody(const std::string& body);
 
+    /**
+     * @brief Set the HTTP version of the request.
+     * @param version The HTTP version to set.
+     */
+    void setHttpVersion(const std::string& version);
+
+    /**
+     * @brief Set the streaming reader of the request body.
+     * @param reader The body reader.
+     */
+    void setBodyReader(std::shared_ptr<BodyReader> reader);
+
+    /**
+     * @brief Set the files spooled from a multipart/form-data body.
+     *
+     * The files are removed from disk once the last copy of the request is destroyed;
+     * handlers that want to keep a file must move it elsewhere.
+     *
+     * @param files The uploaded files.
+     */
+    void setUploadedFiles(UploadedFiles files);
+
+    /**
+     * @brief Set a non-file field of a multipart/form-data body.
+     * @param name The name of the field.
+     * @param value The value of the field.
+     */
+    void setFormField(const std::string& name, const std::string& value);
+
     /**
      * @brief Set the session ID of the request.
      * @param sessionId The session ID to set.
@@ -109,10 +170,22 @@ public:
 
     /**
      * @brief Get the uploaded files in the request.
-     * @return The uploaded files as an unordered map.
+     * @return The temporary paths of the uploaded files keyed by form field name.
      */
     std::unordered_map<std::string, std::string> getUploadedFiles() const;
 
+    /**
+     * @brief Get the uploaded files in the request with their metadata.
+     * @return The uploaded files.
+     */
+    const UploadedFiles& uploadedFiles() const;
+
+    /**
+     * @brief Get the non-file fields of a multipart/form-data body.
+     * @return The form fields as an unordered map.
+     */
+    const std::unordered_map<std::string, std::string>& formFields() const;
+
     /**
      * @brief Set path parameters for the request.
      * @param params The path parameters to set.
@@ -127,7 +200,6 @@ public:
 
 private:
     RequestStructure m_requestStructure {};
-    std::unordered_map<std::string, std::string> m_uploadedFiles;
 };
 
 CELL_NAMESPACE_END
@@ -18,6 +18,15 @@ CELL_USING_NAMESPACE Cell::Utility;
 
 CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Network::WebServer)
 
+namespace {
+
+/**
+ * @brief Records of the router; Logger::setMinimumLevel("Router", ...) filters them.
+ */
+LogChannel routerLog { "Router" };
+
+}  // namespace
+
 void Router::addRoute(const std::string& path, const Handler& handler, const std::string& method)
 {
     std::string normalizedPath = normalizePath(path).value();
@@ -40,12 +49,17 @@ void Router::addMiddleware(const Middleware& middleware)
     m_middleWares.push_back(middleware);
 }
 
+const std::vector<Middleware>& Router::middlewares() const
+{
+    return m_middleWares;
+}
+
 Response Router::routeRequest(const Request& request) {
     auto& engine = engineController.getEngine();
     std::string methodKey = normalizeMethod(request.method().value()).value();
     std::string path = normalizePath(request.path().value()).value();
 
-    Log("Routing request: Method=" + methodKey + ", Path=" + path, Utility::LoggerType::Info);
+    LogTagged(routerLog, "Routing request: Method=" + methodKey + ", Path=" + path, Utility::LoggerType::Info);
 
     auto methodIt = m_routes.find(methodKey);
     if (methodIt != m_routes.end()) {
@@ -57,7 +71,7 @@ Response Router::routeRequest(const Request& request) {
             std::regex routeRegex = createRouteRegex(routePath);
 
             if (std::regex_match(path, match, routeRegex)) {
-                Log("Matched route: " + routePath, Utility::LoggerType::Info);
+                LogTagged(routerLog, "Matched route: " + routePath, Utility::LoggerType::Info);
 
                 std::unordered_map<std::string, std::string> pathParams;
                 auto paramNames = extractParameterNames(routePath);
@@ -67,18 +81,12 @@ Response Router::routeRequest(const Request& request) {
 
                 const_cast<Request&>(request).setPathParameters(pathParams);
 
-                Response response = route.second(request);
-
-                for (const auto& middleware : m_middleWares) {
-                    middleware(const_cast<Request&>(request), response, route.second);
-                }
-
-                return response;
+                return route.second(request);
             }
         }
     }
 
-    Log("No route matched for path: " + path, Utility::LoggerType::Warning);
+    LogTagged(routerLog, "No route matched for path: " + path, Utility::LoggerType::Warning);
 
     if (m_notFoundHandler) {
         return m_notFoundHandler(request);
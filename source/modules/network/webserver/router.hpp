@@ -53,12 +53,20 @@ public:
     /**
      * Add a middleware to the router.
      *
+     * The web server compiles router middlewares into the post-route phase of its pipeline; they run
+     * for requests handled by this router, after the route handler.
+     *
      * @param middleware The middleware function to add.
      */
     void addMiddleware(const Middleware& middleware);
 
     /**
-     * Route the incoming request based on the registered routes and middleware.
+     * Returns the middlewares added to the router, in registration order.
+     */
+    const std::vector<Middleware>& middlewares() const;
+
+    /**
+     * Route the incoming request based on the registered routes.
      *
      * @param request The incoming request to route.
      * @return The response generated from the routing process.
@@ -127,15 +135,6 @@ private:
      */
     std::vector<std::string> extractParameterNames(const std::string& routePath);
 
-    /**
-     * Apply middlewares to the request and response.
-     *
-     * @param request The request to apply middlewares to.
-     * @param handler The handler function to apply middlewares to.
-     * @return The response generated from the middlewares.
-     */
-    Response applyMiddlewares(Request& request, const Handler& handler);
-
 
     std::unordered_map<std::string, std::unordered_map<std::string, Handler>> m_routes;
     std::vector<Middleware> m_middleWares;
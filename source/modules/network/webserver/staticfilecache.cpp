@@ -0,0 +1,113 @@
+#if __has_include("staticfilecache.hpp")
+#   include "staticfilecache.hpp"
+#else
+#   error "Cell's staticfilecache was not found!"
+#endif
+
+#if __has_include("classes/mediatypes.hpp")
+#   include "classes/mediatypes.hpp"
+#else
+#   error "Cell's classes/mediatypes.hpp was not found!"
+#endif
+
+CELL_USING_NAMESPACE Cell;
+CELL_USING_NAMESPACE Cell::Types;
+CELL_USING_NAMESPACE Cell::Globals;
+
+CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Network::WebServer)
+
+StaticFileCache::StaticFileCache(std::size_t byteBudget) : m_byteBudget(byteBudget)
+{
+}
+
+void StaticFileCache::setTtl(std::chrono::seconds ttl)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_ttl = ttl;
+}
+
+std::shared_ptr<const CachedFile> StaticFileCache::load(const std::filesystem::path& path, bool useCache)
+{
+    if (!useCache) {
+        return read(path);
+    }
+
+    const auto key = path.string();
+    const auto now = std::chrono::steady_clock::now();
+    std::shared_ptr<const CachedFile> cached;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (auto it = m_entries.find(key); it != m_entries.end()) {
+            cached = it->second;
+            if (now - cached->loadedAt < m_ttl) {
+                return cached;
+            }
+        }
+    }
+
+    // Stale entries are reused if the file did not change on disk.
+    std::error_code ec;
+    const auto modified = std::filesystem::last_write_time(path, ec);
+    if (cached && !ec && modified == cached->modified) {
+        auto refreshed = std::make_shared<CachedFile>(*cached);
+        refreshed->loadedAt = now;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries[key] = refreshed;
+        return refreshed;
+    }
+
+    auto file = read(path);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (auto it = m_entries.find(key); it != m_entries.end()) {
+        m_bytes -= it->second->content.size();
+        m_entries.erase(it);
+    }
+    if (!file || file->content.size() > m_byteBudget / STATIC_FILE_CACHE_CONSTANTS::MAX_FILE_FRACTION) {
+        return file;
+    }
+
+    // Make room; entries are small relative to the budget, so evicting in bucket order is good enough.
+    while (m_bytes + file->content.size() > m_byteBudget && !m_entries.empty()) {
+        m_bytes -= m_entries.begin()->second->content.size();
+        m_entries.erase(m_entries.begin());
+    }
+    m_entries.emplace(key, file);
+    m_bytes += file->content.size();
+    return file;
+}
+
+void StaticFileCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_bytes = 0;
+}
+
+std::shared_ptr<const CachedFile> StaticFileCache::read(const std::filesystem::path& path)
+{
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(path, ec)) {
+        return nullptr;
+    }
+
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream) {
+        return nullptr;
+    }
+
+    auto file = std::make_shared<CachedFile>();
+    std::ostringstream content;
+    content << stream.rdbuf();
+    file->content = content.str();
+
+    // Determine the MIME type based on the file extension
+    MediaTypes mt;
+    const auto extension = path.extension().string();
+    file->mimeType = mt.getMimeType(extension.size() > 1 ? extension.substr(1) : "bin");
+    file->modified = std::filesystem::last_write_time(path, ec);
+    file->loadedAt = std::chrono::steady_clock::now();
+    return file;
+}
+
+CELL_NAMESPACE_END
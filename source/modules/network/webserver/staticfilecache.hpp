@@ -0,0 +1,102 @@
+/*!
+ * @file        staticfilecache.hpp
+ * @brief       This file is part of the Cell Engine.
+ * @details     In-memory cache of static files served by the web server.
+ * @author      <a href='https://github.com/thecompez'>Kambiz Asadzadeh</a>
+ * @package     Genyleap
+ * @since       29 Apr 2023
+ * @copyright   Copyright (c) 2025 The Genyleap. All rights reserved.
+ * @license     https://github.com/genyleap/cell/blob/main/LICENSE.md
+ *
+ */
+
+#ifndef CELL_WEBSERVER_STATIC_FILE_CACHE_HPP
+#define CELL_WEBSERVER_STATIC_FILE_CACHE_HPP
+
+#ifdef __has_include
+# if __has_include("common.hpp")
+#   include "common.hpp"
+#else
+#   error "Cell's "common.hpp" was not found!"
+# endif
+#endif
+
+CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Network::WebServer)
+
+/**
+ * @brief Constants related to the static file cache.
+ */
+struct STATIC_FILE_CACHE_CONSTANTS final {
+    __cell_static_const_constexpr std::size_t DEFAULT_BYTE_BUDGET = 64 * 1024 * 1024;  //!< Bytes of file content kept per cache.
+    __cell_static_const_constexpr std::size_t MAX_FILE_FRACTION = 8;                   //!< Files above budget / fraction are never cached.
+};
+
+/**
+ * @brief A static file loaded into memory.
+ */
+struct CachedFile final
+{
+    std::string                             content     {}; //!< The file content.
+    std::string                             mimeType    {}; //!< The media type derived from the extension.
+    std::filesystem::file_time_type         modified    {}; //!< Modification time when the file was read.
+    std::chrono::steady_clock::time_point   loadedAt    {}; //!< When the file was read.
+};
+
+/**
+ * @class StaticFileCache
+ * @brief Keeps recently served static files in memory.
+ *
+ * Each virtual host owns its own cache, so one tenant cannot evict another tenant's files.
+ * Entries are revalidated against the file's modification time once their TTL expires.
+ *
+ * @note This class is marked with the "__cell_export" attribute, indicating
+ *       it is part of the "cell" module for exporting purposes.
+ */
+class __cell_export StaticFileCache {
+public:
+    /**
+     * @brief Constructs a StaticFileCache.
+     * @param byteBudget The maximum number of content bytes kept in memory.
+     */
+    explicit StaticFileCache(std::size_t byteBudget = STATIC_FILE_CACHE_CONSTANTS::DEFAULT_BYTE_BUDGET);
+
+    /**
+     * @brief Disable copy construction and assignment for a class.
+     */
+    CELL_DISABLE_COPY(StaticFileCache)
+
+    /**
+     * @brief Sets how long an entry is used before its modification time is checked again.
+     * @param ttl The time-to-live of an entry.
+     */
+    void setTtl(std::chrono::seconds ttl);
+
+    /**
+     * @brief Returns a file, reading it from disk if it is not cached or stale.
+     * @param path The path of the file.
+     * @param useCache False to bypass the cache entirely.
+     * @return The file, or nullptr if it does not exist or is not a regular file.
+     */
+    std::shared_ptr<const CachedFile> load(const std::filesystem::path& path, bool useCache = true);
+
+    /**
+     * @brief Drops every cached entry.
+     */
+    void clear();
+
+private:
+    /**
+     * @brief Reads a file from disk.
+     */
+    static std::shared_ptr<const CachedFile> read(const std::filesystem::path& path);
+
+    mutable std::mutex                                                  m_mutex         {};
+    std::unordered_map<std::string, std::shared_ptr<const CachedFile>>  m_entries       {};
+    std::size_t                                                         m_bytes         {};     //!< Content bytes currently cached.
+    std::size_t                                                         m_byteBudget    {};
+    std::chrono::seconds                                                m_ttl           { 60 };
+};
+
+CELL_NAMESPACE_END
+
+#endif  // CELL_WEBSERVER_STATIC_FILE_CACHE_HPP
@@ -28,4 +28,130 @@ void VirtualHostConfig::setErrorPage(const std::string& errorPage, int errorCode
     m_errorPages[std::to_string(errorCode)] = errorPage;
 }
 
+void VirtualHostConfig::setRouter(const Router& router)
+{
+    m_router = std::make_shared<Router>(router);
+}
+
+Router* VirtualHostConfig::getRouter() const
+{
+    return m_router.get();
+}
+
+void VirtualHostConfig::setSslCertificate(const std::string& certFile, const std::string& keyFile)
+{
+    m_sslCertFile = certFile;
+    m_sslKeyFile = keyFile;
+}
+
+const std::string& VirtualHostConfig::getSslCertFile() const
+{
+    return m_sslCertFile;
+}
+
+const std::string& VirtualHostConfig::getSslKeyFile() const
+{
+    return m_sslKeyFile;
+}
+
+VirtualHostTable::Entry::~Entry()
+{
+    if (sslContext) {
+        SSL_CTX_free(sslContext);
+    }
+}
+
+void VirtualHostTable::build(const std::unordered_map<std::string, VirtualHostConfig>& hosts)
+{
+    m_entries.clear();
+    m_exact.clear();
+    m_suffixes = {};
+    m_default = nullptr;
+
+    for (const auto& [hostname, config] : hosts) {
+        auto entry = std::make_unique<Entry>();
+        entry->hostname = hostname;
+        entry->config = config;
+
+        const auto name = normalizeHost(hostname);
+        if (name == "*" || name == "_" || name == "default") {
+            m_default = entry.get();
+        } else if (name.starts_with("*.")) {
+            // Insert the labels right to left: "*.a.example.com" -> com, example, a.
+            SuffixNode* node = &m_suffixes;
+            std::string_view labels = std::string_view(name).substr(2);
+            while (!labels.empty()) {
+                const auto dot = labels.rfind('.');
+                const auto label = std::string(dot == std::string_view::npos ? labels : labels.substr(dot + 1));
+                labels = dot == std::string_view::npos ? std::string_view() : labels.substr(0, dot);
+                auto& child = node->children[label];
+                if (!child) {
+                    child = std::make_unique<SuffixNode>();
+                }
+                node = child.get();
+            }
+            node->wildcard = entry.get();
+        } else {
+            m_exact[name] = entry.get();
+        }
+        m_entries.push_back(std::move(entry));
+    }
+}
+
+VirtualHostTable::Entry* VirtualHostTable::resolve(std::string_view host) const
+{
+    if (m_entries.empty()) {
+        return nullptr;
+    }
+
+    const auto name = normalizeHost(host);
+    if (auto it = m_exact.find(name); it != m_exact.end()) {
+        return it->second;
+    }
+
+    // Walk the labels right to left; a wildcard only matches if at least one label remains on its left.
+    Entry* match = nullptr;
+    const SuffixNode* node = &m_suffixes;
+    std::string_view labels = name;
+    while (!labels.empty()) {
+        const auto dot = labels.rfind('.');
+        if (dot == std::string_view::npos) {
+            break;
+        }
+        auto it = node->children.find(std::string(labels.substr(dot + 1)));
+        if (it == node->children.end()) {
+            break;
+        }
+        node = it->second.get();
+        labels = labels.substr(0, dot);
+        if (node->wildcard) {
+            match = node->wildcard;
+        }
+    }
+    return match ? match : m_default;
+}
+
+const std::vector<std::unique_ptr<VirtualHostTable::Entry>>& VirtualHostTable::entries() const
+{
+    return m_entries;
+}
+
+std::string VirtualHostTable::normalizeHost(std::string_view host)
+{
+    // Strip the port, taking bracketed IPv6 literals into account.
+    if (!host.empty() && host.front() == '[') {
+        const auto close = host.find(']');
+        host = host.substr(0, close == std::string_view::npos ? host.size() : close + 1);
+    } else if (const auto colon = host.find(':'); colon != std::string_view::npos) {
+        host = host.substr(0, colon);
+    }
+    if (!host.empty() && host.back() == '.') {
+        host.remove_suffix(1);
+    }
+
+    std::string name(host);
+    std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+    return name;
+}
+
 CELL_NAMESPACE_END
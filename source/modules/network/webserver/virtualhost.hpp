@@ -37,6 +37,22 @@
 # endif
 #endif
 
+#ifdef __has_include
+# if __has_include("router.hpp")
+#   include "router.hpp"
+#else
+#   error "Cell's "router.hpp" was not found!"
+# endif
+#endif
+
+#ifdef __has_include
+# if __has_include("staticfilecache.hpp")
+#   include "staticfilecache.hpp"
+#else
+#   error "Cell's "staticfilecache.hpp" was not found!"
+# endif
+#endif
+
 #if __has_include("abstracts/modules/webserver/virtualhost.hpp")
 #include "abstracts/modules/webserver/virtualhost.hpp"
 #else
@@ -51,9 +67,101 @@ public:
     const std::unordered_map<std::string, std::string>& getErrorPages() const;
     void setDocumentRoot(const std::string& documentRoot);
     void setErrorPage(const std::string& errorPage, int errorCode = 0);
+
+    /**
+     * @brief Sets the router used for requests to this host.
+     * @param router The router; copies of this configuration share it.
+     */
+    void setRouter(const Router& router);
+
+    /**
+     * @brief Returns the router of this host, or nullptr to use the server's router.
+     */
+    Router* getRouter() const;
+
+    /**
+     * @brief Sets the TLS certificate presented when a client asks for this host via SNI.
+     * @param certFile The PEM certificate file.
+     * @param keyFile The PEM private key file.
+     */
+    void setSslCertificate(const std::string& certFile, const std::string& keyFile);
+
+    const std::string& getSslCertFile() const;
+    const std::string& getSslKeyFile() const;
+
 private:
     std::string m_documentRoot;
     std::unordered_map<std::string, std::string> m_errorPages;
+    std::shared_ptr<Router> m_router;   //!< Per-host router (shared between copies).
+    std::string m_sslCertFile;          //!< Per-host certificate for SNI.
+    std::string m_sslKeyFile;           //!< Per-host private key for SNI.
+};
+
+/**
+ * @class VirtualHostTable
+ * @brief Resolves a Host header or SNI name to its virtual host.
+ *
+ * Built once at startup: exact names are looked up in a hash map, wildcard names (`*.example.com`)
+ * in a trie of reversed labels so the most specific wildcard wins, and everything else falls back to
+ * the default host (`*`, `_` or `default`), if one was configured.
+ *
+ * @note This class is marked with the "__cell_export" attribute, indicating
+ *       it is part of the "cell" module for exporting purposes.
+ */
+class __cell_export VirtualHostTable {
+public:
+    /**
+     * @brief Runtime state of a virtual host.
+     */
+    struct Entry final {
+        ~Entry();
+
+        std::string         hostname        {};         //!< The configured name (possibly a wildcard).
+        VirtualHostConfig   config          {};         //!< The host configuration.
+        SSL_CTX*            sslContext      {};         //!< TLS context selected by SNI, if the host has a certificate.
+        StaticFileCache     staticFiles     {};         //!< Static file cache partition of this host.
+    };
+
+    VirtualHostTable() = default;
+
+    /**
+     * @brief Disable copy construction and assignment for a class.
+     */
+    CELL_DISABLE_COPY(VirtualHostTable)
+
+    /**
+     * @brief Rebuilds the lookup structures from the configured hosts.
+     * @param hosts The virtual hosts keyed by hostname.
+     */
+    void build(const std::unordered_map<std::string, VirtualHostConfig>& hosts);
+
+    /**
+     * @brief Finds the virtual host serving a name.
+     * @param host The Host header value or SNI name (case and port are ignored).
+     * @return The matching entry, the default entry, or nullptr.
+     */
+    Entry* resolve(std::string_view host) const;
+
+    /**
+     * @brief Returns all entries.
+     */
+    const std::vector<std::unique_ptr<Entry>>& entries() const;
+
+    /**
+     * @brief Lowercases a host name and strips the port and a trailing dot.
+     */
+    static std::string normalizeHost(std::string_view host);
+
+private:
+    struct SuffixNode final {
+        std::unordered_map<std::string, std::unique_ptr<SuffixNode>> children {};
+        Entry* wildcard {};     //!< Host for `*.<labels up to here>`.
+    };
+
+    std::vector<std::unique_ptr<Entry>>         m_entries   {};
+    std::unordered_map<std::string, Entry*>     m_exact     {};
+    SuffixNode                                  m_suffixes  {};
+    Entry*                                      m_default   {};
 };
 
 
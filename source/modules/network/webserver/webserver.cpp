@@ -16,6 +16,16 @@
 #   error "Cell's classes/mediatypes.hpp was not found!"
 #endif
 
+#if __has_include("handoff.hpp")
+#   include "handoff.hpp"
+#else
+#   error "Cell's handoff was not found!"
+#endif
+
+#include <fcntl.h>
+
+extern char** environ;
+
 CELL_USING_NAMESPACE Cell;
 CELL_USING_NAMESPACE Cell::Types;
 CELL_USING_NAMESPACE Cell::System;
@@ -25,6 +35,103 @@ CELL_USING_NAMESPACE Cell::Globals::Storage;
 
 CELL_NAMESPACE_BEGIN(Cell::Modules::BuiltIn::Network::WebServer)
 
+namespace {
+
+/**
+ * @brief Records of the web server; Logger::setMinimumLevel("WebServer", ...) filters them.
+ */
+LogChannel webServerLog { "WebServer" };
+
+/**
+ * @brief Answers the request with a plain-text status when a check fails.
+ */
+struct RequestCheck final {
+    std::function<bool(const Request&)> check;
+    int statusCode;
+    std::string message;
+
+    MiddlewareAction preRoute(MiddlewareContext& context)
+    {
+        if (check(context.request)) {
+            return MiddlewareAction::Continue;
+        }
+        context.response.setStatusCode(statusCode);
+        context.response.setContentType("text/plain");
+        context.response.setContent(message);
+        return MiddlewareAction::Respond;
+    }
+};
+
+/**
+ * @brief Rejects clients that exceeded the rate limit with 429.
+ */
+struct RateLimitMiddleware final {
+    RateLimiter* limiter;
+
+    MiddlewareAction preRoute(MiddlewareContext& context)
+    {
+        if (limiter->allowRequest(std::string(context.clientAddress))) {
+            return MiddlewareAction::Continue;
+        }
+        context.response.setStatusCode(429); // Too Many Requests
+        context.response.setContentType("text/plain");
+        context.response.setContent("Rate limit exceeded. Please try again later.");
+        return MiddlewareAction::Respond;
+    }
+};
+
+/**
+ * @brief Runs a wrapping middleware added through WebServer::addMiddleWare around the handler.
+ */
+struct WrappingMiddleware final {
+    std::function<Response(const Request&, const std::function<Response(const Request&)>&)> middleware;
+
+    void around(MiddlewareContext& context, const MiddlewareNext& next)
+    {
+        // Whatever the middleware returns is the response, including one it built from the result of next
+        Response response = middleware(context.request, [&context, &next](const Request& request) {
+            if (&request != &context.request) {
+                context.request = request;
+            }
+            next();
+            return context.response;
+        });
+        context.response = std::move(response);
+    }
+};
+
+/**
+ * @brief Runs a router middleware after the handlers of that router.
+ */
+struct RouterMiddleware final {
+    Router* router;
+    Middleware middleware;
+
+    void postRoute(MiddlewareContext& context)
+    {
+        if (context.router != router) {
+            return;
+        }
+        middleware(context.request, context.response, [this](const Request& request) {
+            return router->routeRequest(request);
+        });
+    }
+};
+
+/**
+ * @brief Turns exceptions into responses through the configured exception handler.
+ */
+struct ExceptionMiddleware final {
+    ExceptionErrorHandler handler;
+
+    void onError(MiddlewareContext& context)
+    {
+        context.response = handler(context.request, *context.error);
+    }
+};
+
+}  // namespace
+
 WebServer::WebServer(EventLoopType loopType) : m_eventLoop(loopType)
 {
     // Initialize the SSL library
@@ -41,18 +148,37 @@ WebServer::~WebServer()
 }
 
 void WebServer::start(int port) {
+    // Claim the server before touching any state: a second start() must not rebuild the host table or the
+    // middleware chain that the request threads of the running one are using
+    bool expected = false;
+    if (!m_serverStructure.isRunning.compare_exchange_strong(expected, true)) {
+        LogTagged(webServerLog, "Web server is already running.", LoggerType::Success);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_activeClientsMutex);
+        m_accepting = true;
+    }
+
     EngineController ec;
     auto& engine = ec.getEngine();
 
     m_serverStructure.router.setNotFoundHandler(m_serverStructure.notFoundHandler);
     m_serverStructure.router.setExceptionHandler(m_serverStructure.exceptionErrorHandler);
 
-    if (m_serverStructure.enableSsl) {
-        if (m_serverStructure.isRunning) {
-            Log("Web server is already running.", LoggerType::Success);
-            return;
+    // Precompute the Host/SNI lookup and give every host its own static file cache partition
+    m_serverStructure.virtualHostTable.build(m_serverStructure.virtualHosts);
+    if (m_serverStructure.staticFileCacheTtl > 0) {
+        const std::chrono::seconds ttl { m_serverStructure.staticFileCacheTtl };
+        m_serverStructure.staticFileCache.setTtl(ttl);
+        for (const auto& entry : m_serverStructure.virtualHostTable.entries()) {
+            entry->staticFiles.setTtl(ttl);
         }
+    }
+
+    compileMiddleware();
 
+    if (m_serverStructure.enableSsl) {
         m_serverStructure.port = port;
 
         try {
@@ -61,110 +187,62 @@ void WebServer::start(int port) {
             OpenSSL_add_all_algorithms();
             SSL_load_error_strings();
 
-            // Create an SSL context
-            SSL_CTX* sslContext = SSL_CTX_new(TLS_server_method());
-            if (!sslContext) {
-                Log("Failed to create SSL context.", LoggerType::Critical);
-                throw std::runtime_error("Failed to create SSL context.");
-            }
-
-            // Disable insecure protocols
-            SSL_CTX_set_options(sslContext, SSL_OP_NO_SSLv2 | SSL_OP_NO_SSLv3 | SSL_OP_NO_TLSv1 | SSL_OP_NO_TLSv1_1);
-            SSL_CTX_set_min_proto_version(sslContext, TLS1_3_VERSION);
-
-                   // Set cipher list
-            if (SSL_CTX_set_cipher_list(sslContext, "HIGH:!aNULL:!MD5:!RC4") != 1) {
-                Log("Failed to set cipher list.", LoggerType::Critical);
-                throw std::runtime_error("Failed to set cipher list.");
-            }
-
-            // Load certificate and private key
-            if (SSL_CTX_use_certificate_file(sslContext, m_serverStructure.sslCertFile.c_str(), SSL_FILETYPE_PEM) <= 0) {
-                Log("Failed to load server certificate.", LoggerType::Critical);
-                throw std::runtime_error("Failed to load server certificate.");
-            }
-
-            if (SSL_CTX_use_PrivateKey_file(sslContext, m_serverStructure.sslKeyFile.c_str(), SSL_FILETYPE_PEM) <= 0) {
-                Log("Failed to load private key.", LoggerType::Critical);
-                throw std::runtime_error("Failed to load private key.");
-            }
-
-            // Verify private key matches the certificate
-            if (!SSL_CTX_check_private_key(sslContext)) {
-                Log("Private key does not match the certificate.", LoggerType::Critical);
-                throw std::runtime_error("Private key does not match the certificate.");
-            }
+            // Create the default SSL context
+            SSL_CTX* sslContext = createSslContext(m_serverStructure.sslCertFile, m_serverStructure.sslKeyFile);
 
-            // Create server socket
-            int serverSocket = socket(AF_INET, SOCK_STREAM, 0);
-            if (serverSocket < 0) {
-                Log("Failed to create server socket.", LoggerType::Critical);
-                throw std::runtime_error("Failed to create server socket.");
-            }
-
-            // Set socket options to reuse address
-            int opt = 1;
-            if (setsockopt(serverSocket, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)) < 0) {
-                Log("Failed to set socket options.", LoggerType::Warning);
-            }
-
-            // Bind server socket
-            sockaddr_in serverAddress{};
-            serverAddress.sin_family = AF_INET;
-            serverAddress.sin_addr.s_addr = htonl(INADDR_ANY);
-            serverAddress.sin_port = htons(port);
-
-            if (bind(serverSocket, reinterpret_cast<sockaddr*>(&serverAddress), sizeof(serverAddress)) < 0) {
-                Log("Failed to bind server socket.", LoggerType::Critical);
-                throw std::runtime_error("Failed to bind server socket.");
+            // Per-host certificates are selected from the SNI name during the handshake
+            for (const auto& entry : m_serverStructure.virtualHostTable.entries()) {
+                const auto& config = entry->config;
+                if (config.getSslCertFile().empty()) {
+                    continue;
+                }
+                try {
+                    entry->sslContext = createSslContext(config.getSslCertFile(), config.getSslKeyFile());
+                } catch (const std::exception& e) {
+                    LogTagged(webServerLog, "Virtual host " + entry->hostname + " falls back to the default certificate: " + e.what(), LoggerType::Warning);
+                }
             }
+            SSL_CTX_set_tlsext_servername_callback(sslContext, &WebServer::selectSslContext);
+            SSL_CTX_set_tlsext_servername_arg(sslContext, this);
 
-            // Listen for incoming connections
-            if (listen(serverSocket, SOMAXCONN) < 0) {
-                Log("Failed to listen on server socket.", LoggerType::Critical);
-                throw std::runtime_error("Failed to listen on server socket.");
-            }
+            // Create (or inherit) the listening socket
+            openListeningSocket(port, listenBacklog());
 
-            m_serverStructure.isRunning = true;
-            Log("Web server started on port: " + TO_CELL_STRING(port), LoggerType::Success);
+            LogTagged(webServerLog, "Web server started on port: " + TO_CELL_STRING(port), LoggerType::Success);
 
             // Start the event loop in a separate thread
             m_eventLoop.start();
 
             while (m_serverStructure.isRunning) {
-                sockaddr_in clientAddress{};
-                socklen_t clientAddressLength = sizeof(clientAddress);
-
                 // Accept client connection
-                int clientSocket = accept(serverSocket, reinterpret_cast<sockaddr*>(&clientAddress), &clientAddressLength);
+                SocketType clientSocket = acceptClient();
                 if (clientSocket < 0) {
-                    Log("Failed to accept client connection: " + FROM_CELL_STRING(strerror(errno)), LoggerType::Critical);
                     continue;
                 }
 
                 // Create SSL object
                 SSL* ssl = SSL_new(sslContext);
                 if (!ssl) {
-                    Log("Failed to create SSL object.", LoggerType::Critical);
-                    close(clientSocket);
+                    LogTagged(webServerLog, "Failed to create SSL object.", LoggerType::Critical);
+                    closeClient(clientSocket);
                     continue;
                 }
 
                 // Associate SSL object with the client socket
                 if (SSL_set_fd(ssl, clientSocket) != 1) {
-                    Log("Failed to set SSL file descriptor.", LoggerType::Critical);
+                    LogTagged(webServerLog, "Failed to set SSL file descriptor.", LoggerType::Critical);
                     SSL_free(ssl);
-                    close(clientSocket);
+                    closeClient(clientSocket);
                     continue;
                 }
 
                 // Perform SSL handshake
                 if (SSL_accept(ssl) <= 0) {
                     int sslError = SSL_get_error(ssl, -1);
-                    Log("SSL handshake failed. Error: " + std::to_string(sslError), LoggerType::Warning);
+                    LogTagged(webServerLog, "SSL handshake failed. Error: " + std::to_string(sslError), LoggerType::Warning);
                     ERR_print_errors_fp(stderr); // Print detailed SSL errors
                     SSL_free(ssl);
-                    close(clientSocket);
+                    closeClient(clientSocket);
                     continue;
                 }
 
@@ -178,27 +256,25 @@ void WebServer::start(int port) {
                         shutdownResult = SSL_shutdown(ssl); // Perform second phase of shutdown
                     }
                     if (shutdownResult < 0) {
-                        Log("SSL shutdown failed.", LoggerType::Warning);
+                        LogTagged(webServerLog, "SSL shutdown failed.", LoggerType::Warning);
                     }
 
                     SSL_free(ssl);
-                    close(clientSocket);
+                    closeClient(clientSocket);
                 });
             }
 
             // Clean up SSL context
             SSL_CTX_free(sslContext);
-            close(serverSocket);
-        } catch (const Exception& ex) {
-            Log("Error starting web server: " + FROM_CELL_STRING(ex.what()), LoggerType::Critical);
+            closeListeningSocket();
+        } catch (const std::exception& ex) {
+            LogTagged(webServerLog, "Error starting web server: " + FROM_CELL_STRING(ex.what()), LoggerType::Critical);
+            // Release the claim, so the server can be started again
+            closeListeningSocket();
+            m_serverStructure.isRunning = false;
         }
     } else {
         // Non-SSL mode (same as before)
-        if (m_serverStructure.isRunning) {
-            Log("Web server is already running.", LoggerType::Success);
-            return;
-        }
-
         m_serverStructure.port = port;
 
         try {
@@ -210,103 +286,374 @@ void WebServer::start(int port) {
             }
 #endif
 
-            // Create a socket for the server
-            m_serverStructure.serverSocket = socket(AF_INET, SOCK_STREAM, 0);
-            if (m_serverStructure.serverSocket == -1) {
-                Log("Failed to create socket.", LoggerType::Critical);
-                throw std::runtime_error("Failed to create socket.");
-            }
-
-            // Bind the socket to the specified port
-            sockaddr_in serverAddress{};
-            serverAddress.sin_family = AF_INET;
-            serverAddress.sin_addr.s_addr = INADDR_ANY;
-            serverAddress.sin_port = htons(m_serverStructure.port);
-
-            if (bind(m_serverStructure.serverSocket, (struct sockaddr*)&serverAddress, sizeof(serverAddress)) < 0) {
-                Log("Failed to bind socket to port " + TO_CELL_STRING(m_serverStructure.port) + ".", LoggerType::Critical);
-                throw std::runtime_error("Failed to bind socket to port " + std::to_string(m_serverStructure.port) + ".");
-            }
-
-            // Start listening for client connections
-            if (listen(m_serverStructure.serverSocket, WEBSERVER_CONSTANTS::MAX_CONNECTIONS) < 0) {
-                Log("Failed to start listening on port " + TO_CELL_STRING(m_serverStructure.port) + ".", LoggerType::Critical);
-                throw std::runtime_error("Failed to start listening on port " + std::to_string(m_serverStructure.port) + ".");
-            }
+            // Create (or inherit) the listening socket
+            openListeningSocket(m_serverStructure.port, listenBacklog());
 
-            m_serverStructure.isRunning = true;
-            Log("Web server started on port " + TO_CELL_STRING(m_serverStructure.port) + ".", LoggerType::Info);
+            LogTagged(webServerLog, "Web server started on port " + TO_CELL_STRING(m_serverStructure.port) + ".", LoggerType::Info);
 
             // Start the event loop in a separate thread
             m_eventLoop.start();
 
             while (m_serverStructure.isRunning) {
                 try {
-                    sockaddr_in clientAddress{};
-                    socklen_t clientAddressLength = sizeof(clientAddress);
-
                     // Accept a client connection
-                    SocketType clientSocket = accept(m_serverStructure.serverSocket, (struct sockaddr*)&clientAddress, &clientAddressLength);
+                    SocketType clientSocket = acceptClient();
                     if (clientSocket < 0) {
-                        Log("Failed to accept client connection.", LoggerType::Critical);
-                        throw std::runtime_error("Failed to accept client connection.");
+                        continue;
                     }
 
                     // Add a task to the event loop to handle the client request
                     m_eventLoop.addTask([=, this]() {
+                        // The handler only reads and writes; the task owns the descriptor
                         handleClientRequestNoSSL(clientSocket);
-                        close(clientSocket);
+                        closeClient(clientSocket);
                     });
                 } catch (const Exception& ex) {
-                    Log("An error occurred: " + FROM_CELL_STRING(ex.what()), LoggerType::Critical);
-                    close(m_serverStructure.serverSocket);
+                    LogTagged(webServerLog, "An error occurred: " + FROM_CELL_STRING(ex.what()), LoggerType::Critical);
+                    closeListeningSocket();
                     stop(); // Stop the server to ensure proper cleanup
                 }
             }
 
             // Close the server socket
-            close(m_serverStructure.serverSocket);
+            closeListeningSocket();
 
        // Cleanup the socket library (Windows only)
 #ifdef _WIN32
             WSACleanup();
 #endif
-            Log("Web server stopped.", LoggerType::Critical);
-        } catch (const Exception& ex) {
-            Log("An error occurred: " + FROM_CELL_STRING(ex.what()), LoggerType::Critical);
+            LogTagged(webServerLog, "Web server stopped.", LoggerType::Critical);
+        } catch (const std::exception& ex) {
+            LogTagged(webServerLog, "An error occurred: " + FROM_CELL_STRING(ex.what()), LoggerType::Critical);
+            closeListeningSocket();
             stop(); // Stop the server to ensure proper cleanup
         }
     }
+
+    finishAcceptLoop();
 }
 
 void WebServer::stop() {
-    if (!m_serverStructure.isRunning) {
-        return; // If the server is not running, no need to proceed
+    if (m_serverStructure.isRunning.exchange(false)) { // Mark the server as stopped
+        // Abort all active client connections; their handlers fail fast and close the descriptors.
+        // The accept loop closes the server socket once it notices the server has stopped.
+        std::lock_guard<std::mutex> lock(m_activeClientsMutex); // Ensure thread safety
+        for (const auto& clientPair : m_activeClients) {
+            ::shutdown(clientPair.first, SHUT_RDWR);
+        }
+        LogTagged(webServerLog, "Web server stopped.", LoggerType::Critical); // Log the server stop event
     }
 
-    m_serverStructure.isRunning = false; // Mark the server as stopped
+    if (m_eventLoop.getIsRunning()) {
+        m_eventLoop.stop();
+    }
+}
 
-    // Close all active client connections
+bool WebServer::stopGracefully(std::chrono::milliseconds drainTimeout) {
+    // A request handler runs on the event loop thread, which can neither wait for its own connection nor join
+    // itself. The flag is cleared under the lock, so the accept loop cannot finish before the drain is deferred.
+    if (m_eventLoop.isWorkerThread()) {
+        std::lock_guard<std::mutex> lock(m_activeClientsMutex);
+        if (m_serverStructure.isRunning.exchange(false)) {
+            m_deferredDrain = drainTimeout;
+            LogTagged(webServerLog, "Web server will drain once the request handler returns.", LoggerType::Info);
+        }
+        return true;
+    }
+
+    if (!m_serverStructure.isRunning.exchange(false)) {
+        return true;
+    }
+
+    // The accept loop notices within one poll interval and closes the listener.
+    LogTagged(webServerLog, "Web server is draining in-flight requests.", LoggerType::Info);
+    return drainClients(drainTimeout);
+}
+
+bool WebServer::drainClients(std::chrono::milliseconds drainTimeout) {
+    bool drained = false;
     {
-        std::lock_guard<std::mutex> lock(m_activeClientsMutex); // Ensure thread safety
-        for (const auto& clientPair : m_activeClients) {
-            const Types::SocketType& clientSocket = clientPair.first;
-            if (clientSocket >= 0) { // Check if the socket is valid (POSIX sockets are non-negative integers)
-                close(clientSocket); // Close each client socket
+        std::unique_lock<std::mutex> lock(m_activeClientsMutex);
+        // Shut down rather than close so handlers still own (and close) their descriptors.
+        const auto abortClients = [this]() {
+            for (const auto& clientPair : m_activeClients) {
+                ::shutdown(clientPair.first, SHUT_RDWR);
             }
+        };
+        drained = m_drainCondition.wait_for(lock, drainTimeout, [this]() { return !m_accepting && m_activeClients.empty(); });
+        if (!drained) {
+            LogTagged(webServerLog, "Drain deadline reached with " + std::to_string(m_activeClients.size()) + " connection(s) left; aborting them.", LoggerType::Warning);
+            abortClients();
+            // A connection accepted before the accept loop exited is still queued on the event loop; abort it too.
+            m_drainCondition.wait(lock, [this]() { return !m_accepting; });
+            abortClients();
         }
-        m_activeClients.clear(); // Clear the map of active clients
     }
 
-    // Close the server socket
-    if (m_serverStructure.serverSocket >= 0) { // Check if the server socket is valid
+    // Queued tasks still run before the loop stops, so every accepted connection is closed by its task.
+    if (m_eventLoop.getIsRunning()) {
+        m_eventLoop.stop();
+    }
+
+    LogTagged(webServerLog, "Web server stopped.", LoggerType::Critical);
+    return drained;
+}
+
+void WebServer::finishAcceptLoop() {
+    std::optional<std::chrono::milliseconds> deferredDrain;
+    {
+        std::lock_guard<std::mutex> lock(m_activeClientsMutex);
+        m_accepting = false;
+        deferredDrain = std::exchange(m_deferredDrain, std::nullopt);
+    }
+    m_drainCondition.notify_all();
+
+    if (deferredDrain) {
+        drainClients(deferredDrain.value());
+    }
+}
+
+bool WebServer::upgrade(const std::string& executable,
+                        const std::vector<std::string>& arguments,
+                        std::chrono::milliseconds drainTimeout) {
+    if (!m_serverStructure.isRunning || m_serverStructure.serverSocket < 0) {
+        LogTagged(webServerLog, "Cannot upgrade a web server that is not listening.", LoggerType::Warning);
+        return false;
+    }
+
+    const std::string channelPath = m_serverStructure.upgradeSocketPath.empty()
+                                        ? (std::filesystem::temp_directory_path() / ("cell-upgrade-" + std::to_string(getpid()) + ".sock")).string()
+                                        : m_serverStructure.upgradeSocketPath;
+
+    SocketType channel = ListenerHandoff::createChannel(channelPath);
+    if (channel < 0) {
+        LogTagged(webServerLog, "Failed to create upgrade channel at " + channelPath + ".", LoggerType::Critical);
+        return false;
+    }
+
+    // Prepare argv and envp before forking; only async-signal-safe calls are allowed in the child.
+    std::vector<std::string> argumentStorage { executable };
+    argumentStorage.insert(argumentStorage.end(), arguments.begin(), arguments.end());
+    std::vector<char*> argv;
+    for (auto& argument : argumentStorage) {
+        argv.push_back(argument.data());
+    }
+    argv.push_back(nullptr);
+
+    const std::string variable = std::string(HANDOFF_CONSTANTS::ENVIRONMENT_VARIABLE) + "=";
+    std::vector<std::string> environmentStorage { variable + channelPath };
+    for (char** entry = environ; *entry != nullptr; ++entry) {
+        if (std::string_view(*entry).rfind(variable, 0) != 0) {
+            environmentStorage.emplace_back(*entry);
+        }
+    }
+    std::vector<char*> envp;
+    for (auto& entry : environmentStorage) {
+        envp.push_back(entry.data());
+    }
+    envp.push_back(nullptr);
+
+    const pid_t child = fork();
+    if (child < 0) {
+        LogTagged(webServerLog, "Failed to fork the upgraded web server.", LoggerType::Critical);
+        close(channel);
+        ::unlink(channelPath.c_str());
+        return false;
+    }
+    if (child == 0) {
+        execve(executable.c_str(), argv.data(), envp.data());
+        _exit(127);
+    }
+
+    bool handedOff = false;
+    SocketType connection = ListenerHandoff::acceptChannel(channel, WEBSERVER_CONSTANTS::UPGRADE_TIMEOUT);
+    if (connection >= 0) {
+        handedOff = ListenerHandoff::sendSockets(connection, { m_serverStructure.serverSocket })
+                    && ListenerHandoff::waitReady(connection, WEBSERVER_CONSTANTS::UPGRADE_TIMEOUT);
+        close(connection);
+    }
+    close(channel);
+    ::unlink(channelPath.c_str());
+
+    if (!handedOff) {
+        LogTagged(webServerLog, "Upgraded web server (pid " + std::to_string(child) + ") did not take over the listener; keeping this process.", LoggerType::Critical);
+        return false;
+    }
+
+    LogTagged(webServerLog, "Listener handed off to pid " + std::to_string(child) + ".", LoggerType::Success);
+    return stopGracefully(drainTimeout);
+}
+
+void WebServer::setUpgradeSocketPath(const std::string& path) {
+    m_serverStructure.upgradeSocketPath = path;
+}
+
+void WebServer::openListeningSocket(int port, int backlog) {
+    // A process started by upgrade() takes over the listener of its predecessor.
+    if (const auto channelPath = ListenerHandoff::inheritedChannelPath()) {
+        ::unsetenv(HANDOFF_CONSTANTS::ENVIRONMENT_VARIABLE.data());
+        SocketType connection = ListenerHandoff::connectChannel(channelPath.value());
+        if (connection >= 0) {
+            const auto sockets = ListenerHandoff::receiveSockets(connection);
+            if (!sockets.empty()) {
+                m_serverStructure.serverSocket = sockets.front();
+                for (std::size_t i = 1; i < sockets.size(); ++i) {
+                    close(sockets[i]);
+                }
+                fcntl(m_serverStructure.serverSocket, F_SETFL, fcntl(m_serverStructure.serverSocket, F_GETFL, 0) | O_NONBLOCK);
+                ListenerHandoff::sendReady(connection);
+                close(connection);
+                LogTagged(webServerLog, "Inherited listening socket from the previous process.", LoggerType::Info);
+                return;
+            }
+            close(connection);
+        }
+        LogTagged(webServerLog, "Failed to inherit the listening socket; binding a new one.", LoggerType::Warning);
+    }
+
+    m_serverStructure.serverSocket = socket(AF_INET, SOCK_STREAM, 0);
+    if (m_serverStructure.serverSocket < 0) {
+        LogTagged(webServerLog, "Failed to create server socket.", LoggerType::Critical);
+        throw std::runtime_error("Failed to create server socket.");
+    }
+
+    // Set socket options to reuse address
+    int opt = 1;
+    if (setsockopt(m_serverStructure.serverSocket, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)) < 0) {
+        LogTagged(webServerLog, "Failed to set socket options.", LoggerType::Warning);
+    }
+
+    // Non-blocking, so a listener shared with another process never blocks accept(); not inherited by exec.
+    fcntl(m_serverStructure.serverSocket, F_SETFL, fcntl(m_serverStructure.serverSocket, F_GETFL, 0) | O_NONBLOCK);
+    fcntl(m_serverStructure.serverSocket, F_SETFD, FD_CLOEXEC);
+
+    sockaddr_in serverAddress{};
+    serverAddress.sin_family = AF_INET;
+    serverAddress.sin_addr.s_addr = htonl(INADDR_ANY);
+    serverAddress.sin_port = htons(port);
+
+    if (bind(m_serverStructure.serverSocket, reinterpret_cast<sockaddr*>(&serverAddress), sizeof(serverAddress)) < 0) {
+        LogTagged(webServerLog, "Failed to bind socket to port " + TO_CELL_STRING(port) + ".", LoggerType::Critical);
+        throw std::runtime_error("Failed to bind socket to port " + std::to_string(port) + ".");
+    }
+
+    if (listen(m_serverStructure.serverSocket, backlog) < 0) {
+        LogTagged(webServerLog, "Failed to start listening on port " + TO_CELL_STRING(port) + ".", LoggerType::Critical);
+        throw std::runtime_error("Failed to start listening on port " + std::to_string(port) + ".");
+    }
+}
+
+void WebServer::closeListeningSocket() {
+    if (m_serverStructure.serverSocket >= 0) {
         close(m_serverStructure.serverSocket);
-        m_serverStructure.serverSocket = -1; // Reset the server socket to an invalid state
+        m_serverStructure.serverSocket = -1;
+    }
+}
+
+SocketType WebServer::acceptClient() {
+    // Poll with a timeout so the loop notices stopGracefully() without closing a shared listener.
+    pollfd listener { m_serverStructure.serverSocket, POLLIN, 0 };
+    if (poll(&listener, 1, WEBSERVER_CONSTANTS::ACCEPT_POLL_INTERVAL_MS) <= 0 || !(listener.revents & POLLIN)) {
+        return -1;
+    }
+
+    // Stopped while polling: leave the connection queued for whoever owns the listener now.
+    if (!m_serverStructure.isRunning) {
+        return -1;
+    }
+
+    // Close-on-exec from the start: a process started by upgrade() that inherited the descriptor would keep the
+    // connection open after the handler closed it, and the client would wait for the end of the response.
+#if defined(__linux__)
+    SocketType clientSocket = accept4(m_serverStructure.serverSocket, nullptr, nullptr, SOCK_CLOEXEC);
+#else
+    SocketType clientSocket = accept(m_serverStructure.serverSocket, nullptr, nullptr);
+    if (clientSocket >= 0) {
+        fcntl(clientSocket, F_SETFD, FD_CLOEXEC);
+    }
+#endif
+    if (clientSocket < 0) {
+        // Another process sharing the listener may have taken the connection.
+        if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR && errno != ECONNABORTED) {
+            LogTagged(webServerLog, "Failed to accept client connection: " + FROM_CELL_STRING(strerror(errno)), LoggerType::Critical);
+        }
+        return -1;
+    }
+
+    // BSD-derived systems propagate O_NONBLOCK to accepted sockets; handlers use blocking I/O.
+    fcntl(clientSocket, F_SETFL, fcntl(clientSocket, F_GETFL, 0) & ~O_NONBLOCK);
+
+    {
+        std::unique_lock<std::mutex> lock(m_activeClientsMutex);
+        if (m_serverStructure.maxConnections > 0
+            && m_activeClients.size() >= static_cast<std::size_t>(m_serverStructure.maxConnections)) {
+            lock.unlock();
+            m_serverStructure.admissionController.recordRejectedConnection();
+            // Refuse without queueing; a TLS client cannot read a plain-text response, so it is just closed.
+            if (!m_serverStructure.enableSsl) {
+                const std::string responseString = responseToString(overloadResponse());
+                send(clientSocket, responseString.c_str(), responseString.length(), MSG_NOSIGNAL);
+            }
+            close(clientSocket);
+            return -1;
+        }
+        m_activeClients[clientSocket] = {
+            clientSocket,
+            getClientIP(clientSocket),
+            std::chrono::steady_clock::now()
+        };
+    }
+    return clientSocket;
+}
+
+int WebServer::listenBacklog() const {
+    return m_serverStructure.listenBacklog > 0 ? m_serverStructure.listenBacklog : WEBSERVER_CONSTANTS::LISTEN_BACKLOG;
+}
+
+Response WebServer::overloadResponse() const {
+    Response response;
+    response.setStatusCode(503);
+    response.setContentType("text/plain");
+    response.setHeader("Retry-After", std::to_string(ADMISSION_CONSTANTS::RETRY_AFTER_SECONDS));
+    response.setContent("Server is overloaded. Please try again later.");
+    return response;
+}
+
+bool WebServer::admitRequest(const Request& request) {
+    auto& admission = m_serverStructure.admissionController;
+    const auto priority = admission.priorityOf(request.path().value_or("/"));
+    if (admission.admit(m_eventLoop.currentQueueDelay(), priority)) {
+        return true;
     }
+    LogTagged(webServerLog, "Shedding request for " + request.path().value_or("/") + " after queueing delay.", LoggerType::Warning);
+    return false;
+}
 
-    Log("Web server stopped.", LoggerType::Critical); // Log the server stop event
+void WebServer::setQueueDelayTarget(std::chrono::milliseconds target, std::chrono::milliseconds interval) {
+    m_serverStructure.admissionController.setQueueDelayTarget(target, interval);
 }
 
+void WebServer::setRoutePriority(const std::string& pathPrefix, RequestPriority priority) {
+    m_serverStructure.admissionController.setRoutePriority(pathPrefix, priority);
+}
+
+AdmissionStatistics WebServer::getAdmissionStatistics() const {
+    return m_serverStructure.admissionController.statistics();
+}
+
+void WebServer::releaseClient(SocketType clientSocket) {
+    {
+        std::lock_guard<std::mutex> lock(m_activeClientsMutex);
+        m_activeClients.erase(clientSocket);
+    }
+    m_drainCondition.notify_all();
+}
+
+void WebServer::closeClient(SocketType clientSocket) {
+    // Unregistered first: once the number is closed it may be reused, and stop() must not shut that one down.
+    releaseClient(clientSocket);
+    close(clientSocket);
+}
 
 bool WebServer::isRunning() const {
     return m_serverStructure.isRunning;
@@ -327,26 +674,39 @@ void WebServer::parseRequest(const std::string& requestString, Request& request)
     // Parse the first line of the request
     std::string method, path, version;
     if (!(iss >> method >> path >> version)) {
-        Log("Invalid request line", LoggerType::Critical);
+        LogTagged(webServerLog, "Invalid request line", LoggerType::Critical);
         throw std::runtime_error("Invalid request line");
     }
 
-    // Set the method and path in the request object
+    // Set the method, path and version in the request object
     request.setMethod(method);
     request.setPath(path);
+    request.setHttpVersion(version);
 
-    // Parse the headers
+    // Skip the remainder of the request line
     std::string line;
-    while (std::getline(iss, line) && !line.empty()) {
+    std::getline(iss, line);
+
+    const auto trim = [](const std::string& text) {
+        const auto first = text.find_first_not_of(" \t\r");
+        if (first == std::string::npos) {
+            return std::string();
+        }
+        return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+    };
+
+    // Parse the headers up to the blank line (lines are CRLF terminated)
+    while (std::getline(iss, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty()) {
+            break;
+        }
         size_t colonPos = line.find(':');
         if (colonPos != std::string::npos) {
-            std::string key = line.substr(0, colonPos);
-            std::string value = line.substr(colonPos + 1);
-            // Trim leading and trailing whitespace from the key and value
-            key = std::regex_replace(key, std::regex("^\\s+|\\s+$"), "");
-            value = std::regex_replace(value, std::regex("^\\s+|\\s+$"), "");
             // Set the header in the request object
-            request.setHeader(key, value);
+            request.setHeader(trim(line.substr(0, colonPos)), trim(line.substr(colonPos + 1)));
         }
     }
 
@@ -368,14 +728,26 @@ void WebServer::parseRequest(const std::string& requestString, Request& request)
 std::string WebServer::getStatusMessage(int statusCode)
 {
     switch (statusCode) {
+    case 100:
+        return "Continue";
     case 200:
         return "OK";
     case 400:
         return "Bad Request";
     case 404:
         return "Not Found";
+    case 413:
+        return "Payload Too Large";
+    case 417:
+        return "Expectation Failed";
+    case 429:
+        return "Too Many Requests";
+    case 431:
+        return "Request Header Fields Too Large";
     case 500:
         return "Internal Server Error";
+    case 503:
+        return "Service Unavailable";
     // Add more status codes and messages as needed
     default:
         return "Unknown Status";
@@ -392,6 +764,9 @@ std::string WebServer::responseToString(const Response& response)
     // Write the headers
     ss << "Content-Type: " << response.contentType().value() << "\r\n";
     ss << "Content-Length: " << response.content().value().length() << "\r\n";
+    for (const auto& header : response.headers()) {
+        ss << header.first << ": " << header.second << "\r\n";
+    }
 
     // Write a blank line to separate headers from content
     ss << "\r\n";
@@ -408,7 +783,7 @@ std::string WebServer::getClientIP(SocketType clientSocket) {
 
     if (getpeername(clientSocket, reinterpret_cast<struct sockaddr*>(&addrStorage), &addrLength) < 0)
     {
-        Log("Error getting client IP address.", LoggerType::Critical);
+        LogTagged(webServerLog, "Error getting client IP address.", LoggerType::Critical);
         return "";
     }
 
@@ -423,7 +798,7 @@ std::string WebServer::getClientIP(SocketType clientSocket) {
         inet_ntop(AF_INET6, &(addr->sin6_addr), clientIP, INET6_ADDRSTRLEN);
         return std::string(clientIP);
     }
-    Log("Unknown address family.", LoggerType::Critical);
+    LogTagged(webServerLog, "Unknown address family.", LoggerType::Critical);
     return "";
 }
 
@@ -444,164 +819,353 @@ Response WebServer::error404Handler(const Request& request) {
 }
 
 void WebServer::handleClientRequestNoSSL(SocketType clientSocket) {
+    // The caller owns the socket and closes it once this returns.
     try {
-        // Add client to active connections
-        {
-            std::lock_guard<std::mutex> lock(m_activeClientsMutex);
-            m_activeClients[clientSocket] = {
-                clientSocket,
-                getClientIP(clientSocket),
-                std::chrono::steady_clock::now()
-            };
+        const BodyReader::ReadCallback source = [clientSocket](char* data, std::size_t length) -> std::int64_t {
+            ssize_t received = 0;
+            do {
+                received = recv(clientSocket, data, length, 0);
+            } while (received < 0 && errno == EINTR);
+            return received;
+        };
+        const auto interim = [clientSocket](std::string_view data) {
+            return send(clientSocket, data.data(), data.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(data.size());
+        };
+
+        // Receive the request head; the body is pulled on demand
+        std::string requestHead;
+        std::string prefetchedBody;
+        if (!readRequestHead(source, requestHead, prefetchedBody)) {
+            LogTagged(webServerLog, "Error reading client request.", LoggerType::Critical);
+            return;
         }
 
-        for (const auto& [socket, clientInfo] : m_activeClients) {
-            Log("Client: " + clientInfo.ipAddress + ", Connected at: " + std::to_string(clientInfo.connectionTime.time_since_epoch().count()), LoggerType::Info);
-        }
+        Request request;
+        parseRequest(requestHead, request);
 
-        constexpr const int bufferSize = 4096;
-        std::array<char, bufferSize> buffer;
-        std::fill(buffer.begin(), buffer.end(), 0);
+        // Shed before touching the body if the request waited too long in the queue
+        if (!admitRequest(request)) {
+            sendResponseNoSSL(clientSocket, overloadResponse());
+            return;
+        }
 
-        // Receive the client request
-        ssize_t bytesRead = recv(clientSocket, buffer.data(), bufferSize - 1, 0);
-        if (bytesRead < 0) {
-            Log("Error reading client request.", LoggerType::Critical);
-            close(clientSocket);
+        if (auto rejection = prepareRequestBody(request, source, interim, std::move(prefetchedBody))) {
+            sendResponseNoSSL(clientSocket, rejection.value());
             return;
         }
 
-        std::string_view requestString(buffer.data(), bytesRead);
-        Request request;
-        parseRequest(std::string(requestString), request);
+        LogTagged(webServerLog, "Received request: Method=" + request.method().value() + ", Path=" + request.path().value(), LoggerType::Info);
 
-        Log("Received request: Method=" + request.method().value() + ", Path=" + request.path().value(), LoggerType::Info);
+        sendResponseNoSSL(clientSocket, dispatchRequest(request, getClientIP(clientSocket)));
 
-        // Rate limiting
+    } catch (const std::exception& e) {
         std::string clientIP = getClientIP(clientSocket);
-        if (m_serverStructure.rateLimiter && !m_serverStructure.rateLimiter->allowRequest(clientIP)) {
-            Response rateLimitResponse;
-            rateLimitResponse.setStatusCode(429); // Too Many Requests
-            rateLimitResponse.setContentType("text/plain");
-            rateLimitResponse.setContent("Rate limit exceeded. Please try again later.");
-            std::string responseString = responseToString(rateLimitResponse);
-            ssize_t bytesSent = send(clientSocket, responseString.c_str(), responseString.length(), 0);
-            if (bytesSent < 0) {
-                Log("Error sending rate limit response to client.", LoggerType::Critical);
-            }
-            close(clientSocket);
-            return; // Exit after sending the rate limit response
+        LogTagged(webServerLog, "Error in handleClientRequestNoSSL for client IP: " + clientIP + " - " + std::string(e.what()), LoggerType::Critical);
+
+        // Internal Server Error response
+        Response errorResponse;
+        errorResponse.setStatusCode(500);
+        errorResponse.setContentType("text/plain");
+        errorResponse.setContent("Internal server error.");
+
+        // Send the error response to the client
+        sendResponseNoSSL(clientSocket, errorResponse);
+    }
+}
+
+void WebServer::compileMiddleware() {
+    auto& pipeline = m_serverStructure.pipeline;
+    pipeline.clear();
+
+    // Cheap checks that may answer the request come first
+    if (m_serverStructure.rateLimiter) {
+        pipeline.add("rateLimit", RateLimitMiddleware { m_serverStructure.rateLimiter.get() });
+    }
+    if (m_serverStructure.authenticationHandler) {
+        pipeline.add("authentication", RequestCheck { m_serverStructure.authenticationHandler, 401, "Authentication required." });
+    }
+    if (m_serverStructure.authorizationHandler) {
+        pipeline.add("authorization", RequestCheck { m_serverStructure.authorizationHandler, 403, "Access denied." });
+    }
+
+    pipeline.append(m_serverStructure.middleware);
+
+    // Router middlewares only see the requests of their own router
+    std::vector<Router*> routers { &m_serverStructure.router };
+    for (const auto& entry : m_serverStructure.virtualHostTable.entries()) {
+        if (auto* router = entry->config.getRouter(); router && std::find(routers.begin(), routers.end(), router) == routers.end()) {
+            routers.push_back(router);
+        }
+    }
+    for (auto* router : routers) {
+        for (const auto& middleware : router->middlewares()) {
+            pipeline.add("router", RouterMiddleware { router, middleware });
         }
+    }
 
+    if (m_serverStructure.exceptionErrorHandler) {
+        pipeline.add("exceptionHandler", ExceptionMiddleware { m_serverStructure.exceptionErrorHandler });
+    }
+
+    pipeline.compile();
+}
+
+Response WebServer::dispatchRequest(Request& request, const std::string& clientIP) {
+    // Select the virtual host by the Host header; unknown hosts use the server defaults
+    auto* host = m_serverStructure.virtualHostTable.resolve(request.header("Host").value_or(""));
+    Router& router = host && host->config.getRouter() ? *host->config.getRouter() : m_serverStructure.router;
+    const std::string& documentRoot = host && !host->config.getDocumentRoot().empty()
+                                          ? host->config.getDocumentRoot()
+                                          : m_serverStructure.documentRoot;
+    StaticFileCache& staticFiles = host ? host->staticFiles : m_serverStructure.staticFileCache;
+
+    Response response;
+    MiddlewareContext context { .request = request, .response = response, .clientAddress = clientIP };
+
+    m_serverStructure.pipeline.run(context, [&](MiddlewareContext& ctx) {
         // Sanitize the requested path to prevent directory traversal attacks
-        std::string requestedPath = sanitizePath(request.path().value());
-
-        // Check if the request path matches a route handler
-        if (requestedPath == "/") {
-            // Handle the home page route explicitly
-            Response homeResponse = m_serverStructure.router.routeRequest(request);
-            std::string responseString = responseToString(homeResponse);
-            ssize_t bytesSent = send(clientSocket, responseString.c_str(), responseString.length(), 0);
-            if (bytesSent < 0) {
-                Log("Error sending home page response to client.", LoggerType::Critical);
+        const std::string requestedPath = sanitizePath(ctx.request.path().value(), documentRoot);
+
+        // The home page always goes to the router; other paths are tried as static files first
+        if (requestedPath != "/") {
+            if (const auto file = staticFiles.load(documentRoot + requestedPath, m_serverStructure.staticFileCacheEnabled)) {
+                ctx.response.setStatusCode(200);
+                ctx.response.setContentType(file->mimeType);
+                ctx.response.setContent(file->content);
+                return;
             }
-            close(clientSocket);
-            return; // Exit after sending the home page response
         }
 
-        // Check if the requested path is a static file
-        std::string filePath = m_serverStructure.documentRoot + requestedPath;
-        std::ifstream file(filePath, std::ios::binary);
-
-        if (file) {
-            // Read the file content
-            std::ostringstream fileContentStream;
-            fileContentStream << file.rdbuf();
-            std::string fileContent = fileContentStream.str();
-
-            // Determine the MIME type based on the file extension
-            MediaTypes mt;
-            std::string extension = filePath.substr(filePath.find_last_of('.') + 1);
-            std::string mimeType = mt.getMimeType(extension.empty() ? "bin" : extension);
-
-            // Create a response with the file content and MIME type
-            Response response;
-            response.setStatusCode(200);
-            response.setContentType(mimeType);
-            response.setContent(fileContent);
-
-                   // Send the response to the client
-            std::string responseString = responseToString(response);
-            const char* responseData = responseString.c_str();
-            size_t responseLength = responseString.length();
-            ssize_t bytesSent = 0;
-            while (bytesSent < responseLength) {
-                ssize_t sent = send(clientSocket, responseData + bytesSent, responseLength - bytesSent, MSG_NOSIGNAL);
-                if (sent < 0) {
-                    if (errno == EINTR) {
-                        // The send operation was interrupted, try again
-                        continue;
-                    } else if (errno == EPIPE || errno == ECONNRESET) {
-                        // Client closed the connection, but we can continue processing requests
-                        break;
-                    } else {
-                        Log("Error sending response to client. Error code: " + TO_CELL_STRING(errno), LoggerType::Critical);
-                        close(clientSocket);
-                        return;
-                    }
-                } else if (sent == 0) {
-                    // Client closed the connection, but we can continue processing requests
-                    break;
-                }
-                bytesSent += sent;
+        ctx.router = &router;
+        ctx.response = router.routeRequest(ctx.request);
+    });
+
+    // Replace error bodies with the configured error page (per status code, or "0" for any error)
+    if (response.statusCode() >= 400) {
+        std::string errorPage;
+        if (host) {
+            const auto& pages = host->config.getErrorPages();
+            auto it = pages.find(std::to_string(response.statusCode()));
+            if (it == pages.end()) {
+                it = pages.find("0");
             }
-
-            // Check if the entire response was sent successfully
-            if (bytesSent == responseLength) {
-                // Response sent successfully, connection remains open
-                // Continue processing requests or wait for next request
-            } else {
-                // Error occurred while sending response or client closed the connection
-                close(clientSocket);
+            if (it != pages.end()) {
+                errorPage = it->second;
             }
+        }
+        if (errorPage.empty()) {
+            errorPage = m_serverStructure.errorPage;
+        }
+        if (!errorPage.empty()) {
+            const auto pagePath = std::filesystem::path(errorPage).is_absolute() ? errorPage : documentRoot + "/" + errorPage;
+            if (const auto page = staticFiles.load(pagePath, m_serverStructure.staticFileCacheEnabled)) {
+                response.setContentType(page->mimeType);
+                response.setContent(page->content);
+            }
+        }
+    }
+    return response;
+}
 
-            file.close();
-        } else {
-            // If the file is not found, delegate to the router to handle the request
-            Response response = m_serverStructure.router.routeRequest(request);
-            std::string responseString = responseToString(response);
-            ssize_t bytesSent = send(clientSocket, responseString.c_str(), responseString.length(), 0);
-            if (bytesSent < 0) {
-                Log("Error sending response to client.", LoggerType::Critical);
+void WebServer::sendResponseNoSSL(SocketType clientSocket, const Response& response) {
+    const std::string responseString = responseToString(response);
+    const char* responseData = responseString.c_str();
+    const size_t responseLength = responseString.length();
+
+    size_t bytesSent = 0;
+    while (bytesSent < responseLength) {
+        ssize_t sent = send(clientSocket, responseData + bytesSent, responseLength - bytesSent, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue; // Retry if interrupted
             }
-            close(clientSocket);
+            if (errno != EPIPE && errno != ECONNRESET) {
+                LogTagged(webServerLog, "Error sending response to client. Error code: " + TO_CELL_STRING(errno), LoggerType::Critical);
+            }
+            break;
+        } else if (sent == 0) {
+            break; // Client closed the connection
         }
+        bytesSent += static_cast<size_t>(sent);
+    }
+}
 
-    } catch (const std::exception& e) {
-        std::string clientIP = getClientIP(clientSocket);
-        Log("Error in handleClientRequestNoSSL for client IP: " + clientIP + " - " + std::string(e.what()), LoggerType::Critical);
+int WebServer::selectSslContext(SSL* ssl, int* alert, void* arg) {
+    (void)alert;
+    auto* server = static_cast<WebServer*>(arg);
+    const char* serverName = SSL_get_servername(ssl, TLSEXT_NAMETYPE_host_name);
+    if (serverName != nullptr) {
+        const auto* host = server->m_serverStructure.virtualHostTable.resolve(serverName);
+        if (host && host->sslContext) {
+            SSL_set_SSL_CTX(ssl, host->sslContext);
+        }
+    }
+    return SSL_TLSEXT_ERR_OK;
+}
 
-               // Internal Server Error response
-        Response errorResponse;
-        errorResponse.setStatusCode(500);
-        errorResponse.setContentType("text/plain");
-        errorResponse.setContent("Internal server error.");
+SSL_CTX* WebServer::createSslContext(const std::string& certFile, const std::string& keyFile) {
+    // Create an SSL context
+    SSL_CTX* sslContext = SSL_CTX_new(TLS_server_method());
+    if (!sslContext) {
+        LogTagged(webServerLog, "Failed to create SSL context.", LoggerType::Critical);
+        throw std::runtime_error("Failed to create SSL context.");
+    }
 
-               // Send the error response to the client
-        std::string responseString = responseToString(errorResponse);
-        ssize_t bytesSent = send(clientSocket, responseString.c_str(), responseString.length(), 0);
-        if (bytesSent < 0) {
-            Log("Error sending error response to client.", LoggerType::Critical);
+    try {
+        // Disable insecure protocols
+        SSL_CTX_set_options(sslContext, SSL_OP_NO_SSLv2 | SSL_OP_NO_SSLv3 | SSL_OP_NO_TLSv1 | SSL_OP_NO_TLSv1_1);
+        SSL_CTX_set_min_proto_version(sslContext, TLS1_3_VERSION);
+
+        // Set cipher list
+        if (SSL_CTX_set_cipher_list(sslContext, "HIGH:!aNULL:!MD5:!RC4") != 1) {
+            LogTagged(webServerLog, "Failed to set cipher list.", LoggerType::Critical);
+            throw std::runtime_error("Failed to set cipher list.");
         }
 
-               // Remove client from active connections
-        {
-            std::lock_guard<std::mutex> lock(m_activeClientsMutex);
-            m_activeClients.erase(clientSocket);
+        // Load certificate and private key
+        if (SSL_CTX_use_certificate_file(sslContext, certFile.c_str(), SSL_FILETYPE_PEM) <= 0) {
+            LogTagged(webServerLog, "Failed to load server certificate.", LoggerType::Critical);
+            throw std::runtime_error("Failed to load server certificate.");
         }
 
-        close(clientSocket);
+        if (SSL_CTX_use_PrivateKey_file(sslContext, keyFile.c_str(), SSL_FILETYPE_PEM) <= 0) {
+            LogTagged(webServerLog, "Failed to load private key.", LoggerType::Critical);
+            throw std::runtime_error("Failed to load private key.");
+        }
+
+        // Verify private key matches the certificate
+        if (!SSL_CTX_check_private_key(sslContext)) {
+            LogTagged(webServerLog, "Private key does not match the certificate.", LoggerType::Critical);
+            throw std::runtime_error("Private key does not match the certificate.");
+        }
+    } catch (...) {
+        SSL_CTX_free(sslContext);
+        throw;
     }
+    return sslContext;
+}
+
+bool WebServer::readRequestHead(const BodyReader::ReadCallback& source, std::string& head, std::string& remainder)
+{
+    std::array<char, BODY_READER_CONSTANTS::BUFFER_SIZE> buffer {};
+    std::string received;
+
+    for (;;) {
+        const auto bytesRead = source(buffer.data(), buffer.size());
+        if (bytesRead <= 0) {
+            return false;
+        }
+
+        // Only rescan the tail that may complete the terminator
+        const auto searchFrom = received.size() >= 3 ? received.size() - 3 : 0;
+        received.append(buffer.data(), static_cast<std::size_t>(bytesRead));
+
+        const auto headEnd = received.find("\r\n\r\n", searchFrom);
+        if (headEnd != std::string::npos) {
+            head = received.substr(0, headEnd + 4);
+            remainder = received.substr(headEnd + 4);
+            return true;
+        }
+
+        if (received.size() > WEBSERVER_CONSTANTS::MAX_HEADER_SIZE) {
+            LogTagged(webServerLog, "Request head exceeds " + std::to_string(WEBSERVER_CONSTANTS::MAX_HEADER_SIZE) + " bytes.", LoggerType::Warning);
+            return false;
+        }
+    }
+}
+
+std::optional<Response> WebServer::prepareRequestBody(Request& request,
+                                                      const BodyReader::ReadCallback& source,
+                                                      const std::function<bool(std::string_view)>& interim,
+                                                      std::string prefetched)
+{
+    const auto reject = [](int statusCode, const std::string& message) {
+        Response response;
+        response.setStatusCode(statusCode);
+        response.setContentType("text/plain");
+        response.setContent(message);
+        return response;
+    };
+
+    const auto containsToken = [](std::string value, std::string_view token) {
+        std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) { return std::tolower(c); });
+        return value.find(token) != std::string::npos;
+    };
+
+    const std::uint64_t maxBodySize = m_serverStructure.maxRequestSize > 0
+                                          ? static_cast<std::uint64_t>(m_serverStructure.maxRequestSize)
+                                          : 0;
+
+    auto encoding = BodyReader::Encoding::None;
+    std::uint64_t contentLength = 0;
+
+    if (const auto transferEncoding = request.header("Transfer-Encoding")) {
+        if (!containsToken(transferEncoding.value(), "chunked")) {
+            return reject(400, "Unsupported transfer encoding.");
+        }
+        encoding = BodyReader::Encoding::Chunked;
+    } else if (const auto lengthHeader = request.header("Content-Length")) {
+        const auto& value = lengthHeader.value();
+        const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), contentLength);
+        if (value.empty() || ec != std::errc() || ptr != value.data() + value.size()) {
+            return reject(400, "Invalid Content-Length.");
+        }
+        encoding = contentLength > 0 ? BodyReader::Encoding::ContentLength : BodyReader::Encoding::None;
+    }
+
+    if (encoding == BodyReader::Encoding::None) {
+        return std::nullopt;
+    }
+
+    // Reject oversized bodies before the client starts sending them
+    if (encoding == BodyReader::Encoding::ContentLength && maxBodySize > 0 && contentLength > maxBodySize) {
+        return reject(413, "Request body exceeds the maximum allowed size.");
+    }
+
+    if (const auto expect = request.header("Expect")) {
+        if (!containsToken(expect.value(), "100-continue")) {
+            return reject(417, "Unsupported expectation.");
+        }
+        if (request.httpVersion().value_or("") == "HTTP/1.1" && prefetched.empty()
+            && !interim("HTTP/1.1 100 Continue\r\n\r\n")) {
+            throw std::runtime_error("Failed to send 100 Continue.");
+        }
+    }
+
+    auto reader = std::make_shared<BodyReader>(source, std::move(prefetched), encoding, contentLength, maxBodySize);
+
+    try {
+        const auto contentType = request.header("Content-Type");
+        const auto boundary = contentType ? MultipartParser::boundaryFromContentType(contentType.value()) : std::nullopt;
+
+        if (boundary) {
+            // Spool file parts to disk while the body streams in
+            MultipartParser parser(boundary.value(), m_serverStructure.uploadDirectory);
+            std::array<char, BODY_READER_CONSTANTS::BUFFER_SIZE> buffer {};
+            while (const auto bytesRead = reader->read(buffer.data(), buffer.size())) {
+                parser.feed(std::string_view(buffer.data(), bytesRead));
+            }
+            parser.finish();
+            for (const auto& [name, value] : parser.fields()) {
+                request.setFormField(name, value);
+            }
+            request.setUploadedFiles(parser.takeFiles());
+        } else if (encoding == BodyReader::Encoding::ContentLength
+                   && contentLength <= WEBSERVER_CONSTANTS::MAX_BUFFERED_BODY_SIZE) {
+            request.setBody(reader->readAll());
+        } else {
+            // Large and chunked bodies are left for the handler to stream
+            request.setBodyReader(std::move(reader));
+        }
+    } catch (const BodyTooLargeError& e) {
+        LogTagged(webServerLog, std::string("Rejected request body: ") + e.what(), LoggerType::Warning);
+        return reject(413, e.what());
+    } catch (const std::runtime_error& e) {
+        LogTagged(webServerLog, std::string("Malformed request body: ") + e.what(), LoggerType::Warning);
+        return reject(400, e.what());
+    }
+
+    return std::nullopt;
 }
 
 void WebServer::sendResponseSSL(SSL* ssl, const Response& response) {
@@ -638,7 +1202,7 @@ void WebServer::sendResponseSSL(SSL* ssl, const Response& response) {
             if (errno == EINTR) {
                 continue; // Retry if interrupted
             }
-            Log("Error sending response. Errno: " + std::to_string(errno), LoggerType::Critical);
+            LogTagged(webServerLog, "Error sending response. Errno: " + std::to_string(errno), LoggerType::Critical);
             break;
         } else if (sent == 0) {
             break; // Client closed the connection
@@ -647,7 +1211,7 @@ void WebServer::sendResponseSSL(SSL* ssl, const Response& response) {
     }
 
     if (bytesSent < responseLength) {
-        Log("Failed to send the entire response. Sent " + std::to_string(bytesSent) + " of " + std::to_string(responseLength) + " bytes.", LoggerType::Warning);
+        LogTagged(webServerLog, "Failed to send the entire response. Sent " + std::to_string(bytesSent) + " of " + std::to_string(responseLength) + " bytes.", LoggerType::Warning);
     }
 }
 
@@ -656,6 +1220,10 @@ std::string WebServer::getDocumentRoot() const {
 }
 
 std::string WebServer::sanitizePath(const std::string& requestedPath) {
+    return sanitizePath(requestedPath, m_serverStructure.documentRoot);
+}
+
+std::string WebServer::sanitizePath(const std::string& requestedPath, const std::string& documentRoot) {
     try {
         // Ensure the path starts with a '/'
         std::string sanitized = requestedPath;
@@ -695,11 +1263,11 @@ std::string WebServer::sanitizePath(const std::string& requestedPath) {
 
         // Only perform canonical path check for static files
         if (cleanPath.rfind("/static/", 0) == 0) { // Check if the path starts with "/static/"
-            std::string fullPath = m_serverStructure.documentRoot + cleanPath;
+            std::string fullPath = documentRoot + cleanPath;
             std::string canonicalPath = std::filesystem::canonical(fullPath);
 
             // Ensure the canonical path is within the document root
-            if (canonicalPath.find(m_serverStructure.documentRoot) != 0) {
+            if (canonicalPath.find(documentRoot) != 0) {
                 // If the path escapes the document root, return "/" (root) or an error path
                 return "/";
             }
@@ -708,7 +1276,7 @@ std::string WebServer::sanitizePath(const std::string& requestedPath) {
         return cleanPath;
     } catch (const std::exception& e) {
         // Log the error and return the root path
-        Log("Error sanitizing path: " + std::string(e.what()), LoggerType::Warning);
+        LogTagged(webServerLog, "Error sanitizing path: " + std::string(e.what()), LoggerType::Warning);
         return "/";
     }
 }
@@ -716,97 +1284,48 @@ std::string WebServer::sanitizePath(const std::string& requestedPath) {
 void WebServer::handleClientRequestSSL(SocketType clientSocket, SSL* ssl) {
 
     try {
-        // Add client to active connections
-        {
-            std::lock_guard<std::mutex> lock(m_activeClientsMutex);
-            m_activeClients[clientSocket] = {
-                clientSocket,
-                getClientIP(clientSocket),
-                std::chrono::steady_clock::now()
-            };
-        }
-
-        // Log active clients
-        for (const auto& [socket, clientInfo] : m_activeClients) {
-            Log("Client: " + clientInfo.ipAddress + ", Connected at: " + std::to_string(clientInfo.connectionTime.time_since_epoch().count()), LoggerType::Info);
-        }
-
-        // Buffer to hold the client request
-        constexpr const int bufferSize = 4096;
-        std::array<char, bufferSize> buffer;
-        std::fill(buffer.begin(), buffer.end(), 0);
 
-        // Receive the client request
-        ssize_t bytesRead = SSL_read(ssl, buffer.data(), bufferSize - 1);
-        if (bytesRead < 0) {
-            int sslError = SSL_get_error(ssl, bytesRead);
-            Log("Error reading client request. SSL error: " + std::to_string(sslError), LoggerType::Critical);
+        const BodyReader::ReadCallback source = [ssl](char* data, std::size_t length) -> std::int64_t {
+            const int received = SSL_read(ssl, data, static_cast<int>(std::min<std::size_t>(length, std::numeric_limits<int>::max())));
+            if (received <= 0) {
+                return SSL_get_error(ssl, received) == SSL_ERROR_ZERO_RETURN ? 0 : -1;
+            }
+            return received;
+        };
+        const auto interim = [ssl](std::string_view data) {
+            return SSL_write(ssl, data.data(), static_cast<int>(data.size())) == static_cast<int>(data.size());
+        };
+
+        // Receive the request head; the body is pulled on demand
+        std::string requestHead;
+        std::string prefetchedBody;
+        if (!readRequestHead(source, requestHead, prefetchedBody)) {
+            LogTagged(webServerLog, "Error reading client request.", LoggerType::Critical);
             return;
         }
 
         // Parse the request
-        std::string_view requestString(buffer.data(), bytesRead);
         Request request;
-        parseRequest(std::string(requestString), request);
-
-        Log("Received request: Method=" + request.method().value() + ", Path=" + request.path().value(), LoggerType::Info);
+        parseRequest(requestHead, request);
 
-        // Rate limiting
-        std::string clientIP = getClientIP(clientSocket);
-        if (m_serverStructure.rateLimiter && !m_serverStructure.rateLimiter->allowRequest(clientIP)) {
-            Response rateLimitResponse;
-            rateLimitResponse.setStatusCode(429); // Too Many Requests
-            rateLimitResponse.setContentType("text/plain");
-            rateLimitResponse.setContent("Rate limit exceeded. Please try again later.");
-            sendResponseSSL(ssl, rateLimitResponse);
+        // Shed before touching the body if the request waited too long in the queue
+        if (!admitRequest(request)) {
+            sendResponseSSL(ssl, overloadResponse());
             return;
         }
 
-        // Sanitize the requested path to prevent directory traversal attacks
-        std::string requestedPath = sanitizePath(request.path().value());
-
-        // Check if the request path matches a route handler
-        if (requestedPath == "/") {
-            // Handle the home page route explicitly
-            Response homeResponse = m_serverStructure.router.routeRequest(request);
-            sendResponseSSL(ssl, homeResponse);
+        if (auto rejection = prepareRequestBody(request, source, interim, std::move(prefetchedBody))) {
+            sendResponseSSL(ssl, rejection.value());
             return;
         }
 
-        // Check if the requested path is a static file
-        std::string filePath = m_serverStructure.documentRoot + requestedPath;
-        std::ifstream file(filePath, std::ios::binary);
+        LogTagged(webServerLog, "Received request: Method=" + request.method().value() + ", Path=" + request.path().value(), LoggerType::Info);
 
-        if (file) {
-            // Read the file content
-            std::ostringstream fileContentStream;
-            fileContentStream << file.rdbuf();
-            std::string fileContent = fileContentStream.str();
-
-            // Determine the MIME type based on the file extension
-            MediaTypes mt;
-            std::string extension = filePath.substr(filePath.find_last_of('.') + 1);
-            std::string mimeType = mt.getMimeType(extension.empty() ? "bin" : extension);
-
-            // Create a response with the file content and MIME type
-            Response response;
-            response.setStatusCode(200);
-            response.setContentType(mimeType);
-            response.setContent(fileContent);
-
-            // Send the response to the client
-            sendResponseSSL(ssl, response);
-
-            file.close();
-        } else {
-            // If the file is not found, delegate to the router to handle the request
-            Response response = m_serverStructure.router.routeRequest(request);
-            sendResponseSSL(ssl, response);
-        }
+        sendResponseSSL(ssl, dispatchRequest(request, getClientIP(clientSocket)));
 
     } catch (const std::exception& e) {
         std::string clientIP = getClientIP(clientSocket);
-        Log("Error in handleClientRequestSSL for client IP: " + clientIP + " - " + std::string(e.what()), LoggerType::Critical);
+        LogTagged(webServerLog, "Error in handleClientRequestSSL for client IP: " + clientIP + " - " + std::string(e.what()), LoggerType::Critical);
 
         // Internal Server Error response
         Response errorResponse;
@@ -816,12 +1335,6 @@ void WebServer::handleClientRequestSSL(SocketType clientSocket, SSL* ssl) {
 
         // Send the error response to the client
         sendResponseSSL(ssl, errorResponse);
-
-        // Remove client from active connections
-        {
-            std::lock_guard<std::mutex> lock(m_activeClientsMutex);
-            m_activeClients.erase(clientSocket);
-        }
     }
 }
 
@@ -847,7 +1360,17 @@ void WebServer::addRoute(const std::string& path, const Handler& handler)
 
 void WebServer::addMiddleWare(const std::function<Response(const Request&, const std::function<Response(const Request&)>&)>& middleware)
 {
-    m_serverStructure.middleware.push_back(middleware);
+    m_serverStructure.middleware.add("middleware", WrappingMiddleware { middleware });
+}
+
+MiddlewarePipeline& WebServer::getMiddlewarePipeline()
+{
+    return m_serverStructure.middleware;
+}
+
+std::vector<MiddlewareMetrics> WebServer::getMiddlewareMetrics() const
+{
+    return m_serverStructure.pipeline.metrics();
 }
 
 void WebServer::setAuthenticationHandler(const std::function<bool(const Request&)>& authenticationHandler)
@@ -1109,11 +1632,21 @@ void WebServer::setMaxRequestSize(int maxSize)
     m_serverStructure.maxRequestSize = maxSize;
 }
 
+void WebServer::setUploadDirectory(const std::string& directory)
+{
+    m_serverStructure.uploadDirectory = directory;
+}
+
 void WebServer::setMaxConnections(int maxConnections)
 {
     m_serverStructure.maxConnections = maxConnections;
 }
 
+void WebServer::setListenBacklog(int backlog)
+{
+    m_serverStructure.listenBacklog = backlog;
+}
+
 void WebServer::setKeepAliveTimeout(int timeoutSeconds)
 {
     m_serverStructure.keepAliveTimeout = timeoutSeconds;
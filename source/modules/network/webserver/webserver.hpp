@@ -47,6 +47,31 @@ struct WEBSERVER_CONSTANTS final {
      * @brief The maximum number of connections allowed by the WebServer.
      */
     __cell_static_const_constexpr int MAX_CONNECTIONS = 100;
+
+    /**
+     * @brief The default length of the kernel queue of connections not yet accepted.
+     */
+    __cell_static_const_constexpr int LISTEN_BACKLOG = 511;
+
+    /**
+     * @brief The maximum size of a request line plus headers in bytes.
+     */
+    __cell_static_const_constexpr std::size_t MAX_HEADER_SIZE = 16384;
+
+    /**
+     * @brief Content-Length bodies up to this size are buffered into Request::body(); larger ones are streamed.
+     */
+    __cell_static_const_constexpr std::uint64_t MAX_BUFFERED_BODY_SIZE = 1048576;
+
+    /**
+     * @brief How often the accept loop checks whether the server is still running, in milliseconds.
+     */
+    __cell_static_const_constexpr int ACCEPT_POLL_INTERVAL_MS = 250;
+
+    /**
+     * @brief How long an upgrade waits for the new process to take over the listener.
+     */
+    __cell_static_const_constexpr std::chrono::milliseconds UPGRADE_TIMEOUT { 10000 };
 };
 
 struct ClientInfo {
@@ -96,6 +121,40 @@ public:
      */
     void stop() override;
 
+    /**
+     * @brief Stops the web server after in-flight requests have completed.
+     *
+     * New connections are no longer accepted; requests that are already accepted or queued are allowed
+     * to finish until the deadline, after which the remaining connections are aborted. The event loop is
+     * stopped only once the accept loop has exited, so no accepted connection is left unserved.
+     * Called from a request handler, it only starts the drain, which start() completes after the handler
+     * has returned, and returns true.
+     * @param drainTimeout The maximum time to wait for in-flight requests.
+     * @return True if every in-flight request completed before the deadline.
+     */
+    bool stopGracefully(std::chrono::milliseconds drainTimeout);
+
+    /**
+     * @brief Replaces this process with a new binary without refusing connections.
+     *
+     * Starts the executable with the handoff channel in its environment and passes the listening socket to it
+     * over a UNIX domain socket. Once the new process reports that it accepts connections, this server
+     * drains with stopGracefully(). The new process picks the listener up in start().
+     * @param executable The path of the new binary.
+     * @param arguments The arguments passed to the new binary.
+     * @param drainTimeout The maximum time to wait for in-flight requests.
+     * @return True if the listener was handed off and this server drained in time.
+     */
+    bool upgrade(const std::string& executable,
+                 const std::vector<std::string>& arguments,
+                 std::chrono::milliseconds drainTimeout);
+
+    /**
+     * @brief Sets the path of the UNIX socket used by upgrade().
+     * @param path The socket path (a file in the temp directory is used by default).
+     */
+    void setUpgradeSocketPath(const std::string& path);
+
     /**
      * @brief Checks if the web server is running.
      *
@@ -194,10 +253,35 @@ public:
      * @brief Adds a middleware function to the web server.
      *
      * This function adds a middleware function to the web server, which will be invoked for each incoming request before reaching the final handler.
+     * It runs as an around stage of the pipeline: `next` runs the handler and returns its response, which the
+     * middleware may return as is or change; returning without calling `next` answers the request without the handler.
      * @param middleware The middleware function to be added.
      */
     void addMiddleWare(const std::function<Response(const Request&, const std::function<Response(const Request&)>&)>& middleware);
 
+    /**
+     * @brief Adds a middleware type to the pipeline for every phase it implements.
+     *
+     * Middlewares must be added before start(), which compiles the pipeline.
+     * @param name The name reported by getMiddlewareMetrics().
+     * @param middleware The middleware object.
+     */
+    template <TypedMiddleware T>
+    void addMiddleware(const std::string& name, T middleware)
+    {
+        m_serverStructure.middleware.add(name, std::move(middleware));
+    }
+
+    /**
+     * @brief Returns the pipeline that application middlewares are registered in.
+     */
+    MiddlewarePipeline& getMiddlewarePipeline();
+
+    /**
+     * @brief Returns the call count, short-circuit count and time spent of every compiled middleware.
+     */
+    std::vector<MiddlewareMetrics> getMiddlewareMetrics() const;
+
     /**
      * @brief Sets the authentication handler for the web server.
      *
@@ -458,6 +542,8 @@ public:
      * @brief Adds a virtual host configuration to the web server.
      *
      * This function adds a virtual host configuration to the web server. It associates the specified hostname with the provided virtual host configuration.
+     * The hostname may be exact (`example.com`), a wildcard suffix (`*.example.com`) or the default host (`*`).
+     * Virtual hosts are indexed when the server starts.
      * @param hostname The hostname for the virtual host.
      * @param config The virtual host configuration to be associated with the hostname.
      */
@@ -611,6 +697,15 @@ public:
      */
     void setMaxRequestSize(int maxSize);
 
+    /**
+     * @brief Sets the directory where multipart file uploads are spooled.
+     *
+     * Uploaded files are written to this directory while the request body streams in and are
+     * removed once the request is destroyed. The system temporary directory is used by default.
+     * @param directory The upload directory.
+     */
+    void setUploadDirectory(const std::string& directory);
+
     /**
      * @brief Sets the maximum number of connections.
      *
@@ -619,6 +714,38 @@ public:
      */
     void setMaxConnections(int maxConnections);
 
+    /**
+     * @brief Sets how many connections the kernel queues before the server accepts them.
+     *
+     * Independent of setMaxConnections(): the backlog absorbs bursts between two accept() calls, while the
+     * connection limit caps the requests handled at once. The kernel may cap it further (somaxconn).
+     * @param backlog The queue length; zero or less restores WEBSERVER_CONSTANTS::LISTEN_BACKLOG.
+     */
+    void setListenBacklog(int backlog);
+
+    /**
+     * @brief Sets the CoDel parameters used to shed load.
+     *
+     * While the minimum queueing delay over an interval stays above the target, requests that waited longer
+     * than the target are answered with 503 and Retry-After instead of being handled. Shedding is off until
+     * this is called; ADMISSION_CONSTANTS holds reasonable values.
+     * @param target The acceptable standing queue delay (zero disables shedding).
+     * @param interval The window over which the minimum delay is observed.
+     */
+    void setQueueDelayTarget(std::chrono::milliseconds target, std::chrono::milliseconds interval);
+
+    /**
+     * @brief Sets the shedding priority of every route under a path prefix.
+     * @param pathPrefix The path prefix, e.g. "/health".
+     * @param priority Critical routes are never shed, Sheddable ones go first.
+     */
+    void setRoutePriority(const std::string& pathPrefix, RequestPriority priority);
+
+    /**
+     * @brief Returns the admission control counters.
+     */
+    AdmissionStatistics getAdmissionStatistics() const;
+
     /**
      * @brief Sets the keep-alive timeout.
      *
@@ -662,6 +789,14 @@ public:
      */
     std::string sanitizePath(const std::string& requestedPath);
 
+    /**
+     * Sanitizes the provided file path against a specific document root.
+     * @param requestedPath The input file path to sanitize.
+     * @param documentRoot The document root the path must stay within.
+     * @return A sanitized version of the input path as a std::string.
+     */
+    std::string sanitizePath(const std::string& requestedPath, const std::string& documentRoot);
+
     /**
      * @brief Adds a static file mapping.
      *
@@ -697,12 +832,139 @@ public:
     size_t getActiveClientCount() const;
 
 private:
+    /**
+     * @brief Creates the listening socket, or inherits it from the process that started an upgrade.
+     * @param port The port to bind.
+     * @param backlog The listen backlog.
+     */
+    void openListeningSocket(int port, int backlog);
+
+    /**
+     * @brief Closes this process's descriptor of the listening socket.
+     */
+    void closeListeningSocket();
+
+    /**
+     * @brief Accepts a pending connection and registers it as active.
+     * @return The client socket, or -1 if no connection was accepted within the poll interval.
+     */
+    Types::SocketType acceptClient();
+
+    /**
+     * @brief Marks the accept loop of start() as exited and runs a drain that a request handler deferred to it.
+     */
+    void finishAcceptLoop();
+
+    /**
+     * @brief Waits for the accept loop to exit and the active clients to finish, then stops the event loop.
+     * @param drainTimeout The time after which the remaining connections are aborted.
+     * @return True if every active client finished before the deadline.
+     */
+    bool drainClients(std::chrono::milliseconds drainTimeout);
+
+    /**
+     * @brief Compiles the request pipeline.
+     *
+     * Stages are laid out in this order: rate limiting, authentication and authorization, the application
+     * middlewares, the middlewares of the default and virtual host routers, and the exception handler.
+     * Only called by start() once it holds the running flag, as request threads read the compiled pipeline unlocked.
+     */
+    void compileMiddleware();
+
+    /**
+     * @brief Produces the response for a parsed request.
+     *
+     * Runs the middleware pipeline around the terminal handler, which serves static files from the
+     * virtual host's document root (through its cache partition) and routes everything else through the
+     * host's router. The configured error pages are substituted afterwards.
+     * @param request The request.
+     * @param clientIP The IP address of the client.
+     * @return The response to send.
+     */
+    Response dispatchRequest(Request& request, const std::string& clientIP);
+
+    /**
+     * @brief Sends an HTTP response over a plain socket.
+     * @param clientSocket The client socket.
+     * @param response The response to send.
+     */
+    void sendResponseNoSSL(Types::SocketType clientSocket, const Response& response);
+
+    /**
+     * @brief SNI callback that switches the handshake to the certificate of the requested virtual host.
+     */
+    static int selectSslContext(SSL* ssl, int* alert, void* arg);
+
+    /**
+     * @brief Creates a TLS 1.3 server context for a certificate and key.
+     * @throws std::runtime_error If the context cannot be created or the files cannot be loaded.
+     */
+    SSL_CTX* createSslContext(const std::string& certFile, const std::string& keyFile);
+
+    /**
+     * @brief Returns the listen backlog: the configured one if set, WEBSERVER_CONSTANTS::LISTEN_BACKLOG otherwise.
+     */
+    int listenBacklog() const;
+
+    /**
+     * @brief Builds the 503 response sent to shed requests and refused connections.
+     */
+    Response overloadResponse() const;
+
+    /**
+     * @brief Applies admission control to a parsed request using its queueing delay.
+     * @return True if the request should be handled.
+     */
+    bool admitRequest(const Request& request);
+
+    /**
+     * @brief Unregisters a connection once its request has been handled.
+     * @param clientSocket The client socket.
+     */
+    void releaseClient(Types::SocketType clientSocket);
+
+    /**
+     * @brief Unregisters a connection and closes its descriptor; called exactly once per accepted socket.
+     *
+     * The accept loop, or the task it queued, owns the descriptor; request handlers never close it.
+     * @param clientSocket The client socket.
+     */
+    void closeClient(Types::SocketType clientSocket);
+
+    /**
+     * @brief Reads the request line and headers from the connection.
+     * @param source The connection read callback.
+     * @param head Receives the request line and headers, including the terminating blank line.
+     * @param remainder Receives the body bytes that arrived together with the head.
+     * @return False if the connection failed or the head exceeded WEBSERVER_CONSTANTS::MAX_HEADER_SIZE.
+     */
+    bool readRequestHead(const BodyReader::ReadCallback& source, std::string& head, std::string& remainder);
+
+    /**
+     * @brief Sets up the body of a parsed request.
+     *
+     * Enforces the maximum request size, answers `Expect: 100-continue`, spools multipart uploads
+     * to disk, buffers small bodies into Request::body() and attaches a BodyReader for the rest.
+     * @param request The parsed request.
+     * @param source The connection read callback.
+     * @param interim Writes an interim response (100 Continue) to the connection.
+     * @param prefetched Body bytes that arrived together with the head.
+     * @return A rejection response (400, 413 or 417), or std::nullopt if the request can be routed.
+     */
+    std::optional<Response> prepareRequestBody(Request& request,
+                                               const BodyReader::ReadCallback& source,
+                                               const std::function<bool(std::string_view)>& interim,
+                                               std::string prefetched);
+
     ServerStructure m_serverStructure;  //!< The server structure object.
     EventLoop m_eventLoop;              //!< The event loop object.
     EventLoopType m_eventLoopType;      //!< The type of event loop used by the server.
 
     std::unordered_map<Types::SocketType, ClientInfo> m_activeClients;  //!< Track active clients with details
     mutable std::mutex m_activeClientsMutex;                            //!< Mutex for thread safety (mutable for const methods)
+    std::condition_variable m_drainCondition;                           //!< Signalled whenever an active client is released or the accept loop exits
+    bool m_accepting { false };                                         //!< True while start() runs its accept loop (guarded by m_activeClientsMutex)
+    std::optional<std::chrono::milliseconds> m_deferredDrain;           //!< Drain requested from a request handler (guarded by m_activeClientsMutex)
 };
 
 CELL_NAMESPACE_END
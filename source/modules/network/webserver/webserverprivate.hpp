@@ -53,6 +53,22 @@
 # endif
 #endif
 
+#ifdef __has_include
+# if __has_include("admission.hpp")
+#   include "admission.hpp"
+#else
+#   error "Cell's "admission.hpp" was not found!"
+# endif
+#endif
+
+#ifdef __has_include
+# if __has_include("middleware.hpp")
+#   include "middleware.hpp"
+#else
+#   error "Cell's "middleware.hpp" was not found!"
+# endif
+#endif
+
 #ifdef __has_include
 # if __has_include("virtualhost.hpp")
 #   include "virtualhost.hpp"
@@ -88,7 +104,7 @@ struct ServerStructure final {
     /**
      * @brief Indicates whether the server is running.
      */
-    bool isRunning { false };
+    std::atomic<bool> isRunning { false };
 
     /**
      * @brief Server running port.
@@ -191,6 +207,11 @@ struct ServerStructure final {
      */
     int maxConnections {};
 
+    /**
+     * @brief Length of the kernel queue of connections not yet accepted; zero for the default.
+     */
+    int listenBacklog {};
+
     /**
      * @brief Timeout for keeping alive an idle connection in seconds.
      */
@@ -226,6 +247,16 @@ struct ServerStructure final {
      */
     std::string documentRoot {};
 
+    /**
+     * @brief Directory where multipart file uploads are spooled (system temp directory if empty).
+     */
+    std::string uploadDirectory {};
+
+    /**
+     * @brief Path of the UNIX socket used to hand listeners to an upgraded process (temp directory if empty).
+     */
+    std::string upgradeSocketPath {};
+
     /**
      * @brief The server header string.
      */
@@ -291,6 +322,16 @@ struct ServerStructure final {
      */
     std::unordered_map<std::string, VirtualHostConfig> virtualHosts {};
 
+    /**
+     * @brief Host/SNI lookup built from virtualHosts when the server starts.
+     */
+    VirtualHostTable virtualHostTable {};
+
+    /**
+     * @brief Static file cache for requests that do not match a virtual host.
+     */
+    StaticFileCache staticFileCache {};
+
     /**
      * @brief List of backend servers for load balancing.
      */
@@ -350,10 +391,15 @@ struct ServerStructure final {
      */
     std::unique_ptr<RateLimiter> rateLimiter {};
 
+    /**
+     * @brief Queue-delay based load shedding and per-route priorities.
+     */
+    AdmissionController admissionController {};
+
     /**
      * @brief The type of socket used by the server.
      */
-    Types::SocketType serverSocket {};
+    Types::SocketType serverSocket { -1 };
 
     /**
      * @brief The router for handling incoming requests.
@@ -366,9 +412,15 @@ struct ServerStructure final {
     Handler notFoundHandler {};
 
     /**
-     * @brief List of middleware functions to be executed.
+     * @brief Middlewares registered by the application, in registration order.
+     */
+    MiddlewarePipeline middleware {};
+
+    /**
+     * @brief The pipeline run for every request, compiled by start() from the built-in,
+     * application and router middlewares.
      */
-    std::vector<std::function<Response(const Request&, const std::function<Response(const Request&)>&)>> middleware {};
+    MiddlewarePipeline pipeline {};
 };
 
 CELL_NAMESPACE_END
@@ -0,0 +1,57 @@
+#if __has_include("testing.hpp")
+#   include "testing.hpp"
+#else
+#   error "Cell's "testing.hpp" was not found!"
+#endif
+
+#if __has_include("core/binarylog.hpp")
+#   include "core/binarylog.hpp"
+#else
+#   error "Cell's "core/binarylog.hpp" was not found!"
+#endif
+
+CELL_USING_NAMESPACE Cell;
+CELL_USING_NAMESPACE Cell::Tests;
+CELL_USING_NAMESPACE Cell::Utility;
+
+namespace {
+
+/**
+ * @brief Encodes arguments as LogDeferred does, decodes them as the writer does and formats them.
+ */
+template <typename... Args>
+std::string deferredFormat(std::string_view format, const Args&... args)
+{
+    std::vector<std::byte> bytes((std::size_t { 0 } + ... + logArgumentSize(args)));
+    std::byte* out = bytes.data();
+    (encodeLogArgument(out, args), ...);
+    const std::vector<LogArgument> arguments = decodeLogArguments(bytes);
+    return formatLogArguments(format, arguments);
+}
+
+/**
+ * @brief Checks that a deferred record prints what std::format prints at the call.
+ */
+template <typename... Args>
+void expectSame(Checks& checks, std::string_view format, const Args&... args)
+{
+    const std::string eager = std::vformat(format, std::make_format_args(args...));
+    const std::string deferred = deferredFormat(format, args...);
+    checks.expect(deferred == eager, "\"" + std::string(format) + "\" gives \"" + deferred + "\" instead of \"" + eager + "\"");
+}
+
+}  // namespace
+
+int main()
+{
+    Checks checks;
+
+    expectSame(checks, "{}", 0.1f);
+    expectSame(checks, "{} {}", 1.0f / 3.0f, -2.5e-7f);
+    expectSame(checks, "{:.3} {:>10}", 0.1f, 3.14159f);
+    expectSame(checks, "{}", 0.1);
+    expectSame(checks, "{} {} {}", std::int16_t { -7 }, 42u, std::string_view("text"));
+
+    checks.expect(logArgumentSize(0.1f) == 1 + sizeof(float), "a float takes four bytes after its kind");
+    return checks.finish();
+}
@@ -0,0 +1,118 @@
+#if __has_include("testing.hpp")
+#   include "testing.hpp"
+#else
+#   error "Cell's "testing.hpp" was not found!"
+#endif
+
+#if __has_include("abstracts/database/keyset.hpp")
+#   include "abstracts/database/keyset.hpp"
+#else
+#   error "Cell's "abstracts/database/keyset.hpp" was not found!"
+#endif
+
+CELL_USING_NAMESPACE Cell;
+CELL_USING_NAMESPACE Cell::Tests;
+CELL_USING_NAMESPACE Cell::Abstracts;
+
+namespace {
+
+//! PostgreSQL spelling, so the placeholder numbers show which value goes where.
+const KeysetDialect numberedDialect {
+    .placeholder = [](std::size_t position) { return "$" + std::to_string(position); },
+    .quoteIdentifier = [](std::string_view name) { return "\"" + std::string(name) + "\""; }
+};
+
+/**
+ * @brief Whether decoding the token for the ordering is refused.
+ */
+bool rejects(const std::vector<KeysetColumn>& ordering, std::string_view token)
+{
+    try {
+        KeysetPagination::decodeToken(ordering, token);
+        return false;
+    } catch (const std::invalid_argument&) {
+        return true;
+    }
+}
+
+/**
+ * @brief Keys come back byte for byte, whatever they hold.
+ */
+void checkRoundTrip(Checks& checks)
+{
+    const std::vector<KeysetColumn> ordering { { "path" }, { "payload" }, { "id" } };
+    const std::vector<std::string> key { "a:b::c", std::string("\0\xff\x01:\x80", 5), "12:" };
+
+    const std::string token = KeysetPagination::encodeToken(ordering, key);
+    checks.expect(token.find_first_not_of("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_") == std::string::npos,
+                  "a token only uses base64url characters");
+    checks.expect(KeysetPagination::decodeToken(ordering, token) == key, "keys with colons and binary bytes survive a round trip");
+
+    const std::vector<std::string> empty { "", "", "" };
+    checks.expect(KeysetPagination::decodeToken(ordering, KeysetPagination::encodeToken(ordering, empty)) == empty,
+                  "empty key values survive a round trip");
+}
+
+/**
+ * @brief A token only continues the ordering it was made for.
+ */
+void checkForeignToken(Checks& checks)
+{
+    const std::vector<KeysetColumn> ordering { { "created_at", SortDirection::Descending }, { "id", SortDirection::Descending } };
+    const std::string token = KeysetPagination::encodeToken(ordering, { "2024-01-01", "7" });
+
+    checks.expect(!rejects(ordering, token), "a token is accepted for its own ordering");
+    checks.expect(rejects({ { "created_at", SortDirection::Ascending }, { "id", SortDirection::Descending } }, token),
+                  "a token is refused when a direction differs");
+    checks.expect(rejects({ { "updated_at", SortDirection::Descending }, { "id", SortDirection::Descending } }, token),
+                  "a token is refused when a column differs");
+    checks.expect(rejects({ { "created_at", SortDirection::Descending } }, token), "a token is refused for a shorter ordering");
+    checks.expect(rejects(ordering, "not a token!"), "a token outside base64url is refused");
+    checks.expect(rejects(ordering, token.substr(0, token.size() - 2)), "a truncated token is refused");
+}
+
+/**
+ * @brief Columns in one direction seek with a row comparison; mixed ones with an expanded predicate.
+ */
+void checkSeekPredicate(Checks& checks)
+{
+    const std::vector<KeysetColumn> uniform { { "name" }, { "id" } };
+    const KeysetQuery uniformQuery = KeysetPagination::build("SELECT id, name FROM users WHERE status = $1;", uniform, 10,
+                                                             KeysetPagination::encodeToken(uniform, { "bob", "7" }),
+                                                             numberedDialect, { "active" });
+    checks.expect(uniformQuery.sql ==
+                  "SELECT cell_keyset.*, cell_keyset.\"name\" AS \"cell_key_0\", cell_keyset.\"id\" AS \"cell_key_1\""
+                  " FROM (SELECT id, name FROM users WHERE status = $1) AS cell_keyset"
+                  " WHERE (cell_keyset.\"name\", cell_keyset.\"id\") > ($2, $3)"
+                  " ORDER BY cell_keyset.\"name\" ASC, cell_keyset.\"id\" ASC LIMIT 11",
+                  "a uniform ordering seeks with a row comparison: " + uniformQuery.sql);
+    checks.expect(uniformQuery.params == std::vector<std::string> { "active", "bob", "7" },
+                  "the key is bound after the query's own parameters");
+
+    const std::vector<KeysetColumn> mixed { { "created_at", SortDirection::Descending }, { "id", SortDirection::Ascending } };
+    const KeysetQuery mixedQuery = KeysetPagination::build("SELECT id, created_at FROM events", mixed, 5,
+                                                           KeysetPagination::encodeToken(mixed, { "2024-01-01", "7" }),
+                                                           numberedDialect);
+    checks.expect(mixedQuery.sql ==
+                  "SELECT cell_keyset.*, cell_keyset.\"created_at\" AS \"cell_key_0\", cell_keyset.\"id\" AS \"cell_key_1\""
+                  " FROM (SELECT id, created_at FROM events) AS cell_keyset"
+                  " WHERE cell_keyset.\"created_at\" <= $1"
+                  " AND (cell_keyset.\"created_at\" < $2 OR (cell_keyset.\"created_at\" = $3 AND (cell_keyset.\"id\" > $4)))"
+                  " ORDER BY cell_keyset.\"created_at\" DESC, cell_keyset.\"id\" ASC LIMIT 6",
+                  "a mixed ordering seeks with a leading bound and an expanded predicate: " + mixedQuery.sql);
+    checks.expect(mixedQuery.params == std::vector<std::string> { "2024-01-01", "2024-01-01", "2024-01-01", "7" },
+                  "every placeholder of the mixed predicate is bound");
+}
+
+}  // namespace
+
+int main()
+{
+    Checks checks;
+
+    checkRoundTrip(checks);
+    checkForeignToken(checks);
+    checkSeekPredicate(checks);
+
+    return checks.finish();
+}
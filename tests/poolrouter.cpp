@@ -0,0 +1,62 @@
+#if __has_include("testing.hpp")
+#   include "testing.hpp"
+#else
+#   error "Cell's "testing.hpp" was not found!"
+#endif
+
+#if __has_include("abstracts/database/poolrouter.hpp")
+#   include "abstracts/database/poolrouter.hpp"
+#else
+#   error "Cell's "abstracts/database/poolrouter.hpp" was not found!"
+#endif
+
+CELL_USING_NAMESPACE Cell;
+CELL_USING_NAMESPACE Cell::Tests;
+CELL_USING_NAMESPACE Cell::Abstracts;
+
+namespace {
+
+/**
+ * @brief Plain reads may go to a replica.
+ */
+void checkReads(Checks& checks)
+{
+    checks.expect(PoolRouter::isReadOnly("SELECT id, name FROM users WHERE id = 1"), "a plain SELECT is read-only");
+    checks.expect(PoolRouter::isReadOnly("SELECT count(*), max(changes) FROM audit"), "an aggregate SELECT is read-only");
+    checks.expect(PoolRouter::isReadOnly("SELECT changes FROM audit"), "a column named like a function is read-only");
+    checks.expect(PoolRouter::isReadOnly("SELECT id FROM notes WHERE body = 'moved into place'"), "a literal containing INTO is read-only");
+    checks.expect(PoolRouter::isReadOnly("EXPLAIN ANALYZE SELECT * FROM users"), "EXPLAIN ANALYZE of a SELECT is read-only");
+}
+
+/**
+ * @brief Writes, row locks and calls of writing functions stay on the primary.
+ */
+void checkPrimaryOnly(Checks& checks)
+{
+    checks.expect(!PoolRouter::isReadOnly("INSERT INTO users (name) VALUES ('a')"), "an INSERT is not read-only");
+    checks.expect(!PoolRouter::isReadOnly("SELECT * FROM users WHERE id = 1 FOR\n UPDATE"), "a SELECT ... FOR UPDATE is not read-only");
+    checks.expect(!PoolRouter::isReadOnly("SELECT nextval('users_id_seq')"), "SELECT nextval() is not read-only");
+    checks.expect(!PoolRouter::isReadOnly("SELECT pg_catalog.SETVAL ('users_id_seq', 10)"), "a qualified SETVAL() is not read-only");
+    checks.expect(!PoolRouter::isReadOnly("SELECT pg_advisory_lock(42)"), "SELECT pg_advisory_lock() is not read-only");
+    checks.expect(!PoolRouter::isReadOnly("SELECT id FROM jobs WHERE pg_try_advisory_lock(id) LIMIT 1"), "an advisory lock in WHERE is not read-only");
+    checks.expect(!PoolRouter::isReadOnly("SELECT GET_LOCK('migration', 10)"), "SELECT GET_LOCK() is not read-only");
+    checks.expect(!PoolRouter::isReadOnly("SELECT last_insert_rowid()"), "SELECT last_insert_rowid() is not read-only");
+    checks.expect(!PoolRouter::isReadOnly("CREATE TABLE t AS SELECT * FROM users"), "CREATE TABLE ... AS SELECT is not read-only");
+    checks.expect(!PoolRouter::isReadOnly("SELECT * INTO newtable FROM users"), "SELECT ... INTO a table is not read-only");
+    checks.expect(!PoolRouter::isReadOnly("LOCK TABLE t"), "LOCK TABLE is not read-only");
+    checks.expect(!PoolRouter::isReadOnly("NOTIFY chan"), "NOTIFY is not read-only");
+    checks.expect(!PoolRouter::isReadOnly("SET search_path TO app, public"), "SET is not read-only");
+    checks.expect(!PoolRouter::isReadOnly("EXPLAIN ANALYZE INSERT INTO users (name) VALUES ('a')"), "EXPLAIN ANALYZE of an INSERT is not read-only");
+}
+
+}  // namespace
+
+int main()
+{
+    Checks checks;
+
+    checkReads(checks);
+    checkPrimaryOnly(checks);
+
+    return checks.finish();
+}
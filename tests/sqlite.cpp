@@ -0,0 +1,124 @@
+#if __has_include("testing.hpp")
+#   include "testing.hpp"
+#else
+#   error "Cell's "testing.hpp" was not found!"
+#endif
+
+#if __has_include("modules/database/sqliteresultset.hpp")
+#   include "modules/database/sqliteresultset.hpp"
+#else
+#   error "Cell's "modules/database/sqliteresultset.hpp" was not found!"
+#endif
+
+CELL_USING_NAMESPACE Cell;
+CELL_USING_NAMESPACE Cell::Tests;
+CELL_USING_NAMESPACE Cell::Modules::BuiltIn::Database;
+
+namespace {
+
+constexpr std::size_t wideColumns = 100;   //!< More than one null bitmap word per row.
+constexpr std::size_t wideRows = 5;
+
+/**
+ * @brief Whether a value of the wide result is NULL; the pattern differs from row to row.
+ */
+bool isNullAt(std::size_t row, std::size_t column)
+{
+    return (row + column) % 3 == 0;
+}
+
+/**
+ * @brief The text of a non-NULL value of the wide result.
+ */
+std::string valueAt(std::size_t row, std::size_t column)
+{
+    return std::to_string(row * 1000 + column);
+}
+
+/**
+ * @brief Reads a result with more than 64 columns and compares every value and NULL.
+ */
+void checkWideResult(Checks& checks, sqlite3* database)
+{
+    std::string sql;
+    for (std::size_t row = 0; row < wideRows; ++row) {
+        sql += row == 0 ? "SELECT " : " UNION ALL SELECT ";
+        for (std::size_t column = 0; column < wideColumns; ++column) {
+            sql += column == 0 ? "" : ", ";
+            sql += isNullAt(row, column) ? "NULL" : valueAt(row, column);
+            sql += " AS c" + std::to_string(column);
+        }
+    }
+
+    sqlite3_stmt* statement = __cell_nullptr;
+    if (!checks.expect(sqlite3_prepare_v2(database, sql.c_str(), -1, &statement, __cell_nullptr) == SQLITE_OK, "the wide query is prepared")) {
+        return;
+    }
+    const SqliteResultSet result(statement);
+    sqlite3_finalize(statement);
+
+    checks.expect(result.rowCount() == wideRows, "every row of the wide result is read");
+    checks.expect(result.columnCount() == wideColumns, "every column of the wide result is read");
+    checks.expect(result.columnName(wideColumns - 1) == "c" + std::to_string(wideColumns - 1), "the last column keeps its name");
+    std::size_t mismatches = 0;
+    for (std::size_t row = 0; row < result.rowCount(); ++row) {
+        for (std::size_t column = 0; column < result.columnCount(); ++column) {
+            const bool null = isNullAt(row, column);
+            if (result.isNull(row, column) != null || (!null && result.value(row, column) != valueAt(row, column))) {
+                ++mismatches;
+            }
+        }
+    }
+    checks.expect(mismatches == 0, std::to_string(mismatches) + " values of the wide result differ");
+}
+
+/**
+ * @brief A read blocked by another connection's write lock fails as a serialization failure.
+ */
+void checkBusyStep(Checks& checks, const std::string& path)
+{
+    sqlite3* writer = __cell_nullptr;
+    sqlite3* reader = __cell_nullptr;
+    sqlite3_open(path.c_str(), &writer);
+    sqlite3_open(path.c_str(), &reader);
+    sqlite3_exec(writer, "CREATE TABLE items (id INTEGER); INSERT INTO items VALUES (1);", __cell_nullptr, __cell_nullptr, __cell_nullptr);
+
+    // Prepared before the lock is taken, so only the step is blocked
+    sqlite3_stmt* statement = __cell_nullptr;
+    bool retryable = false;
+    if (sqlite3_prepare_v2(reader, "SELECT id FROM items", -1, &statement, __cell_nullptr) == SQLITE_OK) {
+        sqlite3_exec(writer, "BEGIN EXCLUSIVE; INSERT INTO items VALUES (2);", __cell_nullptr, __cell_nullptr, __cell_nullptr);
+        try {
+            const SqliteResultSet result(statement);
+        } catch (const Abstracts::SerializationFailure&) {
+            retryable = true;
+        } catch (const std::exception&) {
+        }
+        sqlite3_finalize(statement);
+    }
+    checks.expect(retryable, "a busy step throws SerializationFailure");
+
+    sqlite3_exec(writer, "ROLLBACK;", __cell_nullptr, __cell_nullptr, __cell_nullptr);
+    sqlite3_close(reader);
+    sqlite3_close(writer);
+}
+
+}  // namespace
+
+int main()
+{
+    Checks checks;
+
+    sqlite3* database = __cell_nullptr;
+    if (!checks.expect(sqlite3_open(":memory:", &database) == SQLITE_OK, "an in-memory database opens")) {
+        return checks.finish();
+    }
+    checkWideResult(checks, database);
+    sqlite3_close(database);
+
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / ("cell-sqlite-test-" + std::to_string(std::random_device {}()) + ".db");
+    checkBusyStep(checks, path.string());
+    std::filesystem::remove(path);
+
+    return checks.finish();
+}
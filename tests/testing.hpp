@@ -0,0 +1,62 @@
+/*!
+ * @file        testing.hpp
+ * @brief       Test harness for the Cell Engine.
+ * @details     This file defines the checks shared by the test executables registered with CTest.
+ * @author      Kambiz Asadzadeh
+ * @since       07 Jun 2023
+ * @version     1.0
+ * @note        This is part of the Cell Engine, developed by Kambiz Asadzadeh.
+ *
+ * @license     This file is licensed under the terms of the Genyleap License. See the LICENSE.md file for more information.
+ * @copyright   Copyright (c) 2025 The Genyleap | Kambiz Asadzadeh. All rights reserved.
+ * @see         https://github.com/genyleap/cell
+ */
+
+#ifndef CELL_TESTING_HPP
+#define CELL_TESTING_HPP
+
+#if __has_include("common.hpp")
+#   include "common.hpp"
+#else
+#   error "Cell's "common.hpp" was not found!"
+#endif
+
+CELL_NAMESPACE_BEGIN(Cell::Tests)
+
+/**
+ * @brief Counts the checks of a test executable and reports the failed ones.
+ */
+class Checks final {
+public:
+    /**
+     * @brief Records a check; a failed one is printed with its description.
+     *
+     * @return The condition, so a test can stop early when later checks depend on it.
+     */
+    bool expect(bool condition, std::string_view what)
+    {
+        ++m_total;
+        if (!condition) {
+            ++m_failed;
+            std::cerr << "FAILED: " << what << '\n';
+        }
+        return condition;
+    }
+
+    /**
+     * @brief Prints a summary and returns the exit code of the test.
+     */
+    int finish() const
+    {
+        std::cout << m_total - m_failed << " of " << m_total << " checks passed.\n";
+        return m_failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+private:
+    std::size_t m_total     {}; //!< Checks recorded.
+    std::size_t m_failed    {}; //!< Checks that failed.
+};
+
+CELL_NAMESPACE_END
+
+#endif  // CELL_TESTING_HPP
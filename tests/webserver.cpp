@@ -0,0 +1,192 @@
+#if __has_include("testing.hpp")
+#   include "testing.hpp"
+#else
+#   error "Cell's "testing.hpp" was not found!"
+#endif
+
+#if __has_include("modules/network/webserver/webserver.hpp")
+#   include "modules/network/webserver/webserver.hpp"
+#else
+#   error "Cell's "modules/network/webserver/webserver.hpp" was not found!"
+#endif
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+CELL_USING_NAMESPACE Cell;
+CELL_USING_NAMESPACE Cell::Tests;
+CELL_USING_NAMESPACE Cell::Modules::BuiltIn::Network::WebServer;
+
+namespace {
+
+constexpr std::string_view serveOption = "--serve";
+constexpr auto successorLifetime = std::chrono::seconds(3);    //!< How long the upgraded process serves.
+constexpr auto drainTimeout = std::chrono::milliseconds(5000);
+
+/**
+ * @brief Returns a free local TCP port.
+ */
+int freePort()
+{
+    const int probe = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    bind(probe, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    getsockname(probe, reinterpret_cast<sockaddr*>(&address), &length);
+    close(probe);
+    return ntohs(address.sin_port);
+}
+
+/**
+ * @brief Serves GET /ping with the id of the serving process.
+ *
+ * The handler answers "pong" and a middleware appends the id to the response that next() returned.
+ */
+void addPing(WebServer& server)
+{
+    Router router;
+    router.addRoute("/ping", [](const Request&) {
+        Response response;
+        response.setStatusCode(200);
+        response.setContentType("text/plain");
+        response.setContent("pong");
+        return response;
+    });
+    server.registerRouter(router);
+    server.addMiddleWare([](const Request& request, const std::function<Response(const Request&)>& next) {
+        Response response = next(request);
+        response.setContent(response.content().value_or("") + " " + std::to_string(getpid()));
+        return response;
+    });
+}
+
+/**
+ * @brief Sends one request and returns the body, or nothing if the request failed.
+ */
+Types::OptionalString ping(int port)
+{
+    // Not inherited by the upgraded process, which is started from this one
+    const int client = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (client < 0) {
+        return std::nullopt;
+    }
+    const timeval timeout { 5, 0 };
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    sockaddr_in address {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(static_cast<std::uint16_t>(port));
+    if (connect(client, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        close(client);
+        return std::nullopt;
+    }
+    constexpr std::string_view request = "GET /ping HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n";
+    send(client, request.data(), request.size(), MSG_NOSIGNAL);
+
+    // The server closes the connection after the response
+    std::string response;
+    char buffer[1024];
+    ssize_t received = 0;
+    while ((received = recv(client, buffer, sizeof(buffer), 0)) > 0) {
+        response.append(buffer, static_cast<std::size_t>(received));
+    }
+    close(client);
+    const std::size_t body = response.find("\r\n\r\n");
+    if (received < 0 || !response.starts_with("HTTP/1.1 200") || body == std::string::npos) {
+        return std::nullopt;
+    }
+    return response.substr(body + 4);
+}
+
+/**
+ * @brief The upgraded process: takes over the listener, serves for a while and drains.
+ */
+int serve(int port)
+{
+    WebServer server(EventLoopType::POLL);
+    addPing(server);
+    std::thread stopper([&server] {
+        std::this_thread::sleep_for(successorLifetime);
+        server.stopGracefully(drainTimeout);
+    });
+    server.start(port);
+    stopper.join();
+    return EXIT_SUCCESS;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc > 2 && argv[1] == serveOption) {
+        return serve(std::stoi(argv[2]));
+    }
+
+    Checks checks;
+    const int port = freePort();
+    WebServer server(EventLoopType::POLL);
+    addPing(server);
+    std::thread listener([&server, port] { server.start(port); });
+
+    // Wait until the listener accepts
+    Types::OptionalString first;
+    for (int attempt = 0; attempt < 100 && !first; ++attempt) {
+        first = ping(port);
+        if (!first) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+    }
+    if (!checks.expect(first.has_value(), "the web server answers before the upgrade")) {
+        server.stop();
+        listener.join();
+        return checks.finish();
+    }
+    const std::string self = "pong " + std::to_string(getpid());
+    checks.expect(first.value() == self, "a middleware changes the response returned by next()");
+
+    // Clients keep sending requests while the listener moves to the new process
+    std::atomic<bool> done { false };
+    std::atomic<std::uint64_t> succeeded { 0 };
+    std::atomic<std::uint64_t> failed { 0 };
+    std::atomic<std::uint64_t> bySuccessor { 0 };
+    std::vector<std::thread> clients;
+    for (int i = 0; i < 4; ++i) {
+        clients.emplace_back([&] {
+            while (!done.load()) {
+                const auto body = ping(port);
+                if (!body) {
+                    ++failed;
+                    continue;
+                }
+                ++succeeded;
+                if (body.value() != self) {
+                    ++bySuccessor;
+                }
+            }
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    const bool handedOff = server.upgrade(argv[0], { std::string(serveOption), std::to_string(port) }, drainTimeout);
+    listener.join();
+
+    // Keep going against the new process alone, then let it finish
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    done = true;
+    for (auto& client : clients) {
+        client.join();
+    }
+    int status = 0;
+    const pid_t successor = waitpid(-1, &status, 0);
+
+    checks.expect(handedOff, "upgrade() hands the listener to the new process");
+    checks.expect(failed == 0, std::to_string(failed.load()) + " of " + std::to_string(succeeded + failed) + " requests failed during the handoff");
+    checks.expect(bySuccessor > 0, "the new process served requests after the handoff");
+    checks.expect(successor > 0 && WIFEXITED(status) && WEXITSTATUS(status) == 0, "the new process exits cleanly");
+    return checks.finish();
+}
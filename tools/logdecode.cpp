@@ -0,0 +1,160 @@
+#if __has_include("core/binarylog.hpp")
+#   include "core/binarylog.hpp"
+#else
+#   error "Cell's "core/binarylog.hpp" was not found!"
+#endif
+
+#if __has_include("core/logger.hpp")
+#   include "core/logger.hpp"
+#else
+#   error "Cell's "core/logger.hpp" was not found!"
+#endif
+
+CELL_USING_NAMESPACE Cell;
+CELL_USING_NAMESPACE Cell::Utility;
+
+namespace {
+
+constexpr std::string_view usage =
+    "Usage: cell-logdecode [options] FILE.clog\n"
+    "  --format text|json     Lines as Logger prints them, or one JSON object per record (default: text)\n"
+    "  --output FILE          Write to FILE instead of the standard output\n";
+
+/**
+ * @brief The command line.
+ */
+struct Settings final
+{
+    std::string input   {};
+    std::string format  { "text" };
+    std::string output  {};
+};
+
+Settings parse(int argc, char* argv[])
+{
+    Settings settings;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view option = argv[i];
+        if (option == "--help" || option == "-h") {
+            std::cout << usage;
+            std::exit(EXIT_SUCCESS);
+        }
+        if (!option.starts_with("--")) {
+            settings.input = option;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            throw std::invalid_argument("Missing value of " + std::string(option) + ".\n" + std::string(usage));
+        }
+        const std::string value = argv[++i];
+        if (option == "--format" && (value == "text" || value == "json")) {
+            settings.format = value;
+        } else if (option == "--output") {
+            settings.output = value;
+        } else {
+            throw std::invalid_argument("Unknown option " + std::string(option) + " " + value + ".\n" + std::string(usage));
+        }
+    }
+    if (settings.input.empty()) {
+        throw std::invalid_argument("No input file.\n" + std::string(usage));
+    }
+    return settings;
+}
+
+std::string_view typeName(Types::u8 type)
+{
+    static constexpr std::array<std::string_view, 9> names {
+        "Default", "Info", "Warning", "Critical", "Failed", "Success", "Done", "Paused", "InProgress"
+    };
+    return type < names.size() ? names[type] : "Unknown";
+}
+
+/**
+ * @brief Writes a record as Logger::echo() does, in the local time of this machine.
+ */
+void writeText(std::ostream& out, const ClogEntry& entry)
+{
+    const std::time_t seconds = static_cast<std::time_t>(entry.time / 1000000000);
+    out << " => Log Id : [" << entry.counter;
+    if (static_cast<Mode>(entry.mode) == Mode::User) {
+        out << "] : [";
+    } else {
+        out << "][ Line : " << entry.line << "] [ Function : " << entry.function
+            << "] [ Thread Id : " << entry.threadId << "] [ File : " << entry.file << "] ] : [";
+    }
+    out << typeName(entry.type) << "] " << entry.message << " { DateTime: "
+        << std::put_time(std::localtime(&seconds), "%Y/%m/%d %H:%M:%S") << " }\n";
+}
+
+std::string quote(std::string_view text)
+{
+    std::string quoted = "\"";
+    for (const char character : text) {
+        if (character == '"' || character == '\\') {
+            quoted += '\\';
+            quoted += character;
+        } else if (static_cast<unsigned char>(character) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(character));
+            quoted += escaped;
+        } else {
+            quoted += character;
+        }
+    }
+    return quoted + "\"";
+}
+
+/**
+ * @brief Writes a record as one JSON object, with the time in UTC and nanoseconds.
+ */
+void writeJson(std::ostream& out, const ClogEntry& entry)
+{
+    const std::int64_t nanoseconds = ((entry.time % 1000000000) + 1000000000) % 1000000000;
+    const std::time_t seconds = static_cast<std::time_t>((entry.time - nanoseconds) / 1000000000);
+    char fraction[16];
+    std::snprintf(fraction, sizeof(fraction), ".%09lldZ", static_cast<long long>(nanoseconds));
+    out << "{\"time\": \"" << std::put_time(std::gmtime(&seconds), "%Y-%m-%dT%H:%M:%S") << fraction << "\""
+        << ", \"type\": " << quote(typeName(entry.type))
+        << ", \"id\": " << entry.counter
+        << ", \"line\": " << entry.line
+        << ", \"function\": " << quote(entry.function)
+        << ", \"file\": " << quote(entry.file)
+        << ", \"thread\": " << quote(entry.threadId)
+        << ", \"message\": " << quote(entry.message) << "}\n";
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    try {
+        const Settings settings = parse(argc, argv);
+        std::ifstream input(settings.input, std::ios::binary);
+        if (!input) {
+            throw std::runtime_error("Cannot open " + settings.input + ".");
+        }
+        std::ofstream file;
+        if (!settings.output.empty()) {
+            file.open(settings.output);
+            if (!file) {
+                throw std::runtime_error("Cannot create " + settings.output + ".");
+            }
+        }
+        std::ostream& out = settings.output.empty() ? std::cout : file;
+
+        ClogReader reader(input);
+        std::uint64_t records = 0;
+        while (const auto entry = reader.next()) {
+            settings.format == "json" ? writeJson(out, *entry) : writeText(out, *entry);
+            ++records;
+        }
+        if (reader.truncated()) {
+            std::cerr << settings.input << " ends inside a record after " << records
+                      << " records; the writer probably stopped while writing it.\n";
+        }
+        return EXIT_SUCCESS;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+}
@@ -242,6 +242,23 @@ namespace JsonSpace      = std::json;
 #endif
 #endif
 
+//! Native driver handles, declared at global scope next to their driver headers.
+#ifdef USE_MYSQL_MARIADB
+using ::MySqlPtr;
+#endif
+#ifdef USE_POSTGRESQL
+using ::PostgreSqlPtr;
+#endif
+#ifdef USE_MSSQL
+using ::SqlServerPtr;
+#endif
+#ifdef USE_ORACLE
+using ::OraclePtr;
+#endif
+#ifdef USE_SQLITE
+using ::SqlitePtr;
+#endif
+
 /**
  * @brief Represents a connection to a SQL database.
  * This type alias defines a C++ union type using `std::variant`, which allows for type-safe handling of multiple
@@ -252,8 +269,25 @@ namespace JsonSpace      = std::json;
  * The connection pointer returned by each database type should be of type `std::shared_ptr<DatabaseConnection>`.
  */
 
-#if defined(USE_MYSQL_MARIADB) && defined(USE_POSTGRESQL) && defined(USE_SQLITE) && defined(USE_MSSQL) && defined(USE_ORACLE)
-using SqlConnection         = std::variant<MySqlPtr, PostgreSqlPtr, SqlServerPtr, OraclePtr, SqlitePtr>;
+#if defined(USE_MYSQL_MARIADB) || defined(USE_POSTGRESQL) || defined(USE_SQLITE) || defined(USE_MSSQL) || defined(USE_ORACLE)
+//! Only the drivers that are built; std::monostate closes the list and is never held by a pooled connection.
+using SqlConnection         = std::variant<
+#ifdef USE_MYSQL_MARIADB
+    MySqlPtr,
+#endif
+#ifdef USE_POSTGRESQL
+    PostgreSqlPtr,
+#endif
+#ifdef USE_MSSQL
+    SqlServerPtr,
+#endif
+#ifdef USE_ORACLE
+    OraclePtr,
+#endif
+#ifdef USE_SQLITE
+    SqlitePtr,
+#endif
+    std::monostate>;
 using DbConnectionQueue     = std::deque<Types::SqlConnection>;
 #endif
 